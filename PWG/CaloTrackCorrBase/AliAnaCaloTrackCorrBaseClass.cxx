@@ -511,6 +511,15 @@ Int_t AliAnaCaloTrackCorrBaseClass::GetEventNumber() const
   return fReader->GetEventNumber() ; 
 }
 
+//________________________________________________________
+/// \return Number of events accepted by the reader, including the current one.
+/// Unlike the event number, it is not reset when the input file changes.
+//________________________________________________________
+Int_t AliAnaCaloTrackCorrBaseClass::GetNAcceptedEvents() const 
+{  
+  return fReader->GetNAcceptedEvents() ; 
+}
+
 //__________________________________________________________
 /// \return  AliMCEvent pointer from AliCaloTrackReader.
 //__________________________________________________________
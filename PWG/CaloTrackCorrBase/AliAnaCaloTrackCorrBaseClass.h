@@ -98,6 +98,8 @@ public:
   
   virtual Int_t          GetEventNumber() const ;
   
+  virtual Int_t          GetNAcceptedEvents() const ;
+  
   // Centrality, multiplicity selection
   
   virtual Int_t             GetTrackMultiplicity()        const { return fReader->GetTrackMultiplicity() ; }
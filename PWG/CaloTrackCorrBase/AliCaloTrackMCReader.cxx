@@ -349,6 +349,8 @@ Bool_t AliCaloTrackMCReader::FillInputEvent(Int_t iEntry,
   
   fIndex2ndPhoton = -1; //In case of overlapping studies, reset for each event	
  	
+  fNAcceptedEvents++;
+  
   return kTRUE;	
 }
 
@@ -0,0 +1,111 @@
+ /**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+// --- ROOT system ---
+#include <TClonesArray.h>
+
+//---- AliRoot system ----
+#include "AliCaloTrackMixingPool.h"
+
+/// \cond CLASSIMP
+ClassImp(AliCaloTrackMixingPool) ;
+/// \endcond
+
+//____________________________________________________________
+/// Default constructor, needed by ROOT I/O.
+//____________________________________________________________
+AliCaloTrackMixingPool::AliCaloTrackMixingPool() :
+TObject(),
+fNBins(0),      fDepth(0),     fClassName("AliAODPWG4Particle"),
+fEvents(),      fEventNumber(), fFirst(),   fNEvents()
+{
+}
+
+//____________________________________________________________
+/// Constructor.
+///
+/// \param nBins: number of event bins.
+/// \param depth: maximum number of events stored per bin.
+/// \param className: class of the particles stored, AliAODPWG4Particle or derived.
+//____________________________________________________________
+AliCaloTrackMixingPool::AliCaloTrackMixingPool(Int_t nBins, Int_t depth, const char * className) :
+TObject(),
+fNBins(nBins > 0 ? nBins : 0), fDepth(depth > 0 ? depth : 0), fClassName(className),
+fEvents(),      fEventNumber(), fFirst(),   fNEvents()
+{
+  fEvents     .assign(fNBins*fDepth, (TClonesArray*) 0x0);
+  fEventNumber.assign(fNBins*fDepth, -1);
+  fFirst      .assign(fNBins, 0);
+  fNEvents    .assign(fNBins, 0);
+}
+
+//____________________________________________________________
+/// Destructor. Delete the stored events.
+//____________________________________________________________
+AliCaloTrackMixingPool::~AliCaloTrackMixingPool()
+{
+  for(UInt_t islot = 0; islot < fEvents.size(); islot++)
+  {
+    if ( !fEvents[islot] ) continue;
+    
+    fEvents[islot]->Delete();
+    delete fEvents[islot];
+  }
+}
+
+//____________________________________________________________
+/// Remove all the events, the arrays are kept for later use.
+//____________________________________________________________
+void AliCaloTrackMixingPool::Reset()
+{
+  for(UInt_t islot = 0; islot < fEvents.size(); islot++)
+  {
+    if ( fEvents[islot] ) fEvents[islot]->Delete();
+    
+    fEventNumber[islot] = -1;
+  }
+  
+  fFirst  .assign(fNBins, 0);
+  fNEvents.assign(fNBins, 0);
+}
+
+//____________________________________________________________
+/// Add an event to a bin. If the bin is full, the oldest event
+/// is removed and its array reused.
+///
+/// \param bin: event bin.
+/// \param eventNumber: number of accepted events, to monitor the age of the events.
+/// \return empty array, to be filled with the particles of the event,
+///         NULL if the bin does not exist or no events can be stored.
+//____________________________________________________________
+TClonesArray * AliCaloTrackMixingPool::AddEvent(Int_t bin, Int_t eventNumber)
+{
+  if ( bin < 0 || bin >= fNBins || fDepth <= 0 ) return 0x0;
+  
+  // The new event takes the position before the most recent one,
+  // the one of the oldest event if the buffer is full
+  fFirst[bin] = (fFirst[bin] + fDepth - 1) % fDepth;
+  
+  if ( fNEvents[bin] < fDepth ) fNEvents[bin]++;
+  
+  Int_t slot = bin*fDepth + fFirst[bin];
+  
+  if ( !fEvents[slot] ) fEvents[slot] = new TClonesArray(fClassName, 100);
+  else                  fEvents[slot]->Delete();
+  
+  fEventNumber[slot] = eventNumber;
+  
+  return fEvents[slot];
+}
@@ -0,0 +1,79 @@
+#ifndef ALICALOTRACKMIXINGPOOL_H
+#define ALICALOTRACKMIXINGPOOL_H
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice     */
+
+//_________________________________________________________________________
+/// \class AliCaloTrackMixingPool
+/// \ingroup CaloTrackCorrelationsBase
+/// \brief Pool of events for own mixing, one ring buffer per event bin.
+///
+/// Each event bin (centrality, z vertex and reaction plane) keeps at most
+/// a fixed number of events. Each event is a TClonesArray of AliAODPWG4Particle.
+/// When the buffer of a bin is full, adding an event reuses the array of
+/// the oldest one, so that adding and removing events is done in constant
+/// time and the arrays and particle objects memory is kept between events.
+///
+/// The events of a bin are accessed from the most recent (index 0)
+/// to the oldest one. The number of accepted events when each event was
+/// added (AliCaloTrackReader::GetNAcceptedEvents) is kept, to monitor the
+/// age of the mixed events.
+//_________________________________________________________________________
+
+#include <vector>
+
+// --- ROOT system ---
+#include <TObject.h>
+#include <TString.h>
+
+class TClonesArray ;
+
+class AliCaloTrackMixingPool : public TObject {
+  
+ public:
+  
+  AliCaloTrackMixingPool() ; // default ctor
+  
+  AliCaloTrackMixingPool(Int_t nBins, Int_t depth, const char * className = "AliAODPWG4Particle") ;
+  
+  virtual ~AliCaloTrackMixingPool() ;
+  
+  void           Reset() ;
+  
+  Int_t          GetNBins()                       const { return fNBins                     ; }
+  Int_t          GetDepth()                       const { return fDepth                     ; }
+  
+  Int_t          GetNEvents(Int_t bin)            const { return fNEvents[bin]              ; }
+  
+  TClonesArray * GetEvent(Int_t bin, Int_t i)     const { return fEvents     [GetSlot(bin,i)] ; }
+  Int_t          GetEventNumber(Int_t bin, Int_t i) const { return fEventNumber[GetSlot(bin,i)] ; }
+  
+  TClonesArray * AddEvent(Int_t bin, Int_t eventNumber) ;
+  
+ private:
+  
+  /// \return position in the buffers of the event i (0 the most recent) of a bin.
+  Int_t          GetSlot(Int_t bin, Int_t i)      const { return bin*fDepth + (fFirst[bin]+i)%fDepth ; }
+  
+  Int_t                       fNBins ;        ///< Number of event bins.
+  Int_t                       fDepth ;        ///< Maximum number of events per bin.
+  TString                     fClassName ;    ///< Class of the particles stored.
+  
+  std::vector<TClonesArray *> fEvents ;       //!<! Particles of the stored events, fDepth per bin. Owned.
+  std::vector<Int_t>          fEventNumber ;  //!<! Number of accepted events when the event was added.
+  std::vector<Int_t>          fFirst ;        //!<! Position in the bin buffer of the most recent event.
+  std::vector<Int_t>          fNEvents ;      //!<! Number of events stored per bin.
+  
+  /// Copy constructor not implemented.
+  AliCaloTrackMixingPool(              const AliCaloTrackMixingPool & p) ;
+  
+  /// Assignment operator not implemented.
+  AliCaloTrackMixingPool & operator = (const AliCaloTrackMixingPool & p) ;
+  
+  /// \cond CLASSIMP
+  ClassDef(AliCaloTrackMixingPool,1) ;
+  /// \endcond
+
+} ;
+
+#endif //ALICALOTRACKMIXINGPOOL_H
@@ -57,7 +57,7 @@ ClassImp(AliCaloTrackReader) ;
 /// Constructor. Initialize parameters.
 //________________________________________
 AliCaloTrackReader::AliCaloTrackReader() :
-TObject(),                   fEventNumber(-1), //fCurrentFileName(""),
+TObject(),                   fEventNumber(-1),                fNAcceptedEvents(0), //fCurrentFileName(""),
 fDataType(0),                fDebug(0),
 fFiducialCut(0x0),           fCheckFidCut(kFALSE),
 fComparePtHardAndJetPt(0),   fPtHardAndJetPtFactor(0),
@@ -99,7 +99,7 @@ fEventType(-1),
 fTaskName(""),               fCaloUtils(0x0),
 fWeightUtils(0x0),           fEventWeight(1),
 fMixedEvent(NULL),           fNMixedEvent(0),                 fVertex(NULL),
-fListMixedTracksEvents(),    fListMixedCaloEvents(),
+fMixingPoolTracks(0x0),      fMixingPoolCalo(0x0),
 fLastMixedTracksEvent(-1),   fLastMixedCaloEvent(-1),
 fWriteOutputDeltaAOD(kFALSE),
 fEMCALClustersListName(""),  fZvtxCut(0.),
@@ -1491,6 +1491,8 @@ Bool_t AliCaloTrackReader::FillInputEvent(Int_t iEntry, const char * /*curFileNa
 
   AliDebug(1,"Event accepted for analysis");
 
+  fNAcceptedEvents++;
+  
   return kTRUE ;
 }
 
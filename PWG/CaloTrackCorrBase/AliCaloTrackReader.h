@@ -46,6 +46,7 @@ class AliESDtrackCuts;
 //class AliTriggerAnalysis;
 class AliEventplane;
 class AliVCluster;
+class AliCaloTrackMixingPool;
 #include "AliLog.h"
 
 // --- CaloTrackCorr / EMCAL ---
@@ -84,6 +85,7 @@ public:
   virtual void    SetDataType(Int_t data )                 { fDataType = data              ; }
 
   virtual Int_t   GetEventNumber()                   const { return fEventNumber           ; }
+  virtual Int_t   GetNAcceptedEvents()               const { return fNAcceptedEvents       ; }
 	
   virtual TObjString *  GetListOfParameters() ;
   
@@ -588,25 +590,25 @@ public:
   Int_t   GetLastCaloMixedEvent()                    const { return fLastMixedCaloEvent          ; }
   Int_t   GetLastTracksMixedEvent ()                 const { return fLastMixedTracksEvent        ; }
   
-  TList * GetListWithMixedEventsForCalo  (Int_t bi)  const { if(fListMixedCaloEvents)   return fListMixedCaloEvents  [bi] ; else return 0 ; }
-  TList * GetListWithMixedEventsForTracks(Int_t bi)  const { if(fListMixedTracksEvents) return fListMixedTracksEvents[bi] ; else return 0 ; }
+  AliCaloTrackMixingPool * GetMixingPoolForCalo  () const { return fMixingPoolCalo              ; }
+  AliCaloTrackMixingPool * GetMixingPoolForTracks() const { return fMixingPoolTracks            ; }
    
-  Bool_t  ListWithMixedEventsForCaloExists()         const { if(fListMixedCaloEvents) return kTRUE  ;
-                                                             else                     return kFALSE ; }
+  Bool_t  MixingPoolForCaloExists()                  const { if(fMixingPoolCalo) return kTRUE  ;
+                                                             else                return kFALSE ; }
 
-  Bool_t  ListWithMixedEventsForTracksExists()       const { if(fListMixedTracksEvents) return kTRUE  ;
-                                                             else                       return kFALSE ; }
+  Bool_t  MixingPoolForTracksExists()                const { if(fMixingPoolTracks) return kTRUE  ;
+                                                             else                  return kFALSE ; }
   
   void    SetLastCaloMixedEvent  (Int_t e)                 { fLastMixedCaloEvent    = e          ; }
   void    SetLastTracksMixedEvent(Int_t e)                 { fLastMixedTracksEvent  = e          ; }
   
-  void    SetListWithMixedEventsForCalo (TList ** l)       { 
-            if(fListMixedCaloEvents) printf("AliCaloTrackReader::SetListWithMixedEventsForCalo() - Track Mixing event list already set, nothing done\n");
-            else                        fListMixedCaloEvents    = l ; }
+  void    SetMixingPoolForCalo  (AliCaloTrackMixingPool * p) { 
+            if(fMixingPoolCalo)   printf("AliCaloTrackReader::SetMixingPoolForCalo() - Calorimeter mixing pool already set, nothing done\n");
+            else                  fMixingPoolCalo    = p ; }
   
-  void    SetListWithMixedEventsForTracks(TList ** l)      { 
-            if(fListMixedTracksEvents)  printf("AliCaloTrackReader::SetListWithMixedEventsForTracks() - Calorimeter Mixing event list already set, nothing done\n");
-            else                        fListMixedTracksEvents  = l ; }
+  void    SetMixingPoolForTracks(AliCaloTrackMixingPool * p) { 
+            if(fMixingPoolTracks) printf("AliCaloTrackReader::SetMixingPoolForTracks() - Track mixing pool already set, nothing done\n");
+            else                  fMixingPoolTracks  = p ; }
   
   //-------------------------------------
   // Other methods
@@ -737,6 +739,7 @@ public:
  protected:
   
   Int_t	           fEventNumber;                   ///<  Event number.
+  Int_t            fNAcceptedEvents;               //!<! Number of events accepted for analysis, not reset when the input file changes as the event number.
   Int_t            fDataType ;                     ///<  Select MC: Kinematics, Data: ESD/AOD, MCData: Both.
   Int_t            fDebug;                         ///<  Debugging level.
   AliFiducialCut * fFiducialCut;                   ///<  Acceptance cuts.
@@ -857,8 +860,8 @@ public:
   Int_t            fNMixedEvent ;                  ///<  Number of events in mixed event buffer.
   Double_t      ** fVertex      ;                  //!<! Vertex array 3 dim for each mixed event buffer.
   
-  TList **         fListMixedTracksEvents;         //!<! Container for tracks stored for different events, used in case of own mixing, set in analysis class.
-  TList **         fListMixedCaloEvents  ;         //!<! Container for photon stored for different events, used in case of own mixing, set in analysis class.
+  AliCaloTrackMixingPool * fMixingPoolTracks;      //!<! Pool of tracks stored for different events, used in case of own mixing, set in analysis class. Not owner.
+  AliCaloTrackMixingPool * fMixingPoolCalo  ;      //!<! Pool of clusters stored for different events, used in case of own mixing, set in analysis class. Not owner.
   Int_t            fLastMixedTracksEvent ;         ///<  Temporary container with the last event added to the mixing list for tracks.
   Int_t            fLastMixedCaloEvent   ;         ///<  Temporary container with the last event added to the mixing list for photons.
    
@@ -974,7 +977,7 @@ public:
   AliCaloTrackReader & operator = (const AliCaloTrackReader & r) ; 
   
   /// \cond CLASSIMP
-  ClassDef(AliCaloTrackReader,77) ;
+  ClassDef(AliCaloTrackReader,78) ;
   /// \endcond
 
 } ;
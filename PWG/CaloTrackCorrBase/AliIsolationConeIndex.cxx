@@ -0,0 +1,281 @@
+ /**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+#include <algorithm>
+
+// --- ROOT system ---
+#include <TObjArray.h>
+#include <TMath.h>
+
+//---- AliRoot system ----
+#include "AliIsolationConeIndex.h"
+
+/// \cond CLASSIMP
+ClassImp(AliIsolationConeIndex) ;
+/// \endcond
+
+namespace
+{
+  const Float_t kGridCellSize = 0.1  ; ///< Approximate eta and phi size of the grid cells.
+  const Int_t   kGridMaxRows  = 100  ; ///< Maximum number of eta rows of the grid.
+  const Float_t kGridMargin   = 0.01 ; ///< Margin added to the cone size when looking for cells, larger than the rounding errors.
+}
+
+//____________________________________________________________
+/// Default constructor.
+//____________________________________________________________
+AliIsolationConeIndex::AliIsolationConeIndex() :
+TObject(),
+fObject(),        fID(),             fMatched(),      fBad(),
+fPt(),            fEta(),            fPhi(),
+fList(0x0),       fEventNumber(-1),
+fUseGrid(kFALSE), fNEtaRows(0),      fNPhiColumns(0),
+fEtaMin(0.),      fEtaCell(0.),      fPhiCell(0.),
+fCellStart(),     fCellEntries(),
+fCandidates(),    fColumnInRange()
+{
+}
+
+//____________________________________________________________
+/// Remove all the entries, the arrays capacity is kept.
+//____________________________________________________________
+void AliIsolationConeIndex::Clear(Option_t *)
+{
+  fObject .clear();
+  fID     .clear();
+  fMatched.clear();
+  fBad    .clear();
+  fPt     .clear();
+  fEta    .clear();
+  fPhi    .clear();
+  
+  fList        = 0x0;
+  fEventNumber = -1;
+  fUseGrid     = kFALSE;
+  
+  fCellEntries.clear();
+  fCandidates .clear();
+}
+
+//____________________________________________________________
+/// Add a track or cluster, in the order of the original list.
+///
+/// \param obj: original track or cluster, null for mixed events particles.
+/// \param id: track or cluster ID, -1 if not available.
+/// \param matched: cluster matched with a track.
+/// \param pt: transverse momentum.
+/// \param eta: pseudorapidity.
+/// \param phi: azimuthal angle, in [0,2pi].
+//____________________________________________________________
+void AliIsolationConeIndex::AddEntry(TObject * obj, Int_t id, Bool_t matched,
+                                     Float_t pt, Float_t eta, Float_t phi)
+{
+  fObject .push_back(obj);
+  fID     .push_back(id);
+  fMatched.push_back(matched);
+  fBad    .push_back(kFALSE);
+  fPt     .push_back(pt);
+  fEta    .push_back(eta);
+  fPhi    .push_back(phi);
+}
+
+//____________________________________________________________
+/// Add an entry of the original list that cannot be used,
+/// to keep the same indexes as in the list.
+//____________________________________________________________
+void AliIsolationConeIndex::AddBadEntry()
+{
+  fObject .push_back(0x0);
+  fID     .push_back(-1);
+  fMatched.push_back(kFALSE);
+  fBad    .push_back(kTRUE);
+  fPt     .push_back(0.);
+  fEta    .push_back(0.);
+  fPhi    .push_back(0.);
+}
+
+//____________________________________________________________
+/// Sort the entries in the eta-phi grid, once all are added.
+///
+/// \param list: original list, if not null the index is reused for this list in the same event.
+/// \param eventNumber: number of accepted events of the reader, identifies the event.
+/// \param useGrid: sort the entries in the grid, if false all the entries are candidates of all queries.
+//____________________________________________________________
+void AliIsolationConeIndex::Build(const TObjArray * list, Int_t eventNumber, Bool_t useGrid)
+{
+  fList        = list;
+  fEventNumber = eventNumber;
+  fUseGrid     = useGrid;
+  
+  fCellEntries.clear();
+  
+  if ( !fUseGrid ) return;
+  
+  Int_t nEntries = GetNEntries();
+  
+  Float_t etaMin =  1e10;
+  Float_t etaMax = -1e10;
+  for(Int_t i = 0; i < nEntries; i++)
+  {
+    if ( fBad[i] ) continue;
+    
+    if ( fEta[i] < etaMin ) etaMin = fEta[i];
+    if ( fEta[i] > etaMax ) etaMax = fEta[i];
+  }
+  
+  if ( etaMax < etaMin ) etaMin = etaMax = 0;
+  
+  fNEtaRows    = TMath::Min(Int_t((etaMax-etaMin)/kGridCellSize)+1, kGridMaxRows);
+  fEtaMin      = etaMin;
+  fEtaCell     = (etaMax-etaMin)/fNEtaRows;
+  if ( fEtaCell <= 0 ) fEtaCell = kGridCellSize;
+  
+  fNPhiColumns = TMath::CeilNint(TMath::TwoPi()/kGridCellSize);
+  fPhiCell     = TMath::TwoPi()/fNPhiColumns;
+  
+  // Counting sort of the entries in the cells, keeping the list order in each cell
+  Int_t nCells = fNEtaRows*fNPhiColumns;
+  fCellStart.assign(nCells+1, 0);
+  
+  for(Int_t i = 0; i < nEntries; i++)
+  {
+    if ( fBad[i] ) continue;
+    
+    fCellStart[GetEtaRow(fEta[i])*fNPhiColumns+GetPhiColumn(fPhi[i])+1]++;
+  }
+  
+  for(Int_t icell = 0; icell < nCells; icell++) fCellStart[icell+1] += fCellStart[icell];
+  
+  fCellEntries.resize(fCellStart[nCells]);
+  
+  std::vector<Int_t> fill(fCellStart.begin(), fCellStart.end()-1);
+  for(Int_t i = 0; i < nEntries; i++)
+  {
+    if ( fBad[i] ) continue;
+    
+    fCellEntries[fill[GetEtaRow(fEta[i])*fNPhiColumns+GetPhiColumn(fPhi[i])]++] = i;
+  }
+}
+
+//____________________________________________________________
+/// \return true if the index was built from this list in this event
+/// and can be reused.
+//____________________________________________________________
+Bool_t AliIsolationConeIndex::IsBuiltFor(const TObjArray * list, Int_t eventNumber) const
+{
+  if ( !fList || list != fList || eventNumber != fEventNumber ) return kFALSE;
+  
+  return ( list->GetEntries() == GetNEntries() );
+}
+
+//____________________________________________________________
+/// Find the entries that can be inside the cone of a candidate 
+/// (and in its eta and phi UE bands if requested). The entries found are
+/// accessed with GetNCandidates() and GetCandidate(i), in increasing order.
+///
+/// \param etaC: pseudorapidity of the candidate.
+/// \param phiC: azimuthal angle of the candidate, in [0,2pi[.
+/// \param coneSize: isolation cone size.
+/// \param withUEBands: also the entries in the eta band (full phi) and phi band (full eta).
+//____________________________________________________________
+void AliIsolationConeIndex::FindCandidates(Float_t etaC, Float_t phiC, Float_t coneSize, Bool_t withUEBands)
+{
+  fCandidates.clear();
+  
+  if ( !fUseGrid )
+  {
+    for(Int_t i = 0; i < GetNEntries(); i++)
+    {
+      if ( !fBad[i] ) fCandidates.push_back(i);
+    }
+    
+    return;
+  }
+  
+  if ( fCellEntries.empty() ) return;
+  
+  Float_t r = coneSize + kGridMargin;
+  
+  // Eta rows overlapping with [etaC-r, etaC+r]
+  Int_t row0 = 0, row1 = -1;
+  if ( etaC + r >= fEtaMin && etaC - r <= fEtaMin + fNEtaRows*fEtaCell )
+  {
+    row0 = GetEtaRow(etaC - r);
+    row1 = GetEtaRow(etaC + r);
+  }
+  
+  // Phi columns overlapping with [phiC-r, phiC+r], wrapped around 2pi
+  fColumnInRange.assign(fNPhiColumns, kFALSE);
+  if ( 2*r >= TMath::TwoPi() )
+  {
+    fColumnInRange.assign(fNPhiColumns, kTRUE);
+  }
+  else
+  {
+    Int_t col0 = TMath::FloorNint((phiC - r)/fPhiCell);
+    Int_t col1 = TMath::FloorNint((phiC + r)/fPhiCell);
+    for(Int_t col = col0; col <= col1; col++)
+      fColumnInRange[((col % fNPhiColumns) + fNPhiColumns) % fNPhiColumns] = kTRUE;
+  }
+  
+  for(Int_t row = 0; row < fNEtaRows; row++)
+  {
+    Bool_t inEta = ( row >= row0 && row <= row1 );
+    
+    if ( !inEta && !withUEBands ) continue;
+    
+    for(Int_t col = 0; col < fNPhiColumns; col++)
+    {
+      // Cone: cells in eta and phi range; UE bands: cells in eta or phi range
+      Bool_t select = withUEBands ? ( inEta || fColumnInRange[col] ) : fColumnInRange[col];
+      
+      if ( !select ) continue;
+      
+      Int_t icell = row*fNPhiColumns+col;
+      for(Int_t ientry = fCellStart[icell]; ientry < fCellStart[icell+1]; ientry++)
+        fCandidates.push_back(fCellEntries[ientry]);
+    }
+  }
+  
+  std::sort(fCandidates.begin(), fCandidates.end());
+}
+
+//____________________________________________________________
+/// \return eta row of the grid, values out of the grid go to the first or last row.
+//____________________________________________________________
+Int_t AliIsolationConeIndex::GetEtaRow(Float_t eta) const
+{
+  Float_t x = (eta - fEtaMin)/fEtaCell;
+  
+  if ( !(x >= 0) ) return 0;
+  
+  if ( x >= fNEtaRows ) return fNEtaRows-1;
+  
+  return Int_t(x);
+}
+
+//____________________________________________________________
+/// \return phi column of the grid, values out of [0,2pi[ go to the first or last column.
+//____________________________________________________________
+Int_t AliIsolationConeIndex::GetPhiColumn(Float_t phi) const
+{
+  Float_t x = phi/fPhiCell;
+  
+  if ( !(x >= 0) ) return 0;
+  
+  if ( x >= fNPhiColumns ) return fNPhiColumns-1;
+  
+  return Int_t(x);
+}
@@ -0,0 +1,108 @@
+#ifndef ALIISOLATIONCONEINDEX_H
+#define ALIISOLATIONCONEINDEX_H
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice     */
+
+//_________________________________________________________________________
+/// \class AliIsolationConeIndex
+/// \ingroup CaloTrackCorrelationsBase
+/// \brief Eta-phi index of the tracks or clusters of an event for isolation cone queries.
+///
+/// The kinematics (pT, eta, phi) of the tracks or clusters of a list are
+/// calculated once and kept with the information needed by the isolation
+/// (pointer to the original object, track or cluster ID, track matching).
+/// The entries are sorted in cells of an eta-phi grid, so that the entries
+/// that can be in the cone (or in the eta and phi UE bands) of a candidate
+/// are found by looking only at the cells that overlap with them. The
+/// selection of the entries is then done exactly by the caller, in the
+/// order of the original list, so that the results do not change.
+///
+/// The index is kept for the whole event when built from the lists
+/// of the reader, identified by the list and a number unique to the
+/// event, AliCaloTrackReader::GetNAcceptedEvents(). The entry number in
+/// the tree cannot be used, it restarts with each input file.
+//_________________________________________________________________________
+
+#include <vector>
+
+// --- ROOT system ---
+#include <TObject.h>
+
+class TObjArray ;
+
+class AliIsolationConeIndex : public TObject {
+  
+ public:
+  
+  AliIsolationConeIndex() ; // default ctor
+  
+  /// Virtual destructor.
+  virtual ~AliIsolationConeIndex() { ; }
+  
+  void       Clear(Option_t * opt = "") ;
+  
+  // Filling
+  
+  void       AddEntry(TObject * obj, Int_t id, Bool_t matched, Float_t pt, Float_t eta, Float_t phi) ;
+  void       AddBadEntry() ;
+  void       Build(const TObjArray * list, Int_t eventNumber, Bool_t useGrid) ;
+  
+  Bool_t     IsBuiltFor(const TObjArray * list, Int_t eventNumber) const ;
+  
+  // Queries
+  
+  void       FindCandidates(Float_t etaC, Float_t phiC, Float_t coneSize, Bool_t withUEBands) ;
+  
+  Int_t      GetNCandidates()                     const { return fCandidates.size()     ; }
+  Int_t      GetCandidate(Int_t i)                const { return fCandidates[i]         ; }
+  
+  Int_t      GetNEntries()                        const { return fPt.size()             ; }
+  Bool_t     IsBad(Int_t i)                       const { return fBad[i]                ; }
+  TObject  * GetObject(Int_t i)                   const { return fObject[i]             ; }
+  Int_t      GetID(Int_t i)                       const { return fID[i]                 ; }
+  Bool_t     IsMatched(Int_t i)                   const { return fMatched[i]            ; }
+  Float_t    GetPt(Int_t i)                       const { return fPt[i]                 ; }
+  Float_t    GetEta(Int_t i)                      const { return fEta[i]                ; }
+  Float_t    GetPhi(Int_t i)                      const { return fPhi[i]                ; }
+  
+ private:
+  
+  Int_t      GetEtaRow(Float_t eta)               const ;
+  Int_t      GetPhiColumn(Float_t phi)            const ;
+  
+  std::vector<TObject*> fObject ;   //!<! Original track or cluster, null for mixed events particles.
+  std::vector<Int_t>    fID ;       //!<! Track or cluster ID, to remove the candidate daughters.
+  std::vector<Bool_t>   fMatched ;  //!<! Cluster matched with a track.
+  std::vector<Bool_t>   fBad ;      //!<! Entry of unexpected type, not to be used.
+  std::vector<Float_t>  fPt ;       //!<! Transverse momentum.
+  std::vector<Float_t>  fEta ;      //!<! Pseudorapidity.
+  std::vector<Float_t>  fPhi ;      //!<! Azimuthal angle, in [0,2pi].
+  
+  const TObjArray     * fList ;     //!<! List used to build the index, null if it must not be reused.
+  Int_t                 fEventNumber ; //!<! Number of accepted events of the reader when the index was built.
+  
+  Bool_t                fUseGrid ;  //!<! Entries sorted in the grid, otherwise all entries are candidates.
+  Int_t                 fNEtaRows ; //!<! Number of eta rows of the grid.
+  Int_t                 fNPhiColumns ; //!<! Number of phi columns of the grid.
+  Float_t               fEtaMin ;   //!<! Minimum eta of the grid.
+  Float_t               fEtaCell ;  //!<! Eta size of the grid cells.
+  Float_t               fPhiCell ;  //!<! Phi size of the grid cells.
+  std::vector<Int_t>    fCellStart ;   //!<! Position of the first entry of each cell in fCellEntries.
+  std::vector<Int_t>    fCellEntries ; //!<! Entries sorted by cell, in increasing order in a cell.
+  
+  std::vector<Int_t>    fCandidates ;  //!<! Entries found by the last query, in increasing order.
+  std::vector<Bool_t>   fColumnInRange ; //!<! Phi columns overlapping with the last query.
+  
+  /// Copy constructor not implemented.
+  AliIsolationConeIndex(              const AliIsolationConeIndex & idx) ;
+  
+  /// Assignment operator not implemented.
+  AliIsolationConeIndex & operator = (const AliIsolationConeIndex & idx) ;
+  
+  /// \cond CLASSIMP
+  ClassDef(AliIsolationConeIndex,1) ;
+  /// \endcond
+
+} ;
+
+#endif //ALIISOLATIONCONEINDEX_H
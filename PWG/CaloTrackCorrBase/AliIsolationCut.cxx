@@ -54,7 +54,9 @@ fFracIsThresh(1),
 fIsTMClusterInConeRejected(1),
 fDistMinToTrigger(-1.),
 fMomentum(),
-fTrackVector()
+fTrackVector(),
+fTrackIndex(),
+fClusterIndex()
 {
   InitParameters();
 }
@@ -460,9 +462,18 @@ void  AliIsolationCut::MakeIsolationCut(TObjArray * plCTS,
   if(plCTS &&
      (fPartInCone==kOnlyCharged || fPartInCone==kNeutralAndCharged))
   {
-    for(Int_t ipr = 0;ipr < plCTS->GetEntries() ; ipr ++ )
+    // Tracks kinematics, calculated once per event, and tracks that can be
+    // in the cone (or in the UE bands), in the order of the list
+    FillTrackIndex(plCTS, reader);
+    
+    fTrackIndex.FindCandidates(etaC, phiC, fConeSize, fICMethod == kSumBkgSubIC);
+    
+    for(Int_t icand = 0; icand < fTrackIndex.GetNCandidates(); icand++)
     {
-      AliVTrack* track = dynamic_cast<AliVTrack*>(plCTS->At(ipr)) ;
+      Int_t ipr = fTrackIndex.GetCandidate(icand);
+      
+      // Null for mixed event stored in AliAODPWG4Particles
+      AliVTrack* track = static_cast<AliVTrack*>(fTrackIndex.GetObject(ipr)) ;
       
       if(track)
       {
@@ -471,7 +482,7 @@ void  AliIsolationCut::MakeIsolationCut(TObjArray * plCTS,
         // in the isolation conte
         if ( pCandidate->GetDetectorTag() == AliFiducialCut::kCTS ) // make sure conversions are tagged as kCTS!!!
         {
-          Int_t  trackID   = reader->GetTrackID(track) ; // needed instead of track->GetID() since AOD needs some manipulations
+          Int_t  trackID   = fTrackIndex.GetID(ipr) ;
           Bool_t contained = kFALSE;
           
           for(Int_t i = 0; i < 4; i++) 
@@ -481,29 +492,13 @@ void  AliIsolationCut::MakeIsolationCut(TObjArray * plCTS,
           
           if ( contained ) continue ;
         }
-        
-        fTrackVector.SetXYZ(track->Px(),track->Py(),track->Pz());
-        pt  = fTrackVector.Pt();
-        eta = fTrackVector.Eta();
-        phi = fTrackVector.Phi() ;
-      }
-      else
-      {// Mixed event stored in AliAODPWG4Particles
-        AliAODPWG4Particle * trackmix = dynamic_cast<AliAODPWG4Particle*>(plCTS->At(ipr)) ;
-        if(!trackmix)
-        {
-          AliWarning("Wrong track data type, continue");
-          continue;
-        }
-        
-        pt  = trackmix->Pt();
-        eta = trackmix->Eta();
-        phi = trackmix->Phi() ;
       }
       
-      // ** Calculate distance between candidate and tracks **
+      pt  = fTrackIndex.GetPt (ipr);
+      eta = fTrackIndex.GetEta(ipr);
+      phi = fTrackIndex.GetPhi(ipr);
       
-      if ( phi < 0 ) phi+=TMath::TwoPi();
+      // ** Calculate distance between candidate and tracks **
       
       rad = Radius(etaC, phiC, eta, phi);
       
@@ -606,53 +601,37 @@ void  AliIsolationCut::MakeIsolationCut(TObjArray * plCTS,
      (fPartInCone==kOnlyNeutral || fPartInCone==kNeutralAndCharged))
   {
     
-    for(Int_t ipr = 0;ipr < plNe->GetEntries() ; ipr ++ )
+    // Clusters kinematics, calculated once per event, and clusters that can be
+    // in the cone (or in the UE bands), in the order of the list
+    FillClusterIndex(plNe, reader, pid);
+    
+    fClusterIndex.FindCandidates(etaC, phiC, fConeSize, fICMethod == kSumBkgSubIC);
+    
+    for(Int_t icand = 0; icand < fClusterIndex.GetNCandidates(); icand++)
     {
-      AliVCluster * calo = dynamic_cast<AliVCluster *>(plNe->At(ipr)) ;
+      Int_t ipr = fClusterIndex.GetCandidate(icand);
+      
+      // Null for mixed event stored in AliAODPWG4Particles
+      AliVCluster * calo = static_cast<AliVCluster *>(fClusterIndex.GetObject(ipr)) ;
       
       if(calo)
       {
-        // Get the index where the cluster comes, to retrieve the corresponding vertex
-        Int_t evtIndex = 0 ;
-        if (reader->GetMixedEvent())
-          evtIndex=reader->GetMixedEvent()->EventIndexForCaloCluster(calo->GetID()) ;
-        
-        
         // Do not count the candidate (photon or pi0) or the daughters of the candidate
-        if(calo->GetID() == pCandidate->GetCaloLabel(0) ||
-           calo->GetID() == pCandidate->GetCaloLabel(1)   ) continue ;
+        if(fClusterIndex.GetID(ipr) == pCandidate->GetCaloLabel(0) ||
+           fClusterIndex.GetID(ipr) == pCandidate->GetCaloLabel(1)   ) continue ;
         
         // Skip matched clusters with tracks in case of neutral+charged analysis
         if(fIsTMClusterInConeRejected)
         {
-          if( fPartInCone == kNeutralAndCharged &&
-             pid->IsTrackMatched(calo,reader->GetCaloUtils(),reader->GetInputEvent()) ) continue ;
-        }
-        
-        // Assume that come from vertex in straight line
-        calo->GetMomentum(fMomentum,reader->GetVertex(evtIndex)) ;
-        
-        pt  = fMomentum.Pt()  ;
-        eta = fMomentum.Eta() ;
-        phi = fMomentum.Phi() ;
-      }
-      else
-      {// Mixed event stored in AliAODPWG4Particles
-        AliAODPWG4Particle * calomix = dynamic_cast<AliAODPWG4Particle*>(plNe->At(ipr)) ;
-        if(!calomix)
-        {
-          AliWarning("Wrong calo data type, continue");
-          continue;
+          if( fPartInCone == kNeutralAndCharged && fClusterIndex.IsMatched(ipr) ) continue ;
         }
-        
-        pt  = calomix->Pt();
-        eta = calomix->Eta();
-        phi = calomix->Phi() ;
       }
       
-      // ** Calculate distance between candidate and tracks **
+      pt  = fClusterIndex.GetPt (ipr);
+      eta = fClusterIndex.GetEta(ipr);
+      phi = fClusterIndex.GetPhi(ipr);
       
-      if( phi < 0 ) phi+=TMath::TwoPi();
+      // ** Calculate distance between candidate and tracks **
       
       rad = Radius(etaC, phiC, eta, phi);
       
@@ -878,6 +857,139 @@ void  AliIsolationCut::MakeIsolationCut(TObjArray * plCTS,
   }
 }
 
+//________________________________________________________________________________
+/// Fill the eta-phi index of the tracks used in MakeIsolationCut.
+/// The index of the reader tracks is built once per event and reused
+/// for all the candidates, other lists (mixed events, tracks referenced
+/// by a candidate) are indexed in each call.
+///
+/// \param plCTS: List of tracks.
+/// \param reader: pointer to AliCaloTrackReader. Needed to access event info.
+//________________________________________________________________________________
+void AliIsolationCut::FillTrackIndex(TObjArray * plCTS, AliCaloTrackReader * reader)
+{
+  Bool_t readerList  = ( plCTS == reader->GetCTSTracks() );
+  Int_t  eventNumber = reader->GetNAcceptedEvents(); // unlike GetEventNumber(), not reset per input file
+  
+  if ( readerList && fTrackIndex.IsBuiltFor(plCTS, eventNumber) ) return;
+  
+  fTrackIndex.Clear();
+  
+  Float_t pt  = -100. ;
+  Float_t eta = -100. ;
+  Float_t phi = -100. ;
+  
+  for(Int_t ipr = 0;ipr < plCTS->GetEntries() ; ipr ++ )
+  {
+    AliVTrack* track = dynamic_cast<AliVTrack*>(plCTS->At(ipr)) ;
+    Int_t trackID = -1;
+    
+    if(track)
+    {
+      trackID = reader->GetTrackID(track) ; // needed instead of track->GetID() since AOD needs some manipulations
+      
+      fTrackVector.SetXYZ(track->Px(),track->Py(),track->Pz());
+      pt  = fTrackVector.Pt();
+      eta = fTrackVector.Eta();
+      phi = fTrackVector.Phi() ;
+    }
+    else
+    {// Mixed event stored in AliAODPWG4Particles
+      AliAODPWG4Particle * trackmix = dynamic_cast<AliAODPWG4Particle*>(plCTS->At(ipr)) ;
+      if(!trackmix)
+      {
+        AliWarning("Wrong track data type, continue");
+        fTrackIndex.AddBadEntry();
+        continue;
+      }
+      
+      pt  = trackmix->Pt();
+      eta = trackmix->Eta();
+      phi = trackmix->Phi() ;
+    }
+    
+    if ( phi < 0 ) phi+=TMath::TwoPi();
+    
+    fTrackIndex.AddEntry(track, trackID, kFALSE, pt, eta, phi);
+  }
+  
+  fTrackIndex.Build(readerList ? plCTS : 0x0, eventNumber, readerList);
+}
+
+//________________________________________________________________________________
+/// Fill the eta-phi index of the clusters used in MakeIsolationCut.
+/// The index of the reader clusters is built once per event and reused
+/// for all the candidates, other lists (mixed events, clusters referenced
+/// by a candidate) are indexed in each call.
+///
+/// \param plNe: List of clusters.
+/// \param reader: pointer to AliCaloTrackReader. Needed to access event info.
+/// \param pid: pointer to AliCaloPID. Needed to reject matched clusters in isolation cone.
+//________________________________________________________________________________
+void AliIsolationCut::FillClusterIndex(TObjArray * plNe, AliCaloTrackReader * reader, AliCaloPID * pid)
+{
+  Bool_t readerList  = ( plNe == reader->GetEMCALClusters() ||
+                         plNe == reader->GetDCALClusters()  ||
+                         plNe == reader->GetPHOSClusters()     );
+  Int_t  eventNumber = reader->GetNAcceptedEvents(); // unlike GetEventNumber(), not reset per input file
+  
+  if ( readerList && fClusterIndex.IsBuiltFor(plNe, eventNumber) ) return;
+  
+  fClusterIndex.Clear();
+  
+  Float_t pt  = -100. ;
+  Float_t eta = -100. ;
+  Float_t phi = -100. ;
+  
+  for(Int_t ipr = 0;ipr < plNe->GetEntries() ; ipr ++ )
+  {
+    AliVCluster * calo = dynamic_cast<AliVCluster *>(plNe->At(ipr)) ;
+    Int_t  caloID  = -1;
+    Bool_t matched = kFALSE;
+    
+    if(calo)
+    {
+      // Get the index where the cluster comes, to retrieve the corresponding vertex
+      Int_t evtIndex = 0 ;
+      if (reader->GetMixedEvent())
+        evtIndex=reader->GetMixedEvent()->EventIndexForCaloCluster(calo->GetID()) ;
+      
+      caloID = calo->GetID();
+      
+      // Matched clusters with tracks, skipped in case of neutral+charged analysis
+      if ( fIsTMClusterInConeRejected && fPartInCone == kNeutralAndCharged )
+        matched = pid->IsTrackMatched(calo,reader->GetCaloUtils(),reader->GetInputEvent());
+      
+      // Assume that come from vertex in straight line
+      calo->GetMomentum(fMomentum,reader->GetVertex(evtIndex)) ;
+      
+      pt  = fMomentum.Pt()  ;
+      eta = fMomentum.Eta() ;
+      phi = fMomentum.Phi() ;
+    }
+    else
+    {// Mixed event stored in AliAODPWG4Particles
+      AliAODPWG4Particle * calomix = dynamic_cast<AliAODPWG4Particle*>(plNe->At(ipr)) ;
+      if(!calomix)
+      {
+        AliWarning("Wrong calo data type, continue");
+        fClusterIndex.AddBadEntry();
+        continue;
+      }
+      
+      pt  = calomix->Pt();
+      eta = calomix->Eta();
+      phi = calomix->Phi() ;
+    }
+    
+    if( phi < 0 ) phi+=TMath::TwoPi();
+    
+    fClusterIndex.AddEntry(calo, caloID, matched, pt, eta, phi);
+  }
+  
+  fClusterIndex.Build(readerList ? plNe : 0x0, eventNumber, readerList);
+}
+
 //_____________________________________________________
 /// Print some relevant parameters set for the analysis.
 //_____________________________________________________
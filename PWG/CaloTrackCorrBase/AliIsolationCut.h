@@ -23,6 +23,9 @@
 class TObjArray ;
 #include <TLorentzVector.h>
 
+// --- CaloTrackCorrelations ---
+#include "AliIsolationConeIndex.h"
+
 // --- ANALYSIS system ---
 class AliAODPWG4ParticleCorrelation ;
 class AliCaloTrackReader ;
@@ -63,6 +66,10 @@ class AliIsolationCut : public TObject {
 
   Float_t    Radius(Float_t etaCandidate, Float_t phiCandidate, Float_t eta, Float_t phi) const ;
 
+  void       FillTrackIndex  (TObjArray * plCTS, AliCaloTrackReader * reader) ;
+
+  void       FillClusterIndex(TObjArray * plNe,  AliCaloTrackReader * reader, AliCaloPID * pid) ;
+
   // Cone background studies medthods
 
   Float_t    CalculateExcessAreaFraction(Float_t excess) const ;
@@ -140,6 +147,10 @@ class AliIsolationCut : public TObject {
 
   TVector3   fTrackVector;       //!<! Track moment, temporal object.
 
+  AliIsolationConeIndex fTrackIndex;   //!<! Eta-phi index of the tracks of the event.
+
+  AliIsolationConeIndex fClusterIndex; //!<! Eta-phi index of the clusters of the event.
+
   /// Copy constructor not implemented.
   AliIsolationCut(              const AliIsolationCut & g) ;
 
@@ -0,0 +1,196 @@
+ /**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+// --- ROOT system ---
+#include <TClonesArray.h>
+#include <TMath.h>
+
+//---- AliRoot system ----
+#include "AliNeutralMesonPairKinematics.h"
+#include "AliAODPWG4Particle.h"
+
+/// \cond CLASSIMP
+ClassImp(AliNeutralMesonPairKinematics) ;
+/// \endcond
+
+//____________________________________________________________
+/// Default constructor.
+//____________________________________________________________
+AliNeutralMesonPairKinematics::AliNeutralMesonPairKinematics() :
+TObject(),
+fPx(),     fPy(),     fPz(),    fE(),       fP2(),       fEta(),   fPhi(),
+fPartners(),
+fPartnerPx(), fPartnerPy(), fPartnerPz(), fPartnerE(), fPartnerP2(),
+fPairE(),  fPairPt(), fPairM(), fPairAsym(), fPairAngle()
+{
+}
+
+//____________________________________________________________
+/// Remove the photons and partners of the list, keep the arrays capacity.
+//____________________________________________________________
+void AliNeutralMesonPairKinematics::Clear(Option_t *)
+{
+  fPx.clear();
+  fPy.clear();
+  fPz.clear();
+  fE .clear();
+  fP2.clear();
+  fEta.clear();
+  fPhi.clear();
+  
+  ClearPartners();
+}
+
+//____________________________________________________________
+/// Remove the partners, keep the arrays capacity.
+//____________________________________________________________
+void AliNeutralMesonPairKinematics::ClearPartners()
+{
+  fPartners .clear();
+  fPartnerPx.clear();
+  fPartnerPy.clear();
+  fPartnerPz.clear();
+  fPartnerE .clear();
+  fPartnerP2.clear();
+}
+
+//____________________________________________________________
+/// Add photon i of the list as partner of the first photon.
+/// Its momentum components are copied to the partner arrays,
+/// in the order the partners are added.
+//____________________________________________________________
+void AliNeutralMesonPairKinematics::AddPartner(Int_t i)
+{
+  fPartners .push_back(i);
+  fPartnerPx.push_back(fPx[i]);
+  fPartnerPy.push_back(fPy[i]);
+  fPartnerPz.push_back(fPz[i]);
+  fPartnerE .push_back(fE [i]);
+  fPartnerP2.push_back(fP2[i]);
+}
+
+//____________________________________________________________
+/// Add a photon to the list.
+/// \return index of the photon in the list.
+//____________________________________________________________
+Int_t AliNeutralMesonPairKinematics::AddPhoton(Double_t px, Double_t py, Double_t pz, Double_t e)
+{
+  fPx.push_back(px);
+  fPy.push_back(py);
+  fPz.push_back(pz);
+  fE .push_back(e );
+  fP2.push_back(px*px+py*py+pz*pz);
+  
+  // As in TVector3::PseudoRapidity() and TVector3::Phi()
+  Double_t ptot     = TMath::Sqrt(fP2.back());
+  Double_t cosTheta = ptot == 0.0 ? 1.0 : pz/ptot;
+  if      ( cosTheta*cosTheta < 1 ) fEta.push_back(-0.5*TMath::Log((1.0-cosTheta)/(1.0+cosTheta)));
+  else if ( pz == 0 )               fEta.push_back(0.);
+  else                              fEta.push_back(pz > 0 ? 10e10 : -10e10);
+  
+  fPhi.push_back(px == 0.0 && py == 0.0 ? 0.0 : TMath::ATan2(py,px));
+  
+  return fPx.size()-1;
+}
+
+//____________________________________________________________
+/// Fill the list with the photons of an array of AliAODPWG4Particle,
+/// with the same indexes as in the array.
+//____________________________________________________________
+void AliNeutralMesonPairKinematics::SetPhotons(const TClonesArray * photons)
+{
+  Clear();
+  
+  if ( !photons ) return;
+  
+  Int_t nPhot = photons->GetEntriesFast();
+  for(Int_t iphot = 0; iphot < nPhot; iphot++)
+  {
+    AliAODPWG4Particle * phot = (AliAODPWG4Particle*) photons->At(iphot);
+    AddPhoton(phot->Px(),phot->Py(),phot->Pz(),phot->E());
+  }
+}
+
+//____________________________________________________________
+/// Calculate the kinematics of the pairs of a photon with 
+/// the partner photons of the list, see AddPartner.
+/// The results are accessed with the partner index k, in the order
+/// the partners were added, GetPairMass(k) etc.; GetPartner(k) gives
+/// the index of the partner photon in the list.
+///
+/// \param px: first photon px.
+/// \param py: first photon py.
+/// \param pz: first photon pz.
+/// \param e:  first photon energy.
+/// \param angle: calculate also the opening angle.
+//____________________________________________________________
+void AliNeutralMesonPairKinematics::CalculatePairs(Double_t px, Double_t py, Double_t pz, Double_t e, Bool_t angle)
+{
+  const Int_t nPartners = fPartners.size();
+  
+  if ( (Int_t) fPairE.size() < nPartners )
+  {
+    fPairE    .resize(nPartners);
+    fPairPt   .resize(nPartners);
+    fPairM    .resize(nPartners);
+    fPairAsym .resize(nPartners);
+    fPairAngle.resize(nPartners);
+  }
+  
+  const Double_t * px2 = fPartnerPx.data();
+  const Double_t * py2 = fPartnerPy.data();
+  const Double_t * pz2 = fPartnerPz.data();
+  const Double_t * e2  = fPartnerE .data();
+  const Double_t * p22 = fPartnerP2.data();
+  
+  Double_t * pairE     = fPairE    .data();
+  Double_t * pairPt    = fPairPt   .data();
+  Double_t * pairM     = fPairM    .data();
+  Double_t * pairAsym  = fPairAsym .data();
+  Double_t * pairAngle = fPairAngle.data();
+  
+  // Sum of the 4-momenta, as in TLorentzVector::operator+, M() and Pt()
+  for(Int_t k = 0; k < nPartners; k++)
+  {
+    Double_t sx = px + px2[k];
+    Double_t sy = py + py2[k];
+    Double_t sz = pz + pz2[k];
+    Double_t se = e  + e2 [k];
+    
+    Double_t mm = se*se - (sx*sx+sy*sy+sz*sz);
+    Double_t m  = TMath::Sqrt(TMath::Abs(mm));
+    
+    pairE   [k] = se;
+    pairPt  [k] = TMath::Sqrt(sx*sx+sy*sy);
+    pairM   [k] = mm < 0 ? -m : m;
+    pairAsym[k] = TMath::Abs(e-e2[k])/(e+e2[k]);
+  }
+  
+  if ( !angle ) return;
+  
+  // Opening angle, as in TVector3::Angle()
+  const Double_t p2 = px*px+py*py+pz*pz;
+  
+  for(Int_t k = 0; k < nPartners; k++)
+  {
+    Double_t ptot2 = p2*p22[k];
+    Double_t arg   = (px*px2[k]+py*py2[k]+pz*pz2[k])/TMath::Sqrt(ptot2 > 0 ? ptot2 : 1.);
+    
+    if      ( arg >  1.0 ) arg =  1.0;
+    else if ( arg < -1.0 ) arg = -1.0;
+    
+    pairAngle[k] = ptot2 > 0 ? TMath::ACos(arg) : 0.;
+  }
+}
@@ -0,0 +1,107 @@
+#ifndef ALINEUTRALMESONPAIRKINEMATICS_H
+#define ALINEUTRALMESONPAIRKINEMATICS_H
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice     */
+
+//_________________________________________________________________________
+/// \class AliNeutralMesonPairKinematics
+/// \ingroup CaloTrackCorrelationsBase
+/// \brief Pair kinematics of one photon with a list of photons.
+///
+/// The momentum components of a list of photons are kept in separate arrays
+/// (px, py, pz, E and momentum squared), together with their pseudorapidity
+/// and azimuthal angle, calculated once per photon. The momentum components
+/// of the partner photons, the photons of the list to pair with a first photon,
+/// are copied to compact arrays when they are added, so that the invariant mass,
+/// transverse momentum, energy and energy asymmetry of the pairs are calculated
+/// in one pass over contiguous memory; the opening angle only if requested.
+///
+/// The arithmetic is the same as the one of TLorentzVector and TVector3 
+/// ((p1+p2).M(), (p1+p2).Pt(), p1.Angle(p2.Vect()), p2.Eta(), p2.Phi()),
+/// the results are identical.
+///
+/// The arrays keep their capacity between events.
+//_________________________________________________________________________
+
+#include <vector>
+
+// --- ROOT system ---
+#include <TObject.h>
+
+class TClonesArray ;
+
+class AliNeutralMesonPairKinematics : public TObject {
+  
+ public:
+  
+  AliNeutralMesonPairKinematics() ; // default ctor
+  
+  /// Virtual destructor.
+  virtual ~AliNeutralMesonPairKinematics() { ; }
+  
+  void     Clear(Option_t * opt = "") ;
+  
+  Int_t    AddPhoton(Double_t px, Double_t py, Double_t pz, Double_t e) ;
+  
+  void     SetPhotons(const TClonesArray * photons) ;
+  
+  Int_t    GetNPhotons()                          const { return fPx.size()             ; }
+  
+  // Photons of the list to pair with the first photon
+  
+  void     ClearPartners() ;
+  void     AddPartner(Int_t i) ;
+  Int_t    GetNPartners()                         const { return fPartners.size()       ; }
+  Int_t    GetPartner(Int_t k)                    const { return fPartners[k]           ; }
+  
+  void     CalculatePairs(Double_t px, Double_t py, Double_t pz, Double_t e, Bool_t angle) ;
+  
+  // Kinematics of photon i of the list
+  
+  Double_t GetPhotonEta(Int_t i)                  const { return fEta[i]                ; }
+  Double_t GetPhotonPhi(Int_t i)                  const { return fPhi[i]                ; }
+  
+  // Pair kinematics of the first photon with partner k, after CalculatePairs
+  
+  Double_t GetPairEnergy(Int_t k)                 const { return fPairE[k]              ; }
+  Double_t GetPairPt(Int_t k)                     const { return fPairPt[k]             ; }
+  Double_t GetPairMass(Int_t k)                   const { return fPairM[k]              ; }
+  Double_t GetPairAsymmetry(Int_t k)              const { return fPairAsym[k]           ; }
+  Double_t GetPairAngle(Int_t k)                  const { return fPairAngle[k]          ; }
+  
+ private:
+  
+  std::vector<Double_t> fPx ;          //!<! Photons px
+  std::vector<Double_t> fPy ;          //!<! Photons py
+  std::vector<Double_t> fPz ;          //!<! Photons pz
+  std::vector<Double_t> fE ;           //!<! Photons energy
+  std::vector<Double_t> fP2 ;          //!<! Photons momentum squared
+  std::vector<Double_t> fEta ;         //!<! Photons pseudorapidity
+  std::vector<Double_t> fPhi ;         //!<! Photons azimuthal angle
+  
+  std::vector<Int_t>    fPartners ;    //!<! Photons to pair with the first photon
+  std::vector<Double_t> fPartnerPx ;   //!<! Partners px
+  std::vector<Double_t> fPartnerPy ;   //!<! Partners py
+  std::vector<Double_t> fPartnerPz ;   //!<! Partners pz
+  std::vector<Double_t> fPartnerE ;    //!<! Partners energy
+  std::vector<Double_t> fPartnerP2 ;   //!<! Partners momentum squared
+  
+  std::vector<Double_t> fPairE ;       //!<! Pairs energy
+  std::vector<Double_t> fPairPt ;      //!<! Pairs transverse momentum
+  std::vector<Double_t> fPairM ;       //!<! Pairs invariant mass
+  std::vector<Double_t> fPairAsym ;    //!<! Pairs energy asymmetry
+  std::vector<Double_t> fPairAngle ;   //!<! Pairs opening angle
+  
+  /// Copy constructor not implemented.
+  AliNeutralMesonPairKinematics(              const AliNeutralMesonPairKinematics & k) ;
+  
+  /// Assignment operator not implemented.
+  AliNeutralMesonPairKinematics & operator = (const AliNeutralMesonPairKinematics & k) ;
+  
+  /// \cond CLASSIMP
+  ClassDef(AliNeutralMesonPairKinematics,3) ;
+  /// \endcond
+
+} ;
+
+#endif //ALINEUTRALMESONPAIRKINEMATICS_H
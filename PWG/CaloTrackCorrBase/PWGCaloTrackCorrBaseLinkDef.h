@@ -6,14 +6,17 @@
 
 #pragma link C++ class AliAnaScale+;
 #pragma link C++ class AliNeutralMesonSelection+;
+#pragma link C++ class AliNeutralMesonPairKinematics+;
 #pragma link C++ class AliFiducialCut+;
 #pragma link C++ class AliCaloPID+;
 #pragma link C++ class AliMCAnalysisUtils+;
 #pragma link C++ class AliIsolationCut+;
+#pragma link C++ class AliIsolationConeIndex+;
 #pragma link C++ class AliCaloTrackReader+;
 #pragma link C++ class AliCaloTrackESDReader+;
 #pragma link C++ class AliCaloTrackAODReader+;
 #pragma link C++ class AliCaloTrackMCReader+;
+#pragma link C++ class AliCaloTrackMixingPool+;
 #pragma link C++ class AliCalorimeterUtils+;
 #pragma link C++ class AliAnalysisTaskCounter+;
 #pragma link C++ class AliAnaCaloTrackCorrMaker+;
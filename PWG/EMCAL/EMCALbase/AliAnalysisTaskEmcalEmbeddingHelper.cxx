@@ -34,6 +34,7 @@
 #include <TProfile.h>
 #include <TH1F.h>
 #include <TRandom3.h>
+#include <TEnv.h>
 
 #include <AliLog.h>
 #include <AliAnalysisManager.h>
@@ -79,6 +80,11 @@ AliAnalysisTaskEmcalEmbeddingHelper::AliAnalysisTaskEmcalEmbeddingHelper() :
   fRandomEventNumberAccess(kFALSE),
   fRandomFileAccess(kTRUE),
   fCreateHisto(true),
+  fExternalEventCacheSize(30000000),
+  fExternalEventCacheLearnEntries(10),
+  fAsyncPrefetching(false),
+  fParallelUnzip(false),
+  fPreOpenNextFile(true),
 
   fFilePattern(""),
   fInputFilename(""),
@@ -94,6 +100,7 @@ AliAnalysisTaskEmcalEmbeddingHelper::AliAnalysisTaskEmcalEmbeddingHelper() :
   fOffset(0),
   fMaxNumberOfFiles(0),
   fFileNumber(0),
+  fPreOpenedFileNumber(-1),
   fHistManager(),
   fOutput(nullptr),
 
@@ -139,6 +146,11 @@ AliAnalysisTaskEmcalEmbeddingHelper::AliAnalysisTaskEmcalEmbeddingHelper(const c
   fRandomEventNumberAccess(kFALSE),
   fRandomFileAccess(kTRUE),
   fCreateHisto(true),
+  fExternalEventCacheSize(30000000),
+  fExternalEventCacheLearnEntries(10),
+  fAsyncPrefetching(false),
+  fParallelUnzip(false),
+  fPreOpenNextFile(true),
   
   fFilePattern(""),
   fInputFilename(""),
@@ -154,6 +166,7 @@ AliAnalysisTaskEmcalEmbeddingHelper::AliAnalysisTaskEmcalEmbeddingHelper(const c
   fOffset(0),
   fMaxNumberOfFiles(0),
   fFileNumber(0),
+  fPreOpenedFileNumber(-1),
   fHistManager(name),
   fOutput(nullptr),
   fExternalEvent(nullptr),
@@ -785,6 +798,11 @@ Bool_t AliAnalysisTaskEmcalEmbeddingHelper::SetupInputFiles()
   DetermineFirstFileToEmbed();
 
   // Setup TChain
+  // Asynchronous prefetching needs to be enabled before the first file is opened
+  if (fAsyncPrefetching) {
+    AliInfo("Enabling asynchronous prefetching of the read-ahead caches (TFile.AsyncPrefetching).");
+    gEnv->SetValue("TFile.AsyncPrefetching", 1);
+  }
   fChain = new TChain(fTreeName);
 
   // Determine whether AliEn is needed
@@ -888,9 +906,55 @@ Bool_t AliAnalysisTaskEmcalEmbeddingHelper::SetupInputFiles()
   Bool_t res = InitEvent();
   if (!res) return kFALSE;
 
+  SetupExternalEventCache();
+
   return kTRUE;
 }
 
+/**
+ * Setup the read-ahead cache of the external event chain. Entries are read sequentially within a file
+ * (starting from a random offset if requested), so the cache can read the baskets of the following
+ * entries in a few large requests instead of one request per branch and entry. Optionally, the cache
+ * is filled asynchronously and the baskets are decompressed ahead of time in a background thread, so
+ * that the I/O of the next external entries overlaps with the processing of the current internal event.
+ */
+void AliAnalysisTaskEmcalEmbeddingHelper::SetupExternalEventCache()
+{
+  if (!fChain || fExternalEventCacheSize == 0) return;
+
+  if (fExternalEventCacheSize > 0) {
+    fChain->SetCacheSize(fExternalEventCacheSize);
+  }
+  if (fExternalEventCacheLearnEntries > 0) {
+    fChain->SetCacheLearnEntries(fExternalEventCacheLearnEntries);
+  }
+  if (fParallelUnzip) {
+    fChain->SetParallelUnzip(kTRUE);
+  }
+  AliInfoStream() << "Read-ahead cache for the external events: size " << fExternalEventCacheSize << " bytes, learning from " << fExternalEventCacheLearnEntries << " entries" << (fAsyncPrefetching ? ", asynchronous prefetching" : "") << (fParallelUnzip ? ", parallel unzipping" : "") << ".\n";
+}
+
+/**
+ * Request the asynchronous opening of the file following the current one in the chain (wrapping
+ * around to the first file at the end). When the chain switches to this file, TFile::Open() picks up
+ * the pending request, so the connection and the reading of the file header happen in the background
+ * while the events of the current file are embedded.
+ */
+void AliAnalysisTaskEmcalEmbeddingHelper::PreOpenNextFile()
+{
+  if (!fPreOpenNextFile || !fChain || fMaxNumberOfFiles < 2) return;
+
+  Int_t nextFileNumber = (fFileNumber + 1) % fMaxNumberOfFiles;
+  if (nextFileNumber == fPreOpenedFileNumber) return;
+
+  TObject * element = fChain->GetListOfFiles()->At(nextFileNumber);
+  if (!element) return;
+
+  AliDebugStream(3) << "Requesting asynchronous open of the next file to embed \"" << element->GetTitle() << "\".\n";
+  TFile::AsyncOpen(element->GetTitle());
+  fPreOpenedFileNumber = nextFileNumber;
+}
+
 /**
  * Check if the file pythia base filename can be found in the folder or archive corresponding where
  * the external event input file is found.
@@ -1043,6 +1107,9 @@ void AliAnalysisTaskEmcalEmbeddingHelper::InitTree()
   //       invalid filenames may be included in the fFilenames count!
   //AliDebug(2, TString::Format("Will start embedding file %i as the %ith file beginning from entry %i.", (fFilenameIndex + fFileNumber) % fMaxNumberOfFiles, fFileNumber, fCurrentEntry));
 
+  // Start opening the next file while the current one is used
+  PreOpenNextFile();
+
   // (re)set whether we have wrapped the tree
   fWrappedAroundTree = false;
 
@@ -1238,6 +1305,11 @@ std::string AliAnalysisTaskEmcalEmbeddingHelper::toString(bool includeFileList)
   tempSS << "Random file access: " << fRandomFileAccess << "\n";
   tempSS << "Starting file index: " << fFilenameIndex << "\n";
   tempSS << "Number of files to embed: " << fFilenames.size() << "\n";
+  tempSS << "External event cache size: " << fExternalEventCacheSize << "\n";
+  tempSS << "External event cache learn entries: " << fExternalEventCacheLearnEntries << "\n";
+  tempSS << "Asynchronous prefetching: " << fAsyncPrefetching << "\n";
+  tempSS << "Parallel unzip: " << fParallelUnzip << "\n";
+  tempSS << "Pre-open next file: " << fPreOpenNextFile << "\n";
 
   std::bitset<32> triggerMask(fTriggerMask);
   tempSS << "\nEmbedded event settings:\n";
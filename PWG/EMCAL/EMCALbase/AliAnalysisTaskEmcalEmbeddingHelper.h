@@ -97,6 +97,11 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   Int_t GetStartingFileIndex()                              const { return fFilenameIndex; }
   TString GetFileListFilename()                             const { return fFileListFilename; }
   bool GetCreateHistos()                                    const { return fCreateHisto; }
+  Long64_t GetExternalEventCacheSize()                      const { return fExternalEventCacheSize; }
+  Int_t GetExternalEventCacheLearnEntries()                 const { return fExternalEventCacheLearnEntries; }
+  bool GetAsyncPrefetching()                                const { return fAsyncPrefetching; }
+  bool GetParallelUnzip()                                   const { return fParallelUnzip; }
+  bool GetPreOpenNextFile()                                 const { return fPreOpenNextFile; }
 
   // Set
   /// Set the pt hard bin which will be added into the file pattern. Can also be omitted and set directly in the pattern.
@@ -129,6 +134,23 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   void SetFileListFilename(const char * filename)                 { fFileListFilename = filename; }
   /// Create QA histograms. These are necessary for proper scaling, so be careful disabling them!
   void SetCreateHistos(bool b)                                    { fCreateHisto = b; }
+  /**
+   * Set the size (in bytes) of the read-ahead cache of the external event chain. The cache reads the
+   * baskets of the next entries of the current file in large blocks, bounding the memory used for prefetching.
+   * 0 disables the cache, a negative value keeps the ROOT default.
+   */
+  void SetExternalEventCacheSize(Long64_t bytes)                  { fExternalEventCacheSize = bytes; }
+  /// Set the number of entries used by the read-ahead cache to learn which branches are read
+  void SetExternalEventCacheLearnEntries(Int_t n)                 { fExternalEventCacheLearnEntries = n; }
+  /**
+   * Fill the read-ahead cache asynchronously in a background thread (TFile.AsyncPrefetching), such that reading
+   * the next entries overlaps with the processing of the current internal event. Note that this setting is global!
+   */
+  void SetAsyncPrefetching(bool b)                                { fAsyncPrefetching = b; }
+  /// Decompress the baskets of the next entries in a background thread and keep them for the following internal events
+  void SetParallelUnzip(bool b)                                   { fParallelUnzip = b; }
+  /// Start opening the next file of the chain when switching to a new file, such that the file switch does not block
+  void SetPreOpenNextFile(bool b)                                 { fPreOpenNextFile = b; }
   /* @} */
 
   /**
@@ -199,6 +221,8 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   Bool_t          CheckIsEmbeddedEventSelected();
   Bool_t          InitEvent()           ;
   void            InitTree()            ;
+  void            SetupExternalEventCache();
+  void            PreOpenNextFile()     ;
   bool            PythiaInfoFromCrossSectionFile(std::string filename);
 
   UInt_t                                        fTriggerMask;       ///<  Trigger selection mask
@@ -219,6 +243,11 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   Bool_t                                        fRandomEventNumberAccess; ///<  If true, it will start embedding from a random entry in the file rather than from the first
   Bool_t                                        fRandomFileAccess ; ///< If true, it will start embedding from a random file in the input files list
   bool                                          fCreateHisto      ; ///< If true, create QA histograms
+  Long64_t                                      fExternalEventCacheSize; ///< Size of the read-ahead cache of the external chain in bytes (0: disabled, <0: ROOT default)
+  Int_t                                         fExternalEventCacheLearnEntries; ///< Number of entries the read-ahead cache uses to learn the branches read
+  bool                                          fAsyncPrefetching ; ///< If true, the read-ahead cache is filled asynchronously
+  bool                                          fParallelUnzip    ; ///< If true, baskets are decompressed ahead of time in a background thread
+  bool                                          fPreOpenNextFile  ; ///< If true, the next file of the chain is opened asynchronously ahead of time
 
   TString                                       fFilePattern      ; ///<  File pattern to select AliEn files using alien_find
   TString                                       fInputFilename    ; ///<  Filename of input root files
@@ -234,6 +263,7 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   Int_t                                         fOffset           ; //!<! Offset from fLowerEntry where the loop over the tree should start
   UInt_t                                        fMaxNumberOfFiles ; //!<! Max number of files that are in the TChain
   UInt_t                                        fFileNumber       ; //!<! File number corresponding to the current tree
+  Int_t                                         fPreOpenedFileNumber; //!<! Number of the file in the chain for which the asynchronous open was last requested
   THistManager                                  fHistManager      ; ///< Manages access to all histograms
   AliEmcalList                                 *fOutput           ; //!<! List which owns the output histograms to be saved
   AliVEvent                                    *fExternalEvent    ; //!<! Current external event available for embedding
@@ -253,7 +283,7 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   AliAnalysisTaskEmcalEmbeddingHelper &operator=(const AliAnalysisTaskEmcalEmbeddingHelper&); // not implemented
 
   /// \cond CLASSIMP
-  ClassDef(AliAnalysisTaskEmcalEmbeddingHelper, 6);
+  ClassDef(AliAnalysisTaskEmcalEmbeddingHelper, 7);
   /// \endcond
 };
 #endif
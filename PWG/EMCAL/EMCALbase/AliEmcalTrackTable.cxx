@@ -0,0 +1,152 @@
+/**************************************************************************
+ * Copyright(c) 1998-2017, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+#include <TClonesArray.h>
+
+#include "AliVTrack.h"
+#include "AliPicoTrack.h"
+
+#include "AliEmcalTrackTable.h"
+
+/// \cond CLASSIMP
+ClassImp(AliEmcalTrackTable);
+/// \endcond
+
+/**
+ * Default constructor.
+ */
+AliEmcalTrackTable::AliEmcalTrackTable() :
+  TNamed(),
+  fMass(0.13957),
+  fPt(),
+  fEta(),
+  fPhi(),
+  fCharge(),
+  fLabel(),
+  fTrackType(),
+  fEtaEmc(),
+  fPhiEmc(),
+  fPtEmc(),
+  fEmcal(),
+  fFlag(),
+  fGeneratorIndex(),
+  fOrig(),
+  fPicoTracks(0),
+  fPicoTracksValid(kFALSE)
+{
+}
+
+/**
+ * Standard constructor.
+ * @param[in] name Name of the table, used to publish it in the event
+ */
+AliEmcalTrackTable::AliEmcalTrackTable(const char *name) :
+  TNamed(name, name),
+  fMass(0.13957),
+  fPt(),
+  fEta(),
+  fPhi(),
+  fCharge(),
+  fLabel(),
+  fTrackType(),
+  fEtaEmc(),
+  fPhiEmc(),
+  fPtEmc(),
+  fEmcal(),
+  fFlag(),
+  fGeneratorIndex(),
+  fOrig(),
+  fPicoTracks(0),
+  fPicoTracksValid(kFALSE)
+{
+}
+
+/**
+ * Remove all tracks (the capacity of the arrays is kept). The attached
+ * AliPicoTrack array is emptied as well, so that it never shows the tracks
+ * of a previous event.
+ */
+void AliEmcalTrackTable::Clear(Option_t *)
+{
+  fPt.clear();
+  fEta.clear();
+  fPhi.clear();
+  fCharge.clear();
+  fLabel.clear();
+  fTrackType.clear();
+  fEtaEmc.clear();
+  fPhiEmc.clear();
+  fPtEmc.clear();
+  fEmcal.clear();
+  fFlag.clear();
+  fGeneratorIndex.clear();
+  fOrig.clear();
+
+  if (fPicoTracks) fPicoTracks->Delete();
+  fPicoTracksValid = kFALSE;
+}
+
+/**
+ * Add a track to the table.
+ * @param[in] track Original track
+ * @param[in] type Track type (see AliPicoTrack::GetTrackType)
+ * @param[in] isEmc Whether the track points to the EMCal
+ * @return Index of the track in the table
+ */
+Int_t AliEmcalTrackTable::AddTrack(AliVTrack *track, Byte_t type, Bool_t isEmc)
+{
+  fPt.push_back(track->Pt());
+  fEta.push_back(track->Eta());
+  fPhi.push_back(track->Phi());
+  fCharge.push_back(track->Charge());
+  fLabel.push_back(track->GetLabel());
+  fTrackType.push_back(type);
+  fEtaEmc.push_back(track->GetTrackEtaOnEMCal());
+  fPhiEmc.push_back(track->GetTrackPhiOnEMCal());
+  fPtEmc.push_back(track->GetTrackPtOnEMCal());
+  fEmcal.push_back(isEmc);
+  fFlag.push_back(0);
+  fGeneratorIndex.push_back(-1);
+  fOrig.push_back(track);
+
+  fPicoTracksValid = kFALSE;
+
+  return fPt.size() - 1;
+}
+
+/**
+ * Get the attached array of AliPicoTrack, creating the objects of the
+ * current event if this was not done yet. The i-th object corresponds
+ * to the i-th entry of the table.
+ * @return Array of AliPicoTrack (NULL if no array is attached)
+ */
+TClonesArray *AliEmcalTrackTable::GetPicoTracks()
+{
+  if (!fPicoTracks || fPicoTracksValid) return fPicoTracks;
+
+  fPicoTracks->Delete();
+
+  const Int_t n = GetNTracks();
+  for (Int_t i = 0; i < n; i++) {
+    AliPicoTrack *picotrack = new ((*fPicoTracks)[i]) AliPicoTrack(fPt[i], fEta[i], fPhi[i], fCharge[i], fLabel[i], fTrackType[i],
+                                                                   fEtaEmc[i], fPhiEmc[i], fPtEmc[i], fEmcal[i], fMass);
+    picotrack->SetTrack(fOrig[i]);
+    picotrack->SetFlag(fFlag[i]);
+    picotrack->SetGeneratorIndex(fGeneratorIndex[i]);
+  }
+
+  fPicoTracksValid = kTRUE;
+
+  return fPicoTracks;
+}
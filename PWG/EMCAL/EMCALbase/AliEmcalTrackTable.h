@@ -0,0 +1,84 @@
+#ifndef ALIEMCALTRACKTABLE_H
+#define ALIEMCALTRACKTABLE_H
+/* Copyright(c) 1998-2017, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+#include <vector>
+
+#include <TNamed.h>
+
+class TClonesArray;
+class AliVTrack;
+
+/**
+ * @class AliEmcalTrackTable
+ * @brief Flat per-event table of tracks, alternative to a TClonesArray of AliPicoTrack
+ * @ingroup EMCALCOREFW
+ *
+ * Stores the information carried by AliPicoTrack (pt, eta, phi, charge, label,
+ * track type, propagation to the EMCal surface, MC flags) in one array per
+ * quantity. The arrays keep their capacity between events, so filling the table
+ * does not allocate once the largest event has been seen.
+ *
+ * The table can be attached to a TClonesArray of AliPicoTrack: the objects
+ * are only created (with the same index as in the table) when GetPicoTracks()
+ * is called, i.e. when a consumer needs AliVParticle objects.
+ */
+class AliEmcalTrackTable : public TNamed {
+ public:
+  AliEmcalTrackTable();
+  AliEmcalTrackTable(const char *name);
+  virtual ~AliEmcalTrackTable() {}
+
+  void                        Clear(Option_t *option="");
+  Int_t                       AddTrack(AliVTrack *track, Byte_t type, Bool_t isEmc);
+  void                        SetMCInfo(Int_t i, UInt_t flag, Short_t genIndex)  { fFlag[i] = flag; fGeneratorIndex[i] = genIndex; }
+
+  Int_t                       GetNTracks()                        const { return fPt.size()                   ; }
+  Double_t                    GetPt(Int_t i)                      const { return fPt[i]                       ; }
+  Double_t                    GetEta(Int_t i)                     const { return fEta[i]                      ; }
+  Double_t                    GetPhi(Int_t i)                     const { return fPhi[i]                      ; }
+  Double_t                    GetMass()                           const { return fMass                        ; }
+  Short_t                     GetCharge(Int_t i)                  const { return (char)fCharge[i]             ; }
+  Int_t                       GetLabel(Int_t i)                   const { return fLabel[i]                    ; }
+  Byte_t                      GetTrackType(Int_t i)               const { return fTrackType[i]                ; }
+  Double_t                    GetTrackEtaOnEMCal(Int_t i)         const { return fEtaEmc[i]                   ; }
+  Double_t                    GetTrackPhiOnEMCal(Int_t i)         const { return fPhiEmc[i]                   ; }
+  Double_t                    GetTrackPtOnEMCal(Int_t i)          const { return fPtEmc[i]                    ; }
+  Bool_t                      IsEMCAL(Int_t i)                    const { return fEmcal[i]                    ; }
+  UInt_t                      GetFlag(Int_t i)                    const { return fFlag[i]                     ; }
+  Short_t                     GetGeneratorIndex(Int_t i)          const { return fGeneratorIndex[i]           ; }
+  AliVTrack                  *GetTrack(Int_t i)                   const { return fOrig[i]                     ; }
+
+  void                        SetPicoTrackArray(TClonesArray *array)    { fPicoTracks = array; fPicoTracksValid = kFALSE; }
+  TClonesArray               *GetPicoTrackArray()                 const { return fPicoTracks                  ; }
+  Bool_t                      HasPicoTracks()                     const { return fPicoTracksValid             ; }
+  TClonesArray               *GetPicoTracks();
+
+ protected:
+  Double_t                    fMass;                    ///< mass hypothesis of the tracks (same as AliPicoTrack)
+  std::vector<Double_t>       fPt;                      //!<! pt at vertex
+  std::vector<Double_t>       fEta;                     //!<! eta at vertex
+  std::vector<Double_t>       fPhi;                     //!<! phi at vertex
+  std::vector<Byte_t>         fCharge;                  //!<! charge
+  std::vector<Int_t>          fLabel;                   //!<! label
+  std::vector<Byte_t>         fTrackType;               //!<! track type (see AliPicoTrack::GetTrackType)
+  std::vector<Double_t>       fEtaEmc;                  //!<! eta at the EMCal surface
+  std::vector<Double_t>       fPhiEmc;                  //!<! phi at the EMCal surface
+  std::vector<Double_t>       fPtEmc;                   //!<! pt at the EMCal surface
+  std::vector<Byte_t>         fEmcal;                   //!<! whether the track points to the EMCal
+  std::vector<UInt_t>         fFlag;                    //!<! MC flag (primary etc.)
+  std::vector<Short_t>        fGeneratorIndex;          //!<! MC generator index
+  std::vector<AliVTrack*>     fOrig;                    //!<! original tracks
+  TClonesArray               *fPicoTracks;              //!<! array of AliPicoTrack filled on request (not owned)
+  Bool_t                      fPicoTracksValid;         //!<! whether fPicoTracks holds the tracks of the current event
+
+ private:
+  AliEmcalTrackTable(const AliEmcalTrackTable&);            // not implemented
+  AliEmcalTrackTable &operator=(const AliEmcalTrackTable&); // not implemented
+
+  /// \cond CLASSIMP
+  ClassDef(AliEmcalTrackTable, 1);
+  /// \endcond
+};
+#endif
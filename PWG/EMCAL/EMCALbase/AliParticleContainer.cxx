@@ -21,6 +21,8 @@
 #include "AliLog.h"
 
 #include "AliTLorentzVector.h"
+#include "AliEmcalTrackTable.h"
+#include "AliAnalysisTaskEmcalEmbeddingHelper.h"
 #include "AliParticleContainer.h"
 
 /// \cond CLASSIMP
@@ -37,7 +39,9 @@ AliParticleContainer::AliParticleContainer():
   AliEmcalContainer(),
   fMinDistanceTPCSectorEdge(-1),
   fChargeCut(kNoChargeCut),
-  fGeneratorIndex(-1)
+  fGeneratorIndex(-1),
+  fUseTrackTable(kFALSE),
+  fTrackTable(0)
 {
   fBaseClassName = "AliVParticle";
   SetClassName("AliVParticle");
@@ -51,7 +55,9 @@ AliParticleContainer::AliParticleContainer(const char *name) :
   AliEmcalContainer(name),
   fMinDistanceTPCSectorEdge(-1),
   fChargeCut(kNoChargeCut),
-  fGeneratorIndex(-1)
+  fGeneratorIndex(-1),
+  fUseTrackTable(kFALSE),
+  fTrackTable(0)
 {
   fBaseClassName = "AliVParticle";
   SetClassName("AliVParticle");
@@ -460,6 +466,122 @@ void AliParticleContainer::SetArray(const AliVEvent * event)
 
   // Register TClonesArray in index map
   fgEmcalContainerIndexMap.RegisterArray(GetArray());
+
+  // Flat track table produced together with the array (if any)
+  if (fClArray && !fTrackTable) {
+    if (fIsEmbedding) {
+      const AliAnalysisTaskEmcalEmbeddingHelper* embedding = AliAnalysisTaskEmcalEmbeddingHelper::GetInstance();
+      event = embedding ? embedding->GetExternalEvent() : 0;
+    }
+    if (event) fTrackTable = dynamic_cast<AliEmcalTrackTable*>(event->FindListObject(fClArrayName + "_Table"));
+  }
+}
+
+/**
+ * Preparation for the next event. If the array comes with a flat track table
+ * and the table is not iterated directly, make sure that the AliPicoTrack
+ * objects of the event exist (they may be created on request only).
+ */
+void AliParticleContainer::NextEvent()
+{
+  if (fTrackTable && !fUseTrackTable) fTrackTable->GetPicoTracks();
+}
+
+/**
+ * Perform the particle selection on the \f$ i^{th} \f$ entry of the flat track
+ * table, without accessing the AliPicoTrack objects. The selection is identical
+ * to AcceptParticle(i, rejectionReason). A selection on the object bits
+ * (SetBitMap) needs the objects, which are then created.
+ * @param[in] i Index of the track in the table
+ * @param[out] rejectionReason Bitmap with the reason why the particle was rejected.
+ * Note: The value is not set to 0 in the function in order to combine the information
+ * with other selection steps.
+ * @return True if the particle was accepted, false otherwise
+ */
+Bool_t AliParticleContainer::AcceptTrackTableEntry(Int_t i, UInt_t &rejectionReason) const
+{
+  if (!fTrackTable || i < 0 || i >= fTrackTable->GetNTracks()) {
+    rejectionReason |= kNullObject;
+    return kFALSE;
+  }
+
+  if (fBitMap != 0) {
+    fTrackTable->GetPicoTracks();
+    return AcceptParticle(i, rejectionReason);
+  }
+
+  Int_t label = TMath::Abs(fTrackTable->GetLabel(i));
+
+  if (fMinMCLabel >= 0 && label < fMinMCLabel) {
+    rejectionReason |= kMCLabelCut;
+    return kFALSE;
+  }
+
+  if (fMaxMCLabel >= 0 && label > fMaxMCLabel) {
+    rejectionReason |= kMCLabelCut;
+    return kFALSE;
+  }
+
+  Short_t charge = fTrackTable->GetCharge(i);
+  if ((fChargeCut == kCharged && charge == 0) ||
+      (fChargeCut == kNeutral && charge != 0) ||
+      (fChargeCut == kPositiveCharge && charge <= 0) ||
+      (fChargeCut == kNegativeCharge && charge >= 0)) {
+    rejectionReason |= kChargeCut;
+    return kFALSE;
+  }
+
+  if (fGeneratorIndex >= 0 && fGeneratorIndex != fTrackTable->GetGeneratorIndex(i)) {
+    rejectionReason |= kMCGeneratorCut;
+    return kFALSE;
+  }
+
+  AliTLorentzVector mom;
+  GetTrackTableMomentum(mom, i);
+
+  return ApplyKinematicCuts(mom, rejectionReason);
+}
+
+/**
+ * Fill a TLorentzVector with the momentum of the \f$ i^{th} \f$ entry of the flat
+ * track table, using the global mass hypothesis (same as GetMomentum(mom, i)).
+ * @param[out] mom Momentum vector to be filled
+ * @param[in] i Index of the track in the table
+ * @return True if the request was successfull, false otherwise
+ */
+Bool_t AliParticleContainer::GetTrackTableMomentum(TLorentzVector &mom, Int_t i) const
+{
+  if (fTrackTable && i >= 0 && i < fTrackTable->GetNTracks() &&
+      fTrackTable->GetEta(i) < 1e6 && fTrackTable->GetEta(i) > -1e6) { // protection against FPE in sinh(eta)
+    Double_t mass = fMassHypothesis;
+    if (mass < 0) mass = fTrackTable->GetMass();
+    mom.SetPtEtaPhiM(fTrackTable->GetPt(i), fTrackTable->GetEta(i), fTrackTable->GetPhi(i), mass);
+    return kTRUE;
+  }
+  else {
+    mom.SetPtEtaPhiM(0, 0, 0, 0);
+    return kFALSE;
+  }
+}
+
+/**
+ * Iterator over the accepted entries of the flat track table. Uses the same
+ * current index as the other iterators (reset with ResetCurrentID()).
+ * @return Index of the next accepted entry (-1 if the end is reached)
+ */
+Int_t AliParticleContainer::GetNextAcceptTrackTableEntry()
+{
+  if (!fTrackTable) return -1;
+
+  const Int_t n = fTrackTable->GetNTracks();
+  UInt_t rejectionReason = 0;
+  do {
+    fCurrentID++;
+    if (fCurrentID >= n) return -1;
+    rejectionReason = 0;
+  } while (!AcceptTrackTableEntry(fCurrentID, rejectionReason));
+
+  return fCurrentID;
 }
 
 /**
@@ -8,6 +8,7 @@
 
 class AliVEvent;
 class AliTLorentzVector;
+class AliEmcalTrackTable;
 
 #include "AliEmcalContainer.h"
 #if !(defined(__CINT__) || defined(__MAKECINT__))
@@ -27,6 +28,12 @@ typedef EMCALIterableContainer::AliEmcalIterableContainerT<AliVParticle, EMCALIt
  * @author Salvatore Aiola <salvatore.aiola@cern.ch>, Yale University
  *
  * Container with name, TClonesArray and cuts for particles
+ *
+ * If the array was produced together with a flat track table (AliEmcalTrackTable,
+ * published as "<array name>_Table", see AliEmcalPicoTrackMaker), the container
+ * picks it up. With SetUseTrackTable(kTRUE) the task iterates the table directly
+ * (GetNextAcceptTrackTableEntry, AcceptTrackTableEntry, GetTrackTableMomentum);
+ * otherwise the AliPicoTrack objects are created from the table at each event.
  */
 class AliParticleContainer : public AliEmcalContainer {
  public:
@@ -76,6 +83,14 @@ class AliParticleContainer : public AliEmcalContainer {
   void                        SelectHIJING(Bool_t s)                            { if (s) fGeneratorIndex = 0; else fGeneratorIndex = -1; }
   void                        SetGeneratorIndex(Short_t i)                      { fGeneratorIndex = i  ; }
   void                        SetArray(const AliVEvent * event);
+  void                        NextEvent();
+
+  void                        SetUseTrackTable(Bool_t b)                        { fUseTrackTable = b   ; }
+  Bool_t                      GetUseTrackTable()                        const   { return fUseTrackTable; }
+  AliEmcalTrackTable         *GetTrackTable()                           const   { return fTrackTable   ; }
+  virtual Bool_t              AcceptTrackTableEntry(Int_t i, UInt_t &rejectionReason) const;
+  Bool_t                      GetTrackTableMomentum(TLorentzVector &mom, Int_t i) const;
+  Int_t                       GetNextAcceptTrackTableEntry();
 
   const char*                 GetTitle() const;
 
@@ -99,13 +114,15 @@ class AliParticleContainer : public AliEmcalContainer {
   Double_t                    fMinDistanceTPCSectorEdge;      ///< require minimum distance to edge of TPC sector edge
   EChargeCut_t                fChargeCut;                     ///< select particles according to their charge
   Short_t                     fGeneratorIndex;                ///< select MC particles with generator index (default = -1 = switch off selection)
+  Bool_t                      fUseTrackTable;                 ///< iterate the flat track table instead of creating the AliPicoTrack objects
+  AliEmcalTrackTable         *fTrackTable;                    //!<! flat track table published with the array (if any)
 
  private:
   AliParticleContainer(const AliParticleContainer& obj); // copy constructor
   AliParticleContainer& operator=(const AliParticleContainer& other); // assignment
 
   /// \cond CLASSIMP
-  ClassDef(AliParticleContainer,11);
+  ClassDef(AliParticleContainer,12);
   /// \endcond
 
 };
@@ -24,6 +24,7 @@
 #include "AliTLorentzVector.h"
 #include "AliEmcalTrackSelectionAOD.h"
 #include "AliEmcalTrackSelectionESD.h"
+#include "AliEmcalTrackTable.h"
 #include "AliTrackContainer.h"
 
 /// \cond CLASSIMP
@@ -151,6 +152,9 @@ void AliTrackContainer::SetArray(const AliVEvent *event)
  */
 void AliTrackContainer::NextEvent()
 {
+  // The track selection works on the objects: create them if the array comes with a flat track table
+  if (fTrackTable) fTrackTable->GetPicoTracks();
+
   fTrackTypes.Reset(kUndefined);
   if (fEmcalTrackSelection) {
     fFilteredTracks = fEmcalTrackSelection->GetAcceptedTracks(fClArray);
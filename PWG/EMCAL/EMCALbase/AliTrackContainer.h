@@ -52,6 +52,7 @@ class AliTrackContainer : public AliParticleContainer {
   virtual Bool_t              AcceptObject(const TObject* obj, UInt_t &rejectionReason) const             { return AcceptTrack(dynamic_cast<const AliVTrack*>(obj), rejectionReason); }
   virtual Bool_t              AcceptParticle(Int_t i, UInt_t &rejectionReason) const                      { return AcceptTrack(i, rejectionReason); }
   virtual Bool_t              AcceptParticle(const AliVParticle* vp, UInt_t &rejectionReason) const       { return AcceptTrack(dynamic_cast<const AliVTrack*>(vp), rejectionReason); }
+  virtual Bool_t              AcceptTrackTableEntry(Int_t i, UInt_t &rejectionReason) const               { return AcceptTrack(i, rejectionReason); }
   virtual AliVParticle       *GetParticle(Int_t i=-1)                const { return GetTrack(i)           ; }
   virtual AliVParticle       *GetAcceptParticle(Int_t i=-1)          const { return GetAcceptTrack(i)     ; }
   virtual AliVParticle       *GetNextAcceptParticle()                      { return GetNextAcceptTrack()  ; }
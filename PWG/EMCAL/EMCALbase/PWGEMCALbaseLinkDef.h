@@ -15,6 +15,7 @@
 #pragma link C++ class AliEmcalAODFilterBitCuts+;
 #pragma link C++ class AliEmcalESDTrackCutsGenerator+;
 #pragma link C++ class AliEmcalParticle+;
+#pragma link C++ class AliEmcalTrackTable+;
 #pragma link C++ class AliEmcalPhysicsSelection+;
 #pragma link C++ class AliEmcalPythiaInfo+;
 #pragma link C++ class AliEmcalTrackSelResultPtr+;
@@ -115,6 +115,19 @@ void AliEmcalCorrectionCellCombineCollections::SetupCombinedCells()
   fInitializedCombinedCells = true;
 }
 
+/**
+ * Besides the configured cells, the component reads the cells of the external event and fills the
+ * combined cells, which are used by the components configured with them.
+ *
+ * @param[out] keys Keys of the shared state accessed by the component
+ */
+void AliEmcalCorrectionCellCombineCollections::GetSharedStateKeys(std::set <std::string> & keys) const
+{
+  AliEmcalCorrectionComponent::GetSharedStateKeys(keys);
+  keys.insert(GetInputObjectKey(AliEmcalContainerUtils::kCaloCells, true, fExternalCellsBranchName));
+  keys.insert(GetInputObjectKey(AliEmcalContainerUtils::kCaloCells, false, fCreatedCellsBranchName));
+}
+
 /**
  * Run each event to fill the combined cells from input and external cells.
  * Note that the combined cells object should have already been created.
@@ -186,7 +199,7 @@ void AliEmcalCorrectionCellCombineCollections::AddCellsToCombinedCellObject(AliV
   {
     getCellResult = inputCells->GetCell(i, cellNumber, ampltidue, time, mcLabel, eFrac);
     if (!getCellResult) {
-      AliWarning(TString::Format("Could not get cell %i from cell collection %s", i, inputCells->GetName()));
+      AliEmcalCorrectionWarning(TString::Format("Could not get cell %i from cell collection %s", i, inputCells->GetName()));
     }
     // Get high gain attribute in addition to cell
     cellHighGain = inputCells->GetCellHighGain(i);
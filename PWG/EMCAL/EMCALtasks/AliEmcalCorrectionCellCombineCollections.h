@@ -37,6 +37,8 @@ class AliEmcalCorrectionCellCombineCollections : public AliEmcalCorrectionCompon
   void UserCreateOutputObjects();
   void ExecOnce();
   Bool_t Run();
+  Bool_t RequiresSequentialExecution() const { return kFALSE; }
+  void GetSharedStateKeys(std::set <std::string> & keys) const;
 
   std::string GetExternalCellsBranchName()                      const { return fExternalCellsBranchName; }
   std::string GetCombinedCellsBranchName()                      const { return fCreatedCellsBranchName; }
@@ -81,7 +81,7 @@ Bool_t AliEmcalCorrectionCellEnergy::Run()
   AliEmcalCorrectionComponent::Run();
   
   if (!fEventManager.InputEvent()) {
-    AliError("Event ptr = 0, returning");
+    AliEmcalCorrectionError("Event ptr = 0, returning");
     return kFALSE;
   }
   
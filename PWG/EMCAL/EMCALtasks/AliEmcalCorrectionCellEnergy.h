@@ -32,6 +32,8 @@ class AliEmcalCorrectionCellEnergy : public AliEmcalCorrectionComponent {
   void UserCreateOutputObjects();
   Bool_t Run();
   Bool_t CheckIfRunChanged();
+  /// Only its own AliEMCALRecoUtils, histograms and input objects are accessed in Run()
+  Bool_t RequiresSequentialExecution() const { return kFALSE; }
   
 protected:
   TH1F* fCellEnergyDistBefore;        //!<! cell energy distribution, before energy calibration
@@ -83,7 +83,7 @@ Bool_t AliEmcalCorrectionCellTimeCalib::Run()
   AliEmcalCorrectionComponent::Run();
   
   if (!fEventManager.InputEvent()) {
-    AliError("Event ptr = 0, returning");
+    AliEmcalCorrectionError("Event ptr = 0, returning");
     return kFALSE;
   }
 
@@ -107,7 +107,7 @@ Bool_t AliEmcalCorrectionCellTimeCalib::Run()
   // Test if cells present
   if (fCaloCells->GetNumberOfCells()<=0)
   {
-    AliWarning(Form("Number of EMCAL cells = %d, returning", fCaloCells->GetNumberOfCells()));
+    AliEmcalCorrectionWarning(Form("Number of EMCAL cells = %d, returning", fCaloCells->GetNumberOfCells()));
     return kFALSE;
   }
   
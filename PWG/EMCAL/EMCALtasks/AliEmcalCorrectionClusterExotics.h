@@ -33,6 +33,8 @@ class AliEmcalCorrectionClusterExotics : public AliEmcalCorrectionComponent {
   Bool_t Initialize();
   void UserCreateOutputObjects();
   Bool_t Run();
+  /// Only its own AliEMCALRecoUtils, histograms and input objects are accessed in Run()
+  Bool_t RequiresSequentialExecution() const { return kFALSE; }
 
 protected:
   TH2F                  *fEtaPhiDistBefore;          //!<!eta/phi distribution before
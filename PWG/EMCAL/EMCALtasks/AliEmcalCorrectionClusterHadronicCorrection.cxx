@@ -551,7 +551,7 @@ void AliEmcalCorrectionClusterHadronicCorrection::DoMatchedTracksLoop(Int_t iclu
       track = static_cast<AliVTrack*>(cluster->GetTrackMatched(i));
       UInt_t rejectionReason = 0;
       AliParticleContainer * partCont = GetParticleContainer(0);
-      if (!partCont) { AliError("No particle container available!"); }
+      if (!partCont) { AliEmcalCorrectionError("No particle container available!"); }
       if (!partCont->AcceptParticle(track, rejectionReason)) track = 0;
     }
     
@@ -645,7 +645,7 @@ Double_t AliEmcalCorrectionClusterHadronicCorrection::ApplyHadCorrOneTrack(Int_t
       track = static_cast<AliVTrack*>(cluster->GetTrackMatched(0));
       UInt_t rejectionReason = 0;
       AliParticleContainer * partCont = GetParticleContainer(0);
-      if (!partCont) { AliError("No particle container available!"); }
+      if (!partCont) { AliEmcalCorrectionError("No particle container available!"); }
       if (!partCont->AcceptParticle(track, rejectionReason)) track = 0;
     }
   }
@@ -804,7 +804,7 @@ Double_t AliEmcalCorrectionClusterHadronicCorrection::ApplyHadCorrAllTracks(Int_
           track = static_cast<AliVTrack*>(cluster->GetTrackMatched(0));
           UInt_t rejectionReason = 0;
           AliParticleContainer * partCont = GetParticleContainer(0);
-          if (!partCont) { AliError("No particle container available!"); }
+          if (!partCont) { AliEmcalCorrectionError("No particle container available!"); }
           if (!partCont->AcceptParticle(track, rejectionReason)) track = 0;
         }
         if (track) {
@@ -41,6 +41,8 @@ class AliEmcalCorrectionClusterHadronicCorrection : public AliEmcalCorrectionCom
   void UserCreateOutputObjects();
   void ExecOnce();
   Bool_t Run();
+  /// Only its own AliEMCALRecoUtils, histograms and input objects are accessed in Run()
+  Bool_t RequiresSequentialExecution() const { return kFALSE; }
   
 protected:
   Double_t               ApplyHadCorrOneTrack(Int_t icluster, Double_t hadCorr);
@@ -36,6 +36,8 @@ class AliEmcalCorrectionClusterNonLinearity : public AliEmcalCorrectionComponent
   Bool_t Initialize();
   void UserCreateOutputObjects();
   Bool_t Run();
+  /// Only its own AliEMCALRecoUtils, histograms and input objects are accessed in Run()
+  Bool_t RequiresSequentialExecution() const { return kFALSE; }
 
 protected:
   TH1F                  *fEnergyDistBefore;          //!<!energy distribution before
@@ -3,8 +3,15 @@
 
 #include "AliEmcalCorrectionClusterTrackMatcher.h"
 
+#include <algorithm>
+#include <limits>
+
 #include <TH1.h>
 #include <TList.h>
+#include <TMath.h>
+#include <TRandom3.h>
+#include <TVector2.h>
+#include <TVector3.h>
 
 #include "AliClusterContainer.h"
 #include "AliParticleContainer.h"
@@ -37,6 +44,7 @@ AliEmcalCorrectionClusterTrackMatcher::AliEmcalCorrectionClusterTrackMatcher() :
   fUseDCA(kTRUE),
   fUpdateTracks(kTRUE),
   fUpdateClusters(kTRUE),
+  fUseMatchingGrid(kTRUE),
   fClusterContainerIndexMap(),
   fParticleContainerIndexMap(),
   fEmcalTracks(0),
@@ -45,6 +53,19 @@ AliEmcalCorrectionClusterTrackMatcher::AliEmcalCorrectionClusterTrackMatcher() :
   fNEmcalClusters(0),
   fHistMatchEtaAll(0),
   fHistMatchPhiAll(0),
+  fTrackEtaOnEmcal(),
+  fTrackPhiOnEmcal(),
+  fClusterEta(),
+  fClusterPhi(),
+  fGridEtaMin(0),
+  fGridEtaCellSize(0),
+  fGridPhiCellSize(0),
+  fGridNEta(0),
+  fGridNPhi(0),
+  fGridCellStart(),
+  fGridClusters(),
+  fGridUnbinned(),
+  fGridCandidates(),
   fNMCGenerToAccept(0),
   fMCGenerToAcceptForTrack(1)
 {
@@ -81,6 +102,7 @@ Bool_t AliEmcalCorrectionClusterTrackMatcher::Initialize()
   GetProperty("maxDist", fMaxDistance);
   GetProperty("updateClusters", fUpdateClusters);
   GetProperty("updateTracks", fUpdateTracks);
+  GetProperty("useMatchingGrid", fUseMatchingGrid);
   fDoPropagation = fEsdMode;
   
   Bool_t enableFracEMCRecalc = kFALSE;
@@ -184,6 +206,18 @@ void AliEmcalCorrectionClusterTrackMatcher::ExecOnce()
   fParticleContainerIndexMap.CopyMappingFrom(AliParticleContainer::GetEmcalContainerIndexMap(), fParticleCollArray);
 }
 
+/**
+ * The MC generator selection reads the MC event, which is shared between components. The track
+ * propagation (gGeoManager and magnetic field) is serialised with LockTrackPropagation() instead.
+ *
+ * @param[out] keys Keys of the shared state accessed by the component
+ */
+void AliEmcalCorrectionClusterTrackMatcher::GetSharedStateKeys(std::set <std::string> & keys) const
+{
+  AliEmcalCorrectionComponent::GetSharedStateKeys(keys);
+  if (fMCEvent) keys.insert("AliMCEvent");
+}
+
 /**
  * Called for each event to process the event data.
  */
@@ -334,7 +368,9 @@ void AliEmcalCorrectionClusterTrackMatcher::GenerateEmcalParticles()
         }
         
         // Propagate the track
+        LockTrackPropagation();
         AliEMCALRecoUtils::ExtrapolateTrackToEMCalSurface(track, fPropDist, mass, 20, 0.35, kFALSE, fUseDCA);
+        UnlockTrackPropagation();
       }
 
       // Reset properties of the track to fix TRefArray errors which occur when AddTrackMatched(obj) is called.
@@ -364,50 +400,338 @@ void AliEmcalCorrectionClusterTrackMatcher::GenerateEmcalParticles()
 
 /**
  * Set the links between tracks and clusters.
+ *
+ * Tracks are only compared to clusters in the neighbouring cells of the
+ * eta-phi grid (if enabled). For each track the candidate clusters are
+ * processed in increasing index order, the same order as in the loop over
+ * all clusters, so the matched lists and histograms are identical.
  */
 void AliEmcalCorrectionClusterTrackMatcher::DoMatching()
 {
   const Double_t maxd2 = fMaxDistance*fMaxDistance;
 
+  FillEtaPhiOnEmcal();
+  Bool_t useGrid = fUseMatchingGrid && BuildMatchingGrid(fMaxDistance);
+
   for (Int_t itrack = 0; itrack < fNEmcalTracks; itrack++) {
-    AliEmcalParticle* emcalTrack = static_cast<AliEmcalParticle*>(fEmcalTracks->At(itrack));
-    AliVTrack* track = emcalTrack->GetTrack();
+    if (useGrid) {
+      FindMatchingCandidates(fTrackEtaOnEmcal[itrack], fTrackPhiOnEmcal[itrack]);
+      for (std::vector<Int_t>::const_iterator icluster = fGridCandidates.begin(); icluster != fGridCandidates.end(); ++icluster) {
+        MatchTrackCluster(itrack, *icluster, maxd2);
+      }
+    }
+    else {
+      for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
+        MatchTrackCluster(itrack, icluster, maxd2);
+      }
+    }
+  }
+}
 
-    for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
-      AliEmcalParticle* emcalCluster = static_cast<AliEmcalParticle*>(fEmcalClusters->At(icluster));
-      AliVCluster* cluster = emcalCluster->GetCluster();
-      
-      Double_t deta = 999;
-      Double_t dphi = 999;
-      GetEtaPhiDiff(track, cluster, dphi, deta);
-      Double_t d2 = deta * deta + dphi * dphi;
+/**
+ * Check a single track-cluster combination and set the link if they are within the matching distance.
+ * @param[in] itrack Index of the track in fEmcalTracks
+ * @param[in] icluster Index of the cluster in fEmcalClusters
+ * @param[in] maxd2 Square of the maximum matching distance
+ */
+void AliEmcalCorrectionClusterTrackMatcher::MatchTrackCluster(Int_t itrack, Int_t icluster, Double_t maxd2)
+{
+  AliEmcalParticle* emcalTrack = static_cast<AliEmcalParticle*>(fEmcalTracks->At(itrack));
+  AliVTrack* track = emcalTrack->GetTrack();
+  AliEmcalParticle* emcalCluster = static_cast<AliEmcalParticle*>(fEmcalClusters->At(icluster));
+  AliVCluster* cluster = emcalCluster->GetCluster();
+
+  Double_t deta = 999;
+  Double_t dphi = 999;
+  if (track && cluster) {
+    GetEtaPhiResidual(fTrackEtaOnEmcal[itrack], fTrackPhiOnEmcal[itrack], fClusterEta[icluster], fClusterPhi[icluster], deta, dphi);
+  }
+  else {
+    GetEtaPhiDiff(track, cluster, dphi, deta);
+  }
+  Double_t d2 = deta * deta + dphi * dphi;
+
+  if (d2 > maxd2) return;
+
+  Double_t d = TMath::Sqrt(d2);
+  emcalCluster->AddMatchedObj(itrack, d);
+  emcalTrack->AddMatchedObj(icluster, d);
+  AliDebug(2, Form("Now matching cluster E = %.3f, pT = %.3f, eta = %.3f, phi = %.3f "
+                   "with track pT = %.3f, eta = %.3f, phi = %.3f"
+                   "Track eta, phi on EMCal = %.3f, %.3f, d = %.3f",
+                   cluster->GetNonLinCorrEnergy(), emcalCluster->Pt(), emcalCluster->Eta(), emcalCluster->Phi(),
+                   emcalTrack->Pt(), emcalTrack->Eta(), emcalTrack->Phi(),
+                   track->GetTrackEtaOnEMCal(), track->GetTrackPhiOnEMCal(), d));
+
+  if (fCreateHisto) {
+    Int_t mombin = GetMomBin(track->P());
+    Int_t centbinch = fCentBin;
+    if (track->Charge() < 0) centbinch += fNcentBins;
+    Int_t etabin = 0;
+    if(track->Eta() > 0) etabin = 1;
+
+    fHistMatchEta[centbinch][mombin][etabin]->Fill(deta);
+    fHistMatchPhi[centbinch][mombin][etabin]->Fill(dphi);
+    fHistMatchEtaAll->Fill(deta);
+    fHistMatchPhiAll->Fill(dphi);
+  }
+}
 
-      if (d2 > maxd2) continue;
-      
-      Double_t d = TMath::Sqrt(d2);
-      emcalCluster->AddMatchedObj(itrack, d);
-      emcalTrack->AddMatchedObj(icluster, d);
-      AliDebug(2, Form("Now matching cluster E = %.3f, pT = %.3f, eta = %.3f, phi = %.3f "
-                       "with track pT = %.3f, eta = %.3f, phi = %.3f"
-                       "Track eta, phi on EMCal = %.3f, %.3f, d = %.3f",
-                       cluster->GetNonLinCorrEnergy(), emcalCluster->Pt(), emcalCluster->Eta(), emcalCluster->Phi(),
-                       emcalTrack->Pt(), emcalTrack->Eta(), emcalTrack->Phi(),
-                       track->GetTrackEtaOnEMCal(), track->GetTrackPhiOnEMCal(), d));
-      
-      if (fCreateHisto) {
-        Int_t mombin = GetMomBin(track->P());
-        Int_t centbinch = fCentBin;
-        if (track->Charge() < 0) centbinch += fNcentBins;
-        Int_t etabin = 0;
-        if(track->Eta() > 0) etabin = 1;
-
-        fHistMatchEta[centbinch][mombin][etabin]->Fill(deta);
-        fHistMatchPhi[centbinch][mombin][etabin]->Fill(dphi);
-        fHistMatchEtaAll->Fill(deta);
-        fHistMatchPhiAll->Fill(dphi);
-      }
+/**
+ * Cache eta and phi of the tracks on the EMCal surface and of the clusters,
+ * calculated in the same way as in GetEtaPhiDiff.
+ */
+void AliEmcalCorrectionClusterTrackMatcher::FillEtaPhiOnEmcal()
+{
+  const Double_t kNaN = std::numeric_limits<Double_t>::quiet_NaN();
+
+  fTrackEtaOnEmcal.resize(fNEmcalTracks);
+  fTrackPhiOnEmcal.resize(fNEmcalTracks);
+  for (Int_t itrack = 0; itrack < fNEmcalTracks; itrack++) {
+    AliVTrack* track = static_cast<AliEmcalParticle*>(fEmcalTracks->At(itrack))->GetTrack();
+    fTrackEtaOnEmcal[itrack] = track ? track->GetTrackEtaOnEMCal() : kNaN;
+    fTrackPhiOnEmcal[itrack] = track ? track->GetTrackPhiOnEMCal() : kNaN;
+  }
+
+  fClusterEta.resize(fNEmcalClusters);
+  fClusterPhi.resize(fNEmcalClusters);
+  for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
+    AliVCluster* cluster = static_cast<AliEmcalParticle*>(fEmcalClusters->At(icluster))->GetCluster();
+    if (!cluster) {
+      fClusterEta[icluster] = kNaN;
+      fClusterPhi[icluster] = kNaN;
+      continue;
     }
+    Float_t pos[3] = {0};
+    cluster->GetPosition(pos);
+    TVector3 cpos(pos);
+    fClusterEta[icluster] = cpos.Eta();
+    fClusterPhi[icluster] = cpos.Phi();
+  }
+}
+
+/**
+ * Calculate the eta-phi residuals between track and cluster. Same arithmetic as in GetEtaPhiDiff.
+ */
+void AliEmcalCorrectionClusterTrackMatcher::GetEtaPhiResidual(Double_t trackEta, Double_t trackPhi, Double_t clusterEta, Double_t clusterPhi, Double_t &deta, Double_t &dphi)
+{
+  deta = trackEta - clusterEta;
+  dphi = TVector2::Phi_mpi_pi(trackPhi - clusterPhi);
+}
+
+/**
+ * Sort the clusters into an eta-phi grid, with a cell size of at least the
+ * matching distance in each direction. Clusters without valid position
+ * are kept in a separate list and compared to every track.
+ * @param[in] maxDist Maximum matching distance
+ * @return False if the grid cannot be used for this matching distance
+ */
+Bool_t AliEmcalCorrectionClusterTrackMatcher::BuildMatchingGrid(Double_t maxDist)
+{
+  const Int_t kMaxCellsEta = 200;
+  const Int_t kMaxCellsPhi = 360;
+
+  // Margin on the cell size protects against rounding at the cell borders
+  Double_t cellsize = maxDist * (1. + 1e-6);
+  if (!(cellsize > 0) || !TMath::Finite(cellsize)) return kFALSE;
+
+  const Int_t nclusters = fClusterEta.size();
+  Double_t etamin = 0, etamax = 0;
+  Bool_t first = kTRUE;
+  fGridUnbinned.clear();
+  for (Int_t icluster = 0; icluster < nclusters; icluster++) {
+    if (!TMath::Finite(fClusterEta[icluster]) || !TMath::Finite(fClusterPhi[icluster])) {
+      fGridUnbinned.push_back(icluster);
+      continue;
+    }
+    if (first || fClusterEta[icluster] < etamin) etamin = fClusterEta[icluster];
+    if (first || fClusterEta[icluster] > etamax) etamax = fClusterEta[icluster];
+    first = kFALSE;
+  }
+
+  fGridEtaMin = etamin;
+  fGridEtaCellSize = cellsize;
+  if ((etamax - etamin) / cellsize >= kMaxCellsEta - 1) fGridEtaCellSize = (etamax - etamin) / (kMaxCellsEta - 1);
+  fGridNEta = static_cast<Int_t>((etamax - etamin) / fGridEtaCellSize) + 1;
+  if (fGridNEta > kMaxCellsEta) fGridNEta = kMaxCellsEta;
+
+  // Cells in phi need to cover the full circle. With less than 3 cells all cells are neighbours.
+  fGridNPhi = static_cast<Int_t>(TMath::TwoPi() / cellsize);
+  if (fGridNPhi > kMaxCellsPhi) fGridNPhi = kMaxCellsPhi;
+  if (fGridNPhi < 3) fGridNPhi = 1;
+  fGridPhiCellSize = TMath::TwoPi() / fGridNPhi;
+
+  // Counting sort of the clusters into the cells, keeping the index order within each cell
+  const Int_t ncells = fGridNEta * fGridNPhi;
+  fGridCellStart.assign(ncells + 1, 0);
+  std::vector<Int_t> cellOfCluster(nclusters, -1);
+  for (Int_t icluster = 0; icluster < nclusters; icluster++) {
+    if (!TMath::Finite(fClusterEta[icluster]) || !TMath::Finite(fClusterPhi[icluster])) continue;
+    Int_t ieta = static_cast<Int_t>((fClusterEta[icluster] - fGridEtaMin) / fGridEtaCellSize);
+    if (ieta >= fGridNEta) ieta = fGridNEta - 1;
+    Double_t phi = fClusterPhi[icluster] - TMath::TwoPi() * TMath::Floor(fClusterPhi[icluster] / TMath::TwoPi());
+    Int_t iphi = static_cast<Int_t>(phi / fGridPhiCellSize);
+    if (iphi >= fGridNPhi) iphi = fGridNPhi - 1;
+    if (iphi < 0) iphi = 0;
+    cellOfCluster[icluster] = ieta * fGridNPhi + iphi;
+    fGridCellStart[cellOfCluster[icluster] + 1]++;
+  }
+  for (Int_t icell = 0; icell < ncells; icell++) fGridCellStart[icell + 1] += fGridCellStart[icell];
+  fGridClusters.resize(fGridCellStart[ncells]);
+  std::vector<Int_t> fillpos(fGridCellStart.begin(), fGridCellStart.end() - 1);
+  for (Int_t icluster = 0; icluster < nclusters; icluster++) {
+    if (cellOfCluster[icluster] < 0) continue;
+    fGridClusters[fillpos[cellOfCluster[icluster]]++] = icluster;
+  }
+
+  return kTRUE;
+}
+
+/**
+ * Collect the clusters which can be within the matching distance of a track
+ * into fGridCandidates, sorted by cluster index.
+ * @param[in] eta Track eta on the EMCal surface
+ * @param[in] phi Track phi on the EMCal surface
+ */
+void AliEmcalCorrectionClusterTrackMatcher::FindMatchingCandidates(Double_t eta, Double_t phi)
+{
+  fGridCandidates.clear();
+
+  if (!TMath::Finite(eta) || !TMath::Finite(phi)) {
+    // No position information: compare to all clusters
+    const Int_t nclusters = fClusterEta.size();
+    for (Int_t icluster = 0; icluster < nclusters; icluster++) fGridCandidates.push_back(icluster);
+    return;
+  }
+
+  fGridCandidates.insert(fGridCandidates.end(), fGridUnbinned.begin(), fGridUnbinned.end());
+
+  // Clamp before conversion to integer, tracks far outside the grid have no candidates
+  Double_t etapos = TMath::Floor((eta - fGridEtaMin) / fGridEtaCellSize);
+  if (etapos < -2) etapos = -2;
+  if (etapos > fGridNEta + 1) etapos = fGridNEta + 1;
+  Int_t ietamin = TMath::Max(static_cast<Int_t>(etapos) - 1, 0);
+  Int_t ietamax = TMath::Min(static_cast<Int_t>(etapos) + 1, fGridNEta - 1);
+
+  Double_t phipos = phi - TMath::TwoPi() * TMath::Floor(phi / TMath::TwoPi());
+  Int_t iphi = static_cast<Int_t>(phipos / fGridPhiCellSize);
+  if (iphi >= fGridNPhi) iphi = fGridNPhi - 1;
+  if (iphi < 0) iphi = 0;
+  Int_t nphicells = fGridNPhi < 3 ? 1 : 3;
+
+  for (Int_t ieta = ietamin; ieta <= ietamax; ieta++) {
+    for (Int_t jphi = 0; jphi < nphicells; jphi++) {
+      Int_t cphi = nphicells == 1 ? iphi : (iphi + jphi - 1 + fGridNPhi) % fGridNPhi;
+      Int_t icell = ieta * fGridNPhi + cphi;
+      fGridCandidates.insert(fGridCandidates.end(), fGridClusters.begin() + fGridCellStart[icell], fGridClusters.begin() + fGridCellStart[icell + 1]);
+    }
+  }
+
+  std::sort(fGridCandidates.begin(), fGridCandidates.end());
+}
+
+/**
+ * Test of the matching grid: Compares the track-cluster pairs found via the grid
+ * with the ones from the loop over all combinations, for random track and cluster
+ * positions. Includes tracks and clusters close to the phi boundary, pairs which are
+ * only matched across the \f$\phi = 0 = 2\pi\f$ wrap-around, and tracks without
+ * valid position.
+ * @param[in] ntracks Number of tracks
+ * @param[in] nclusters Number of clusters
+ * @param[in] maxDist Matching distance
+ * @param[in] seed Seed of the random number generator
+ * @return Number of differences between the two methods (0 if test passed)
+ */
+Int_t AliEmcalCorrectionClusterTrackMatcher::TestMatchingGrid(Int_t ntracks, Int_t nclusters, Double_t maxDist, UInt_t seed)
+{
+  TRandom3 rnd(seed);
+  const Double_t maxd2 = maxDist * maxDist;
+
+  AliEmcalCorrectionClusterTrackMatcher matcher;
+  matcher.fTrackEtaOnEmcal.resize(ntracks);
+  matcher.fTrackPhiOnEmcal.resize(ntracks);
+  for (Int_t itrack = 0; itrack < ntracks; itrack++) {
+    matcher.fTrackEtaOnEmcal[itrack] = rnd.Uniform(-1., 1.);
+    matcher.fTrackPhiOnEmcal[itrack] = rnd.Uniform(0., TMath::TwoPi());
+  }
+  // special cases: tracks at the phi boundary, far outside, and without position
+  if (ntracks > 4) {
+    matcher.fTrackPhiOnEmcal[0] = 1e-4;
+    matcher.fTrackPhiOnEmcal[1] = TMath::TwoPi() - 1e-4;
+    matcher.fTrackEtaOnEmcal[2] = -999.;
+    matcher.fTrackPhiOnEmcal[2] = -999.;
+    matcher.fTrackEtaOnEmcal[3] = std::numeric_limits<Double_t>::quiet_NaN();
+  }
+  matcher.fClusterEta.resize(nclusters);
+  matcher.fClusterPhi.resize(nclusters);
+  for (Int_t icluster = 0; icluster < nclusters; icluster++) {
+    matcher.fClusterEta[icluster] = rnd.Uniform(-0.7, 0.7);
+    matcher.fClusterPhi[icluster] = rnd.Uniform(-TMath::Pi(), TMath::Pi());
+  }
+  if (nclusters > 2) {
+    matcher.fClusterPhi[0] = -TMath::Pi() + 1e-5;
+    matcher.fClusterPhi[1] = TMath::Pi();
+  }
+  // pairs which are within the matching distance only across the wrap-around:
+  // tracks just below 2pi with clusters at small positive phi, tracks just above 0
+  // with clusters at small negative phi
+  Int_t nwrappairs = TMath::Min(ntracks - 4, nclusters - 2) / 10;
+  for (Int_t ipair = 0; ipair < nwrappairs; ipair++) {
+    Int_t itrack = 4 + ipair, icluster = 2 + ipair;
+    Double_t eta = rnd.Uniform(-0.7, 0.7);
+    Double_t dphi = rnd.Uniform(0., 0.45 * maxDist);
+    matcher.fTrackEtaOnEmcal[itrack] = eta;
+    matcher.fClusterEta[icluster] = eta + rnd.Uniform(-0.45, 0.45) * maxDist;
+    if (ipair % 2) {
+      matcher.fTrackPhiOnEmcal[itrack] = TMath::TwoPi() - dphi;
+      matcher.fClusterPhi[icluster] = rnd.Uniform(0., 0.45 * maxDist);
+    }
+    else {
+      matcher.fTrackPhiOnEmcal[itrack] = dphi;
+      matcher.fClusterPhi[icluster] = -rnd.Uniform(1e-6, 0.45 * maxDist);
+    }
+  }
+
+  if (!matcher.BuildMatchingGrid(maxDist)) {
+    Printf("TestMatchingGrid: Grid cannot be built for maximum distance %f", maxDist);
+    return 1;
+  }
+
+  Int_t ndiff = 0, nmatched = 0, nwrapped = 0;
+  std::vector<Int_t> reference, found;
+  for (Int_t itrack = 0; itrack < ntracks; itrack++) {
+    reference.clear();
+    found.clear();
+    Double_t deta = 0, dphi = 0;
+    for (Int_t icluster = 0; icluster < nclusters; icluster++) {
+      GetEtaPhiResidual(matcher.fTrackEtaOnEmcal[itrack], matcher.fTrackPhiOnEmcal[itrack], matcher.fClusterEta[icluster], matcher.fClusterPhi[icluster], deta, dphi);
+      if (deta * deta + dphi * dphi > maxd2) continue;
+      reference.push_back(icluster);
+      // pairs on either side of phi = 0, with both angles mapped to [0, 2pi)
+      Double_t trackphi = matcher.fTrackPhiOnEmcal[itrack] - TMath::TwoPi() * TMath::Floor(matcher.fTrackPhiOnEmcal[itrack] / TMath::TwoPi());
+      Double_t clusterphi = matcher.fClusterPhi[icluster] - TMath::TwoPi() * TMath::Floor(matcher.fClusterPhi[icluster] / TMath::TwoPi());
+      if (TMath::Abs(trackphi - clusterphi) > TMath::Pi()) nwrapped++;
+    }
+    matcher.FindMatchingCandidates(matcher.fTrackEtaOnEmcal[itrack], matcher.fTrackPhiOnEmcal[itrack]);
+    for (std::vector<Int_t>::const_iterator icluster = matcher.fGridCandidates.begin(); icluster != matcher.fGridCandidates.end(); ++icluster) {
+      GetEtaPhiResidual(matcher.fTrackEtaOnEmcal[itrack], matcher.fTrackPhiOnEmcal[itrack], matcher.fClusterEta[*icluster], matcher.fClusterPhi[*icluster], deta, dphi);
+      if (deta * deta + dphi * dphi > maxd2) continue;
+      found.push_back(*icluster);
+    }
+    nmatched += reference.size();
+    if (reference != found) {
+      Printf("TestMatchingGrid: Track %d (eta %f, phi %f): %d matches with full loop, %d with grid", itrack,
+          matcher.fTrackEtaOnEmcal[itrack], matcher.fTrackPhiOnEmcal[itrack], Int_t(reference.size()), Int_t(found.size()));
+      ndiff++;
+    }
+  }
+  Printf("TestMatchingGrid: %d tracks, %d clusters, %d matched pairs (%d across the phi wrap-around), %d tracks with differences",
+      ntracks, nclusters, nmatched, nwrapped, ndiff);
+  if (nwrappairs > 0 && nwrapped < nwrappairs) {
+    Printf("TestMatchingGrid: Only %d of %d pairs across the phi wrap-around are matched with the full loop", nwrapped, nwrappairs);
+    ndiff++;
   }
+  return ndiff;
 }
 
 /**
@@ -490,7 +814,7 @@ Bool_t AliEmcalCorrectionClusterTrackMatcher::IsTrackInEmcalAcceptance(AliVParti
 {
   
   if (!fGeom) {
-    AliWarning(Form("%s - AliAnalysisTaskEmcal::IsTrackInEmcalAcceptance - Geometry is not available!", GetName()));
+    AliEmcalCorrectionWarning(Form("%s - AliAnalysisTaskEmcal::IsTrackInEmcalAcceptance - Geometry is not available!", GetName()));
     return kFALSE;
   }
   
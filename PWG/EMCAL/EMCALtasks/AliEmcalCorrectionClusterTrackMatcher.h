@@ -1,6 +1,8 @@
 #ifndef ALIEMCALCORRECTIONCLUSTERTRACKMATCHER_H
 #define ALIEMCALCORRECTIONCLUSTERTRACKMATCHER_H
 
+#include <vector>
+
 #include "AliEmcalCorrectionComponent.h"
 
 #if !(defined(__CINT__) || defined(__MAKECINT__))
@@ -45,6 +47,13 @@ class AliVParticle;
  ~~~
  (again assuming that the task is derived from AliAnalysisTaskEmcal or AliAnalysisTaskEmcalJet).
  *
+ * In order to avoid testing all track-cluster combinations, clusters are sorted into an
+ * \f$\eta\f$-\f$\phi\f$ grid with a cell size of at least the maximum matching distance.
+ * Each track is only compared to the clusters in its own and the neighbouring cells. The
+ * candidates are processed in the same order as in the full loop, so the matching result is
+ * identical. The grid can be disabled with the `useMatchingGrid` property; the equivalence
+ * with the full loop is checked by TestMatchingGrid (see test/trackmatcher/runtest.C).
+ *
  * Based on code in AliEmcalClusTrackMatcherTask. 
  *
  * @author Constantin Loizides, LBNL, AliEmcalClusTrackMatcherTask
@@ -64,11 +73,21 @@ class AliEmcalCorrectionClusterTrackMatcher : public AliEmcalCorrectionComponent
   void UserCreateOutputObjects();
   void ExecOnce();
   Bool_t Run();
-  
+  Bool_t RequiresSequentialExecution() const { return kFALSE; }
+  /// The track propagation uses gGeoManager and the global magnetic field, the MC event is read for the generator selection
+  void GetSharedStateKeys(std::set <std::string> & keys) const;
+
+  static Int_t  TestMatchingGrid(Int_t ntracks = 3000, Int_t nclusters = 500, Double_t maxDist = 0.1, UInt_t seed = 1);
+
  protected:
   Int_t         GetMomBin(Double_t p) const;
   void          GenerateEmcalParticles();
   void          DoMatching();
+  void          MatchTrackCluster(Int_t itrack, Int_t icluster, Double_t maxd2);
+  void          FillEtaPhiOnEmcal();
+  Bool_t        BuildMatchingGrid(Double_t maxDist);
+  void          FindMatchingCandidates(Double_t eta, Double_t phi);
+  static void   GetEtaPhiResidual(Double_t trackEta, Double_t trackPhi, Double_t clusterEta, Double_t clusterPhi, Double_t &deta, Double_t &dphi);
   void          UpdateTracks();
   void          UpdateClusters();
   Bool_t        IsTrackInEmcalAcceptance(AliVParticle* part, Double_t edges=0.9) const;
@@ -87,6 +106,7 @@ class AliEmcalCorrectionClusterTrackMatcher : public AliEmcalCorrectionComponent
   Bool_t        fUseDCA;                ///< Use DCA as starting point for track propagation, rather than primary vertex
   Bool_t        fUpdateTracks;          ///< update tracks with matching info
   Bool_t        fUpdateClusters;        ///< update clusters with matching info
+  Bool_t        fUseMatchingGrid;       ///< only compare tracks to clusters in neighbouring eta-phi cells
   
 #if !(defined(__CINT__) || defined(__MAKECINT__))
   // Handle mapping between index and containers
@@ -102,6 +122,20 @@ class AliEmcalCorrectionClusterTrackMatcher : public AliEmcalCorrectionComponent
   TH1          *fHistMatchPhiAll;       //!<!dphi distribution
   TH1          *fHistMatchEta[10][9][2]; //!<!deta distribution
   TH1          *fHistMatchPhi[10][9][2]; //!<!dphi distribution
+
+  std::vector<Double_t> fTrackEtaOnEmcal;    //!<!track eta on the EMCal surface (NaN if no track)
+  std::vector<Double_t> fTrackPhiOnEmcal;    //!<!track phi on the EMCal surface (NaN if no track)
+  std::vector<Double_t> fClusterEta;         //!<!cluster eta from the cluster position (NaN if no cluster)
+  std::vector<Double_t> fClusterPhi;         //!<!cluster phi from the cluster position (NaN if no cluster)
+  Double_t      fGridEtaMin;                 //!<!lower eta edge of the matching grid
+  Double_t      fGridEtaCellSize;            //!<!eta size of a grid cell
+  Double_t      fGridPhiCellSize;            //!<!phi size of a grid cell
+  Int_t         fGridNEta;                   //!<!number of grid cells in eta
+  Int_t         fGridNPhi;                   //!<!number of grid cells in phi
+  std::vector<Int_t> fGridCellStart;         //!<!start of each cell in fGridClusters (cell index = ieta*fGridNPhi + iphi)
+  std::vector<Int_t> fGridClusters;          //!<!cluster indices sorted by grid cell
+  std::vector<Int_t> fGridUnbinned;          //!<!clusters without valid position, compared to every track
+  std::vector<Int_t> fGridCandidates;        //!<!candidate clusters for the current track
   
   Int_t      fNMCGenerToAccept;          ///<  Number of MC generators that should not be included in analysis
   TString    fMCGenerToAccept[5];        ///<  List with name of generators that should not be included
@@ -115,7 +149,7 @@ private:
   static RegisterCorrectionComponent<AliEmcalCorrectionClusterTrackMatcher> reg;
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalCorrectionClusterTrackMatcher, 4); // EMCal cluster track matcher correction component
+  ClassDef(AliEmcalCorrectionClusterTrackMatcher, 5); // EMCal cluster track matcher correction component
   /// \endcond
 };
 
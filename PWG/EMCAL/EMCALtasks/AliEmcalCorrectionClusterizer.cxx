@@ -213,6 +213,19 @@ void AliEmcalCorrectionClusterizer::UserCreateOutputObjects()
   }
 }
 
+/**
+ * The cell MC labels are recalculated from the MC event, which is shared between components. The
+ * geometry is only read: its super module matrices are loaded by AliEmcalCorrectionTask before the
+ * components are run in parallel.
+ *
+ * @param[out] keys Keys of the shared state accessed by the component
+ */
+void AliEmcalCorrectionClusterizer::GetSharedStateKeys(std::set <std::string> & keys) const
+{
+  AliEmcalCorrectionComponent::GetSharedStateKeys(keys);
+  if (fMCEvent) keys.insert("AliMCEvent");
+}
+
 /**
  * Called for each event to process the event data.
  */
@@ -239,7 +252,7 @@ Bool_t AliEmcalCorrectionClusterizer::Run()
   // If cells are empty, clear clusters and return
   if (fCaloCells->GetNumberOfCells()<=0)
   {
-    AliWarning(Form("Number of EMCAL cells = %d, returning", fCaloCells->GetNumberOfCells()));
+    AliEmcalCorrectionWarning(Form("Number of EMCAL cells = %d, returning", fCaloCells->GetNumberOfCells()));
     ClearEMCalClusters();
     return kFALSE;
   }
@@ -251,7 +264,7 @@ Bool_t AliEmcalCorrectionClusterizer::Run()
     Bool_t desc1 = (mask1 >> 18) & 0x1;
     Bool_t desc2 = (mask2 >> 18) & 0x1;
     if (desc1==0 || desc2==0) { //AliDAQ::OfflineModuleName(180=="EMCAL"
-      AliError(Form("EMCAL not in DAQ/RECO: %u (%u)/%u (%u)",
+      AliEmcalCorrectionError(Form("EMCAL not in DAQ/RECO: %u (%u)/%u (%u)",
                     mask1, fEsd->GetESDRun()->GetDetectorsInReco(),
                     mask2, fEsd->GetESDRun()->GetDetectorsInDAQ()));
       return kFALSE;
@@ -264,7 +277,7 @@ Bool_t AliEmcalCorrectionClusterizer::Run()
   
   if (!fMCEvent) {
     if (offtrigger & AliVEvent::kFastOnly) {
-      AliError(Form("EMCAL not in fast only partition"));
+      AliEmcalCorrectionError(Form("EMCAL not in fast only partition"));
       return kFALSE;
     }
   }
@@ -272,7 +285,7 @@ Bool_t AliEmcalCorrectionClusterizer::Run()
   Init();
   
   if (fJustUnfold) {
-    AliWarning("Unfolding not implemented");
+    AliEmcalCorrectionWarning("Unfolding not implemented");
     return kTRUE;
   }
   
@@ -413,7 +426,7 @@ void AliEmcalCorrectionClusterizer::FillDigitsArray()
 
         if(iclus < 0)
         {
-          AliInfo("Negative original cluster index, skip \n");
+          AliEmcalCorrectionInfo("Negative original cluster index, skip \n");
           continue;
         }
 
@@ -501,7 +514,7 @@ void AliEmcalCorrectionClusterizer::RecPoints2Clusters(TClonesArray *clus)
     
     if (ncellsTrue < 1)
     {
-      AliWarning("Skipping cluster with no cells");
+      AliEmcalCorrectionWarning("Skipping cluster with no cells");
       continue;
     }
     
@@ -44,6 +44,9 @@ class AliEmcalCorrectionClusterizer : public AliEmcalCorrectionComponent {
   void UserCreateOutputObjects();
   Bool_t Run();
   Bool_t CheckIfRunChanged();
+  Bool_t RequiresSequentialExecution() const { return kFALSE; }
+  /// The cluster positions may be computed via gGeoManager and the MC labels are read from the MC event
+  void GetSharedStateKeys(std::set <std::string> & keys) const;
   
 protected:
   void           Clusterize();
@@ -3,6 +3,8 @@
 
 #include "AliEmcalCorrectionComponent.h"
 
+#include <mutex>
+
 #include <TFile.h>
 #include <TH1.h>
 
@@ -30,6 +32,7 @@ AliEmcalCorrectionComponent::AliEmcalCorrectionComponent() :
   TNamed("AliEmcalCorrectionComponent", "AliEmcalCorrectionComponent"),
   fUserConfiguration(),
   fDefaultConfiguration(),
+  fDeferredLogMessages(),
   fCreateHisto(kTRUE),
   fRun(-1),
   fFilepass(""),
@@ -51,8 +54,8 @@ AliEmcalCorrectionComponent::AliEmcalCorrectionComponent() :
   fCaloCells(0),
   fRecoUtils(0),
   fOutput(0),
-  fBasePath("")
-
+  fBasePath(""),
+  fDeferLogMessages(kFALSE)
 {
   fVertex[0] = 0;
   fVertex[1] = 0;
@@ -66,6 +69,7 @@ AliEmcalCorrectionComponent::AliEmcalCorrectionComponent(const char * name) :
   TNamed(name, name),
   fUserConfiguration(),
   fDefaultConfiguration(),
+  fDeferredLogMessages(),
   fCreateHisto(kTRUE),
   fRun(-1),
   fFilepass(""),
@@ -87,7 +91,8 @@ AliEmcalCorrectionComponent::AliEmcalCorrectionComponent(const char * name) :
   fCaloCells(0),
   fRecoUtils(0),
   fOutput(0),
-  fBasePath("")
+  fBasePath(""),
+  fDeferLogMessages(kFALSE)
 {
   fVertex[0] = 0;
   fVertex[1] = 0;
@@ -165,6 +170,96 @@ Bool_t AliEmcalCorrectionComponent::UserNotify()
   return kTRUE;
 }
 
+/**
+ * Keys of the state which is accessed in Run() in addition to the configured input objects
+ * and which may be shared with other components. Components with a common key are never run
+ * in parallel to each other. The base class declares its AliEMCALRecoUtils object, which can
+ * be shared via SetRecoUtils().
+ *
+ * @param[out] keys Keys of the shared state accessed by the component
+ */
+void AliEmcalCorrectionComponent::GetSharedStateKeys(std::set <std::string> & keys) const
+{
+  if (fRecoUtils) keys.insert(TString::Format("AliEMCALRecoUtils:%p", static_cast<void *>(fRecoUtils)).Data());
+}
+
+/**
+ * Key of an input object (cells, cluster or track branch of the input or embedded event) as used for
+ * grouping the components into chains. Components can use it in GetSharedStateKeys() to declare input
+ * objects which they access in addition to the configured ones.
+ *
+ * @param[in] inputObjectType Type of the input object
+ * @param[in] isEmbedding True if the branch is in the embedded event
+ * @param[in] branchName Name of the branch
+ * @return Key of the input object
+ */
+std::string AliEmcalCorrectionComponent::GetInputObjectKey(AliEmcalContainerUtils::InputObject_t inputObjectType, bool isEmbedding, const std::string & branchName)
+{
+  std::string inputObjectName = "cells";
+  if (inputObjectType == AliEmcalContainerUtils::kCluster) inputObjectName = "clusters";
+  else if (inputObjectType == AliEmcalContainerUtils::kTrack) inputObjectName = "tracks";
+  return inputObjectName + (isEmbedding ? ":embedded:" : ":input:") + branchName;
+}
+
+namespace {
+  std::mutex gTrackPropagationMutex;  ///< Serialises the track propagation of components running in parallel
+}
+
+/**
+ * Track propagation navigates gGeoManager for the material budget and evaluates the global magnetic
+ * field, neither of which is thread safe. Components propagating tracks in Run() hold this lock during
+ * the propagation, such that components in different chains can still be run in parallel.
+ */
+void AliEmcalCorrectionComponent::LockTrackPropagation()
+{
+  gTrackPropagationMutex.lock();
+}
+
+/**
+ * Release the lock taken by LockTrackPropagation().
+ */
+void AliEmcalCorrectionComponent::UnlockTrackPropagation()
+{
+  gTrackPropagationMutex.unlock();
+}
+
+/**
+ * Print a message via AliLog, or keep it until FlushLogMessages() if the component is run on a
+ * worker thread. Use it through the AliEmcalCorrectionInfo(), AliEmcalCorrectionWarning() and
+ * AliEmcalCorrectionError() macros.
+ *
+ * @param[in] type AliLog message type
+ * @param[in] message Message
+ * @param[in] function Function which issued the message
+ * @param[in] file File which issued the message
+ * @param[in] line Line which issued the message
+ */
+void AliEmcalCorrectionComponent::LogMessage(UInt_t type, const char * message, const char * function, const char * file, Int_t line) const
+{
+  if (fDeferLogMessages) {
+    DeferredLogMessage deferred;
+    deferred.fType = type;
+    deferred.fMessage = message;
+    deferred.fFunction = function;
+    deferred.fFile = file;
+    deferred.fLine = line;
+    fDeferredLogMessages.push_back(deferred);
+    return;
+  }
+  AliLog::Message(type, message, MODULENAME(), ClassName(), function, file, line);
+}
+
+/**
+ * Print the messages kept by LogMessage(). Called by the main thread after the component chains were run.
+ */
+void AliEmcalCorrectionComponent::FlushLogMessages()
+{
+  for (auto const & deferred : fDeferredLogMessages) {
+    AliLog::Message(deferred.fType, deferred.fMessage.c_str(), MODULENAME(), ClassName(), deferred.fFunction.c_str(), deferred.fFile.c_str(), deferred.fLine);
+  }
+  fDeferredLogMessages.clear();
+}
+
 /**
  * Calculate \f$\phi\f$ and \f$\eta\f$ difference between a track (t) and a cluster (c). The
  * position of the track is obtained on the EMCAL surface
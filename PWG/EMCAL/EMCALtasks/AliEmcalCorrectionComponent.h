@@ -2,6 +2,8 @@
 #define ALIEMCALCORRECTIONCOMPONENT_H
 
 #include <map>
+#include <set>
+#include <vector>
 #include <string>
 
 // CINT can't handle the yaml header!
@@ -57,6 +59,16 @@ class AliEmcalCorrectionComponent : public TNamed {
   virtual Bool_t Run();
   virtual Bool_t UserNotify();
   virtual Bool_t CheckIfRunChanged();
+  /// False only if all state shared with other components which is accessed in Run() is declared by GetSharedStateKeys(). Otherwise (default) the component is never run in parallel to other components.
+  virtual Bool_t RequiresSequentialExecution() const { return kTRUE; }
+  virtual void GetSharedStateKeys(std::set <std::string> & keys) const;
+  static std::string GetInputObjectKey(AliEmcalContainerUtils::InputObject_t inputObjectType, bool isEmbedding, const std::string & branchName);
+  static void LockTrackPropagation();
+  static void UnlockTrackPropagation();
+
+  // Messages from Run() while the component is run on a worker thread
+  void SetDeferLogMessages(Bool_t b) { fDeferLogMessages = b; }
+  void FlushLogMessages();
   
   void GetEtaPhiDiff(const AliVTrack *t, const AliVCluster *v, Double_t &phidiff, Double_t &etadiff);
   void UpdateCells();
@@ -100,6 +112,7 @@ class AliEmcalCorrectionComponent : public TNamed {
   void SetUsingInputEvent(bool b = true) { fEventManager.SetUseEmbeddingEvent(!b); }
 
   void SetEMCALGeometry(AliEMCALGeometry * geometry ) { fGeom = geometry; }
+  AliEMCALGeometry * GetEMCALGeometry() const { return fGeom; }
   void SetCentralityBin(Int_t bin) { fCentBin = bin; }
   void SetCentrality(Double_t cent) { fCent = cent; }
   void SetNcentralityBins(Int_t n) { fNcentBins = n; }
@@ -130,8 +143,20 @@ class AliEmcalCorrectionComponent : public TNamed {
 
   YAML::Node              fUserConfiguration;             //!<! User YAML configuration
   YAML::Node              fDefaultConfiguration;          //!<! Default YAML configuration
+
+  /// Message kept until it can be printed by the main thread
+  struct DeferredLogMessage {
+    UInt_t                fType;                          ///< AliLog message type
+    std::string           fMessage;                       ///< Message
+    std::string           fFunction;                      ///< Function which issued the message
+    std::string           fFile;                          ///< File which issued the message
+    Int_t                 fLine;                          ///< Line which issued the message
+  };
+  mutable std::vector <DeferredLogMessage> fDeferredLogMessages; //!<! Messages issued while fDeferLogMessages is set
 #endif
 
+  void                    LogMessage(UInt_t type, const char * message, const char * function, const char * file, Int_t line) const;
+
   Bool_t                  fCreateHisto;                   ///< Flag to make some basic histograms
   Int_t                   fRun;                           //!<! Run number
   TString                 fFilepass;                      ///< Input data pass number
@@ -156,16 +181,27 @@ class AliEmcalCorrectionComponent : public TNamed {
   TList                  *fOutput;                        //!<! List of output histograms
   
   TString                fBasePath;                       ///< Base folder path to get root files
+  Bool_t                 fDeferLogMessages;               //!<! Keep the messages of LogMessage() until FlushLogMessages()
 
  private:
   AliEmcalCorrectionComponent(const AliEmcalCorrectionComponent &);               // Not implemented
   AliEmcalCorrectionComponent &operator=(const AliEmcalCorrectionComponent &);    // Not implemented
   
   /// \cond CLASSIMP
-  ClassDef(AliEmcalCorrectionComponent, 3); // EMCal correction component
+  ClassDef(AliEmcalCorrectionComponent, 4); // EMCal correction component
   /// \endcond
 };
 
+/**
+ * Info, warning and error messages of the correction components in Run(). While the component chains
+ * are run in parallel, the messages are kept and printed by the main thread afterwards, since AliLog
+ * is not thread safe. Debug messages are printed directly: the components are not run in parallel
+ * if debugging is enabled.
+ */
+#define AliEmcalCorrectionInfo(message) LogMessage(AliLog::kInfo, message, FUNCTIONNAME(), __FILE__, __LINE__)
+#define AliEmcalCorrectionWarning(message) LogMessage(AliLog::kWarning, message, FUNCTIONNAME(), __FILE__, __LINE__)
+#define AliEmcalCorrectionError(message) LogMessage(AliLog::kError, message, FUNCTIONNAME(), __FILE__, __LINE__)
+
 #if !(defined(__CINT__) || defined(__MAKECINT__))
 /**
  * Get the requested property from the YAML configuration. This function is generally used by
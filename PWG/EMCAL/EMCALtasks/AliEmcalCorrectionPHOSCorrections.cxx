@@ -76,6 +76,19 @@ void AliEmcalCorrectionPHOSCorrections::UserCreateOutputObjects()
 
 }
 
+/**
+ * The PHOS tender updates the PHOS clusters in the calo cluster branch of its event, which also contains
+ * the EMCal clusters, and reads the MC event for MC productions.
+ *
+ * @param[out] keys Keys of the shared state accessed by the component
+ */
+void AliEmcalCorrectionPHOSCorrections::GetSharedStateKeys(std::set <std::string> & keys) const
+{
+  AliEmcalCorrectionComponent::GetSharedStateKeys(keys);
+  keys.insert(GetInputObjectKey(AliEmcalContainerUtils::kCluster, fEventManager.UseEmbeddingEvent(), AliEmcalContainerUtils::DetermineUseDefaultName(AliEmcalContainerUtils::kCluster, fEsdMode)));
+  if (fMCEvent) keys.insert("AliMCEvent");
+}
+
 /**
  * Called for each event to process the event data.
  */
@@ -85,7 +98,10 @@ Bool_t AliEmcalCorrectionPHOSCorrections::Run()
   
   CheckIfRunChanged();
   
+  // The track matching of the tender propagates tracks
+  LockTrackPropagation();
   fPHOSTender->ProcessEvent();
+  UnlockTrackPropagation();
   
   return kTRUE;
 }
@@ -25,6 +25,8 @@ class AliEmcalCorrectionPHOSCorrections : public AliEmcalCorrectionComponent {
   void UserCreateOutputObjects();
   Bool_t Run();
   Bool_t CheckIfRunChanged();
+  Bool_t RequiresSequentialExecution() const { return kFALSE; }
+  void GetSharedStateKeys(std::set <std::string> & keys) const;
   
   AliPHOSTenderSupply*          GetPHOSTenderSupply() {return fPHOSTender;}
 
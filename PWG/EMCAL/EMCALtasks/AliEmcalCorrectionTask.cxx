@@ -12,11 +12,22 @@
 #include <sstream>
 #include <iostream>
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
 
 #include <TChain.h>
+#include <TH1.h>
+#include <TROOT.h>
+#include <RVersion.h>
+#include <TStopwatch.h>
 #include <TSystem.h>
 #include <TGrid.h>
 #include <TFile.h>
+#include <TGeoManager.h>
 #include <TUUID.h>
 
 #include "AliVEventHandler.h"
@@ -54,6 +65,132 @@ const std::map <std::string, AliEmcalTrackSelection::ETrackFilterType_t> AliEmca
   {"kTPCOnlyTracks", AliEmcalTrackSelection::kTPCOnlyTracks }
 };
 
+/**
+ * @class AliEmcalCorrectionTaskWorkerPool
+ * @brief Persistent threads running the independent component chains of AliEmcalCorrectionTask
+ *
+ * The threads are started once and wait for the next event, so that no thread is created or
+ * joined per event. Run() hands out the items of one event and returns when all of them are done.
+ */
+class AliEmcalCorrectionTaskWorkerPool {
+ public:
+  AliEmcalCorrectionTaskWorkerPool(UInt_t nthreads);
+  ~AliEmcalCorrectionTaskWorkerPool();
+
+  void Run(UInt_t nitems, const std::function<void(UInt_t)> & work);
+
+ private:
+  AliEmcalCorrectionTaskWorkerPool(const AliEmcalCorrectionTaskWorkerPool &);
+  AliEmcalCorrectionTaskWorkerPool & operator=(const AliEmcalCorrectionTaskWorkerPool &);
+
+  void WorkerLoop();
+  void ProcessItems();
+
+  std::vector <std::thread>         fThreads;        ///< Worker threads (in addition to the calling thread)
+  std::mutex                        fMutex;          ///< Protects the members below
+  std::condition_variable           fStartEvent;     ///< Signals the workers that new items are available
+  std::condition_variable           fEventDone;      ///< Signals the calling thread that all workers are done
+  const std::function<void(UInt_t)> * fWork;         ///< Work to be done for each item of the current event
+  UInt_t                            fNItems;         ///< Number of items of the current event
+  std::atomic <UInt_t>              fNextItem;       ///< Next item to be processed
+  ULong64_t                         fGeneration;     ///< Incremented for each event
+  UInt_t                            fNBusy;          ///< Number of workers still processing the current event
+  Bool_t                            fStop;           ///< Set to stop the workers
+};
+
+/**
+ * Start the worker threads.
+ *
+ * @param[in] nthreads Number of worker threads in addition to the calling thread
+ */
+AliEmcalCorrectionTaskWorkerPool::AliEmcalCorrectionTaskWorkerPool(UInt_t nthreads) :
+  fThreads(),
+  fMutex(),
+  fStartEvent(),
+  fEventDone(),
+  fWork(0),
+  fNItems(0),
+  fNextItem(0),
+  fGeneration(0),
+  fNBusy(0),
+  fStop(kFALSE)
+{
+  for (UInt_t ithread = 0; ithread < nthreads; ithread++) {
+    fThreads.emplace_back(&AliEmcalCorrectionTaskWorkerPool::WorkerLoop, this);
+  }
+}
+
+/**
+ * Stop and join the worker threads.
+ */
+AliEmcalCorrectionTaskWorkerPool::~AliEmcalCorrectionTaskWorkerPool()
+{
+  {
+    std::lock_guard <std::mutex> lock(fMutex);
+    fStop = kTRUE;
+  }
+  fStartEvent.notify_all();
+  for (auto & thread : fThreads) {
+    thread.join();
+  }
+}
+
+/**
+ * Process the items 0 to nitems-1 of one event on the worker threads and the calling thread.
+ *
+ * @param[in] nitems Number of items
+ * @param[in] work Function called for each item
+ */
+void AliEmcalCorrectionTaskWorkerPool::Run(UInt_t nitems, const std::function<void(UInt_t)> & work)
+{
+  {
+    std::lock_guard <std::mutex> lock(fMutex);
+    fWork = &work;
+    fNItems = nitems;
+    fNextItem = 0;
+    fNBusy = fThreads.size();
+    fGeneration++;
+  }
+  fStartEvent.notify_all();
+
+  ProcessItems();
+
+  std::unique_lock <std::mutex> lock(fMutex);
+  fEventDone.wait(lock, [this]() { return fNBusy == 0; });
+  fWork = 0;
+}
+
+/**
+ * Main loop of the worker threads: wait for the next event, process its items and report when done.
+ */
+void AliEmcalCorrectionTaskWorkerPool::WorkerLoop()
+{
+  ULong64_t generation = 0;
+  while (true) {
+    {
+      std::unique_lock <std::mutex> lock(fMutex);
+      fStartEvent.wait(lock, [this, generation]() { return fStop || fGeneration != generation; });
+      if (fStop) return;
+      generation = fGeneration;
+    }
+
+    ProcessItems();
+
+    std::lock_guard <std::mutex> lock(fMutex);
+    if (--fNBusy == 0) fEventDone.notify_one();
+  }
+}
+
+/**
+ * Take the next unprocessed item of the current event until all are taken.
+ */
+void AliEmcalCorrectionTaskWorkerPool::ProcessItems()
+{
+  for (UInt_t item = fNextItem++; item < fNItems; item = fNextItem++) {
+    (*fWork)(item);
+  }
+}
+
 /**
  * Default constructor.
  */
@@ -87,7 +224,13 @@ AliEmcalCorrectionTask::AliEmcalCorrectionTask() :
   fParticleCollArray(),
   fClusterCollArray(),
   fCellCollArray(),
-  fOutput(0)
+  fNThreads(1),
+  fComponentChains(),
+  fComponentWallTime(),
+  fLastRunNumber(-1),
+  fWorkerPool(0),
+  fOutput(0),
+  fHistComponentWallTime(0)
 {
   // Default constructor
   AliDebug(3, Form("%s", __PRETTY_FUNCTION__));
@@ -135,7 +278,13 @@ AliEmcalCorrectionTask::AliEmcalCorrectionTask(const char * name) :
   fParticleCollArray(),
   fClusterCollArray(),
   fCellCollArray(),
-  fOutput(0)
+  fNThreads(1),
+  fComponentChains(),
+  fComponentWallTime(),
+  fLastRunNumber(-1),
+  fWorkerPool(0),
+  fOutput(0),
+  fHistComponentWallTime(0)
 {
   // Standard constructor
   AliDebug(3, Form("%s", __PRETTY_FUNCTION__));
@@ -182,7 +331,13 @@ AliEmcalCorrectionTask::AliEmcalCorrectionTask(const AliEmcalCorrectionTask & ta
   fGeom(task.fGeom),
   fParticleCollArray(*(static_cast<TObjArray *>(task.fParticleCollArray.Clone()))),
   fClusterCollArray(*(static_cast<TObjArray *>(task.fClusterCollArray.Clone()))),
-  fOutput(task.fOutput)                           // TODO: More care is needed here!
+  fNThreads(task.fNThreads),
+  fComponentChains(task.fComponentChains),
+  fComponentWallTime(task.fComponentWallTime),
+  fLastRunNumber(task.fLastRunNumber),
+  fWorkerPool(0),
+  fOutput(task.fOutput),
+  fHistComponentWallTime(0)
 {
   // Vertex position
   std::copy(std::begin(task.fVertex), std::end(task.fVertex), std::begin(fVertex));
@@ -249,7 +404,13 @@ void swap(AliEmcalCorrectionTask & first, AliEmcalCorrectionTask & second)
   swap(first.fParticleCollArray, second.fParticleCollArray);
   swap(first.fClusterCollArray, second.fClusterCollArray);
   swap(first.fCellCollArray, second.fCellCollArray);
+  swap(first.fNThreads, second.fNThreads);
+  swap(first.fComponentChains, second.fComponentChains);
+  swap(first.fComponentWallTime, second.fComponentWallTime);
+  swap(first.fLastRunNumber, second.fLastRunNumber);
+  swap(first.fWorkerPool, second.fWorkerPool);
   swap(first.fOutput, second.fOutput);
+  swap(first.fHistComponentWallTime, second.fHistComponentWallTime);
 }
 
 /**
@@ -259,6 +420,7 @@ void swap(AliEmcalCorrectionTask & first, AliEmcalCorrectionTask & second)
 AliEmcalCorrectionTask::~AliEmcalCorrectionTask()
 {
   // Destructor
+  delete fWorkerPool;
 }
 
 /**
@@ -1086,6 +1248,15 @@ void AliEmcalCorrectionTask::UserCreateOutputObjects()
 
   UserCreateOutputObjectsComponents();
 
+  // Wall time accounting: one bin per component, last bin for the full correction step
+  const Int_t ncomponents = fCorrectionComponents.size();
+  fHistComponentWallTime = new TH1D("fHistComponentWallTime", "Wall time per correction component;;t (s)", ncomponents + 1, -0.5, ncomponents + 0.5);
+  for (Int_t icomponent = 0; icomponent < ncomponents; icomponent++) {
+    fHistComponentWallTime->GetXaxis()->SetBinLabel(icomponent + 1, fCorrectionComponents[icomponent]->GetName());
+  }
+  fHistComponentWallTime->GetXaxis()->SetBinLabel(ncomponents + 1, "Total");
+  fOutput->Add(fHistComponentWallTime);
+
   PostData(1, fOutput);
 }
 
@@ -1243,6 +1414,138 @@ void AliEmcalCorrectionTask::ExecOnceComponents()
       AddContainersToComponent(component, AliEmcalContainerUtils::kCaloCells, true);
     }
   }
+
+  // Group the components into chains which can be run independently
+  DetermineComponentChains();
+  if (fNThreads > 1) {
+    if (fComponentChains.size() < 2) {
+      AliWarningStream() << "No independent component chains, the components are run sequentially." << std::endl;
+    }
+    else {
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,6,0)
+      ROOT::EnableThreadSafety();
+      delete fWorkerPool;
+      fWorkerPool = new AliEmcalCorrectionTaskWorkerPool(std::min(static_cast<UInt_t>(fNThreads), static_cast<UInt_t>(fComponentChains.size())) - 1);
+#else
+      AliWarningStream() << "ROOT::EnableThreadSafety() is not available, the components are run sequentially." << std::endl;
+#endif
+    }
+  }
+}
+
+/**
+ * Determine the keys of the input objects used by a component, based on the YAML configuration. The key
+ * consists of the object type, the event (input or embedded) and the branch name, such that containers
+ * with different names but the same underlying branch lead to the same key.
+ *
+ * @param[in] component Component for which the input objects are determined
+ * @param[out] keys Keys of the input objects used by the component
+ */
+void AliEmcalCorrectionTask::GetInputObjectKeysForComponent(AliEmcalCorrectionComponent * component, std::set <std::string> & keys)
+{
+  const AliEmcalContainerUtils::InputObject_t inputObjectTypes[] = {AliEmcalContainerUtils::kCaloCells, AliEmcalContainerUtils::kCluster, AliEmcalContainerUtils::kTrack};
+  for (auto inputObjectType : inputObjectTypes)
+  {
+    std::string inputObjectName = GetInputFieldNameFromInputObjectType(inputObjectType);
+    std::vector <std::string> inputObjects;
+    AliEmcalCorrectionComponent::GetProperty((inputObjectName + "Names").c_str(), inputObjects, fUserConfiguration, fDefaultConfiguration, false, component->GetName());
+
+    for (auto const & str : inputObjects)
+    {
+      std::string branchName = str;
+      bool isEmbedding = false;
+      if (inputObjectType == AliEmcalContainerUtils::kCaloCells) {
+        AliEmcalCorrectionCellContainer * cellCont = GetCellContainer(str);
+        if (cellCont) {
+          branchName = cellCont->GetBranchName();
+          isEmbedding = cellCont->GetIsEmbedding();
+        }
+      }
+      else {
+        AliEmcalContainer * cont = 0;
+        if (inputObjectType == AliEmcalContainerUtils::kCluster) cont = GetClusterContainer(str.c_str());
+        else cont = GetParticleContainer(str.c_str());
+        if (cont) {
+          branchName = cont->GetArrayName().Data();
+          isEmbedding = cont->GetIsEmbedding();
+        }
+      }
+      keys.insert(AliEmcalCorrectionComponent::GetInputObjectKey(inputObjectType, isEmbedding, branchName));
+    }
+  }
+}
+
+/**
+ * Group the correction components into chains. Components which share an input object or a key of shared
+ * state (directly or via other components) are put into the same chain, keeping the configured execution
+ * order. The declared keys may also name input objects which are not configured for the component (see
+ * AliEmcalCorrectionComponent::GetInputObjectKey()). Different chains do not share any input object or
+ * declared state and can be run in parallel. Components which require sequential execution (i.e. which
+ * do not declare their shared state) connect all components into a single chain.
+ */
+void AliEmcalCorrectionTask::DetermineComponentChains()
+{
+  const UInt_t ncomponents = fCorrectionComponents.size();
+
+  // Union-find over the components, connecting components via shared input objects
+  std::vector <UInt_t> parent(ncomponents);
+  for (UInt_t icomponent = 0; icomponent < ncomponents; icomponent++) parent[icomponent] = icomponent;
+  auto findRoot = [&parent](UInt_t i) {
+    while (parent[i] != i) {
+      parent[i] = parent[parent[i]];
+      i = parent[i];
+    }
+    return i;
+  };
+  auto join = [&parent, &findRoot](UInt_t a, UInt_t b) {
+    a = findRoot(a);
+    b = findRoot(b);
+    if (a != b) parent[std::max(a, b)] = std::min(a, b);
+  };
+
+  std::map <std::string, UInt_t> firstUserOfObject;
+  for (UInt_t icomponent = 0; icomponent < ncomponents; icomponent++)
+  {
+    AliEmcalCorrectionComponent * component = fCorrectionComponents[icomponent];
+    if (component->RequiresSequentialExecution()) {
+      for (UInt_t jcomponent = 0; jcomponent < ncomponents; jcomponent++) join(icomponent, jcomponent);
+      continue;
+    }
+    std::set <std::string> keys;
+    GetInputObjectKeysForComponent(component, keys);
+    component->GetSharedStateKeys(keys);
+    for (auto const & key : keys)
+    {
+      auto found = firstUserOfObject.find(key);
+      if (found == firstUserOfObject.end()) firstUserOfObject[key] = icomponent;
+      else join(found->second, icomponent);
+    }
+  }
+
+  // Chains are ordered by their first component, components within a chain by execution order
+  fComponentChains.clear();
+  std::map <UInt_t, UInt_t> chainOfRoot;
+  for (UInt_t icomponent = 0; icomponent < ncomponents; icomponent++)
+  {
+    UInt_t root = findRoot(icomponent);
+    auto found = chainOfRoot.find(root);
+    if (found == chainOfRoot.end()) {
+      chainOfRoot[root] = fComponentChains.size();
+      fComponentChains.push_back(std::vector <UInt_t>(1, icomponent));
+    }
+    else {
+      fComponentChains[found->second].push_back(icomponent);
+    }
+  }
+  fComponentWallTime.assign(ncomponents, 0.);
+
+  AliInfoStream() << "Correction components grouped into " << fComponentChains.size() << " independent chain(s):" << std::endl;
+  for (auto const & chain : fComponentChains)
+  {
+    std::stringstream chainComponents;
+    for (auto icomponent : chain) chainComponents << " " << fCorrectionComponents[icomponent]->GetName();
+    AliInfoStream() << "\t" << chainComponents.str() << std::endl;
+  }
 }
 
 /**
@@ -1344,7 +1647,10 @@ Bool_t AliEmcalCorrectionTask::RetrieveEventObjects()
  */
 Bool_t AliEmcalCorrectionTask::Run()
 {
-  // Run the initialization for all derived classes.
+  TStopwatch totalTime;
+  totalTime.Start();
+
+  // Set the event properties for all derived classes.
   for (auto component : fCorrectionComponents)
   {
     component->SetInputEvent(InputEvent());
@@ -1352,8 +1658,30 @@ Bool_t AliEmcalCorrectionTask::Run()
     component->SetCentralityBin(fCentBin);
     component->SetCentrality(fCent);
     component->SetVertex(fVertex);
+  }
 
-    component->Run();
+  // The run-dependent initialization of the components is not thread safe,
+  // so the first event of each run is processed sequentially.
+  // Debug messages are printed directly by AliLog, which is not thread safe.
+  Int_t runNumber = InputEvent()->GetRunNumber();
+  Bool_t runParallel = fWorkerPool && runNumber == fLastRunNumber && !AliLog::IsDebugEnabled();
+  fLastRunNumber = runNumber;
+
+  if (runParallel) {
+    RunComponentChainsParallel();
+  }
+  else {
+    for (UInt_t icomponent = 0; icomponent < fCorrectionComponents.size(); icomponent++) {
+      RunComponent(icomponent);
+    }
+    if (fWorkerPool) LoadGeometryMatrices();
+  }
+
+  if (fHistComponentWallTime) {
+    for (UInt_t icomponent = 0; icomponent < fComponentWallTime.size(); icomponent++) {
+      fHistComponentWallTime->Fill(icomponent, fComponentWallTime[icomponent]);
+    }
+    fHistComponentWallTime->Fill(fCorrectionComponents.size(), totalTime.RealTime());
   }
 
   PostData(1, fOutput);
@@ -1361,6 +1689,62 @@ Bool_t AliEmcalCorrectionTask::Run()
   return kTRUE;
 }
 
+/**
+ * Run a single correction component and record its wall time.
+ *
+ * @param[in] icomponent Index of the component in the list of correction components
+ */
+void AliEmcalCorrectionTask::RunComponent(UInt_t icomponent)
+{
+  TStopwatch componentTime;
+  componentTime.Start();
+
+  fCorrectionComponents[icomponent]->Run();
+
+  // Each component has its own entry, so this is safe when running chains in parallel
+  if (icomponent < fComponentWallTime.size()) fComponentWallTime[icomponent] = componentTime.RealTime();
+}
+
+/**
+ * Run the independent component chains on the worker pool. Each thread takes the next chain which
+ * has not been processed yet and runs its components in order. The calling thread takes part in the
+ * processing and returns when all chains are done.
+ */
+void AliEmcalCorrectionTask::RunComponentChainsParallel()
+{
+  for (auto component : fCorrectionComponents) component->SetDeferLogMessages(kTRUE);
+
+  fWorkerPool->Run(fComponentChains.size(), [this](UInt_t ichain) {
+    for (auto icomponent : fComponentChains[ichain]) {
+      RunComponent(icomponent);
+    }
+  });
+
+  // Print the messages of the components on the main thread, in the order of execution
+  for (auto component : fCorrectionComponents) {
+    component->SetDeferLogMessages(kFALSE);
+    component->FlushLogMessages();
+  }
+}
+
+/**
+ * Load the super module matrices of the EMCal geometry used by the components. Otherwise they are
+ * loaded from gGeoManager on first access, which is not thread safe. Afterwards the geometry is only
+ * read by the components and can be shared by chains running in parallel.
+ */
+void AliEmcalCorrectionTask::LoadGeometryMatrices()
+{
+  if (!gGeoManager) return;
+  std::set <AliEMCALGeometry *> geometries;
+  if (fGeom) geometries.insert(fGeom);
+  for (auto component : fCorrectionComponents) {
+    if (component->GetEMCALGeometry()) geometries.insert(component->GetEMCALGeometry());
+  }
+  for (auto geom : geometries) {
+    for (Int_t ism = 0; ism < geom->GetNumberOfSuperModules(); ism++) geom->GetMatrixForSuperModule(ism);
+  }
+}
+
 /**
  * Executed when the file is changed. Also calls UserNotify() for each component.
  */
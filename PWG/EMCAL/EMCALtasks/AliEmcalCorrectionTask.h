@@ -10,6 +10,8 @@ class AliEmcalCorrectionCellContainer;
 class AliEmcalCorrectionComponent;
 class AliEMCALGeometry;
 class AliVEvent;
+class AliEmcalCorrectionTaskWorkerPool;
+class TH1;
 
 #include <iosfwd>
 
@@ -38,6 +40,25 @@ class AliVEvent;
  * In general, this steering class handles all of the configuration of the
  * corrections, including passing the relevant EMCal containers and event objects.
  *
+ * Components are grouped into chains based on the input objects (cells, cluster
+ * and track branches) configured for them in the YAML configuration and on the
+ * shared state which they declare via AliEmcalCorrectionComponent::GetSharedStateKeys()
+ * (AliEMCALRecoUtils, MC event, input objects not in their configuration): components
+ * sharing an input object or a state key are in the same chain and are run in the
+ * configured order. A component which does not declare its shared state puts all
+ * components into a single chain. The EMCal geometry is shared read-only, its matrices
+ * are loaded before the chains are run in parallel, and track propagation is serialised
+ * via AliEmcalCorrectionComponent::LockTrackPropagation(). Messages of the components
+ * are printed by the main thread after the chains were run, and the chains are run
+ * sequentially if AliLog debugging is enabled.
+ * If more than one thread is requested via SetNumberOfThreads() and there is more than
+ * one chain, the chains are run in parallel on a pool of threads which is started once;
+ * otherwise (or with ROOT versions without ROOT::EnableThreadSafety()) the components
+ * are run sequentially. The first event of each run is always processed sequentially,
+ * since the run-dependent initialization of the components (OCDB access) is not thread
+ * safe. The wall time spent in each component is accumulated in the histogram
+ * fHistComponentWallTime in the output list.
+ *
  * Note: YAML does not play nicely with CINT and dictionary generation, so it is
  * hidden using conditional inclusion.
  *
@@ -102,6 +123,8 @@ class AliEmcalCorrectionTask : public AliAnalysisTaskSE {
   void                        SetCentralityEstimator(const char * c)                { fCentEst           = c                              ; }
   virtual void                SetNCentBins(Int_t n)                                 { fNcentBins         = n                              ; }
   void                        SetCentRange(Double_t min, Double_t max)              { fMinCent           = min  ; fMaxCent = max          ; }
+  // Parallel execution of independent component chains
+  void                        SetNumberOfThreads(Int_t n)                           { fNThreads          = n                              ; }
 
   /**
    * Direct access to the correction components.
@@ -168,6 +191,13 @@ class AliEmcalCorrectionTask : public AliAnalysisTaskSE {
   // Execute component functions
   void UserCreateOutputObjectsComponents();
   void ExecOnceComponents();
+  void RunComponent(UInt_t icomponent);
+  void RunComponentChainsParallel();
+  void LoadGeometryMatrices();
+
+  // Component scheduling
+  void DetermineComponentChains();
+  void GetInputObjectKeysForComponent(AliEmcalCorrectionComponent * component, std::set <std::string> & keys);
 
   // Initialization functions
   void InitializeConfiguration();
@@ -233,10 +263,17 @@ class AliEmcalCorrectionTask : public AliAnalysisTaskSE {
   TObjArray                   fClusterCollArray;           ///< Cluster collection array
   std::vector <AliEmcalCorrectionCellContainer *> fCellCollArray; ///< Cells collection array
   
+  Int_t                       fNThreads;                   ///< Number of threads to run independent component chains (1 for sequential execution)
+  std::vector <std::vector <UInt_t> > fComponentChains;    //!<! Indices of the components in each independent chain, in execution order
+  std::vector <Double_t>      fComponentWallTime;          //!<! Wall time of each component in the current event
+  Int_t                       fLastRunNumber;              //!<! Run number of the previous event
+  AliEmcalCorrectionTaskWorkerPool * fWorkerPool;          //!<! Threads running the component chains in parallel (0 for sequential execution)
+
   TList *                     fOutput;                     //!<! Output for histograms
+  TH1 *                       fHistComponentWallTime;      //!<! Accumulated wall time of each component
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalCorrectionTask, 4); // EMCal correction task
+  ClassDef(AliEmcalCorrectionTask, 5); // EMCal correction task
   /// \endcond
 };
 
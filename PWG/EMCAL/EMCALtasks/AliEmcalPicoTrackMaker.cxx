@@ -2,6 +2,12 @@
 //
 // Class to make PicoTracks in AOD/ESD events.
 //
+// The accepted tracks are stored in a flat track table (AliEmcalTrackTable),
+// reused from event to event. With SetMakeTrackTable(kTRUE) the table is
+// published in the event, with SetMakePicoTracks(kFALSE) the AliPicoTrack
+// objects are only created when a consumer asks the table for them
+// (e.g. AliParticleContainer when not iterating the table directly).
+//
 // Author: S.Aiola, C.Loizides
 
 #include <TClonesArray.h>
@@ -17,6 +23,7 @@
 #include "AliVTrack.h"
 #include "AliAODMCParticle.h"
 #include "AliNamedArrayI.h"
+#include "AliEmcalTrackTable.h"
 
 ClassImp(AliEmcalPicoTrackMaker)
 
@@ -34,8 +41,11 @@ AliEmcalPicoTrackMaker::AliEmcalPicoTrackMaker() :
   fMaxTrackPhi(10),
   fTrackEfficiency(1),
   fCopyMCFlag(kFALSE),
+  fMakeTrackTable(kFALSE),
+  fMakePicoTracks(kTRUE),
   fTracksIn(0),
   fTracksOut(0),
+  fTrackTable(0),
   fMCParticles(0),
   fMCParticlesMap(0),
   fInit(kFALSE)
@@ -60,8 +70,11 @@ AliEmcalPicoTrackMaker::AliEmcalPicoTrackMaker(const char *name) :
   fMaxTrackPhi(10),
   fTrackEfficiency(1),
   fCopyMCFlag(kFALSE),
+  fMakeTrackTable(kFALSE),
+  fMakePicoTracks(kTRUE),
   fTracksIn(0),
   fTracksOut(0),
+  fTrackTable(0),
   fMCParticles(0),
   fMCParticlesMap(0),
   fInit(kFALSE)
@@ -77,6 +90,8 @@ AliEmcalPicoTrackMaker::AliEmcalPicoTrackMaker(const char *name) :
 AliEmcalPicoTrackMaker::~AliEmcalPicoTrackMaker()
 {
   // Destructor.
+
+  if (fTrackTable && !fMakeTrackTable) delete fTrackTable;
 }
 
 //________________________________________________________________________
@@ -112,6 +127,23 @@ void AliEmcalPicoTrackMaker::UserExec(Option_t *)
       InputEvent()->AddObject(fTracksOut);
     }
 
+    if (!fMakePicoTracks && !fMakeTrackTable) {
+      AliWarning(Form("%s: AliPicoTrack objects are made on request only, the track table %s_Table will be published in the event", GetName(), fTracksOutName.Data()));
+      fMakeTrackTable = kTRUE;
+    }
+
+    fTrackTable = new AliEmcalTrackTable(fTracksOutName + "_Table");
+    fTrackTable->SetPicoTrackArray(fTracksOut);
+
+    if (fMakeTrackTable) {
+      if (InputEvent()->FindListObject(fTrackTable->GetName())) {
+        AliFatal(Form("Object %s already present in the event!", fTrackTable->GetName()));
+      }
+      else {
+        InputEvent()->AddObject(fTrackTable);
+      }
+    }
+
     if (fCopyMCFlag) {
       fMCParticles = dynamic_cast<TClonesArray*>(InputEvent()->FindListObject(fMCParticlesName));
       if (!fMCParticles) {
@@ -130,11 +162,11 @@ void AliEmcalPicoTrackMaker::UserExec(Option_t *)
     fInit = kTRUE;
   }
 
-  fTracksOut->Delete();
+  fTrackTable->Clear();
 
   // loop over tracks
   const Int_t Ntracks = fTracksIn->GetEntriesFast();
-  for (Int_t iTracks = 0, nacc = 0; iTracks < Ntracks; ++iTracks) {
+  for (Int_t iTracks = 0; iTracks < Ntracks; ++iTracks) {
 
     AliVTrack *track = static_cast<AliVTrack*>(fTracksIn->At(iTracks));
 
@@ -160,30 +192,20 @@ void AliEmcalPicoTrackMaker::UserExec(Option_t *)
 	track->GetTrackPhiOnEMCal() < 190 * TMath::DegToRad())
       isEmc = kTRUE;
 
-    AliPicoTrack *picotrack = new ((*fTracksOut)[nacc]) AliPicoTrack(track->Pt(), 
-								     track->Eta(), 
-								     track->Phi(), 
-								     track->Charge(), 
-								     track->GetLabel(),
-								     AliPicoTrack::GetTrackType(track),
-								     track->GetTrackEtaOnEMCal(), 
-								     track->GetTrackPhiOnEMCal(), 
-								     track->GetTrackPtOnEMCal(), 
-								     isEmc);
-    picotrack->SetTrack(track);
+    Int_t itrack = fTrackTable->AddTrack(track, AliPicoTrack::GetTrackType(track), isEmc);
     
     if (fCopyMCFlag && track->GetLabel() != 0) {
       AliVParticle *mcpart = GetMCParticle(TMath::Abs(track->GetLabel()));
       if (mcpart) {
 	UInt_t mcFlag = mcpart->GetFlag();	
-	picotrack->SetFlag(mcFlag);
 	Short_t genIndex = mcpart->GetGeneratorIndex();
-	picotrack->SetGeneratorIndex(genIndex);
+	fTrackTable->SetMCInfo(itrack, mcFlag, genIndex);
       }
     }
-
-    ++nacc;
   }
+
+  if (fMakePicoTracks)
+    fTrackTable->GetPicoTracks();
 }
 
 //________________________________________________________________________
@@ -4,6 +4,7 @@
 class TClonesArray;
 class AliVParticle;
 class AliNamedArrayI;
+class AliEmcalTrackTable;
 
 #include "AliAnalysisTaskSE.h"
 
@@ -21,6 +22,8 @@ class AliEmcalPicoTrackMaker : public AliAnalysisTaskSE {
   void               SetTracksOutName(const char *name)                { fTracksOutName     = name; }
   void               SetMCParticlesName(const char *name)              { fMCParticlesName   = name; }
   void               SetCopyMCFlag(Bool_t c, const char* name)         { fCopyMCFlag        = c   ; fMCParticlesName  = name; }
+  void               SetMakeTrackTable(Bool_t b)                       { fMakeTrackTable    = b   ; }
+  void               SetMakePicoTracks(Bool_t b)                       { fMakePicoTracks    = b   ; }
   
 
  protected:
@@ -41,8 +44,11 @@ class AliEmcalPicoTrackMaker : public AliAnalysisTaskSE {
   Double_t           fMaxTrackPhi;          // cut on track phi
   Double_t           fTrackEfficiency;      // track efficiency
   Bool_t             fCopyMCFlag;           // copy MC flag
+  Bool_t             fMakeTrackTable;       // publish the flat track table (name: fTracksOutName + "_Table")
+  Bool_t             fMakePicoTracks;       // fill the AliPicoTrack array in every event (otherwise only on request through the track table)
   TClonesArray      *fTracksIn;             //!track array in
   TClonesArray      *fTracksOut;            //!track array out
+  AliEmcalTrackTable *fTrackTable;          //!flat track table out
   TClonesArray      *fMCParticles;          //!MC particle array
   AliNamedArrayI    *fMCParticlesMap;       //!MC particle map
   Bool_t             fInit;                 //!true = task initialized
@@ -51,6 +57,6 @@ class AliEmcalPicoTrackMaker : public AliAnalysisTaskSE {
   AliEmcalPicoTrackMaker(const AliEmcalPicoTrackMaker&);            // not implemented
   AliEmcalPicoTrackMaker &operator=(const AliEmcalPicoTrackMaker&); // not implemented
 
-  ClassDef(AliEmcalPicoTrackMaker, 8); // Task to make PicoTracks in AOD/ESD events
+  ClassDef(AliEmcalPicoTrackMaker, 9); // Task to make PicoTracks in AOD/ESD events
 };
 #endif
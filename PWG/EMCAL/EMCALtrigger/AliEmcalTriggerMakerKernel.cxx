@@ -12,6 +12,7 @@
  * about the suitability of this software for any purpose. It is          *
  * provided "as is" without express or implied warranty.                  *
  **************************************************************************/
+#include <algorithm>
 #include <iostream>
 #include <vector>
 #include <cstring>
@@ -65,6 +66,7 @@ AliEmcalTriggerMakerKernel::AliEmcalTriggerMakerKernel():
   fSmearModelMean(nullptr),
   fSmearModelSigma(nullptr),
   fSmearThreshold(0.1),
+  fL1AlgorithmSettings(),
   fGeometry(nullptr),
   fPatchAmplitudes(nullptr),
   fPatchADCSimple(nullptr),
@@ -72,9 +74,18 @@ AliEmcalTriggerMakerKernel::AliEmcalTriggerMakerKernel():
   fPatchEnergySimpleSmeared(nullptr),
   fLevel0TimeMap(nullptr),
   fTriggerBitMap(nullptr),
-  fADCtoGeV(1.)
+  fADCtoGeV(1.),
+  fIntegralImages(),
+  fIntegralOccupancy(),
+  fIntegralNCols(0),
+  fIntegralNRows(0),
+  fIntegralImagesValid(kFALSE),
+  fBadChannelMask(),
+  fOfflineBadChannelMask(),
+  fBadChannelMasksValid(kFALSE)
 {
   memset(fThresholdConstants, 0, sizeof(Int_t) * 12);
+  memset(fL0AlgorithmSettings, 0, sizeof(Int_t) * 5);
   memset(fL1ThresholdsOffline, 0, sizeof(ULong64_t) * 4);
   fCellTimeLimits[0] = -10000.;
   fCellTimeLimits[1] = 10000.;
@@ -128,6 +139,10 @@ void AliEmcalTriggerMakerKernel::AddL1TriggerAlgorithm(Int_t rowmin, Int_t rowma
   trigger->SetPatchSize(patchSize);
   trigger->SetSubregionSize(subregionSize);
   fPatchFinder->AddTriggerAlgorithm(trigger);
+
+  // Keep the settings for the patch finding on the integral images
+  Int_t settings[5] = {rowmin, rowmax, static_cast<Int_t>(bitmask), patchSize, subregionSize};
+  fL1AlgorithmSettings.insert(fL1AlgorithmSettings.end(), settings, settings + 5);
 }
 
 void AliEmcalTriggerMakerKernel::SetL0TriggerAlgorithm(Int_t rowmin, Int_t rowmax, UInt_t bitmask, Int_t patchSize, Int_t subregionSize)
@@ -136,6 +151,12 @@ void AliEmcalTriggerMakerKernel::SetL0TriggerAlgorithm(Int_t rowmin, Int_t rowma
   fLevel0PatchFinder = new AliEMCALTriggerAlgorithm<double>(rowmin, rowmax, bitmask);
   fLevel0PatchFinder->SetPatchSize(patchSize);
   fLevel0PatchFinder->SetSubregionSize(subregionSize);
+
+  fL0AlgorithmSettings[0] = rowmin;
+  fL0AlgorithmSettings[1] = rowmax;
+  fL0AlgorithmSettings[2] = static_cast<Int_t>(bitmask);
+  fL0AlgorithmSettings[3] = patchSize;
+  fL0AlgorithmSettings[4] = subregionSize;
 }
 
 void AliEmcalTriggerMakerKernel::ConfigureForPbPb2015()
@@ -146,6 +167,7 @@ void AliEmcalTriggerMakerKernel::ConfigureForPbPb2015()
   // Initialize patch finder
   if (fPatchFinder) delete fPatchFinder;
   fPatchFinder = new AliEMCALTriggerPatchFinder<double>;
+  fL1AlgorithmSettings.clear();
 
   SetL0TriggerAlgorithm(0, 103, 1<<fTriggerBitConfig->GetLevel0Bit(), 2, 1);
   AddL1TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetGammaHighBit() | 1<<fTriggerBitConfig->GetGammaLowBit(), 2, 1);
@@ -163,6 +185,7 @@ void AliEmcalTriggerMakerKernel::ConfigureForPP2015()
   // Initialize patch finder
   if (fPatchFinder) delete fPatchFinder;
   fPatchFinder = new AliEMCALTriggerPatchFinder<double>;
+  fL1AlgorithmSettings.clear();
 
   SetL0TriggerAlgorithm(0, 103, 1<<fTriggerBitConfig->GetLevel0Bit(), 2, 1);
   AddL1TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetGammaHighBit() | 1<<fTriggerBitConfig->GetGammaLowBit(), 2, 1);
@@ -180,6 +203,7 @@ void AliEmcalTriggerMakerKernel::ConfigureForPPb2013()
   // Initialize patch finder
   if (fPatchFinder) delete fPatchFinder;
   fPatchFinder = new AliEMCALTriggerPatchFinder<double>;
+  fL1AlgorithmSettings.clear();
 
   SetL0TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetLevel0Bit(), 2, 1);
   AddL1TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetGammaHighBit() | 1<<fTriggerBitConfig->GetGammaLowBit(), 2, 1);
@@ -195,6 +219,7 @@ void AliEmcalTriggerMakerKernel::ConfigureForPP2012()
   // Initialize patch finder
   if (fPatchFinder) delete fPatchFinder;
   fPatchFinder = new AliEMCALTriggerPatchFinder<double>;
+  fL1AlgorithmSettings.clear();
 
   SetL0TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetLevel0Bit(), 2, 1);
   AddL1TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetGammaHighBit(), 2, 1);
@@ -210,6 +235,7 @@ void AliEmcalTriggerMakerKernel::ConfigureForPbPb2011()
   // Initialize patch finder
   if (fPatchFinder) delete fPatchFinder;
   fPatchFinder = new AliEMCALTriggerPatchFinder<double>;
+  fL1AlgorithmSettings.clear();
 
   SetL0TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetLevel0Bit(), 2, 1);
   AddL1TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetGammaHighBit(), 2, 1);
@@ -225,6 +251,7 @@ void AliEmcalTriggerMakerKernel::ConfigureForPP2011()
   // Initialize patch finder
   if (fPatchFinder) delete fPatchFinder;
   fPatchFinder = new AliEMCALTriggerPatchFinder<double>;
+  fL1AlgorithmSettings.clear();
 
   SetL0TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetLevel0Bit(), 2, 1);
   fConfigured = true;
@@ -296,9 +323,12 @@ void AliEmcalTriggerMakerKernel::Reset(){
   fTriggerBitMap->Reset();
   if(fPatchEnergySimpleSmeared) fPatchEnergySimpleSmeared->Reset();
   memset(fL1ThresholdsOffline, 0, sizeof(ULong64_t) * 4);
+  fIntegralImagesValid = kFALSE;
 }
 
 void AliEmcalTriggerMakerKernel::ReadTriggerData(AliVCaloTrigger *trigger){
+  if(!fBadChannelMasksValid) BuildBadChannelMasks();
+  fIntegralImagesValid = kFALSE;
   trigger->Reset();
   Int_t globCol=-1, globRow=-1;
   Int_t adcAmp=-1, bitmap = 0;
@@ -341,7 +371,7 @@ void AliEmcalTriggerMakerKernel::ReadTriggerData(AliVCaloTrigger *trigger){
     }
 
     // exclude channel completely if it is masked as hot channel
-    if (fBadChannels.find(absId) != fBadChannels.end()){
+    if (IsChannelMasked(fBadChannelMask, fBadChannels, absId)){
       AliDebugStream(1) << "Found ADC for masked fastor " << absId << ", rejecting" << std::endl;
       continue;
     }
@@ -385,13 +415,15 @@ void AliEmcalTriggerMakerKernel::ReadTriggerData(AliVCaloTrigger *trigger){
 
 void AliEmcalTriggerMakerKernel::ReadCellData(AliVCaloCells *cells){
   // fill the patch ADCs from cells
+  if(!fBadChannelMasksValid) BuildBadChannelMasks();
+  fIntegralImagesValid = kFALSE;
   Int_t nCell = cells->GetNumberOfCells();
   for(Int_t iCell = 0; iCell < nCell; ++iCell) {
     // get the cell info, based in index in array
     Short_t cellId = cells->GetCellNumber(iCell);
 
     // Check bad channel map
-    if (fOfflineBadChannels.find(cellId) != fOfflineBadChannels.end()) {
+    if (IsChannelMasked(fOfflineBadChannelMask, fOfflineBadChannels, cellId)) {
       AliDebugStream(1) << "Cell " << cellId << " masked as bad channel, rejecting." << std::endl;
       continue;
     }
@@ -407,7 +439,7 @@ void AliEmcalTriggerMakerKernel::ReadCellData(AliVCaloCells *cells){
       // Exclude FEE amplitudes from cells which are within a TRU which is masked at
       // online level. Using this the online acceptance can be applied to offline
       // patches as well.
-      if(fBadChannels.find(absId) != fBadChannels.end()){
+      if(IsChannelMasked(fBadChannelMask, fBadChannels, absId)){
         AliDebugStream(1) << "Cell " << cellId << " corresponding to masked fastor " << absId << ", rejecting." << std::endl;
         continue;
       }
@@ -487,8 +519,18 @@ void AliEmcalTriggerMakerKernel::CreateTriggerPatches(const AliVEvent *inputeven
   bkgPatchMask = 1 << fTriggerBitConfig->GetBkgBit();
       //l0PatchMask = 1 << fTriggerBitConfig->GetLevel0Bit();
 
+  // Build the integral images once for the event - all patch sizes, subregions and
+  // amplitude sources below are obtained from them in constant time per patch
+  BuildIntegralImages();
+  EPatchAmplitudeSource_t onlinesource = useL0amp ? kOnlineL0Amplitude : kOnlineADC;
+
   std::vector<AliEMCALTriggerRawPatch> patches;
-  if (fPatchFinder) {
+  if (fL1AlgorithmSettings.size()) {
+    for(std::vector<Int_t>::size_type ialgo = 0; ialgo + 5 <= fL1AlgorithmSettings.size(); ialgo += 5)
+      FindPatchesIntegral(&fL1AlgorithmSettings[ialgo], onlinesource, patches);
+  }
+  else if (fPatchFinder) {
+    // Patch finder configured in a version of the class not storing the algorithm settings
     if (useL0amp) {
       patches = fPatchFinder->FindPatches(*fPatchAmplitudes, *fPatchADCSimple);
     }
@@ -530,12 +572,7 @@ void AliEmcalTriggerMakerKernel::CreateTriggerPatches(const AliVEvent *inputeven
     fullpatch.SetOffSet(offset);
     if(fPatchEnergySimpleSmeared){
       // Add smeared energy
-      double energysmear = 0;
-      for(int icol = 0; icol < fullpatch.GetPatchSize(); icol++){
-        for(int irow = 0; irow < fullpatch.GetPatchSize(); irow++){
-          energysmear += (*fPatchEnergySimpleSmeared)(fullpatch.GetColStart() + icol, fullpatch.GetRowStart() + irow);
-        }
-      }
+      double energysmear = GetPatchAmplitudeSum(kOfflineEnergySmeared, fullpatch.GetColStart(), fullpatch.GetRowStart(), fullpatch.GetPatchSize(), fullpatch.GetPatchSize());
       AliDebugStream(1) << "Patch size(" << fullpatch.GetPatchSize() <<") energy " << fullpatch.GetPatchE() << " smeared " << energysmear << std::endl;
       fullpatch.SetSmearedEnergy(energysmear);
     }
@@ -544,7 +581,8 @@ void AliEmcalTriggerMakerKernel::CreateTriggerPatches(const AliVEvent *inputeven
 
   // Find Level0 patches
   std::vector<AliEMCALTriggerRawPatch> l0patches;
-  if (fLevel0PatchFinder) l0patches = fLevel0PatchFinder->FindPatches(*fPatchAmplitudes, *fPatchADCSimple);
+  if (fL0AlgorithmSettings[3] > 0) FindPatchesIntegral(fL0AlgorithmSettings, kOnlineL0Amplitude, l0patches);
+  else if (fLevel0PatchFinder) l0patches = fLevel0PatchFinder->FindPatches(*fPatchAmplitudes, *fPatchADCSimple);
   for(std::vector<AliEMCALTriggerRawPatch>::iterator patchit = l0patches.begin(); patchit != l0patches.end(); ++patchit){
     Int_t offlinebits = 0, onlinebits = 0;
     if(HasPHOSOverlap(*patchit)) continue;
@@ -561,12 +599,7 @@ void AliEmcalTriggerMakerKernel::CreateTriggerPatches(const AliVEvent *inputeven
     fullpatch.SetTriggerBitConfig(fTriggerBitConfig);
     if(fPatchEnergySimpleSmeared){
       // Add smeared energy
-      double energysmear = 0;
-      for(int icol = 0; icol < fullpatch.GetPatchSize(); icol++){
-        for(int irow = 0; irow < fullpatch.GetPatchSize(); irow++){
-          energysmear += (*fPatchEnergySimpleSmeared)(fullpatch.GetColStart() + icol, fullpatch.GetRowStart() + irow);
-        }
-      }
+      double energysmear = GetPatchAmplitudeSum(kOfflineEnergySmeared, fullpatch.GetColStart(), fullpatch.GetRowStart(), fullpatch.GetPatchSize(), fullpatch.GetPatchSize());
       fullpatch.SetSmearedEnergy(energysmear);
     }
     outputcont.push_back(fullpatch);
@@ -631,6 +664,94 @@ double AliEmcalTriggerMakerKernel::GetDataGridDimensionRows() const{
   return fPatchADC->GetNumberOfRows();
 }
 
+void AliEmcalTriggerMakerKernel::BuildIntegralImages(){
+  if(fIntegralImagesValid) return;
+  fIntegralNCols = fPatchADC->GetNumberOfCols();
+  fIntegralNRows = fPatchADC->GetNumberOfRows();
+  const Int_t stride = fIntegralNCols + 1, imagesize = stride * (fIntegralNRows + 1);
+  fIntegralImages.assign(kNPatchAmplitudeSources * imagesize, 0.);
+  fIntegralOccupancy.assign(kNPatchAmplitudeSources * imagesize, 0);
+
+  AliEMCALTriggerDataGrid<double> *grids[kNPatchAmplitudeSources] = {fPatchADC, fPatchAmplitudes, fPatchADCSimple, fPatchEnergySimpleSmeared};
+  for(int isource = 0; isource < kNPatchAmplitudeSources; isource++){
+    if(!grids[isource]) continue;
+    AliEMCALTriggerDataGrid<double> &grid = *grids[isource];
+    double *image = &fIntegralImages[isource * imagesize];
+    Int_t *occupancy = &fIntegralOccupancy[isource * imagesize];
+    for(int irow = 0; irow < fIntegralNRows; irow++){
+      double rowsum = 0;
+      Int_t rowcount = 0;
+      for(int icol = 0; icol < fIntegralNCols; icol++){
+        double amp = grid(icol, irow);
+        rowsum += amp;
+        if(amp != 0) rowcount++;
+        image[(irow + 1) * stride + icol + 1] = image[irow * stride + icol + 1] + rowsum;
+        occupancy[(irow + 1) * stride + icol + 1] = occupancy[irow * stride + icol + 1] + rowcount;
+      }
+    }
+  }
+  fIntegralImagesValid = kTRUE;
+}
+
+double AliEmcalTriggerMakerKernel::GetPatchAmplitudeSum(EPatchAmplitudeSource_t source, Int_t col, Int_t row, Int_t ncols, Int_t nrows) const {
+  AliEMCALTriggerDataGrid<double> *grids[kNPatchAmplitudeSources] = {fPatchADC, fPatchAmplitudes, fPatchADCSimple, fPatchEnergySimpleSmeared};
+  if(source < 0 || source >= kNPatchAmplitudeSources || !grids[source]) return 0.;
+  AliEMCALTriggerDataGrid<double> &grid = *grids[source];
+
+  // Restrict the region to the data grid
+  Int_t colmin = std::max(col, 0), colmax = std::min(col + ncols, grid.GetNumberOfCols()),
+        rowmin = std::max(row, 0), rowmax = std::min(row + nrows, grid.GetNumberOfRows());
+  if(colmin >= colmax || rowmin >= rowmax) return 0.;
+
+  if(!fIntegralImagesValid){
+    double sum = 0;
+    for(int irow = rowmin; irow < rowmax; irow++){
+      for(int icol = colmin; icol < colmax; icol++) sum += grid(icol, irow);
+    }
+    return sum;
+  }
+
+  const Int_t stride = fIntegralNCols + 1, offset = source * stride * (fIntegralNRows + 1);
+  const Int_t i00 = offset + rowmin * stride + colmin, i01 = offset + rowmin * stride + colmax,
+              i10 = offset + rowmax * stride + colmin, i11 = offset + rowmax * stride + colmax;
+  // Regions without signal are exactly 0 (as in the direct sum)
+  if(fIntegralOccupancy[i11] - fIntegralOccupancy[i10] - fIntegralOccupancy[i01] + fIntegralOccupancy[i00] == 0) return 0.;
+  return fIntegralImages[i11] - fIntegralImages[i10] - fIntegralImages[i01] + fIntegralImages[i00];
+}
+
+void AliEmcalTriggerMakerKernel::FindPatchesIntegral(const Int_t *settings, EPatchAmplitudeSource_t onlinesource, std::vector<AliEMCALTriggerRawPatch> &patches) const {
+  const Int_t rowmin = settings[0], rowmax = settings[1], patchsize = settings[3], subregionsize = settings[4];
+  const UInt_t bitmask = static_cast<UInt_t>(settings[2]);
+  if(patchsize <= 0 || subregionsize <= 0) return;
+  const Int_t rowstartmax = rowmax - (patchsize - 1), colstartmax = fPatchADC->GetNumberOfCols() - patchsize;
+  for(int irow = rowmin; irow <= rowstartmax; irow += subregionsize){
+    for(int icol = 0; icol <= colstartmax; icol += subregionsize){
+      double adc = GetPatchAmplitudeSum(onlinesource, icol, irow, patchsize, patchsize),
+             offlineadc = GetPatchAmplitudeSum(kOfflineADC, icol, irow, patchsize, patchsize);
+      if(adc > 0 || offlineadc > 0){
+        AliEMCALTriggerRawPatch recpatch(icol, irow, patchsize, adc, offlineadc);
+        recpatch.SetBitmask(bitmask);
+        patches.push_back(recpatch);
+      }
+    }
+  }
+}
+
+void AliEmcalTriggerMakerKernel::BuildBadChannelMasks(){
+  fBadChannelMask.clear();
+  fOfflineBadChannelMask.clear();
+  // Sets are ordered, the last entry defines the size of the mask
+  if(fBadChannels.size() && *fBadChannels.rbegin() >= 0){
+    fBadChannelMask.resize(*fBadChannels.rbegin() + 1, 0);
+    for(std::set<Short_t>::const_iterator it = fBadChannels.lower_bound(0); it != fBadChannels.end(); ++it) fBadChannelMask[*it] = 1;
+  }
+  if(fOfflineBadChannels.size() && *fOfflineBadChannels.rbegin() >= 0){
+    fOfflineBadChannelMask.resize(*fOfflineBadChannels.rbegin() + 1, 0);
+    for(std::set<Short_t>::const_iterator it = fOfflineBadChannels.lower_bound(0); it != fOfflineBadChannels.end(); ++it) fOfflineBadChannelMask[*it] = 1;
+  }
+  fBadChannelMasksValid = kTRUE;
+}
+
 AliEmcalTriggerMakerKernel::ELevel0TriggerStatus_t AliEmcalTriggerMakerKernel::CheckForL0(Int_t col, Int_t row) const {
   ELevel0TriggerStatus_t result = kLevel0Candidate;
 
@@ -667,10 +788,12 @@ AliEmcalTriggerMakerKernel::ELevel0TriggerStatus_t AliEmcalTriggerMakerKernel::C
 
 void AliEmcalTriggerMakerKernel::ClearFastORBadChannels(){
   fBadChannels.clear();
+  fBadChannelMasksValid = kFALSE;
 }
 
 void AliEmcalTriggerMakerKernel::ClearOfflineBadChannels() {
   fOfflineBadChannels.clear();
+  fBadChannelMasksValid = kFALSE;
 }
 
 Bool_t AliEmcalTriggerMakerKernel::IsGammaPatch(const AliEMCALTriggerRawPatch &patch) const {
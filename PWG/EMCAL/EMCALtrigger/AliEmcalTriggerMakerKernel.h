@@ -51,6 +51,18 @@ public:
 
   enum ELevel0TriggerStatus_t { kNotLevel0, kLevel0Candidate, kLevel0Fired };
 
+  /**
+   * @enum EPatchAmplitudeSource_t
+   * @brief Amplitude sources for which an integral image is built in each event
+   */
+  enum EPatchAmplitudeSource_t {
+    kOnlineADC = 0,             ///< L1 FastOR ADC values (fPatchADC)
+    kOnlineL0Amplitude = 1,     ///< L0 FastOR amplitudes (fPatchAmplitudes)
+    kOfflineADC = 2,            ///< FEE ADC values from cell energies (fPatchADCSimple)
+    kOfflineEnergySmeared = 3,  ///< Smeared FEE energies (fPatchEnergySimpleSmeared)
+    kNPatchAmplitudeSources = 4 ///< Number of amplitude sources
+  };
+
   /**
    * @brief Constructor
    */
@@ -160,6 +172,22 @@ public:
    */
   double GetDataGridDimensionRows() const;
 
+  /**
+   * @brief Get the sum of amplitudes in a rectangular region of the data grid
+   *
+   * Once the integral images have been built for the event (done in CreateTriggerPatches)
+   * the sum is obtained in constant time from four lookups, independent of the
+   * size of the region. Before this the sum is calculated from the data grid directly.
+   * Parts of the region outside the data grid are ignored.
+   * @param[in] source Amplitude source (online ADC, L0 amplitude, offline ADC, smeared energy)
+   * @param[in] col Starting column of the region
+   * @param[in] row Starting row of the region
+   * @param[in] ncols Number of columns in the region
+   * @param[in] nrows Number of rows in the region
+   * @return Sum of the amplitudes in the region (0 for an empty region or a source which is not available)
+   */
+  double GetPatchAmplitudeSum(EPatchAmplitudeSource_t source, Int_t col, Int_t row, Int_t ncols, Int_t nrows) const;
+
   /**
    * @brief Define whether running on MC or not (for offset)
    * @param isMC Flag for MC
@@ -203,7 +231,7 @@ public:
    * @brief Add a FastOR bad channel to the list
    * @param[in] absId Absolute ID of the bad channel
    */
-  void AddFastORBadChannel(Short_t absId) { fBadChannels.insert(absId); }
+  void AddFastORBadChannel(Short_t absId) { fBadChannels.insert(absId); fBadChannelMasksValid = kFALSE; }
 
   /**
    * @brief Read the FastOR bad channel map from a standard stream
@@ -226,7 +254,7 @@ public:
    * @brief Add an offline bad channel to the set
    * @param[in] absId Absolute ID of the bad channel
    */
-  void AddOfflineBadChannel(Short_t absId) { fOfflineBadChannels.insert(absId); }
+  void AddOfflineBadChannel(Short_t absId) { fOfflineBadChannels.insert(absId); fBadChannelMasksValid = kFALSE; }
 
   /**
    * @brief Read the offline bad channel map from a standard stream
@@ -459,6 +487,45 @@ protected:
    */
   bool HasPHOSOverlap(const AliEMCALTriggerRawPatch &patch) const;
 
+  /**
+   * @brief Build the integral images (summed-area tables) of all amplitude sources
+   *
+   * Each image has one row and one column more than the data grid, entry (col, row)
+   * containing the sum of all channels below col and row. An additional occupancy
+   * image counts the non-zero channels, so that regions without signal are
+   * guaranteed to sum to exactly 0 despite rounding in the differences.
+   */
+  void BuildIntegralImages();
+
+  /**
+   * @brief Find trigger patches for a given algorithm setting using the integral images
+   *
+   * Same patch definition as in AliEMCALTriggerAlgorithm: patches are placed in
+   * steps of the subregion size and accepted if the online or offline sum is
+   * larger than 0.
+   * @param[in] settings Algorithm setting (row min, row max, bitmask, patch size, subregion size)
+   * @param[in] onlinesource Amplitude source used as online ADC
+   * @param[out] patches Container the patches found are appended to
+   */
+  void FindPatchesIntegral(const Int_t *settings, EPatchAmplitudeSource_t onlinesource, std::vector<AliEMCALTriggerRawPatch> &patches) const;
+
+  /**
+   * @brief Build dense masks for the online and offline bad channels from the bad channel sets
+   */
+  void BuildBadChannelMasks();
+
+  /**
+   * @brief Check whether a channel is masked, using the dense mask for non-negative IDs
+   * @param[in] mask Dense mask (index is the absolute ID)
+   * @param[in] badchannels Set of bad channels the mask was built from
+   * @param[in] absId Absolute ID of the channel
+   * @return True if the channel is masked
+   */
+  static Bool_t IsChannelMasked(const std::vector<UChar_t> &mask, const std::set<Short_t> &badchannels, Int_t absId) {
+    if (absId < 0) return badchannels.find(absId) != badchannels.end();
+    return static_cast<UInt_t>(absId) < mask.size() && mask[absId];
+  }
+
   std::set<Short_t>                         fBadChannels;                 ///< Container of bad channels
   std::set<Short_t>                         fOfflineBadChannels;          ///< Abd ID of offline bad channels
   TArrayF                                   fFastORPedestal;              ///< FastOR pedestal
@@ -484,6 +551,8 @@ protected:
   TF1                                       *fSmearModelMean;             ///< Smearing parameterization for the mean
   TF1                                       *fSmearModelSigma;            ///< Smearing parameterization for the width
   Double_t                                  fSmearThreshold;              ///< Smear threshold: Only cell energies above threshold are smeared
+  std::vector<Int_t>                        fL1AlgorithmSettings;         ///< Settings of the L1 algorithms (5 entries per algorithm: row min, row max, bitmask, patch size, subregion size)
+  Int_t                                     fL0AlgorithmSettings[5];      ///< Settings of the L0 algorithm (same layout as L1, patch size 0 if not set)
 
   const AliEMCALGeometry                    *fGeometry;                   //!<! Underlying EMCAL geometry
   AliEMCALTriggerDataGrid<double>           *fPatchAmplitudes;            //!<! TRU Amplitudes (for L0)
@@ -495,8 +564,17 @@ protected:
 
   Double_t                                  fADCtoGeV;                    //!<! Conversion factor from ADC to GeV
 
+  std::vector<double>                       fIntegralImages;              //!<! Integral images of all amplitude sources, (cols+1) x (rows+1) per source
+  std::vector<Int_t>                        fIntegralOccupancy;           //!<! Integral images of the number of non-zero channels per source
+  Int_t                                     fIntegralNCols;               //!<! Number of columns of the data grid the integral images were built for
+  Int_t                                     fIntegralNRows;               //!<! Number of rows of the data grid the integral images were built for
+  Bool_t                                    fIntegralImagesValid;         //!<! Integral images are up to date with the data grids
+  std::vector<UChar_t>                      fBadChannelMask;              //!<! Dense mask of online bad channels, indexed by FastOR abs. ID
+  std::vector<UChar_t>                      fOfflineBadChannelMask;       //!<! Dense mask of offline bad channels, indexed by cell abs. ID
+  Bool_t                                    fBadChannelMasksValid;        //!<! Dense masks are up to date with the bad channel sets
+
   /// \cond CLASSIMP
-  ClassDef(AliEmcalTriggerMakerKernel, 4);
+  ClassDef(AliEmcalTriggerMakerKernel, 5);
   /// \endcond
 };
 
@@ -730,12 +730,22 @@ void AliFlowAnalysisCRC::Make(AliFlowEventSimple* anEvent)
 
   // loop over particles **********************************************************************************************
 
+  // per-track quantities are read from the contiguous arrays of the flow event (index i corresponds to GetTrack(i))
+  const Double_t *eventPhi = anEvent->GetTrackPhiArray();
+  const Double_t *eventPt = anEvent->GetTrackPtArray();
+  const Double_t *eventEta = anEvent->GetTrackEtaArray();
+  const Int_t *eventCharge = anEvent->GetTrackChargeArray();
+  const UInt_t *eventFlowBits = anEvent->GetTrackFlowBitsArray();
+  const UInt_t bitRP = 1u<<AliFlowTrackSimple::kRP;
+  const UInt_t bitPOI = 1u<<AliFlowTrackSimple::kPOI;
+  const UInt_t bitPOI1 = 1u<<AliFlowTrackSimple::kPOI1;
+
   for(Int_t i=0;i<nPrim;i++) {
     if(fExactNoRPs > 0 && nCounterNoRPs>fExactNoRPs){continue;}
     aftsTrack=anEvent->GetTrack(i);
     if(aftsTrack) {
 
-      if(!(aftsTrack->InRPSelection() || aftsTrack->InPOISelection() || aftsTrack->InPOISelection(2))){continue;} // safety measure: consider only tracks which are RPs or POIs
+      if(!(eventFlowBits[i] & (bitRP|bitPOI|bitPOI1))){continue;} // safety measure: consider only tracks which are RPs or POIs
 
       Bool_t IsSplitMergedTracks = kFALSE;
       if(fRemoveSplitMergedTracks) {
@@ -745,12 +755,12 @@ void AliFlowAnalysisCRC::Make(AliFlowEventSimple* anEvent)
 
       // RPs *********************************************************************************************************
 
-      if(aftsTrack->InRPSelection()) {
+      if(eventFlowBits[i] & bitRP) {
         nCounterNoRPs++;
-        dPhi = aftsTrack->Phi();
-        dPt  = aftsTrack->Pt();
-        dEta = aftsTrack->Eta();
-        dCharge = aftsTrack->Charge();
+        dPhi = eventPhi[i];
+        dPt  = eventPt[i];
+        dEta = eventEta[i];
+        dCharge = eventCharge[i];
 
         if(fSelectCharge==kPosCh && dCharge<0.) continue;
         if(fSelectCharge==kNegCh && dCharge>0.) continue;
@@ -860,7 +870,7 @@ void AliFlowAnalysisCRC::Make(AliFlowEventSimple* anEvent)
             } // end of for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
           } // end of for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
           // Checking if RP particle is also POI particle:
-          if(aftsTrack->InPOISelection())
+          if(eventFlowBits[i] & bitPOI)
           {
             // Calculate q_{m*n,k} and s_{p,k} ('q-vector' and 's' for RPs && POIs):
             for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
@@ -890,23 +900,23 @@ void AliFlowAnalysisCRC::Make(AliFlowEventSimple* anEvent)
                 } // end of if(fCalculate2DDiffFlow)
               } // end of for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
             } // end of for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
-          } // end of if(aftsTrack->InPOISelection())
+          } // end of if(eventFlowBits[i] & bitPOI)
         } // end of if(fCalculateDiffFlow || fCalculate2DDiffFlow)
 
       } // end of if(pTrack->InRPSelection())
 
       // POIs ********************************************************************************************************
 
-      if(aftsTrack->InPOISelection() || aftsTrack->InPOISelection(2)) {
+      if(eventFlowBits[i] & (bitPOI|bitPOI1)) {
 
-        if(!fUseTracklets && aftsTrack->InPOISelection(2)) continue;
-        if(fUseTracklets && !aftsTrack->InPOISelection(2)) continue;
+        if(!fUseTracklets && (eventFlowBits[i] & bitPOI1)) continue;
+        if(fUseTracklets && !(eventFlowBits[i] & bitPOI1)) continue;
 
-        dPhi = aftsTrack->Phi();
-        dPt  = aftsTrack->Pt();
-        dEta = aftsTrack->Eta();
-        dCharge = aftsTrack->Charge();
-        Int_t ITStype = aftsTrack->ITStype();
+        dPhi = eventPhi[i];
+        dPt  = eventPt[i];
+        dEta = eventEta[i];
+        dCharge = eventCharge[i];
+        Int_t ITStype = aftsTrack->ITStype(); // not mirrored in the flow event arrays
 
         if(fSelectCharge==kPosCh && dCharge<0.) continue;
         if(fSelectCharge==kNegCh && dCharge>0.) continue;
@@ -1616,28 +1626,33 @@ Bool_t AliFlowAnalysisCRC::EvaulateIfSplitMergedTracks(AliFlowEventSimple* anEve
 
   Bool_t isNoSplit = kFALSE;
 
+  // the second track of each pair is read from the contiguous arrays of the flow event (empty slots have no flow bits)
+  const Double_t *eventPhi = anEvent->GetTrackPhiArray();
+  const Double_t *eventPt = anEvent->GetTrackPtArray();
+  const Double_t *eventEta = anEvent->GetTrackEtaArray();
+  const Int_t *eventCharge = anEvent->GetTrackChargeArray();
+  const UInt_t *eventFlowBits = anEvent->GetTrackFlowBitsArray();
+  const UInt_t bitsRPorPOI = (1u<<AliFlowTrackSimple::kRP) | (1u<<AliFlowTrackSimple::kPOI) | (1u<<AliFlowTrackSimple::kPOI1);
+  const Double_t eta1 = aftsTrack->Eta();
+  const Double_t pt1 = aftsTrack->Pt();
+  const Int_t charge1 = aftsTrack->Charge();
+
   //your cuts
   if (it1 < nTracks - 1) {
     for (Int_t itll2 = it1 + 1; itll2 < nTracks; itll2++) {
 
-      AliFlowTrackSimple* aftsTrack2 = (AliFlowTrackSimple*)anEvent->GetTrack(itll2);
-      if (!aftsTrack2) {
-        delete aftsTrack2;
-        continue;
-      }
-
-      if(!(aftsTrack2->InRPSelection() || aftsTrack2->InPOISelection() || aftsTrack2->InPOISelection(2))){continue;} // safety measure: consider only tracks which are RPs or POIs
+      if(!(eventFlowBits[itll2] & bitsRPorPOI)){continue;} // safety measure: consider only tracks which are RPs or POIs
 
-      Double_t deta1 = aftsTrack->Eta() - aftsTrack2->Eta();
+      Double_t deta1 = eta1 - eventEta[itll2];
 
       if (TMath::Abs(deta1) < 0.02 * 2.5 * 3) {
         // phi in rad
         Float_t phi1rad1 = aftsTrack->Phi();
-        Float_t phi2rad1 = aftsTrack2->Phi();
+        Float_t phi2rad1 = eventPhi[itll2];
 
         // check first boundaries to see if is worth to loop and find the minimum
-        Float_t dphistar11 = GetDPhiStar(phi1rad1, aftsTrack->Pt(), aftsTrack->Charge(), phi2rad1, aftsTrack2->Pt(), aftsTrack2->Charge(), 0.8, bSign);
-        Float_t dphistar21 = GetDPhiStar(phi1rad1, aftsTrack->Pt(), aftsTrack->Charge(), phi2rad1, aftsTrack2->Pt(), aftsTrack2->Charge(), 2.5, bSign);
+        Float_t dphistar11 = GetDPhiStar(phi1rad1, pt1, charge1, phi2rad1, eventPt[itll2], eventCharge[itll2], 0.8, bSign);
+        Float_t dphistar21 = GetDPhiStar(phi1rad1, pt1, charge1, phi2rad1, eventPt[itll2], eventCharge[itll2], 2.5, bSign);
         Float_t dphistarminabs1 = 1e5;
         Float_t dphistarmin1 = 1e5;
 
@@ -1645,7 +1660,7 @@ Bool_t AliFlowAnalysisCRC::EvaulateIfSplitMergedTracks(AliFlowEventSimple* anEve
 
           for (Double_t rad1 = 0.8; rad1 < 2.51; rad1 += 0.01) {
 
-            Float_t dphistar1 = GetDPhiStar(phi1rad1, aftsTrack->Pt(), aftsTrack->Charge(), phi2rad1, aftsTrack2->Pt(), aftsTrack2->Charge(), rad1, bSign);
+            Float_t dphistar1 = GetDPhiStar(phi1rad1, pt1, charge1, phi2rad1, eventPt[itll2], eventCharge[itll2], rad1, bSign);
             Float_t dphistarabs1 = TMath::Abs(dphistar1);
             if (dphistarabs1 < dphistarminabs1) {
               dphistarmin1 = dphistar1;
@@ -447,16 +447,22 @@ void AliFlowAnalysisWithCumulants::FillGeneratingFunctionsForDifferentTuningPara
   } 
  }
  
+ // Per-track quantities are read from the contiguous arrays of the flow event (index i corresponds to GetTrack(i)):
+ const Double_t *eventPhi = anEvent->GetTrackPhiArray();
+ const Double_t *eventPt = anEvent->GetTrackPtArray();
+ const Double_t *eventEta = anEvent->GetTrackEtaArray();
+ const UInt_t *eventFlowBits = anEvent->GetTrackFlowBitsArray();
+ const UInt_t bitRP = 1u<<AliFlowTrackSimple::kRP;
+
  // Looping over tracks:
  for(Int_t i=0;i<nPrim;i++)
  {
-  AliFlowTrackSimple *aftsTrack = anEvent->GetTrack(i);
-  if(aftsTrack && aftsTrack->InRPSelection())
+  if(eventFlowBits[i] & bitRP) // empty slots have no flow bits
   {
    // Access particle variables and weights:
-   dPhi = aftsTrack->Phi();
-   dPt  = aftsTrack->Pt();
-   dEta = aftsTrack->Eta();
+   dPhi = eventPhi[i];
+   dPt  = eventPt[i];
+   dEta = eventEta[i];
    if(fUsePhiWeights && fnBinsPhi) // determine phi weight for this particle:
    {
     wPhi = fPhiWeights->GetBinContent(1+(Int_t)(TMath::Floor(dPhi*fnBinsPhi/TMath::TwoPi())));
@@ -485,7 +491,7 @@ void AliFlowAnalysisWithCumulants::FillGeneratingFunctionsForDifferentTuningPara
      } // end of for(Int_t p=0;p<pMax[pq];p++)
     } // end for(Int_t pq=0;pq<5;pq++) // 5 different values for set (pMax,qMax)
    } // end of for(Int_t r=0;r<10;r++) // 10 different values for interpolating parameter r0  
-  } // end of if(aftsTrack && aftsTrack->InRPSelection())
+  } // end of if(eventFlowBits[i] & bitRP)
  } // end of for(Int_t i=0;i<nPrim;i++) 
   
  // Store G[p][q]:
@@ -547,17 +553,23 @@ void AliFlowAnalysisWithCumulants::FillGeneratingFunctionForReferenceFlow(AliFlo
  // Cross-checking the number of RPs in current event:
  Int_t crossCheckRP = 0; 
  
+ // Per-track quantities are read from the contiguous arrays of the flow event (index i corresponds to GetTrack(i)):
+ const Double_t *eventPhi = anEvent->GetTrackPhiArray();
+ const Double_t *eventPt = anEvent->GetTrackPtArray();
+ const Double_t *eventEta = anEvent->GetTrackEtaArray();
+ const UInt_t *eventFlowBits = anEvent->GetTrackFlowBitsArray();
+ const UInt_t bitRP = 1u<<AliFlowTrackSimple::kRP;
+
  // Looping over tracks:
  for(Int_t i=0;i<nPrim;i++)
  {
-  AliFlowTrackSimple *aftsTrack = anEvent->GetTrack(i);
-  if(aftsTrack && aftsTrack->InRPSelection())
+  if(eventFlowBits[i] & bitRP) // empty slots have no flow bits
   {
    crossCheckRP++;
    // Access particle variables and weights:
-   dPhi = aftsTrack->Phi();
-   dPt  = aftsTrack->Pt();
-   dEta = aftsTrack->Eta();
+   dPhi = eventPhi[i];
+   dPt  = eventPt[i];
+   dEta = eventEta[i];
    if(fUsePhiWeights && fnBinsPhi) // determine phi weight for this particle:
    {
     wPhi = fPhiWeights->GetBinContent(1+(Int_t)(TMath::Floor(dPhi*fnBinsPhi/TMath::TwoPi())));
@@ -580,7 +592,7 @@ void AliFlowAnalysisWithCumulants::FillGeneratingFunctionForReferenceFlow(AliFlo
    }
    // Fill the profile to calculate <<w^2>>: 
    fAverageOfSquaredWeight->Fill(0.5,pow(wPhi*wPt*wEta,2.),1.); 
-  } // end of if(aftsTrack && aftsTrack->InRPSelection())
+  } // end of if(eventFlowBits[i] & bitRP)
  } // end of for(Int_t i=0;i<nPrim;i++) 
  
  // Cross check # of RPs:
@@ -675,115 +687,67 @@ void AliFlowAnalysisWithCumulants::FillGeneratingFunctionForDiffFlow(AliFlowEven
  
  Int_t nRP = anEvent->GetEventNSelTracksRP(); // nRP = # of particles used to determine the reaction plane
        
+ // Per-track quantities are read from the contiguous arrays of the flow event (index i corresponds to GetTrack(i)):
+ const Double_t *eventPhi = anEvent->GetTrackPhiArray();
+ const Double_t *eventPt = anEvent->GetTrackPtArray();
+ const Double_t *eventEta = anEvent->GetTrackEtaArray();
+ const UInt_t *eventFlowBits = anEvent->GetTrackFlowBitsArray();
+ const UInt_t bitRP = 1u<<AliFlowTrackSimple::kRP;
+ const UInt_t bitPOI = 1u<<AliFlowTrackSimple::kPOI;
+       
  // Start the second loop over event in order to evaluate the generating function D[b][p][q] for differential flow: 
  for(Int_t i=0;i<nPrim;i++)
  {
-  AliFlowTrackSimple *aftsTrack = anEvent->GetTrack(i);
-  if(aftsTrack)
+  if(!(eventFlowBits[i] & (bitRP|bitPOI))) continue; // consider only RPs and POIs (empty slots have no flow bits)
+  // Differential flow of POIs:
+  if(eventFlowBits[i] & bitPOI)
   {
-   if(!(aftsTrack->InRPSelection() || aftsTrack->InPOISelection())) continue;
-   // Differential flow of POIs:
-   if(aftsTrack->InPOISelection())
-   {
-    // Get azimuthal angle, momentum and pseudorapidity of a particle:
-    dPhi = aftsTrack->Phi();
-    dPt  = aftsTrack->Pt();
-    dEta = aftsTrack->Eta();
-    Double_t ptEta[2] = {dPt,dEta};    
-   
-    // Count number of POIs in pt/eta bin:
-    for(Int_t pe=0;pe<2;pe++)
-    { 
-     fNoOfParticlesInBin[1][pe]->Fill(ptEta[pe],ptEta[pe],1.);
-    }
+   // Get azimuthal angle, momentum and pseudorapidity of a particle:
+   dPhi = eventPhi[i];
+   dPt  = eventPt[i];
+   dEta = eventEta[i];
+   Double_t ptEta[2] = {dPt,dEta};    
   
-    if(!(aftsTrack->InRPSelection())) // particle was flagged only as POI 
+   // Count number of POIs in pt/eta bin:
+   for(Int_t pe=0;pe<2;pe++)
+   { 
+    fNoOfParticlesInBin[1][pe]->Fill(ptEta[pe],ptEta[pe],1.);
+   }
+ 
+   if(!(eventFlowBits[i] & bitRP)) // particle was flagged only as POI 
+   {
+    // Fill generating function:
+    for(Int_t p=0;p<pMax;p++)
     {
-     // Fill generating function:
-     for(Int_t p=0;p<pMax;p++)
+     for(Int_t q=0;q<qMax;q++)
      {
-      for(Int_t q=0;q<qMax;q++)
+      for(Int_t ri=0;ri<2;ri++)
       {
-       for(Int_t ri=0;ri<2;ri++)
+       for(Int_t pe=0;pe<2;pe++)
        {
-        for(Int_t pe=0;pe<2;pe++)
+        if(ri==0) // Real part (to be improved - this can be implemented better)
         {
-         if(ri==0) // Real part (to be improved - this can be implemented better)
-         {
-          fDiffFlowGenFun[ri][1][pe]->Fill(ptEta[pe],(Double_t)p,(Double_t)q, // to be improved - hardwired weight 1. in the line bellow
-                                       (*fGEBE)(p,q)*cos(fMultiple*fHarmonic*dPhi),1.);
-         } 
-         else if(ri==1) // Imaginary part (to be improved - this can be implemented better)
-         {
-          fDiffFlowGenFun[ri][1][pe]->Fill(ptEta[pe],(Double_t)p,(Double_t)q, // to be improved - hardwired weight 1. in the line bellow
-                                       (*fGEBE)(p,q)*sin(fMultiple*fHarmonic*dPhi),1.);
-         }
-        } // end of for(Int_t pe=0;pe<2;pe++)
-       } // end of for(Int_t ri=0;ri<2;ri++) 
-      } // end of for(Int_t q=0;q<qMax;q++)
-     } // end of for(Int_t p=0;p<pMax;p++)       
-    } // end of if(!(aftsTrack->InRPSelection())) // particle was flagged only as POI 
-    else if(aftsTrack->InRPSelection()) // particle was flagged both as RP and POI 
-    {
-     // If particle weights were used, get them:
-     if(fUsePhiWeights && fnBinsPhi) // determine phi weight for this particle:
-     {
-      wPhi = fPhiWeights->GetBinContent(1+(Int_t)(TMath::Floor(dPhi*fnBinsPhi/TMath::TwoPi())));
-     }
-     if(fUsePtWeights && fnBinsPt) // determine pt weight for this particle:
-     {
-      wPt = fPtWeights->GetBinContent(1+(Int_t)(TMath::Floor((dPt-fPtMin)/fPtBinWidth))); 
-     }              
-     if(fUseEtaWeights && fEtaBinWidth) // determine eta weight for this particle: 
-     {
-      wEta = fEtaWeights->GetBinContent(1+(Int_t)(TMath::Floor((dEta-fEtaMin)/fEtaBinWidth))); 
-     }    
-     // Fill generating function:
-     for(Int_t p=0;p<pMax;p++)
-     {
-      for(Int_t q=0;q<qMax;q++)
-      {
-       for(Int_t ri=0;ri<2;ri++)
-       {
-        for(Int_t pe=0;pe<2;pe++)
+         fDiffFlowGenFun[ri][1][pe]->Fill(ptEta[pe],(Double_t)p,(Double_t)q, // to be improved - hardwired weight 1. in the line bellow
+                                      (*fGEBE)(p,q)*cos(fMultiple*fHarmonic*dPhi),1.);
+        } 
+        else if(ri==1) // Imaginary part (to be improved - this can be implemented better)
         {
-         if(ri==0) // Real part (to be improved - this can be implemented better)
-         {
-          fDiffFlowGenFun[ri][1][pe]->Fill(ptEta[pe],(Double_t)p,(Double_t)q, // to be improved - hardwired weight 1. in the line bellow
-                                      (*fGEBE)(p,q)*cos(fMultiple*fHarmonic*dPhi)/(1.+wPhi*wPt*wEta*(2.*fR0*sqrt(p+1.)/nRP)*cos(fHarmonic*dPhi-2.*q*TMath::Pi()/qMax)),1.);
-         } 
-         else if(ri==1) // Imaginary part (to be improved - this can be implemented better)
-         {
-          fDiffFlowGenFun[ri][1][pe]->Fill(ptEta[pe],(Double_t)p,(Double_t)q, // to be improved - hardwired weight 1. in the line bellow
-                                      (*fGEBE)(p,q)*sin(fMultiple*fHarmonic*dPhi)/(1.+wPhi*wPt*wEta*(2.*fR0*sqrt(p+1.)/nRP)*cos(fHarmonic*dPhi-2.*q*TMath::Pi()/qMax)),1.);
-         }
-        } // end of for(Int_t pe=0;pe<2;pe++)
-       } // end of for(Int_t ri=0;ri<2;ri++) 
-      } // end of for(Int_t q=0;q<qMax;q++)
-     } // end of for(Int_t p=0;p<pMax;p++)
-    } // end of else if (aftsTrack->InRPSelection()) // particle was flagged both as RP and POI 
-   } // end of if(aftsTrack->InPOISelection())
-   // Differential flow of RPs:
-   if(aftsTrack->InRPSelection()) 
-   {
-    // Get azimuthal angle, momentum and pseudorapidity of a particle:
-    dPhi = aftsTrack->Phi();
-    dPt  = aftsTrack->Pt();
-    dEta = aftsTrack->Eta();
-    Double_t ptEta[2] = {dPt,dEta}; 
-    
-    // Count number of RPs in pt/eta bin:
-    for(Int_t pe=0;pe<2;pe++)
-    { 
-     fNoOfParticlesInBin[0][pe]->Fill(ptEta[pe],ptEta[pe],1.);
-    }
-    
+         fDiffFlowGenFun[ri][1][pe]->Fill(ptEta[pe],(Double_t)p,(Double_t)q, // to be improved - hardwired weight 1. in the line bellow
+                                      (*fGEBE)(p,q)*sin(fMultiple*fHarmonic*dPhi),1.);
+        }
+       } // end of for(Int_t pe=0;pe<2;pe++)
+      } // end of for(Int_t ri=0;ri<2;ri++) 
+     } // end of for(Int_t q=0;q<qMax;q++)
+    } // end of for(Int_t p=0;p<pMax;p++)       
+   } // end of if(!(eventFlowBits[i] & bitRP)) // particle was flagged only as POI 
+   else // particle was flagged both as RP and POI 
+   {
     // If particle weights were used, get them:
     if(fUsePhiWeights && fnBinsPhi) // determine phi weight for this particle:
     {
      wPhi = fPhiWeights->GetBinContent(1+(Int_t)(TMath::Floor(dPhi*fnBinsPhi/TMath::TwoPi())));
     }
-    if(fUsePtWeights && fnBinsPt) // determine pt weight for this particle: 
+    if(fUsePtWeights && fnBinsPt) // determine pt weight for this particle:
     {
      wPt = fPtWeights->GetBinContent(1+(Int_t)(TMath::Floor((dPt-fPtMin)/fPtBinWidth))); 
     }              
@@ -802,20 +766,72 @@ void AliFlowAnalysisWithCumulants::FillGeneratingFunctionForDiffFlow(AliFlowEven
        {
         if(ri==0) // Real part (to be improved - this can be implemented better)
         {
-         fDiffFlowGenFun[ri][0][pe]->Fill(ptEta[pe],(Double_t)p,(Double_t)q, // to be improved - hardwired weight 1. in the line bellow
+         fDiffFlowGenFun[ri][1][pe]->Fill(ptEta[pe],(Double_t)p,(Double_t)q, // to be improved - hardwired weight 1. in the line bellow
                                      (*fGEBE)(p,q)*cos(fMultiple*fHarmonic*dPhi)/(1.+wPhi*wPt*wEta*(2.*fR0*sqrt(p+1.)/nRP)*cos(fHarmonic*dPhi-2.*q*TMath::Pi()/qMax)),1.);
         } 
         else if(ri==1) // Imaginary part (to be improved - this can be implemented better)
         {
-         fDiffFlowGenFun[ri][0][pe]->Fill(ptEta[pe],(Double_t)p,(Double_t)q, // to be improved - hardwired weight 1. in the line bellow
+         fDiffFlowGenFun[ri][1][pe]->Fill(ptEta[pe],(Double_t)p,(Double_t)q, // to be improved - hardwired weight 1. in the line bellow
                                      (*fGEBE)(p,q)*sin(fMultiple*fHarmonic*dPhi)/(1.+wPhi*wPt*wEta*(2.*fR0*sqrt(p+1.)/nRP)*cos(fHarmonic*dPhi-2.*q*TMath::Pi()/qMax)),1.);
         }
        } // end of for(Int_t pe=0;pe<2;pe++)
       } // end of for(Int_t ri=0;ri<2;ri++) 
      } // end of for(Int_t q=0;q<qMax;q++)
     } // end of for(Int_t p=0;p<pMax;p++)
-   } // end of if(aftsTrack->InRPSelection()) 
-  } // end of if(aftsTrack)  
+   } // end of else // particle was flagged both as RP and POI 
+  } // end of if(eventFlowBits[i] & bitPOI)
+  // Differential flow of RPs:
+  if(eventFlowBits[i] & bitRP) 
+  {
+   // Get azimuthal angle, momentum and pseudorapidity of a particle:
+   dPhi = eventPhi[i];
+   dPt  = eventPt[i];
+   dEta = eventEta[i];
+   Double_t ptEta[2] = {dPt,dEta}; 
+   
+   // Count number of RPs in pt/eta bin:
+   for(Int_t pe=0;pe<2;pe++)
+   { 
+    fNoOfParticlesInBin[0][pe]->Fill(ptEta[pe],ptEta[pe],1.);
+   }
+   
+   // If particle weights were used, get them:
+   if(fUsePhiWeights && fnBinsPhi) // determine phi weight for this particle:
+   {
+    wPhi = fPhiWeights->GetBinContent(1+(Int_t)(TMath::Floor(dPhi*fnBinsPhi/TMath::TwoPi())));
+   }
+   if(fUsePtWeights && fnBinsPt) // determine pt weight for this particle: 
+   {
+    wPt = fPtWeights->GetBinContent(1+(Int_t)(TMath::Floor((dPt-fPtMin)/fPtBinWidth))); 
+   }              
+   if(fUseEtaWeights && fEtaBinWidth) // determine eta weight for this particle: 
+   {
+    wEta = fEtaWeights->GetBinContent(1+(Int_t)(TMath::Floor((dEta-fEtaMin)/fEtaBinWidth))); 
+   }    
+   // Fill generating function:
+   for(Int_t p=0;p<pMax;p++)
+   {
+    for(Int_t q=0;q<qMax;q++)
+    {
+     for(Int_t ri=0;ri<2;ri++)
+     {
+      for(Int_t pe=0;pe<2;pe++)
+      {
+       if(ri==0) // Real part (to be improved - this can be implemented better)
+       {
+        fDiffFlowGenFun[ri][0][pe]->Fill(ptEta[pe],(Double_t)p,(Double_t)q, // to be improved - hardwired weight 1. in the line bellow
+                                    (*fGEBE)(p,q)*cos(fMultiple*fHarmonic*dPhi)/(1.+wPhi*wPt*wEta*(2.*fR0*sqrt(p+1.)/nRP)*cos(fHarmonic*dPhi-2.*q*TMath::Pi()/qMax)),1.);
+       } 
+       else if(ri==1) // Imaginary part (to be improved - this can be implemented better)
+       {
+        fDiffFlowGenFun[ri][0][pe]->Fill(ptEta[pe],(Double_t)p,(Double_t)q, // to be improved - hardwired weight 1. in the line bellow
+                                    (*fGEBE)(p,q)*sin(fMultiple*fHarmonic*dPhi)/(1.+wPhi*wPt*wEta*(2.*fR0*sqrt(p+1.)/nRP)*cos(fHarmonic*dPhi-2.*q*TMath::Pi()/qMax)),1.);
+       }
+      } // end of for(Int_t pe=0;pe<2;pe++)
+     } // end of for(Int_t ri=0;ri<2;ri++) 
+    } // end of for(Int_t q=0;q<qMax;q++)
+   } // end of for(Int_t p=0;p<pMax;p++)
+  } // end of if(eventFlowBits[i] & bitRP) 
  } // end of for(Int_t i=0;i<nPrim;i++)
  
 } // end of void AliFlowAnalysisWithCumulants::FillGeneratingFunctionForDiffFlow(AliFlowEventSimple* anEvent)
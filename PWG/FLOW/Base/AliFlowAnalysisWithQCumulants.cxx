@@ -234,7 +234,17 @@ AliFlowAnalysisWithQCumulants::AliFlowAnalysisWithQCumulants():
  fnSubsamples(10),
  fRandom(NULL),
  fBootstrapCorrelations(NULL),
- fBootstrapCumulants(NULL)
+ fBootstrapCumulants(NULL),
+ // 12.) Q-vector engine:
+ fTrackArraysSize(0),
+ fTrackPhi(NULL),
+ fTrackPt(NULL),
+ fTrackEta(NULL),
+ fTrackWeight(NULL),
+ fTrackFlag(NULL),
+ fTrackWeightPow(NULL),
+ fCosNPhi(NULL),
+ fSinNPhi(NULL)
  {
   // constructor  
   
@@ -261,6 +271,7 @@ AliFlowAnalysisWithQCumulants::AliFlowAnalysisWithQCumulants():
   this->InitializeArraysForMixedHarmonics();
   this->InitializeArraysForControlHistograms();
   this->InitializeArraysForBootstrap();
+  this->InitializeArraysForQvectorEngine();
   
  } // end of constructor
  
@@ -271,6 +282,23 @@ AliFlowAnalysisWithQCumulants::~AliFlowAnalysisWithQCumulants()
  // destructor
  
  delete fHistList;
+ 
+ // Q-vector engine:
+ delete [] fTrackWeight;
+ delete [] fTrackWeightPow;
+ delete [] fCosNPhi;
+ delete [] fSinNPhi;
+ for(Int_t sp=0;sp<3;sp++) // [0=pt,1=eta,2=(pt,eta)]
+ {
+  for(Int_t t=0;t<3;t++) // [0=r,1=p,2=q]
+  {
+   delete [] fDiffReQv[sp][t];
+   delete [] fDiffImQv[sp][t];
+   delete [] fDiffSv[sp][t];
+   delete [] fDiffQvEntries[sp][t];
+   delete [] fDiffQvTouched[sp][t];
+  }
+ }
 
 } // end of AliFlowAnalysisWithQCumulants::~AliFlowAnalysisWithQCumulants()
 
@@ -355,20 +383,11 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
  this->CheckPointersUsedInMake();
  
  // b) Define local variables:
- Double_t dPhi = 0.; // azimuthal angle in the laboratory frame
- Double_t dPt  = 0.; // transverse momentum
- Double_t dEta = 0.; // pseudorapidity
- Double_t wPhi = 1.; // phi weight
- Double_t wPt  = 1.; // pt weight
- Double_t wEta = 1.; // eta weight
- Double_t wTrack = 1.; // track weight
- Int_t nCounterNoRPs = 0; // needed only for shuffling
  fNumberOfRPsEBE = anEvent->GetNumberOfRPs(); // number of RPs (i.e. number of reference particles)
  if(fExactNoRPs > 0 && fNumberOfRPsEBE<fExactNoRPs){return;}
  fNumberOfPOIsEBE = anEvent->GetNumberOfPOIs(); // number of POIs (i.e. number of particles of interest)
  fReferenceMultiplicityEBE = anEvent->GetReferenceMultiplicity(); // reference multiplicity for current event
  //Printf("Reference multiplicity (QC): %.1f",fReferenceMultiplicityEBE);
- Double_t ptEta[2] = {0.,0.}; // 0 = dPt, 1 = dEta
   
  // c) Fill the common control histograms and call the method to fill fAvMultiplicity:
  this->FillCommonControlHistograms(anEvent);                                                               
@@ -376,177 +395,11 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
  if(fStoreControlHistograms){this->FillControlHistograms(anEvent);}                                                              
                                                                                                                                                                                                                                                                                         
  // d) Loop over data and calculate e-b-e quantities Q_{n,k}, S_{p,k} and s_{p,k}:
- Int_t nPrim = anEvent->NumberOfTracks();  // nPrim = total number of primary tracks
- AliFlowTrackSimple *aftsTrack = NULL;
- Int_t n = fHarmonic; // shortcut for the harmonic 
- for(Int_t i=0;i<nPrim;i++) 
- { 
-  if(fExactNoRPs > 0 && nCounterNoRPs>fExactNoRPs){continue;}
-  aftsTrack=anEvent->GetTrack(i);
-  if(aftsTrack)
-  {
-   if(!(aftsTrack->InRPSelection() || aftsTrack->InPOISelection())){continue;} // safety measure: consider only tracks which are RPs or POIs
-   if(aftsTrack->InRPSelection()) // RP condition:
-   {    
-    nCounterNoRPs++;
-    dPhi = aftsTrack->Phi();
-    dPt  = aftsTrack->Pt();
-    dEta = aftsTrack->Eta();
-    if(fUsePhiWeights && fPhiWeights && fnBinsPhi) // determine phi weight for this particle:
-    {
-     wPhi = fPhiWeights->GetBinContent(1+(Int_t)(TMath::Floor(dPhi*fnBinsPhi/TMath::TwoPi())));
-    }
-    if(fUsePtWeights && fPtWeights && fnBinsPt) // determine pt weight for this particle:
-    {
-     wPt = fPtWeights->GetBinContent(1+(Int_t)(TMath::Floor((dPt-fPtMin)/fPtBinWidth))); 
-    }              
-    if(fUseEtaWeights && fEtaWeights && fEtaBinWidth) // determine eta weight for this particle: 
-    {
-     wEta = fEtaWeights->GetBinContent(1+(Int_t)(TMath::Floor((dEta-fEtaMin)/fEtaBinWidth))); 
-    }      
-    // Access track weight:
-    if(fUseTrackWeights)
-    {
-     wTrack = aftsTrack->Weight(); 
-    }
-    // Calculate Re[Q_{m*n,k}] and Im[Q_{m*n,k}] for this event (m = 1,2,...,12, k = 0,1,...,8):
-    for(Int_t m=0;m<12;m++) // to be improved - hardwired 6 
-    {
-     for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
-     {
-      (*fReQ)(m,k)+=pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1)*n*dPhi); 
-      (*fImQ)(m,k)+=pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1)*n*dPhi); 
-     } 
-    }
-    // Calculate S_{p,k} for this event (Remark: final calculation of S_{p,k} follows after the loop over data bellow):
-    for(Int_t p=0;p<8;p++)
-    {
-     for(Int_t k=0;k<9;k++)
-     {     
-      (*fSpk)(p,k)+=pow(wPhi*wPt*wEta*wTrack,k);
-     }
-    } 
-    // Differential flow:
-    if(fCalculateDiffFlow || fCalculate2DDiffFlow)
-    {
-     ptEta[0] = dPt; 
-     ptEta[1] = dEta; 
-     // Calculate r_{m*n,k} and s_{p,k} (r_{m,k} is 'p-vector' for RPs): 
-     for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
-     {
-      for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
-      {
-       if(fCalculateDiffFlow)
-       {
-        for(Int_t pe=0;pe<1+(Int_t)fCalculateDiffFlowVsEta;pe++) // pt or eta
-        {
-         fReRPQ1dEBE[0][pe][m][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-         fImRPQ1dEBE[0][pe][m][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);          
-         if(m==0) // s_{p,k} does not depend on index m
-         {
-          fs1dEBE[0][pe][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k),1.);
-         } // end of if(m==0) // s_{p,k} does not depend on index m
-        } // end of for(Int_t pe=0;pe<2;pe++) // pt or eta
-       } // end of if(fCalculateDiffFlow) 
-       if(fCalculate2DDiffFlow)
-       {
-        fReRPQ2dEBE[0][m][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-        fImRPQ2dEBE[0][m][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);      
-        if(m==0) // s_{p,k} does not depend on index m
-        {
-         fs2dEBE[0][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k),1.);
-        } // end of if(m==0) // s_{p,k} does not depend on index m
-       } // end of if(fCalculate2DDiffFlow)
-      } // end of for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
-     } // end of for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
-     // Checking if RP particle is also POI particle:      
-     if(aftsTrack->InPOISelection())
-     {
-      // Calculate q_{m*n,k} and s_{p,k} ('q-vector' and 's' for RPs && POIs): 
-      for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
-      {
-       for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
-       {
-        if(fCalculateDiffFlow)
-        {
-         for(Int_t pe=0;pe<1+(Int_t)fCalculateDiffFlowVsEta;pe++) // pt or eta
-         {
-          fReRPQ1dEBE[2][pe][m][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-          fImRPQ1dEBE[2][pe][m][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);          
-          if(m==0) // s_{p,k} does not depend on index m
-          {
-           fs1dEBE[2][pe][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k),1.);
-          } // end of if(m==0) // s_{p,k} does not depend on index m
-         } // end of for(Int_t pe=0;pe<2;pe++) // pt or eta
-        } // end of if(fCalculateDiffFlow) 
-        if(fCalculate2DDiffFlow)
-        {
-         fReRPQ2dEBE[2][m][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-         fImRPQ2dEBE[2][m][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);      
-         if(m==0) // s_{p,k} does not depend on index m
-         {
-          fs2dEBE[2][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k),1.);
-         } // end of if(m==0) // s_{p,k} does not depend on index m
-        } // end of if(fCalculate2DDiffFlow)
-       } // end of for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
-      } // end of for(Int_t k=0;k<9;k++) // to be improved - hardwired 9    
-     } // end of if(aftsTrack->InPOISelection())  
-    } // end of if(fCalculateDiffFlow || fCalculate2DDiffFlow)         
-   } // end of if(pTrack->InRPSelection())
-   if(aftsTrack->InPOISelection())
-   {
-    dPhi = aftsTrack->Phi();
-    dPt  = aftsTrack->Pt();
-    dEta = aftsTrack->Eta();
-    wPhi = 1.;
-    wPt  = 1.;
-    wEta = 1.;
-    wTrack = 1.;
-    if(fUsePhiWeights && fPhiWeights && fnBinsPhi && aftsTrack->InRPSelection()) // determine phi weight for POI && RP particle:
-    {
-     wPhi = fPhiWeights->GetBinContent(1+(Int_t)(TMath::Floor(dPhi*fnBinsPhi/TMath::TwoPi())));
-    }
-    if(fUsePtWeights && fPtWeights && fnBinsPt && aftsTrack->InRPSelection()) // determine pt weight for POI && RP particle:
-    {
-     wPt = fPtWeights->GetBinContent(1+(Int_t)(TMath::Floor((dPt-fPtMin)/fPtBinWidth))); 
-    }              
-    if(fUseEtaWeights && fEtaWeights && fEtaBinWidth && aftsTrack->InRPSelection()) // determine eta weight for POI && RP particle: 
-    {
-     wEta = fEtaWeights->GetBinContent(1+(Int_t)(TMath::Floor((dEta-fEtaMin)/fEtaBinWidth))); 
-    }      
-    // Access track weight for POI && RP particle:
-    if(aftsTrack->InRPSelection() && fUseTrackWeights)
-    {
-     wTrack = aftsTrack->Weight(); 
-    }
-    ptEta[0] = dPt;
-    ptEta[1] = dEta;
-    // Calculate p_{m*n,k} ('p-vector' for POIs): 
-    for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
-    {
-     for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
-     {
-      if(fCalculateDiffFlow)
-      {
-       for(Int_t pe=0;pe<1+(Int_t)fCalculateDiffFlowVsEta;pe++) // pt or eta
-       {
-        fReRPQ1dEBE[1][pe][m][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-        fImRPQ1dEBE[1][pe][m][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);          
-       } // end of for(Int_t pe=0;pe<2;pe++) // pt or eta
-      } // end of if(fCalculateDiffFlow) 
-      if(fCalculate2DDiffFlow)
-      {
-       fReRPQ2dEBE[1][m][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-       fImRPQ2dEBE[1][m][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);      
-      } // end of if(fCalculate2DDiffFlow)
-     } // end of for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
-    } // end of for(Int_t k=0;k<9;k++) // to be improved - hardwired 9    
-   } // end of if(pTrack->InPOISelection())    
-  } else // to if(aftsTrack)
-    {
-     printf("\n WARNING (QC): No particle (i.e. aftsTrack is a NULL pointer in AFAWQC::Make())!!!!\n\n");
-    }
- } // end of for(Int_t i=0;i<nPrim;i++) 
+ //    (phi, pt, eta and flow bits are taken from the contiguous arrays of the flow event, particle weights are filled once, 
+ //     all harmonics and powers of weights are then accumulated from these arrays in tight loops)
+ Int_t nTracks = this->FillTrackArrays(anEvent);
+ this->CalculateQvectors(nTracks);
+ if(fCalculateDiffFlow || fCalculate2DDiffFlow){this->CalculateDiffFlowQvectors(nTracks);}
 
  // e) Calculate the final expressions for S_{p,k} and s_{p,k} (important !!!!):
  for(Int_t p=0;p<8;p++)
@@ -700,6 +553,291 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
 
 //=======================================================================================================================
 
+Int_t AliFlowAnalysisWithQCumulants::FillTrackArrays(AliFlowEventSimple *anEvent)
+{
+ // Point to phi, pt, eta and flow bits of the flow event and fill the particle weights, return the number of particles to be used.
+ 
+ // Remarks: 
+ //  a) The arrays of the flow event are used as they are (index i corresponds to GetTrack(i)), nothing is copied;
+ //  b) Tracks which are neither RPs nor POIs stay in the arrays, but have no flow bits and therefore do not contribute;
+ //  c) For POIs which are not RPs the particle weight is 1;
+ //  d) Shuffling: only the first fExactNoRPs+1 RPs are taken (and POIs which come before them), 
+ //     i.e. the returned number of particles is the length of the prefix which contains them. 
+
+ Int_t nPrim = anEvent->NumberOfTracks(); // nPrim = total number of primary tracks
+ if(nPrim > fTrackArraysSize)
+ {
+  delete [] fTrackWeight;
+  delete [] fTrackWeightPow;
+  delete [] fCosNPhi;
+  delete [] fSinNPhi;
+  fTrackArraysSize = nPrim + nPrim/2; // some headroom for the next events
+  fTrackWeight = new Double_t[fTrackArraysSize];
+  fTrackWeightPow = new Double_t[fTrackArraysSize];
+  fCosNPhi = new Double_t[12*fTrackArraysSize]; // to be improved - hardwired 12
+  fSinNPhi = new Double_t[12*fTrackArraysSize]; // to be improved - hardwired 12
+ } // end of if(nPrim > fTrackArraysSize)
+
+ fTrackPhi = anEvent->GetTrackPhiArray();
+ fTrackPt = anEvent->GetTrackPtArray();
+ fTrackEta = anEvent->GetTrackEtaArray();
+ fTrackFlag = anEvent->GetTrackFlowBitsArray();
+ const Double_t *eventWeight = anEvent->GetTrackWeightArray();
+
+ Double_t wPhi = 1.; // phi weight
+ Double_t wPt  = 1.; // pt weight
+ Double_t wEta = 1.; // eta weight
+ Double_t wTrack = 1.; // track weight
+ Int_t nCounterNoRPs = 0; // needed only for shuffling
+ Int_t nTracks = 0; // number of particles to be used
+ for(Int_t i=0;i<nPrim;i++) 
+ { 
+  if(fExactNoRPs > 0 && nCounterNoRPs>fExactNoRPs){break;}
+  nTracks = i+1;
+  fTrackWeight[i] = 1.;
+  if(!(fTrackFlag[i] & (1u<<AliFlowTrackSimple::kRP))){continue;} // weights are needed only for RPs
+  nCounterNoRPs++;
+  wPhi = 1.;
+  wPt  = 1.;
+  wEta = 1.;
+  wTrack = 1.;
+  if(fUsePhiWeights && fPhiWeights && fnBinsPhi) // determine phi weight for this particle:
+  {
+   wPhi = fPhiWeights->GetBinContent(1+(Int_t)(TMath::Floor(fTrackPhi[i]*fnBinsPhi/TMath::TwoPi())));
+  }
+  if(fUsePtWeights && fPtWeights && fnBinsPt) // determine pt weight for this particle:
+  {
+   wPt = fPtWeights->GetBinContent(1+(Int_t)(TMath::Floor((fTrackPt[i]-fPtMin)/fPtBinWidth))); 
+  }              
+  if(fUseEtaWeights && fEtaWeights && fEtaBinWidth) // determine eta weight for this particle: 
+  {
+   wEta = fEtaWeights->GetBinContent(1+(Int_t)(TMath::Floor((fTrackEta[i]-fEtaMin)/fEtaBinWidth))); 
+  }      
+  // Access track weight:
+  if(fUseTrackWeights)
+  {
+   wTrack = eventWeight[i]; 
+  }
+  fTrackWeight[i] = wPhi*wPt*wEta*wTrack;
+ } // end of for(Int_t i=0;i<nPrim;i++) 
+
+ return nTracks;
+
+} // end of Int_t AliFlowAnalysisWithQCumulants::FillTrackArrays(AliFlowEventSimple *anEvent)
+
+//=======================================================================================================================
+
+void AliFlowAnalysisWithQCumulants::CalculateQvectors(Int_t nTracks)
+{
+ // Calculate Re[Q_{m*n,k}], Im[Q_{m*n,k}] (m = 1,2,...,12, k = 0,1,...,8) and S_{p,k} for this event from the track arrays.
+ 
+ // Remarks: 
+ //  a) cos(m*n*phi) and sin(m*n*phi) are obtained from cos(n*phi) and sin(n*phi) with the angle addition formulas, 
+ //     and w^k by repeated multiplication, so that only one Cos() and one Sin() per particle are evaluated;
+ //  b) All loops below run over contiguous arrays and have no branches in the body;
+ //  c) Particles are summed in the same order as they appear in the event. 
+
+ if(nTracks <= 0){return;}
+ 
+ Int_t n = fHarmonic; // shortcut for the harmonic 
+ Int_t size = fTrackArraysSize;
+ 
+ // a) cos(m*n*phi) and sin(m*n*phi) for all particles and m = 1,2,...,12:
+ Double_t *cos1 = fCosNPhi;
+ Double_t *sin1 = fSinNPhi;
+ for(Int_t i=0;i<nTracks;i++)
+ {
+  cos1[i] = TMath::Cos(n*fTrackPhi[i]);
+  sin1[i] = TMath::Sin(n*fTrackPhi[i]);
+ }
+ for(Int_t m=1;m<12;m++) // to be improved - hardwired 12
+ {
+  const Double_t *cosPrev = fCosNPhi+(m-1)*size;
+  const Double_t *sinPrev = fSinNPhi+(m-1)*size;
+  Double_t *cosM = fCosNPhi+m*size;
+  Double_t *sinM = fSinNPhi+m*size;
+  for(Int_t i=0;i<nTracks;i++)
+  {
+   cosM[i] = cosPrev[i]*cos1[i]-sinPrev[i]*sin1[i];
+   sinM[i] = sinPrev[i]*cos1[i]+cosPrev[i]*sin1[i];
+  }
+ } // end of for(Int_t m=1;m<12;m++)
+ 
+ // b) Q_{m*n,k} and S_{p,k} (only RPs contribute, all other particles enter with w^k = 0):
+ Double_t *wk = fTrackWeightPow;
+ for(Int_t i=0;i<nTracks;i++)
+ {
+  wk[i] = (fTrackFlag[i] & (1u<<AliFlowTrackSimple::kRP)) ? 1. : 0.;
+ }
+ for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
+ {
+  if(k>0)
+  {
+   for(Int_t i=0;i<nTracks;i++){wk[i] *= fTrackWeight[i];}
+  }
+  for(Int_t m=0;m<12;m++) // to be improved - hardwired 12
+  {
+   const Double_t *cosM = fCosNPhi+m*size;
+   const Double_t *sinM = fSinNPhi+m*size;
+   Double_t dReQ = 0.;
+   Double_t dImQ = 0.;
+   for(Int_t i=0;i<nTracks;i++)
+   {
+    dReQ += wk[i]*cosM[i];
+    dImQ += wk[i]*sinM[i];
+   }
+   (*fReQ)(m,k)+=dReQ; 
+   (*fImQ)(m,k)+=dImQ; 
+  } // end of for(Int_t m=0;m<12;m++)
+  // S_{p,k} (Remark: final calculation of S_{p,k} follows in Make()):
+  Double_t dS = 0.;
+  for(Int_t i=0;i<nTracks;i++){dS += wk[i];}
+  for(Int_t p=0;p<8;p++)
+  {
+   (*fSpk)(p,k)+=dS;
+  }
+ } // end of for(Int_t k=0;k<9;k++)
+
+} // end of void AliFlowAnalysisWithQCumulants::CalculateQvectors(Int_t nTracks)
+
+//=======================================================================================================================
+
+void AliFlowAnalysisWithQCumulants::CalculateDiffFlowQvectors(Int_t nTracks)
+{
+ // Calculate r_{m*n,k}, p_{m*n,k}, q_{m*n,k} and s_{p,k} in pt, eta and (pt,eta) bins from the track arrays.
+ 
+ // Remarks: 
+ //  a) Must be called after CalculateQvectors(), which fills cos(m*n*phi) and sin(m*n*phi);
+ //  b) Sums are accumulated in dense arrays and then moved once per event in fReRPQ1dEBE, fImRPQ1dEBE, fs1dEBE, 
+ //     fReRPQ2dEBE, fImRPQ2dEBE and fs2dEBE: bin content = sum, bin entries = number of particles in that bin 
+ //     (exactly what TProfile::Fill(x,y,1.) would give, but without 216 calls to Fill() per particle);
+ //  c) Only the cells filled in this event are moved and cleared. 
+
+ Int_t size = fTrackArraysSize;
+ Bool_t bSpace[3] = {fCalculateDiffFlow,fCalculateDiffFlow && fCalculateDiffFlowVsEta,fCalculate2DDiffFlow}; // [0=pt,1=eta,2=(pt,eta)]
+ 
+ // a) Book dense arrays on first use:
+ for(Int_t sp=0;sp<3;sp++) // [0=pt,1=eta,2=(pt,eta)]
+ {
+  if(!bSpace[sp] || fDiffQvCells[sp] > 0){continue;}
+  Int_t nCells = (sp<2 ? fReRPQ1dEBE[0][sp][0][0]->GetNcells() : fReRPQ2dEBE[0][0][0]->GetNcells());
+  fDiffQvCells[sp] = nCells;
+  for(Int_t t=0;t<3;t++) // [0=r,1=p,2=q]
+  {
+   fDiffReQv[sp][t] = new Double_t[4*9*nCells](); // to be improved - hardwired 4 and 9
+   fDiffImQv[sp][t] = new Double_t[4*9*nCells](); // to be improved - hardwired 4 and 9
+   fDiffSv[sp][t] = new Double_t[9*nCells](); // to be improved - hardwired 9
+   fDiffQvEntries[sp][t] = new Double_t[nCells]();
+   fDiffQvTouched[sp][t] = new Int_t[nCells]();
+   fDiffQvNTouched[sp][t] = 0;
+  }
+ } // end of for(Int_t sp=0;sp<3;sp++)
+
+ // b) Accumulate:
+ Int_t cell[3] = {-1,-1,-1}; // [0=pt,1=eta,2=(pt,eta)]
+ Int_t type[3] = {-1,-1,-1}; // [0=r,1=p,2=q] to which this particle contributes
+ for(Int_t i=0;i<nTracks;i++)
+ {
+  Int_t nTypes = 0;
+  Bool_t bRP = (fTrackFlag[i] & (1u<<AliFlowTrackSimple::kRP));
+  Bool_t bPOI = (fTrackFlag[i] & (1u<<AliFlowTrackSimple::kPOI));
+  if(bRP){type[nTypes++] = 0;} // r: RP
+  if(bPOI){type[nTypes++] = 1;} // p: POI
+  if(bRP && bPOI){type[nTypes++] = 2;} // q: RP && POI
+  if(nTypes == 0){continue;} // neither RP nor POI
+  if(bSpace[0]){cell[0] = fReRPQ1dEBE[0][0][0][0]->FindBin(fTrackPt[i]);}
+  if(bSpace[1]){cell[1] = fReRPQ1dEBE[0][1][0][0]->FindBin(fTrackEta[i]);}
+  if(bSpace[2]){cell[2] = fReRPQ2dEBE[0][0][0]->FindBin(fTrackPt[i],fTrackEta[i]);}
+  for(Int_t sp=0;sp<3;sp++) // [0=pt,1=eta,2=(pt,eta)]
+  {
+   if(!bSpace[sp]){continue;}
+   Int_t nCells = fDiffQvCells[sp];
+   Int_t c = cell[sp];
+   for(Int_t tt=0;tt<nTypes;tt++)
+   {
+    Int_t t = type[tt];
+    Double_t *reQv = fDiffReQv[sp][t];
+    Double_t *imQv = fDiffImQv[sp][t];
+    Double_t *sv = fDiffSv[sp][t];
+    if(fDiffQvEntries[sp][t][c] == 0.){fDiffQvTouched[sp][t][fDiffQvNTouched[sp][t]++] = c;}
+    fDiffQvEntries[sp][t][c] += 1.;
+    Double_t wk = 1.;
+    for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
+    {
+     if(k>0){wk *= fTrackWeight[i];}
+     for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
+     {
+      reQv[(m*9+k)*nCells+c] += wk*fCosNPhi[m*size+i];
+      imQv[(m*9+k)*nCells+c] += wk*fSinNPhi[m*size+i];
+     }
+     if(t != 1){sv[k*nCells+c] += wk;} // s_{p,k} is not needed for POIs
+    } // end of for(Int_t k=0;k<9;k++)
+   } // end of for(Int_t tt=0;tt<nTypes;tt++)
+  } // end of for(Int_t sp=0;sp<3;sp++)
+ } // end of for(Int_t i=0;i<nTracks;i++)
+
+ // c) Move sums in e-b-e profiles and clear the dense arrays:
+ for(Int_t sp=0;sp<3;sp++) // [0=pt,1=eta,2=(pt,eta)]
+ {
+  if(!bSpace[sp]){continue;}
+  Int_t nCells = fDiffQvCells[sp];
+  for(Int_t t=0;t<3;t++) // [0=r,1=p,2=q]
+  {
+   Double_t *reQv = fDiffReQv[sp][t];
+   Double_t *imQv = fDiffImQv[sp][t];
+   Double_t *sv = fDiffSv[sp][t];
+   for(Int_t j=0;j<fDiffQvNTouched[sp][t];j++)
+   {
+    Int_t c = fDiffQvTouched[sp][t][j];
+    Double_t dEntries = fDiffQvEntries[sp][t][c];
+    for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
+    {
+     for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
+     {
+      Int_t index = (m*9+k)*nCells+c;
+      if(sp<2)
+      {
+       fReRPQ1dEBE[t][sp][m][k]->SetBinContent(c,reQv[index]);
+       fReRPQ1dEBE[t][sp][m][k]->SetBinEntries(c,dEntries);
+       fImRPQ1dEBE[t][sp][m][k]->SetBinContent(c,imQv[index]);
+       fImRPQ1dEBE[t][sp][m][k]->SetBinEntries(c,dEntries);
+      } else
+        {
+         fReRPQ2dEBE[t][m][k]->SetBinContent(c,reQv[index]);
+         fReRPQ2dEBE[t][m][k]->SetBinEntries(c,dEntries);
+         fImRPQ2dEBE[t][m][k]->SetBinContent(c,imQv[index]);
+         fImRPQ2dEBE[t][m][k]->SetBinEntries(c,dEntries);
+        } 
+      reQv[index] = 0.;
+      imQv[index] = 0.;
+     } // end of for(Int_t k=0;k<9;k++)
+    } // end of for(Int_t m=0;m<4;m++)
+    if(t != 1) // s_{p,k} is not needed for POIs
+    {
+     for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
+     {
+      if(sp<2)
+      {
+       fs1dEBE[t][sp][k]->SetBinContent(c,sv[k*nCells+c]);
+       fs1dEBE[t][sp][k]->SetBinEntries(c,dEntries);
+      } else
+        {
+         fs2dEBE[t][k]->SetBinContent(c,sv[k*nCells+c]);
+         fs2dEBE[t][k]->SetBinEntries(c,dEntries);
+        }
+      sv[k*nCells+c] = 0.;
+     } // end of for(Int_t k=0;k<9;k++)
+    } // end of if(t != 1)
+    fDiffQvEntries[sp][t][c] = 0.;
+   } // end of for(Int_t j=0;j<fDiffQvNTouched[sp][t];j++)
+   fDiffQvNTouched[sp][t] = 0;
+  } // end of for(Int_t t=0;t<3;t++)
+ } // end of for(Int_t sp=0;sp<3;sp++)
+
+} // end of void AliFlowAnalysisWithQCumulants::CalculateDiffFlowQvectors(Int_t nTracks)
+
+//=======================================================================================================================
+
 void AliFlowAnalysisWithQCumulants::Finish()
 {
  // Calculate the final results.
@@ -3631,6 +3769,28 @@ void AliFlowAnalysisWithQCumulants::InitializeArraysForBootstrap()
 
 //=======================================================================================================================
 
+void AliFlowAnalysisWithQCumulants::InitializeArraysForQvectorEngine()
+{
+ // Initialize arrays of the dense e-b-e buffers used for differential Q-vectors.
+
+ for(Int_t sp=0;sp<3;sp++) // [0=pt,1=eta,2=(pt,eta)]
+ {
+  fDiffQvCells[sp] = 0;
+  for(Int_t t=0;t<3;t++) // [0=r,1=p,2=q]
+  {
+   fDiffReQv[sp][t] = NULL;
+   fDiffImQv[sp][t] = NULL;
+   fDiffSv[sp][t] = NULL;
+   fDiffQvEntries[sp][t] = NULL;
+   fDiffQvTouched[sp][t] = NULL;
+   fDiffQvNTouched[sp][t] = 0;
+  }
+ }
+
+} // end of void AliFlowAnalysisWithQCumulants::InitializeArraysForQvectorEngine()
+
+//=======================================================================================================================
+
 void AliFlowAnalysisWithQCumulants::BookEverythingForNestedLoops()
 {
  // Book all objects relevant for calculations with nested loops.
@@ -50,6 +50,7 @@ class AliFlowAnalysisWithQCumulants{
   virtual void InitializeArraysForMixedHarmonics();
   virtual void InitializeArraysForControlHistograms();
   virtual void InitializeArraysForBootstrap();
+  virtual void InitializeArraysForQvectorEngine();
   // 1.) method Init() and methods called within Init():
   virtual void Init();
     virtual void CrossCheckSettings();
@@ -82,6 +83,9 @@ class AliFlowAnalysisWithQCumulants{
     virtual void FillCommonControlHistograms(AliFlowEventSimple *anEvent);
     virtual void FillControlHistograms(AliFlowEventSimple *anEvent);
     virtual void ResetEventByEventQuantities();
+    virtual Int_t FillTrackArrays(AliFlowEventSimple *anEvent);
+    virtual void CalculateQvectors(Int_t nTracks);
+    virtual void CalculateDiffFlowQvectors(Int_t nTracks);
     // 2b.) Reference flow:
     virtual void CalculateIntFlowCorrelations(); 
     virtual void CalculateIntFlowCorrelationsUsingParticleWeights();
@@ -847,6 +851,24 @@ class AliFlowAnalysisWithQCumulants{
   TH2D *fBootstrapCumulants; // x-axis => QC{2}, QC{4}, QC{6}, QC{8}; y-axis => subsample # 
   TH2D *fBootstrapCumulantsVsM[4]; // index => QC{2}, QC{4}, QC{6}, QC{8}; x-axis => multiplicity; y-axis => subsample # 
 
+  // 12.) Q-vector engine (e-b-e, contiguous per-track arrays filled once per event in Make()):
+  Int_t fTrackArraysSize; //! capacity of the per-track arrays below
+  const Double_t *fTrackPhi; //! azimuthal angles (array of the current flow event, not owned)
+  const Double_t *fTrackPt; //! transverse momenta (array of the current flow event, not owned)
+  const Double_t *fTrackEta; //! pseudorapidities (array of the current flow event, not owned)
+  Double_t *fTrackWeight; //! [fTrackArraysSize] particle weight w_i (1 for particles which are not RPs)
+  const UInt_t *fTrackFlag; //! flow bits, bit 0 = RP, bit 1 = POI (array of the current flow event, not owned)
+  Double_t *fTrackWeightPow; //! [fTrackArraysSize] w_i^k for the current power k (0 for non-RPs)
+  Double_t *fCosNPhi; //! [12*fTrackArraysSize] cos((m+1)*n*phi_i), stored as [m*fTrackArraysSize+i]
+  Double_t *fSinNPhi; //! [12*fTrackArraysSize] sin((m+1)*n*phi_i), stored as [m*fTrackArraysSize+i]
+  Int_t fDiffQvCells[3]; //! number of cells incl. under/overflow [0=pt,1=eta,2=(pt,eta)]
+  Double_t *fDiffReQv[3][3]; //! dense Re[r,p,q] [0=pt,1=eta,2=(pt,eta)][0=r,1=p,2=q], stored as [(m*9+k)*cells+cell]
+  Double_t *fDiffImQv[3][3]; //! dense Im[r,p,q] [0=pt,1=eta,2=(pt,eta)][0=r,1=p,2=q], stored as [(m*9+k)*cells+cell]
+  Double_t *fDiffSv[3][3]; //! dense s_{p,k} [0=pt,1=eta,2=(pt,eta)][0=r,1=p,2=q], stored as [k*cells+cell]
+  Double_t *fDiffQvEntries[3][3]; //! number of particles per cell [0=pt,1=eta,2=(pt,eta)][0=r,1=p,2=q]
+  Int_t *fDiffQvTouched[3][3]; //! cells filled in the current event [0=pt,1=eta,2=(pt,eta)][0=r,1=p,2=q]
+  Int_t fDiffQvNTouched[3][3]; //! number of cells filled in the current event
+
   ClassDef(AliFlowAnalysisWithQCumulants, 4);
 
 };
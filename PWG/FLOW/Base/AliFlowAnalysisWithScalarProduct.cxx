@@ -371,15 +371,25 @@ void AliFlowAnalysisWithScalarProduct::Make(AliFlowEventSimple* anEvent) {
   fHistProNUAq->Fill(5.,vQm.Y()/dNq,dWq);
   fHistProNUAq->Fill(6.,vQm.X()/dNq,dWq);
 
-  //loop over the tracks of the event
+  //loop over the tracks of the event; the kinematics and the tags are read from
+  //the contiguous arrays of the flow event (index i corresponds to GetTrack(i)),
+  //the track object is only needed to subtract it (and its daughters) from the Q vector
+  const Double_t *eventPhi = anEvent->GetTrackPhiArray();
+  const Double_t *eventPt = anEvent->GetTrackPtArray();
+  const Double_t *eventEta = anEvent->GetTrackEtaArray();
+  const Double_t *eventWeight = anEvent->GetTrackWeightArray();
+  const UInt_t *eventFlowBits = anEvent->GetTrackFlowBitsArray();
+  const UInt_t *eventSubEventBits = anEvent->GetTrackSubEventBitsArray();
+  const UInt_t bitRP = 1u<<AliFlowTrackSimple::kRP;
+  const UInt_t bitPOI = (fPOItype>=0 && fPOItype<32) ? 1u<<fPOItype : 0;
   AliFlowTrackSimple*   pTrack = NULL; 
   Int_t iNumberOfTracks = anEvent->NumberOfTracks(); 
   for (Int_t i=0;i<iNumberOfTracks;i++) {
     pTrack = anEvent->GetTrack(i) ; 
     if (!pTrack) continue;
-    Double_t dPhi = pTrack->Phi();
-    Double_t dPt  = pTrack->Pt();
-    Double_t dEta = pTrack->Eta();
+    Double_t dPhi = eventPhi[i];
+    Double_t dPt  = eventPt[i];
+    Double_t dEta = eventEta[i];
 
     //calculate vU
     TVector2 vU;
@@ -402,7 +412,7 @@ void AliFlowAnalysisWithScalarProduct::Make(AliFlowEventSimple* anEvent) {
 
     //remove track if in subevent
     for(Int_t inSubEvent=0; inSubEvent<2; ++inSubEvent) {
-      if( !pTrack->InSubevent( inSubEvent ) )
+      if( !(eventSubEventBits[i] & (1u<<inSubEvent)) )
         continue;
       if(inSubEvent==0)
         if( (fTotalQvector%2)!=1 )
@@ -432,7 +442,7 @@ void AliFlowAnalysisWithScalarProduct::Make(AliFlowEventSimple* anEvent) {
         fHistNumberOfSubtractedDaughters->Fill(numberOfsubtractedDaughters);
       }
 
-      dMq = dMq-dW*pTrack->Weight();
+      dMq = dMq-dW*eventWeight[i];
     }
     dNq = fNormalizationType ? dMq : vQm.Mod();
     dWq = fNormalizationType ? dMq : 1;
@@ -455,9 +465,9 @@ void AliFlowAnalysisWithScalarProduct::Make(AliFlowEventSimple* anEvent) {
 
     //fill the profile histograms
     for(Int_t iPOI=0; iPOI!=2; ++iPOI) {
-      if( (iPOI==0)&&(!pTrack->InRPSelection()) )
+      if( (iPOI==0)&&(!(eventFlowBits[i] & bitRP)) )
         continue;
-      if( (iPOI==1)&&(!pTrack->InPOISelection(fPOItype)) )
+      if( (iPOI==1)&&(!(eventFlowBits[i] & bitPOI)) )
         continue;
       fHistProUQ[iPOI][0]->Fill(dPt ,dUQ/dNq,dWq); //Fill (uQ/Nq') with weight (Nq')
       fHistProUQ[iPOI][1]->Fill(dEta,dUQ/dNq,dWq); //Fill (uQ/Nq') with weight (Nq')
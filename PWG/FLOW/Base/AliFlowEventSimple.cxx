@@ -87,6 +87,16 @@ AliFlowEventSimple::AliFlowEventSimple():
   fZPCM(0.),
   fZPAM(0.),
   fAbsOrbit(0),
+  fTrackArraysValid(kFALSE),
+  fTrackArraysModificationCount(0),
+  fTrackArraysSize(0),
+  fTrackPhi(NULL),
+  fTrackEta(NULL),
+  fTrackPt(NULL),
+  fTrackWeight(NULL),
+  fTrackCharge(NULL),
+  fTrackFlowBits(NULL),
+  fTrackSubEventBits(NULL),
   fNumberOfPOItypes(2),
   fNumberOfPOIs(NULL)
 {
@@ -146,6 +156,16 @@ AliFlowEventSimple::AliFlowEventSimple( Int_t n,
   fZPCM(0.),
   fZPAM(0.),
   fAbsOrbit(0),
+  fTrackArraysValid(kFALSE),
+  fTrackArraysModificationCount(0),
+  fTrackArraysSize(0),
+  fTrackPhi(NULL),
+  fTrackEta(NULL),
+  fTrackPt(NULL),
+  fTrackWeight(NULL),
+  fTrackCharge(NULL),
+  fTrackFlowBits(NULL),
+  fTrackSubEventBits(NULL),
   fNumberOfPOItypes(2),
   fNumberOfPOIs(new Int_t[fNumberOfPOItypes])
 {
@@ -209,6 +229,16 @@ AliFlowEventSimple::AliFlowEventSimple(const AliFlowEventSimple& anEvent):
   fZPCM(anEvent.fZPCM),
   fZPAM(anEvent.fZPAM),
   fAbsOrbit(anEvent.fAbsOrbit),
+  fTrackArraysValid(kFALSE),
+  fTrackArraysModificationCount(0),
+  fTrackArraysSize(0),
+  fTrackPhi(NULL),
+  fTrackEta(NULL),
+  fTrackPt(NULL),
+  fTrackWeight(NULL),
+  fTrackCharge(NULL),
+  fTrackFlowBits(NULL),
+  fTrackSubEventBits(NULL),
   fNumberOfPOItypes(anEvent.fNumberOfPOItypes),
   fNumberOfPOIs(new Int_t[fNumberOfPOItypes])
 {
@@ -298,6 +328,7 @@ AliFlowEventSimple& AliFlowEventSimple::operator=(const AliFlowEventSimple& anEv
   fZPCM = anEvent.fZPCM;
   fZPAM = anEvent.fZPAM;
   fAbsOrbit = anEvent.fAbsOrbit;
+  fTrackArraysValid = kFALSE;
   for(Int_t i(0); i < 3; i++) {
     fVtxPos[i] = anEvent.fVtxPos[i];
   }
@@ -322,6 +353,13 @@ AliFlowEventSimple::~AliFlowEventSimple()
   delete fShuffledIndexes;
   delete fMothersCollection;
   delete [] fNumberOfPOIs;
+  delete [] fTrackPhi;
+  delete [] fTrackEta;
+  delete [] fTrackPt;
+  delete [] fTrackWeight;
+  delete [] fTrackCharge;
+  delete [] fTrackFlowBits;
+  delete [] fTrackSubEventBits;
 }
 
 //-----------------------------------------------------------------------
@@ -374,7 +412,8 @@ void AliFlowEventSimple::Generate(Int_t nParticles,
 
   for (Int_t i=0; i<nParticles; i++)
   {
-    AliFlowTrackSimple* track = new AliFlowTrackSimple();
+    AliFlowTrackSimple* track = MakeNewTrack();
+    track->Clear();
     track->SetPhi( gRandom->Uniform(phiMin,phiMax) );
     track->SetEta( gRandom->Uniform(etaMin,etaMax) );
     track->SetPt( ptDist->GetRandom() );
@@ -441,6 +480,7 @@ void AliFlowEventSimple::ShuffleTracks()
   }
   //shuffle
   std::random_shuffle(&fShuffledIndexes[0], &fShuffledIndexes[fNumberOfTracks]);
+  fTrackArraysValid=kFALSE;
   Printf("Tracks shuffled! tracks: %i",fNumberOfTracks);
 }
 
@@ -467,6 +507,7 @@ void AliFlowEventSimple::TrackAdded()
 {
   //book keeping after a new track has been added
   fNumberOfTracks++;
+  fTrackArraysValid=kFALSE;
   if (fShuffledIndexes)
   {
     delete [] fShuffledIndexes;
@@ -485,6 +526,73 @@ AliFlowTrackSimple* AliFlowEventSimple::MakeNewTrack()
    return t;
 }
 
+//-----------------------------------------------------------------------
+void AliFlowEventSimple::FillTrackArrays()
+{
+  //copy phi, eta, pt, weight, charge, flow bits and subevent bits of all tracks
+  //into contiguous arrays, in the same order as GetTrack(i) (i.e. shuffled if
+  //requested); the arrays are reused from event to event and rebuilt on demand
+  //after tracks are added or removed by the event, or after any track was
+  //modified (see AliFlowTrackSimple::GetModificationCount())
+  if (fNumberOfTracks>fTrackArraysSize)
+  {
+    delete [] fTrackPhi;
+    delete [] fTrackEta;
+    delete [] fTrackPt;
+    delete [] fTrackWeight;
+    delete [] fTrackCharge;
+    delete [] fTrackFlowBits;
+    delete [] fTrackSubEventBits;
+    fTrackArraysSize = fNumberOfTracks+fNumberOfTracks/2;
+    fTrackPhi = new Double_t[fTrackArraysSize];
+    fTrackEta = new Double_t[fTrackArraysSize];
+    fTrackPt = new Double_t[fTrackArraysSize];
+    fTrackWeight = new Double_t[fTrackArraysSize];
+    fTrackCharge = new Int_t[fTrackArraysSize];
+    fTrackFlowBits = new UInt_t[fTrackArraysSize];
+    fTrackSubEventBits = new UInt_t[fTrackArraysSize];
+  }
+  for (Int_t i=0; i<fNumberOfTracks; i++)
+  {
+    AliFlowTrackSimple* track = GetTrack(i);
+    if (!track)
+    {
+      //empty slot: no flow bits, so never taken as RP or POI
+      fTrackPhi[i]=0.; fTrackEta[i]=0.; fTrackPt[i]=0.; fTrackWeight[i]=0.;
+      fTrackCharge[i]=0; fTrackFlowBits[i]=0; fTrackSubEventBits[i]=0;
+      continue;
+    }
+    fTrackPhi[i] = track->Phi();
+    fTrackEta[i] = track->Eta();
+    fTrackPt[i] = track->Pt();
+    fTrackWeight[i] = track->Weight();
+    fTrackCharge[i] = track->Charge();
+    fTrackFlowBits[i] = GetFirstBitsWord(track->GetFlowBits());
+    fTrackSubEventBits[i] = GetFirstBitsWord(track->GetSubEventBits());
+  }
+  fTrackArraysValid=kTRUE;
+  fTrackArraysModificationCount=AliFlowTrackSimple::GetModificationCount();
+}
+
+//-----------------------------------------------------------------------
+UInt_t AliFlowEventSimple::GetFirstBitsWord(const TBits* bits)
+{
+  //bits 0-31 as one word; they normally fit in one word: read it in one go
+  UInt_t word = 0;
+  if (bits->GetNbits()<=32)
+  {
+    bits->Get(&word);
+  }
+  else
+  {
+    for (UInt_t j=0; j<32; j++)
+    {
+      if (bits->TestBitNumber(j)) word |= (1u<<j);
+    }
+  }
+  return word;
+}
+
 //-----------------------------------------------------------------------
 AliFlowVector AliFlowEventSimple::GetQ( Int_t n,
                                         TList *weightsList,
@@ -893,6 +1001,16 @@ AliFlowEventSimple::AliFlowEventSimple( TTree* inputTree,
   fZPCM(0.),
   fZPAM(0.),
   fAbsOrbit(0),
+  fTrackArraysValid(kFALSE),
+  fTrackArraysModificationCount(0),
+  fTrackArraysSize(0),
+  fTrackPhi(NULL),
+  fTrackEta(NULL),
+  fTrackPt(NULL),
+  fTrackWeight(NULL),
+  fTrackCharge(NULL),
+  fTrackFlowBits(NULL),
+  fTrackSubEventBits(NULL),
   fNumberOfPOItypes(2),
   fNumberOfPOIs(new Int_t[fNumberOfPOItypes])
 {
@@ -1157,6 +1275,7 @@ void AliFlowEventSimple::AddV2( TF2* ptEtaDepV2 )
 void AliFlowEventSimple::TagRP( const AliFlowTrackSimpleCuts* cuts )
 {
   //tag tracks as reference particles (RPs)
+  fTrackArraysValid=kFALSE;
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
     AliFlowTrackSimple* track = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(i));
@@ -1179,6 +1298,7 @@ void AliFlowEventSimple::TagRP( const AliFlowTrackSimpleCuts* cuts )
 void AliFlowEventSimple::TagPOI( const AliFlowTrackSimpleCuts* cuts, Int_t poiType )
 {
   //tag tracks as particles of interest (POIs)
+  fTrackArraysValid=kFALSE;
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
     AliFlowTrackSimple* track = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(i));
@@ -1212,6 +1332,7 @@ void AliFlowEventSimple::DefineDeadZone( Double_t etaMin,
 {
   //mark tracks in given eta-phi region as dead
   //by resetting the flow bits
+  fTrackArraysValid=kFALSE;
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
     AliFlowTrackSimple* track = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(i));
@@ -1234,6 +1355,7 @@ Int_t AliFlowEventSimple::CleanUpDeadTracks()
 {
   //remove tracks that have no flow tags set and cleanup the container
   //returns number of cleaned tracks
+  fTrackArraysValid=kFALSE;
   Int_t ncleaned=0;
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
@@ -1282,5 +1404,6 @@ void AliFlowEventSimple::ClearFast()
   fMCReactionPlaneAngleIsSet = kFALSE;
   fAfterBurnerPrecision = 0.001;
   fUserModified = kFALSE;
+  fTrackArraysValid = kFALSE;
   delete [] fShuffledIndexes; fShuffledIndexes=NULL;
 }
@@ -82,7 +82,7 @@ class AliFlowEventSimple: public TObject {
   Bool_t   IsSetMCReactionPlaneAngle() const        { return fMCReactionPlaneAngleIsSet; }
   void     SetAfterBurnerPrecision(Double_t p)      { fAfterBurnerPrecision=p; }
   Double_t GetAfterBurnerPrecision() const          { return fAfterBurnerPrecision; }
-  void     SetUserModified(Bool_t s=kTRUE)          { fUserModified=s; }
+  void     SetUserModified(Bool_t s=kTRUE)          { fUserModified=s; fTrackArraysValid=kFALSE; }
   Bool_t   IsUserModified() const                   { return fUserModified; }
   void     SetShuffleTracks(Bool_t b)               {fShuffleTracks=b;}
   void     ShuffleTracks();
@@ -117,6 +117,19 @@ class AliFlowEventSimple: public TObject {
   void TrackAdded();
   AliFlowTrackSimple* MakeNewTrack();
 
+  //contiguous per-track arrays, index i corresponds to GetTrack(i); they are
+  //refilled on access when tracks were added or removed, or any track modified
+  void           FillTrackArrays();
+  void           InvalidateTrackArrays()            { fTrackArraysValid=kFALSE; }
+  Bool_t         TrackArraysUpToDate() const        { return fTrackArraysValid && fTrackArraysModificationCount==AliFlowTrackSimple::GetModificationCount(); }
+  const Double_t* GetTrackPhiArray()                { if (!TrackArraysUpToDate()) FillTrackArrays(); return fTrackPhi; }
+  const Double_t* GetTrackEtaArray()                { if (!TrackArraysUpToDate()) FillTrackArrays(); return fTrackEta; }
+  const Double_t* GetTrackPtArray()                 { if (!TrackArraysUpToDate()) FillTrackArrays(); return fTrackPt; }
+  const Double_t* GetTrackWeightArray()             { if (!TrackArraysUpToDate()) FillTrackArrays(); return fTrackWeight; }
+  const Int_t*    GetTrackChargeArray()             { if (!TrackArraysUpToDate()) FillTrackArrays(); return fTrackCharge; }
+  const UInt_t*   GetTrackFlowBitsArray()           { if (!TrackArraysUpToDate()) FillTrackArrays(); return fTrackFlowBits; }
+  const UInt_t*   GetTrackSubEventBitsArray()       { if (!TrackArraysUpToDate()) FillTrackArrays(); return fTrackSubEventBits; }
+
   virtual AliFlowVector GetQ(Int_t n=2, TList *weightsList=NULL, Bool_t usePhiWeights=kFALSE, Bool_t usePtWeights=kFALSE, Bool_t useEtaWeights=kFALSE);
   virtual void Get2Qsub(AliFlowVector* Qarray, Int_t n=2, TList *weightsList=NULL, Bool_t usePhiWeights=kFALSE, Bool_t usePtWeights=kFALSE, Bool_t useEtaWeights=kFALSE);
   virtual void GetZDC2Qsub(AliFlowVector* Qarray);
@@ -204,8 +217,20 @@ class AliFlowEventSimple: public TObject {
   Double_t                fZPAM;                      // total energy from ZPC-A
   Double_t                fVtxPos[3];                 // Primary vertex position (x,y,z)
   UInt_t                  fAbsOrbit;                  // Absolute orbit number
+  Bool_t                  fTrackArraysValid;          //! are the per-track arrays in sync with the track collection?
+  ULong64_t               fTrackArraysModificationCount; //! AliFlowTrackSimple::GetModificationCount() when the arrays were filled
+  Int_t                   fTrackArraysSize;           //! allocated size of the per-track arrays
+  Double_t*               fTrackPhi;                  //! [fTrackArraysSize] phi of GetTrack(i)
+  Double_t*               fTrackEta;                  //! [fTrackArraysSize] eta of GetTrack(i)
+  Double_t*               fTrackPt;                   //! [fTrackArraysSize] pt of GetTrack(i)
+  Double_t*               fTrackWeight;               //! [fTrackArraysSize] weight of GetTrack(i)
+  Int_t*                  fTrackCharge;               //! [fTrackArraysSize] charge of GetTrack(i)
+  UInt_t*                 fTrackFlowBits;             //! [fTrackArraysSize] flow bits 0-31 of GetTrack(i) (bit 0 = RP, bit n = POI type n)
+  UInt_t*                 fTrackSubEventBits;         //! [fTrackArraysSize] subevent bits 0-31 of GetTrack(i)
 
  private:
+  static UInt_t GetFirstBitsWord(const TBits* bits);
+
   Int_t                   fNumberOfPOItypes;    // how many different flow particle types do we have? (RP,POI,POI_2,...)
   Int_t*                  fNumberOfPOIs;          //[fNumberOfPOItypes] number of tracks that have passed the POI selection
 
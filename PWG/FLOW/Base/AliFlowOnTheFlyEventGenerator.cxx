@@ -202,7 +202,9 @@ AliFlowEventSimple* AliFlowOnTheFlyEventGenerator::ConvertTClonesToFlowEvent(TCl
         pParticle = (TParticle*)event->At(i);           // get the particle 
         if (!pParticle) continue;                       // skip if empty slot (no particle)
         if (pParticle->GetNDaughters()!=0) continue;    // see if the particle has daughters (if so, reject it)      
-        AliFlowTrackSimple* pTrack = new AliFlowTrackSimple(pParticle);         // allocate space for the new flow track
+        AliFlowTrackSimple* pTrack = fFlowEvent->MakeNewTrack();               // reuse a flow track from the previous event if available
+        pTrack->Clear();                                                        // reset all members of a reused track
+        pTrack->Set(pParticle);                                                 // copy kinematics from the particle
         pTrack->SetWeight(pParticle->Pz());                                     // ugly hack: store pz here ...
         pTrack->SetID(pParticle->GetPdgCode());                                 // set pid code as id
         pTrack->SetForRPSelection(kTRUE);                                       // tag ALL particles as RP's, 
@@ -31,6 +31,8 @@
 
 ClassImp(AliFlowTrackSimple)
 
+ULong64_t AliFlowTrackSimple::fgModificationCount = 0;
+
 //-----------------------------------------------------------------------
 AliFlowTrackSimple::AliFlowTrackSimple():
   TObject(),
@@ -97,6 +99,7 @@ void AliFlowTrackSimple::Set(TParticle* p)
   fCharge = TMath::Nint(ppdg->Charge()/3.0);
   fMass = ppdg->Mass();
   fITStype = 0;
+  Modified();
 }
 
 //-----------------------------------------------------------------------
@@ -138,6 +141,7 @@ AliFlowTrackSimple& AliFlowTrackSimple::operator=(const AliFlowTrackSimple& aTra
   fSubEventBits = aTrack.fSubEventBits;
   fID = aTrack.fID;
   fITStype = aTrack.fITStype;
+  Modified();
 
   return *this;
 }
@@ -154,6 +158,7 @@ void AliFlowTrackSimple::ResolutionPt(Double_t res)
 {
   //smear the pt by a gaussian with sigma=res
   fPt += gRandom->Gaus(0.,res);
+  Modified();
 }
 
 //----------------------------------------------------------------------- 
@@ -176,6 +181,7 @@ void AliFlowTrackSimple::AddV1( Double_t v1,
     fPhi -= f/fp;
     if (TMath::AreEqualAbs(phiprev,fPhi,precisionPhi)) break;
   }
+  Modified();
 }
 
 //----------------------------------------------------------------------- 
@@ -198,6 +204,7 @@ void AliFlowTrackSimple::AddV2( Double_t v2,
     fPhi -= f/fp;
     if (TMath::AreEqualAbs(phiprev,fPhi,precisionPhi)) break;
   }
+  Modified();
 }
 
 //----------------------------------------------------------------------- 
@@ -220,6 +227,7 @@ void AliFlowTrackSimple::AddV3( Double_t v3,
     fPhi -= f/fp;
     if (TMath::AreEqualAbs(phiprev,fPhi,precisionPhi)) break;
   }
+  Modified();
 }
 
 //----------------------------------------------------------------------- 
@@ -242,6 +250,7 @@ void AliFlowTrackSimple::AddV4( Double_t v4,
     fPhi -= f/fp;
     if (TMath::AreEqualAbs(phiprev,fPhi,precisionPhi)) break;
   }
+  Modified();
 }
 
 //----------------------------------------------------------------------- 
@@ -264,6 +273,7 @@ void AliFlowTrackSimple::AddV5( Double_t v5,
     fPhi -= f/fp;
     if (TMath::AreEqualAbs(phiprev,fPhi,precisionPhi)) break;
   }
+  Modified();
 }
 
 //______________________________________________________________________________
@@ -307,6 +317,7 @@ void AliFlowTrackSimple::AddFlow( Double_t v1,
     fPhi -= f/fp;
     if (TMath::AreEqualAbs(phiprev,fPhi,precisionPhi)) break;
   }
+  Modified();
 }
 
 //______________________________________________________________________________
@@ -357,6 +368,7 @@ void AliFlowTrackSimple::AddFlow( Double_t v1,
     fPhi -= f/fp;
     if (TMath::AreEqualAbs(phiprev,fPhi,precisionPhi)) break;
   }
+  Modified();
 }
 
 //______________________________________________________________________________
@@ -387,4 +399,5 @@ void AliFlowTrackSimple::Clear(Option_t*)
   fSubEventBits.ResetAllBits();
   fID=-1;
   fITStype=0;
+  Modified();
 }
@@ -53,11 +53,11 @@ public:
   Bool_t InSubevent(Int_t i) const;
   void TagRP(Bool_t b=kTRUE) {SetForRPSelection(b);} 
   void TagPOI(Bool_t b=kTRUE) {SetForPOISelection(b);} 
-  void Tag(Int_t n, Bool_t b=kTRUE) {fPOItype.SetBitNumber(n,b);}
+  void Tag(Int_t n, Bool_t b=kTRUE) {fPOItype.SetBitNumber(n,b); Modified();}
   Bool_t CheckTag(Int_t n) {return fPOItype.TestBitNumber(n);}
   void SetForSubevent(Int_t i); 
-  void ResetPOItype() {fPOItype.ResetAllBits();}
-  void ResetSubEventTags() {fSubEventBits.ResetAllBits();}
+  void ResetPOItype() {fPOItype.ResetAllBits(); Modified();}
+  void ResetSubEventTags() {fSubEventBits.ResetAllBits(); Modified();}
   Bool_t IsDead() const {return (fPOItype.CountBits()==0);}
       
   void SetEta(Double_t eta);
@@ -123,6 +123,7 @@ public:
 
   const TBits* GetPOItype() const {return &fPOItype;}
   const TBits* GetFlowBits() const {return GetPOItype();}
+  const TBits* GetSubEventBits() const {return &fSubEventBits;}
 
   void  SetID(Int_t i) {fID=i;}
   Int_t GetID() const {return fID;}
@@ -133,7 +134,14 @@ public:
   virtual void SetDaughter(Int_t /*value*/, AliFlowTrackSimple* /*track*/) {}
   virtual AliFlowTrackSimple *GetDaughter(Int_t /*value*/) const {return NULL;}
 
+  //counts the modifications of the kinematics, weight, charge and tags of all
+  //tracks, used by AliFlowEventSimple to keep its per-track arrays up to date
+  static ULong64_t GetModificationCount() {return fgModificationCount;}
+
  private:
+  static void Modified() {fgModificationCount++;}
+  static ULong64_t fgModificationCount; // number of track modifications so far
+
   AliFlowTrackSimple(Double_t phi, Double_t eta, Double_t pt, Double_t weight, Int_t charge, Double_t mass=-1);
   Double_t fEta;         // eta
   Double_t fPt;          // pt
@@ -177,15 +185,15 @@ inline Bool_t AliFlowTrackSimple::InSubevent(Int_t i) const {
 
 //Setters
 inline void AliFlowTrackSimple::SetEta(Double_t val) {
-  fEta = val; }
+  fEta = val; Modified(); }
 inline void AliFlowTrackSimple::SetPt(Double_t val) {
-  fPt = val; }
+  fPt = val; Modified(); }
 inline void AliFlowTrackSimple::SetPhi(Double_t val) {
-  fPhi = val; }
+  fPhi = val; Modified(); }
 inline void AliFlowTrackSimple::SetWeight(Double_t val) {
-  fTrackWeight = val; }
+  fTrackWeight = val; Modified(); }
 inline void AliFlowTrackSimple::SetCharge(Int_t val) {
-  fCharge = val; }
+  fCharge = val; Modified(); }
 inline void AliFlowTrackSimple::SetMass(Double_t val) {
   fMass = val; }
 inline void AliFlowTrackSimple::SetITStype(Int_t val) {
@@ -193,14 +201,14 @@ inline void AliFlowTrackSimple::SetITStype(Int_t val) {
 
   //TBits
 inline void AliFlowTrackSimple::SetForRPSelection(Bool_t val) {
-  fPOItype.SetBitNumber(kRP,val); }
+  fPOItype.SetBitNumber(kRP,val); Modified(); }
 inline void AliFlowTrackSimple::SetForPOISelection(Bool_t val) {
-  fPOItype.SetBitNumber(kPOI,val); }
+  fPOItype.SetBitNumber(kPOI,val); Modified(); }
 inline void AliFlowTrackSimple::SetForSubevent(Int_t i) {
-  fSubEventBits.SetBitNumber(i,kTRUE); }
+  fSubEventBits.SetBitNumber(i,kTRUE); Modified(); }
 
 inline void AliFlowTrackSimple::SetPOItype(Int_t poiType, Bool_t b) {
-  fPOItype.SetBitNumber(poiType,b); }
+  fPOItype.SetBitNumber(poiType,b); Modified(); }
 
 #endif
 
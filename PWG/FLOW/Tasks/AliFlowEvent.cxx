@@ -1029,6 +1029,7 @@ void AliFlowEvent::InsertTrack(AliFlowTrack *track) {
 AliFlowTrack* AliFlowEvent::ReuseTrack(Int_t i)
 {
   //try to reuse an existing track, if empty, make new one
+  InvalidateTrackArrays();
   AliFlowTrack* pTrack = static_cast<AliFlowTrack*>(fTrackCollection->At(i));
   if (pTrack)
   {
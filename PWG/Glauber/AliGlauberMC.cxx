@@ -32,6 +32,11 @@
 #include <TFile.h>
 #include <TTree.h>
 #include <TF1.h>
+#include <TRandom3.h>
+#include <algorithm>
+#if __cplusplus >= 201103L
+#include <thread>
+#endif
 
 #include "AliGlauberNucleon.h"
 #include "AliGlauberNucleus.h"
@@ -172,7 +177,15 @@ AliGlauberMC::AliGlauberMC(Option_t* NA, Option_t* NB, Double_t xsect) :
   fOmega(0),
   fSig0(0),
   fLambda(0),
-  fSigFluc(0)
+  fSigFluc(0),
+  fNThreads(1),
+  fSeed(0),
+  fRandom(0),
+  fSigFlucX(),
+  fSigFlucCDF(),
+  fGridCellStart(),
+  fGridIndex(),
+  fGridCandidates()
 {
   //ctor
   for (UInt_t i=0; i<(sizeof(fdNdEtaParam)/sizeof(fdNdEtaParam[0])); i++)
@@ -322,7 +335,15 @@ AliGlauberMC::AliGlauberMC(const AliGlauberMC& in):
   fOmega(in.fOmega),
   fSig0(in.fSig0),
   fLambda(in.fLambda),
-  fSigFluc(in.fSigFluc)
+  fSigFluc(in.fSigFluc),
+  fNThreads(in.fNThreads),
+  fSeed(in.fSeed),
+  fRandom(0),
+  fSigFlucX(),
+  fSigFlucCDF(),
+  fGridCellStart(),
+  fGridIndex(),
+  fGridCandidates()
 {
   //copy ctor
   memcpy(fdNdEtaParam,in.fdNdEtaParam,sizeof(fdNdEtaParam));
@@ -453,6 +474,8 @@ AliGlauberMC& AliGlauberMC::operator=(const AliGlauberMC& in)
   fSxyCom=in.fSxyCom;
   fX=in.fX;
   fNpp=in.fNpp;
+  fNThreads=in.fNThreads;
+  fSeed=in.fSeed;
   return *this;
 }
 
@@ -461,13 +484,7 @@ Bool_t AliGlauberMC::CalcEvent(Double_t bgen)
 {
   // prepare event
 
-  if (fDoFluc) {
-    if (!fSigFluc) {
-      fSigFluc = new TF1("fSigFluc","[0]*x/[3]/(x/[3]+[1])*exp(-((x/[1]/[3]-1)/[2])^2)",0,250);
-      fSigFluc->SetParameters(1,fSig0,fOmega,fLambda);
-      cout << "Setting fluc: " << fSig0 << " " << fOmega << " " << fLambda << endl;
-    }
-  }
+  if (fDoFluc) MakeSigFluc();
 
   fANucleus.ThrowNucleons(-bgen/2.);
   fNucleonsA = fANucleus.GetNucleons();
@@ -480,7 +497,7 @@ Bool_t AliGlauberMC::CalcEvent(Double_t bgen)
     nucleonA->SetInNucleusA();
     nucleonA->SetSigNN(fXSect);
     if (fDoFluc)
-      nucleonA->SetSigNN(fSigFluc->GetRandom());
+      nucleonA->SetSigNN(fRandom ? AliGlauberNucleus::GetRandomFromCDF(fSigFlucX,fSigFlucCDF,fRandom) : fSigFluc->GetRandom());
   }
   fBNucleus.ThrowNucleons(bgen/2.);
   fNucleonsB = fBNucleus.GetNucleons();
@@ -493,65 +510,202 @@ Bool_t AliGlauberMC::CalcEvent(Double_t bgen)
     nucleonB->SetInNucleusB();
     nucleonB->SetSigNN(fXSect);
     if (fDoFluc)
-      nucleonB->SetSigNN(fSigFluc->GetRandom());
+      nucleonB->SetSigNN(fRandom ? AliGlauberNucleus::GetRandomFromCDF(fSigFlucX,fSigFlucCDF,fRandom) : fSigFluc->GetRandom());
   }
 
   if (fDoFluc) {
-    if (!fSigFluc) {
-      fSigFluc = new TF1("fSigFluc","[0]*x/[3]/(x/[3]+[1])*exp(-((x/[1]/[3]-1)/[2])^2)",0,250);
-      fSigFluc->SetParameters(1,fSig0,fOmega,fLambda);
-      cout << "Setting fluc: " << fSig0 << " " << fOmega << " " << fLambda << endl;
-    }
-    fXSect = fSigFluc->GetRandom();
+    fXSect = fRandom ? AliGlauberNucleus::GetRandomFromCDF(fSigFlucX,fSigFlucCDF,fRandom) : fSigFluc->GetRandom();
   }
-  // "ball" diameter = distance at which two balls interact
-  Double_t d2 = (Double_t)fXSect/(TMath::Pi()*10); // in fm^2
 
   Double_t bNN   = 0;
   Double_t Nco   = 0;
   Double_t Ncohc = 0; // hard core
+  CalcCollisions(bNN,Nco,Ncohc);
+
+  if (Nco>0) {
+    fNcollw = Ncohc;
+    fBNN = bNN/Nco;
+  } else {
+    fNcollw = 0;
+    fBNN    = 0.;
+  }
+
+  if (Nco>0)
+    fBNN = bNN/Nco;
+  else
+    fBNN = 0.;
+  return CalcResults(bgen);
+}
+
+//______________________________________________________________________________
+void AliGlauberMC::CalcCollisions(Double_t& bNN, Double_t& Nco, Double_t& Ncohc)
+{
+  // find all colliding nucleon pairs of A and B; the nucleons of A are
+  // binned in a transverse grid with cells as large as the largest
+  // interaction distance, so only the 3x3 cells around each nucleon of B
+  // have to be checked. Pairs are visited in the same order as in the
+  // plain loop over all pairs (kept for light nuclei), so the results
+  // are identical.
+
+  // "ball" diameter = distance at which two balls interact
+  Double_t d2 = (Double_t)fXSect/(TMath::Pi()*10); // in fm^2
+
+  const Int_t kMinGridN = 16;
+  if (fAN < kMinGridN || fBN < kMinGridN)
+  {
+    // for each of the A nucleons in nucleus B
+    for (Int_t i = 0; i<fBN; i++)
+    {
+      AliGlauberNucleon *nucleonB=(AliGlauberNucleon*)(fNucleonsB->UncheckedAt(i));
+      for (Int_t j = 0 ; j < fAN ; j++)
+      {
+        AliGlauberNucleon *nucleonA=(AliGlauberNucleon*)(fNucleonsA->UncheckedAt(j));
+        Double_t dx = nucleonB->GetX()-nucleonA->GetX();
+        Double_t dy = nucleonB->GetY()-nucleonA->GetY();
+        Double_t dij = dx*dx+dy*dy;
+        if (fDoFluc) {
+          //fXSect = nucleonA->GetSigNN();
+          //fXSect = (nucleonA->GetSigNN()+nucleonB->GetSigNN())/2.;
+          fXSect = TMath::Max(nucleonA->GetSigNN(),nucleonB->GetSigNN());
+          d2 = (Double_t)fXSect/(TMath::Pi()*10); // in fm^2
+        }
+        if (dij < d2)
+        {
+          bNN += dij;
+          ++Nco;
+          nucleonB->Collide();
+          nucleonA->Collide();
+          if (dij<d2/4)
+            ++Ncohc;
+        }
+      }
+    }
+    return;
+  }
+
+  // largest interaction distance and extent of nucleus A
+  Double_t maxSigA = fXSect;
+  Double_t maxSigB = fXSect;
+  Double_t xmin = 1e30, xmax = -1e30, ymin = 1e30, ymax = -1e30;
+  for (Int_t j = 0; j<fAN; j++)
+  {
+    AliGlauberNucleon *nucleonA=(AliGlauberNucleon*)(fNucleonsA->UncheckedAt(j));
+    if (fDoFluc) maxSigA = (j==0) ? nucleonA->GetSigNN() : TMath::Max(maxSigA,nucleonA->GetSigNN());
+    xmin = TMath::Min(xmin,nucleonA->GetX()); xmax = TMath::Max(xmax,nucleonA->GetX());
+    ymin = TMath::Min(ymin,nucleonA->GetY()); ymax = TMath::Max(ymax,nucleonA->GetY());
+  }
+  if (fDoFluc)
+  {
+    for (Int_t i = 0; i<fBN; i++)
+    {
+      AliGlauberNucleon *nucleonB=(AliGlauberNucleon*)(fNucleonsB->UncheckedAt(i));
+      maxSigB = (i==0) ? nucleonB->GetSigNN() : TMath::Max(maxSigB,nucleonB->GetSigNN());
+    }
+  }
+  Double_t cell = TMath::Sqrt(TMath::Max(TMath::Max(maxSigA,maxSigB),0.)/(TMath::Pi()*10));
+  if (!(cell>0)) cell = 1.; // no pair can interact, any cell size will do
+  const Int_t kMaxCells = 64;
+  Int_t nx = TMath::Min((Int_t)((xmax-xmin)/cell)+1,kMaxCells);
+  Int_t ny = TMath::Min((Int_t)((ymax-ymin)/cell)+1,kMaxCells);
+  Double_t cellX = TMath::Max(cell,(xmax-xmin)/nx*1.000001);
+  Double_t cellY = TMath::Max(cell,(ymax-ymin)/ny*1.000001);
+
+  // counting sort of the nucleons of A into the cells (ascending index within a cell)
+  fGridCellStart.assign(nx*ny+1,0);
+  fGridIndex.resize(fAN);
+  for (Int_t j = 0; j<fAN; j++)
+  {
+    AliGlauberNucleon *nucleonA=(AliGlauberNucleon*)(fNucleonsA->UncheckedAt(j));
+    Int_t ix = TMath::Min((Int_t)((nucleonA->GetX()-xmin)/cellX),nx-1);
+    Int_t iy = TMath::Min((Int_t)((nucleonA->GetY()-ymin)/cellY),ny-1);
+    fGridCellStart[ix*ny+iy+1]++;
+  }
+  for (Int_t c = 0; c<nx*ny; c++) fGridCellStart[c+1] += fGridCellStart[c];
+  std::vector<Int_t> fill(fGridCellStart.begin(),fGridCellStart.end()-1);
+  for (Int_t j = 0; j<fAN; j++)
+  {
+    AliGlauberNucleon *nucleonA=(AliGlauberNucleon*)(fNucleonsA->UncheckedAt(j));
+    Int_t ix = TMath::Min((Int_t)((nucleonA->GetX()-xmin)/cellX),nx-1);
+    Int_t iy = TMath::Min((Int_t)((nucleonA->GetY()-ymin)/cellY),ny-1);
+    fGridIndex[fill[ix*ny+iy]++] = j;
+  }
 
   // for each of the A nucleons in nucleus B
   for (Int_t i = 0; i<fBN; i++)
   {
     AliGlauberNucleon *nucleonB=(AliGlauberNucleon*)(fNucleonsB->UncheckedAt(i));
-    for (Int_t j = 0 ; j < fAN ; j++)
+    Double_t xb = nucleonB->GetX();
+    Double_t yb = nucleonB->GetY();
+    Int_t ix0 = (Int_t)TMath::Floor((xb-xmin)/cellX);
+    Int_t iy0 = (Int_t)TMath::Floor((yb-ymin)/cellY);
+    fGridCandidates.clear();
+    for (Int_t ix = TMath::Max(ix0-1,0); ix <= TMath::Min(ix0+1,nx-1); ix++)
     {
-      AliGlauberNucleon *nucleonA=(AliGlauberNucleon*)(fNucleonsA->UncheckedAt(j));
-      Double_t dx = nucleonB->GetX()-nucleonA->GetX();
-      Double_t dy = nucleonB->GetY()-nucleonA->GetY();
-      Double_t dij = dx*dx+dy*dy;
-      if (fDoFluc) {
-	//fXSect = nucleonA->GetSigNN();
-	//fXSect = (nucleonA->GetSigNN()+nucleonB->GetSigNN())/2.;
-	fXSect = TMath::Max(nucleonA->GetSigNN(),nucleonB->GetSigNN());
-	d2 = (Double_t)fXSect/(TMath::Pi()*10); // in fm^2
+      for (Int_t iy = TMath::Max(iy0-1,0); iy <= TMath::Min(iy0+1,ny-1); iy++)
+      {
+        Int_t c = ix*ny+iy;
+        fGridCandidates.insert(fGridCandidates.end(),fGridIndex.begin()+fGridCellStart[c],fGridIndex.begin()+fGridCellStart[c+1]);
       }
+    }
+    std::sort(fGridCandidates.begin(),fGridCandidates.end());
+    for (UInt_t k = 0; k<fGridCandidates.size(); k++)
+    {
+      AliGlauberNucleon *nucleonA=(AliGlauberNucleon*)(fNucleonsA->UncheckedAt(fGridCandidates[k]));
+      Double_t dx = xb-nucleonA->GetX();
+      Double_t dy = yb-nucleonA->GetY();
+      Double_t dij = dx*dx+dy*dy;
+      if (fDoFluc)
+        d2 = (Double_t)TMath::Max(nucleonA->GetSigNN(),nucleonB->GetSigNN())/(TMath::Pi()*10); // in fm^2
       if (dij < d2)
       {
-	bNN += dij;
-	++Nco;
+        bNN += dij;
+        ++Nco;
         nucleonB->Collide();
         nucleonA->Collide();
-	if (dij<d2/4)
-	  ++Ncohc;
+        if (dij<d2/4)
+          ++Ncohc;
       }
     }
   }
 
-  if (Nco>0) {
-    fNcollw = Ncohc;
-    fBNN = bNN/Nco;
-  } else {
-    fNcollw = 0;
-    fBNN    = 0.;
+  // the plain loop leaves the cross section of the last pair in fXSect
+  if (fDoFluc)
+  {
+    AliGlauberNucleon *lastA=(AliGlauberNucleon*)(fNucleonsA->UncheckedAt(fAN-1));
+    AliGlauberNucleon *lastB=(AliGlauberNucleon*)(fNucleonsB->UncheckedAt(fBN-1));
+    fXSect = TMath::Max(lastA->GetSigNN(),lastB->GetSigNN());
   }
+}
 
-  if (Nco>0)
-    fBNN = bNN/Nco;
-  else
-    fBNN = 0.;
-  return CalcResults(bgen);
+//______________________________________________________________________________
+void AliGlauberMC::MakeSigFluc()
+{
+  // create the parameterization of the fluctuating sigNN if not done yet
+  if (fSigFluc) return;
+  fSigFluc = new TF1("fSigFluc","[0]*x/[3]/(x/[3]+[1])*exp(-((x/[1]/[3]-1)/[2])^2)",0,250);
+  fSigFluc->SetParameters(1,fSig0,fOmega,fLambda);
+  cout << "Setting fluc: " << fSig0 << " " << fOmega << " " << fLambda << endl;
+}
+
+//______________________________________________________________________________
+void AliGlauberMC::SetRandom(TRandom* rnd)
+{
+  // use rnd instead of gRandom for this generator and its nuclei (not owned);
+  // the densities are then sampled from tables, see AliGlauberNucleus::SetRandom
+  fRandom = rnd;
+  fANucleus.SetRandom(rnd);
+  fBNucleus.SetRandom(rnd);
+  if (fRandom && fDoFluc) {
+    MakeSigFluc();
+    AliGlauberNucleus::TabulateCDF(fSigFluc,fSigFlucX,fSigFlucCDF);
+  }
+}
+
+//______________________________________________________________________________
+TRandom* AliGlauberMC::GetRandom() const
+{
+  // generator in use
+  return fRandom ? fRandom : gRandom;
 }
 
 //______________________________________________________________________________
@@ -1267,7 +1421,7 @@ Int_t AliGlauberMC::NegativeBinomialRandom(Int_t k, Double_t nmean) const
   {
     array[i] = NegativeBinomialDistribution(i,k,nmean) + array[i-1];
   }
-  Double_t r = gRandom->Uniform(0,1);
+  Double_t r = GetRandom()->Uniform(0,1);
   return TMath::BinarySearch(fMaxPlot,array,r)+2;
 
 }
@@ -1278,7 +1432,7 @@ Int_t AliGlauberMC::NegativeBinomialRandomSV(Double_t k, Double_t nbar) const
   // negative binomial distribution generator, S. Voloshin, 09-May-2007
   Double_t sum=0.;
   Int_t i=0;
-  Double_t ran=gRandom->Rndm();
+  Double_t ran=GetRandom()->Rndm();
   Double_t trm=1./pow(1.+nbar/k,k);
   if (trm==0.)
   {
@@ -1308,7 +1462,7 @@ Int_t AliGlauberMC::DoubleNegativeBinomialRandom( Int_t k,
   {
     array[i] = alpha*NegativeBinomialDistribution(i,k,nmean)+(1-alpha)*NegativeBinomialDistribution(i,k2,nmean2) + array[i-1];
   }
-  Double_t r = gRandom->Uniform(0,1);
+  Double_t r = GetRandom()->Uniform(0,1);
   return TMath::BinarySearch(fMaxPlot,array,r)+2;
 }
 
@@ -1506,7 +1660,7 @@ Bool_t AliGlauberMC::NextEvent(Double_t bgen)
   {
     if(bgen<0||!succes) //get impactparameter
     {
-      bgen = TMath::Sqrt((fBMax*fBMax-fBMin*fBMin)*gRandom->Rndm()+fBMin*fBMin);
+      bgen = TMath::Sqrt((fBMax*fBMax-fBMin*fBMin)*GetRandom()->Rndm()+fBMin*fBMin);
     }
     if ( (succes=CalcEvent(bgen)) ) break; //ends if we have particparts
   }
@@ -1694,6 +1848,16 @@ void AliGlauberMC::Run(Int_t nevents)
                       "Npart:Ncoll:B:MeanX:MeanY:MeanX2:MeanY2:MeanXY:VarX:VarY:VarXY:MeanXSystem:MeanYSystem:MeanXA:MeanYA:MeanXB:MeanYB:VarE:Stoa:VarEColl:VarECom:VarEPart:VarEPartColl:VarEPartCom:dNdEta:dNdEtaGBW:dNdEtaTwoNBD:xsect:tAA:Epsl2:Epsl3:Epsl4:Epsl5:E2Coll:E3Coll:E4Coll:E5Coll:E2Com:E3Com:E4Com:E5Com:Psi2:Psi3:Psi4:Psi5:BNN:signn:Ncollw");
     fnt->SetDirectory(0);
   }
+  if (fNThreads>1 && nevents>1)
+    RunParallel(nevents);
+  else
+    RunSerial(nevents);
+}
+
+//______________________________________________________________________________
+void AliGlauberMC::RunSerial(Int_t nevents)
+{
+  //generate nevents events in this thread and fill the ntuple
   Int_t q = 0;
   Int_t u = 0;
   for (Int_t i = 0; i<nevents; i++)
@@ -1706,68 +1870,8 @@ void AliGlauberMC::Run(Int_t nevents)
     }
 
     q++;
-    Float_t v[48];
-    v[0]  = GetNpart();
-    v[1]  = GetNcoll();
-    v[2]  = fBMC;
-    v[3]  = fMeanXParts;
-    v[4]  = fMeanYParts;
-    v[5]  = fMeanX2Parts;
-    v[6]  = fMeanY2Parts;
-    v[7]  = fMeanXYParts;
-    v[8]  = fSx2Parts;
-    v[9]  = fSy2Parts;
-    v[10] = fSxyParts;
-    v[11] = fMeanXSystem;
-    v[12] = fMeanYSystem;
-    v[13] = fMeanXA;
-    v[14] = fMeanYA;
-    v[15] = fMeanXB;
-    v[16] = fMeanYB;
-    v[17] = GetEccentricity();
-    v[18] = GetStoa();
-    v[19] = GetEccentricityColl();
-    v[20] = GetEccentricityCom();
-    v[21] = GetEccentricityPart();
-    v[22] = GetEccentricityPartColl();
-    v[23] = GetEccentricityPartCom();
-    if (fDoPartProd)
-    {
-      v[24] = GetdNdEta();
-      v[25] = GetdNdEta();
-      v[26] = v[24]+v[25];
-    }
-    else
-    {
-      v[24] = 0;
-      v[25] = 0;
-      v[26] = 0;
-    }
-    v[27]=fXSect;
-
-    Float_t mytAA=-999;
-    if (GetNcoll()>0) mytAA=GetNcoll()/fXSect;
-    v[28]=mytAA;
-    //_____________epsilon2,3,4,4_______
-    v[29] = GetEpsilon2Part();
-    v[30] = GetEpsilon3Part();
-    v[31] = GetEpsilon4Part();
-    v[32] = GetEpsilon5Part();
-    v[33] = GetEpsilon2Coll();
-    v[34] = GetEpsilon3Coll();
-    v[35] = GetEpsilon4Coll();
-    v[36] = GetEpsilon5Coll();
-    v[37] = GetEpsilon2Com();
-    v[38] = GetEpsilon3Com();
-    v[39] = GetEpsilon4Com();
-    v[40] = GetEpsilon5Com();
-    v[41] = GetPsi2();
-    v[42] = GetPsi3();
-    v[43] = GetPsi4();
-    v[44] = GetPsi5();
-    v[45] = fBNN;
-    v[46] = fXSect;
-    v[47] = fNcollw;
+    Float_t v[kNtupleVars];
+    FillNtupleRow(v);
 
     //always at the end
     fnt->Fill(v);
@@ -1777,6 +1881,167 @@ void AliGlauberMC::Run(Int_t nevents)
   std::cout << "Generating Event # " << nevents << "... \r" << endl << "Done! Succesfull events:  " << q << "  discarded events:  " << u <<"."<< endl;
 }
 
+//______________________________________________________________________________
+void AliGlauberMC::RunParallel(Int_t nevents)
+{
+  //generate nevents events with fNThreads workers and fill the ntuple;
+  //every worker is an independent generator with its own TRandom3
+  //(seeded with fSeed+worker) and produces a contiguous block of events,
+  //the rows are appended in worker order, so the ntuple only depends on
+  //fSeed and fNThreads
+  Int_t nWorkers = TMath::Min(fNThreads,nevents);
+  UInt_t seed = fSeed ? fSeed : 1+gRandom->Integer(1000000000);
+  cout << "Using " << nWorkers << " threads, seed " << seed << endl;
+
+  //workers are set up here: TObject and TF1 construction is not thread safe
+  std::vector<AliGlauberMC*> workers(nWorkers);
+  std::vector<TRandom3*> generators(nWorkers);
+  std::vector< std::vector<Float_t> > rows(nWorkers);
+  std::vector<Int_t> discarded(nWorkers,0);
+  std::vector<Int_t> nWorkerEvents(nWorkers);
+  for (Int_t w = 0; w<nWorkers; w++)
+  {
+    AliGlauberMC *mc = new AliGlauberMC(fANucleus.GetName(),fBNucleus.GetName(),fXSect);
+    mc->fANucleus.SetR(fANucleus.GetR());
+    mc->fANucleus.SetA(fANucleus.GetA());
+    mc->fANucleus.SetW(fANucleus.GetW());
+    mc->fANucleus.SetMinDist(fANucleus.GetMinDist());
+    mc->fBNucleus.SetR(fBNucleus.GetR());
+    mc->fBNucleus.SetA(fBNucleus.GetA());
+    mc->fBNucleus.SetW(fBNucleus.GetW());
+    mc->fBNucleus.SetMinDist(fBNucleus.GetMinDist());
+    mc->fANucleus.AllocateNucleons();
+    mc->fBNucleus.AllocateNucleons();
+    mc->fBMin = fBMin;
+    mc->fBMax = fBMax;
+    memcpy(mc->fdNdEtaParam,fdNdEtaParam,sizeof(fdNdEtaParam));
+    mc->fMultType = fMultType;
+    mc->fX = fX;
+    mc->fNpp = fNpp;
+    mc->fDoPartProd = fDoPartProd;
+    mc->fDoFluc = fDoFluc;
+    mc->fOmega = fOmega;
+    mc->fSig0 = fSig0;
+    mc->fLambda = fLambda;
+    generators[w] = new TRandom3(seed+w);
+    mc->SetRandom(generators[w]);
+    workers[w] = mc;
+    nWorkerEvents[w] = nevents/nWorkers + (w < nevents%nWorkers ? 1 : 0);
+    rows[w].reserve(nWorkerEvents[w]*kNtupleVars);
+  }
+
+#if __cplusplus >= 201103L
+  std::vector<std::thread> threads;
+  for (Int_t w = 0; w<nWorkers; w++)
+    threads.push_back(std::thread(&AliGlauberMC::RunWorker,workers[w],nWorkerEvents[w],&rows[w],&discarded[w]));
+  for (UInt_t t = 0; t<threads.size(); t++) threads[t].join();
+#else
+  for (Int_t w = 0; w<nWorkers; w++)
+    workers[w]->RunWorker(nWorkerEvents[w],&rows[w],&discarded[w]);
+#endif
+
+  //merge
+  Int_t q = 0;
+  Int_t u = 0;
+  for (Int_t w = 0; w<nWorkers; w++)
+  {
+    Int_t nrows = rows[w].size()/kNtupleVars;
+    for (Int_t r = 0; r<nrows; r++) fnt->Fill(&rows[w][r*kNtupleVars]);
+    q += nrows;
+    u += discarded[w];
+    fEvents += workers[w]->fEvents;
+    fTotalEvents += workers[w]->fTotalEvents;
+    if (workers[w]->fMaxNpartFound > fMaxNpartFound) fMaxNpartFound = workers[w]->fMaxNpartFound;
+    delete workers[w];
+    delete generators[w];
+  }
+  std::cout << "Generating Event # " << nevents << "... \r" << endl << "Done! Succesfull events:  " << q << "  discarded events:  " << u <<"."<< endl;
+}
+
+//______________________________________________________________________________
+void AliGlauberMC::RunWorker(Int_t nevents, std::vector<Float_t>* rows, Int_t* nDiscarded)
+{
+  //generate nevents events and append the ntuple rows to rows (worker thread of RunParallel)
+  Float_t v[kNtupleVars];
+  for (Int_t i = 0; i<nevents; i++)
+  {
+    if(!NextEvent())
+    {
+      (*nDiscarded)++;
+      continue;
+    }
+    FillNtupleRow(v);
+    rows->insert(rows->end(),v,v+kNtupleVars);
+  }
+}
+
+//______________________________________________________________________________
+void AliGlauberMC::FillNtupleRow(Float_t* v)
+{
+  //ntuple row of the current event
+  v[0]  = GetNpart();
+  v[1]  = GetNcoll();
+  v[2]  = fBMC;
+  v[3]  = fMeanXParts;
+  v[4]  = fMeanYParts;
+  v[5]  = fMeanX2Parts;
+  v[6]  = fMeanY2Parts;
+  v[7]  = fMeanXYParts;
+  v[8]  = fSx2Parts;
+  v[9]  = fSy2Parts;
+  v[10] = fSxyParts;
+  v[11] = fMeanXSystem;
+  v[12] = fMeanYSystem;
+  v[13] = fMeanXA;
+  v[14] = fMeanYA;
+  v[15] = fMeanXB;
+  v[16] = fMeanYB;
+  v[17] = GetEccentricity();
+  v[18] = GetStoa();
+  v[19] = GetEccentricityColl();
+  v[20] = GetEccentricityCom();
+  v[21] = GetEccentricityPart();
+  v[22] = GetEccentricityPartColl();
+  v[23] = GetEccentricityPartCom();
+  if (fDoPartProd)
+  {
+    v[24] = GetdNdEta();
+    v[25] = GetdNdEta();
+    v[26] = v[24]+v[25];
+  }
+  else
+  {
+    v[24] = 0;
+    v[25] = 0;
+    v[26] = 0;
+  }
+  v[27]=fXSect;
+
+  Float_t mytAA=-999;
+  if (GetNcoll()>0) mytAA=GetNcoll()/fXSect;
+  v[28]=mytAA;
+  //_____________epsilon2,3,4,4_______
+  v[29] = GetEpsilon2Part();
+  v[30] = GetEpsilon3Part();
+  v[31] = GetEpsilon4Part();
+  v[32] = GetEpsilon5Part();
+  v[33] = GetEpsilon2Coll();
+  v[34] = GetEpsilon3Coll();
+  v[35] = GetEpsilon4Coll();
+  v[36] = GetEpsilon5Coll();
+  v[37] = GetEpsilon2Com();
+  v[38] = GetEpsilon3Com();
+  v[39] = GetEpsilon4Com();
+  v[40] = GetEpsilon5Com();
+  v[41] = GetPsi2();
+  v[42] = GetPsi3();
+  v[43] = GetPsi4();
+  v[44] = GetPsi5();
+  v[45] = fBNN;
+  v[46] = fXSect;
+  v[47] = fNcollw;
+}
+
 //---------------------------------------------------------------------------------
 void AliGlauberMC::RunAndSaveNtuple( Int_t n,
                                      const Option_t *sysA,
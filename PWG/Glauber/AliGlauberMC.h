@@ -16,9 +16,12 @@
 #include "AliGlauberNucleus.h"
 #include <Riostream.h>
 #include <TNamed.h>
+#include <TArrayD.h>
+#include <vector>
 
 class TObjArray;
 class TNtuple;
+class TRandom;
 
 using std::cout;
 using std::endl;
@@ -100,6 +103,11 @@ public:
    void   Seta(Double_t a)  {fANucleus.SetA(a); fBNucleus.SetA(a);}
    void   SetDoFluc(Double_t omega, Double_t sig0, Double_t lam, Bool_t on=kTRUE) 
             {fDoFluc=on;fOmega=omega;fSig0=sig0;fLambda=lam;}
+   void   SetNThreads(Int_t n)        {fNThreads = n;}
+   void   SetSeed(UInt_t seed)        {fSeed = seed;}
+   Int_t  GetNThreads()         const {return fNThreads;}
+   UInt_t GetSeed()             const {return fSeed;}
+   void   SetRandom(TRandom* rnd);
    static void       PrintVersion()         {cout << "AliGlauberMC " << Version() << endl;}
    static const char *Version()             {return "v1.2";}
    static void       RunAndSaveNtuple( Int_t n,
@@ -119,6 +127,7 @@ public:
                             const char *fname);
    
 private:
+   enum { kNtupleVars = 48 };    //number of ntuple columns filled by Run
    AliGlauberNucleus fANucleus;       //Nucleus A
    AliGlauberNucleus fBNucleus;       //Nucleus B
    Double_t     fXSect;          //Nucleon-nucleon cross section
@@ -251,9 +260,24 @@ private:
    Double_t     fSig0;           //regularization parameter 
    Double_t     fLambda;         //lambda parameter
    TF1         *fSigFluc;        //!parameterization for fluctuating sigNN
+   Int_t        fNThreads;       //number of threads used by Run (<=1: serial)
+   UInt_t       fSeed;           //seed of the worker generators in Run (0: taken from gRandom)
+   TRandom     *fRandom;         //!generator used instead of gRandom (not owned)
+   TArrayD      fSigFlucX;       //!tabulated fSigFluc (used with fRandom)
+   TArrayD      fSigFlucCDF;     //!cumulative fSigFluc at fSigFlucX (used with fRandom)
+   std::vector<Int_t> fGridCellStart; //!first entry of each transverse grid cell in fGridIndex
+   std::vector<Int_t> fGridIndex;     //!nucleons of A sorted by grid cell
+   std::vector<Int_t> fGridCandidates;//!nucleons of A close to the current nucleon of B
    Bool_t       CalcResults(Double_t bgen);
+   void         CalcCollisions(Double_t& bNN, Double_t& nco, Double_t& ncohc);
+   void         MakeSigFluc();
+   void         FillNtupleRow(Float_t* v);
+   void         RunSerial(Int_t nevents);
+   void         RunParallel(Int_t nevents);
+   void         RunWorker(Int_t nevents, std::vector<Float_t>* rows, Int_t* nDiscarded);
+   TRandom*     GetRandom() const;
 
-   ClassDef(AliGlauberMC,4)
+   ClassDef(AliGlauberMC,5)
 };
 
 #endif
@@ -49,7 +49,10 @@ AliGlauberNucleus::AliGlauberNucleus(Option_t* iname, Int_t iN, Double_t iR, Dou
   fF(0),
   fTrials(0),
   fFunction(ifunc),
-  fNucleons(NULL)
+  fNucleons(NULL),
+  fRandom(NULL),
+  fRadiusX(),
+  fRadiusCDF()
 {
    if (fN==0) {
       cout << "Setting up nucleus " << iname << endl;
@@ -77,7 +80,10 @@ AliGlauberNucleus::AliGlauberNucleus(const AliGlauberNucleus& in):
   fF(in.fF),
   fTrials(in.fTrials),
   fFunction(in.fFunction),
-  fNucleons(NULL)
+  fNucleons(NULL),
+  fRandom(NULL),
+  fRadiusX(),
+  fRadiusCDF()
 {
   //copy ctor
   if (in.fNucleons)
@@ -189,6 +195,7 @@ void AliGlauberNucleus::SetR(Double_t ir)
          fFunction->SetParameter(0,fR);
          break;
    }
+   if (fRandom) TabulateCDF(fFunction,fRadiusX,fRadiusCDF);
 }
 
 //______________________________________________________________________________
@@ -206,6 +213,7 @@ void AliGlauberNucleus::SetA(Double_t ia)
          fFunction->SetParameter(1,fA);
          break;
    }
+   if (fRandom) TabulateCDF(fFunction,fRadiusX,fRadiusCDF);
 }
 
 //______________________________________________________________________________
@@ -223,19 +231,79 @@ void AliGlauberNucleus::SetW(Double_t iw)
          fFunction->SetParameter(2,fW);
          break;
    }
+   if (fRandom) TabulateCDF(fFunction,fRadiusX,fRadiusCDF);
+}
+
+//______________________________________________________________________________
+void AliGlauberNucleus::SetRandom(TRandom* rnd)
+{
+   // Use rnd instead of gRandom; rho(r) is then sampled from a table instead
+   // of TF1::GetRandom (which always uses gRandom), so that nuclei with
+   // different generators can be thrown in parallel. NULL restores the default.
+   fRandom = rnd;
+   if (fRandom && fFunction) TabulateCDF(fFunction,fRadiusX,fRadiusCDF);
+}
+
+//______________________________________________________________________________
+void AliGlauberNucleus::AllocateNucleons()
+{
+   // Create the nucleons if not done yet
+   if (fNucleons) return;
+   fNucleons=new TObjArray(fN);
+   fNucleons->SetOwner();
+   for(Int_t i=0;i<fN;i++) {
+      AliGlauberNucleon *nucleon=new AliGlauberNucleon(); 
+      fNucleons->Add(nucleon); 
+   }
+}
+
+//______________________________________________________________________________
+Double_t AliGlauberNucleus::GetRandomRadius()
+{
+   // Random radius distributed according to rho(r)
+   if (!fRandom) return fFunction->GetRandom();
+   return GetRandomFromCDF(fRadiusX,fRadiusCDF,fRandom);
+}
+
+//______________________________________________________________________________
+void AliGlauberNucleus::TabulateCDF(TF1* f, TArrayD& x, TArrayD& cdf, Int_t npx)
+{
+   // Tabulate the cumulative integral of f in npx steps over its range
+   Double_t xmin = f->GetXmin();
+   Double_t xmax = f->GetXmax();
+   Double_t dx = (xmax-xmin)/npx;
+   x.Set(npx+1);
+   cdf.Set(npx+1);
+   x[0] = xmin;
+   cdf[0] = 0;
+   Double_t fprev = TMath::Max(f->Eval(xmin),0.);
+   for (Int_t i=1; i<=npx; i++) {
+      x[i] = xmin+i*dx;
+      Double_t fcur = TMath::Max(f->Eval(x[i]),0.);
+      cdf[i] = cdf[i-1]+0.5*(fprev+fcur)*dx;
+      fprev = fcur;
+   }
+}
+
+//______________________________________________________________________________
+Double_t AliGlauberNucleus::GetRandomFromCDF(const TArrayD& x, const TArrayD& cdf, TRandom* rnd)
+{
+   // Inverse-transform sampling with linear interpolation of a table from TabulateCDF
+   Int_t n = cdf.GetSize();
+   Double_t u = rnd->Rndm()*cdf[n-1];
+   Int_t i = TMath::BinarySearch(n,cdf.GetArray(),u);
+   if (i<0) i=0;
+   if (i>=n-1) return x[n-1];
+   Double_t dc = cdf[i+1]-cdf[i];
+   if (dc<=0) return x[i];
+   return x[i]+(x[i+1]-x[i])*(u-cdf[i])/dc;
 }
 
 //______________________________________________________________________________
 void AliGlauberNucleus::ThrowNucleons(Double_t xshift)
 {
-   if (fNucleons==0) {
-      fNucleons=new TObjArray(fN);
-      fNucleons->SetOwner();
-      for(Int_t i=0;i<fN;i++) {
-	 AliGlauberNucleon *nucleon=new AliGlauberNucleon(); 
-	 fNucleons->Add(nucleon); 
-      }
-   } 
+   AllocateNucleons();
+   TRandom *rnd = fRandom ? fRandom : gRandom;
    
    fTrials = 0;
 
@@ -246,9 +314,9 @@ void AliGlauberNucleus::ThrowNucleons(Double_t xshift)
    Bool_t hulthen = (TString(GetName())=="dh");
    if (fN==2 && hulthen) { //special treatmeant for Hulten
 
-      Double_t r = fFunction->GetRandom()/2;
-      Double_t phi = gRandom->Rndm() * 2 * TMath::Pi() ;
-      Double_t ctheta = 2*gRandom->Rndm() - 1 ;
+      Double_t r = GetRandomRadius()/2;
+      Double_t phi = rnd->Rndm() * 2 * TMath::Pi() ;
+      Double_t ctheta = 2*rnd->Rndm() - 1 ;
       Double_t stheta = sqrt(1-ctheta*ctheta);
      
       AliGlauberNucleon *nucleon1=(AliGlauberNucleon*)(fNucleons->UncheckedAt(0));
@@ -270,9 +338,9 @@ void AliGlauberNucleus::ThrowNucleons(Double_t xshift)
       nucleon->Reset();
       while(1) {
          fTrials++;
-         Double_t r = fFunction->GetRandom();
-         Double_t phi = gRandom->Rndm() * 2 * TMath::Pi() ;
-         Double_t ctheta = 2*gRandom->Rndm() - 1 ;
+         Double_t r = GetRandomRadius();
+         Double_t phi = rnd->Rndm() * 2 * TMath::Pi() ;
+         Double_t ctheta = 2*rnd->Rndm() - 1 ;
          Double_t stheta = TMath::Sqrt(1-ctheta*ctheta);
          Double_t x = r * stheta * cos(phi) + xshift;
          Double_t y = r * stheta * sin(phi);      
@@ -16,8 +16,10 @@
 
 //class TNamed;
 #include <TNamed.h>
+#include <TArrayD.h>
 class TObjArray;
 class TF1;
+class TRandom;
 
 class AliGlauberNucleus : public TNamed {
 private:
@@ -30,8 +32,12 @@ private:
    Int_t      fTrials;     //Store trials needed to complete nucleus
    TF1*       fFunction;   //Probability density function rho(r)
    TObjArray* fNucleons;   //Array of nucleons
+   TRandom*   fRandom;     //!Random generator used instead of gRandom (not owned)
+   TArrayD    fRadiusX;    //!Radii of the tabulated rho(r) (used with fRandom)
+   TArrayD    fRadiusCDF;  //!Cumulative rho(r) at fRadiusX (used with fRandom)
 
    void       Lookup(Option_t* name);
+   Double_t   GetRandomRadius();
 
 public:
    AliGlauberNucleus(Option_t* iname="Au", Int_t iN=0, Double_t iR=0, Double_t ia=0, Double_t iw=0, TF1* ifunc=0);
@@ -45,6 +51,7 @@ public:
    Double_t   GetR()             const {return fR;}
    Double_t   GetA()             const {return fA;}
    Double_t   GetW()             const {return fW;}
+   Double_t   GetMinDist()       const {return fMinDist;}
    TObjArray *GetNucleons()      const {return fNucleons;}
    Int_t      GetTrials()        const {return fTrials;}
    void       SetN(Int_t in)           {fN=in;}
@@ -52,8 +59,13 @@ public:
    void       SetA(Double_t ia);
    void       SetW(Double_t iw);
    void       SetMinDist(Double_t min) {fMinDist=min;}
+   void       SetRandom(TRandom* rnd);
+   void       AllocateNucleons();
    void       ThrowNucleons(Double_t xshift=0.);
 
+   static void     TabulateCDF(TF1* f, TArrayD& x, TArrayD& cdf, Int_t npx=1000);
+   static Double_t GetRandomFromCDF(const TArrayD& x, const TArrayD& cdf, TRandom* rnd);
+
    ClassDef(AliGlauberNucleus,1)
 };
 
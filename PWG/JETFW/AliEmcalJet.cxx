@@ -62,7 +62,9 @@ AliEmcalJet::AliEmcalJet() :
   fHasGhost(kFALSE),
   fGhosts(),
   fJetShapeProperties(0),
-  fJetAcceptanceType(0)
+  fJetAcceptanceType(0),
+  fPtSortedTrackIndexes(),
+  fPtSortedTrackArray(0)
 {
   fClosestJets[0] = 0;
   fClosestJets[1] = 0;
@@ -112,7 +114,9 @@ AliEmcalJet::AliEmcalJet(Double_t px, Double_t py, Double_t pz) :
   fHasGhost(kFALSE),
   fGhosts(),
   fJetShapeProperties(0),
-  fJetAcceptanceType(0)
+  fJetAcceptanceType(0),
+  fPtSortedTrackIndexes(),
+  fPtSortedTrackArray(0)
 {
   if (fPt != 0) {
     fPhi = TVector2::Phi_0_2pi(TMath::ATan2(py, px));
@@ -167,7 +171,9 @@ AliEmcalJet::AliEmcalJet(Double_t pt, Double_t eta, Double_t phi, Double_t m) :
   fHasGhost(kFALSE),
   fGhosts(),
   fJetShapeProperties(0),
-  fJetAcceptanceType(0)
+  fJetAcceptanceType(0),
+  fPtSortedTrackIndexes(),
+  fPtSortedTrackArray(0)
 {
   fPhi = TVector2::Phi_0_2pi(fPhi);
 
@@ -216,7 +222,9 @@ AliEmcalJet::AliEmcalJet(const AliEmcalJet& jet) :
   fHasGhost(jet.fHasGhost),
   fGhosts(jet.fGhosts),
   fJetShapeProperties(0),
-  fJetAcceptanceType(jet.fJetAcceptanceType)
+  fJetAcceptanceType(jet.fJetAcceptanceType),
+  fPtSortedTrackIndexes(jet.fPtSortedTrackIndexes),
+  fPtSortedTrackArray(jet.fPtSortedTrackArray)
 {
   // Copy constructor.
   fClosestJets[0]     = jet.fClosestJets[0];
@@ -285,6 +293,8 @@ AliEmcalJet& AliEmcalJet::operator=(const AliEmcalJet& jet)
       fJetShapeProperties = new AliEmcalJetShapeProperties(*(jet.fJetShapeProperties));
     }
     fJetAcceptanceType  = jet.fJetAcceptanceType;
+    fPtSortedTrackIndexes = jet.fPtSortedTrackIndexes;
+    fPtSortedTrackArray   = jet.fPtSortedTrackArray;
   }
 
   return *this;
@@ -380,6 +390,8 @@ void AliEmcalJet::SortConstituents()
 {
   std::sort(fClusterIDs.GetArray(), fClusterIDs.GetArray() + fClusterIDs.GetSize());
   std::sort(fTrackIDs.GetArray(), fTrackIDs.GetArray() + fTrackIDs.GetSize());
+  // Positions of the track constituents changed
+  fPtSortedTrackIndexes.clear();
 }
 
 /**
@@ -398,6 +410,10 @@ Double_t AliEmcalJet::DeltaR(const AliVParticle* part) const
 /**
  * Sorting jet constituents by pT (decreasing)  
  * It returns a standard vector with the indexes of the constituents relative to fTrackIDs.
+ * If the pT order was provided by the jet finder (see SetTrackConstituentPt()) and all
+ * track constituents were drawn from the array passed, it is returned directly, without
+ * accessing the tracks. Otherwise the tracks are retrieved from the array and sorted,
+ * skipping the ones which cannot be found.
  * To retrieve the track do:
  * ~~~{.cxx}
  * TClonesArray* fTracksContArray = jetCont->GetParticleContainer()->GetArray();
@@ -412,6 +428,8 @@ Double_t AliEmcalJet::DeltaR(const AliVParticle* part) const
  */
 std::vector<int> AliEmcalJet::GetPtSortedTrackConstituentIndexes(TClonesArray* tracks) const
 {
+  if (tracks && tracks == fPtSortedTrackArray && HasPtSortedTrackConstituents()) return std::vector<int>(fPtSortedTrackIndexes.begin(), fPtSortedTrackIndexes.end());
+
   typedef std::pair<Double_t, Int_t> ptidx_pair;
 
   // Create vector for Pt sorting
@@ -437,6 +455,114 @@ std::vector<int> AliEmcalJet::GetPtSortedTrackConstituentIndexes(TClonesArray* t
   return index_sorted_list;
 }
 
+/**
+ * Store the pT order of the track constituents, such that it does not need to be
+ * determined again from the tracks each time it is requested. Must be called after
+ * all track constituents have been added and sorted (SortConstituents()). The order
+ * is the same as obtained in GetPtSortedTrackConstituentIndexes(TClonesArray*),
+ * i.e. constituents with equal pT remain ordered by their position in fTrackIDs.
+ * The array the track constituents are drawn from is recorded as well, if it is the
+ * same for all of them; GetPtSortedTrackConstituentIndexes(TClonesArray*) only uses
+ * the stored order for this array.
+ * @param ptids Pairs of pT and (global) index of the track constituents. The vector is modified (sorted).
+ */
+void AliEmcalJet::SetTrackConstituentPt(std::vector<std::pair<Double_t, Int_t> > &ptids)
+{
+  fPtSortedTrackIndexes.clear();
+  fPtSortedTrackArray = 0;
+  if (ptids.size() != (UInt_t)fTrackIDs.GetSize()) {
+    AliError(Form("Number of pT values (%lu) does not match the number of track constituents (%d)", ptids.size(), fTrackIDs.GetSize()));
+    return;
+  }
+
+  // Array of the track constituents, if they all come from the same one
+  const AliEmcalContainerIndexMap<TClonesArray, AliVParticle> &indexMap = AliParticleContainer::GetEmcalContainerIndexMap();
+  const TClonesArray *array = 0;
+  for (UInt_t i = 0; i < ptids.size(); i++) {
+    const TClonesArray *trackArray = indexMap.LocalIndexFromGlobalIndex(ptids[i].second).second;
+    if (i == 0) {
+      array = trackArray;
+    }
+    else if (trackArray != array) {
+      array = 0;
+      break;
+    }
+  }
+
+  // Replace the global index by the position in fTrackIDs (sorted by index)
+  const Int_t *first = fTrackIDs.GetArray(), *last = fTrackIDs.GetArray() + fTrackIDs.GetSize();
+  for (auto &ptid : ptids) {
+    const Int_t *pos = std::lower_bound(first, last, ptid.second);
+    if (pos == last || *pos != ptid.second) {
+      AliError(Form("Track %d is not a constituent of the jet", ptid.second));
+      return;
+    }
+    ptid.second = pos - first;
+  }
+
+  std::sort(ptids.begin(), ptids.end(), [](const std::pair<Double_t, Int_t> &p1, const std::pair<Double_t, Int_t> &p2) { return p1.second < p2.second; });
+  std::stable_sort(ptids.begin(), ptids.end(), sort_descend());
+
+  fPtSortedTrackIndexes.reserve(ptids.size());
+  for (auto ptid : ptids) fPtSortedTrackIndexes.push_back(ptid.second);
+  fPtSortedTrackArray = array;
+}
+
+/**
+ * Get the positions of the track constituents in fTrackIDs sorted by decreasing pT,
+ * as stored by the jet finder. The span is empty if the order is not available
+ * (e.g. jets read from file), in which case GetPtSortedTrackConstituentIndexes(TClonesArray*)
+ * has to be used.
+ * @return View on the pT-sorted positions of the track constituents
+ */
+AliEmcalJet::ConstituentIndexSpan AliEmcalJet::GetPtSortedTrackConstituentPositions() const
+{
+  if (!HasPtSortedTrackConstituents()) return ConstituentIndexSpan();
+  return ConstituentIndexSpan(fPtSortedTrackIndexes.data(), fPtSortedTrackIndexes.data() + fPtSortedTrackIndexes.size());
+}
+
+/**
+ * Retrieve all track constituents in one go. The objects are taken directly from the
+ * arrays registered in the global index map, without going through TrackAt(Int_t, TClonesArray*).
+ * @param[out] tracks Vector filled with the track constituents (cleared first)
+ * @param[in] ptsorted If true the constituents are ordered by decreasing pT (requires the pT order from the jet finder, otherwise index order is used)
+ * @return Number of track constituents retrieved
+ */
+UInt_t AliEmcalJet::GetTrackConstituents(std::vector<AliVParticle*> &tracks, Bool_t ptsorted) const
+{
+  tracks.clear();
+  tracks.reserve(fTrackIDs.GetSize());
+  const AliEmcalContainerIndexMap<TClonesArray, AliVParticle> &indexMap = AliParticleContainer::GetEmcalContainerIndexMap();
+  Bool_t usePtOrder = ptsorted && HasPtSortedTrackConstituents();
+  for (Int_t i = 0; i < fTrackIDs.GetSize(); i++) {
+    auto res = indexMap.LocalIndexFromGlobalIndex(fTrackIDs.GetArray()[usePtOrder ? fPtSortedTrackIndexes[i] : i]);
+    if (res.first < 0 || res.first >= res.second->GetEntriesFast()) continue;
+    AliVParticle *track = static_cast<AliVParticle*>(res.second->UncheckedAt(res.first));
+    if (track) tracks.push_back(track);
+  }
+  return tracks.size();
+}
+
+/**
+ * Retrieve all cluster constituents in one go (ordered by index). The objects are taken directly
+ * from the arrays registered in the global index map.
+ * @param[out] clusters Vector filled with the cluster constituents (cleared first)
+ * @return Number of cluster constituents retrieved
+ */
+UInt_t AliEmcalJet::GetClusterConstituents(std::vector<AliVCluster*> &clusters) const
+{
+  clusters.clear();
+  clusters.reserve(fClusterIDs.GetSize());
+  const AliEmcalContainerIndexMap<TClonesArray, AliVCluster> &indexMap = AliClusterContainer::GetEmcalContainerIndexMap();
+  for (Int_t i = 0; i < fClusterIDs.GetSize(); i++) {
+    auto res = indexMap.LocalIndexFromGlobalIndex(fClusterIDs.GetArray()[i]);
+    if (res.first < 0 || res.first >= res.second->GetEntriesFast()) continue;
+    AliVCluster *cluster = static_cast<AliVCluster*>(res.second->UncheckedAt(res.first));
+    if (cluster) clusters.push_back(cluster);
+  }
+  return clusters.size();
+}
+
 /**
  * Get the momentum fraction of a jet constituent
  * @param trkPx First transverse component of the momentum of the jet constituent
@@ -662,6 +788,7 @@ void AliEmcalJet::Clear(Option_t */*option*/)
 {
   fClusterIDs.Set(0);
   fTrackIDs.Set(0);
+  fPtSortedTrackIndexes.clear();
   fClosestJets[0] = 0;
   fClosestJets[1] = 0;
   fClosestJetsDist[0] = 0;
@@ -44,6 +44,26 @@
 class AliEmcalJet : public AliVParticle
 {
  public:
+
+  /**
+   * @class ConstituentIndexSpan
+   * @brief Lightweight view on a contiguous block of constituent indices
+   *
+   * Allows iterating over the constituent indices stored in the jet (e.g. in a range-based for loop)
+   * without copying them. The span is only valid as long as the constituents of the jet are not modified.
+   */
+  class ConstituentIndexSpan {
+  public:
+    ConstituentIndexSpan(const Int_t *first = 0, const Int_t *last = 0) : fBegin(first), fEnd(last) {}
+    const Int_t    *begin()                  const { return fBegin           ; }
+    const Int_t    *end()                    const { return fEnd             ; }
+    UInt_t          size()                   const { return fEnd - fBegin    ; }
+    Bool_t          empty()                  const { return fEnd == fBegin   ; }
+    Int_t           operator[](UInt_t i)     const { return fBegin[i]        ; }
+  private:
+    const Int_t    *fBegin;               ///< First element of the span
+    const Int_t    *fEnd;                 ///< One past the last element of the span
+  };
   
   /**
    * @enum JetAcceptanceType
@@ -192,7 +212,7 @@ class AliEmcalJet : public AliVParticle
   void              SetMaxChargedPt(Double32_t t)      { fMaxCPt  = t;                     }
   void              SetNEF(Double_t nef)               { fNEF     = nef;                   }
   void              SetNumberOfClusters(Int_t n)       { fClusterIDs.Set(n);               }
-  void              SetNumberOfTracks(Int_t n)         { fTrackIDs.Set(n);                 }
+  void              SetNumberOfTracks(Int_t n)         { fTrackIDs.Set(n); fPtSortedTrackIndexes.clear(); }
   void              SetNumberOfCharged(Int_t n)        { fNch = n;                         }
   void              SetNumberOfNeutrals(Int_t n)       { fNn = n;                          }
   void              SetMCPt(Double_t p)                { fMCPt = p;                        }
@@ -201,12 +221,21 @@ class AliEmcalJet : public AliVParticle
   void              SetPtSub(Double_t ps)              { fPtSub          = ps;             }
   void              SetPtSubVect(Double_t ps)          { fPtSubVect      = ps;             }
   void              AddClusterAt(Int_t clus, Int_t idx){ fClusterIDs.AddAt(clus, idx);     }
-  void              AddTrackAt(Int_t track, Int_t idx) { fTrackIDs.AddAt(track, idx);      }
+  void              AddTrackAt(Int_t track, Int_t idx) { fTrackIDs.AddAt(track, idx); fPtSortedTrackIndexes.clear(); }
   void              Clear(Option_t */*option*/="");
 
   // Sorting methods
   void              SortConstituents();
   std::vector<int>  GetPtSortedTrackConstituentIndexes(TClonesArray *tracks) const;
+  void              SetTrackConstituentPt(std::vector<std::pair<Double_t, Int_t> > &ptids);
+  Bool_t            HasPtSortedTrackConstituents()                const { return fTrackIDs.GetSize() > 0 && fPtSortedTrackIndexes.size() == (UInt_t)fTrackIDs.GetSize(); }
+
+  // Bulk access to constituents
+  ConstituentIndexSpan GetTrackConstituentIDs()                   const { return ConstituentIndexSpan(fTrackIDs.GetArray(), fTrackIDs.GetArray() + fTrackIDs.GetSize()); }
+  ConstituentIndexSpan GetClusterConstituentIDs()                 const { return ConstituentIndexSpan(fClusterIDs.GetArray(), fClusterIDs.GetArray() + fClusterIDs.GetSize()); }
+  ConstituentIndexSpan GetPtSortedTrackConstituentPositions()     const;
+  UInt_t            GetTrackConstituents(std::vector<AliVParticle*> &tracks, Bool_t ptsorted = kFALSE) const;
+  UInt_t            GetClusterConstituents(std::vector<AliVCluster*> &clusters) const;
 
   // Trigger
   Bool_t            IsTriggerJet(UInt_t trigger=AliVEvent::kEMCEJE) const   { return (Bool_t)((fTriggers & trigger) != 0); }
@@ -313,6 +342,8 @@ class AliEmcalJet : public AliVParticle
 
   AliEmcalJetShapeProperties *fJetShapeProperties; //!<! Pointer to the jet shape properties
   UInt_t fJetAcceptanceType;    //!<!  Jet acceptance type (stored bitwise)
+  std::vector<Int_t> fPtSortedTrackIndexes; //!<! Positions of the track constituents in fTrackIDs, sorted by decreasing pT (filled by the jet finder)
+  const TClonesArray *fPtSortedTrackArray;  //!<! Array of all the track constituents when fPtSortedTrackIndexes was filled (0 if they come from several arrays)
 
  private:
   /**
@@ -28,6 +28,7 @@
 // the derivation from THnSparse is obviously against many OO rules. correct would be a common baseclass of THnSparse and THn.
 //
 // Templated version allows also the use of double as storage container
+// or of a paged storage (AliTHnPagedArrayT) where only the pages which have been written to are allocated
 // 
 // Author: Jan Fiete Grosse-Oetringhaus
 
@@ -39,8 +40,86 @@
 #include "TArrayD.h"
 #include "THnSparse.h"
 #include "TMath.h"
+#include "TBuffer.h"
 
 templateClassImp(AliTHnT)
+templateClassImp(AliTHnPagedArrayT)
+
+namespace
+{
+  // access to the storage arrays of AliTHnT
+  // dense arrays (TArrayF, TArrayD) are accessed directly, AliTHnPagedArrayT page-wise
+  
+  template <class TemplateArray>
+  inline Double_t StorageGet(const TemplateArray* array, Long64_t bin) { return array->GetArray()[bin]; }
+  template <typename TemplateType>
+  inline Double_t StorageGet(const AliTHnPagedArrayT<TemplateType>* array, Long64_t bin) { return array->At(bin); }
+
+  template <class TemplateArray>
+  inline void StorageSet(TemplateArray* array, Long64_t bin, Double_t value) { array->GetArray()[bin] = value; }
+  template <typename TemplateType>
+  inline void StorageSet(AliTHnPagedArrayT<TemplateType>* array, Long64_t bin, Double_t value) { array->SetBin(bin, value); }
+
+  template <class TemplateArray>
+  inline void StorageAdd(TemplateArray* array, Long64_t bin, Double_t weight) { array->GetArray()[bin] += weight; }
+  template <typename TemplateType>
+  inline void StorageAdd(AliTHnPagedArrayT<TemplateType>* array, Long64_t bin, Double_t weight) { array->AddBin(bin, weight); }
+  
+  // returns the first bin >= <bin> which can be non-0 (skips pages which are not allocated)
+  template <class TemplateArray>
+  inline Long64_t StorageNextFilledBin(const TemplateArray*, Long64_t bin) { return bin; }
+  template <typename TemplateType>
+  inline Long64_t StorageNextFilledBin(const AliTHnPagedArrayT<TemplateType>* array, Long64_t bin)
+  {
+    const Int_t pageSize = AliTHnPagedArrayT<TemplateType>::fgkPageSize;
+    Int_t page = bin / pageSize;
+    while (page < array->GetNPages() && !array->GetPage(page))
+    {
+      page++;
+      bin = (Long64_t) page * pageSize;
+    }
+    return bin;
+  }
+  
+  // target += source (both have <nBins> entries)
+  template <class TemplateArray>
+  inline void StorageAddArray(TemplateArray* target, const TemplateArray* source, Long64_t nBins)
+  {
+    for (Long64_t l = 0; l<nBins; l++)
+      target->GetArray()[l] += source->GetArray()[l];
+  }
+  template <typename TemplateType>
+  inline void StorageAddArray(AliTHnPagedArrayT<TemplateType>* target, const AliTHnPagedArrayT<TemplateType>* source, Long64_t)
+  {
+    const Int_t pageSize = AliTHnPagedArrayT<TemplateType>::fgkPageSize;
+    for (Int_t p=0; p<source->GetNPages(); p++)
+    {
+      const TemplateType* sourcePage = source->GetPage(p);
+      if (!sourcePage)
+	continue;
+      TemplateType* targetPage = target->GetPageForWrite(p);
+      for (Int_t l=0; l<pageSize; l++)
+	targetPage[l] += sourcePage[l];
+    }
+  }
+  
+  // target[offset...offset+n] += source[0...n]
+  template <class TemplateArray, typename TemplateType>
+  inline void StorageAddRange(TemplateArray* target, Long64_t offset, const TemplateType* source, Long64_t n)
+  {
+    TemplateType* targetArray = target->GetArray() + offset;
+    for (Long64_t l=0; l<n; l++)
+      targetArray[l] += source[l];
+  }
+  template <typename TemplateType>
+  inline void StorageAddRange(AliTHnPagedArrayT<TemplateType>* target, Long64_t offset, const TemplateType* source, Long64_t n)
+  {
+    // do not allocate pages for empty bins
+    for (Long64_t l=0; l<n; l++)
+      if (source[l] != 0)
+	target->AddBin(offset + l, source[l]);
+  }
+}
 
 template <class TemplateArray, typename TemplateType>
 AliTHnT<TemplateArray, TemplateType>::AliTHnT() : 
@@ -53,7 +132,9 @@ AliTHnT<TemplateArray, TemplateType>::AliTHnT() :
   axisCache(0),
   fNbinsCache(0),
   fLastVars(0),
-  fLastBins(0)
+  fLastBins(0),
+  fNShards(0),
+  fShards(0)
 {
   // Constructor
 }
@@ -69,7 +150,9 @@ AliTHnT<TemplateArray, TemplateType>::AliTHnT(const Char_t* name, const Char_t*
   axisCache(0),
   fNbinsCache(0),
   fLastVars(0),
-  fLastBins(0)
+  fLastBins(0),
+  fNShards(0),
+  fShards(0)
 {
   // Constructor
 
@@ -106,12 +189,17 @@ AliTHnT<TemplateArray, TemplateType>::AliTHnT(const AliTHnT &c) :
   axisCache(0),
   fNbinsCache(0),
   fLastVars(0),
-  fLastBins(0)
+  fLastBins(0),
+  fNShards(0),
+  fShards(0)
 {
   //
   // AliTHnT copy constructor
   //
 
+  // entries in shards are part of the content
+  const_cast<AliTHnT&>(c).MergeShards();
+
   memset(fValues,0,fNSteps*sizeof(TemplateArray*));
   memset(fSumw2,0,fNSteps*sizeof(TemplateArray*));
 
@@ -128,6 +216,7 @@ AliTHnT<TemplateArray, TemplateType>::~AliTHnT()
   // Destructor
   
   DeleteContainers();
+  DeleteShards();
   
   delete[] fValues;
   delete[] fSumw2;
@@ -142,6 +231,9 @@ void AliTHnT<TemplateArray, TemplateType>::DeleteContainers()
 {
   // delete data containers
   
+  for (Int_t i=0; i<fNShards; i++)
+    fShards[i]->Clear();
+  
   for (Int_t i=0; i<fNSteps; i++)
   {
     if (fValues && fValues[i])
@@ -165,6 +257,8 @@ AliTHnT<TemplateArray, TemplateType> &AliTHnT<TemplateArray, TemplateType>::oper
   // assigment operator
 
   if (this != &c) {
+    const_cast<AliTHnT&>(c).MergeShards();
+    DeleteShards();
     AliCFContainer::operator=(c);
     fNBins=c.fNBins;
     fNVars=c.fNVars;
@@ -206,6 +300,9 @@ void AliTHnT<TemplateArray, TemplateType>::Copy(TObject& c) const
 
   AliTHnT& target = (AliTHnT &) c;
   
+  // entries in shards are part of the content
+  const_cast<AliTHnT*>(this)->MergeShards();
+  
   AliCFContainer::Copy(target);
   
   target.fNSteps = fNSteps;
@@ -243,6 +340,8 @@ Long64_t AliTHnT<TemplateArray, TemplateType>::Merge(TCollection* list)
     return 1;
   
   AliCFContainer::Merge(list);
+  
+  MergeShards();
 
   TIterator* iter = list->MakeIterator();
   TObject* obj;
@@ -253,6 +352,8 @@ Long64_t AliTHnT<TemplateArray, TemplateType>::Merge(TCollection* list)
     AliTHnT* entry = dynamic_cast<AliTHnT*> (obj);
     if (entry == 0) 
       continue;
+    
+    entry->MergeShards();
 
     for (Int_t i=0; i<fNSteps; i++)
     {
@@ -261,8 +362,7 @@ Long64_t AliTHnT<TemplateArray, TemplateType>::Merge(TCollection* list)
 	if (!fValues[i])
 	  fValues[i] = new TemplateArray(fNBins);
       
-	for (Long64_t l = 0; l<fNBins; l++)
-	  fValues[i]->GetArray()[l] += entry->fValues[i]->GetArray()[l];
+	StorageAddArray(fValues[i], entry->fValues[i], fNBins);
       }
 
       if (entry->fSumw2[i])
@@ -270,8 +370,7 @@ Long64_t AliTHnT<TemplateArray, TemplateType>::Merge(TCollection* list)
 	if (!fSumw2[i])
 	  fSumw2[i] = new TemplateArray(fNBins);
       
-	for (Long64_t l = 0; l<fNBins; l++)
-	  fSumw2[i]->GetArray()[l] += entry->fSumw2[i]->GetArray()[l];
+	StorageAddArray(fSumw2[i], entry->fSumw2[i], fNBins);
       }
     }
     
@@ -286,16 +385,28 @@ void AliTHnT<TemplateArray, TemplateType>::Fill(const Double_t *var, Int_t istep
 {
   // fills an entry
 
+  Long64_t bin = GetGlobalBin(var);
+  
+  // under/overflow not supported
+  if (bin < 0)
+    return;
+  
+  AddBinContent(istep, bin, weight);
+  
+  // debug
+//   AliCFContainer::Fill(var, istep, weight);
+}
+
+template <class TemplateArray, typename TemplateType>
+Long64_t AliTHnT<TemplateArray, TemplateType>::GetGlobalBin(const Double_t *var)
+{
+  // calculates the global bin index of the entry <var>
+  // returns -1 if any of the variables is in under/overflow
+
   // fill axis cache
-  if (!axisCache)
+  if (!fLastVars)
   {
-    axisCache = new TAxis*[fNVars];
-    fNbinsCache = new Int_t[fNVars];
-    for (Int_t i=0; i<fNVars; i++)
-    {
-      axisCache[i] = GetAxis(i, 0);
-      fNbinsCache[i] = axisCache[i]->GetNbins();
-    }
+    InitAxisCache();
     
     fLastVars = new Double_t[fNVars];
     fLastBins = new Int_t[fNVars];
@@ -327,13 +438,33 @@ void AliTHnT<TemplateArray, TemplateType>::Fill(const Double_t *var, Int_t istep
 
     // under/overflow not supported
     if (tmpBin < 1 || tmpBin > fNbinsCache[i])
-      return;
+      return -1;
     
     // bins start from 0 here
     bin += tmpBin - 1;
 //     Printf("%lld", bin);
   }
+  
+  return bin;
+}
 
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::FillBins(Int_t istep, Int_t n, const Long64_t* bins, const Double_t* weights)
+{
+  // fills <n> entries given by their global bin index (see GetGlobalBin) and weight
+  // entries with a negative bin index are skipped
+  // the result is identical to calling Fill for each entry in the same order
+  
+  for (Int_t i=0; i<n; i++)
+    if (bins[i] >= 0)
+      AddBinContent(istep, bins[i], weights[i]);
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::AddBinContent(Int_t istep, Long64_t bin, Double_t weight)
+{
+  // adds <weight> to the global bin <bin> of step <istep>
+  
   if (!fValues[istep])
   {
     fValues[istep] = new TemplateArray(fNBins);
@@ -350,14 +481,165 @@ void AliTHnT<TemplateArray, TemplateType>::Fill(const Double_t *var, Int_t istep
     }
   }
 
-  fValues[istep]->GetArray()[bin] += weight;
+  StorageAdd(fValues[istep], bin, weight);
   if (fSumw2[istep])
-    fSumw2[istep]->GetArray()[bin] += weight * weight;
+    StorageAdd(fSumw2[istep], bin, weight * weight);
   
 //   Printf("%f", fValues[istep][bin]);
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::InitAxisCache()
+{
+  // caches axis pointers and number of bins per axis
   
-  // debug
-//   AliCFContainer::Fill(var, istep, weight);
+  if (fNbinsCache)
+    return;
+  
+  if (!axisCache)
+    axisCache = new TAxis*[fNVars];
+  fNbinsCache = new Int_t[fNVars];
+  for (Int_t i=0; i<fNVars; i++)
+  {
+    axisCache[i] = GetAxis(i, 0);
+    fNbinsCache[i] = axisCache[i]->GetNbins();
+  }
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::SetNShards(Int_t nShards)
+{
+  // creates <nShards> per-thread fill shards, see FillShard
+  // entries which are already in shards are merged into the container before
+  
+  MergeShards();
+  DeleteShards();
+  
+  // the axis cache is only read by FillShard, therefore it is set up here and not from the filling threads
+  InitAxisCache();
+  
+  fNShards = nShards;
+  if (fNShards <= 0)
+    return;
+  
+  fShards = new AliTHnShard<TemplateType>*[fNShards];
+  for (Int_t i=0; i<fNShards; i++)
+    fShards[i] = new AliTHnShard<TemplateType>(fNBins, fNVars, fNSteps);
+  
+  AliInfo(Form("Created %d fill shards", fNShards));
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::DeleteShards()
+{
+  // deletes the fill shards (without merging them)
+  
+  for (Int_t i=0; i<fNShards; i++)
+    delete fShards[i];
+  delete[] fShards;
+  
+  fShards = 0;
+  fNShards = 0;
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::FillShard(Int_t shard, const Double_t *var, Int_t istep, Double_t weight)
+{
+  // fills an entry into the fill shard <shard>
+  // different shards can be filled concurrently from different threads without locking: each shard has its own 
+  // storage and bin cache, the axes are only read (FindFixBin)
+  
+  if (shard < 0 || shard >= fNShards)
+  {
+    AliFatal(Form("Invalid shard %d (%d shards available, see SetNShards)", shard, fNShards));
+    return;
+  }
+  
+  AliTHnShard<TemplateType>* target = fShards[shard];
+  Double_t* lastVars = target->GetLastVars();
+  Int_t* lastBins = target->GetLastBins();
+  
+  // calculate global bin index
+  Long64_t bin = 0;
+  for (Int_t i=0; i<fNVars; i++)
+  {
+    bin *= fNbinsCache[i];
+    
+    Int_t tmpBin = 0;
+    if (lastVars[i] == var[i])
+      tmpBin = lastBins[i];
+    else
+    {
+      tmpBin = axisCache[i]->FindFixBin(var[i]);
+      lastBins[i] = tmpBin;
+      lastVars[i] = var[i];
+    }
+
+    // under/overflow not supported
+    if (tmpBin < 1 || tmpBin > fNbinsCache[i])
+      return;
+    
+    // bins start from 0 here
+    bin += tmpBin - 1;
+  }
+  
+  target->AddBinContent(istep, bin, weight);
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::MergeShards()
+{
+  // adds the content of all fill shards to the container and empties the shards
+  // must not be called while shards are filled
+  
+  const Int_t pageSize = AliTHnShard<TemplateType>::fgkPageSize;
+  
+  for (Int_t s=0; s<fNShards; s++)
+  {
+    AliTHnShard<TemplateType>* shard = fShards[s];
+    
+    for (Int_t i=0; i<fNSteps; i++)
+    {
+      Bool_t touched = kFALSE;
+      for (Int_t p=0; p<shard->GetNPages() && !touched; p++)
+	if (shard->GetValuesPage(i, p))
+	  touched = kTRUE;
+      if (!touched)
+	continue;
+      
+      if (!fValues[i])
+      {
+	fValues[i] = new TemplateArray(fNBins);
+	AliInfo(Form("Created values container for step %d", i));
+      }
+      
+      // same logic as in Fill: at the first weight != 1, fSumw2 := fValues
+      if (shard->HasSumw2(i) && !fSumw2[i])
+      {
+	fSumw2[i] = new TemplateArray(*fValues[i]);
+	AliInfo(Form("Created sumw2 container for step %d", i));
+      }
+      
+      for (Int_t p=0; p<shard->GetNPages(); p++)
+      {
+	const TemplateType* sourceValues = shard->GetValuesPage(i, p);
+	if (!sourceValues)
+	  continue;
+	
+	// if the shard has no sumw2, only weights == 1 have been filled and sumw2 == values
+	const TemplateType* sourceSumw2 = (shard->HasSumw2(i)) ? shard->GetSumw2Page(i, p) : sourceValues;
+	
+	Long64_t offset = (Long64_t) p * pageSize;
+	Long64_t n = TMath::Min((Long64_t) pageSize, fNBins - offset);
+	
+	StorageAddRange(fValues[i], offset, sourceValues, n);
+	if (fSumw2[i])
+	  StorageAddRange(fSumw2[i], offset, sourceSumw2, n);
+      }
+    }
+    
+    shard->Clear();
+  }
 }
 
 template <class TemplateArray, typename TemplateType>
@@ -382,61 +664,54 @@ void AliTHnT<TemplateArray, TemplateType>::FillContainer(AliCFContainer* cont)
 {
   // fills the information stored in the buffer in this class into the container <cont>
   
+  MergeShards();
+  
   for (Int_t i=0; i<fNSteps; i++)
   {
     if (!fValues[i])
       continue;
       
-    TemplateType* source = fValues[i]->GetArray();
+    TemplateArray* source = fValues[i];
     // if fSumw2 is not stored, the sqrt of the number of bin entries in source is filled below; otherwise we use fSumw2
-    TemplateType* sourceSumw2 = source;
+    TemplateArray* sourceSumw2 = source;
     if (fSumw2[i])
-      sourceSumw2 = fSumw2[i]->GetArray();
+      sourceSumw2 = fSumw2[i];
     
     THnSparse* target = cont->GetGrid(i)->GetGrid();
     
     Int_t* binIdx = new Int_t[fNVars];
     Int_t* nBins  = new Int_t[fNVars];
     for (Int_t j=0; j<fNVars; j++)
-    {
-      binIdx[j] = 1;
       nBins[j] = target->GetAxis(j)->GetNbins();
-    }
     
     Long64_t count = 0;
     
-    while (1)
+    // loop over the global bins in increasing order (skipping pages which are not allocated) 
+    // and translate the filled ones into TAxis bin indexes (inverse of GetGlobalBinIndex)
+    for (Long64_t globalBin = StorageNextFilledBin(source, 0); globalBin < fNBins; globalBin = StorageNextFilledBin(source, globalBin + 1))
     {
-//       for (Int_t j=0; j<fNVars; j++)
-// 	printf("%d ", binIdx[j]);
+      Double_t content = StorageGet(source, globalBin);
+      if (content == 0)
+	continue;
       
-      Long64_t globalBin = GetGlobalBinIndex(binIdx);
-//       Printf(" --> %lld", globalBin);
-      
-      if (source[globalBin] != 0)
+      Long64_t tmpBin = globalBin;
+      for (Int_t j=fNVars-1; j>=0; j--)
       {
-	target->SetBinContent(binIdx, source[globalBin]);
-	target->SetBinError(binIdx, TMath::Sqrt(sourceSumw2[globalBin]));
-	
-	count++;
+	binIdx[j] = tmpBin % nBins[j] + 1;
+	tmpBin /= nBins[j];
       }
       
-      binIdx[fNVars-1]++;
+//       for (Int_t j=0; j<fNVars; j++)
+// 	printf("%d ", binIdx[j]);
+//       Printf(" --> %lld", globalBin);
       
-      for (Int_t j=fNVars-1; j>0; j--)
-      {
-	if (binIdx[j] > nBins[j])
-	{
-	  binIdx[j] = 1;
-	  binIdx[j-1]++;
-	}
-      }
+      target->SetBinContent(binIdx, content);
+      target->SetBinError(binIdx, TMath::Sqrt(StorageGet(sourceSumw2, globalBin)));
       
-      if (binIdx[0] > nBins[0])
-	break;
+      count++;
     }
     
-    AliInfo(Form("Step %d: copied %lld entries out of %lld bins", i, count, GetGlobalBinIndex(binIdx)));
+    AliInfo(Form("Step %d: copied %lld entries out of %lld bins", i, count, fNBins));
 
     delete[] binIdx;
     delete[] nBins;
@@ -457,6 +732,8 @@ void AliTHnT<TemplateArray, TemplateType>::ReduceAxis()
   // "removes" one axis by summing over the axis and putting the entry to bin 1
   // TODO presently only implemented for the last axis
   
+  MergeShards();
+  
   Int_t axis = fNVars-1;
   
   for (Int_t i=0; i<fNSteps; i++)
@@ -464,10 +741,8 @@ void AliTHnT<TemplateArray, TemplateType>::ReduceAxis()
     if (!fValues[i])
       continue;
       
-    TemplateType* source = fValues[i]->GetArray();
-    TemplateType* sourceSumw2 = 0;
-    if (fSumw2[i])
-      sourceSumw2 = fSumw2[i]->GetArray();
+    TemplateArray* source = fValues[i];
+    TemplateArray* sourceSumw2 = fSumw2[i];
     
     THnSparse* target = GetGrid(i)->GetGrid();
     
@@ -490,21 +765,21 @@ void AliTHnT<TemplateArray, TemplateType>::ReduceAxis()
       {
 	binIdx[axis] = j;
 	Long64_t globalBin = GetGlobalBinIndex(binIdx);
-	sumValues += source[globalBin];
-	source[globalBin] = 0;
+	sumValues += StorageGet(source, globalBin);
+	StorageSet(source, globalBin, 0);
 
 	if (sourceSumw2)
 	{
-	  sumSumw2 += sourceSumw2[globalBin];
-	  sourceSumw2[globalBin] = 0;
+	  sumSumw2 += StorageGet(sourceSumw2, globalBin);
+	  StorageSet(sourceSumw2, globalBin, 0);
 	}
       }
       binIdx[axis] = 1;
 	
       Long64_t globalBin = GetGlobalBinIndex(binIdx);
-      source[globalBin] = sumValues;
+      StorageSet(source, globalBin, sumValues);
       if (sourceSumw2)
-	sourceSumw2[globalBin] = sumSumw2;
+	StorageSet(sourceSumw2, globalBin, sumSumw2);
 
       count++;
 
@@ -531,5 +806,303 @@ void AliTHnT<TemplateArray, TemplateType>::ReduceAxis()
   }
 }
 
+//____________________________________________________________________
+template <typename TemplateType>
+AliTHnShard<TemplateType>::AliTHnShard(Long64_t nBins, Int_t nVars, Int_t nSteps) :
+  fNBins(nBins),
+  fNSteps(nSteps),
+  fNPages((nBins + fgkPageSize - 1) / fgkPageSize),
+  fValues(new TemplateType**[nSteps]),
+  fSumw2(new TemplateType**[nSteps]),
+  fLastVars(new Double_t[nVars]),
+  fLastBins(new Int_t[nVars])
+{
+  // Constructor
+  
+  for (Int_t i=0; i<fNSteps; i++)
+  {
+    fValues[i] = new TemplateType*[fNPages];
+    memset(fValues[i], 0, fNPages*sizeof(TemplateType*));
+    fSumw2[i] = 0;
+  }
+  
+  // NaN never compares equal, therefore the first fill always looks up the bin
+  for (Int_t i=0; i<nVars; i++)
+  {
+    fLastVars[i] = TMath::QuietNaN();
+    fLastBins[i] = 0;
+  }
+}
+
+template <typename TemplateType>
+AliTHnShard<TemplateType>::~AliTHnShard()
+{
+  // Destructor
+  
+  Clear();
+  
+  for (Int_t i=0; i<fNSteps; i++)
+    delete[] fValues[i];
+  delete[] fValues;
+  delete[] fSumw2;
+  delete[] fLastVars;
+  delete[] fLastBins;
+}
+
+template <typename TemplateType>
+void AliTHnShard<TemplateType>::Clear()
+{
+  // frees all pages
+  
+  for (Int_t i=0; i<fNSteps; i++)
+  {
+    for (Int_t p=0; p<fNPages; p++)
+    {
+      delete[] fValues[i][p];
+      fValues[i][p] = 0;
+    }
+    
+    if (fSumw2[i])
+    {
+      for (Int_t p=0; p<fNPages; p++)
+	delete[] fSumw2[i][p];
+      delete[] fSumw2[i];
+      fSumw2[i] = 0;
+    }
+  }
+}
+
+template <typename TemplateType>
+TemplateType* AliTHnShard<TemplateType>::NewPage(const TemplateType* source)
+{
+  // allocates a page, initialized with <source> or 0
+  
+  TemplateType* page = new TemplateType[fgkPageSize];
+  if (source)
+    memcpy(page, source, fgkPageSize*sizeof(TemplateType));
+  else
+    memset(page, 0, fgkPageSize*sizeof(TemplateType));
+  
+  return page;
+}
+
+template <typename TemplateType>
+void AliTHnShard<TemplateType>::AddBinContent(Int_t istep, Long64_t bin, Double_t weight)
+{
+  // adds <weight> to the global bin <bin> of step <istep>
+  
+  Int_t page = bin / fgkPageSize;
+  Int_t idx = bin % fgkPageSize;
+  
+  if (!fValues[istep][page])
+  {
+    fValues[istep][page] = NewPage(0);
+    if (fSumw2[istep])
+      fSumw2[istep][page] = NewPage(0);
+  }
+  
+  if (weight != 1 && !fSumw2[istep])
+  {
+    // same logic as in AliTHnT::Fill: sumw2 := values of the entries filled so far
+    fSumw2[istep] = new TemplateType*[fNPages];
+    for (Int_t p=0; p<fNPages; p++)
+      fSumw2[istep][p] = (fValues[istep][p]) ? NewPage(fValues[istep][p]) : 0;
+  }
+  
+  fValues[istep][page][idx] += weight;
+  if (fSumw2[istep])
+    fSumw2[istep][page][idx] += weight * weight;
+}
+
+//____________________________________________________________________
+template <typename TemplateType>
+AliTHnPagedArrayT<TemplateType>::AliTHnPagedArrayT() :
+  TArray(),
+  fNPages(0),
+  fPages(0)
+{
+  // Constructor
+}
+
+template <typename TemplateType>
+AliTHnPagedArrayT<TemplateType>::AliTHnPagedArrayT(Int_t n) :
+  TArray(),
+  fNPages(0),
+  fPages(0)
+{
+  // Constructor, no page is allocated
+  
+  Set(n);
+}
+
+template <typename TemplateType>
+AliTHnPagedArrayT<TemplateType>::AliTHnPagedArrayT(const AliTHnPagedArrayT& array) :
+  TArray(array),
+  fNPages(0),
+  fPages(0)
+{
+  // Copy constructor, copies only the allocated pages
+  
+  CopyPages(array);
+}
+
+template <typename TemplateType>
+AliTHnPagedArrayT<TemplateType>& AliTHnPagedArrayT<TemplateType>::operator=(const AliTHnPagedArrayT& array)
+{
+  // assigment operator
+  
+  if (this != &array)
+  {
+    DeletePages();
+    TArray::operator=(array);
+    CopyPages(array);
+  }
+  return *this;
+}
+
+template <typename TemplateType>
+AliTHnPagedArrayT<TemplateType>::~AliTHnPagedArrayT()
+{
+  // Destructor
+  
+  DeletePages();
+}
+
+template <typename TemplateType>
+void AliTHnPagedArrayT<TemplateType>::Set(Int_t n)
+{
+  // sets the size to <n> elements, the content is reset
+  
+  DeletePages();
+  
+  fN = (n > 0) ? n : 0;
+  fNPages = (fN + fgkPageSize - 1) / fgkPageSize;
+  if (fNPages > 0)
+  {
+    fPages = new TemplateType*[fNPages];
+    memset(fPages, 0, fNPages*sizeof(TemplateType*));
+  }
+}
+
+template <typename TemplateType>
+void AliTHnPagedArrayT<TemplateType>::Reset()
+{
+  // frees all pages, i.e. all elements are 0 afterwards
+  
+  for (Int_t i=0; i<fNPages; i++)
+  {
+    delete[] fPages[i];
+    fPages[i] = 0;
+  }
+}
+
+template <typename TemplateType>
+void AliTHnPagedArrayT<TemplateType>::SetBin(Long64_t i, TemplateType v)
+{
+  // sets element <i>, setting 0 does not allocate a page
+  
+  Int_t page = i / fgkPageSize;
+  if (!fPages[page] && v == 0)
+    return;
+  
+  GetPageForWrite(page)[i % fgkPageSize] = v;
+}
+
+template <typename TemplateType>
+Int_t AliTHnPagedArrayT<TemplateType>::GetNAllocatedPages() const
+{
+  // returns the number of allocated pages
+  
+  Int_t count = 0;
+  for (Int_t i=0; i<fNPages; i++)
+    if (fPages[i])
+      count++;
+  
+  return count;
+}
+
+template <typename TemplateType>
+TemplateType* AliTHnPagedArrayT<TemplateType>::NewPage(Int_t page)
+{
+  // allocates page <page> initialized with 0
+  
+  fPages[page] = new TemplateType[fgkPageSize];
+  memset(fPages[page], 0, fgkPageSize*sizeof(TemplateType));
+  
+  return fPages[page];
+}
+
+template <typename TemplateType>
+void AliTHnPagedArrayT<TemplateType>::CopyPages(const AliTHnPagedArrayT& array)
+{
+  // copies size and allocated pages of <array>, the pages of this object must have been deleted before
+  
+  Set(array.fN);
+  
+  for (Int_t i=0; i<fNPages; i++)
+    if (array.fPages[i])
+      memcpy(NewPage(i), array.fPages[i], fgkPageSize*sizeof(TemplateType));
+}
+
+template <typename TemplateType>
+void AliTHnPagedArrayT<TemplateType>::DeletePages()
+{
+  // deletes all pages and the page table
+  
+  Reset();
+  delete[] fPages;
+  fPages = 0;
+  fNPages = 0;
+}
+
+template <typename TemplateType>
+void AliTHnPagedArrayT<TemplateType>::Streamer(TBuffer& R__b)
+{
+  // streams the size and the allocated pages (with their index) only
+  
+  if (R__b.IsReading())
+  {
+    UInt_t R__s, R__c;
+    R__b.ReadVersion(&R__s, &R__c);
+    
+    Int_t n = 0;
+    R__b >> n;
+    Set(n);
+    
+    Int_t nAllocated = 0;
+    R__b >> nAllocated;
+    for (Int_t i=0; i<nAllocated; i++)
+    {
+      Int_t page = 0;
+      R__b >> page;
+      R__b.ReadFastArray(NewPage(page), fgkPageSize);
+    }
+    
+    R__b.CheckByteCount(R__s, R__c, AliTHnPagedArrayT::Class());
+  }
+  else
+  {
+    UInt_t R__c = R__b.WriteVersion(AliTHnPagedArrayT::Class(), kTRUE);
+    
+    R__b << fN;
+    R__b << GetNAllocatedPages();
+    for (Int_t i=0; i<fNPages; i++)
+    {
+      if (!fPages[i])
+	continue;
+      R__b << i;
+      R__b.WriteFastArray(fPages[i], fgkPageSize);
+    }
+    
+    R__b.SetByteCount(R__c, kTRUE);
+  }
+}
+
+template class AliTHnPagedArrayT<Float_t>;
+
+template class AliTHnShard<Float_t>;
+template class AliTHnShard<Double_t>;
+
 template class AliTHnT<TArrayF, Float_t>;
 template class AliTHnT<TArrayD, Double_t>;
+template class AliTHnT<AliTHnPagedArrayF, Float_t>;
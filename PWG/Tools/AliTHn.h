@@ -9,9 +9,16 @@
 // Use AliTHn instead of AliCFContainer and your memory consumption will be drastically reduced
 // As AliTHn derives from AliCFContainer, you can just replace your current AliCFContainer object by AliTHn
 // Once you have the merged output, call FillParent() and you can use AliCFContainer as usual
+//
+// For filling from several threads, call SetNShards(nThreads) and let each thread fill with FillShard(threadId, ...)
+// The shards are merged into the container by MergeShards(), which is called by FillParent(), Merge() and Copy()
+//
+// AliTHnPaged stores the bins in pages which are allocated at the first write (see AliTHnPagedArrayT). Use it for
+// containers with many bins of which only a small fraction is filled.
 
 #include "TObject.h"
 #include "TString.h"
+#include "TArray.h"
 #include "AliCFContainer.h"
 
 class TArray;
@@ -19,6 +26,85 @@ class TArrayF;
 class TArrayD;
 class TCollection;
 
+template <typename TemplateType>
+class AliTHnPagedArrayT : public TArray
+{
+  // array with the interface of TArrayF/TArrayD which stores its content in pages of fgkPageSize elements
+  // a page is only allocated when an element in it is written; pages which have not been written read as 0
+  // only the allocated pages are streamed
+ public:
+  AliTHnPagedArrayT();
+  AliTHnPagedArrayT(Int_t n);
+  AliTHnPagedArrayT(const AliTHnPagedArrayT& array);
+  AliTHnPagedArrayT& operator=(const AliTHnPagedArrayT& array);
+  virtual ~AliTHnPagedArrayT();
+  
+  virtual Double_t GetAt(Int_t i) const { return At(i); }
+  virtual void SetAt(Double_t v, Int_t i) { SetBin(i, v); }
+  virtual void Set(Int_t n);
+  void Reset();
+  
+  TemplateType At(Long64_t i) const { const TemplateType* page = fPages[i / fgkPageSize]; return (page) ? page[i % fgkPageSize] : 0; }
+  void AddBin(Long64_t i, Double_t v) { GetPageForWrite(i / fgkPageSize)[i % fgkPageSize] += v; }
+  void SetBin(Long64_t i, TemplateType v);
+  
+  Int_t GetNPages() const { return fNPages; }
+  Int_t GetNAllocatedPages() const;
+  const TemplateType* GetPage(Int_t page) const { return fPages[page]; }
+  TemplateType* GetPageForWrite(Int_t page) { return (fPages[page]) ? fPages[page] : NewPage(page); }
+  
+  static const Int_t fgkPageSize = 4096; // elements per page
+  
+ protected:
+  TemplateType* NewPage(Int_t page);
+  void CopyPages(const AliTHnPagedArrayT& array);
+  void DeletePages();
+  
+  Int_t fNPages;          //! number of pages (streamed by the custom streamer)
+  TemplateType** fPages;  //! [fNPages] pages, 0 if not allocated (streamed by the custom streamer)
+  
+  ClassDef(AliTHnPagedArrayT, 1) // array with pages allocated on first write
+};
+
+typedef AliTHnPagedArrayT<Float_t> AliTHnPagedArrayF;
+
+template <typename TemplateType>
+class AliTHnShard
+{
+  // per-thread fill buffer of AliTHnT (not streamed)
+  // values are stored in pages of fgkPageSize bins which are allocated when first touched
+ public:
+  AliTHnShard(Long64_t nBins, Int_t nVars, Int_t nSteps);
+  ~AliTHnShard();
+  
+  void Clear();
+  void AddBinContent(Int_t istep, Long64_t bin, Double_t weight);
+  
+  Int_t GetNPages() const { return fNPages; }
+  const TemplateType* GetValuesPage(Int_t istep, Int_t page) const { return fValues[istep][page]; }
+  const TemplateType* GetSumw2Page(Int_t istep, Int_t page) const { return (fSumw2[istep]) ? fSumw2[istep][page] : 0; }
+  Bool_t HasSumw2(Int_t istep) const { return fSumw2[istep] != 0; }
+  
+  Double_t* GetLastVars() { return fLastVars; }
+  Int_t* GetLastBins() { return fLastBins; }
+  
+  static const Int_t fgkPageSize = 16384; // bins per page
+  
+ private:
+  AliTHnShard(const AliTHnShard&);
+  AliTHnShard& operator=(const AliTHnShard&);
+  
+  TemplateType* NewPage(const TemplateType* source);
+  
+  Long64_t fNBins;   // number of total bins
+  Int_t    fNSteps;  // number of selection steps
+  Int_t    fNPages;  // number of pages per step
+  TemplateType*** fValues;  // [fNSteps][fNPages] pages of values, 0 if not touched yet
+  TemplateType*** fSumw2;   // [fNSteps][fNPages] pages of sumw2, 0 as long as only weights == 1 have been filled
+  Double_t* fLastVars; // caching of last used bins (private to the thread)
+  Int_t* fLastBins;    // caching of last used bins (private to the thread)
+};
+
 class AliTHnBase : public AliCFContainer
 {
 public:
@@ -26,6 +112,11 @@ public:
   AliTHnBase(const Char_t* name, const Char_t* title,const Int_t nSelStep, const Int_t nVarIn, const Int_t* nBinIn) : AliCFContainer(name, title, nSelStep, nVarIn, nBinIn) { }
   
   virtual void Fill(const Double_t *var, Int_t istep, Double_t weight=1.) = 0;
+  virtual Long64_t GetGlobalBin(const Double_t *var) = 0;
+  virtual void FillBins(Int_t istep, Int_t n, const Long64_t* bins, const Double_t* weights) = 0;
+  virtual void SetNShards(Int_t nShards) = 0;
+  virtual void FillShard(Int_t shard, const Double_t *var, Int_t istep, Double_t weight=1.) = 0;
+  virtual void MergeShards() = 0;
   virtual void FillParent() = 0;
   virtual void FillContainer(AliCFContainer* cont) = 0;
 
@@ -48,11 +139,16 @@ class AliTHnT : public AliTHnBase
   virtual ~AliTHnT();
   
   virtual void Fill(const Double_t *var, Int_t istep, Double_t weight=1.) ;
+  virtual Long64_t GetGlobalBin(const Double_t *var);
+  virtual void FillBins(Int_t istep, Int_t n, const Long64_t* bins, const Double_t* weights);
+  virtual void SetNShards(Int_t nShards);
+  virtual void FillShard(Int_t shard, const Double_t *var, Int_t istep, Double_t weight=1.);
+  virtual void MergeShards();
   virtual void FillParent();
   virtual void FillContainer(AliCFContainer* cont);
   
-  virtual TArray* GetValues(Int_t step) { return fValues[step]; }
-  virtual TArray* GetSumw2(Int_t step)  { return fSumw2[step]; }
+  virtual TArray* GetValues(Int_t step) { MergeShards(); return fValues[step]; }
+  virtual TArray* GetSumw2(Int_t step)  { MergeShards(); return fSumw2[step]; }
   
   virtual void DeleteContainers();
   virtual void ReduceAxis();
@@ -65,7 +161,10 @@ class AliTHnT : public AliTHnBase
   
 protected:
   void Init();
+  void InitAxisCache();
+  void DeleteShards();
   Long64_t GetGlobalBinIndex(const Int_t* binIdx);
+  void AddBinContent(Int_t istep, Long64_t bin, Double_t weight);
   
   Long64_t fNBins;   // number of total bins
   Int_t    fNVars;   // number of variables
@@ -78,10 +177,14 @@ protected:
   Double_t* fLastVars; //! caching of last used bins (in many loops some vars are the same for a while)
   Int_t* fLastBins; //! caching of last used bins (in many loops some vars are the same for a while)
   
+  Int_t fNShards;   //! number of per-thread fill shards
+  AliTHnShard<TemplateType>** fShards; //! [fNShards] per-thread fill shards
+  
   ClassDef(AliTHnT, 5) // THn like container
 };
 
 typedef AliTHnT<TArrayF, Float_t> AliTHn;
 typedef AliTHnT<TArrayD, Double_t> AliTHnD;
+typedef AliTHnT<AliTHnPagedArrayF, Float_t> AliTHnPaged;
 
 #endif
@@ -16,9 +16,13 @@
 #pragma link C++ class AliPWGHistoTools+;
 #pragma link C++ typedef AliTHn;
 #pragma link C++ typedef AliTHnD;
+#pragma link C++ typedef AliTHnPaged;
+#pragma link C++ typedef AliTHnPagedArrayF;
 #pragma link C++ class AliTHnBase+;
+#pragma link C++ class AliTHnPagedArrayT<Float_t>-;
 #pragma link C++ class AliTHnT<TArrayF, Float_t>+;
 #pragma link C++ class AliTHnT<TArrayD, Double_t>+;
+#pragma link C++ class AliTHnT<AliTHnPagedArrayF, Float_t>+;
 #pragma link C++ class THistManager+;
 #pragma link C++ class AliJSONReader+;
 #pragma link C++ class AliJSONData+;
@@ -37,4 +41,5 @@
 #pragma link C++ function TestTHistManager::TestRunBuildGrouped();
 #pragma link C++ function TestTHistManager::TestRunFillSimple();
 #pragma link C++ function TestTHistManager::TestRunFillGrouped();
+#pragma link C++ function TestTHistManager::TestRunFillHandle();
 #endif
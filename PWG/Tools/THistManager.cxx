@@ -14,7 +14,7 @@
  **************************************************************************/
 #include <cfloat>
 #include <cstring>
-#include <iostream>   // for unit tests
+#include <iostream>
 #include <sstream>
 #include <string>
 #include <exception>
@@ -42,14 +42,18 @@ ClassImp(THistManager)
 THistManager::THistManager():
 		TNamed(),
 		fHistos(NULL),
-		fIsOwner(true)
+		fIsOwner(true),
+		fCountNameBasedFills(false),
+		fNameBasedFills()
 {
 }
 
 THistManager::THistManager(const char *name):
 		TNamed(name, Form("Histogram container %s", name)),
 		fHistos(NULL),
-		fIsOwner(true)
+		fIsOwner(true),
+		fCountNameBasedFills(false),
+		fNameBasedFills()
 {
 	fHistos = new THashList();
 	fHistos->SetName(Form("histos%s", name));
@@ -354,7 +358,7 @@ THnSparse* THistManager::CreateTHnSparse(const char *name, const char *title, in
   return hsparse;
 }
 
-void THistManager::CreateTProfile(const char* name, const char* title, int nbinsX, double xmin, double xmax, Option_t *opt) {
+TProfile *THistManager::CreateTProfile(const char* name, const char* title, int nbinsX, double xmin, double xmax, Option_t *opt) {
   TString dirname(basename(name)), hname(histname(name));
   THashList *parent(FindGroup(dirname));
   if(!parent) parent = CreateHistoGroup(dirname);
@@ -362,9 +366,10 @@ void THistManager::CreateTProfile(const char* name, const char* title, int nbins
 		Fatal("THistManager::CreateTProfile", "Object %s already exists in group %s", hname.Data(), dirname.Data());
   TProfile *hist = new TProfile(hname, title, nbinsX, xmin, xmax, opt);
   parent->Add(hist);
+  return hist;
 }
 
-void THistManager::CreateTProfile(const char* name, const char* title, int nbinsX, const double* xbins, Option_t *opt) {
+TProfile *THistManager::CreateTProfile(const char* name, const char* title, int nbinsX, const double* xbins, Option_t *opt) {
   TString dirname(basename(name)), hname(histname(name));
   THashList *parent(FindGroup(dirname));
   if(!parent) parent = CreateHistoGroup(dirname);
@@ -372,9 +377,10 @@ void THistManager::CreateTProfile(const char* name, const char* title, int nbins
 		Fatal("THistManager::CreateTHnSparse", "Object %s already exists in group %s", hname.Data(), dirname.Data());
   TProfile *hist = new TProfile(hname, title, nbinsX, xbins, opt);
   parent->Add(hist);
+  return hist;
 }
 
-void THistManager::CreateTProfile(const char* name, const char* title, const TArrayD& xbins, Option_t *opt){
+TProfile *THistManager::CreateTProfile(const char* name, const char* title, const TArrayD& xbins, Option_t *opt){
   TString dirname(basename(name)), hname(histname(name));
   THashList *parent(FindGroup(dirname));
   if(!parent) parent = CreateHistoGroup(dirname);
@@ -382,16 +388,17 @@ void THistManager::CreateTProfile(const char* name, const char* title, const TAr
 		Fatal("THistManager::CreateTHnSparse", "Object %s already exists in group %s", hname.Data(), dirname.Data());
   TProfile *hist = new TProfile(hname.Data(), title, xbins.GetSize()-1, xbins.GetArray(), opt);
   parent->Add(hist);
+  return hist;
 }
 
-void THistManager::CreateTProfile(const char *name, const char *title, const TBinning &xbins, Option_t *opt){
+TProfile *THistManager::CreateTProfile(const char *name, const char *title, const TBinning &xbins, Option_t *opt){
   TArrayD myxbins;
   try{
     xbins.CreateBinEdges(myxbins);
   } catch (std::exception &e){
     Fatal("THistManager::CreateProfile", "Exception raised: %s", e.what());
   }
-  CreateTProfile(name, title, myxbins, opt);
+  return CreateTProfile(name, title, myxbins, opt);
 }
 
 void THistManager::SetObject(TObject * const o, const char *group) {
@@ -409,19 +416,87 @@ void THistManager::SetObject(TObject * const o, const char *group) {
 }
 
 void THistManager::FillTH1(const char *name, double x, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTH1", "Parent group %s does not exist", dirname.Data());
+	TH1 *hist = dynamic_cast<TH1 *>(FindHistogramForFill(name, "THistManager::FillTH1"));
+	if(!hist){
+		Fatal("THistManager::FillTH1", "Histogram %s is not of type TH1", name);
+		return;
+	}
+	FillTH1(TH1Handle(hist), x, weight, opt);
+}
+
+void THistManager::FillTH1(const char *name, const char *label, double weight, Option_t *opt) {
+	TH1 *hist = dynamic_cast<TH1 *>(FindHistogramForFill(name, "THistManager::FillTH1"));
+	if(!hist){
+		Fatal("THistManager::FillTH1", "Histogram %s is not of type TH1", name);
+		return;
+	}
+	FillTH1(TH1Handle(hist), label, weight, opt);
+}
+
+void THistManager::FillTH2(const char *name, double x, double y, double weight, Option_t *opt) {
+	TH2 *hist = dynamic_cast<TH2 *>(FindHistogramForFill(name, "THistManager::FillTH2"));
+	if(!hist){
+		Fatal("THistManager::FillTH2", "Histogram %s is not of type TH2", name);
+		return;
+	}
+	FillTH2(TH2Handle(hist), x, y, weight, opt);
+}
+
+void THistManager::FillTH2(const char *name, double *point, double weight, Option_t *opt) {
+	TH2 *hist = dynamic_cast<TH2 *>(FindHistogramForFill(name, "THistManager::FillTH2"));
+	if(!hist){
+		Fatal("THistManager::FillTH2", "Histogram %s is not of type TH2", name);
 		return;
 	}
-	TH1 *hist = dynamic_cast<TH1 *>(parent->FindObject(hname));
+	FillTH2(TH2Handle(hist), point, weight, opt);
+}
+
+void THistManager::FillTH2(const char *name, const char *labelX, const char *labelY, double weight, Option_t *opt) {
+	TH2 *hist = dynamic_cast<TH2 *>(FindHistogramForFill(name, "THistManager::FillTH2"));
+	if(!hist){
+		Fatal("THistManager::FillTH2", "Histogram %s is not of type TH2", name);
+		return;
+	}
+	FillTH2(TH2Handle(hist), labelX, labelY, weight, opt);
+}
+
+void THistManager::FillTH3(const char* name, double x, double y, double z, double weight, Option_t *opt) {
+	TH3 *hist = dynamic_cast<TH3 *>(FindHistogramForFill(name, "THistManager::FillTH3"));
+	if(!hist){
+		Fatal("THistManager::FillTH3", "Histogram %s is not of type TH3", name);
+		return;
+	}
+	FillTH3(TH3Handle(hist), x, y, z, weight, opt);
+}
+
+void THistManager::FillTH3(const char* name, const double* point, double weight, Option_t *opt) {
+	TH3 *hist = dynamic_cast<TH3 *>(FindHistogramForFill(name, "THistManager::FillTH3"));
+	if(!hist){
+		Fatal("THistManager::FillTH3", "Histogram %s is not of type TH3", name);
+		return;
+	}
+	FillTH3(TH3Handle(hist), point, weight, opt);
+}
+
+void THistManager::FillTHnSparse(const char *name, const double *x, double weight, Option_t *opt) {
+	THnSparseD *hist = dynamic_cast<THnSparseD *>(FindHistogramForFill(name, "THistManager::FillTHnSparse"));
 	if(!hist){
-		Fatal("THistManager::FillTH1", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
+		Fatal("THistManager::FillTHnSparse", "Histogram %s is not of type THnSparseD", name);
 		return;
 	}
-	TString optionstring(opt);
-	if(optionstring.Contains("w")){
+	FillTHnSparse(THnSparseHandle(hist), x, weight, opt);
+}
+
+void THistManager::FillProfile(const char* name, double x, double y, double weight){
+  TProfile *hist = dynamic_cast<TProfile *>(FindHistogramForFill(name, "THistManager::FillTProfile"));
+  if(!hist)
+		Fatal("THistManager::FillTProfile", "Histogram %s is not of type TProfile", name);
+  FillProfile(TProfileHandle(hist), x, y, weight);
+}
+
+void THistManager::FillTH1(TH1Handle hist, double x, double weight, Option_t *opt) {
+	// options checked on the raw string, avoids TString creation for each entry
+	if(opt && strchr(opt, 'w')){
 	  // use bin width as weight
 	  Int_t bin = hist->GetXaxis()->FindBin(x);
 	  // check if not overflow or underflow bin
@@ -431,20 +506,8 @@ void THistManager::FillTH1(const char *name, double x, double weight, Option_t *
 	hist->Fill(x, weight);
 }
 
-void THistManager::FillTH1(const char *name, const char *label, double weight, Option_t *opt) {
-  TString dirname(basename(name)), hname(histname(name));
-  THashList *parent(FindGroup(dirname));
-  if(!parent){
-    Fatal("THistManager::FillTH1", "Parent group %s does not exist", dirname.Data());
-    return;
-  }
-  TH1 *hist = dynamic_cast<TH1 *>(parent->FindObject(hname));
-  if(!hist){
-    Fatal("THistManager::FillTH1", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-    return;
-  }
-	TString optionstring(opt);
-	if(optionstring.Contains("w")){
+void THistManager::FillTH1(TH1Handle hist, const char *label, double weight, Option_t *opt) {
+	if(opt && strchr(opt, 'w')){
 	  // use bin width as weight
 	  // get bin for label
 	  Int_t bin = hist->GetXaxis()->FindBin(label);
@@ -455,174 +518,144 @@ void THistManager::FillTH1(const char *name, const char *label, double weight, O
   hist->Fill(label, weight);
 }
 
-void THistManager::FillTH2(const char *name, double x, double y, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTH2", "Parent group %s does not exist", dirname.Data());
-		return;
-	}
-	TH2 *hist = dynamic_cast<TH2 *>(parent->FindObject(hname));
-	if(!hist){
-		Fatal("THistManager::FillTH2", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-		return;
-	}
-	TString optstring(opt);
-	Double_t myweight = optstring.Contains("w") ? 1. : weight;
-	if(optstring.Contains("wx")){
-	  Int_t binx = hist->GetXaxis()->FindBin(x);
-	  if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
-	}
-	if(optstring.Contains("wy")){
-	  Int_t biny = hist->GetYaxis()->FindBin(y);
-	  if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
+void THistManager::FillTH2(TH2Handle hist, double x, double y, double weight, Option_t *opt) {
+	Double_t myweight = weight;
+	if(opt && strchr(opt, 'w')){
+	  myweight = 1.;
+	  if(strstr(opt, "wx")){
+	    Int_t binx = hist->GetXaxis()->FindBin(x);
+	    if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
+	  }
+	  if(strstr(opt, "wy")){
+	    Int_t biny = hist->GetYaxis()->FindBin(y);
+	    if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
+	  }
 	}
 	hist->Fill(x, y, myweight);
 }
 
-void THistManager::FillTH2(const char *name, double *point, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTH2", "Parent group %s does not exist", dirname.Data());
-		return;
-	}
-	TH2 *hist = dynamic_cast<TH2 *>(parent->FindObject(hname));
-	if(!hist){
-		Fatal("THistManager::FillTH2", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-		return;
-	}
-	TString optstring(opt);
-	Double_t myweight = optstring.Contains("w") ? 1. : weight;
-	if(optstring.Contains("wx")){
-	  Int_t binx = hist->GetXaxis()->FindBin(point[0]);
-	  if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
-	}
-	if(optstring.Contains("wy")){
-	  Int_t biny = hist->GetYaxis()->FindBin(point[1]);
-	  if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
+void THistManager::FillTH2(TH2Handle hist, double *point, double weight, Option_t *opt) {
+	Double_t myweight = weight;
+	if(opt && strchr(opt, 'w')){
+	  myweight = 1.;
+	  if(strstr(opt, "wx")){
+	    Int_t binx = hist->GetXaxis()->FindBin(point[0]);
+	    if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
+	  }
+	  if(strstr(opt, "wy")){
+	    Int_t biny = hist->GetYaxis()->FindBin(point[1]);
+	    if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
+	  }
 	}
 	hist->Fill(point[0], point[1], weight);
 }
 
-void THistManager::FillTH2(const char *name, const char *labelX, const char *labelY, double weight, Option_t *opt) {
-  TString dirname(basename(name)), hname(histname(name));
-  THashList *parent(FindGroup(dirname));
-  if(!parent){
-    Fatal("THistManager::FillTH2", "Parent group %s does not exist", dirname.Data());
-    return;
-  }
-  TH2 *hist = dynamic_cast<TH2 *>(parent->FindObject(hname));
-  if(!hist){
-    Fatal("THistManager::FillTH2", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-    return;
-  }
-  TString optstring(opt);
-  Double_t myweight = optstring.Contains("w") ? 1. : weight;
-  if(optstring.Contains("wx")){
-    Int_t binx = hist->GetXaxis()->FindBin(labelY);
-    if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
-  }
-  if(optstring.Contains("wy")){
-    Int_t biny = hist->GetYaxis()->FindBin(labelX);
-    if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
+void THistManager::FillTH2(TH2Handle hist, const char *labelX, const char *labelY, double weight, Option_t *opt) {
+  Double_t myweight = weight;
+  if(opt && strchr(opt, 'w')){
+    myweight = 1.;
+    if(strstr(opt, "wx")){
+      Int_t binx = hist->GetXaxis()->FindBin(labelY);
+      if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
+    }
+    if(strstr(opt, "wy")){
+      Int_t biny = hist->GetYaxis()->FindBin(labelX);
+      if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
+    }
   }
   hist->Fill(labelX, labelY, weight);
 }
 
-void THistManager::FillTH3(const char* name, double x, double y, double z, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTH3", "Parent group %s does not exist", dirname.Data());
-		return;
-	}
-	TH3 *hist = dynamic_cast<TH3 *>(parent->FindObject(hname));
-	if(!hist){
-		Fatal("THistManager::FillTH3", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-		return;
-	}
-	TString optstring(opt);
-	Double_t myweight = optstring.Contains("w") ? 1. : weight;
-	if(optstring.Contains("wx")){
-	  Int_t binx = hist->GetXaxis()->FindBin(x);
-	  if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
-	}
-	if(optstring.Contains("wy")){
-	  Int_t biny = hist->GetYaxis()->FindBin(y);
-	  if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
-	}
-	if(optstring.Contains("wz")){
-	  Int_t binz = hist->GetZaxis()->FindBin(z);
-	  if(binz != 0 && binz != hist->GetZaxis()->GetNbins()) myweight *= 1./hist->GetZaxis()->GetBinWidth(binz);
+void THistManager::FillTH3(TH3Handle hist, double x, double y, double z, double weight, Option_t *opt) {
+	Double_t myweight = weight;
+	if(opt && strchr(opt, 'w')){
+	  myweight = 1.;
+	  if(strstr(opt, "wx")){
+	    Int_t binx = hist->GetXaxis()->FindBin(x);
+	    if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
+	  }
+	  if(strstr(opt, "wy")){
+	    Int_t biny = hist->GetYaxis()->FindBin(y);
+	    if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
+	  }
+	  if(strstr(opt, "wz")){
+	    Int_t binz = hist->GetZaxis()->FindBin(z);
+	    if(binz != 0 && binz != hist->GetZaxis()->GetNbins()) myweight *= 1./hist->GetZaxis()->GetBinWidth(binz);
+	  }
 	}
 	hist->Fill(x, y, z, weight);
 }
 
-void THistManager::FillTH3(const char* name, const double* point, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTH3", "Parent group %s does not exist", dirname.Data());
-		return;
-	}
-	TH3 *hist = dynamic_cast<TH3 *>(parent->FindObject(hname));
-	if(!hist){
-		Fatal("THistManager::FillTH3", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-		return;
-	}
-	TString optstring(opt);
-	Double_t myweight = optstring.Contains("w") ? 1. : weight;
-	if(optstring.Contains("wx")){
-	  Int_t binx = hist->GetXaxis()->FindBin(point[0]);
-	  if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
-	}
-	if(optstring.Contains("wy")){
-	  Int_t biny = hist->GetYaxis()->FindBin(point[1]);
-	  if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
-	}
-	if(optstring.Contains("wz")){
-	  Int_t binz = hist->GetZaxis()->FindBin(point[2]);
-	  if(binz != 0 && binz != hist->GetZaxis()->GetNbins()) myweight *= 1./hist->GetZaxis()->GetBinWidth(binz);
+void THistManager::FillTH3(TH3Handle hist, const double* point, double weight, Option_t *opt) {
+	Double_t myweight = weight;
+	if(opt && strchr(opt, 'w')){
+	  myweight = 1.;
+	  if(strstr(opt, "wx")){
+	    Int_t binx = hist->GetXaxis()->FindBin(point[0]);
+	    if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
+	  }
+	  if(strstr(opt, "wy")){
+	    Int_t biny = hist->GetYaxis()->FindBin(point[1]);
+	    if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
+	  }
+	  if(strstr(opt, "wz")){
+	    Int_t binz = hist->GetZaxis()->FindBin(point[2]);
+	    if(binz != 0 && binz != hist->GetZaxis()->GetNbins()) myweight *= 1./hist->GetZaxis()->GetBinWidth(binz);
+	  }
 	}
 	hist->Fill(point[0], point[1], point[2], weight);
 }
 
-void THistManager::FillTHnSparse(const char *name, const double *x, double weight, Option_t *opt) {
+void THistManager::FillTHnSparse(THnSparseHandle hist, const double *x, double weight, Option_t *opt) {
+	Double_t myweight = weight;
+	if(opt && strchr(opt, 'w')){
+	  myweight = 1.;
+	  for(Int_t iaxis = 0; iaxis < hist->GetNdimensions(); iaxis++){
+	    std::stringstream weighthandler;
+	    weighthandler << "w" << iaxis;
+	    if(strstr(opt, weighthandler.str().c_str())){
+	      Int_t bin = hist->GetAxis(iaxis)->FindBin(x[iaxis]);
+	      if(bin != 0 && bin != hist->GetAxis(iaxis)->GetNbins()) myweight *= hist->GetAxis(iaxis)->GetBinWidth(bin);
+	    }
+	  }
+	}
+
+	hist->Fill(x, weight);
+}
+
+void THistManager::FillProfile(TProfileHandle hist, double x, double y, double weight){
+  hist->Fill(x, y, weight);
+}
+
+TObject *THistManager::FindHistogramForFill(const char *name, const char *caller) {
 	TString dirname(basename(name)), hname(histname(name));
 	THashList *parent(FindGroup(dirname));
 	if(!parent){
-		Fatal("THistManager::FillTHnSparse", "Parent group %s does not exist", dirname.Data());
-		return;
+		Fatal(caller, "Parent group %s does not exist", dirname.Data());
+		return nullptr;
 	}
-	THnSparseD *hist = dynamic_cast<THnSparseD *>(parent->FindObject(hname));
+	TObject *hist = parent->FindObject(hname);
 	if(!hist){
-		Fatal("THistManager::FillTHnSparse", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-		return;
-	}
-	TString optstring(opt);
-	Double_t myweight = optstring.Contains("w") ? 1. : weight;
-	for(Int_t iaxis = 0; iaxis < hist->GetNdimensions(); iaxis++){
-	  std::stringstream weighthandler;
-	  weighthandler << "w" << iaxis;
-	  if(optstring.Contains(weighthandler.str().c_str())){
-	    Int_t bin = hist->GetAxis(iaxis)->FindBin(x[iaxis]);
-	    if(bin != 0 && bin != hist->GetAxis(iaxis)->GetNbins()) myweight *= hist->GetAxis(iaxis)->GetBinWidth(bin);
-	  }
+		Fatal(caller, "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
+		return nullptr;
 	}
+	if(fCountNameBasedFills) fNameBasedFills[name]++;
+	return hist;
+}
 
-	hist->Fill(x, weight);
+void THistManager::PrintNameBasedFills() const {
+	if(!fCountNameBasedFills){
+		Info("THistManager::PrintNameBasedFills", "Counting of name-based fills not enabled");
+		return;
+	}
+	std::cout << "Name-based fills in histogram manager " << GetName() << ":" << std::endl;
+	for(std::map<std::string, ULong64_t>::const_iterator it = fNameBasedFills.begin(); it != fNameBasedFills.end(); ++it)
+	  std::cout << "  " << it->first << ": " << it->second << std::endl;
 }
 
-void THistManager::FillProfile(const char* name, double x, double y, double weight){
-  TString dirname(basename(name)), hname(histname(name));
-  THashList *parent(FindGroup(dirname));
-  if(!parent)
-		Fatal("THistManager::FillTProfile", "Parent group %s does not exist", dirname.Data());
-  TProfile *hist = dynamic_cast<TProfile *>(parent->FindObject(hname));
-  if(!hist)
-		Fatal("THistManager::FillTProfile", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-  hist->Fill(x, y, weight);
+ULong64_t THistManager::GetNumberOfNameBasedFills(const char *name) const {
+	std::map<std::string, ULong64_t>::const_iterator found = fNameBasedFills.find(name);
+	return found == fNameBasedFills.end() ? 0 : found->second;
 }
 
 TObject *THistManager::FindObject(const char *name) const {
@@ -1030,6 +1063,64 @@ namespace TestTHistManager {
     return success ? 0 : 1;
   }
 
+  int THistManagerTestSuite::TestFillHandleHistograms(){
+    THistManager testmgr("testmgr");
+
+    THistManager::TH1Handle h1 = testmgr.CreateTH1("Group1/Test1", "Test handle fill 1D histogram", 1, 0., 1.);
+    THistManager::TH2Handle h2 = testmgr.CreateTH2("Group2/Test2", "Test handle fill 2D histogram", 1, 0., 1., 1, 0., 1.);
+    THistManager::TH3Handle h3 = testmgr.CreateTH3("Test3", "Test handle fill 3D histogram", 1, 0., 1., 1, 0., 1., 1, 0., 1.);
+    int nbins[4] = {1,1,1,1}; double min[4] = {0.,0.,0.,0.}, max[4] = {1.,1.,1.,1.};
+    THistManager::THnSparseHandle hN = testmgr.CreateTHnSparse("TestN", "Test handle fill THnSparse", 4, nbins, min, max);
+    testmgr.CreateTProfile("Group3/Subgroup1/TestProfile", "Test handle fill profile histogram", 1, 0., 1.);
+    THistManager::TProfileHandle hprof = testmgr.GetHandle<TProfile>("Group3/Subgroup1/TestProfile");
+
+    testmgr.SetCountNameBasedFills();
+    double point[4] = {0.5, 0.5, 0.5, 0.5};
+    for(int i = 0; i < 100; i++){
+      testmgr.FillTH1(h1, 0.5);
+      testmgr.FillTH2(h2, 0.5, 0.5);
+      testmgr.FillTH3(h3, 0.5, 0.5, 0.5);
+      testmgr.FillTHnSparse(hN, point);
+      testmgr.FillProfile(hprof, 0.5, 1.);
+    }
+    // one name-based fill in order to check the counter
+    testmgr.FillTH1("Group1/Test1", 0.5);
+
+    // Evaluate test
+    // tell user why test has failed
+    bool success(true);
+    if(!(h1.IsValid() && h2.IsValid() && h3.IsValid() && hN.IsValid() && hprof.IsValid())){
+      std::cout << "Invalid handle returned" << std::endl;
+      return 1;
+    }
+    if(TMath::Abs(h1->GetBinContent(1) - 101) > DBL_EPSILON){
+      std::cout << "Group1/Test1: Mismatch in values, expected 101, found " << h1->GetBinContent(1) << std::endl;
+      success = false;
+    }
+    if(TMath::Abs(h2->GetBinContent(1, 1) - 100) > DBL_EPSILON){
+      std::cout << "Group2/Test2: Mismatch in values, expected 100, found " << h2->GetBinContent(1, 1) << std::endl;
+      success = false;
+    }
+    if(TMath::Abs(h3->GetBinContent(1, 1, 1) - 100) > DBL_EPSILON){
+      std::cout << "Test3: Mismatch in values, expected 100, found " << h3->GetBinContent(1, 1, 1) << std::endl;
+      success = false;
+    }
+    int index[4] = {1,1,1,1};
+    if(TMath::Abs(hN->GetBinContent(index) - 100) > DBL_EPSILON){
+      std::cout << "TestN: Mismatch in values, expected 100, found " << hN->GetBinContent(index) << std::endl;
+      success = false;
+    }
+    if(TMath::Abs(hprof->GetBinContent(1) - 1) > DBL_EPSILON){
+      std::cout << "Group3/Subgroup1/TestProfile: Mismatch in values, expected 1, found " << hprof->GetBinContent(1) << std::endl;
+      success = false;
+    }
+    if(testmgr.GetNumberOfNameBasedFills("Group1/Test1") != 1 || testmgr.GetNumberOfNameBasedFills("Group2/Test2") != 0){
+      std::cout << "Name-based fills not counted correctly" << std::endl;
+      success = false;
+    }
+    return success ? 0 : 1;
+  }
+
   int TestRunAll(){
     int testresult(0);
     THistManagerTestSuite testsuite;
@@ -1050,6 +1141,10 @@ namespace TestTHistManager {
     testresult += testsuite.TestFillGroupedHistograms();
     std::cout << "Result after test: " << testresult << std::endl;
 
+    std::cout << "Running test: Fill Handle" << std::endl;
+    testresult += testsuite.TestFillHandleHistograms();
+    std::cout << "Result after test: " << testresult << std::endl;
+
     return testresult;
   }
 
@@ -1072,4 +1167,9 @@ namespace TestTHistManager {
     THistManagerTestSuite testsuite;
     return testsuite.TestFillGroupedHistograms();
   }
+
+  int TestRunFillHandle(){
+    THistManagerTestSuite testsuite;
+    return testsuite.TestFillHandleHistograms();
+  }
 }
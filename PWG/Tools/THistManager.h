@@ -7,6 +7,8 @@
 #include <TIterator.h>
 #include <TNamed.h>
 #include <iterator>
+#include <map>
+#include <string>
 
 class TArrayD;
 class TAxis;
@@ -95,6 +97,27 @@ class TProfile;
  * an argument for options. Automatic correction for the bin width is done when
  * specifying the argument *W*, followed by the direction. Adding multiple directions
  * the weight is calculated for all directions at the same time.
+ *
+ * ## Filling via histogram handles
+ *
+ * Name-based Fill methods resolve the histogram path (groups and histogram
+ * name) and look up the histogram in the hash lists for every entry. In
+ * loops over tracks or clusters this lookup dominates over the fill itself.
+ * The pointer returned by the Create methods can be stored as a typed handle
+ * and passed to the Fill methods instead of the name, in which case the
+ * histogram is filled directly:
+ *
+ * ~~~{.cxx}
+ * THistManager::TH1Handle hpt = mgr.CreateTH1("hPt", "pt-distribution", TLinearBinning(100, 0., 100.));
+ * for(auto en : ROOT::TSeqI(0, 10000) {
+ *   mgr.FillTH1(hpt, gRandom->Exp(-1));
+ * }
+ * ~~~
+ *
+ * Handles for histograms created elsewhere can be obtained via GetHandle.
+ * In order to find name-based fills remaining on the hot path, counting
+ * of name-based fills can be enabled with SetCountNameBasedFills. The
+ * number of fills per histogram is reported by PrintNameBasedFills.
  */
 class THistManager : public TNamed {
 public:
@@ -229,6 +252,57 @@ public:
     iterator();
   };
 
+  /**
+   * @class THistHandle
+   * @brief Typed handle to a histogram inside the histogram manager
+   * @ingroup Histmanager
+   *
+   * Lightweight wrapper around the pointer to a histogram owned by the
+   * histogram manager. Passing a handle to the Fill methods bypasses
+   * the name-based lookup of the histogram. Handles are implicitly
+   * constructed from the pointers returned by the Create methods.
+   * The handle does not own the histogram and gets invalid once the
+   * histogram manager is deleted.
+   */
+  template<class H>
+  class THistHandle {
+  public:
+    /**
+     * @brief Default constructor, creating an invalid handle
+     */
+    THistHandle(): fHist(nullptr) {}
+
+    /**
+     * @brief Constructor, wrapping a histogram pointer
+     * @param[in] hist Histogram connected to the handle
+     */
+    THistHandle(H *hist): fHist(hist) {}
+
+    /**
+     * @brief Check whether the handle is connected to a histogram
+     * @return True if the handle points to a histogram, false otherwise
+     */
+    bool IsValid() const { return fHist != nullptr; }
+
+    /**
+     * @brief Access to the underlying histogram
+     * @return Histogram connected to the handle
+     */
+    H *Get() const { return fHist; }
+
+    H *operator->() const { return fHist; }
+    operator H*() const { return fHist; }
+
+  private:
+    H                           *fHist;               ///< Underlying histogram (not owned)
+  };
+
+  typedef THistHandle<TH1> TH1Handle;                 ///< Handle for 1D histograms
+  typedef THistHandle<TH2> TH2Handle;                 ///< Handle for 2D histograms
+  typedef THistHandle<TH3> TH3Handle;                 ///< Handle for 3D histograms
+  typedef THistHandle<THnSparse> THnSparseHandle;     ///< Handle for THnSparse histograms
+  typedef THistHandle<TProfile> TProfileHandle;       ///< Handle for profile histograms
+
   /**
    * @brief Default constructor.
    *
@@ -481,7 +555,7 @@ public:
 	 * @param[in] xmax max. value in x-direction
 	 * @param[in] opt Further options
 	 */
-  void CreateTProfile(const char *name, const char *title, int nbinsX, double xmin, double xmax, Option_t *opt = "");
+  TProfile *CreateTProfile(const char *name, const char *title, int nbinsX, double xmin, double xmax, Option_t *opt = "");
 
   /**
    * @brief Create a new TProfile within the container.
@@ -494,7 +568,7 @@ public:
    * @param[in] xbins binning in x-direction
    * @param[in] opt Further options
    */
-  void CreateTProfile(const char *name, const char *title, int nbinsX, const double *xbins, Option_t *opt = "");
+  TProfile *CreateTProfile(const char *name, const char *title, int nbinsX, const double *xbins, Option_t *opt = "");
 
   /**
    * @brief Create a new TProfile within the container.
@@ -506,7 +580,7 @@ public:
    * @param[in] xbins binning in x-direction
    * @param[in] opt Further options
    */
-  void CreateTProfile(const char *name, const char *title, const TArrayD &xbins, Option_t *opt = "");
+  TProfile *CreateTProfile(const char *name, const char *title, const TArrayD &xbins, Option_t *opt = "");
 
   /**
    * @brief Create a new TProfile within the container.
@@ -518,7 +592,7 @@ public:
    * @param[in] xbins User binning
    * @param[in] opt Further options
    */
-  void CreateTProfile(const char *name, const char *title, const TBinning &xbins, Option_t *opt = "");
+  TProfile *CreateTProfile(const char *name, const char *title, const TBinning &xbins, Option_t *opt = "");
 
   /**
    * @brief Set a new group into the container into the parent group
@@ -634,6 +708,138 @@ public:
 	 */
   void FillProfile(const char *name, double x, double y, double weight = 1.);
 
+  /**
+   * @brief Fill a 1D histogram via its handle.
+   *
+   * Same as the name-based FillTH1, however the histogram
+   * is filled directly without lookup.
+   * @param[in] hist Handle of the histogram
+   * @param[in] x x-coordinate
+   * @param[in] weight optional weight of the entry (default 1)
+   * @param[in] option Optional filling arguments
+   */
+  void FillTH1(TH1Handle hist, double x, double weight = 1., Option_t *opt = "");
+
+  /**
+   * @brief Fill a 1D histogram via its handle using a bin label.
+   * @param[in] hist Handle of the histogram
+   * @param[in] label Label of the bin to fill
+   * @param[in] weight optional weight of the entry (default 1)
+   * @param[in] option Optional filling arguments
+   */
+  void FillTH1(TH1Handle hist, const char *label, double weight = 1., Option_t *opt = "");
+
+  /**
+   * @brief Fill a 2D histogram via its handle.
+   * @param[in] hist Handle of the histogram
+   * @param[in] x x-coordinate
+   * @param[in] y y-coordinate
+   * @param[in] weight optional weight of the entry (default 1)
+   * @param[in] option Optional filling arguments
+   */
+  void FillTH2(TH2Handle hist, double x, double y, double weight = 1., Option_t *opt = "");
+
+  /**
+   * @brief Fill a 2D histogram via its handle using bin labels.
+   * @param[in] hist Handle of the histogram
+   * @param[in] labelX x-coordinate
+   * @param[in] labelY y-coordinate
+   * @param[in] weight optional weight of the entry (default 1)
+   * @param[in] option Optional filling arguments
+   */
+  void FillTH2(TH2Handle hist, const char *labelX, const char *labelY, double weight = 1., Option_t *opt = "");
+
+  /**
+   * @brief Fill a 2D histogram via its handle.
+   * @param[in] hist Handle of the histogram
+   * @param[in] point coordinates of the data
+   * @param[in] weight optional weight of the entry (default 1)
+   * @param[in] option Optional filling arguments
+   */
+  void FillTH2(TH2Handle hist, double *point, double weight = 1., Option_t *opt = "");
+
+  /**
+   * @brief Fill a 3D histogram via its handle.
+   * @param[in] hist Handle of the histogram
+   * @param[in] x x-coordinate
+   * @param[in] y y-coordinate
+   * @param[in] z z-coordinate
+   * @param[in] weight optional weight of the entry (default 1)
+   * @param[in] option Optional filling arguments
+   */
+  void FillTH3(TH3Handle hist, double x, double y, double z, double weight = 1., Option_t *opt = "");
+
+  /**
+   * @brief Fill a 3D histogram via its handle.
+   * @param[in] hist Handle of the histogram
+   * @param[in] point 3D-coordinate (x,y,z) of the point to be filled
+   * @param[in] weight optional weight of the entry (default 1)
+   * @param[in] option Optional filling arguments
+   */
+  void FillTH3(TH3Handle hist, const double *point, double weight = 1., Option_t *opt = "");
+
+  /**
+   * @brief Fill a nD histogram via its handle.
+   * @param[in] hist Handle of the histogram
+   * @param[in] x coordinates of the data
+   * @param[in] weight optional weight of the entry (default 1)
+   * @param[in] option Optional filling arguments
+   */
+  void FillTHnSparse(THnSparseHandle hist, const double *x, double weight = 1., Option_t *opt = "");
+
+  /**
+   * @brief Fill a profile histogram via its handle.
+   * @param[in] hist Handle of the profile histogram
+   * @param[in] x x-coordinate
+   * @param[in] y y-coordinate
+   * @param[in] weight optional weight of the entry (default 1)
+   */
+  void FillProfile(TProfileHandle hist, double x, double y, double weight = 1.);
+
+  /**
+   * @brief Get a typed handle for a histogram inside the container.
+   *
+   * Meant for histograms which were not created by the
+   * task filling them. The lookup is done once, subsequent
+   * fills via the handle go directly to the histogram. Fails
+   * in case the histogram does not exist or has a different type.
+   * @param[in] name Name of the histogram, including parent group(s)
+   * @return Handle of the histogram
+   */
+  template<class H>
+  THistHandle<H> GetHandle(const char *name) const {
+    H *hist = dynamic_cast<H *>(FindObject(name));
+    if(!hist) Fatal("THistManager::GetHandle", "Histogram %s not found or of different type", name);
+    return THistHandle<H>(hist);
+  }
+
+  /**
+   * @brief Enable counting of name-based fills.
+   *
+   * Debugging aid: When enabled, every Fill call with a
+   * histogram name is counted per histogram, in order to
+   * find name-based lookups remaining in the event loop.
+   * Can be reported via PrintNameBasedFills.
+   * @param[in] doCount If true name-based fills are counted
+   */
+  void SetCountNameBasedFills(bool doCount = true) { fCountNameBasedFills = doCount; }
+
+  /**
+   * @brief Print number of name-based fills per histogram.
+   *
+   * Only available if counting was enabled via SetCountNameBasedFills.
+   */
+  void PrintNameBasedFills() const;
+
+  /**
+   * @brief Get the number of name-based fills of a histogram.
+   *
+   * Only counted if counting was enabled via SetCountNameBasedFills.
+   * @param[in] name Name of the histogram, including parent group(s)
+   * @return Number of name-based fills (0 if not filled by name)
+   */
+  ULong64_t GetNumberOfNameBasedFills(const char *name) const;
+
   /**
    * @brief Create forward iterator starting at the beginning of the
    * container
@@ -719,8 +925,22 @@ private:
 	 */
 	TString histname(const TString &path) const;
 
+	/**
+	 * @brief Find histogram to be filled by its name.
+	 *
+	 * Fails in case the parent group or the histogram does not
+	 * exist. Counts the lookup if counting of name-based fills
+	 * is enabled.
+	 * @param[in] name Name of the histogram, including parent group(s)
+	 * @param[in] caller Name of the calling fill method (for error messages)
+	 * @return The histogram object
+	 */
+	TObject *FindHistogramForFill(const char *name, const char *caller);
+
 	THashList *fHistos;                   ///< List of histograms
 	bool fIsOwner;                        ///< Set the ownership
+	bool fCountNameBasedFills;            //!<! Count fills using the histogram name (debugging)
+	std::map<std::string, ULong64_t> fNameBasedFills;  //!<! Number of name-based fills per histogram
 
   /// \cond CLASSIMP
 	ClassDef(THistManager, 1);  // Container for histograms
@@ -845,6 +1065,20 @@ public:
    * @return 0 if test is passed, 1 if it failed
    */
   int TestFillGroupedHistograms();
+
+  /**
+   * Purpose of the test: Check whether filling via histogram handles is propagated to the histograms
+   * Relies on: TestFillSimpleHistograms, TestFillGroupedHistograms
+   *
+   * Creating histograms of all types, partly in groups, and filling them
+   * 100 times via their handles, and 1 time by name for the TH1.
+   *
+   * Test passed:
+   * - All histograms have the expected value (100 for histograms, 101 for TH1, 1 for profile)
+   * - The name-based fill is counted exactly once
+   * @return 0 if test is passed, 1 if it failed
+   */
+  int TestFillHandleHistograms();
 };
 
 /**
@@ -882,5 +1116,12 @@ int TestRunFillSimple();
  */
 int TestRunFillGrouped();
 
+/**
+ * Run the test for filling histograms via handles. See @ref THistManagerTestSuite
+ * for details.
+ * @return 0 if test is passed, 1 if failed
+ */
+int TestRunFillHandle();
+
 }
 #endif
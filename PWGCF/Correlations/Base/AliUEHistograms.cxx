@@ -28,6 +28,7 @@
 #include "AliBasicParticle.h"
 #include "AliVParticle.h"
 #include "AliAODTrack.h"
+#include "AliTHn.h"
 
 #include "TList.h"
 #include "TCanvas.h"
@@ -77,7 +78,23 @@ AliUEHistograms::AliUEHistograms(const char* name, const char* histograms, const
   fTwoTrackCutMinRadius(0.8),
   fCheckEventNumberInCorrelation(kFALSE),
   fRunNumber(0),
-  fMergeCount(1)
+  fMergeCount(1),
+  fTriggerPt(),
+  fTriggerPhi(),
+  fTriggerEta(),
+  fTriggerCharge(),
+  fAssocPt(),
+  fAssocPhi(),
+  fAssocEta(),
+  fAssocCharge(),
+  fTwoTrackRadii(),
+  fTriggerDPhiStarTerms(),
+  fAssocDPhiStarTerms(),
+  fPairDPhiStarMin(),
+  fPairDPhiStarMinAbs(),
+  fDPhiStarScan(),
+  fPairBins(),
+  fPairWeights()
 {
   // Constructor
   //
@@ -152,6 +169,8 @@ AliUEHistograms::AliUEHistograms(const char* name, const char* histograms, const
       configStr += "Sparse";
     else if (histogramsStr.Contains("D"))
       configStr += "Double";
+    else if (histogramsStr.Contains("P"))
+      configStr += "Paged";
     
     fNumberDensityPhi = new AliUEHist(configStr, binningStr);
   }
@@ -248,7 +267,23 @@ AliUEHistograms::AliUEHistograms(const AliUEHistograms &c) :
   fTwoTrackCutMinRadius(0.8),
   fCheckEventNumberInCorrelation(kFALSE),
   fRunNumber(0),
-  fMergeCount(1)
+  fMergeCount(1),
+  fTriggerPt(),
+  fTriggerPhi(),
+  fTriggerEta(),
+  fTriggerCharge(),
+  fAssocPt(),
+  fAssocPhi(),
+  fAssocEta(),
+  fAssocCharge(),
+  fTwoTrackRadii(),
+  fTriggerDPhiStarTerms(),
+  fAssocDPhiStarTerms(),
+  fPairDPhiStarMin(),
+  fPairDPhiStarMinAbs(),
+  fDPhiStarScan(),
+  fPairBins(),
+  fPairWeights()
 {
   //
   // AliUEHistograms copy constructor
@@ -549,6 +584,9 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
   //
   // if mixed is non-0, mixed events are filled, the trigger particle is from particles, the associated from mixed
   // if weight < 0, then the pt of the associated particle is filled as weight
+  //
+  // the kinematics of all particles are cached in structure-of-arrays buffers at the beginning, so that the pair loop
+  // does not call virtual functions. The pairs are collected as global bins and flushed into the track container in blocks.
   
   Bool_t fillpT = kFALSE;
   if (weight < 0)
@@ -566,11 +604,15 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
     TH1::AddDirectory(oldStatus);
   }
 
-  // Eta() is extremely time consuming, therefore cache it for the inner loop here:
-  TObjArray* input = (mixed) ? mixed : particles;
-  TArrayF eta(input->GetEntriesFast());
-  for (Int_t i=0; i<input->GetEntriesFast(); i++)
-    eta[i] = ((AliVParticle*) input->UncheckedAt(i))->Eta();
+  // Eta() is extremely time consuming, therefore cache it (and the other kinematic variables) for the pair loop here:
+  FillParticleBuffer(particles, fTriggerPt, fTriggerPhi, fTriggerEta, fTriggerCharge);
+  if (mixed)
+    FillParticleBuffer(mixed, fAssocPt, fAssocPhi, fAssocEta, fAssocCharge);
+  
+  const Double_t* assocPt = (mixed) ? &fAssocPt[0] : &fTriggerPt[0];
+  const Double_t* assocPhi = (mixed) ? &fAssocPhi[0] : &fTriggerPhi[0];
+  const Float_t* eta = (mixed) ? &fAssocEta[0] : &fTriggerEta[0];
+  const Short_t* assocCharge = (mixed) ? &fAssocCharge[0] : &fTriggerCharge[0];
   
   // if particles is not set, just fill event statistics
   if (particles)
@@ -579,6 +621,36 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
     if (mixed)
       jMax = mixed->GetEntriesFast();
     
+    // terms of dphi* which only depend on one particle of the pair, calculated once for all radii
+    const Double_t* triggerTerms = 0;
+    const Double_t* assocTerms = 0;
+    Int_t nTerms = 0;
+    if (twoTrackEfficiencyCut)
+    {
+      fTwoTrackRadii.clear();
+      for (Double_t rad=fTwoTrackCutMinRadius; rad<2.51; rad+=0.01) 
+	fTwoTrackRadii.push_back(rad);
+      // last entry is only used for the boundary check, it is not part of the scan
+      fTwoTrackRadii.push_back(2.5);
+      nTerms = fTwoTrackRadii.size();
+      
+      FillDPhiStarTerms(particles->GetEntriesFast(), &fTriggerPt[0], &fTriggerCharge[0], bSign, fTriggerDPhiStarTerms);
+      triggerTerms = &fTriggerDPhiStarTerms[0];
+      assocTerms = triggerTerms;
+      if (mixed)
+      {
+	FillDPhiStarTerms(jMax, assocPt, assocCharge, bSign, fAssocDPhiStarTerms);
+	assocTerms = &fAssocDPhiStarTerms[0];
+      }
+    }
+    
+    // pairs are filled in blocks into the track container if it provides direct bin access
+    AliCFContainer* trackHist = fNumberDensityPhi->GetTrackHist(AliUEHist::kToward);
+    AliTHnBase* trackHistTHn = dynamic_cast<AliTHnBase*> (trackHist);
+    const UInt_t kPairBufferSize = 16384;
+    fPairBins.clear();
+    fPairWeights.clear();
+    
     TH1* triggerWeighting = 0;
     if (fWeightPerEvent)
     {
@@ -587,10 +659,8 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
     
       for (Int_t i=0; i<particles->GetEntriesFast(); i++)
       {
-	AliVParticle* triggerParticle = (AliVParticle*) particles->UncheckedAt(i);
-	
 	// some optimization
-	Float_t triggerEta = triggerParticle->Eta();
+	Float_t triggerEta = fTriggerEta[i];
 
 	if (fTriggerRestrictEta > 0 && TMath::Abs(triggerEta) > fTriggerRestrictEta)
 	  continue;
@@ -602,10 +672,10 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	}
 	
 	if (fTriggerSelectCharge != 0)
-	  if (triggerParticle->Charge() * fTriggerSelectCharge < 0)
+	  if (fTriggerCharge[i] * fTriggerSelectCharge < 0)
 	    continue;
 	
-	triggerWeighting->Fill(triggerParticle->Pt());
+	triggerWeighting->Fill(fTriggerPt[i]);
       }
     }
     
@@ -665,14 +735,14 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	  else if (mixed && triggerParticle->IsEqual(particle))
 	    continue;
 	  
-	  if (triggerParticle->Charge() * particle->Charge() > 0)
+	  if (fTriggerCharge[i] * assocCharge[j] > 0)
 	    continue;
       
-	  Float_t mass = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerParticle->Eta(), triggerParticle->Phi(), particle->Pt(), particle->Eta(), particle->Phi(), massDaughter1, massDaughter2);
+	  Float_t mass = GetInvMassSquaredCheap(fTriggerPt[i], fTriggerEta[i], fTriggerPhi[i], assocPt[j], eta[j], assocPhi[j], massDaughter1, massDaughter2);
 	      
 	  if (TMath::Abs(mass - resonanceMass*resonanceMass) < interval*5)
 	  {
-	    mass = GetInvMassSquared(triggerParticle->Pt(), triggerParticle->Eta(), triggerParticle->Phi(), particle->Pt(), particle->Eta(), particle->Phi(), massDaughter1, massDaughter2);
+	    mass = GetInvMassSquared(fTriggerPt[i], fTriggerEta[i], fTriggerPhi[i], assocPt[j], eta[j], assocPhi[j], massDaughter1, massDaughter2);
 
 	    if (mass > (resonanceMass-interval)*(resonanceMass-interval) && mass < (resonanceMass+interval)*(resonanceMass+interval))
 	    {
@@ -691,7 +761,10 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
       AliVParticle* triggerParticle = (AliVParticle*) particles->UncheckedAt(i);
       
       // some optimization
-      Float_t triggerEta = triggerParticle->Eta();
+      Float_t triggerEta = fTriggerEta[i];
+      Double_t triggerPt = fTriggerPt[i];
+      Double_t triggerPhi = fTriggerPhi[i];
+      Short_t triggerCharge = fTriggerCharge[i];
       
       if (fTriggerRestrictEta > 0 && TMath::Abs(triggerEta) > fTriggerRestrictEta)
 	continue;
@@ -703,7 +776,7 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
       }
       
       if (fTriggerSelectCharge != 0)
-	if (triggerParticle->Charge() * fTriggerSelectCharge < 0)
+	if (triggerCharge * fTriggerSelectCharge < 0)
 	  continue;
 	
       if (fRejectResonanceDaughters > 0)
@@ -713,6 +786,10 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	  continue;
 	}
 	
+      // dphi*_min for the whole block of associated particles
+      if (twoTrackEfficiencyCut)
+	TwoTrackCutKernel(jMax, triggerEta, triggerPhi, triggerTerms + i * nTerms, eta, assocPhi, assocTerms, twoTrackEfficiencyCutValue);
+	
       for (Int_t j=0; j<jMax; j++)
       {
         if (!mixed && i == j)
@@ -739,21 +816,21 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
           continue;
         
         if (fPtOrder)
-	  if (particle->Pt() >= triggerParticle->Pt())
+	  if (assocPt[j] >= triggerPt)
 	    continue;
 	
 	if (fAssociatedSelectCharge != 0)
-	  if (particle->Charge() * fAssociatedSelectCharge < 0)
+	  if (assocCharge[j] * fAssociatedSelectCharge < 0)
 	    continue;
 
         if (fSelectCharge > 0)
         {
           // skip like sign
-          if (fSelectCharge == 1 && particle->Charge() * triggerParticle->Charge() > 0)
+          if (fSelectCharge == 1 && assocCharge[j] * triggerCharge > 0)
             continue;
             
           // skip unlike sign
-          if (fSelectCharge == 2 && particle->Charge() * triggerParticle->Charge() < 0)
+          if (fSelectCharge == 2 && assocCharge[j] * triggerCharge < 0)
             continue;
         }
         
@@ -773,13 +850,13 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	  }
 
 	// conversions
-	if (fCutConversionsV > 0 && particle->Charge() * triggerParticle->Charge() < 0)
+	if (fCutConversionsV > 0 && assocCharge[j] * triggerCharge < 0)
 	{
-	  Float_t mass = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.510e-3, 0.510e-3);
+	  Float_t mass = GetInvMassSquaredCheap(triggerPt, triggerEta, triggerPhi, assocPt[j], eta[j], assocPhi[j], 0.510e-3, 0.510e-3);
 	  
 	  if (mass < fCutConversionsV * 5)
 	  {
-	    mass = GetInvMassSquared(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.510e-3, 0.510e-3);
+	    mass = GetInvMassSquared(triggerPt, triggerEta, triggerPhi, assocPt[j], eta[j], assocPhi[j], 0.510e-3, 0.510e-3);
 	    
 	    fControlConvResoncances->Fill(0.0, mass);
 
@@ -789,15 +866,15 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	}
 	
 	// K0s
-	if (fCutResonancesV > 0 && particle->Charge() * triggerParticle->Charge() < 0)
+	if (fCutResonancesV > 0 && assocCharge[j] * triggerCharge < 0)
 	{
-	  Float_t mass = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.1396, 0.1396);
+	  Float_t mass = GetInvMassSquaredCheap(triggerPt, triggerEta, triggerPhi, assocPt[j], eta[j], assocPhi[j], 0.1396, 0.1396);
 	  
 	  const Float_t kK0smass = 0.4976;
 	  
 	  if (TMath::Abs(mass - kK0smass*kK0smass) < fCutResonancesV * 5)
 	  {
-	    mass = GetInvMassSquared(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.1396, 0.1396);
+	    mass = GetInvMassSquared(triggerPt, triggerEta, triggerPhi, assocPt[j], eta[j], assocPhi[j], 0.1396, 0.1396);
 	    
 	    fControlConvResoncances->Fill(1, mass - kK0smass*kK0smass);
 
@@ -807,16 +884,16 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	}
 	
 	// Lambda
-	if (fCutResonancesV > 0 && particle->Charge() * triggerParticle->Charge() < 0)
+	if (fCutResonancesV > 0 && assocCharge[j] * triggerCharge < 0)
 	{
-	  Float_t mass1 = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.1396, 0.9383);
-	  Float_t mass2 = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.9383, 0.1396);
+	  Float_t mass1 = GetInvMassSquaredCheap(triggerPt, triggerEta, triggerPhi, assocPt[j], eta[j], assocPhi[j], 0.1396, 0.9383);
+	  Float_t mass2 = GetInvMassSquaredCheap(triggerPt, triggerEta, triggerPhi, assocPt[j], eta[j], assocPhi[j], 0.9383, 0.1396);
 	  
 	  const Float_t kLambdaMass = 1.115;
 
 	  if (TMath::Abs(mass1 - kLambdaMass*kLambdaMass) < fCutResonancesV * 5)
 	  {
-	    mass1 = GetInvMassSquared(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.1396, 0.9383);
+	    mass1 = GetInvMassSquared(triggerPt, triggerEta, triggerPhi, assocPt[j], eta[j], assocPhi[j], 0.1396, 0.9383);
 
 	    fControlConvResoncances->Fill(2, mass1 - kLambdaMass*kLambdaMass);
 	    
@@ -825,7 +902,7 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	  }
 	  if (TMath::Abs(mass2 - kLambdaMass*kLambdaMass) < fCutResonancesV * 5)
 	  {
-	    mass2 = GetInvMassSquared(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.9383, 0.1396);
+	    mass2 = GetInvMassSquared(triggerPt, triggerEta, triggerPhi, assocPt[j], eta[j], assocPhi[j], 0.9383, 0.1396);
 
 	    fControlConvResoncances->Fill(2, mass2 - kLambdaMass*kLambdaMass);
 
@@ -838,62 +915,32 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	{
 	  // the variables & cuthave been developed by the HBT group 
 	  // see e.g. https://indico.cern.ch/materialDisplay.py?contribId=36&sessionId=6&materialId=slides&confId=142700
-
-	  Float_t phi1 = triggerParticle->Phi();
-	  Float_t pt1 = triggerParticle->Pt();
-	  Float_t charge1 = triggerParticle->Charge();
-	    
-	  Float_t phi2 = particle->Phi();
-	  Float_t pt2 = particle->Pt();
-	  Float_t charge2 = particle->Charge();
-	      
-	  Float_t deta = triggerEta - eta[j];
-	      
-	  // optimization
-	  if (TMath::Abs(deta) < twoTrackEfficiencyCutValue * 2.5 * 3)
+	  // dphi*_min has been calculated for the whole block above (TwoTrackCutKernel), negative if the pair is not close
+	  
+	  if (fPairDPhiStarMinAbs[j] >= 0)
 	  {
-	    // check first boundaries to see if is worth to loop and find the minimum
-	    Float_t dphistar1 = GetDPhiStar(phi1, pt1, charge1, phi2, pt2, charge2, fTwoTrackCutMinRadius, bSign);
-	    Float_t dphistar2 = GetDPhiStar(phi1, pt1, charge1, phi2, pt2, charge2, 2.5, bSign);
+	    Float_t deta = triggerEta - eta[j];
+	    Float_t dphistarmin = fPairDPhiStarMin[j];
+	    Float_t dpt = TMath::Abs((Float_t) triggerPt - (Float_t) assocPt[j]);
 	    
-	    const Float_t kLimit = twoTrackEfficiencyCutValue * 3;
-
-	    Float_t dphistarminabs = 1e5;
-	    Float_t dphistarmin = 1e5;
-	    if (TMath::Abs(dphistar1) < kLimit || TMath::Abs(dphistar2) < kLimit || dphistar1 * dphistar2 < 0)
+	    fTwoTrackDistancePt[0]->Fill(deta, dphistarmin, dpt);
+	    
+	    if (fPairDPhiStarMinAbs[j] < twoTrackEfficiencyCutValue && TMath::Abs(deta) < twoTrackEfficiencyCutValue)
 	    {
-	      for (Double_t rad=fTwoTrackCutMinRadius; rad<2.51; rad+=0.01) 
-	      {
-		Float_t dphistar = GetDPhiStar(phi1, pt1, charge1, phi2, pt2, charge2, rad, bSign);
-
-		Float_t dphistarabs = TMath::Abs(dphistar);
-		
-		if (dphistarabs < dphistarminabs)
-		{
-		  dphistarmin = dphistar;
-		  dphistarminabs = dphistarabs;
-		}
-	      }
-	      
-	      fTwoTrackDistancePt[0]->Fill(deta, dphistarmin, TMath::Abs(pt1 - pt2));
-	      
-	      if (dphistarminabs < twoTrackEfficiencyCutValue && TMath::Abs(deta) < twoTrackEfficiencyCutValue)
-	      {
-// 		Printf("Removed track pair %d %d with %f %f %f %f %f %f %f %f %f", i, j, deta, dphistarminabs, phi1, pt1, charge1, phi2, pt2, charge2, bSign);
-		continue;
-	      }
-
-    	      fTwoTrackDistancePt[1]->Fill(deta, dphistarmin, TMath::Abs(pt1 - pt2));
+// 	      Printf("Removed track pair %d %d with %f %f", i, j, deta, fPairDPhiStarMinAbs[j]);
+	      continue;
 	    }
+
+	    fTwoTrackDistancePt[1]->Fill(deta, dphistarmin, dpt);
 	  }
 	}
         
         Double_t vars[6];
         vars[0] = triggerEta - eta[j];
-        vars[1] = particle->Pt();
-        vars[2] = triggerParticle->Pt();
+        vars[1] = assocPt[j];
+        vars[2] = triggerPt;
         vars[3] = centrality;
-        vars[4] = triggerParticle->Phi() - particle->Phi();
+        vars[4] = triggerPhi - assocPhi[j];
         if (vars[4] > 1.5 * TMath::Pi()) 
           vars[4] -= TMath::TwoPi();
         if (vars[4] < -0.5 * TMath::Pi())
@@ -901,7 +948,7 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	vars[5] = zVtx;
 	
 	if (fillpT)
-	  weight = particle->Pt();
+	  weight = assocPt[j];
 	
 	Double_t useWeight = weight;
 	if (applyEfficiency)
@@ -939,7 +986,19 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	}
     
         // fill all in toward region and do not use the other regions
-	fNumberDensityPhi->GetTrackHist(AliUEHist::kToward)->Fill(vars, step, useWeight);
+	if (trackHistTHn)
+	{
+	  Long64_t bin = trackHistTHn->GetGlobalBin(vars);
+	  if (bin >= 0)
+	  {
+	    fPairBins.push_back(bin);
+	    fPairWeights.push_back(useWeight);
+	    if (fPairBins.size() >= kPairBufferSize)
+	      FlushPairBuffer(trackHist, step);
+	  }
+	}
+	else
+	  trackHist->Fill(vars, step, useWeight);
 
 // 	Printf("%.2f %.2f --> %.2f", triggerEta, eta[j], vars[0]);
       }
@@ -948,7 +1007,7 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
       {
         // once per trigger particle
         Double_t vars[3];
-        vars[0] = triggerParticle->Pt();
+        vars[0] = triggerPt;
         vars[1] = centrality;
 	vars[2] = zVtx;
 
@@ -965,8 +1024,8 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	  useWeight *= fEfficiencyCorrectionTriggers->GetBinContent(effVars);
 	}
 
-	if (TMath::Abs(triggerEta) < 0.8 && triggerParticle->Pt() > 0)
-	  fInvYield2->Fill(centrality, triggerParticle->Pt(), useWeight / triggerParticle->Pt());
+	if (TMath::Abs(triggerEta) < 0.8 && triggerPt > 0)
+	  fInvYield2->Fill(centrality, triggerPt, useWeight / triggerPt);
 
 	if (fWeightPerEvent)
 	{
@@ -979,16 +1038,19 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
         fNumberDensityPhi->GetEventHist()->Fill(vars, step, useWeight);
 
 	// QA
-        fCorrelationpT->Fill(centrality, triggerParticle->Pt());
+        fCorrelationpT->Fill(centrality, triggerPt);
         fCorrelationEta->Fill(centrality, triggerEta);
-        fCorrelationPhi->Fill(centrality, triggerParticle->Phi());
-	fYields->Fill(centrality, triggerParticle->Pt(), triggerEta);
+        fCorrelationPhi->Fill(centrality, triggerPhi);
+	fYields->Fill(centrality, triggerPt, triggerEta);
 	
 /*        if (dynamic_cast<AliAODTrack*>(triggerParticle))
           fITSClusterMap->Fill(((AliAODTrack*) triggerParticle)->GetITSClusterMap(), centrality, triggerParticle->Pt());*/
       }
     }
     
+    // flush remaining pairs of this event
+    FlushPairBuffer(trackHist, step);
+    
     if (triggerWeighting)
     {
       delete triggerWeighting;
@@ -1000,6 +1062,141 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
   fCentralityCorrelation->Fill(centrality, particles->GetEntriesFast());
   FillEvent(centrality, step);
 }
+
+//____________________________________________________________________
+void AliUEHistograms::FillParticleBuffer(TObjArray* list, std::vector<Double_t>& pt, std::vector<Double_t>& phi, std::vector<Float_t>& eta, std::vector<Short_t>& charge)
+{
+  // copies the kinematics of the particles in <list> into the given arrays (structure of arrays)
+  // one additional element is allocated so that the arrays are never empty
+  
+  Int_t n = (list) ? list->GetEntriesFast() : 0;
+  
+  pt.resize(n+1);
+  phi.resize(n+1);
+  eta.resize(n+1);
+  charge.resize(n+1);
+  
+  for (Int_t i=0; i<n; i++)
+  {
+    AliVParticle* particle = (AliVParticle*) list->UncheckedAt(i);
+    pt[i] = particle->Pt();
+    phi[i] = particle->Phi();
+    eta[i] = particle->Eta();
+    charge[i] = particle->Charge();
+  }
+}
+
+//____________________________________________________________________
+void AliUEHistograms::FillDPhiStarTerms(Int_t n, const Double_t* pt, const Short_t* charge, Float_t bSign, std::vector<Double_t>& terms)
+{
+  // calculates the single-particle terms of dphi* (see GetDPhiStar) for all radii in fTwoTrackRadii
+  // terms[i * nRadii + r] = charge_i * bSign * asin(0.075 * r / pT_i)
+  
+  const Int_t nTerms = fTwoTrackRadii.size();
+  terms.resize(n * nTerms + 1);
+  
+  for (Int_t i=0; i<n; i++)
+  {
+    // same precision as in GetDPhiStar
+    Float_t pt1 = pt[i];
+    Float_t charge1 = charge[i];
+    Double_t* row = &terms[i * nTerms];
+    
+    for (Int_t r=0; r<nTerms; r++)
+      row[r] = charge1 * bSign * TMath::ASin(0.075 * fTwoTrackRadii[r] / pt1);
+  }
+}
+
+//____________________________________________________________________
+void AliUEHistograms::TwoTrackCutKernel(Int_t n, Float_t triggerEta, Float_t triggerPhi, const Double_t* triggerTerms, const Float_t* eta, const Double_t* phi, const Double_t* terms, Float_t twoTrackEfficiencyCutValue)
+{
+  // calculates dphi*_min between the trigger particle and a block of <n> associated particles
+  // the result is stored in fPairDPhiStarMin and fPairDPhiStarMinAbs; the latter is -1 for pairs which are not close
+  //
+  // the radius scan operates on the precomputed terms of FillDPhiStarTerms, its loops have no branches in their body
+  // and are vectorized by the compiler. The result is identical to calling GetDPhiStar for each radius.
+  
+  const Int_t nTerms = fTwoTrackRadii.size();
+  const Int_t nScan = nTerms - 1;
+  const Float_t kLimit = twoTrackEfficiencyCutValue * 3;
+  static const Double_t kPi = TMath::Pi();
+  
+  fPairDPhiStarMin.resize(n+1);
+  fPairDPhiStarMinAbs.resize(n+1);
+  fDPhiStarScan.resize(nTerms);
+  Float_t* scan = &fDPhiStarScan[0];
+  
+  for (Int_t j=0; j<n; j++)
+  {
+    fPairDPhiStarMin[j] = 1e5;
+    fPairDPhiStarMinAbs[j] = -1;
+    
+    Float_t deta = triggerEta - eta[j];
+    
+    // optimization
+    if (!(TMath::Abs(deta) < twoTrackEfficiencyCutValue * 2.5 * 3))
+      continue;
+    
+    Float_t dphi = triggerPhi - (Float_t) phi[j];
+    const Double_t* assocTerms = terms + j * nTerms;
+    
+    // check first boundaries to see if is worth to scan and find the minimum
+    Float_t dphistar1 = FoldDPhiStar(dphi - triggerTerms[0] + assocTerms[0]);
+    Float_t dphistar2 = FoldDPhiStar(dphi - triggerTerms[nScan] + assocTerms[nScan]);
+    
+    if (!(TMath::Abs(dphistar1) < kLimit || TMath::Abs(dphistar2) < kLimit || dphistar1 * dphistar2 < 0))
+      continue;
+    
+    for (Int_t r=0; r<nScan; r++)
+    {
+      Float_t dphistar = dphi - triggerTerms[r] + assocTerms[r];
+      dphistar = (dphistar > kPi) ? kPi * 2 - dphistar : dphistar;
+      dphistar = (dphistar < -kPi) ? -kPi * 2 - dphistar : dphistar;
+      dphistar = (dphistar > kPi) ? kPi * 2 - dphistar : dphistar;
+      scan[r] = dphistar;
+    }
+    
+    Float_t dphistarminabs = 1e5;
+    for (Int_t r=0; r<nScan; r++)
+    {
+      Float_t dphistarabs = TMath::Abs(scan[r]);
+      dphistarminabs = (dphistarabs < dphistarminabs) ? dphistarabs : dphistarminabs;
+    }
+    
+    // signed value of the first minimum (as in the sequential scan)
+    Float_t dphistarmin = 1e5;
+    for (Int_t r=0; r<nScan; r++)
+      if (TMath::Abs(scan[r]) == dphistarminabs)
+      {
+	dphistarmin = scan[r];
+	break;
+      }
+    
+    fPairDPhiStarMin[j] = dphistarmin;
+    fPairDPhiStarMinAbs[j] = dphistarminabs;
+  }
+}
+
+//____________________________________________________________________
+void AliUEHistograms::FlushPairBuffer(AliCFContainer* target, Int_t step)
+{
+  // fills the pairs collected in fPairBins/fPairWeights into <target> and empties the buffer
+  
+  if (fPairBins.size() == 0)
+    return;
+  
+  AliTHnBase* targetTHn = dynamic_cast<AliTHnBase*> (target);
+  if (!targetTHn)
+  {
+    AliFatal("Pair buffer can only be flushed into AliTHn containers");
+    return;
+  }
+  
+  targetTHn->FillBins(step, fPairBins.size(), &fPairBins[0], &fPairWeights[0]);
+  
+  fPairBins.clear();
+  fPairWeights.clear();
+}
   
 //____________________________________________________________________
 void AliUEHistograms::FillTrackingEfficiency(TObjArray* mc, TObjArray* recoPrim, TObjArray* recoAll, TObjArray* recoPrimPID, TObjArray* recoAllPID, TObjArray* fake, Int_t particleType, Double_t centrality, Double_t zVtx)
@@ -12,6 +12,7 @@
 #include "AliUEHist.h"
 #include "TMath.h"
 #include "THn.h" // in cxx file causes .../THn.h:257: error: conflicting declaration ‘typedef class THnT<float> THnF’
+#include <vector>
 
 class AliVParticle;
 
@@ -113,6 +114,11 @@ protected:
   inline Float_t GetInvMassSquared(Float_t pt1, Float_t eta1, Float_t phi1, Float_t pt2, Float_t eta2, Float_t phi2, Float_t m0_1, Float_t m0_2);
   inline Float_t GetInvMassSquaredCheap(Float_t pt1, Float_t eta1, Float_t phi1, Float_t pt2, Float_t eta2, Float_t phi2, Float_t m0_1, Float_t m0_2);
   inline Float_t GetDPhiStar(Float_t phi1, Float_t pt1, Float_t charge1, Float_t phi2, Float_t pt2, Float_t charge2, Float_t radius, Float_t bSign);
+  inline Float_t FoldDPhiStar(Float_t dphistar);
+  void FillParticleBuffer(TObjArray* list, std::vector<Double_t>& pt, std::vector<Double_t>& phi, std::vector<Float_t>& eta, std::vector<Short_t>& charge);
+  void FillDPhiStarTerms(Int_t n, const Double_t* pt, const Short_t* charge, Float_t bSign, std::vector<Double_t>& terms);
+  void TwoTrackCutKernel(Int_t n, Float_t triggerEta, Float_t triggerPhi, const Double_t* triggerTerms, const Float_t* eta, const Double_t* phi, const Double_t* terms, Float_t twoTrackEfficiencyCutValue);
+  void FlushPairBuffer(AliCFContainer* target, Int_t step);
   
   static const Int_t fgkUEHists; // number of histograms
 
@@ -163,6 +169,24 @@ protected:
   
   Int_t fMergeCount;		// counts how many objects have been merged together
   
+  // structure-of-arrays buffers for the pair loop in FillCorrelations (filled once per call)
+  std::vector<Double_t> fTriggerPt;      //! pT of trigger particles
+  std::vector<Double_t> fTriggerPhi;     //! phi of trigger particles
+  std::vector<Float_t>  fTriggerEta;     //! eta of trigger particles
+  std::vector<Short_t>  fTriggerCharge;  //! charge of trigger particles
+  std::vector<Double_t> fAssocPt;        //! pT of associated particles (mixed event only)
+  std::vector<Double_t> fAssocPhi;       //! phi of associated particles (mixed event only)
+  std::vector<Float_t>  fAssocEta;       //! eta of associated particles (mixed event only)
+  std::vector<Short_t>  fAssocCharge;    //! charge of associated particles (mixed event only)
+  std::vector<Float_t>  fTwoTrackRadii;      //! radii scanned for the dphi* minimum
+  std::vector<Double_t> fTriggerDPhiStarTerms; //! per trigger particle and radius: charge * bSign * asin(0.075 * r / pT)
+  std::vector<Double_t> fAssocDPhiStarTerms;   //! per associated particle and radius: charge * bSign * asin(0.075 * r / pT) (mixed event only)
+  std::vector<Float_t>  fPairDPhiStarMin;    //! per associated particle: signed dphi*_min w.r.t. the current trigger particle
+  std::vector<Float_t>  fPairDPhiStarMinAbs; //! per associated particle: |dphi*_min| (-1 if the pair is not close)
+  std::vector<Float_t>  fDPhiStarScan;       //! scratch space for the radius scan
+  std::vector<Long64_t> fPairBins;       //! global bins of pairs to be filled into the track container
+  std::vector<Double_t> fPairWeights;    //! weights of pairs to be filled into the track container
+  
   ClassDef(AliUEHistograms, 31)  // underlying event histogram container
 };
 
@@ -174,6 +198,13 @@ Float_t AliUEHistograms::GetDPhiStar(Float_t phi1, Float_t pt1, Float_t charge1,
   
   Float_t dphistar = phi1 - phi2 - charge1 * bSign * TMath::ASin(0.075 * radius / pt1) + charge2 * bSign * TMath::ASin(0.075 * radius / pt2);
   
+  return FoldDPhiStar(dphistar);
+}
+
+Float_t AliUEHistograms::FoldDPhiStar(Float_t dphistar)
+{
+  // folds dphistar into -pi...pi
+  
   static const Double_t kPi = TMath::Pi();
   
   // circularity
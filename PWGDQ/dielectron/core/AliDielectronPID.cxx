@@ -180,6 +180,7 @@ void AliDielectronPID::AddCut(DetType det, AliPID::EParticleType type, Double_t
     return;
   }
   fFunUpperCut[fNcuts]=funUp;
+  fUsedVars->SetBitNumber(AliDielectronVarManager::kPIn,kTRUE); // functions are evaluated at the inner momentum
   AddCut(det,type,nSigmaLow,0.,min,max,exclude,pidBitType,var);
 }
 
@@ -196,6 +197,7 @@ void AliDielectronPID::AddCut(DetType det, AliPID::EParticleType type, TF1 * con
     return;
   }
   fFunLowerCut[fNcuts]=funLow;
+  fUsedVars->SetBitNumber(AliDielectronVarManager::kPIn,kTRUE); // functions are evaluated at the inner momentum
   AddCut(det,type,0.,nSigmaUp,min,max,exclude,pidBitType,var);
 }
 
@@ -213,6 +215,7 @@ void AliDielectronPID::AddCut(DetType det, AliPID::EParticleType type, TF1 * con
   }
   fFunUpperCut[fNcuts]=funUp;
   fFunLowerCut[fNcuts]=funLow;
+  fUsedVars->SetBitNumber(AliDielectronVarManager::kPIn,kTRUE); // functions are evaluated at the inner momentum
   AddCut(det,type,0.,0.,min,max,exclude,pidBitType,var);
 }
 
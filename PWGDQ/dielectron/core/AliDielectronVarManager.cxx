@@ -658,6 +658,11 @@ TH3D*           AliDielectronVarManager::fgTRDpidEff[10][4] = {{0x0}};
 TObject*        AliDielectronVarManager::fgLegEffMap           = 0x0;
 TObject*        AliDielectronVarManager::fgPairEffMap          = 0x0;
 TBits*          AliDielectronVarManager::fgFillMap          = 0x0;
+TBits           AliDielectronVarManager::fgFillMapDeps;
+UInt_t          AliDielectronVarManager::fgFillPlan         = 0;
+Bool_t          AliDielectronVarManager::fgFillPlanValid    = kFALSE;
+TBits           AliDielectronVarManager::fgLegEffVars;
+Bool_t          AliDielectronVarManager::fgLegEffVarsValid  = kFALSE;
 Double_t        AliDielectronVarManager::fgTRDpidEffCentRanges[10][4] = {{0.0}};
 TString         AliDielectronVarManager::fgVZEROCalibrationFile = "";
 TString         AliDielectronVarManager::fgVZERORecenteringFile = "";
@@ -752,3 +757,177 @@ UInt_t AliDielectronVarManager::GetValueType(const char* valname) {
   }
   return -1;
 }
+
+namespace {
+  // kernel of FillVarESDtrack which computes a given variable. Pair variables
+  // which are built from leg values are attached to the kernel of the leg value.
+  struct VarKernel { Int_t var; Int_t kernel; };
+  const VarKernel kVarKernels[] = {
+    {AliDielectronVarManager::kITSFakeFlag,       AliDielectronVarManager::kKernelTrackQuality},
+    {AliDielectronVarManager::kNclsTPC,           AliDielectronVarManager::kKernelTrackQuality},
+    {AliDielectronVarManager::kNclsSTPC,          AliDielectronVarManager::kKernelTrackQuality},
+    {AliDielectronVarManager::kNclsSFracTPC,      AliDielectronVarManager::kKernelTrackQuality},
+    {AliDielectronVarManager::kNclsTPCiter1,      AliDielectronVarManager::kKernelTrackQuality},
+    {AliDielectronVarManager::kNFclsTPC,          AliDielectronVarManager::kKernelTrackQuality},
+    {AliDielectronVarManager::kNFclsTPCr,         AliDielectronVarManager::kKernelTrackQuality},
+    {AliDielectronVarManager::kNFclsTPCrFrac,     AliDielectronVarManager::kKernelTrackQuality},
+    {AliDielectronVarManager::kNFclsTPCfCross,    AliDielectronVarManager::kKernelTrackQuality},
+    {AliDielectronVarManager::kTPCsignalN,        AliDielectronVarManager::kKernelTrackQuality},
+    {AliDielectronVarManager::kTPCsignalNfrac,    AliDielectronVarManager::kKernelTrackQuality},
+    {AliDielectronVarManager::kNclsTRD,           AliDielectronVarManager::kKernelTrackQuality},
+    {AliDielectronVarManager::kTRDntracklets,     AliDielectronVarManager::kKernelTrackQuality},
+    {AliDielectronVarManager::kTRDpidQuality,     AliDielectronVarManager::kKernelTrackQuality},
+    {AliDielectronVarManager::kTRDchi2,           AliDielectronVarManager::kKernelTrackQuality},
+    {AliDielectronVarManager::kTRDchi2Trklt,      AliDielectronVarManager::kKernelTrackQuality},
+    {AliDielectronVarManager::kTRDsignal,         AliDielectronVarManager::kKernelTrackQuality},
+    {AliDielectronVarManager::kTPCclsDiff,        AliDielectronVarManager::kKernelTrackQuality},
+    {AliDielectronVarManager::kNclsITS,           AliDielectronVarManager::kKernelTrackQuality},
+    {AliDielectronVarManager::kNclsSITS,          AliDielectronVarManager::kKernelTrackQuality},
+    {AliDielectronVarManager::kNclsSFracITS,      AliDielectronVarManager::kKernelTrackQuality},
+    {AliDielectronVarManager::kNclsSMapITS,       AliDielectronVarManager::kKernelTrackQuality},
+    {AliDielectronVarManager::kTrackStatus,       AliDielectronVarManager::kKernelTrackQuality},
+    {AliDielectronVarManager::kFilterBit,         AliDielectronVarManager::kKernelTrackQuality},
+    {AliDielectronVarManager::kTPCchi2Cl,         AliDielectronVarManager::kKernelTrackQuality},
+    {AliDielectronVarManager::kITSchi2Cl,         AliDielectronVarManager::kKernelTrackQuality},
+    {AliDielectronVarManager::kV0Index0,          AliDielectronVarManager::kKernelTrackQuality},
+    {AliDielectronVarManager::kKinkIndex0,        AliDielectronVarManager::kKernelTrackQuality},
+    {AliDielectronVarManager::kTPCclsSegments,    AliDielectronVarManager::kKernelTPCClusterMap},
+    {AliDielectronVarManager::kTPCclsIRO,         AliDielectronVarManager::kKernelTPCClusterMap},
+    {AliDielectronVarManager::kTPCclsORO,         AliDielectronVarManager::kKernelTPCClusterMap},
+    {AliDielectronVarManager::kTRDprobEle,        AliDielectronVarManager::kKernelTRDProb},
+    {AliDielectronVarManager::kTRDprobPio,        AliDielectronVarManager::kKernelTRDProb},
+    {AliDielectronVarManager::kImpactParXY,       AliDielectronVarManager::kKernelImpactPar},
+    {AliDielectronVarManager::kImpactParZ,        AliDielectronVarManager::kKernelImpactPar},
+    {AliDielectronVarManager::kImpactParXYsigma,  AliDielectronVarManager::kKernelImpactPar},
+    {AliDielectronVarManager::kImpactParZsigma,   AliDielectronVarManager::kKernelImpactPar},
+    {AliDielectronVarManager::kITSsignal,         AliDielectronVarManager::kKernelITSsignal},
+    {AliDielectronVarManager::kITSsignalSSD1,     AliDielectronVarManager::kKernelITSsignal},
+    {AliDielectronVarManager::kITSsignalSSD2,     AliDielectronVarManager::kKernelITSsignal},
+    {AliDielectronVarManager::kITSsignalSDD1,     AliDielectronVarManager::kKernelITSsignal},
+    {AliDielectronVarManager::kITSsignalSDD2,     AliDielectronVarManager::kKernelITSsignal},
+    {AliDielectronVarManager::kITSclusterMap,     AliDielectronVarManager::kKernelITSsignal},
+    {AliDielectronVarManager::kITSLayerFirstCls,  AliDielectronVarManager::kKernelITSsignal},
+    {AliDielectronVarManager::kTrackLength,       AliDielectronVarManager::kKernelTrackParam},
+    {AliDielectronVarManager::kPIn,               AliDielectronVarManager::kKernelTrackParam},
+    {AliDielectronVarManager::kYsignedIn,         AliDielectronVarManager::kKernelTrackParam},
+    {AliDielectronVarManager::kPOut,              AliDielectronVarManager::kKernelTrackParam},
+    {AliDielectronVarManager::kTRDphi,            AliDielectronVarManager::kKernelTrackParam},
+    {AliDielectronVarManager::kTRDpidEffLeg,      AliDielectronVarManager::kKernelTrackParam},
+    {AliDielectronVarManager::kTRDpidEffPair,     AliDielectronVarManager::kKernelTrackParam},
+    {AliDielectronVarManager::kTOFsignal,         AliDielectronVarManager::kKernelTOF},
+    {AliDielectronVarManager::kTOFbeta,           AliDielectronVarManager::kKernelTOF},
+    {AliDielectronVarManager::kTOFPIDBit,         AliDielectronVarManager::kKernelTOF},
+    {AliDielectronVarManager::kTOFmismProb,       AliDielectronVarManager::kKernelTOF},
+    {AliDielectronVarManager::kTPCnSigmaEleRaw,   AliDielectronVarManager::kKernelTPCPID},
+    {AliDielectronVarManager::kTPCnSigmaEle,      AliDielectronVarManager::kKernelTPCPID},
+    {AliDielectronVarManager::kTPCnSigmaPio,      AliDielectronVarManager::kKernelTPCPID},
+    {AliDielectronVarManager::kTPCnSigmaMuo,      AliDielectronVarManager::kKernelTPCPID},
+    {AliDielectronVarManager::kTPCnSigmaKao,      AliDielectronVarManager::kKernelTPCPID},
+    {AliDielectronVarManager::kTPCnSigmaPro,      AliDielectronVarManager::kKernelTPCPID},
+    {AliDielectronVarManager::kITSnSigmaEleRaw,   AliDielectronVarManager::kKernelITSPID},
+    {AliDielectronVarManager::kITSnSigmaEle,      AliDielectronVarManager::kKernelITSPID},
+    {AliDielectronVarManager::kITSnSigmaPio,      AliDielectronVarManager::kKernelITSPID},
+    {AliDielectronVarManager::kITSnSigmaMuo,      AliDielectronVarManager::kKernelITSPID},
+    {AliDielectronVarManager::kITSnSigmaKao,      AliDielectronVarManager::kKernelITSPID},
+    {AliDielectronVarManager::kITSnSigmaPro,      AliDielectronVarManager::kKernelITSPID},
+    {AliDielectronVarManager::kTOFnSigmaEleRaw,   AliDielectronVarManager::kKernelTOFPID},
+    {AliDielectronVarManager::kTOFnSigmaEle,      AliDielectronVarManager::kKernelTOFPID},
+    {AliDielectronVarManager::kTOFnSigmaPio,      AliDielectronVarManager::kKernelTOFPID},
+    {AliDielectronVarManager::kTOFnSigmaMuo,      AliDielectronVarManager::kKernelTOFPID},
+    {AliDielectronVarManager::kTOFnSigmaKao,      AliDielectronVarManager::kKernelTOFPID},
+    {AliDielectronVarManager::kTOFnSigmaPro,      AliDielectronVarManager::kKernelTOFPID},
+    {AliDielectronVarManager::kEMCALnSigmaEle,    AliDielectronVarManager::kKernelEMCAL},
+    {AliDielectronVarManager::kEMCALEoverP,       AliDielectronVarManager::kKernelEMCAL},
+    {AliDielectronVarManager::kEMCALE,            AliDielectronVarManager::kKernelEMCAL},
+    {AliDielectronVarManager::kEMCALNCells,       AliDielectronVarManager::kKernelEMCAL},
+    {AliDielectronVarManager::kEMCALM02,          AliDielectronVarManager::kKernelEMCAL},
+    {AliDielectronVarManager::kEMCALM20,          AliDielectronVarManager::kKernelEMCAL},
+    {AliDielectronVarManager::kEMCALDispersion,   AliDielectronVarManager::kKernelEMCAL},
+    {AliDielectronVarManager::kLegEff,            AliDielectronVarManager::kKernelLegEff},
+    {AliDielectronVarManager::kOneOverLegEff,     AliDielectronVarManager::kKernelLegEff},
+    {AliDielectronVarManager::kPairEff,           AliDielectronVarManager::kKernelLegEff},
+    {AliDielectronVarManager::kOneOverPairEff,    AliDielectronVarManager::kKernelLegEff},
+    {AliDielectronVarManager::kOneOverPairEffSq,  AliDielectronVarManager::kKernelLegEff},
+    {AliDielectronVarManager::kTRDeta,            AliDielectronVarManager::kKernelTRDGeometry},
+    {AliDielectronVarManager::kTPCActiveLength,   AliDielectronVarManager::kKernelTRDGeometry},
+    {AliDielectronVarManager::kTPCGeomLength,     AliDielectronVarManager::kKernelTRDGeometry},
+    {AliDielectronVarManager::kInTRDacceptance,   AliDielectronVarManager::kKernelTRDGeometry}
+  };
+  const Int_t kNVarKernels = sizeof(kVarKernels)/sizeof(VarKernel);
+
+  // variables which are computed from the values of other variables
+  struct VarDependency { Int_t var; Int_t dependsOn; };
+  const VarDependency kVarDependencies[] = {
+    {AliDielectronVarManager::kOneOverLegEff,     AliDielectronVarManager::kLegEff},
+    {AliDielectronVarManager::kPairEff,           AliDielectronVarManager::kLegEff},
+    {AliDielectronVarManager::kOneOverPairEff,    AliDielectronVarManager::kPairEff},
+    {AliDielectronVarManager::kOneOverPairEffSq,  AliDielectronVarManager::kPairEff},
+    {AliDielectronVarManager::kTRDpidEffPair,     AliDielectronVarManager::kTRDpidEffLeg},
+    {AliDielectronVarManager::kTRDpidEffLeg,      AliDielectronVarManager::kEta},
+    {AliDielectronVarManager::kTRDpidEffLeg,      AliDielectronVarManager::kTRDphi},
+    {AliDielectronVarManager::kTRDpidEffLeg,      AliDielectronVarManager::kPOut},
+    {AliDielectronVarManager::kNFclsTPCfCross,    AliDielectronVarManager::kNFclsTPC},
+    {AliDielectronVarManager::kNFclsTPCfCross,    AliDielectronVarManager::kNFclsTPCr},
+    {AliDielectronVarManager::kTPCGeomLength,     AliDielectronVarManager::kTPCActiveLength},
+    {AliDielectronVarManager::kInTRDacceptance,   AliDielectronVarManager::kTRDeta}
+  };
+  const Int_t kNVarDependencies = sizeof(kVarDependencies)/sizeof(VarDependency);
+}
+
+//________________________________________________________________
+void AliDielectronVarManager::AddDependencies(TBits *map)
+{
+  //
+  // Add to the map all variables needed to compute the requested ones,
+  // including the axes of the current single leg efficiency map
+  //
+  if (!map) return;
+  Bool_t changed=kTRUE;
+  while (changed) {
+    changed=kFALSE;
+    for (Int_t i=0; i<kNVarDependencies; ++i) {
+      if (!map->TestBitNumber(kVarDependencies[i].var) || map->TestBitNumber(kVarDependencies[i].dependsOn)) continue;
+      map->SetBitNumber(kVarDependencies[i].dependsOn);
+      changed=kTRUE;
+    }
+  }
+
+  if (map->TestBitNumber(kLegEff)) {
+    // the axis names are only looked up once per SetLegEffMap
+    if (!fgLegEffVarsValid) {
+      fgLegEffVars.ResetAllBits();
+      if (fgLegEffMap && fgLegEffMap->InheritsFrom(THnBase::Class())) {
+        THnBase *eff = static_cast<THnBase*>(fgLegEffMap);
+        for (Int_t idim=0; idim<eff->GetNdimensions(); ++idim) {
+          UInt_t var = GetValueType(eff->GetAxis(idim)->GetName());
+          if (var<kNMaxValues) fgLegEffVars.SetBitNumber(var);
+        }
+      }
+      fgLegEffVarsValid=kTRUE;
+    }
+    (*map)|=fgLegEffVars;
+  }
+}
+
+//________________________________________________________________
+void AliDielectronVarManager::BuildFillPlan()
+{
+  //
+  // Complete the current fill map with the variables the requested ones
+  // depend on and translate it into the set of track kernels which have
+  // to run in FillVarESDtrack. Without a map all kernels run.
+  //
+  fgFillPlanValid=kTRUE;
+  if (!fgFillMap) {
+    fgFillPlan=(1u<<kNFillKernels)-1;
+    return;
+  }
+
+  fgFillMapDeps.ResetAllBits();
+  fgFillMapDeps|=(*fgFillMap);
+  AddDependencies(&fgFillMapDeps);
+
+  fgFillPlan=0;
+  for (Int_t i=0; i<kNVarKernels; ++i)
+    if (fgFillMapDeps.TestBitNumber(kVarKernels[i].var)) SETBIT(fgFillPlan,kVarKernels[i].kernel);
+}
@@ -682,6 +682,25 @@ public:
     // TODO: (for A+A) ZDCEnergy, impact parameter, Iflag??
   };
 
+  // groups of track variables which are computed together in FillVarESDtrack;
+  // a group is only evaluated if at least one of its variables is requested
+  enum EFillKernel {
+    kKernelTrackQuality=0,   // cluster counts, chi2, status, indices
+    kKernelTPCClusterMap,    // TPC cluster map segments
+    kKernelTRDProb,          // TRD pid probabilities
+    kKernelImpactPar,        // impact parameters and their significance
+    kKernelITSsignal,        // ITS dE/dx samples and cluster map
+    kKernelTrackParam,       // inner/outer parameters, TRD phi and pid efficiency
+    kKernelTOF,              // TOF signal, beta and mismatch probability
+    kKernelTPCPID,           // TPC nsigma
+    kKernelITSPID,           // ITS nsigma
+    kKernelTOFPID,           // TOF nsigma
+    kKernelEMCAL,            // EMCAL matching and shower shape
+    kKernelLegEff,           // single leg efficiency
+    kKernelTRDGeometry,      // propagation to the TRD and active TPC length
+    kNFillKernels
+  };
+
 
   AliDielectronVarManager();
   AliDielectronVarManager(const char* name, const char* title);
@@ -695,9 +714,10 @@ public:
   static void InitEstimatorAvg(const Char_t* filename);
   static void InitEstimatorObjArrayAvg(const TObjArray* array);
   static void InitTRDpidEffHistograms(const Char_t* filename);
-  static void SetLegEffMap( TObject *map) { fgLegEffMap=map; }
+  static void SetLegEffMap( TObject *map) { fgLegEffMap=map; fgLegEffVarsValid=kFALSE; fgFillPlanValid=kFALSE; }
   static void SetPairEffMap(TObject *map) { fgPairEffMap=map; }
-  static void SetFillMap(   TBits   *map) { fgFillMap=map; }
+  static void SetFillMap(   TBits   *map) { fgFillMap=map; fgFillPlanValid=kFALSE; }
+  static void AddDependencies(TBits *map);
   static void SetVZEROCalibrationFile(const Char_t* filename) {fgVZEROCalibrationFile = filename;}
 
   static void SetVZERORecenteringFile(const Char_t* filename) {fgVZERORecenteringFile = filename;}
@@ -735,7 +755,9 @@ private:
 
   static const char* fgkParticleNames[kNMaxValues][3];  //variable names
 
-  static Bool_t Req(ValueTypes var) { return (fgFillMap ? fgFillMap->TestBitNumber(var) : kTRUE); }
+  static Bool_t Req(ValueTypes var);
+  static UInt_t GetFillPlan();
+  static void BuildFillPlan();
   static void FillVarESDtrack(const AliESDtrack *particle,           Double_t * const values);
   static void FillVarAODTrack(const AliAODTrack *particle,           Double_t * const values);
   static void FillVarVTrdTrack(const AliVParticle *particle,         Double_t * const values);
@@ -765,6 +787,11 @@ private:
   static TObject         *fgLegEffMap;             // single electron efficiencies
   static TObject         *fgPairEffMap;             // pair efficiencies
   static TBits           *fgFillMap;             // map for requested variable filling
+  static TBits            fgFillMapDeps;         //! fill map plus the variables the requested ones depend on
+  static UInt_t           fgFillPlan;            //! kernels needed for the current fill map
+  static Bool_t           fgFillPlanValid;       //! fill plan is up to date with the fill map
+  static TBits            fgLegEffVars;          //! axis variables of the single leg efficiency map
+  static Bool_t           fgLegEffVarsValid;     //! fgLegEffVars is up to date with the leg efficiency map
   static TString          fgVZEROCalibrationFile;  // file with VZERO channel-by-channel calibrations
   static TString          fgVZERORecenteringFile;  // file with VZERO Q-vector averages needed for event plane recentering
   static TProfile2D      *fgVZEROCalib[64];           // 1 histogram per VZERO channel
@@ -866,6 +893,25 @@ inline void AliDielectronVarManager::FillVarVParticle(const AliVParticle *partic
     values[i]=fgData[i];
 }
 
+inline Bool_t AliDielectronVarManager::Req(ValueTypes var)
+{
+  //
+  // is the variable requested by the current fill map, directly or as input of another one
+  //
+  if (!fgFillMap) return kTRUE;
+  if (!fgFillPlanValid) BuildFillPlan();
+  return fgFillMapDeps.TestBitNumber(var);
+}
+
+inline UInt_t AliDielectronVarManager::GetFillPlan()
+{
+  //
+  // kernels to run for the current fill map, rebuilt after each SetFillMap and SetLegEffMap
+  //
+  if (!fgFillPlanValid) BuildFillPlan();
+  return fgFillPlan;
+}
+
 inline void AliDielectronVarManager::FillVarESDtrack(const AliESDtrack *particle, Double_t * const values)
 {
   //
@@ -883,91 +929,102 @@ inline void AliDielectronVarManager::FillVarESDtrack(const AliESDtrack *particle
   if (!esdTrack) return;
   esdTrack->SetTPCsignal(origdEdx/AliDielectronPID::GetEtaCorr(esdTrack)/AliDielectronPID::GetCorrValdEdx(),esdTrack->GetTPCsignalSigma(),esdTrack->GetTPCsignalN());
 
+  // only the kernels needed by the current fill map are evaluated,
+  // in the order of their dependencies
+  const UInt_t plan=GetFillPlan();
+
   Double_t pidProbs[AliPID::kSPECIES];
   // Fill AliESDtrack interface specific information
   Double_t tpcNcls=particle->GetTPCNcls();
-  Double_t tpcNclsS = particle->GetTPCnclsS();
-  Double_t itsNcls=particle->GetNcls(0);
-  Double_t tpcSignalN=particle->GetTPCsignalN();
-  Double_t tpcClusFindable=particle->GetTPCNclsF();
-  values[AliDielectronVarManager::kITSFakeFlag]   = particle->GetITSFakeFlag();
-  values[AliDielectronVarManager::kNclsTPC]       = tpcNcls; // TODO: get rid of the plain numbers
-  values[AliDielectronVarManager::kNclsSTPC]      = tpcNclsS;
-  values[AliDielectronVarManager::kNclsSFracTPC]  = tpcNcls>0?tpcNclsS/tpcNcls:0;
-  values[AliDielectronVarManager::kNclsTPCiter1]  = particle->GetTPCNclsIter1(); // TODO: get rid of the plain numbers
-  values[AliDielectronVarManager::kNFclsTPC]       = tpcClusFindable;
-  values[AliDielectronVarManager::kNFclsTPCr]      = particle->GetTPCClusterInfo(2,1);
-  values[AliDielectronVarManager::kNFclsTPCrFrac]  = particle->GetTPCClusterInfo(2);
-  values[AliDielectronVarManager::kNFclsTPCfCross]= (tpcClusFindable>0)?(particle->GetTPCClusterInfo(2,1)/tpcClusFindable):0;
-  values[AliDielectronVarManager::kTPCsignalN]    = tpcSignalN;
-  values[AliDielectronVarManager::kTPCsignalNfrac]= tpcNcls>0?tpcSignalN/tpcNcls:0;
-  values[AliDielectronVarManager::kNclsTRD]       = particle->GetNcls(2); // TODO: get rid of the plain numbers
-  values[AliDielectronVarManager::kTRDntracklets] = particle->GetTRDntracklets(); // TODO: GetTRDtracklets/GetTRDntracklets?
-  values[AliDielectronVarManager::kTRDpidQuality] = particle->GetTRDntrackletsPID();
-  values[AliDielectronVarManager::kTRDchi2]       = particle->GetTRDchi2();
-  values[AliDielectronVarManager::kTRDchi2Trklt]  = (particle->GetTRDntrackletsPID() > 0 ? particle->GetTRDchi2() / particle->GetTRDntrackletsPID() : -1.);
-  values[AliDielectronVarManager::kTRDsignal]     = particle->GetTRDsignal();
-  values[AliDielectronVarManager::kTPCclsDiff]    = tpcSignalN-tpcNcls;
-  values[AliDielectronVarManager::kTPCclsSegments] = 0.0;
+  if (TESTBIT(plan,kKernelTrackQuality)) {
+    Double_t tpcNclsS = particle->GetTPCnclsS();
+    Double_t itsNcls=particle->GetNcls(0);
+    Double_t tpcSignalN=particle->GetTPCsignalN();
+    Double_t tpcClusFindable=particle->GetTPCNclsF();
+    values[AliDielectronVarManager::kITSFakeFlag]   = particle->GetITSFakeFlag();
+    values[AliDielectronVarManager::kNclsTPC]       = tpcNcls; // TODO: get rid of the plain numbers
+    values[AliDielectronVarManager::kNclsSTPC]      = tpcNclsS;
+    values[AliDielectronVarManager::kNclsSFracTPC]  = tpcNcls>0?tpcNclsS/tpcNcls:0;
+    values[AliDielectronVarManager::kNclsTPCiter1]  = particle->GetTPCNclsIter1(); // TODO: get rid of the plain numbers
+    values[AliDielectronVarManager::kNFclsTPC]       = tpcClusFindable;
+    values[AliDielectronVarManager::kNFclsTPCr]      = particle->GetTPCClusterInfo(2,1);
+    values[AliDielectronVarManager::kNFclsTPCrFrac]  = particle->GetTPCClusterInfo(2);
+    values[AliDielectronVarManager::kNFclsTPCfCross]= (tpcClusFindable>0)?(particle->GetTPCClusterInfo(2,1)/tpcClusFindable):0;
+    values[AliDielectronVarManager::kTPCsignalN]    = tpcSignalN;
+    values[AliDielectronVarManager::kTPCsignalNfrac]= tpcNcls>0?tpcSignalN/tpcNcls:0;
+    values[AliDielectronVarManager::kNclsTRD]       = particle->GetNcls(2); // TODO: get rid of the plain numbers
+    values[AliDielectronVarManager::kTRDntracklets] = particle->GetTRDntracklets(); // TODO: GetTRDtracklets/GetTRDntracklets?
+    values[AliDielectronVarManager::kTRDpidQuality] = particle->GetTRDntrackletsPID();
+    values[AliDielectronVarManager::kTRDchi2]       = particle->GetTRDchi2();
+    values[AliDielectronVarManager::kTRDchi2Trklt]  = (particle->GetTRDntrackletsPID() > 0 ? particle->GetTRDchi2() / particle->GetTRDntrackletsPID() : -1.);
+    values[AliDielectronVarManager::kTRDsignal]     = particle->GetTRDsignal();
+    values[AliDielectronVarManager::kTPCclsDiff]    = tpcSignalN-tpcNcls;
 
-  Double_t itsNclsS = 0.;
-  for(int i=0; i<6; i++){
-    if( particle->HasSharedPointOnITSLayer(i) )   itsNclsS ++;
-  }
-  values[AliDielectronVarManager::kNclsITS]      = itsNcls;
-  values[AliDielectronVarManager::kNclsSITS]     = itsNclsS;
-  values[AliDielectronVarManager::kNclsSFracITS] = itsNcls ? itsNclsS/ itsNcls :0;
-  values[AliDielectronVarManager::kNclsSMapITS]  = particle->GetITSSharedMap();
+    Double_t itsNclsS = 0.;
+    for(int i=0; i<6; i++){
+      if( particle->HasSharedPointOnITSLayer(i) )   itsNclsS ++;
+    }
+    values[AliDielectronVarManager::kNclsITS]      = itsNcls;
+    values[AliDielectronVarManager::kNclsSITS]     = itsNclsS;
+    values[AliDielectronVarManager::kNclsSFracITS] = itsNcls ? itsNclsS/ itsNcls :0;
+    values[AliDielectronVarManager::kNclsSMapITS]  = particle->GetITSSharedMap();
 
+    values[AliDielectronVarManager::kTrackStatus]   = (Double_t)particle->GetStatus();
+    values[AliDielectronVarManager::kFilterBit]     = 0;
 
-  UChar_t threshold = 5;
-  TBits tpcClusterMap = particle->GetTPCClusterMap();
-  UChar_t n=0; UChar_t j=0;
-  for(UChar_t i=0; i<8; ++i) {
-    n=0;
-    for(j=i*20; j<(i+1)*20 && j<159; ++j) n+=tpcClusterMap.TestBitNumber(j);
-    if(n>=threshold) values[AliDielectronVarManager::kTPCclsSegments] += 1.0;
+    values[AliDielectronVarManager::kTPCchi2Cl] = -1;
+    if (tpcNcls>0) values[AliDielectronVarManager::kTPCchi2Cl] = particle->GetTPCchi2() / tpcNcls;
+    values[AliDielectronVarManager::kITSchi2Cl] = -1;
+    if (itsNcls>0) values[AliDielectronVarManager::kITSchi2Cl] = particle->GetITSchi2() / itsNcls;
+
+    values[AliDielectronVarManager::kV0Index0]      = particle->GetV0Index(0);
+    values[AliDielectronVarManager::kKinkIndex0]    = particle->GetKinkIndex(0);
   }
 
-  n=0;
-  threshold=0;
-  values[AliDielectronVarManager::kTPCclsIRO]=0.;
-  for(j=0; j<63; ++j) n+=tpcClusterMap.TestBitNumber(j);
-  if(n>=threshold) values[AliDielectronVarManager::kTPCclsIRO] = n;
-  n=0;
-  threshold=0;
-  values[AliDielectronVarManager::kTPCclsORO]=0.;
-  for(j=63; j<159; ++j) n+=tpcClusterMap.TestBitNumber(j);
-  if(n>=threshold) values[AliDielectronVarManager::kTPCclsORO] = n;
+  if (TESTBIT(plan,kKernelTPCClusterMap)) {
+    values[AliDielectronVarManager::kTPCclsSegments] = 0.0;
+    UChar_t threshold = 5;
+    TBits tpcClusterMap = particle->GetTPCClusterMap();
+    UChar_t n=0; UChar_t j=0;
+    for(UChar_t i=0; i<8; ++i) {
+      n=0;
+      for(j=i*20; j<(i+1)*20 && j<159; ++j) n+=tpcClusterMap.TestBitNumber(j);
+      if(n>=threshold) values[AliDielectronVarManager::kTPCclsSegments] += 1.0;
+    }
 
-  values[AliDielectronVarManager::kTrackStatus]   = (Double_t)particle->GetStatus();
-  values[AliDielectronVarManager::kFilterBit]     = 0;
+    n=0;
+    threshold=0;
+    values[AliDielectronVarManager::kTPCclsIRO]=0.;
+    for(j=0; j<63; ++j) n+=tpcClusterMap.TestBitNumber(j);
+    if(n>=threshold) values[AliDielectronVarManager::kTPCclsIRO] = n;
+    n=0;
+    threshold=0;
+    values[AliDielectronVarManager::kTPCclsORO]=0.;
+    for(j=63; j<159; ++j) n+=tpcClusterMap.TestBitNumber(j);
+    if(n>=threshold) values[AliDielectronVarManager::kTPCclsORO] = n;
+  }
 
-  values[AliDielectronVarManager::kTPCchi2Cl] = -1;
-  if (tpcNcls>0) values[AliDielectronVarManager::kTPCchi2Cl] = particle->GetTPCchi2() / tpcNcls;
-  values[AliDielectronVarManager::kITSchi2Cl] = -1;
-  if (itsNcls>0) values[AliDielectronVarManager::kITSchi2Cl] = particle->GetITSchi2() / itsNcls;
   //TRD pidProbs
-  particle->GetTRDpid(pidProbs);
-  values[AliDielectronVarManager::kTRDprobEle]    = pidProbs[AliPID::kElectron];
-  values[AliDielectronVarManager::kTRDprobPio]    = pidProbs[AliPID::kPion];
-
-  values[AliDielectronVarManager::kV0Index0]      = particle->GetV0Index(0);
-  values[AliDielectronVarManager::kKinkIndex0]    = particle->GetKinkIndex(0);
-
-  Float_t impactParXY, impactParZ;
-  particle->GetImpactParameters(impactParXY, impactParZ);
-  values[AliDielectronVarManager::kImpactParXY]   = impactParXY;
-  values[AliDielectronVarManager::kImpactParZ]    = impactParZ;
-  values[AliDielectronVarManager::kImpactParXYsigma]   = -1.;
-  values[AliDielectronVarManager::kImpactParZsigma]    = -1.;
+  if (TESTBIT(plan,kKernelTRDProb)) {
+    particle->GetTRDpid(pidProbs);
+    values[AliDielectronVarManager::kTRDprobEle]    = pidProbs[AliPID::kElectron];
+    values[AliDielectronVarManager::kTRDprobPio]    = pidProbs[AliPID::kPion];
+  }
 
-  Float_t dca[2] = {-999.,-999.};
-  Float_t dcaRes[3] = {-999.,-999.,-999.};
-  esdTrack->GetImpactParameters(dca, dcaRes);
-  if(dcaRes[0]>0.) values[AliDielectronVarManager::kImpactParXYsigma] = dca[0]/TMath::Sqrt(dcaRes[0]);
-  if(dcaRes[2]>0.) values[AliDielectronVarManager::kImpactParZsigma]  = dca[1]/TMath::Sqrt(dcaRes[2]);
+  if (TESTBIT(plan,kKernelImpactPar)) {
+    Float_t impactParXY, impactParZ;
+    particle->GetImpactParameters(impactParXY, impactParZ);
+    values[AliDielectronVarManager::kImpactParXY]   = impactParXY;
+    values[AliDielectronVarManager::kImpactParZ]    = impactParZ;
+    values[AliDielectronVarManager::kImpactParXYsigma]   = -1.;
+    values[AliDielectronVarManager::kImpactParZsigma]    = -1.;
 
+    Float_t dca[2] = {-999.,-999.};
+    Float_t dcaRes[3] = {-999.,-999.,-999.};
+    esdTrack->GetImpactParameters(dca, dcaRes);
+    if(dcaRes[0]>0.) values[AliDielectronVarManager::kImpactParXYsigma] = dca[0]/TMath::Sqrt(dcaRes[0]);
+    if(dcaRes[2]>0.) values[AliDielectronVarManager::kImpactParZsigma]  = dca[1]/TMath::Sqrt(dcaRes[2]);
+  }
 
   values[AliDielectronVarManager::kPdgCode]=-1;
   values[AliDielectronVarManager::kPdgCodeMother]=-1;
@@ -1011,125 +1068,139 @@ inline void AliDielectronVarManager::FillVarESDtrack(const AliESDtrack *particle
   } //if(mc->HasMC())
 
 
-  values[AliDielectronVarManager::kITSsignal]   =   particle->GetITSsignal();
-  Double_t itsdEdx[4];
-  particle->GetITSdEdxSamples(itsdEdx);
+  if (TESTBIT(plan,kKernelITSsignal)) {
+    values[AliDielectronVarManager::kITSsignal]   =   particle->GetITSsignal();
+    Double_t itsdEdx[4];
+    particle->GetITSdEdxSamples(itsdEdx);
 
-  values[AliDielectronVarManager::kITSsignalSSD1]   =   itsdEdx[0];
-  values[AliDielectronVarManager::kITSsignalSSD2]   =   itsdEdx[1];
-  values[AliDielectronVarManager::kITSsignalSDD1]   =   itsdEdx[2];
-  values[AliDielectronVarManager::kITSsignalSDD2]   =   itsdEdx[3];
-  values[AliDielectronVarManager::kITSclusterMap]   =   particle->GetITSClusterMap();
-  values[AliDielectronVarManager::kITSLayerFirstCls] = -1.;
+    values[AliDielectronVarManager::kITSsignalSSD1]   =   itsdEdx[0];
+    values[AliDielectronVarManager::kITSsignalSSD2]   =   itsdEdx[1];
+    values[AliDielectronVarManager::kITSsignalSDD1]   =   itsdEdx[2];
+    values[AliDielectronVarManager::kITSsignalSDD2]   =   itsdEdx[3];
+    values[AliDielectronVarManager::kITSclusterMap]   =   particle->GetITSClusterMap();
+    values[AliDielectronVarManager::kITSLayerFirstCls] = -1.;
 
-  for (Int_t iC=0; iC<6; iC++) {
-    if (((particle->GetITSClusterMap()) & (1<<(iC))) > 0) {
-      values[AliDielectronVarManager::kITSLayerFirstCls] = iC;
-      break;
+    for (Int_t iC=0; iC<6; iC++) {
+      if (((particle->GetITSClusterMap()) & (1<<(iC))) > 0) {
+        values[AliDielectronVarManager::kITSLayerFirstCls] = iC;
+        break;
+      }
     }
   }
 
 
-  values[AliDielectronVarManager::kTrackLength]   = particle->GetIntegratedLength();
-  //dEdx information
-  Double_t mom = particle->GetP();
-  const AliExternalTrackParam *in=particle->GetInnerParam();
-  Double_t ysignedIn=-100;
-  if (in) {
-    mom = in->GetP();
-    ysignedIn=particle->Charge()*in->GetY();
-  }
-  values[AliDielectronVarManager::kPIn]=mom;
-  values[AliDielectronVarManager::kYsignedIn]=ysignedIn;
   const AliExternalTrackParam *out=particle->GetOuterParam();
-  if(out) values[AliDielectronVarManager::kPOut] = out->GetP();
-  else values[AliDielectronVarManager::kPOut] = mom;
-  if(out && fgEvent) {
-    Double_t localCoord[3]={0.0};
-    Bool_t localCoordGood = out->GetXYZAt(298.0, ((AliESDEvent*)fgEvent)->GetMagneticField(), localCoord);
-    values[AliDielectronVarManager::kTRDphi] = (localCoordGood && TMath::Abs(localCoord[0])>1.0e-6 && TMath::Abs(localCoord[1])>1.0e-6 ? TMath::ATan2(localCoord[1], localCoord[0]) : -999.);
-  }
-  if(mc->HasMC() && fgTRDpidEff[0][0]) {
-    Int_t runNo = (fgEvent ? fgEvent->GetRunNumber() : -1);
-    Float_t centrality=-1.0;
-    AliCentrality *esdCentrality = (fgEvent ? fgEvent->GetCentrality() : 0x0);
-    if(esdCentrality) centrality = esdCentrality->GetCentralityPercentile("V0M");
-    Double_t effErr=0.0;
-    values[kTRDpidEffLeg] = GetTRDpidEfficiency(runNo, centrality, values[AliDielectronVarManager::kEta],
- 						values[AliDielectronVarManager::kTRDphi],
- 						values[AliDielectronVarManager::kPOut], effErr);
+  if (TESTBIT(plan,kKernelTrackParam)) {
+    values[AliDielectronVarManager::kTrackLength]   = particle->GetIntegratedLength();
+    //dEdx information
+    Double_t mom = particle->GetP();
+    const AliExternalTrackParam *in=particle->GetInnerParam();
+    Double_t ysignedIn=-100;
+    if (in) {
+      mom = in->GetP();
+      ysignedIn=particle->Charge()*in->GetY();
+    }
+    values[AliDielectronVarManager::kPIn]=mom;
+    values[AliDielectronVarManager::kYsignedIn]=ysignedIn;
+    if(out) values[AliDielectronVarManager::kPOut] = out->GetP();
+    else values[AliDielectronVarManager::kPOut] = mom;
+    if(out && fgEvent) {
+      Double_t localCoord[3]={0.0};
+      Bool_t localCoordGood = out->GetXYZAt(298.0, ((AliESDEvent*)fgEvent)->GetMagneticField(), localCoord);
+      values[AliDielectronVarManager::kTRDphi] = (localCoordGood && TMath::Abs(localCoord[0])>1.0e-6 && TMath::Abs(localCoord[1])>1.0e-6 ? TMath::ATan2(localCoord[1], localCoord[0]) : -999.);
+    }
+    if(mc->HasMC() && fgTRDpidEff[0][0]) {
+      Int_t runNo = (fgEvent ? fgEvent->GetRunNumber() : -1);
+      Float_t centrality=-1.0;
+      AliCentrality *esdCentrality = (fgEvent ? fgEvent->GetCentrality() : 0x0);
+      if(esdCentrality) centrality = esdCentrality->GetCentralityPercentile("V0M");
+      Double_t effErr=0.0;
+      values[kTRDpidEffLeg] = GetTRDpidEfficiency(runNo, centrality, values[AliDielectronVarManager::kEta],
+   						values[AliDielectronVarManager::kTRDphi],
+   						values[AliDielectronVarManager::kPOut], effErr);
+    }
   }
 
 
-
-
-
   values[AliDielectronVarManager::kTPCsignal]=particle->GetTPCsignal();
 
-  values[AliDielectronVarManager::kTOFsignal]=particle->GetTOFsignal();
+  if (TESTBIT(plan,kKernelTOF)) {
+    values[AliDielectronVarManager::kTOFsignal]=particle->GetTOFsignal();
 
-  Double_t l = particle->GetIntegratedLength();  // cm
-  Double_t t = particle->GetTOFsignal();
-  Double_t t0 = fgPIDResponse->GetTOFResponse().GetTimeZero(); // ps
+    Double_t l = particle->GetIntegratedLength();  // cm
+    Double_t t = particle->GetTOFsignal();
+    Double_t t0 = fgPIDResponse->GetTOFResponse().GetTimeZero(); // ps
 
-  if( (l < 360. || l > 800.) || (t <= 0.) || (t0 >999990.0) ) {
-	values[AliDielectronVarManager::kTOFbeta]=0.0;
-  }
-  else {
-	t -= t0; // subtract the T0
-	l *= 0.01;  // cm ->m
-	t *= 1e-12; //ps -> s
+    if( (l < 360. || l > 800.) || (t <= 0.) || (t0 >999990.0) ) {
+  	values[AliDielectronVarManager::kTOFbeta]=0.0;
+    }
+    else {
+  	t -= t0; // subtract the T0
+  	l *= 0.01;  // cm ->m
+  	t *= 1e-12; //ps -> s
 
-	Double_t v = l / t;
-	Float_t beta = v / TMath::C();
-	values[AliDielectronVarManager::kTOFbeta]=beta;
-  }
-  values[AliDielectronVarManager::kTOFPIDBit]=(particle->GetStatus()&AliESDtrack::kTOFpid? 1: 0);
+  	Double_t v = l / t;
+  	Float_t beta = v / TMath::C();
+  	values[AliDielectronVarManager::kTOFbeta]=beta;
+    }
+    values[AliDielectronVarManager::kTOFPIDBit]=(particle->GetStatus()&AliESDtrack::kTOFpid? 1: 0);
 
-  values[AliDielectronVarManager::kTOFmismProb] = fgPIDResponse->GetTOFMismatchProbability(particle);
+    values[AliDielectronVarManager::kTOFmismProb] = fgPIDResponse->GetTOFMismatchProbability(particle);
+  }
 
   // nsigma to Electron band
   // TODO: for the moment we set the bethe bloch parameters manually
   //       this should be changed in future!
-  values[AliDielectronVarManager::kTPCnSigmaEleRaw]= fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kElectron);
-  values[AliDielectronVarManager::kTPCnSigmaEle]   =(fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kElectron) - AliDielectronPID::GetCorrVal() - AliDielectronPID::GetCntrdCorr(particle)) / AliDielectronPID::GetWdthCorr(particle);
-
-  values[AliDielectronVarManager::kTPCnSigmaPio]=fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kPion);
-  values[AliDielectronVarManager::kTPCnSigmaMuo]=fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kMuon);
-  values[AliDielectronVarManager::kTPCnSigmaKao]=fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kKaon);
-  values[AliDielectronVarManager::kTPCnSigmaPro]=fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kProton);
-
-  values[AliDielectronVarManager::kITSnSigmaEleRaw]= fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kElectron);
-  values[AliDielectronVarManager::kITSnSigmaEle]   =(fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kElectron)
-                                                     -AliDielectronPID::GetCntrdCorrITS(particle)
-                                                     ) / AliDielectronPID::GetWdthCorrITS(particle);
-
-  values[AliDielectronVarManager::kITSnSigmaPio]=fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kPion);
-  values[AliDielectronVarManager::kITSnSigmaMuo]=fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kMuon);
-  values[AliDielectronVarManager::kITSnSigmaKao]=fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kKaon);
-  values[AliDielectronVarManager::kITSnSigmaPro]=fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kProton);
-
-  values[AliDielectronVarManager::kTOFnSigmaEleRaw]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kElectron);
-  values[AliDielectronVarManager::kTOFnSigmaEle]   =(fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kElectron) - AliDielectronPID::GetCntrdCorrTOF(particle)) / AliDielectronPID::GetWdthCorrTOF(particle);
-  values[AliDielectronVarManager::kTOFnSigmaPio]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kPion);
-  values[AliDielectronVarManager::kTOFnSigmaMuo]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kMuon);
-  values[AliDielectronVarManager::kTOFnSigmaKao]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kKaon);
-  values[AliDielectronVarManager::kTOFnSigmaPro]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kProton);
+  if (TESTBIT(plan,kKernelTPCPID)) {
+    values[AliDielectronVarManager::kTPCnSigmaEleRaw]= fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kElectron);
+    values[AliDielectronVarManager::kTPCnSigmaEle]   =(fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kElectron) - AliDielectronPID::GetCorrVal() - AliDielectronPID::GetCntrdCorr(particle)) / AliDielectronPID::GetWdthCorr(particle);
+
+    values[AliDielectronVarManager::kTPCnSigmaPio]=fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kPion);
+    values[AliDielectronVarManager::kTPCnSigmaMuo]=fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kMuon);
+    values[AliDielectronVarManager::kTPCnSigmaKao]=fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kKaon);
+    values[AliDielectronVarManager::kTPCnSigmaPro]=fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kProton);
+  }
+
+  if (TESTBIT(plan,kKernelITSPID)) {
+    values[AliDielectronVarManager::kITSnSigmaEleRaw]= fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kElectron);
+    values[AliDielectronVarManager::kITSnSigmaEle]   =(fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kElectron)
+                                                       -AliDielectronPID::GetCntrdCorrITS(particle)
+                                                       ) / AliDielectronPID::GetWdthCorrITS(particle);
+
+    values[AliDielectronVarManager::kITSnSigmaPio]=fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kPion);
+    values[AliDielectronVarManager::kITSnSigmaMuo]=fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kMuon);
+    values[AliDielectronVarManager::kITSnSigmaKao]=fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kKaon);
+    values[AliDielectronVarManager::kITSnSigmaPro]=fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kProton);
+  }
+
+  if (TESTBIT(plan,kKernelTOFPID)) {
+    values[AliDielectronVarManager::kTOFnSigmaEleRaw]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kElectron);
+    values[AliDielectronVarManager::kTOFnSigmaEle]   =(fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kElectron) - AliDielectronPID::GetCntrdCorrTOF(particle)) / AliDielectronPID::GetWdthCorrTOF(particle);
+    values[AliDielectronVarManager::kTOFnSigmaPio]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kPion);
+    values[AliDielectronVarManager::kTOFnSigmaMuo]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kMuon);
+    values[AliDielectronVarManager::kTOFnSigmaKao]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kKaon);
+    values[AliDielectronVarManager::kTOFnSigmaPro]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kProton);
+  }
 
   //EMCAL PID information
-  Double_t eop=0;
-  Double_t showershape[4]={0.,0.,0.,0.};
-//   values[AliDielectronVarManager::kEMCALnSigmaEle]  = fgPIDResponse->NumberOfSigmasEMCAL(particle,AliPID::kElectron);
-  values[AliDielectronVarManager::kEMCALnSigmaEle]  = fgPIDResponse->NumberOfSigmasEMCAL(particle,AliPID::kElectron,eop,showershape);
-  values[AliDielectronVarManager::kEMCALEoverP]     = eop;
-  values[AliDielectronVarManager::kEMCALE]          = eop*values[AliDielectronVarManager::kP];
-  values[AliDielectronVarManager::kEMCALNCells]     = showershape[0];
-  values[AliDielectronVarManager::kEMCALM02]        = showershape[1];
-  values[AliDielectronVarManager::kEMCALM20]        = showershape[2];
-  values[AliDielectronVarManager::kEMCALDispersion] = showershape[3];
+  if (TESTBIT(plan,kKernelEMCAL)) {
+    Double_t eop=0;
+    Double_t showershape[4]={0.,0.,0.,0.};
+  //   values[AliDielectronVarManager::kEMCALnSigmaEle]  = fgPIDResponse->NumberOfSigmasEMCAL(particle,AliPID::kElectron);
+    values[AliDielectronVarManager::kEMCALnSigmaEle]  = fgPIDResponse->NumberOfSigmasEMCAL(particle,AliPID::kElectron,eop,showershape);
+    values[AliDielectronVarManager::kEMCALEoverP]     = eop;
+    values[AliDielectronVarManager::kEMCALE]          = eop*values[AliDielectronVarManager::kP];
+    values[AliDielectronVarManager::kEMCALNCells]     = showershape[0];
+    values[AliDielectronVarManager::kEMCALM02]        = showershape[1];
+    values[AliDielectronVarManager::kEMCALM20]        = showershape[2];
+    values[AliDielectronVarManager::kEMCALDispersion] = showershape[3];
+  }
 
-  values[AliDielectronVarManager::kLegEff]        = GetSingleLegEff(values);
-  values[AliDielectronVarManager::kOneOverLegEff] = (values[AliDielectronVarManager::kLegEff]>0.0 ? 1./values[AliDielectronVarManager::kLegEff] : 0.0);
+  // the efficiency is looked up from the variables filled above
+  if (TESTBIT(plan,kKernelLegEff)) {
+    values[AliDielectronVarManager::kLegEff]        = GetSingleLegEff(values);
+    values[AliDielectronVarManager::kOneOverLegEff] = (values[AliDielectronVarManager::kLegEff]>0.0 ? 1./values[AliDielectronVarManager::kLegEff] : 0.0);
+  }
   //restore TPC signal if it was changed
   if (esdTrack) esdTrack->SetTPCsignal(origdEdx,esdTrack->GetTPCsignalSigma(),esdTrack->GetTPCsignalN());
 
@@ -1137,7 +1208,7 @@ inline void AliDielectronVarManager::FillVarESDtrack(const AliESDtrack *particle
   if(Req(kTRDonlineA)||Req(kTRDonlineLayerMask)||Req(kTRDonlinePID)||Req(kTRDonlinePt)||Req(kTRDonlineStack)||Req(kTRDonlineTrackInTime)||Req(kTRDonlineSector)||Req(kTRDonlineFlagsTiming)||Req(kTRDonlineLabel)||Req(kTRDonlineNTracklets)||Req(kTRDonlineFirstLayer))
     FillVarVTrdTrack(particle,values);
 
-  if( fgEvent && fgEvent->GetMagneticField() ){
+  if( TESTBIT(plan,kKernelTRDGeometry) && fgEvent && fgEvent->GetMagneticField() ){
     if(out){
       AliExternalTrackParam out_tmp(*out);
       out_tmp.PropagateTo(AliTRDgeometry::GetXtrdBeg(), fgEvent->GetMagneticField());
@@ -48,7 +48,13 @@ AliHistogramManager::AliHistogramManager() :
   fBinsAllocated(0),
   fVariableNames(),
   fVariableUnits(),
-  fNVars(0)
+  fNVars(0),
+  fFillTableReady(kFALSE),
+  fNFillClasses(0),
+  fFillClassFirst(0x0),
+  fNFillDescriptors(0),
+  fFillDescriptors(0x0),
+  fFillVars(0x0)
 {
   //
   // Constructor
@@ -70,7 +76,13 @@ AliHistogramManager::AliHistogramManager(const Char_t* name, Int_t nvars) :
   fBinsAllocated(0),
   fVariableNames(),
   fVariableUnits(),
-  fNVars(nvars)
+  fNVars(nvars),
+  fFillTableReady(kFALSE),
+  fNFillClasses(0),
+  fFillClassFirst(0x0),
+  fNFillDescriptors(0),
+  fFillDescriptors(0x0),
+  fFillVars(0x0)
 {
   //
   // Constructor
@@ -95,6 +107,9 @@ AliHistogramManager::~AliHistogramManager()
   if(fMainDirectory) {delete fMainDirectory; fMainDirectory=0x0;}
   if(fHistFile) {delete fHistFile; fHistFile=0x0;}
   //if(fOutputList) {delete fOutputList; fOutputList=0x0;}
+  if(fFillClassFirst) delete [] fFillClassFirst;
+  if(fFillDescriptors) delete [] fFillDescriptors;
+  if(fFillVars) delete [] fFillVars;
 }
 
 //_______________________________________________________________________________
@@ -130,6 +145,7 @@ void AliHistogramManager::AddHistClass(const Char_t* histClass) {
   hList->SetOwner(kTRUE);
   hList->SetName(histClass);
   fMainList.Add(hList);
+  fFillTableReady = kFALSE;
 }
 
 //_________________________________________________________________
@@ -153,6 +169,7 @@ void AliHistogramManager::AddHistogram(const Char_t* histClass,
     cout << "Warning in AliHistogramManager::AddHistogram(): Histogram " << name << " already exists" << endl;
     return;
   }
+  fFillTableReady = kFALSE;
   TString hname = name;
   
   Int_t dimension = 1;
@@ -289,6 +306,7 @@ void AliHistogramManager::AddHistogram(const Char_t* histClass,
     cout << "Warning in AliHistogramManager::AddHistogram(): Histogram " << name << " already exists" << endl;
     return;
   }
+  fFillTableReady = kFALSE;
   TString hname = name;
   
   Int_t dimension = 1;
@@ -427,6 +445,7 @@ void AliHistogramManager::AddHistogram(const Char_t* histClass,
     cout << "Warning in AliHistogramManager::AddHistogram(): Histogram " << name << " already exists" << endl;
     return;
   }
+  fFillTableReady = kFALSE;
   TString hname = name;
   
   TString titleStr(title);
@@ -476,6 +495,7 @@ void AliHistogramManager::AddHistogram(const Char_t* histClass,
     cout << "Warning in AliHistogramManager::AddHistogram(): Histogram " << name << " already exists" << endl;
     return;
   }
+  fFillTableReady = kFALSE;
   TString hname = name;
   
   TString titleStr(title);
@@ -598,6 +618,110 @@ THnF* AliHistogramManager::CreateHistogram( const Char_t* name, const Char_t* ti
 
 
 
+//__________________________________________________________________
+void AliHistogramManager::CompileFillTable() {
+  //
+  // Decode the unique IDs of all histograms into a flat table of fill descriptors.
+  // Each histogram class gets an integer handle (its position in the main list) which is
+  // also stored in the unique ID of the class list.
+  //
+  if(fFillClassFirst) {delete [] fFillClassFirst; fFillClassFirst=0x0;}
+  if(fFillDescriptors) {delete [] fFillDescriptors; fFillDescriptors=0x0;}
+  if(fFillVars) {delete [] fFillVars; fFillVars=0x0;}
+  
+  // count the histograms and variables to allocate the table in one go
+  fNFillClasses = fMainList.GetEntries();
+  Int_t nHists = 0;
+  Int_t nVars = 0;
+  TIter nextClass(&fMainList);
+  THashList* hList = 0x0;
+  while((hList=(THashList*)nextClass())) {
+    nHists += hList->GetEntries();
+    TIter next(hList);
+    TObject* h = 0x0;
+    while((h=next())) {
+      if((h->GetUniqueID()%100)>10) nVars += ((THnF*)h)->GetNdimensions();
+      else nVars += 4;
+    }
+  }
+  fFillClassFirst = new Int_t[fNFillClasses+1];
+  fFillDescriptors = new FillDescriptor[nHists>0 ? nHists : 1];
+  fFillVars = new Int_t[nVars>0 ? nVars : 1];
+  
+  fNFillDescriptors = 0;
+  Int_t iVar = 0;
+  Int_t iClass = 0;
+  nextClass.Reset();
+  while((hList=(THashList*)nextClass())) {
+    hList->SetUniqueID(iClass+1);
+    fFillClassFirst[iClass] = fNFillDescriptors;
+    TIter next(hList);
+    TObject* h = 0x0;
+    while((h=next())) {
+      // decode the histogram unique ID (see AddHistogram())
+      Int_t uid = h->GetUniqueID();
+      Bool_t isProfile = (uid%10==1 ? kTRUE : kFALSE);
+      Bool_t isTHn = ((uid%100)>10 ? kTRUE : kFALSE);
+      uid = (uid-(uid%100))/100;
+      Int_t varT = -1;
+      Int_t varW = AliReducedVarManager::kNothing;
+      if(uid>0) {
+        varW = uid%(fNVars+1)-1;
+        if(varW==0) varW=AliReducedVarManager::kNothing;
+        uid = (uid-(uid%(fNVars+1)))/(fNVars+1);
+        if(uid>0) varT = uid - 1;
+      }
+      if(varW>AliReducedVarManager::kNothing && !fUsedVars[varW]) continue;
+      
+      FillDescriptor& desc = fFillDescriptors[fNFillDescriptors];
+      desc.fHist = h;
+      desc.fVarW = varW;
+      desc.fFirstVar = iVar;
+      Int_t* vars = fFillVars+iVar;
+      if(isTHn) {
+        desc.fType = kFillTHn;
+        desc.fNVars = ((THnF*)h)->GetNdimensions();
+        for(Int_t idim=0;idim<desc.fNVars;++idim) vars[idim] = ((THnF*)h)->GetAxis(idim)->GetUniqueID();
+      }
+      else {
+        TH1* h1 = (TH1*)h;
+        Int_t dimension = h1->GetDimension();
+        vars[0] = h1->GetXaxis()->GetUniqueID();
+        vars[1] = h1->GetYaxis()->GetUniqueID();
+        vars[2] = h1->GetZaxis()->GetUniqueID();
+        vars[3] = varT;
+        // profiles also need the averaged variable(s)
+        desc.fNVars = dimension + (isProfile ? 1 : 0);
+        if(isProfile && dimension==3) desc.fNVars = 4;
+        if(dimension==1) desc.fType = (isProfile ? kFillProfile : kFillTH1);
+        else if(dimension==2) desc.fType = (isProfile ? kFillProfile2D : kFillTH2);
+        else if(dimension==3) desc.fType = (isProfile ? kFillProfile3D : kFillTH3);
+        else continue;
+      }
+      Bool_t allVarsGood = kTRUE;
+      for(Int_t ivar=0;ivar<desc.fNVars;++ivar) 
+        allVarsGood &= (vars[ivar]>=0 && fUsedVars[vars[ivar]]);
+      if(!allVarsGood) continue;
+      iVar += desc.fNVars;
+      ++fNFillDescriptors;
+    }
+    ++iClass;
+  }
+  fFillClassFirst[fNFillClasses] = fNFillDescriptors;
+  fFillTableReady = kTRUE;
+}
+
+//__________________________________________________________________
+Int_t AliHistogramManager::GetHistClassHandle(const Char_t* className) {
+  //
+  // Return the integer handle of a histogram class, to be used with FillHistClass(Int_t, Float_t*)
+  //
+  THashList* hList = (THashList*)fMainList.FindObject(className);
+  if(!hList) return -1;
+  if(!fFillTableReady) CompileFillTable();
+  return Int_t(hList->GetUniqueID())-1;
+}
+
 //__________________________________________________________________
 void AliHistogramManager::FillHistClass(const Char_t* className, Float_t* values) {
   //
@@ -609,129 +733,56 @@ void AliHistogramManager::FillHistClass(const Char_t* className, Float_t* values
     cout << "         Histogram list not filled" << endl; */
     return;
   }
-  if(!hList) {
-    return;
-  }
-    
-  TIter next(hList);
-  TObject* h=0x0;
-  Bool_t isProfile;
-  Bool_t isTHn;
-  Int_t thnDim=0;
+  if(!fFillTableReady) CompileFillTable();
+  FillHistClass(Int_t(hList->GetUniqueID())-1, values);
+}
+
+//__________________________________________________________________
+void AliHistogramManager::FillHistClass(Int_t classHandle, Float_t* values) {
+  //
+  //  fill a class of histograms addressed by its handle
+  //
+  if(!fFillTableReady) CompileFillTable();
+  if(classHandle<0 || classHandle>=fNFillClasses) return;
+  
   Double_t fillValues[20]={0.0};
-  Int_t uid = 0;
-  Int_t varX=-1, varY=-1, varZ=-1, varT=-1, varW=-1;
-  Int_t dimension=0;
-  while((h=next())) {
-    Bool_t allVarsGood = kTRUE;
-    uid = h->GetUniqueID();
-    isProfile = (uid%10==1 ? kTRUE : kFALSE);   // units digit encodes the isProfile
-    isTHn = ((uid%100)>10 ? kTRUE : kFALSE);      
-    if(isTHn) thnDim = (uid%100)-10;        // the excess over 10 from the last 2 digits give the dimension of the THn
-    dimension = 0;
-    if(!isTHn) dimension = ((TH1*)h)->GetDimension();
-        
-    uid = (uid-(uid%100))/100;
-    varX = -1;
-    varY = -1;
-    varZ = -1;
-    varT = -1;
-    varW = -1;
-    if(uid>0) {
-      varW = uid%(fNVars+1)-1;
-      if(varW==0) varW=AliReducedVarManager::kNothing;
-      uid = (uid-(uid%(fNVars+1)))/(fNVars+1);
-      if(uid>0) varT = uid - 1;
-      //cout << "Filling " << h->GetName() << " with varT " << varT << endl;
-    }
-        
-    if(!isTHn) {
-      varX = ((TH1*)h)->GetXaxis()->GetUniqueID();
-      if(fUsedVars[varX]) {
-        switch(dimension) {
-          case 1:
-            if(isProfile) {
-              varY = ((TH1*)h)->GetYaxis()->GetUniqueID();
-              if(!fUsedVars[varY]) break;
-              if(varW>AliReducedVarManager::kNothing) { 
-                if(!fUsedVars[varW]) break;
-                ((TProfile*)h)->Fill(values[varX],values[varY],values[varW]);
-              }
-              else 
-                ((TProfile*)h)->Fill(values[varX],values[varY]);
-            }
-            else {
-              if(varW>AliReducedVarManager::kNothing) {
-                if(!fUsedVars[varW]) break;
-                ((TH1F*)h)->Fill(values[varX],values[varW]);
-              }
-              else
-                ((TH1F*)h)->Fill(values[varX]);
-            }
-          break;
-          case 2:
-            varY = ((TH1*)h)->GetYaxis()->GetUniqueID();
-            if(!fUsedVars[varY]) break;
-            if(isProfile) {
-              varZ = ((TH1*)h)->GetZaxis()->GetUniqueID();
-              if(!fUsedVars[varZ]) break;
-              if(varW>AliReducedVarManager::kNothing) {
-                if(!fUsedVars[varW]) break;
-                ((TProfile2D*)h)->Fill(values[varX],values[varY],values[varZ],values[varW]);
-              }
-              else
-                ((TProfile2D*)h)->Fill(values[varX],values[varY],values[varZ]);        
-            }
-            else {
-              if(varW>AliReducedVarManager::kNothing) {
-                if(!fUsedVars[varW]) break;
-                ((TH2F*)h)->Fill(values[varX],values[varY], values[varW]);
-              }
-              else
-                ((TH2F*)h)->Fill(values[varX],values[varY]);
-            }
-          break;
-          case 3:
-            varY = ((TH1*)h)->GetYaxis()->GetUniqueID();
-            if(!fUsedVars[varY]) break;
-            varZ = ((TH1*)h)->GetZaxis()->GetUniqueID();
-            if(!fUsedVars[varZ]) break;
-            if(isProfile) {
-              if(!fUsedVars[varT]) break;
-              if(varW>AliReducedVarManager::kNothing) {
-                if(!fUsedVars[varW]) break;
-                ((TProfile3D*)h)->Fill(values[varX],values[varY],values[varZ],values[varT],values[varW]);
-              }
-              else
-                ((TProfile3D*)h)->Fill(values[varX],values[varY],values[varZ],values[varT]);
-            }
-            else {
-              if(varW>AliReducedVarManager::kNothing) {
-                if(!fUsedVars[varW]) break;
-                ((TH3F*)h)->Fill(values[varX],values[varY],values[varZ],values[varW]);
-              }
-              else
-                ((TH3F*)h)->Fill(values[varX],values[varY],values[varZ]);
-            }
-          break;
-          default:
-          break;
-        }  // end switch
-      }
-    }  // end if(!isTHn)
-    else {
-      for(Int_t idim=0;idim<thnDim;++idim) {
-        allVarsGood &= fUsedVars[((THnF*)h)->GetAxis(idim)->GetUniqueID()];
-        fillValues[idim] = values[((THnF*)h)->GetAxis(idim)->GetUniqueID()];
-      }
-      if(allVarsGood) {
-        if(varW>AliReducedVarManager::kNothing) {
-          if(fUsedVars[varW])
-            ((THnF*)h)->Fill(fillValues,values[varW]);
-        }
-        else
-          ((THnF*)h)->Fill(fillValues);
-      }
+  const Int_t last = fFillClassFirst[classHandle+1];
+  for(Int_t i=fFillClassFirst[classHandle]; i<last; ++i) {
+    const FillDescriptor& desc = fFillDescriptors[i];
+    const Int_t* vars = fFillVars+desc.fFirstVar;
+    const Bool_t weighted = (desc.fVarW>AliReducedVarManager::kNothing);
+    switch(desc.fType) {
+      case kFillTH1:
+        if(weighted) ((TH1F*)desc.fHist)->Fill(values[vars[0]],values[desc.fVarW]);
+        else ((TH1F*)desc.fHist)->Fill(values[vars[0]]);
+        break;
+      case kFillProfile:
+        if(weighted) ((TProfile*)desc.fHist)->Fill(values[vars[0]],values[vars[1]],values[desc.fVarW]);
+        else ((TProfile*)desc.fHist)->Fill(values[vars[0]],values[vars[1]]);
+        break;
+      case kFillTH2:
+        if(weighted) ((TH2F*)desc.fHist)->Fill(values[vars[0]],values[vars[1]],values[desc.fVarW]);
+        else ((TH2F*)desc.fHist)->Fill(values[vars[0]],values[vars[1]]);
+        break;
+      case kFillProfile2D:
+        if(weighted) ((TProfile2D*)desc.fHist)->Fill(values[vars[0]],values[vars[1]],values[vars[2]],values[desc.fVarW]);
+        else ((TProfile2D*)desc.fHist)->Fill(values[vars[0]],values[vars[1]],values[vars[2]]);
+        break;
+      case kFillTH3:
+        if(weighted) ((TH3F*)desc.fHist)->Fill(values[vars[0]],values[vars[1]],values[vars[2]],values[desc.fVarW]);
+        else ((TH3F*)desc.fHist)->Fill(values[vars[0]],values[vars[1]],values[vars[2]]);
+        break;
+      case kFillProfile3D:
+        if(weighted) ((TProfile3D*)desc.fHist)->Fill(values[vars[0]],values[vars[1]],values[vars[2]],values[vars[3]],values[desc.fVarW]);
+        else ((TProfile3D*)desc.fHist)->Fill(values[vars[0]],values[vars[1]],values[vars[2]],values[vars[3]]);
+        break;
+      case kFillTHn:
+        for(Int_t idim=0;idim<desc.fNVars;++idim) fillValues[idim] = values[vars[idim]];
+        if(weighted) ((THnF*)desc.fHist)->Fill(fillValues,values[desc.fVarW]);
+        else ((THnF*)desc.fHist)->Fill(fillValues);
+        break;
+      default:
+        break;
     }
   }
 }
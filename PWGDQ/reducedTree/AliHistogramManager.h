@@ -65,6 +65,9 @@ class AliHistogramManager : public TObject {
                         TAxis* axis);
   
   void FillHistClass(const Char_t* className, Float_t* values);
+  void FillHistClass(Int_t classHandle, Float_t* values);
+  Int_t GetHistClassHandle(const Char_t* className);    // integer handle of a histogram class, -1 if not found
+  void CompileFillTable();
   
   void SetUseDefaultVariableNames(Bool_t flag) {fUseDefaultVariableNames = flag;};
   void SetDefaultVarNames(TString* vars, TString* units);
@@ -85,6 +88,19 @@ class AliHistogramManager : public TObject {
  private: 
    AliHistogramManager(const AliHistogramManager& histMan);             
    AliHistogramManager& operator=(const AliHistogramManager& histMan);      
+
+  // histogram types known to the fill table
+  enum EFillType {
+    kFillTH1=0, kFillProfile, kFillTH2, kFillProfile2D, kFillTH3, kFillProfile3D, kFillTHn
+  };
+  // one entry of the fill table: everything needed to fill a histogram, decoded once from its unique IDs
+  struct FillDescriptor {
+    TObject* fHist;      // histogram to be filled
+    Int_t    fType;      // histogram type, see EFillType
+    Int_t    fNVars;     // number of variables (dimensions, plus the profiled variables)
+    Int_t    fFirstVar;  // offset of the variable indices in fFillVars
+    Int_t    fVarW;      // weight variable, kNothing if none
+  };
    
   THashList fMainList;          // master histogram list
   TString fName;                 // master histogram list name
@@ -101,6 +117,14 @@ class AliHistogramManager : public TObject {
   TString fVariableUnits[AliReducedVarManager::kNVars];               //! variable units
   Int_t fNVars;                          // maximum number of variables
   
+  // flat fill table, rebuilt when histograms are added; histogram classes are addressed by integer handles
+  Bool_t fFillTableReady;                //! the fill table is up to date
+  Int_t fNFillClasses;                   //! number of histogram classes in the fill table
+  Int_t* fFillClassFirst;                //! [fNFillClasses+1] first descriptor of each class
+  Int_t fNFillDescriptors;               //! number of fill descriptors
+  FillDescriptor* fFillDescriptors;      //! [fNFillDescriptors] fill descriptors
+  Int_t* fFillVars;                      //! variable indices of all fill descriptors
+  
   void MakeAxisLabels(TAxis* ax, const Char_t* labels);
   
   ClassDef(AliHistogramManager, 3)
@@ -26,6 +26,7 @@
 #include "AliNeutralMesonSelection.h"
 #include "AliAnaParticleHadronCorrelation.h"
 #include "AliCaloTrackReader.h"
+#include "AliCaloTrackMixingPool.h"
 #include "AliAODPWG4ParticleCorrelation.h"
 #include "AliFiducialCut.h"
 #include "AliVTrack.h"
@@ -68,7 +69,7 @@ fMakeAbsoluteLeading(0),        fMakeNearSideLeading(0),
 fLeadingTriggerIndex(-1),       fHMPIDCorrelation(0),  fFillBradHisto(0),
 fNAssocPtBins(0),               fAssocPtBinLimit(),
 fCorrelVzBin(0),
-fListMixTrackEvents(),          fListMixCaloEvents(),
+fMixTrackPool(0x0),             fMixCaloPool(0x0),
 fUseMixStoredInReader(0),       fFillNeutralEventMixPool(0),
 fM02MaxCut(0),                  fM02MinCut(0),
 fSelectLeadingHadronAngle(0),   fFillLeadHadOppositeHisto(0),
@@ -186,6 +187,7 @@ fhMixDeltaPhiChargedAssocPtBinDEta08(),
 fhMixDeltaPhiChargedAssocPtBinDEta0(),
 fhMixDeltaPhiDeltaEtaChargedAssocPtBin(),
 fhEventBin(0),                  fhEventMixBin(0),               fhEventMBBin(0),
+fhMixPoolNEvents(0),            fhMixPoolEventAge(0),
 fhMassPtTrigger(0),             fhMCMassPtTrigger(),
 fhPtLeadInConeBin(),            fhPtSumInConeBin(),
 fhPtLeadConeBinDecay(),         fhSumPtConeBinDecay(),
@@ -224,44 +226,10 @@ fhTrackResolution(0),           fhTrackResolutionUE(0)
 //_________________________________________________________________
 AliAnaParticleHadronCorrelation::~AliAnaParticleHadronCorrelation()
 {
-  if(DoOwnMix())
-  {
-    if(fListMixTrackEvents)
-    {
-      for(Int_t iz=0; iz < GetNZvertBin(); iz++)
-      {
-        for(Int_t ic=0; ic < GetNCentrBin(); ic++)
-        {
-          for(Int_t irp=0; irp<GetNRPBin(); irp++)
-          {
-            Int_t bin = GetEventMixBin(ic, iz, irp);
-            fListMixTrackEvents[bin]->Delete() ;
-            delete fListMixTrackEvents[bin] ;
-          }
-        }
-      }
-    }
-    
-    delete[] fListMixTrackEvents;
-    
-    if(fListMixCaloEvents)
-    {
-      for(Int_t iz=0; iz < GetNZvertBin(); iz++)
-      {
-        for(Int_t ic=0; ic < GetNCentrBin(); ic++)
-        {
-          for(Int_t irp=0; irp<GetNRPBin(); irp++)
-          {
-            Int_t bin = GetEventMixBin(ic, iz, irp);
-            fListMixCaloEvents[bin]->Delete() ;
-            delete fListMixCaloEvents[bin] ;
-          }
-        }
-      }
-    }
-    
-    delete[] fListMixCaloEvents;
-  }
+  // Only the pools created by this analysis are set,
+  // the ones taken from the reader belong to the analysis that created them
+  delete fMixTrackPool;
+  delete fMixCaloPool;
 }
 
 //____________________________________________________________________________________________________________________________________
@@ -1191,19 +1159,19 @@ void AliAnaParticleHadronCorrelation::FillChargedEventMixPool()
   
   fhEventMBBin->Fill(eventBin, GetEventWeight());
   
-  TObjArray * mixEventTracks = new TObjArray;
+  AliCaloTrackMixingPool * pool = fMixTrackPool;
+  if(fUseMixStoredInReader) pool = GetReader()->GetMixingPoolForTracks();
   
-  if(fUseMixStoredInReader)
-  {
-    fListMixTrackEvents[eventBin] = GetReader()->GetListWithMixedEventsForTracks(eventBin);
-  }
-  
-  if(!fListMixTrackEvents[eventBin]) fListMixTrackEvents[eventBin] = new TList();
+  if(!pool) return;
   
   //printf("%s ***** Pool Event bin : %d - nTracks %d\n",GetInputAODName().Data(),eventBin, GetCTSTracks()->GetEntriesFast());
   
-  TList * pool = fListMixTrackEvents[eventBin];
+  // Add the event to the pool, the oldest event is removed if the pool is full
+  TClonesArray * mixEventTracks = pool->AddEvent(eventBin, GetNAcceptedEvents());
+  
+  if(!mixEventTracks) return;
   
+  Int_t nMixTracks = 0;
   for(Int_t ipr = 0;ipr < GetCTSTracks()->GetEntriesFast() ; ipr ++ )
   {
     AliVTrack * track = (AliVTrack *) (GetCTSTracks()->At(ipr)) ;
@@ -1214,10 +1182,9 @@ void AliAnaParticleHadronCorrelation::FillChargedEventMixPool()
     // Select only hadrons in pt range
     if(pt < fMinAssocPt || pt > fMaxAssocPt) continue ;
     
-    AliAODPWG4Particle * mixedTrack = new AliAODPWG4Particle(track->Px(),track->Py(),track->Pz(),0);
+    AliAODPWG4Particle * mixedTrack = new((*mixEventTracks)[nMixTracks++]) AliAODPWG4Particle(track->Px(),track->Py(),track->Pz(),0);
     mixedTrack->SetDetectorTag(kCTS);
     mixedTrack->SetChargedBit(track->Charge()>0);
-    mixEventTracks->Add(mixedTrack);
   }
   
   fhNtracksMB->Fill(mixEventTracks->GetEntriesFast(), eventBin, GetEventWeight());
@@ -1225,19 +1192,7 @@ void AliAnaParticleHadronCorrelation::FillChargedEventMixPool()
   // Set the event number where the last event was added, to avoid double pool filling
   GetReader()->SetLastTracksMixedEvent(GetEventNumber());
   
-  //printf("Add event to pool with %d tracks \n ",mixEventTracks->GetEntries());
-  pool->AddFirst(mixEventTracks);
-  mixEventTracks = 0;
-  
-  //printf("Pool size %d, max %d\n",pool->GetSize(), GetNMaxEvMix());
-  
-  if(pool->GetSize() > GetNMaxEvMix())
-  {
-    // Remove last event
-    TClonesArray * tmp = static_cast<TClonesArray*>(pool->Last()) ;
-    pool->RemoveLast() ;
-    delete tmp ;
-  }
+  //printf("Pool size %d, max %d\n",pool->GetNEvents(eventBin), GetNMaxEvMix());
 }
 
 //_____________________________________________________________
@@ -1271,17 +1226,17 @@ void AliAnaParticleHadronCorrelation::FillNeutralEventMixPool()
   // Check that the bin exists, if not (bad determination of RP, centrality or vz bin) do nothing
   if(eventBin < 0) return;
   
-  TObjArray * mixEventCalo = new TObjArray;
+  AliCaloTrackMixingPool * poolCalo = fMixCaloPool;
+  if(fUseMixStoredInReader) poolCalo = GetReader()->GetMixingPoolForCalo();
   
-  if(fUseMixStoredInReader)
-  {
-    fListMixCaloEvents[eventBin] = GetReader()->GetListWithMixedEventsForCalo(eventBin);
-  }
+  if(!poolCalo) return;
   
-  if(!fListMixCaloEvents[eventBin]) fListMixCaloEvents[eventBin] = new TList();
+  // Add the event to the pool, the oldest event is removed if the pool is full
+  TClonesArray * mixEventCalo = poolCalo->AddEvent(eventBin, GetNAcceptedEvents());
   
-  TList * poolCalo = fListMixCaloEvents[eventBin];
+  if(!mixEventCalo) return;
   
+  Int_t nMixCalo = 0;
   for(Int_t ipr = 0;ipr <  pl->GetEntriesFast() ; ipr ++ )
   {
     AliVCluster * calo = (AliVCluster *) (pl->At(ipr)) ;
@@ -1305,9 +1260,8 @@ void AliAnaParticleHadronCorrelation::FillNeutralEventMixPool()
     // Select only clusters in pt range
     if(pt < fMinAssocPt || pt > fMaxAssocPt) continue ;
     
-    AliAODPWG4Particle * mixedCalo = new AliAODPWG4Particle(fMomentum);
+    AliAODPWG4Particle * mixedCalo = new((*mixEventCalo)[nMixCalo++]) AliAODPWG4Particle(fMomentum);
     mixedCalo->SetDetectorTag(kEMCAL);
-    mixEventCalo->Add(mixedCalo);
   }
   
   fhNclustersMB->Fill(mixEventCalo->GetEntriesFast(), eventBin, GetEventWeight());
@@ -1315,19 +1269,7 @@ void AliAnaParticleHadronCorrelation::FillNeutralEventMixPool()
   // Set the event number where the last event was added, to avoid double pool filling
   GetReader()->SetLastCaloMixedEvent(GetEventNumber());
   
-  //printf("Add event to pool with %d clusters \n ",mixEventCalo->GetEntries());
-  poolCalo->AddFirst(mixEventCalo);
-  mixEventCalo = 0;
-  
-  //printf("Pool size %d, max %d\n",poolCalo->GetSize(), GetNMaxEvMix());
-  
-  if(poolCalo->GetSize() > GetNMaxEvMix())
-  {
-    // Remove last event
-    TClonesArray * tmp = static_cast<TClonesArray*>(poolCalo->Last()) ;
-    poolCalo->RemoveLast() ;
-    delete tmp ;
-  }
+  //printf("Pool size %d, max %d\n",poolCalo->GetNEvents(eventBin), GetNMaxEvMix());
 }
 
 //_________________________________________________________________________________________________________________
@@ -3026,30 +2968,14 @@ TList *  AliAnaParticleHadronCorrelation::GetCreateOutputObjects()
   {
     // Create event containers
     
-    if(!fUseMixStoredInReader || (fUseMixStoredInReader && !GetReader()->ListWithMixedEventsForTracksExists()))
+    if(!fUseMixStoredInReader || (fUseMixStoredInReader && !GetReader()->MixingPoolForTracksExists()))
     {
       Int_t nvz = GetNZvertBin();
       Int_t nrp = GetNRPBin();
       Int_t nce = GetNCentrBin();
       
-      fListMixTrackEvents= new TList*[nvz*nrp*nce] ;
-      
-      for( Int_t ice = 0 ; ice < nce ; ice++ )
-      {
-        for( Int_t ivz = 0 ; ivz < nvz ; ivz++ )
-        {
-          for( Int_t irp = 0 ; irp < nrp ; irp++ )
-          {
-            Int_t bin = GetEventMixBin(ice,ivz,irp); //ic*nvz*nrp+iz*nrp+irp;
-            
-            //printf("GetCreateOutputObjects - Bins : cent %d, vz %d, RP %d, event %d/%d\n",
-            //       ic,iz, irp, bin);
-            
-            fListMixTrackEvents[bin] = new TList() ;
-            fListMixTrackEvents[bin]->SetOwner(kFALSE);
-          }
-        }
-      }
+      delete fMixTrackPool;
+      fMixTrackPool = new AliCaloTrackMixingPool(nvz*nrp*nce, GetNMaxEvMix()) ;
     }
     
     fhPtTriggerMixed  = new TH1F ("hPtTriggerMixed","#it{p}_{T} distribution of trigger particles, used for mixing", nptbins,ptmin,ptmax);
@@ -3079,40 +3005,24 @@ TList *  AliAnaParticleHadronCorrelation::GetCreateOutputObjects()
     outputContainer->Add(fhEtaTriggerMixed);
     
     // Fill the cluster pool only in isolation analysis or if requested
-    if( neutralMix && (!fUseMixStoredInReader || (fUseMixStoredInReader && !GetReader()->ListWithMixedEventsForCaloExists())))
+    if( neutralMix && (!fUseMixStoredInReader || (fUseMixStoredInReader && !GetReader()->MixingPoolForCaloExists())))
     {
       Int_t nvz = GetNZvertBin();
       Int_t nrp = GetNRPBin();
       Int_t nce = GetNCentrBin();
       
-      fListMixCaloEvents= new TList*[nvz*nrp*nce] ;
-      
-      for( Int_t ice = 0 ; ice < nce ; ice++ )
-      {
-        for( Int_t ivz = 0 ; ivz < nvz ; ivz++ )
-        {
-          for( Int_t irp = 0 ; irp < nrp ; irp++ )
-          {
-            Int_t bin = GetEventMixBin(ice,ivz,irp); //ic*nvz*nrp+iz*nrp+irp;
-            
-            //printf("GetCreateOutputObjects - Bins : cent %d, vz %d, RP %d, event %d/%d\n",
-            //       ic,iz, irp, bin);
-            
-            fListMixCaloEvents[bin] = new TList() ;
-            fListMixCaloEvents[bin]->SetOwner(kFALSE);
-          }
-        }
-      }
+      delete fMixCaloPool;
+      fMixCaloPool = new AliCaloTrackMixingPool(nvz*nrp*nce, GetNMaxEvMix()) ;
     }
     
-    // Init the list in the reader if not done previously
+    // Init the pools in the reader if not done previously
     if(fUseMixStoredInReader)
     {
-      if( !GetReader()->ListWithMixedEventsForTracksExists() )
-        GetReader()->SetListWithMixedEventsForTracks(fListMixTrackEvents);
+      if( !GetReader()->MixingPoolForTracksExists() && fMixTrackPool )
+        GetReader()->SetMixingPoolForTracks(fMixTrackPool);
       
-      if( !GetReader()->ListWithMixedEventsForCaloExists()   )
-        GetReader()->SetListWithMixedEventsForCalo  (fListMixCaloEvents );
+      if( !GetReader()->MixingPoolForCaloExists()   && fMixCaloPool  )
+        GetReader()->SetMixingPoolForCalo  (fMixCaloPool );
     }
     
     fhEventBin=new TH1I("hEventBin","Number of triggers per bin(cen,vz,rp)",
@@ -3133,6 +3043,22 @@ TList *  AliAnaParticleHadronCorrelation::GetCreateOutputObjects()
     fhEventMBBin->SetXTitle("event bin");
     outputContainer->Add(fhEventMBBin) ;
     
+    fhMixPoolNEvents=new TH2F("hMixPoolNEvents","Number of events in the tracks mixing pool per bin(cen,vz,rp)",
+                              GetNCentrBin()*GetNZvertBin()*GetNRPBin()+1,0,
+                              GetNCentrBin()*GetNZvertBin()*GetNRPBin()+1,
+                              GetNMaxEvMix()+1,0,GetNMaxEvMix()+1) ;
+    fhMixPoolNEvents->SetXTitle("event bin");
+    fhMixPoolNEvents->SetYTitle("#it{N}_{events} in pool");
+    outputContainer->Add(fhMixPoolNEvents) ;
+    
+    fhMixPoolEventAge=new TH2F("hMixPoolEventAge","Number of analyzed events since the mixed event was stored per bin(cen,vz,rp)",
+                               GetNCentrBin()*GetNZvertBin()*GetNRPBin()+1,0,
+                               GetNCentrBin()*GetNZvertBin()*GetNRPBin()+1,
+                               200,0,2000) ;
+    fhMixPoolEventAge->SetXTitle("event bin");
+    fhMixPoolEventAge->SetYTitle("Age (events)");
+    outputContainer->Add(fhMixPoolEventAge) ;
+    
     fhNtracksMB=new TH2F("hNtracksMBEvent","Number of filtered tracks in MB event per event bin",ntrbins,trmin,trmax,
                          GetNCentrBin()*GetNZvertBin()*GetNRPBin()+1,0,
                          GetNCentrBin()*GetNZvertBin()*GetNRPBin()+1) ;
@@ -4259,20 +4185,20 @@ void AliAnaParticleHadronCorrelation::MakeChargedMixCorrelation(AliAODPWG4Partic
   Bool_t isoCase = OnlyIsolated() && (GetIsolationCut()->GetParticleTypeInCone() != AliIsolationCut::kOnlyCharged);
   Bool_t neutralMix = fFillNeutralEventMixPool || isoCase ;
   
-  TList * pool     = 0;
-  TList * poolCalo = 0;
+  AliCaloTrackMixingPool * pool     = 0;
+  AliCaloTrackMixingPool * poolCalo = 0;
   if(fUseMixStoredInReader)
   {
-    pool     = GetReader()->GetListWithMixedEventsForTracks(eventBin);
-    if(neutralMix) poolCalo = GetReader()->GetListWithMixedEventsForCalo  (eventBin);
+    pool     = GetReader()->GetMixingPoolForTracks();
+    if(neutralMix) poolCalo = GetReader()->GetMixingPoolForCalo  ();
   }
   else
   {
-    pool     = fListMixTrackEvents[eventBin];
-    if(neutralMix) poolCalo = fListMixCaloEvents [eventBin];
+    pool     = fMixTrackPool;
+    if(neutralMix) poolCalo = fMixCaloPool ;
   }
   
-  if(!pool) return ;
+  if(!pool || eventBin >= pool->GetNBins()) return ;
   
   if( neutralMix && !poolCalo )
     AliWarning("Careful, cluster pool not available");
@@ -4282,8 +4208,12 @@ void AliAnaParticleHadronCorrelation::MakeChargedMixCorrelation(AliAODPWG4Partic
   Double_t phiTrig = aodParticle->Phi();
   if(phiTrig < 0.) phiTrig+=TMath::TwoPi();
   
+  Int_t nPoolEvents = pool->GetNEvents(eventBin);
+  
   AliDebug(1,Form("Pool bin %d size %d, trigger trigger pt=%f, phi=%f, eta=%f",
-                  eventBin,pool->GetSize(), ptTrig,phiTrig,etaTrig));
+                  eventBin,nPoolEvents, ptTrig,phiTrig,etaTrig));
+  
+  fhMixPoolNEvents->Fill(eventBin, nPoolEvents, GetEventWeight());
   
   Double_t ptAssoc  = -999.;
   Double_t phiAssoc = -999.;
@@ -4296,21 +4226,21 @@ void AliAnaParticleHadronCorrelation::MakeChargedMixCorrelation(AliAODPWG4Partic
   Int_t ev0 = 0;
   if(GetReader()->GetLastTracksMixedEvent() == GetEventNumber()) ev0 = 1;
   
-  for(Int_t ev=ev0; ev < pool->GetSize(); ev++)
+  for(Int_t ev=ev0; ev < nPoolEvents; ev++)
   {
     //
     // Recover the lists of tracks or clusters
     //
-    TObjArray* bgTracks = static_cast<TObjArray*>(pool->At(ev));
+    TObjArray* bgTracks = pool->GetEvent(eventBin,ev);
     TObjArray* bgCalo   = 0;
     
     // Recover the clusters list if requested
     if( neutralMix && poolCalo )
     {
-      if(pool->GetSize()!=poolCalo->GetSize())
+      if(nPoolEvents!=poolCalo->GetNEvents(eventBin))
         AliWarning("Different size of calo and track pools");
       
-      bgCalo = static_cast<TObjArray*>(poolCalo->At(ev));
+      if(ev < poolCalo->GetNEvents(eventBin)) bgCalo = poolCalo->GetEvent(eventBin,ev);
       
       if(!bgCalo) AliDebug(1,Form("Event %d in calo pool not available?",ev));
     }
@@ -4421,6 +4351,7 @@ void AliAnaParticleHadronCorrelation::MakeChargedMixCorrelation(AliAODPWG4Partic
     //
     
     fhEventMixBin->Fill(eventBin, GetEventWeight());
+    fhMixPoolEventAge->Fill(eventBin, GetNAcceptedEvents()-pool->GetEventNumber(eventBin,ev), GetEventWeight());
     
     //printf("\t Read Pool event %d, nTracks %d\n",ev,nTracks);
     
@@ -23,6 +23,7 @@
 
 #include "AliAnaCaloTrackCorrBaseClass.h"
 class AliAODPWG4ParticleCorrelation ;
+class AliCaloTrackMixingPool ;
 
 class AliAnaParticleHadronCorrelation : public AliAnaCaloTrackCorrBaseClass {
   
@@ -293,11 +294,11 @@ private:
   
   Bool_t       fCorrelVzBin ;                            ///<  Fill one histogram per vz bin.
   
-  /// Containers for tracks in stored events for mixing.
-  TList **     fListMixTrackEvents ;                     //![GetNCentrBin()*GetNZvertBin()*GetNRPBin()]
+  /// Containers for tracks in stored events for mixing, one ring buffer per bin GetNCentrBin()*GetNZvertBin()*GetNRPBin().
+  AliCaloTrackMixingPool * fMixTrackPool ;               //!
   
-  /// Containers for calo clusters in stored events for mixing.
-  TList **     fListMixCaloEvents ;                      //![GetNCentrBin()*GetNZvertBin()*GetNRPBin()]
+  /// Containers for calo clusters in stored events for mixing, one ring buffer per bin GetNCentrBin()*GetNZvertBin()*GetNRPBin().
+  AliCaloTrackMixingPool * fMixCaloPool ;                //!
   
   Bool_t       fUseMixStoredInReader;                    ///<  Signal if in the current event the pool was filled.
   
@@ -618,6 +619,8 @@ private:
   TH1I *       fhEventBin;                               //!<! Number of triggers in a particular event bin (cen,vz,rp).
   TH1I *       fhEventMixBin;                            //!<! Number of triggers mixed in a particular bin (cen,vz,rp).
   TH1I *       fhEventMBBin;                             //!<! Number of MB events in a particular bin (cen,vz,rp).
+  TH2F *       fhMixPoolNEvents;                         //!<! Number of events in the tracks mixing pool vs bin (cen,vz,rp).
+  TH2F *       fhMixPoolEventAge;                        //!<! Number of analyzed events since the mixed event was stored vs bin (cen,vz,rp).
   
   // Check invariant mass
   TH2F *       fhMassPtTrigger;                          //!<! Invariant mass of the trigger.
@@ -654,7 +657,7 @@ private:
   AliAnaParticleHadronCorrelation & operator = (const AliAnaParticleHadronCorrelation & ph) ;
   
   /// \cond CLASSIMP
-  ClassDef(AliAnaParticleHadronCorrelation,36) ;
+  ClassDef(AliAnaParticleHadronCorrelation,37) ;
   /// \endcond
   
 } ;
@@ -35,6 +35,7 @@
 #include "AliESDEvent.h"
 #include "AliAODEvent.h"
 #include "AliNeutralMesonSelection.h"
+#include "AliCaloTrackMixingPool.h"
 #include "AliMixedEvent.h"
 #include "AliVParticle.h"
 #include "AliMCEvent.h"
@@ -51,7 +52,7 @@ ClassImp(AliAnaPi0) ;
 /// Default Constructor. Initialized parameters with default values.
 //______________________________________________________
 AliAnaPi0::AliAnaPi0() : AliAnaCaloTrackCorrBaseClass(),
-fEventsList(0x0),
+fEventsPool(0x0),
 fUseAngleCut(kFALSE),        fUseAngleEDepCut(kFALSE),     fAngleCut(0),                 fAngleMaxCut(0.),
 fMultiCutAna(kFALSE),        fMultiCutAnaSim(kFALSE),      fMultiCutAnaAcc(kFALSE),
 fNPtCuts(0),                 fNAsymCuts(0),                fNCellNCuts(0),               fNPIDBits(0), fNAngleCutBins(0),
@@ -63,7 +64,7 @@ fFillArmenterosThetaStar(0), fFillOnlyMCAcceptanceHisto(0),
 fFillSecondaryCellTiming(0), fFillOpAngleCutHisto(0),      fCheckAccInSector(0),
 fPairWithOtherDetector(0),   fOtherDetectorInputName(""),
 fPhotonMom1(),               fPhotonMom1Boost(),           fPhotonMom2(),                fMCPrimMesonMom(),
-fMCProdVertex(),
+fMCProdVertex(),             fPairKinematics(),
 
 // Histograms
 fhReMod(0x0),                fhReSameSideEMCALMod(0x0),    fhReSameSectorEMCALMod(0x0),  fhReDiffPHOSMod(0x0),
@@ -79,6 +80,7 @@ fhRePtNCellAsymCutsOpAngle(0x0),    fhMiPtNCellAsymCutsOpAngle(0x0),
 fhRePtAsym(0x0),             fhRePtAsymPi0(0x0),           fhRePtAsymEta(0x0),
 fhMiPtAsym(0x0),             fhMiPtAsymPi0(0x0),           fhMiPtAsymEta(0x0),
 fhEventBin(0),               fhEventMixBin(0),
+fhMixPoolNEvents(0),         fhMixPoolEventAge(0),
 fhCentrality(0x0),           fhCentralityNoPair(0x0),
 fhEventPlaneResolution(0x0),
 fhRealOpeningAngle(0x0),     fhRealCosOpeningAngle(0x0),   fhMixedOpeningAngle(0x0),     fhMixedCosOpeningAngle(0x0),
@@ -241,22 +243,7 @@ AliAnaPi0::~AliAnaPi0()
 {
   // Remove event containers
   
-  if(DoOwnMix() && fEventsList)
-  {
-    for(Int_t ic=0; ic<GetNCentrBin(); ic++)
-    {
-      for(Int_t iz=0; iz<GetNZvertBin(); iz++)
-      {
-        for(Int_t irp=0; irp<GetNRPBin(); irp++)
-        {
-          Int_t bin = GetEventMixBin(ic,iz,irp);
-          fEventsList[bin]->Delete() ;
-          delete fEventsList[bin] ;
-        }
-      }
-    }
-    delete[] fEventsList;
-  }
+  delete fEventsPool;
 }
 
 //______________________________
@@ -813,20 +800,10 @@ TList * AliAnaPi0::GetCreateOutputObjects()
   //
   // Create mixed event containers
   //
-  fEventsList = new TList*[GetNCentrBin()*GetNZvertBin()*GetNRPBin()] ;
-  
-  for(Int_t ic=0; ic<GetNCentrBin(); ic++)
-  {
-    for(Int_t iz=0; iz<GetNZvertBin(); iz++)
-    {
-      for(Int_t irp=0; irp<GetNRPBin(); irp++)
-      {
-        Int_t bin = GetEventMixBin(ic,iz,irp);
-        fEventsList[bin] = new TList() ;
-        fEventsList[bin]->SetOwner(kFALSE);
-      }
-    }
-  }
+  // The current event is added and then, if GetNMaxEvMix() events are reached, the oldest one
+  // is removed: at most GetNMaxEvMix()-1 events are kept per bin
+  delete fEventsPool;
+  fEventsPool = new AliCaloTrackMixingPool(GetNCentrBin()*GetNZvertBin()*GetNRPBin(), GetNMaxEvMix()-1) ;
       
   fhRe1 = new TH2F*[GetNCentrBin()*fNPIDBits*fNAsymCuts] ;
   fhMi1 = new TH2F*[GetNCentrBin()*fNPIDBits*fNAsymCuts] ;
@@ -1286,6 +1263,22 @@ TList * AliAnaPi0::GetCreateOutputObjects()
                            GetNCentrBin()*GetNZvertBin()*GetNRPBin()+1) ;
     fhEventMixBin->SetXTitle("bin");
     outputContainer->Add(fhEventMixBin) ;
+    
+    fhMixPoolNEvents=new TH2F("hMixPoolNEvents","Number of events in the mixing pool per bin(cen,vz,rp)",
+                              GetNCentrBin()*GetNZvertBin()*GetNRPBin()+1,0,
+                              GetNCentrBin()*GetNZvertBin()*GetNRPBin()+1,
+                              GetNMaxEvMix()+1,0,GetNMaxEvMix()+1) ;
+    fhMixPoolNEvents->SetXTitle("bin");
+    fhMixPoolNEvents->SetYTitle("#it{N}_{events} in pool");
+    outputContainer->Add(fhMixPoolNEvents) ;
+    
+    fhMixPoolEventAge=new TH2F("hMixPoolEventAge","Number of analyzed events since the mixed event was stored per bin(cen,vz,rp)",
+                               GetNCentrBin()*GetNZvertBin()*GetNRPBin()+1,0,
+                               GetNCentrBin()*GetNZvertBin()*GetNRPBin()+1,
+                               200,0,2000) ;
+    fhMixPoolEventAge->SetXTitle("bin");
+    fhMixPoolEventAge->SetYTitle("Age (events)");
+    outputContainer->Add(fhMixPoolEventAge) ;
   }
   
   if ( IsHighMultiplicityAnalysisOn() )
@@ -3848,6 +3841,12 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
 //  if     (GetCalorimeter()==kEMCAL) clusters = GetEMCALClusters();
 //  else if(GetCalorimeter()==kPHOS ) clusters = GetPHOSClusters() ;
   
+  // Momentum components of the second loop photons, for the pair kinematics calculation
+  fPairKinematics.SetPhotons(secondLoopInputData);
+  
+  // Opening angle of the pairs only if cut on or filled in histograms
+  Bool_t pairAngle = fUseAngleEDepCut || fUseAngleCut || fFillAngleHisto || fFillOpAngleCutHisto || (IsDataMC() && fFillOriginHisto);
+  
   //---------------------------------
   // First loop on photons/clusters
   //---------------------------------
@@ -3891,6 +3890,8 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
     
     //Get the momentum of this cluster
     fPhotonMom1.SetPxPyPzE(p1->Px(),p1->Py(),p1->Pz(),p1->E());
+    Double_t etaPhoton1 = fPhotonMom1.Eta();
+    Double_t phiPhoton1 = fPhotonMom1.Phi();
     
     //Get (Super)Module number of this cluster
     module1 =  p1->GetSModNumber();// GetModuleNumber(p1);
@@ -3936,6 +3937,9 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
     Int_t first = i1+1;
     if(fPairWithOtherDetector) first = 0;
     
+    // Select the partner clusters first, the pair kinematics are calculated only for them
+    Bool_t noEventIndex = kFALSE;
+    fPairKinematics.ClearPartners();
     for(Int_t i2 = first; i2 < nPhot2; i2++)
     {
       //AliAODPWG4Particle * p2 = (AliAODPWG4Particle*) (GetInputAODBranch()->At(i2)) ;
@@ -3949,12 +3953,27 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
       //In case of mixing frame, check we are not in the same event as the first cluster
       Int_t evtIndex2 = GetEventIndex(p2, vert) ;
       if ( evtIndex2 == -1 )
-        return ;
+      {
+        // Stop after the pairs with the previous clusters
+        noEventIndex = kTRUE;
+        break ;
+      }
       if ( evtIndex2 == -2 )
         continue ;
       if (GetMixedEvent() && (evtIndex1 == evtIndex2))
         continue ;
       
+      fPairKinematics.AddPartner(i2);
+    }
+    
+    // Kinematics of the pairs of this cluster with the partner clusters
+    fPairKinematics.CalculatePairs(p1->Px(),p1->Py(),p1->Pz(),p1->E(), pairAngle);
+    
+    for(Int_t ipart = 0; ipart < fPairKinematics.GetNPartners(); ipart++)
+    {
+      Int_t i2 = fPairKinematics.GetPartner(ipart);
+      AliAODPWG4Particle * p2 = (AliAODPWG4Particle*) (secondLoopInputData->At(i2)) ;
+      
 //      //------------------------------------------
 //      // Recover original cluster
 //      Int_t iclus2 = -1;
@@ -4006,38 +4025,33 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
       //printf("cluster2: E %2.2f, l0 %2.2f, tof %2.2f\n",p2->E(),l02,tof2);
       
       Double_t t12diff = tof1-tof2;
-      fhEPairDiffTime->Fill((fPhotonMom1 + fPhotonMom2).Pt(), t12diff, GetEventWeight());
+      fhEPairDiffTime->Fill(fPairKinematics.GetPairPt(ipart), t12diff, GetEventWeight());
       if(TMath::Abs(t12diff) > GetPairTimeCut()) continue;
       
       //------------------------------------------
       
       //printf("AliAnaPi0::MakeAnalysisFillHistograms(): Photon 2 Evt %d  Vertex : %f,%f,%f\n",evtIndex2, GetVertex(evtIndex2)[0] ,GetVertex(evtIndex2)[1],GetVertex(evtIndex2)[2]);
       
-      // Get the momentum of this cluster
-      fPhotonMom2.SetPxPyPzE(p2->Px(),p2->Py(),p2->Pz(),p2->E());
-      
       // Get module number
       module2 = p2->GetSModNumber(); //GetModuleNumber(p2);
       
       //---------------------------------
       // Get pair kinematics
       //---------------------------------
-      Double_t m    = (fPhotonMom1 + fPhotonMom2).M() ;
-      Double_t pt   = (fPhotonMom1 + fPhotonMom2).Pt();
-      Double_t deta = fPhotonMom1.Eta() - fPhotonMom2.Eta();
-      Double_t dphi = fPhotonMom1.Phi() - fPhotonMom2.Phi();
-      Double_t a    = TMath::Abs(p1->E()-p2->E())/(p1->E()+p2->E()) ;
+      Double_t m    = fPairKinematics.GetPairMass(ipart);
+      Double_t pt   = fPairKinematics.GetPairPt(ipart);
+      Double_t a    = fPairKinematics.GetPairAsymmetry(ipart);
       
-      AliDebug(2,Form("E: fPhotonMom1 %f, fPhotonMom2 %f; Pair: pT %f, mass %f, a %f", p1->E(), p2->E(), (fPhotonMom1 + fPhotonMom2).E(),m,a));
+      AliDebug(2,Form("E: fPhotonMom1 %f, fPhotonMom2 %f; Pair: pT %f, mass %f, a %f", p1->E(), p2->E(), fPairKinematics.GetPairEnergy(ipart),m,a));
       
       //--------------------------------
       // Opening angle selection
       //--------------------------------
       // Check if opening angle is too large or too small compared to what is expected
-      Double_t angle   = fPhotonMom1.Angle(fPhotonMom2.Vect());
-      if(fUseAngleEDepCut && !GetNeutralMesonSelection()->IsAngleInWindow((fPhotonMom1+fPhotonMom2).E(),angle+0.05))
+      Double_t angle   = pairAngle ? fPairKinematics.GetPairAngle(ipart) : 0.;
+      if(fUseAngleEDepCut && !GetNeutralMesonSelection()->IsAngleInWindow(fPairKinematics.GetPairEnergy(ipart),angle+0.05))
       {
-        AliDebug(2,Form("Real pair angle %f (deg) not in E %f window",RadToDeg(angle), (fPhotonMom1+fPhotonMom2).E()));
+        AliDebug(2,Form("Real pair angle %f (deg) not in E %f window",RadToDeg(angle), fPairKinematics.GetPairEnergy(ipart)));
         continue;
       }
       
@@ -4123,11 +4137,11 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
         }
         else
         {
-          Float_t phi1 = GetPhi(fPhotonMom1.Phi());
-          Float_t phi2 = GetPhi(fPhotonMom2.Phi());
+          Float_t phi1 = GetPhi(phiPhoton1);
+          Float_t phi2 = GetPhi(fPairKinematics.GetPhotonPhi(i2));
           Bool_t etaside = 0;
-          if(   (p1->GetDetectorTag()==kEMCAL && fPhotonMom1.Eta() < 0) 
-             || (p2->GetDetectorTag()==kEMCAL && fPhotonMom2.Eta() < 0)) etaside = 1;
+          if(   (p1->GetDetectorTag()==kEMCAL && etaPhoton1 < 0) 
+             || (p2->GetDetectorTag()==kEMCAL && fPairKinematics.GetPhotonEta(i2) < 0)) etaside = 1;
           
           if      (    phi1 > DegToRad(260) && phi2 > DegToRad(260) && phi1 < DegToRad(280) && phi2 < DegToRad(280))  fhReSameSectorDCALPHOSMod[0+etaside]->Fill(pt, m, GetEventWeight()*weightPt);
           else if (    phi1 > DegToRad(280) && phi2 > DegToRad(280) && phi1 < DegToRad(300) && phi2 < DegToRad(300))  fhReSameSectorDCALPHOSMod[2+etaside]->Fill(pt, m, GetEventWeight()*weightPt);
@@ -4153,8 +4167,8 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
         } 
         else // PHOS and DCal in same sector
         {
-          Float_t phi1 = GetPhi(fPhotonMom1.Phi());
-          Float_t phi2 = GetPhi(fPhotonMom2.Phi());
+          Float_t phi1 = GetPhi(phiPhoton1);
+          Float_t phi2 = GetPhi(fPairKinematics.GetPhotonPhi(i2));
           ok=kFALSE;
           if      ( phi1 > DegToRad(260) && phi2 > DegToRad(260) && phi1 < DegToRad(280) && phi2 < DegToRad(280)) ok = kTRUE;
           else if ( phi1 > DegToRad(280) && phi2 > DegToRad(280) && phi1 < DegToRad(300) && phi2 < DegToRad(300)) ok = kTRUE;
@@ -4246,8 +4260,8 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
         
         if( angleBin >= 0 && angleBin < fNAngleCutBins)
         {
-          Float_t e1   = fPhotonMom1.E();
-          Float_t e2   = fPhotonMom2.E();
+          Float_t e1   = p1->E();
+          Float_t e2   = p2->E();
 
           Float_t t1   = tof1;
           Float_t t2   = tof2;
@@ -4255,11 +4269,11 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
           Int_t nc1    = ncell1;
           Int_t nc2    = ncell2;          
           
-          Float_t eta1 = fPhotonMom1.Eta(); 
-          Float_t eta2 = fPhotonMom2.Eta(); 
+          Float_t eta1 = etaPhoton1; 
+          Float_t eta2 = fPairKinematics.GetPhotonEta(i2); 
 
-          Float_t phi1 = GetPhi(fPhotonMom1.Phi());
-          Float_t phi2 = GetPhi(fPhotonMom2.Phi());
+          Float_t phi1 = GetPhi(phiPhoton1);
+          Float_t phi2 = GetPhi(fPairKinematics.GetPhotonPhi(i2));
           
           Int_t   mod1 = module1;
           Int_t   mod2 = module2;
@@ -4272,8 +4286,8 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
           
           if(e2 > e1)
           {
-            e1   = fPhotonMom2.E();
-            e2   = fPhotonMom1.E();
+            e1   = p2->E();
+            e2   = p1->E();
 
             t1   = tof2;
             t2   = tof1;
@@ -4281,11 +4295,11 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
             nc1  = ncell2;
             nc2  = ncell1;         
             
-            eta1 = fPhotonMom2.Eta(); 
-            eta2 = fPhotonMom1.Eta(); 
+            eta1 = fPairKinematics.GetPhotonEta(i2); 
+            eta2 = etaPhoton1; 
             
-            phi1 = GetPhi(fPhotonMom2.Phi());
-            phi2 = GetPhi(fPhotonMom1.Phi());
+            phi1 = GetPhi(fPairKinematics.GetPhotonPhi(i2));
+            phi2 = GetPhi(phiPhoton1);
             
             mod1 = module2;
             mod2 = module1;
@@ -4367,7 +4381,9 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
                                         p1->GetCaloLabel(0), p2->GetCaloLabel(0),
                                         p1->GetTag(),p2->GetTag(),
                                         p1->Pt(), p2->Pt(),
-                                        ncell1, ncell2, m, pt, a, deta, dphi, angle);
+                                        ncell1, ncell2, m, pt, a,
+                                        etaPhoton1 - fPairKinematics.GetPhotonEta(i2),
+                                        phiPhoton1 - fPairKinematics.GetPhotonPhi(i2), angle);
         }
       }
       
@@ -4404,6 +4420,8 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
       }// multiple cuts analysis
       
     }// second same event particle
+    
+    if ( noEventIndex ) return ;
   }// first cluster
   
   //-------------------------------------------------------------
@@ -4416,23 +4434,40 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
     // Check that the bin exists, if not (bad determination of RP, centrality or vz bin) do nothing
     if(eventbin < 0) return ;
     
-    TList * evMixList=fEventsList[eventbin] ;
-    
-    if(!evMixList)
+    if(!fEventsPool || eventbin >= fEventsPool->GetNBins())
     {
       AliWarning(Form("Mix event list not available, bin %d",eventbin));
       return;
     }
     
-    Int_t nMixed = evMixList->GetSize() ;
+    Int_t nMixed = fEventsPool->GetNEvents(eventbin) ;
+    fhMixPoolNEvents->Fill(eventbin, nMixed, GetEventWeight()) ;
+    
+    // Opening angle of the pairs only if cut on or filled in histograms
+    Bool_t mixPairAngle = fUseAngleEDepCut || fUseAngleCut || fFillAngleHisto || fFillOpAngleCutHisto;
+    
     for(Int_t ii=0; ii<nMixed; ii++)
     {
-      TClonesArray* ev2= (TClonesArray*) (evMixList->At(ii));
+      TClonesArray* ev2= fEventsPool->GetEvent(eventbin,ii);
       Int_t nPhot2=ev2->GetEntriesFast() ;
       Double_t m = -999;
       AliDebug(1,Form("Mixed event %d photon entries %d, centrality bin %d",ii, nPhot2, GetEventCentralityBin()));
       
       fhEventMixBin->Fill(eventbin, GetEventWeight()) ;
+      fhMixPoolEventAge->Fill(eventbin, GetNAcceptedEvents()-fEventsPool->GetEventNumber(eventbin,ii), GetEventWeight()) ;
+      
+      // Momentum components of the mixed event photons, for the pair kinematics calculation.
+      // The pT selection of the mixed event photons does not depend on the first photon.
+      fPairKinematics.SetPhotons(ev2);
+      for(Int_t i2 = 0; i2 < nPhot2; i2++)
+      {
+        AliAODPWG4Particle * p2 = (AliAODPWG4Particle*) (ev2->At(i2)) ;
+        
+        // Select photons within a pT range
+        if ( p2->Pt() < GetMinPt() || p2->Pt()  > GetMaxPt() ) continue ;
+        
+        fPairKinematics.AddPartner(i2);
+      }
       
       //---------------------------------
       // First loop on photons/clusters
@@ -4449,29 +4484,31 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
         
         //Get kinematics of cluster and (super) module of this cluster
         fPhotonMom1.SetPxPyPzE(p1->Px(),p1->Py(),p1->Pz(),p1->E());
+        Double_t etaPhoton1 = fPhotonMom1.Eta();
+        Double_t phiPhoton1 = fPhotonMom1.Phi();
         module1 = GetModuleNumber(p1);
         
+        // Kinematics of the pairs of this cluster with the selected mixed event clusters
+        fPairKinematics.CalculatePairs(p1->Px(),p1->Py(),p1->Pz(),p1->E(), mixPairAngle);
+        
         //---------------------------------
         // Second loop on other mixed event photons/clusters
         //---------------------------------
-        for(Int_t i2 = 0; i2 < nPhot2; i2++)
+        for(Int_t ipart = 0; ipart < fPairKinematics.GetNPartners(); ipart++)
         {
+          Int_t i2 = fPairKinematics.GetPartner(ipart);
           AliAODPWG4Particle * p2 = (AliAODPWG4Particle*) (ev2->At(i2)) ;
           
-          // Select photons within a pT range
-          if ( p2->Pt() < GetMinPt() || p2->Pt()  > GetMaxPt() ) continue ;
-          
-          // Get kinematics of second cluster and calculate those of the pair
-          fPhotonMom2.SetPxPyPzE(p2->Px(),p2->Py(),p2->Pz(),p2->E());
-          m           = (fPhotonMom1+fPhotonMom2).M() ;
-          Double_t pt = (fPhotonMom1 + fPhotonMom2).Pt();
-          Double_t a  = TMath::Abs(p1->E()-p2->E())/(p1->E()+p2->E()) ;
+          // Get kinematics of the pair
+          m           = fPairKinematics.GetPairMass(ipart);
+          Double_t pt = fPairKinematics.GetPairPt(ipart);
+          Double_t a  = fPairKinematics.GetPairAsymmetry(ipart);
           
           // Check if opening angle is too large or too small compared to what is expected
-          Double_t angle   = fPhotonMom1.Angle(fPhotonMom2.Vect());
-          if(fUseAngleEDepCut && !GetNeutralMesonSelection()->IsAngleInWindow((fPhotonMom1+fPhotonMom2).E(),angle+0.05))
+          Double_t angle   = mixPairAngle ? fPairKinematics.GetPairAngle(ipart) : 0.;
+          if(fUseAngleEDepCut && !GetNeutralMesonSelection()->IsAngleInWindow(fPairKinematics.GetPairEnergy(ipart),angle+0.05))
           {
-            AliDebug(2,Form("Mix pair angle %f (deg) not in E %f window",RadToDeg(angle), (fPhotonMom1+fPhotonMom2).E()));
+            AliDebug(2,Form("Mix pair angle %f (deg) not in E %f window",RadToDeg(angle), fPairKinematics.GetPairEnergy(ipart)));
             continue;
           }
           
@@ -4540,11 +4577,11 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
             }
             else
             {
-              Float_t phi1 = GetPhi(fPhotonMom1.Phi());
-              Float_t phi2 = GetPhi(fPhotonMom2.Phi());
+              Float_t phi1 = GetPhi(phiPhoton1);
+              Float_t phi2 = GetPhi(fPairKinematics.GetPhotonPhi(i2));
               Bool_t etaside = 0;
-              if(   (p1->GetDetectorTag()==kEMCAL && fPhotonMom1.Eta() < 0) 
-                 || (p2->GetDetectorTag()==kEMCAL && fPhotonMom2.Eta() < 0)) etaside = 1;
+              if(   (p1->GetDetectorTag()==kEMCAL && etaPhoton1 < 0) 
+                 || (p2->GetDetectorTag()==kEMCAL && fPairKinematics.GetPhotonEta(i2) < 0)) etaside = 1;
               
               if      (    phi1 > DegToRad(260) && phi2 > DegToRad(260) && phi1 < DegToRad(280) && phi2 < DegToRad(280))  fhMiSameSectorDCALPHOSMod[0+etaside]->Fill(pt, m, GetEventWeight());
               else if (    phi1 > DegToRad(280) && phi2 > DegToRad(280) && phi1 < DegToRad(300) && phi2 < DegToRad(300))  fhMiSameSectorDCALPHOSMod[2+etaside]->Fill(pt, m, GetEventWeight());
@@ -4568,8 +4605,8 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
             } 
             else // PHOS and DCal in same sector
             {
-              Float_t phi1 = GetPhi(fPhotonMom1.Phi());
-              Float_t phi2 = GetPhi(fPhotonMom2.Phi());
+              Float_t phi1 = GetPhi(phiPhoton1);
+              Float_t phi2 = GetPhi(fPairKinematics.GetPhotonPhi(i2));
               ok=kFALSE;
               if      ( phi1 > DegToRad(260) && phi2 > DegToRad(260) && phi1 < DegToRad(280) && phi2 < DegToRad(280)) ok = kTRUE;
               else if ( phi1 > DegToRad(280) && phi2 > DegToRad(280) && phi1 < DegToRad(300) && phi2 < DegToRad(300)) ok = kTRUE;
@@ -4686,8 +4723,8 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
             
             if( angleBin >= 0 && angleBin < fNAngleCutBins)
             {
-              Float_t e1   = fPhotonMom1.E();
-              Float_t e2   = fPhotonMom2.E();
+              Float_t e1   = p1->E();
+              Float_t e2   = p2->E();
               
               Float_t t1   = p1->GetTime();
               Float_t t2   = p2->GetTime();
@@ -4695,11 +4732,11 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
               Int_t nc1    = ncell1;
               Int_t nc2    = ncell2;
               
-              Float_t eta1 = fPhotonMom1.Eta(); 
-              Float_t eta2 = fPhotonMom2.Eta(); 
+              Float_t eta1 = etaPhoton1; 
+              Float_t eta2 = fPairKinematics.GetPhotonEta(i2); 
               
-              Float_t phi1 = GetPhi(fPhotonMom1.Phi());
-              Float_t phi2 = GetPhi(fPhotonMom2.Phi());
+              Float_t phi1 = GetPhi(phiPhoton1);
+              Float_t phi2 = GetPhi(fPairKinematics.GetPhotonPhi(i2));
               
               Int_t   mod1 = module1;
               Int_t   mod2 = module2;
@@ -4715,8 +4752,8 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
               
               if(e2 > e1)
               {
-                e1   = fPhotonMom2.E();
-                e2   = fPhotonMom1.E();
+                e1   = p2->E();
+                e2   = p1->E();
                 
                 t1   = p2->GetTime();
                 t2   = p1->GetTime();
@@ -4724,11 +4761,11 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
                 nc1  = ncell2;
                 nc2  = ncell1;
                 
-                eta1 = fPhotonMom2.Eta(); 
-                eta2 = fPhotonMom1.Eta(); 
+                eta1 = fPairKinematics.GetPhotonEta(i2); 
+                eta2 = etaPhoton1; 
                 
-                phi1 = GetPhi(fPhotonMom2.Phi());
-                phi2 = GetPhi(fPhotonMom1.Phi());
+                phi1 = GetPhi(fPairKinematics.GetPhotonPhi(i2));
+                phi2 = GetPhi(phiPhoton1);
                 
                 mod1 = module2;
                 mod2 = module1;
@@ -4794,26 +4831,21 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
     // Add the current event to the list of events for mixing
     //--------------------------------------------------------
     
-    //TClonesArray *currentEvent = new TClonesArray(*GetInputAODBranch());
-    TClonesArray *currentEvent = new TClonesArray(*secondLoopInputData);
+    // Add current event to buffer, the oldest event is removed if the buffer is full.
+    // Only the photon kinematics and cluster information are kept, not the derived class data.
+    Int_t nPhotCurrent = secondLoopInputData->GetEntriesFast();
+    
+    TClonesArray *currentEvent = 0;
+    if( nPhotCurrent > 0 ) currentEvent = fEventsPool->AddEvent(eventbin, GetNAcceptedEvents());
     
-    // Add current event to buffer and Remove redundant events
-    if( currentEvent->GetEntriesFast() > 0 )
+    if( currentEvent )
     {
-      evMixList->AddFirst(currentEvent) ;
-      currentEvent=0 ; //Now list of particles belongs to buffer and it will be deleted with buffer
-      if( evMixList->GetSize() >= GetNMaxEvMix() )
+      for(Int_t iphot = 0; iphot < nPhotCurrent; iphot++)
       {
-        TClonesArray * tmp = (TClonesArray*) (evMixList->Last()) ;
-        evMixList->RemoveLast() ;
-        delete tmp ;
+        AliAODPWG4Particle * phot = (AliAODPWG4Particle*) (secondLoopInputData->At(iphot));
+        new((*currentEvent)[iphot]) AliAODPWG4Particle(*phot);
       }
     }
-    else
-    { // empty event
-      delete currentEvent ;
-      currentEvent=0 ;
-    }
   }// DoOwnMix
   
   AliDebug(1,"End fill histograms");
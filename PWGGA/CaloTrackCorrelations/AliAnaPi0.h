@@ -32,9 +32,11 @@ class TObjString;
 
 // Analysis
 #include "AliAnaCaloTrackCorrBaseClass.h"
+#include "AliNeutralMesonPairKinematics.h"
 class AliAODEvent ;
 class AliESDEvent ;
 class AliAODPWG4Particle ;
+class AliCaloTrackMixingPool ;
 
 class AliAnaPi0 : public AliAnaCaloTrackCorrBaseClass {
   
@@ -182,8 +184,8 @@ class AliAnaPi0 : public AliAnaCaloTrackCorrBaseClass {
 
   private:
 
-  /// Containers for photons in stored events
-  TList ** fEventsList ;               //![GetNCentrBin()*GetNZvertBin()*GetNRPBin()]
+  /// Containers for photons in stored events, one ring buffer per bin GetNCentrBin()*GetNZvertBin()*GetNRPBin()
+  AliCaloTrackMixingPool * fEventsPool ; //!
   
   Bool_t   fUseAngleCut ;              ///<  Select pairs depending on their opening angle
   Bool_t   fUseAngleEDepCut ;          ///<  Select pairs depending on their opening angle
@@ -235,6 +237,7 @@ class AliAnaPi0 : public AliAnaCaloTrackCorrBaseClass {
   TLorentzVector fPhotonMom2;          //!<! Photon cluster momentum, temporary array
   TLorentzVector fMCPrimMesonMom;      //!<! Pi0/Eta MC primary momentum, temporary array
   TVector3       fMCProdVertex;        //!<! Pi0/Eta MC Production vertex, temporary array
+  AliNeutralMesonPairKinematics fPairKinematics; //!<! Kinematics of the pairs of one photon with the photons of the second loop
     
   // ----------
   // Histograms
@@ -364,6 +367,8 @@ class AliAnaPi0 : public AliAnaCaloTrackCorrBaseClass {
     
   TH1I *   fhEventBin;                 //!<! Number of real  pairs in a particular bin (cen,vz,rp)
   TH1I *   fhEventMixBin;              //!<! Number of mixed pairs in a particular bin (cen,vz,rp)
+  TH2F *   fhMixPoolNEvents;           //!<! Number of events in the mixing pool vs bin (cen,vz,rp)
+  TH2F *   fhMixPoolEventAge;          //!<! Number of analyzed events since the mixed event was stored vs bin (cen,vz,rp)
   TH1F *   fhCentrality;               //!<! Histogram with centrality bins with at least one pare
   TH1F *   fhCentralityNoPair;         //!<! Histogram with centrality bins with no pair
 
@@ -601,7 +606,7 @@ class AliAnaPi0 : public AliAnaCaloTrackCorrBaseClass {
   AliAnaPi0 & operator = (const AliAnaPi0 & api0) ;
   
   /// \cond CLASSIMP
-  ClassDef(AliAnaPi0,35) ;
+  ClassDef(AliAnaPi0,36) ;
   /// \endcond
   
 } ;
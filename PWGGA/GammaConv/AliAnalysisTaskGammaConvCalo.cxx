@@ -56,6 +56,7 @@
 #include "AliESDInputHandler.h"
 #include "AliInputEventHandler.h"
 #include "AliCaloTrackMatcher.h"
+#include "AliConversionCutSetSelector.h"
 #include <vector>
 #include <map>
 
@@ -84,6 +85,8 @@ AliAnalysisTaskGammaConvCalo::AliAnalysisTaskGammaConvCalo(): AliAnalysisTaskSE(
   fOutputContainer(NULL),
   fReaderGammas(NULL),
   fGammaCandidates(NULL),
+  fCutSetSelector(NULL),
+  fVerifyCutSetSelection(kFALSE),
   fClusterCandidates(NULL),
   fEventCutArray(NULL),
   fEventCuts(NULL),
@@ -386,6 +389,8 @@ AliAnalysisTaskGammaConvCalo::AliAnalysisTaskGammaConvCalo(const char *name):
   fOutputContainer(0),
   fReaderGammas(NULL),
   fGammaCandidates(NULL),
+  fCutSetSelector(NULL),
+  fVerifyCutSetSelection(kFALSE),
   fClusterCandidates(NULL),
   fEventCutArray(NULL),
   fEventCuts(NULL),
@@ -671,6 +676,10 @@ AliAnalysisTaskGammaConvCalo::~AliAnalysisTaskGammaConvCalo()
     delete fGammaCandidates;
     fGammaCandidates = 0x0;
   }
+  if(fCutSetSelector){
+    delete fCutSetSelector;
+    fCutSetSelector = 0x0;
+  }
   if(fClusterCandidates){
     delete fClusterCandidates;
     fClusterCandidates = 0x0;
@@ -2307,6 +2316,10 @@ void AliAnalysisTaskGammaConvCalo::UserCreateOutputObjects(){
     }
   }
 
+  fCutSetSelector = new AliConversionCutSetSelector();
+  fCutSetSelector->Init(fCutArray,fnCuts);
+  fCutSetSelector->SetVerifySelection(fVerifyCutSetSelection);
+
   if (fIsMC > 0){
     tBrokenFiles = new TTree("BrokenFiles","BrokenFiles");
     tBrokenFiles->Branch("fileName",&fFileNameBroken);
@@ -2385,6 +2398,7 @@ void AliAnalysisTaskGammaConvCalo::UserExec(Option_t *)
   }
 
   fReaderGammas = fV0Reader->GetReconstructedGammas(); // Gammas from default Cut
+  fCutSetSelector->NextEvent(fReaderGammas->GetEntriesFast());
 
   // ------------------- BeginEvent ----------------------------
   AliEventplane *EventPlane = fInputEvent->GetEventplane();
@@ -2537,6 +2551,8 @@ void AliAnalysisTaskGammaConvCalo::UserExec(Option_t *)
           fBGClusHandlerRP[iCut]->AddEvent(fClusterCandidates,fInputEvent); // Store Event for mixed Events
         }
       }
+      // the rotation background rotates the photon candidates in place: their selection has to be redone
+      if(((AliConversionMesonCuts*)fMesonCutArray->At(iCut))->UseRotationMethod()) fCutSetSelector->Invalidate();
 
       if(fIsMC>0 && fInputEvent->IsA()==AliAODEvent::Class()){
         ProcessConversionPhotonsForMissingTagsAOD(); //Count missing tags
@@ -2991,7 +3007,7 @@ void AliAnalysisTaskGammaConvCalo::ProcessPhotonCandidates()
       if( (isNegFromMBHeader+isPosFromMBHeader) != 4) fIsFromMBHeader = kFALSE;
     }
 
-    if(!((AliConversionPhotonCuts*)fCutArray->At(fiCut))->PhotonIsSelected(PhotonCandidate,fInputEvent)) continue;
+    if(!fCutSetSelector->PhotonIsSelected(fiCut,i,PhotonCandidate,fInputEvent)) continue;
     if(!((AliConversionPhotonCuts*)fCutArray->At(fiCut))->InPlaneOutOfPlaneCut(PhotonCandidate->GetPhotonPhi(),fEventPlaneAngle)) continue;
     if(!((AliConversionPhotonCuts*)fCutArray->At(fiCut))->UseElecSharingCut() &&
     !((AliConversionPhotonCuts*)fCutArray->At(fiCut))->UseToCloseV0sCut()){
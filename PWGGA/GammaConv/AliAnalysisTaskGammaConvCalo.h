@@ -19,6 +19,8 @@
 #include <vector>
 #include <map>
 
+class AliConversionCutSetSelector;
+
 class AliAnalysisTaskGammaConvCalo : public AliAnalysisTaskSE {
   public:
 
@@ -69,6 +71,7 @@ class AliAnalysisTaskGammaConvCalo : public AliAnalysisTaskSE {
     void SetLightOutput                 ( Bool_t flag )                                     { fDoLightOutput = flag                       ;}
     void SetDoMesonAnalysis             ( Bool_t flag )                                     { fDoMesonAnalysis = flag                     ;}
     void SetDoMesonQA                   ( Int_t flag )                                      { fDoMesonQA = flag                           ;}
+    void SetVerifyCutSetSelection       ( Bool_t flag )                                     { fVerifyCutSetSelection = flag               ;}
     void SetDoPhotonQA                  ( Int_t flag )                                      { fDoPhotonQA = flag                          ;}
     void SetDoClusterQA                 ( Int_t flag )                                      { fDoClusterQA = flag                         ;}
     void SetUseTHnSparse                ( Bool_t flag )                                     { fDoTHnSparse = flag                         ;}
@@ -160,6 +163,8 @@ class AliAnalysisTaskGammaConvCalo : public AliAnalysisTaskSE {
     TList*                              fOutputContainer;       // Output container
     TClonesArray*                       fReaderGammas;          // Array with conversion photons selected by V0Reader Cut
     TList*                              fGammaCandidates;       // current list of photon candidates
+    AliConversionCutSetSelector*        fCutSetSelector;        //! photon selection shared between cut sets
+    Bool_t                              fVerifyCutSetSelection; // cross check the shared photon selection against the full selection
     TList*                              fClusterCandidates;     //! current list of cluster candidates
     TList*                              fEventCutArray;         // List with Event Cuts
     AliConvEventCuts*                   fEventCuts;             // EventCutObject
@@ -479,7 +484,7 @@ class AliAnalysisTaskGammaConvCalo : public AliAnalysisTaskSE {
     AliAnalysisTaskGammaConvCalo(const AliAnalysisTaskGammaConvCalo&); // Prevent copy-construction
     AliAnalysisTaskGammaConvCalo &operator=(const AliAnalysisTaskGammaConvCalo&); // Prevent assignment
 
-    ClassDef(AliAnalysisTaskGammaConvCalo, 41);
+    ClassDef(AliAnalysisTaskGammaConvCalo, 42);
 };
 
 #endif
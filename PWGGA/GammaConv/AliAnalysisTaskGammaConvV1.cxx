@@ -54,6 +54,7 @@
 #include "AliAODMCHeader.h"
 #include "AliEventplane.h"
 #include "AliAODEvent.h"
+#include "AliConversionCutSetSelector.h"
 #include <vector>
 #include <map>
 
@@ -81,6 +82,8 @@ AliAnalysisTaskGammaConvV1::AliAnalysisTaskGammaConvV1(): AliAnalysisTaskSE(),
   fOutputContainer(0),
   fReaderGammas(NULL),
   fGammaCandidates(NULL),
+  fCutSetSelector(NULL),
+  fVerifyCutSetSelection(kFALSE),
   fEventCutArray(NULL),
   fCutArray(NULL),
   fMesonCutArray(NULL),
@@ -291,6 +294,8 @@ AliAnalysisTaskGammaConvV1::AliAnalysisTaskGammaConvV1(const char *name):
   fOutputContainer(0),
   fReaderGammas(NULL),
   fGammaCandidates(NULL),
+  fCutSetSelector(NULL),
+  fVerifyCutSetSelection(kFALSE),
   fEventCutArray(NULL),
   fCutArray(NULL),
   fMesonCutArray(NULL),
@@ -486,6 +491,10 @@ AliAnalysisTaskGammaConvV1::~AliAnalysisTaskGammaConvV1()
     delete fGammaCandidates;
     fGammaCandidates = 0x0;
   }
+  if(fCutSetSelector){
+    delete fCutSetSelector;
+    fCutSetSelector = 0x0;
+  }
   if(fBGHandler){
     delete[] fBGHandler;
     fBGHandler = 0x0;
@@ -1587,6 +1596,10 @@ void AliAnalysisTaskGammaConvV1::UserCreateOutputObjects(){
     }  
     
   }
+  fCutSetSelector = new AliConversionCutSetSelector();
+  fCutSetSelector->Init(fCutArray,fnCuts);
+  fCutSetSelector->SetVerifySelection(fVerifyCutSetSelection);
+
   if (fIsMC > 0){
     tBrokenFiles = new TTree("BrokenFiles","BrokenFiles");   
     tBrokenFiles->Branch("fileName",&fFileNameBroken);
@@ -1667,6 +1680,7 @@ void AliAnalysisTaskGammaConvV1::UserExec(Option_t *)
   }
 
   fReaderGammas = fV0Reader->GetReconstructedGammas(); // Gammas from default Cut
+  fCutSetSelector->NextEvent(fReaderGammas->GetEntriesFast());
   
   // ------------------- BeginEvent ----------------------------
 
@@ -1833,6 +1847,8 @@ void AliAnalysisTaskGammaConvV1::UserExec(Option_t *)
           fBGHandlerRP[iCut]->AddEvent(fGammaCandidates,fInputEvent); // Store Event for mixed Events
         }
       }
+      // the rotation background rotates the photon candidates in place: their selection has to be redone
+      if(((AliConversionMesonCuts*)fMesonCutArray->At(iCut))->UseRotationMethod()) fCutSetSelector->Invalidate();
       if(((AliConversionMesonCuts*)fMesonCutArray->At(iCut))->UseMCPSmearing() && fIsMC > 0 ){
         for(Int_t gamma=0;gamma<fGammaCandidates->GetEntries();gamma++){ // Smear the AODPhotons in MC
           ((AliAODConversionPhoton*)fGammaCandidates->At(gamma))->SetPx(fUnsmearedPx[gamma]); // Reset Unsmeared Momenta
@@ -1891,7 +1907,7 @@ void AliAnalysisTaskGammaConvV1::ProcessPhotonCandidates()
       if( (isNegFromMBHeader+isPosFromMBHeader) != 4) fIsFromSelectedHeader = kFALSE;
     }
   
-    if(!((AliConversionPhotonCuts*)fCutArray->At(fiCut))->PhotonIsSelected(PhotonCandidate,fInputEvent)) continue;
+    if(!fCutSetSelector->PhotonIsSelected(fiCut,i,PhotonCandidate,fInputEvent)) continue;
     if(!((AliConversionPhotonCuts*)fCutArray->At(fiCut))->InPlaneOutOfPlaneCut(PhotonCandidate->GetPhotonPhi(),fEventPlaneAngle)) continue;
     if(!((AliConversionPhotonCuts*)fCutArray->At(fiCut))->UseElecSharingCut() &&
       !((AliConversionPhotonCuts*)fCutArray->At(fiCut))->UseToCloseV0sCut()){
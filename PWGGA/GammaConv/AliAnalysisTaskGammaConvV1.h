@@ -17,6 +17,8 @@
 #include <vector>
 #include <map>
 
+class AliConversionCutSetSelector;
+
 class AliAnalysisTaskGammaConvV1 : public AliAnalysisTaskSE {
 
   public:
@@ -37,6 +39,7 @@ class AliAnalysisTaskGammaConvV1 : public AliAnalysisTaskSE {
     void SetIsMC(Int_t isMC)                                      { fIsMC                       = isMC    ;}
     void SetDoMesonAnalysis(Bool_t flag)                          { fDoMesonAnalysis            = flag    ;}
     void SetDoMesonQA(Int_t flag)                                 { fDoMesonQA                  = flag    ;}
+    void SetVerifyCutSetSelection(Bool_t flag)                    { fVerifyCutSetSelection      = flag    ;}
     void SetDoPhotonQA(Int_t flag)                                { fDoPhotonQA                 = flag    ;}
     void SetDoClusterSelectionForTriggerNorm(Bool_t flag)         { fEnableClusterCutsForTrigger= flag    ;}
     void SetDoChargedPrimary(Bool_t flag)                         { fDoChargedPrimary           = flag    ;}
@@ -104,6 +107,8 @@ class AliAnalysisTaskGammaConvV1 : public AliAnalysisTaskSE {
     TList*                            fOutputContainer;                           //
     TClonesArray*                     fReaderGammas;                              //
     TList*                            fGammaCandidates;                           //
+    AliConversionCutSetSelector*      fCutSetSelector;                            //! photon selection shared between cut sets
+    Bool_t                            fVerifyCutSetSelection;                     // cross check the shared photon selection against the full selection
     TList*                            fEventCutArray;                             //
     TList*                            fCutArray;                                  //
     TList*                            fMesonCutArray;                             //
@@ -307,7 +312,7 @@ class AliAnalysisTaskGammaConvV1 : public AliAnalysisTaskSE {
 
     AliAnalysisTaskGammaConvV1(const AliAnalysisTaskGammaConvV1&); // Prevent copy-construction
     AliAnalysisTaskGammaConvV1 &operator=(const AliAnalysisTaskGammaConvV1&); // Prevent assignment
-    ClassDef(AliAnalysisTaskGammaConvV1, 42);
+    ClassDef(AliAnalysisTaskGammaConvV1, 43);
 };
 
 #endif
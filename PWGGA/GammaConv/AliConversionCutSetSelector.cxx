@@ -0,0 +1,183 @@
+/**************************************************************************************
+ * Copyright (C) 2017, Copyright Holders of the ALICE Collaboration                   *
+ * All rights reserved.                                                               *
+ *                                                                                    *
+ * Redistribution and use in source and binary forms, with or without                 *
+ * modification, are permitted provided that the following conditions are met:        *
+ *     * Redistributions of source code must retain the above copyright               *
+ *       notice, this list of conditions and the following disclaimer.                *
+ *     * Redistributions in binary form must reproduce the above copyright            *
+ *       notice, this list of conditions and the following disclaimer in the          *
+ *       documentation and/or other materials provided with the distribution.         *
+ *     * Neither the name of the <organization> nor the                               *
+ *       names of its contributors may be used to endorse or promote products         *
+ *       derived from this software without specific prior written permission.        *
+ *                                                                                    *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND    *
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED      *
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE             *
+ * DISCLAIMED. IN NO EVENT SHALL ALICE COLLABORATION BE LIABLE FOR ANY                *
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES         *
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;       *
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND        *
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT         *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS      *
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                       *
+ **************************************************************************************/
+#include <map>
+#include <string>
+
+#include <TList.h>
+
+#include "AliLog.h"
+#include "AliVEvent.h"
+#include "AliVTrack.h"
+#include "AliConversionPhotonBase.h"
+#include "AliConversionPhotonCuts.h"
+#include "AliConversionCutSetSelector.h"
+
+///________________________________________________________________________
+AliConversionCutSetSelector::AliConversionCutSetSelector():
+	fPhotonCutArray(NULL),
+	fNCriteria(0),
+	fNWords(0),
+	fNCandidates(0),
+	fCriterion(),
+	fQAMask(),
+	fEvaluated(),
+	fPassed(),
+	fRecordMask(),
+	fRecords(),
+	fNegTrack(),
+	fPosTrack(),
+	fVerifySelection(kFALSE),
+	fNMismatches(0)
+{
+}
+
+///________________________________________________________________________
+void AliConversionCutSetSelector::Init(TList *photonCutArray, Int_t nCuts){
+	// Map the selection stages of the cut sets to the elementary criteria, stages with the
+	// same key share a criterion. Has to be called after the cut histograms were created.
+
+	fPhotonCutArray = photonCutArray;
+	fNCriteria = 0;
+	fCriterion.assign(nCuts * AliConversionPhotonCuts::kNSelectionStages, -1);
+	fQAMask.assign(nCuts, 0);
+
+	std::map<std::string, Int_t> criteria;
+	for(Int_t iCut = 0; iCut < nCuts; iCut++){
+		AliConversionPhotonCuts *cuts = (AliConversionPhotonCuts*)fPhotonCutArray->At(iCut);
+		for(Int_t stage = 0; stage < AliConversionPhotonCuts::kNSelectionStages; stage++){
+			std::map<std::string, Int_t>::const_iterator it = criteria.insert(std::make_pair(std::string(cuts->GetStageKey(stage).Data()), fNCriteria)).first;
+			if(it->second == fNCriteria) fNCriteria++;
+			fCriterion[iCut * AliConversionPhotonCuts::kNSelectionStages + stage] = it->second;
+		}
+		fQAMask[iCut] = cuts->GetQAHistogramMask();
+	}
+
+	fNWords = (fNCriteria + 63) / 64;
+	fNCandidates = 0;
+	fNMismatches = 0;
+	fEvaluated.clear();
+	fPassed.clear();
+}
+
+///________________________________________________________________________
+Int_t AliConversionCutSetSelector::GetCriterion(Int_t iCut, Int_t stage) const {
+	return fCriterion[iCut * AliConversionPhotonCuts::kNSelectionStages + stage];
+}
+
+///________________________________________________________________________
+void AliConversionCutSetSelector::NextEvent(Int_t nCandidates){
+	// Forget the selections of the previous event, the capacity of the bitmasks and records is kept.
+	// Records and tracks are only read for evaluated criteria and need no reset.
+
+	fNCandidates = nCandidates;
+	fEvaluated.assign(fNCandidates * fNWords, 0);
+	fPassed.assign(fNCandidates * fNWords, 0);
+
+	const UInt_t nSlots = fNCandidates * fNCriteria;
+	if(fRecords.size() < nSlots){
+		fRecords.resize(nSlots);
+		fRecordMask.resize(nSlots, 0);
+		fNegTrack.resize(nSlots, NULL);
+		fPosTrack.resize(nSlots, NULL);
+	}
+}
+
+///________________________________________________________________________
+void AliConversionCutSetSelector::Invalidate(){
+	// Forget the selections of the current event, e.g. after the candidates were modified
+
+	fEvaluated.assign(fEvaluated.size(), 0);
+}
+
+///________________________________________________________________________
+Bool_t AliConversionCutSetSelector::PhotonIsSelected(Int_t iCut, Int_t iCandidate, AliConversionPhotonBase *photon, AliVEvent *event){
+	// Photon selection of cut set iCut for candidate iCandidate of the current event,
+	// same outcome and bookkeeping as AliConversionPhotonCuts::PhotonIsSelected
+
+	const Bool_t selected = SelectPhoton(iCut, iCandidate, photon, event);
+	if(fVerifySelection){
+		AliConversionPhotonCuts *cuts = (AliConversionPhotonCuts*)fPhotonCutArray->At(iCut);
+		if(cuts->PhotonPassesSelection(photon, event) != selected){
+			fNMismatches++;
+			AliErrorGeneral("AliConversionCutSetSelector", Form("cut set %d (%s), candidate %d: shared selection %d differs from full selection",
+				iCut, cuts->GetCutNumber().Data(), iCandidate, selected));
+		}
+	}
+	return selected;
+}
+
+///________________________________________________________________________
+Bool_t AliConversionCutSetSelector::SelectPhoton(Int_t iCut, Int_t iCandidate, AliConversionPhotonBase *photon, AliVEvent *event){
+	// Shared evaluation of the selection stages, see PhotonIsSelected
+
+	AliConversionPhotonCuts *cuts = (AliConversionPhotonCuts*)fPhotonCutArray->At(iCut);
+	if(iCandidate < 0 || iCandidate >= fNCandidates) return cuts->PhotonIsSelected(photon, event);
+
+	cuts->FillPhotonCutIndex(AliConversionPhotonCuts::kPhotonIn);
+
+	const UInt_t qaMask = fQAMask[iCut];
+	AliVTrack *negTrack = NULL;
+	AliVTrack *posTrack = NULL;
+	for(Int_t stage = 0; stage < AliConversionPhotonCuts::kNSelectionStages; stage++){
+		const Int_t criterion = fCriterion[iCut * AliConversionPhotonCuts::kNSelectionStages + stage];
+		const Int_t slot = iCandidate * fNCriteria + criterion;
+		const Int_t word = iCandidate * fNWords + criterion / 64;
+		const ULong64_t bit = 1ULL << (criterion % 64);
+
+		Bool_t passed;
+		if((fEvaluated[word] & bit) && (qaMask & ~fRecordMask[slot]) == 0){
+			passed = (fPassed[word] & bit) != 0;
+			if(qaMask) cuts->ReplayQAFills(fRecords[slot]);
+			if(stage == AliConversionPhotonCuts::kStageTracks){
+				negTrack = fNegTrack[slot];
+				posTrack = fPosTrack[slot];
+			}
+		} else {
+			fRecords[slot].clear();
+			cuts->SetQAFillRecord(qaMask ? &fRecords[slot] : NULL);
+			passed = cuts->PhotonPassesStage(stage, photon, event, negTrack, posTrack);
+			cuts->SetQAFillRecord(NULL);
+			fRecordMask[slot] = qaMask;
+			fEvaluated[word] |= bit;
+			if(passed) fPassed[word] |= bit;
+			else fPassed[word] &= ~bit;
+			if(stage == AliConversionPhotonCuts::kStageTracks){
+				fNegTrack[slot] = negTrack;
+				fPosTrack[slot] = posTrack;
+			}
+		}
+
+		if(!passed){
+			cuts->FillPhotonCutIndex(AliConversionPhotonCuts::fgkStageCutIndex[stage]);
+			return kFALSE;
+		}
+	}
+
+	// Photon passed cuts
+	cuts->FillPhotonCutIndex(AliConversionPhotonCuts::kPhotonOut);
+	return kTRUE;
+}
@@ -0,0 +1,99 @@
+/**************************************************************************************
+ * Copyright (C) 2017, Copyright Holders of the ALICE Collaboration                   *
+ * All rights reserved.                                                               *
+ *                                                                                    *
+ * Redistribution and use in source and binary forms, with or without                 *
+ * modification, are permitted provided that the following conditions are met:        *
+ *     * Redistributions of source code must retain the above copyright               *
+ *       notice, this list of conditions and the following disclaimer.                *
+ *     * Redistributions in binary form must reproduce the above copyright            *
+ *       notice, this list of conditions and the following disclaimer in the          *
+ *       documentation and/or other materials provided with the distribution.         *
+ *     * Neither the name of the <organization> nor the                               *
+ *       names of its contributors may be used to endorse or promote products         *
+ *       derived from this software without specific prior written permission.        *
+ *                                                                                    *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND    *
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED      *
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE             *
+ * DISCLAIMED. IN NO EVENT SHALL ALICE COLLABORATION BE LIABLE FOR ANY                *
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES         *
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;       *
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND        *
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT         *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS      *
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                       *
+ **************************************************************************************/
+#ifndef ALICONVERSIONCUTSETSELECTOR_H
+#define ALICONVERSIONCUTSETSELECTOR_H
+
+#include <vector>
+#include <Rtypes.h>
+
+class TList;
+class AliVEvent;
+class AliVTrack;
+class AliConversionPhotonBase;
+
+/**
+ * @class AliConversionCutSetSelector
+ * @brief Photon selection shared between the cut sets of a task
+ * @ingroup GammaConv
+ *
+ * Tasks running several cut sets (AliAnalysisTaskGammaConvV1, AliAnalysisTaskGammaConvCalo)
+ * select the photons of the V0 reader once per cut set. The photon selection is split into
+ * the stages of AliConversionPhotonCuts::photonSelectionStages; a stage together with the
+ * settings it reads (AliConversionPhotonCuts::GetStageKey) is an elementary criterion, shared
+ * by all cut sets with the same settings for this stage. Each criterion is evaluated once
+ * per candidate, its result is stored in a per-candidate bitmask with one bit per criterion,
+ * and the decision of a cut set is derived from the bits of its stages.
+ *
+ * The QA histogram fills of an evaluated stage are recorded, a cut set reusing the stage
+ * replays them into its own histograms. The stage is evaluated again if the record misses
+ * histograms of the cut set. The outcome, histograms included, is thus the same as running
+ * the selection for every cut set.
+ *
+ * With SetVerifySelection(kTRUE) each shared decision is cross checked against the full
+ * selection of the cut set (AliConversionPhotonCuts::PhotonPassesSelection) on the same
+ * candidate, differences are reported as errors and counted (GetNMismatches).
+ */
+class AliConversionCutSetSelector {
+public:
+	AliConversionCutSetSelector();
+	virtual ~AliConversionCutSetSelector() {}
+
+	void Init(TList *photonCutArray, Int_t nCuts);
+	void NextEvent(Int_t nCandidates);
+	void Invalidate();
+
+	Bool_t PhotonIsSelected(Int_t iCut, Int_t iCandidate, AliConversionPhotonBase *photon, AliVEvent *event);
+
+	void SetVerifySelection(Bool_t verify) { fVerifySelection = verify; }
+	Long64_t GetNMismatches() const { return fNMismatches; }
+
+	Int_t GetNCriteria() const { return fNCriteria; }
+	Int_t GetCriterion(Int_t iCut, Int_t stage) const;
+
+private:
+	AliConversionCutSetSelector(const AliConversionCutSetSelector &ref);
+	AliConversionCutSetSelector &operator=(const AliConversionCutSetSelector &ref);
+
+	Bool_t SelectPhoton(Int_t iCut, Int_t iCandidate, AliConversionPhotonBase *photon, AliVEvent *event);
+
+	TList* fPhotonCutArray;                         ///< Photon cuts of the cut sets (not owned)
+	Int_t fNCriteria;                               ///< Number of distinct elementary criteria
+	Int_t fNWords;                                  ///< Number of 64 bit words per candidate
+	Int_t fNCandidates;                             ///< Number of photon candidates in the current event
+	std::vector<Int_t> fCriterion;                  ///< Criterion of each stage of each cut set
+	std::vector<UInt_t> fQAMask;                    ///< QA histograms filled by the stages of each cut set
+	std::vector<ULong64_t> fEvaluated;              ///< Per candidate: criteria which were evaluated
+	std::vector<ULong64_t> fPassed;                 ///< Per candidate: criteria passed by the candidate
+	std::vector<UInt_t> fRecordMask;                ///< Per candidate and criterion: QA histograms in the fill record
+	std::vector<std::vector<Double_t> > fRecords;   ///< Per candidate and criterion: recorded QA histogram fills
+	std::vector<AliVTrack*> fNegTrack;              ///< Per candidate and criterion: negative track of the tracks stage
+	std::vector<AliVTrack*> fPosTrack;              ///< Per candidate and criterion: positive track of the tracks stage
+	Bool_t fVerifySelection;                        ///< Cross check the shared decisions against the full selection
+	Long64_t fNMismatches;                          ///< Number of shared decisions differing from the full selection
+};
+
+#endif /* ALICONVERSIONCUTSETSELECTOR_H */
@@ -92,6 +92,15 @@ const char* AliConversionPhotonCuts::fgkCutNames[AliConversionPhotonCuts::kNCuts
   "EvetPlane"               // 25
 };
 
+const Int_t AliConversionPhotonCuts::fgkStageCutIndex[AliConversionPhotonCuts::kNSelectionStages] = {
+  kOnFly,                   // kStageV0Finder
+  kNoTracks,                // kStageTracks
+  kNoV0,                    // kStageV0InAOD
+  kTrackCuts,               // kStageTrackCuts
+  kdEdxCuts,                // kStagedEdxCuts
+  kPhotonCuts               // kStagePhotonCuts
+};
+
 
 //________________________________________________________________________
 AliConversionPhotonCuts::AliConversionPhotonCuts(const char *name,const char *title) :
@@ -220,7 +229,9 @@ AliConversionPhotonCuts::AliConversionPhotonCuts(const char *name,const char *ti
   fPreSelCut(kFALSE),
   fProcessAODCheck(kFALSE),
   fProfileContainingMaterialBudgetWeights(NULL),
-  fMaterialBudgetWeightsInitialized(kFALSE)
+  fMaterialBudgetWeightsInitialized(kFALSE),
+  fQAFillRecord(NULL),
+  fQAFillsDisabled(kFALSE)
 {
   InitPIDResponse();
   for(Int_t jj=0;jj<kNCuts;jj++){fCuts[jj]=0;}
@@ -356,7 +367,9 @@ AliConversionPhotonCuts::AliConversionPhotonCuts(const AliConversionPhotonCuts &
   fPreSelCut(ref.fPreSelCut),
   fProcessAODCheck(ref.fProcessAODCheck),
   fProfileContainingMaterialBudgetWeights(ref.fProfileContainingMaterialBudgetWeights),
-  fMaterialBudgetWeightsInitialized(ref.fMaterialBudgetWeightsInitialized)
+  fMaterialBudgetWeightsInitialized(ref.fMaterialBudgetWeightsInitialized),
+  fQAFillRecord(NULL),
+  fQAFillsDisabled(kFALSE)
 {
   // Copy Constructor
   for(Int_t jj=0;jj<kNCuts;jj++){fCuts[jj]=ref.fCuts[jj];}
@@ -807,17 +820,17 @@ Bool_t AliConversionPhotonCuts::PhotonIsSelectedAODMC(AliAODMCParticle *particle
 Bool_t AliConversionPhotonCuts::PhotonCuts(AliConversionPhotonBase *photon,AliVEvent *event){   // Specific Photon Cuts
 
   Int_t cutIndex = 0;
-  if(fHistoPhotonCuts)fHistoPhotonCuts->Fill(cutIndex, photon->GetPhotonPt());
+  if(fHistoPhotonCuts)FillQAHistogram(kQAPhotonCuts,cutIndex, photon->GetPhotonPt());
   cutIndex++;
 
   // Fill Histos before Cuts
-  if(fHistoInvMassbefore)fHistoInvMassbefore->Fill(photon->GetMass());
-  if(fHistoArmenterosbefore)fHistoArmenterosbefore->Fill(photon->GetArmenterosAlpha(),photon->GetArmenterosQt());
+  if(fHistoInvMassbefore)FillQAHistogram(kQAInvMassbefore,photon->GetMass());
+  if(fHistoArmenterosbefore)FillQAHistogram(kQAArmenterosbefore,photon->GetArmenterosAlpha(),photon->GetArmenterosQt());
 
   // Gamma selection based on QT from Armenteros
   if(fDoQtGammaSelection == kTRUE){
     if(!ArmenterosQtCut(photon)){
-      if(fHistoPhotonCuts)fHistoPhotonCuts->Fill(cutIndex, photon->GetPhotonPt()); //1
+      if(fHistoPhotonCuts)FillQAHistogram(kQAPhotonCuts,cutIndex, photon->GetPhotonPt()); //1
       return kFALSE;
     }
   }
@@ -826,7 +839,7 @@ Bool_t AliConversionPhotonCuts::PhotonCuts(AliConversionPhotonBase *photon,AliVE
   // Chi Cut
   if(photon->GetChi2perNDF() > fChi2CutConversion || photon->GetChi2perNDF() <=0){
     {
-      if(fHistoPhotonCuts)fHistoPhotonCuts->Fill(cutIndex, photon->GetPhotonPt()); //2
+      if(fHistoPhotonCuts)FillQAHistogram(kQAPhotonCuts,cutIndex, photon->GetPhotonPt()); //2
       return kFALSE;
     }
   }
@@ -834,7 +847,7 @@ Bool_t AliConversionPhotonCuts::PhotonCuts(AliConversionPhotonBase *photon,AliVE
 
   // Reconstruction Acceptance Cuts
   if(!AcceptanceCuts(photon)){
-    if(fHistoPhotonCuts)fHistoPhotonCuts->Fill(cutIndex, photon->GetPhotonPt()); //3
+    if(fHistoPhotonCuts)FillQAHistogram(kQAPhotonCuts,cutIndex, photon->GetPhotonPt()); //3
     return kFALSE;
   }
 
@@ -842,7 +855,7 @@ Bool_t AliConversionPhotonCuts::PhotonCuts(AliConversionPhotonBase *photon,AliVE
   // Asymmetry Cut
   if(fDoPhotonAsymmetryCut == kTRUE){
     if(!AsymmetryCut(photon,event)){
-      if(fHistoPhotonCuts)fHistoPhotonCuts->Fill(cutIndex, photon->GetPhotonPt()); //4
+      if(fHistoPhotonCuts)FillQAHistogram(kQAPhotonCuts,cutIndex, photon->GetPhotonPt()); //4
       return kFALSE;
     }
   }
@@ -850,13 +863,13 @@ Bool_t AliConversionPhotonCuts::PhotonCuts(AliConversionPhotonBase *photon,AliVE
   //Check the pid probability
   cutIndex++; //5
   if(!PIDProbabilityCut(photon, event)) {
-    if(fHistoPhotonCuts)fHistoPhotonCuts->Fill(cutIndex, photon->GetPhotonPt()); //5
+    if(fHistoPhotonCuts)FillQAHistogram(kQAPhotonCuts,cutIndex, photon->GetPhotonPt()); //5
     return kFALSE;
   }
 
   cutIndex++; //6
   if(!CorrectedTPCClusterCut(photon, event)) {
-    if(fHistoPhotonCuts)fHistoPhotonCuts->Fill(cutIndex, photon->GetPhotonPt()); //6
+    if(fHistoPhotonCuts)FillQAHistogram(kQAPhotonCuts,cutIndex, photon->GetPhotonPt()); //6
     return kFALSE;
   }
 
@@ -873,13 +886,13 @@ Bool_t AliConversionPhotonCuts::PhotonCuts(AliConversionPhotonBase *photon,AliVE
 
   cutIndex++; //7
   if(!PsiPairCut(photon)) {
-    if(fHistoPhotonCuts)fHistoPhotonCuts->Fill(cutIndex, photon->GetPhotonPt()); //7
+    if(fHistoPhotonCuts)FillQAHistogram(kQAPhotonCuts,cutIndex, photon->GetPhotonPt()); //7
     return kFALSE;
   }
 
   cutIndex++; //8
   if(!CosinePAngleCut(photon, event)) {
-    if(fHistoPhotonCuts)fHistoPhotonCuts->Fill(cutIndex, photon->GetPhotonPt()); //8
+    if(fHistoPhotonCuts)FillQAHistogram(kQAPhotonCuts,cutIndex, photon->GetPhotonPt()); //8
     return kFALSE;
   }
 
@@ -889,13 +902,13 @@ Bool_t AliConversionPhotonCuts::PhotonCuts(AliConversionPhotonBase *photon,AliVE
 
     cutIndex++; //9
     if(photonAOD->GetDCArToPrimVtx() > fDCARPrimVtxCut) { //DCA R cut of photon to primary vertex
-      if(fHistoPhotonCuts)fHistoPhotonCuts->Fill(cutIndex, photon->GetPhotonPt()); //9
+      if(fHistoPhotonCuts)FillQAHistogram(kQAPhotonCuts,cutIndex, photon->GetPhotonPt()); //9
       return kFALSE;
     }
 
     cutIndex++; //10
     if(TMath::Abs(photonAOD->GetDCAzToPrimVtx()) > fDCAZPrimVtxCut) { //DCA Z cut of photon to primary vertex
-      if(fHistoPhotonCuts)fHistoPhotonCuts->Fill(cutIndex, photon->GetPhotonPt()); //10
+      if(fHistoPhotonCuts)FillQAHistogram(kQAPhotonCuts,cutIndex, photon->GetPhotonPt()); //10
       return kFALSE;
     }
   } else {
@@ -913,20 +926,20 @@ Bool_t AliConversionPhotonCuts::PhotonCuts(AliConversionPhotonBase *photon,AliVE
         photonQuality = photonAOD->GetPhotonQuality();
       }
       if (fDoPhotonQualitySelectionCut && photonQuality != fPhotonQualityCut){
-        if(fHistoPhotonCuts)fHistoPhotonCuts->Fill(cutIndex, photon->GetPhotonPt()); //11
+        if(fHistoPhotonCuts)FillQAHistogram(kQAPhotonCuts,cutIndex, photon->GetPhotonPt()); //11
         return kFALSE;
       }
   } 
   cutIndex++; //12
-  if(fHistoPhotonCuts)fHistoPhotonCuts->Fill(cutIndex, photon->GetPhotonPt()); //11
+  if(fHistoPhotonCuts)FillQAHistogram(kQAPhotonCuts,cutIndex, photon->GetPhotonPt()); //11
 
   // Histos after Cuts
-  if(fHistoInvMassafter)fHistoInvMassafter->Fill(photon->GetMass());
-  if(fHistoArmenterosafter)fHistoArmenterosafter->Fill(photon->GetArmenterosAlpha(),photon->GetArmenterosQt());
-  if(fHistoPsiPairDeltaPhiafter)fHistoPsiPairDeltaPhiafter->Fill(deltaPhi,photon->GetPsiPair());
-  if(fHistoKappaafter)fHistoKappaafter->Fill(photon->GetPhotonPt(), GetKappaTPC(photon, event));
+  if(fHistoInvMassafter)FillQAHistogram(kQAInvMassafter,photon->GetMass());
+  if(fHistoArmenterosafter)FillQAHistogram(kQAArmenterosafter,photon->GetArmenterosAlpha(),photon->GetArmenterosQt());
+  if(fHistoPsiPairDeltaPhiafter)FillQAHistogram(kQAPsiPairDeltaPhiafter,deltaPhi,photon->GetPsiPair());
+  if(fHistoKappaafter)FillQAHistogram(kQAKappaafter,photon->GetPhotonPt(), GetKappaTPC(photon, event));
   if(fHistoAsymmetryafter){
-    if(photon->GetPhotonP()!=0 && electronCandidate->P()!=0)fHistoAsymmetryafter->Fill(photon->GetPhotonP(),electronCandidate->P()/photon->GetPhotonP());
+    if(photon->GetPhotonP()!=0 && electronCandidate->P()!=0)FillQAHistogram(kQAAsymmetryafter,photon->GetPhotonP(),electronCandidate->P()/photon->GetPhotonP());
   }
   return kTRUE;
 
@@ -972,68 +985,237 @@ Bool_t AliConversionPhotonCuts::PhotonIsSelected(AliConversionPhotonBase *photon
 
   FillPhotonCutIndex(kPhotonIn);
 
-  if(event->IsA()==AliESDEvent::Class()) {
-    if(!SelectV0Finder( ( ((AliESDEvent*)event)->GetV0(photon->GetV0Index()))->GetOnFlyStatus() ) ){
-      FillPhotonCutIndex(kOnFly);
+  AliVTrack * negTrack = NULL;
+  AliVTrack * posTrack = NULL;
+  for(Int_t stage=0; stage<kNSelectionStages; stage++){
+    if(!PhotonPassesStage(stage, photon, event, negTrack, posTrack)){
+      FillPhotonCutIndex(fgkStageCutIndex[stage]);
       return kFALSE;
     }
   }
 
-  // Get Tracks
-  AliVTrack * negTrack = GetTrack(event, photon->GetTrackLabelNegative());
-  AliVTrack * posTrack = GetTrack(event, photon->GetTrackLabelPositive());
+  // Photon passed cuts
+  FillPhotonCutIndex(kPhotonOut);
+  return kTRUE;
+}
 
-  if(!negTrack || !posTrack) {
-    FillPhotonCutIndex(kNoTracks);
-    return kFALSE;
+///________________________________________________________________________
+Bool_t AliConversionPhotonCuts::PhotonPassesSelection(AliConversionPhotonBase *photon, AliVEvent * event){
+  // Decision of PhotonIsSelected without filling the cut index and QA histograms,
+  // used to cross check the selection shared between cut sets
+
+  AliVTrack * negTrack = NULL;
+  AliVTrack * posTrack = NULL;
+  Bool_t passed = kTRUE;
+  fQAFillsDisabled = kTRUE;
+  for(Int_t stage=0; stage<kNSelectionStages && passed; stage++){
+    passed = PhotonPassesStage(stage, photon, event, negTrack, posTrack);
   }
+  fQAFillsDisabled = kFALSE;
+  return passed;
+}
 
-  // check if V0 from AliAODGammaConversion.root is actually contained in AOD by checking if V0 exists with same tracks
-  if(event->IsA()==AliAODEvent::Class() && fPreSelCut && ( fIsHeavyIon != 1 || (fIsHeavyIon == 1 && fProcessAODCheck) )) {
-    AliAODEvent* aodEvent = dynamic_cast<AliAODEvent*>(event);
-
-    Bool_t bFound = kFALSE;
-    Int_t v0PosID = posTrack->GetID();
-    Int_t v0NegID = negTrack->GetID();
-    AliAODv0* v0 = NULL;
-    for(Int_t iV=0; iV<aodEvent->GetNumberOfV0s(); iV++){
-      v0 = aodEvent->GetV0(iV);
-      if(!v0) continue;
-      if( (v0PosID == v0->GetPosID() && v0NegID == v0->GetNegID()) || (v0PosID == v0->GetNegID() && v0NegID == v0->GetPosID()) ){
-        bFound = kTRUE;
-        break;
+///________________________________________________________________________
+Bool_t AliConversionPhotonCuts::PhotonPassesStage(Int_t stage, AliConversionPhotonBase *photon, AliVEvent * event, AliVTrack *&negTrack, AliVTrack *&posTrack){
+  // Single stage of the photon selection, the stages have to be called in the order of photonSelectionStages.
+  // The tracks are set by kStageTracks and are input of the later stages.
+
+  switch(stage){
+    case kStageV0Finder:
+      if(event->IsA()==AliESDEvent::Class()) {
+        if(!SelectV0Finder( ( ((AliESDEvent*)event)->GetV0(photon->GetV0Index()))->GetOnFlyStatus() ) ) return kFALSE;
       }
-    }
-    if(!bFound){
-      FillPhotonCutIndex(kNoV0);
+      return kTRUE;
+
+    case kStageTracks:
+      negTrack = GetTrack(event, photon->GetTrackLabelNegative());
+      posTrack = GetTrack(event, photon->GetTrackLabelPositive());
+      return (negTrack && posTrack);
+
+    case kStageV0InAOD:
+      // check if V0 from AliAODGammaConversion.root is actually contained in AOD by checking if V0 exists with same tracks
+      if(event->IsA()==AliAODEvent::Class() && fPreSelCut && ( fIsHeavyIon != 1 || (fIsHeavyIon == 1 && fProcessAODCheck) )) {
+        AliAODEvent* aodEvent = dynamic_cast<AliAODEvent*>(event);
+
+        Bool_t bFound = kFALSE;
+        Int_t v0PosID = posTrack->GetID();
+        Int_t v0NegID = negTrack->GetID();
+        AliAODv0* v0 = NULL;
+        for(Int_t iV=0; iV<aodEvent->GetNumberOfV0s(); iV++){
+          v0 = aodEvent->GetV0(iV);
+          if(!v0) continue;
+          if( (v0PosID == v0->GetPosID() && v0NegID == v0->GetNegID()) || (v0PosID == v0->GetNegID() && v0NegID == v0->GetPosID()) ){
+            bFound = kTRUE;
+            break;
+          }
+        }
+        if(!bFound) return kFALSE;
+      }
+      return kTRUE;
+
+    case kStageTrackCuts:
+      photon->DeterminePhotonQuality(negTrack,posTrack);
+      if(!TracksAreSelected(negTrack, posTrack)) return kFALSE;
+      if(fHistoEtaDistV0s)FillQAHistogram(kQAEtaDistV0s,photon->GetPhotonEta());
+      return kTRUE;
+
+    case kStagedEdxCuts:
+      if(!KappaCuts(photon, event) || !dEdxCuts(negTrack) || !dEdxCuts(posTrack)) return kFALSE;
+      if(fHistoEtaDistV0sAfterdEdxCuts)FillQAHistogram(kQAEtaDistV0sAfterdEdxCuts,photon->GetPhotonEta());
+      return kTRUE;
+
+    case kStagePhotonCuts:
+      return PhotonCuts(photon,event);
+
+    default:
+      AliError(Form("unknown selection stage %d",stage));
       return kFALSE;
+  }
+}
+
+///________________________________________________________________________
+TString AliConversionPhotonCuts::GetStageKey(Int_t stage) const {
+  // Key of a selection stage: the stage, the cut string digits it depends on and all settings read
+  // by it (these can be changed by setters after the cut string). Two cut objects with the same key
+  // for a stage give the same result for this stage on the same photon.
+
+  TString key = Form("%d",stage);
+
+  const Int_t kNStageCutIds = 13;
+  const Int_t stageCutIds[kNSelectionStages][kNStageCutIds] = {
+    {kv0FinderType,-1},                                                                   // kStageV0Finder
+    {-1},                                                                                 // kStageTracks
+    {-1},                                                                                 // kStageV0InAOD
+    {kv0FinderType,ketaCut,ksinglePtCut,kclsTPCCut,-1},                                   // kStageTrackCuts
+    {kededxSigmaCut,kpidedxSigmaCut,kpiMomdedxSigmaCut,kpiMaxMomdedxSigmaCut,
+     kLowPRejectionSigmaCut,kTOFelectronPID,kITSelectronPID,kTRDelectronPID,-1},          // kStagedEdxCuts
+    {ketaCut,kRCut,kEtaForPhiSector,kMinPhiSector,kMaxPhiSector,kclsTPCCut,kQtMaxCut,
+     kchi2GammaCut,kPsiPair,kdoPhotonAsymmetryCut,kCosPAngle,kDcaRPrimVtx,kDcaZPrimVtx}  // kStagePhotonCuts
+  };
+  if(stage>=0 && stage<kNSelectionStages){
+    key += " digits";
+    for(Int_t i=0; i<kNStageCutIds && stageCutIds[stage][i]>=0; i++) key += Form(" %d",fCuts[stageCutIds[stage][i]]);
+  }
+
+  switch(stage){
+    case kStageV0Finder:
+      key += Form(" %d",fUseOnFlyV0Finder);
+      break;
+    case kStageTracks:
+      key += " "+fV0ReaderName;
+      break;
+    case kStageV0InAOD:
+      key += Form(" %d %d %d",fPreSelCut,fIsHeavyIon,fProcessAODCheck);
+      break;
+    case kStageTrackCuts:
+      key += Form(" %d %.17g %.17g %.17g %d %.17g %.17g",fUseOnFlyV0FinderSameSign,fMinClsTPC,fEtaCut,fEtaCutMin,
+                  fDoAsymPtCut,fSinglePtCut,fSinglePtCut2);
+      break;
+    case kStagedEdxCuts: {
+      key += Form(" %d %d %d %d %d",fDodEdxSigmaCut,fSwitchToKappa,fDoTRDPID,fUseITSpid,fUseTOFpid);
+      const Double_t values[] = {fDoKaonRejectionLowP,fDoPionRejectionLowP,fDoProtonRejectionLowP,
+                                 fITSPIDnSigmaAboveElectronLine,fITSPIDnSigmaBelowElectronLine,fKappaMaxCut,fKappaMinCut,
+                                 fMaxPtPIDITS,fPIDMaxPnSigmaAbovePionLine,fPIDMinPKaonRejectionLowP,fPIDMinPPionRejectionLowP,
+                                 fPIDMinPProtonRejectionLowP,fPIDMinPnSigmaAbovePionLine,fPIDTRDEfficiency,
+                                 fPIDnSigmaAboveElectronLine,fPIDnSigmaBelowElectronLine,fPIDnSigmaAbovePionLine,
+                                 fPIDnSigmaAbovePionLineHighPt,fPIDnSigmaAtLowPAroundKaonLine,fPIDnSigmaAtLowPAroundPionLine,
+                                 fPIDnSigmaAtLowPAroundProtonLine,fTofPIDnSigmaAboveElectronLine,fTofPIDnSigmaBelowElectronLine};
+      for(UInt_t i=0; i<sizeof(values)/sizeof(values[0]); i++) key += Form(" %.17g",values[i]);
+      break;
+    }
+    case kStagePhotonCuts: {
+      key += Form(" %d %d %d %d %d %d %d %d %d %d %d",fDo2DPsiPairChi2,fDo2DQt,fDoPhotonAsymmetryCut,fDoPhotonPDependentAsymCut,
+                  fDoPhotonQualitySelectionCut,fDoQtGammaSelection,fDoShrinkTPCAcceptance,fIncludeRejectedPsiPair,
+                  fUseCorrectedTPCClsInfo,fUseEtaMinCut,fPhotonQualityCut);
+      key += " "+fV0ReaderName;
+      const Double_t values[] = {fChi2CutConversion,fCosPAngleCut,fDCARPrimVtxCut,fDCAZPrimVtxCut,fEtaCut,fEtaCutMin,
+                                 fEtaForPhiCutMax,fEtaForPhiCutMin,fLineCutZRSlope,fLineCutZRSlopeMin,fLineCutZValue,
+                                 fLineCutZValueMin,fMaxPhiCut,fMinPhiCut,fMaxR,fMinR,fMaxZ,fMinClsTPCToF,
+                                 fMinPPhotonAsymmetryCut,fMinPhotonAsymmetry,fPIDProbabilityCutNegativeParticle,
+                                 fPIDProbabilityCutPositiveParticle,fPsiPairCut,fPtCut,fQtMax};
+      for(UInt_t i=0; i<sizeof(values)/sizeof(values[0]); i++) key += Form(" %.17g",values[i]);
+      // momentum dependent asymmetry cut, only its parameters differ between the cut string values
+      if(fFAsymmetryCut){
+        key += " "+fFAsymmetryCut->GetExpFormula();
+        for(Int_t i=0; i<fFAsymmetryCut->GetNpar(); i++) key += Form(" %.17g",fFAsymmetryCut->GetParameter(i));
+      }
+      break;
     }
+    default:
+      break;
   }
+  return key;
+}
 
-  photon->DeterminePhotonQuality(negTrack,posTrack);
-  // Track Cuts
-  if(!TracksAreSelected(negTrack, posTrack)){
-    FillPhotonCutIndex(kTrackCuts);
-    return kFALSE;
+///________________________________________________________________________
+TH1* AliConversionPhotonCuts::GetQAHistogram(Int_t slot) const {
+  // QA histogram filled by the selection stages
+
+  switch(slot){
+    case kQAEtaDistV0s:               return fHistoEtaDistV0s;
+    case kQAEtaDistV0sAfterdEdxCuts:  return fHistoEtaDistV0sAfterdEdxCuts;
+    case kQATrackCuts:                return fHistoTrackCuts;
+    case kQAdEdxCuts:                 return fHistodEdxCuts;
+    case kQATPCdEdxbefore:            return fHistoTPCdEdxbefore;
+    case kQATPCdEdxafter:             return fHistoTPCdEdxafter;
+    case kQATPCdEdxSigbefore:         return fHistoTPCdEdxSigbefore;
+    case kQATPCdEdxSigafter:          return fHistoTPCdEdxSigafter;
+    case kQATOFbefore:                return fHistoTOFbefore;
+    case kQATOFSigbefore:             return fHistoTOFSigbefore;
+    case kQATOFSigafter:              return fHistoTOFSigafter;
+    case kQAITSSigbefore:             return fHistoITSSigbefore;
+    case kQAITSSigafter:              return fHistoITSSigafter;
+    case kQAPhotonCuts:               return fHistoPhotonCuts;
+    case kQAInvMassbefore:            return fHistoInvMassbefore;
+    case kQAInvMassafter:             return fHistoInvMassafter;
+    case kQAArmenterosbefore:         return fHistoArmenterosbefore;
+    case kQAArmenterosafter:          return fHistoArmenterosafter;
+    case kQAPsiPairDeltaPhiafter:     return fHistoPsiPairDeltaPhiafter;
+    case kQAKappaafter:               return fHistoKappaafter;
+    case kQAAsymmetryafter:           return fHistoAsymmetryafter;
+    case kQAAcceptanceCuts:           return fHistoAcceptanceCuts;
+    default:                          return NULL;
   }
-  if (fHistoEtaDistV0s)fHistoEtaDistV0s->Fill(photon->GetPhotonEta());
-  // dEdx Cuts
-  
-  if(!KappaCuts(photon, event) || !dEdxCuts(negTrack) || !dEdxCuts(posTrack)) {
-    FillPhotonCutIndex(kdEdxCuts);
-    return kFALSE;
+}
+
+///________________________________________________________________________
+UInt_t AliConversionPhotonCuts::GetQAHistogramMask() const {
+  // Bit mask of the existing QA histograms filled by the selection stages
+
+  UInt_t mask = 0;
+  for(Int_t slot=0; slot<kNQAHistograms; slot++){
+    if(GetQAHistogram(slot)) mask |= (1u<<slot);
   }
-    
-  if (fHistoEtaDistV0sAfterdEdxCuts)fHistoEtaDistV0sAfterdEdxCuts->Fill(photon->GetPhotonEta());
-  // Photon Cuts
-  if(!PhotonCuts(photon,event)){
-    FillPhotonCutIndex(kPhotonCuts);
-    return kFALSE;
+  return mask;
+}
+
+///________________________________________________________________________
+void AliConversionPhotonCuts::FillQAHistogram(Int_t slot, Double_t x, Double_t y){
+  // Fill a QA histogram of the selection stages and add the fill to the record if one is set
+
+  if(fQAFillsDisabled) return;
+  TH1 *histo = GetQAHistogram(slot);
+  if(!histo) return;
+  if(histo->GetDimension()==1) histo->Fill(x);
+  else ((TH2*)histo)->Fill(x,y);
+
+  if(fQAFillRecord){
+    fQAFillRecord->push_back(slot);
+    fQAFillRecord->push_back(x);
+    fQAFillRecord->push_back(y);
+  }
+}
+
+///________________________________________________________________________
+void AliConversionPhotonCuts::ReplayQAFills(const std::vector<Double_t> &record){
+  // Repeat the QA histogram fills recorded for another cut object on the same photon and stage
+
+  for(UInt_t i=0; i+2<record.size(); i+=3){
+    TH1 *histo = GetQAHistogram((Int_t)record[i]);
+    if(!histo) continue;
+    if(histo->GetDimension()==1) histo->Fill(record[i+1]);
+    else ((TH2*)histo)->Fill(record[i+1],record[i+2]);
   }
-  
-  // Photon passed cuts
-  FillPhotonCutIndex(kPhotonOut);
-  return kTRUE;
 }
 
 ///________________________________________________________________________
@@ -1056,45 +1238,45 @@ Bool_t AliConversionPhotonCuts::AcceptanceCuts(AliConversionPhotonBase *photon)
   // Exclude certain areas for photon reconstruction
 
   Int_t cutIndex=0;
-  if(fHistoAcceptanceCuts)fHistoAcceptanceCuts->Fill(cutIndex, photon->GetPhotonPt());
+  if(fHistoAcceptanceCuts)FillQAHistogram(kQAAcceptanceCuts,cutIndex, photon->GetPhotonPt());
   cutIndex++;
 
   if(photon->GetConversionRadius()>fMaxR){ // cuts on distance from collision point
-    if(fHistoAcceptanceCuts)fHistoAcceptanceCuts->Fill(cutIndex, photon->GetPhotonPt());
+    if(fHistoAcceptanceCuts)FillQAHistogram(kQAAcceptanceCuts,cutIndex, photon->GetPhotonPt());
     return kFALSE;
   }
   cutIndex++;
 
   if(photon->GetConversionRadius()<fMinR){ // cuts on distance from collision point
-    if(fHistoAcceptanceCuts)fHistoAcceptanceCuts->Fill(cutIndex, photon->GetPhotonPt());
+    if(fHistoAcceptanceCuts)FillQAHistogram(kQAAcceptanceCuts,cutIndex, photon->GetPhotonPt());
     return kFALSE;
   }
   cutIndex++;
 
   if(photon->GetConversionRadius() <= ((TMath::Abs(photon->GetConversionZ())*fLineCutZRSlope)-fLineCutZValue)){
-    if(fHistoAcceptanceCuts)fHistoAcceptanceCuts->Fill(cutIndex, photon->GetPhotonPt());
+    if(fHistoAcceptanceCuts)FillQAHistogram(kQAAcceptanceCuts,cutIndex, photon->GetPhotonPt());
     return kFALSE;
   }
   else if (fUseEtaMinCut &&  photon->GetConversionRadius() >= ((TMath::Abs(photon->GetConversionZ())*fLineCutZRSlopeMin)-fLineCutZValueMin )){
-    if(fHistoAcceptanceCuts)fHistoAcceptanceCuts->Fill(cutIndex, photon->GetPhotonPt());
+    if(fHistoAcceptanceCuts)FillQAHistogram(kQAAcceptanceCuts,cutIndex, photon->GetPhotonPt());
     return kFALSE;
   }
   cutIndex++;
 
   if(TMath::Abs(photon->GetConversionZ()) > fMaxZ ){ // cuts out regions where we do not reconstruct
-    if(fHistoAcceptanceCuts)fHistoAcceptanceCuts->Fill(cutIndex, photon->GetPhotonPt());
+    if(fHistoAcceptanceCuts)FillQAHistogram(kQAAcceptanceCuts,cutIndex, photon->GetPhotonPt());
     return kFALSE;
   }
   cutIndex++;
 
 
   if( photon->GetPhotonEta() > (fEtaCut)    || photon->GetPhotonEta() < (-fEtaCut) ){
-    if(fHistoAcceptanceCuts)fHistoAcceptanceCuts->Fill(cutIndex, photon->GetPhotonPt());
+    if(fHistoAcceptanceCuts)FillQAHistogram(kQAAcceptanceCuts,cutIndex, photon->GetPhotonPt());
     return kFALSE;
   }
   if(fEtaCutMin>-0.1){
     if( photon->GetPhotonEta() < (fEtaCutMin) && photon->GetPhotonEta() > (-fEtaCutMin) ){
-      if(fHistoAcceptanceCuts)fHistoAcceptanceCuts->Fill(cutIndex, photon->GetPhotonPt());
+      if(fHistoAcceptanceCuts)FillQAHistogram(kQAAcceptanceCuts,cutIndex, photon->GetPhotonPt());
       return kFALSE;
     }
   }
@@ -1104,14 +1286,14 @@ Bool_t AliConversionPhotonCuts::AcceptanceCuts(AliConversionPhotonBase *photon)
     if(photon->GetPhotonEta() > fEtaForPhiCutMin && photon->GetPhotonEta() < fEtaForPhiCutMax ){
       if (fMinPhiCut < fMaxPhiCut){
         if( photon->GetPhotonPhi() > fMinPhiCut && photon->GetPhotonPhi() < fMaxPhiCut ) {
-          if(fHistoAcceptanceCuts)fHistoAcceptanceCuts->Fill(cutIndex, photon->GetPhotonPt());
+          if(fHistoAcceptanceCuts)FillQAHistogram(kQAAcceptanceCuts,cutIndex, photon->GetPhotonPt());
           return kFALSE;
         }
       } else {
         Double_t photonPhi = photon->GetPhotonPhi();
         if (photon->GetPhotonPhi() < TMath::Pi()) photonPhi = photon->GetPhotonPhi() + 2*TMath::Pi();
         if( photonPhi > fMinPhiCut && photonPhi < fMaxPhiCut+2*TMath::Pi() ) {
-          if(fHistoAcceptanceCuts)fHistoAcceptanceCuts->Fill(cutIndex, photon->GetPhotonPt());
+          if(fHistoAcceptanceCuts)FillQAHistogram(kQAAcceptanceCuts,cutIndex, photon->GetPhotonPt());
           return kFALSE;
         }
       }
@@ -1122,12 +1304,12 @@ Bool_t AliConversionPhotonCuts::AcceptanceCuts(AliConversionPhotonBase *photon)
 
   
   if(photon->GetPhotonPt()<fPtCut){
-    if(fHistoAcceptanceCuts)fHistoAcceptanceCuts->Fill(cutIndex, photon->GetPhotonPt());
+    if(fHistoAcceptanceCuts)FillQAHistogram(kQAAcceptanceCuts,cutIndex, photon->GetPhotonPt());
     return kFALSE;
   }
   cutIndex++;
 
-  if(fHistoAcceptanceCuts)fHistoAcceptanceCuts->Fill(cutIndex, photon->GetPhotonPt());
+  if(fHistoAcceptanceCuts)FillQAHistogram(kQAAcceptanceCuts,cutIndex, photon->GetPhotonPt());
 
   return kTRUE;
 }
@@ -1138,7 +1320,7 @@ Bool_t AliConversionPhotonCuts::SpecificTrackCuts(AliAODTrack * negTrack, AliAOD
   // Track Cuts which require AOD/ESD specific implementation
 
   if( !negTrack->IsOn(AliESDtrack::kTPCrefit)  || !posTrack->IsOn(AliESDtrack::kTPCrefit)   )  {
-    if(fHistoTrackCuts)fHistoTrackCuts->Fill(cutIndex);
+    if(fHistoTrackCuts)FillQAHistogram(kQATrackCuts,cutIndex);
     return kFALSE;
   }
   cutIndex++;
@@ -1146,7 +1328,7 @@ Bool_t AliConversionPhotonCuts::SpecificTrackCuts(AliAODTrack * negTrack, AliAOD
   AliAODVertex * NegVtxType=negTrack->GetProdVertex();
   AliAODVertex * PosVtxType=posTrack->GetProdVertex();
   if( (NegVtxType->GetType())==AliAODVertex::kKink || (PosVtxType->GetType())==AliAODVertex::kKink) {
-    if(fHistoTrackCuts)fHistoTrackCuts->Fill(cutIndex);
+    if(fHistoTrackCuts)FillQAHistogram(kQATrackCuts,cutIndex);
     return kFALSE;
   }
   return kTRUE;
@@ -1159,13 +1341,13 @@ Bool_t AliConversionPhotonCuts::SpecificTrackCuts(AliESDtrack * negTrack, AliESD
   // Track Cuts which require AOD/ESD specific implementation
 
   if( !negTrack->IsOn(AliESDtrack::kTPCrefit)  || !posTrack->IsOn(AliESDtrack::kTPCrefit)   )  {
-    if(fHistoTrackCuts)fHistoTrackCuts->Fill(cutIndex);
+    if(fHistoTrackCuts)FillQAHistogram(kQATrackCuts,cutIndex);
     return kFALSE;
   }
   cutIndex++;
 
   if(negTrack->GetKinkIndex(0) > 0  || posTrack->GetKinkIndex(0) > 0 ) {
-    if(fHistoTrackCuts)fHistoTrackCuts->Fill(cutIndex);
+    if(fHistoTrackCuts)FillQAHistogram(kQATrackCuts,cutIndex);
     return kFALSE;
   }
   return kTRUE;
@@ -1178,18 +1360,18 @@ Bool_t AliConversionPhotonCuts::TracksAreSelected(AliVTrack * negTrack, AliVTrac
   // Track Selection for Photon Reconstruction
 
   Int_t cutIndex=0;
-  if(fHistoTrackCuts)fHistoTrackCuts->Fill(cutIndex);
+  if(fHistoTrackCuts)FillQAHistogram(kQATrackCuts,cutIndex);
   cutIndex++;
 
   // avoid like sign
   if(fUseOnFlyV0FinderSameSign==0){
     if(negTrack->Charge() == posTrack->Charge()) {
-      if(fHistoTrackCuts)fHistoTrackCuts->Fill(cutIndex);
+      if(fHistoTrackCuts)FillQAHistogram(kQATrackCuts,cutIndex);
       return kFALSE;
     }
   }else if(fUseOnFlyV0FinderSameSign==1){
     if(negTrack->Charge() != posTrack->Charge()) {
-      if(fHistoTrackCuts)fHistoTrackCuts->Fill(cutIndex);
+      if(fHistoTrackCuts)FillQAHistogram(kQATrackCuts,cutIndex);
       return kFALSE;
     }
   }
@@ -1199,7 +1381,7 @@ Bool_t AliConversionPhotonCuts::TracksAreSelected(AliVTrack * negTrack, AliVTrac
 
 
   if( negTrack->GetNcls(1) < fMinClsTPC || posTrack->GetNcls(1) < fMinClsTPC ) {
-    if(fHistoTrackCuts)fHistoTrackCuts->Fill(cutIndex);
+    if(fHistoTrackCuts)FillQAHistogram(kQATrackCuts,cutIndex);
     return kFALSE;
   }
   cutIndex++;
@@ -1207,13 +1389,13 @@ Bool_t AliConversionPhotonCuts::TracksAreSelected(AliVTrack * negTrack, AliVTrac
   // Acceptance
   if( posTrack->Eta() > (fEtaCut) || posTrack->Eta() < (-fEtaCut) ||
     negTrack->Eta() > (fEtaCut) || negTrack->Eta() < (-fEtaCut) ){
-    if(fHistoTrackCuts)fHistoTrackCuts->Fill(cutIndex);
+    if(fHistoTrackCuts)FillQAHistogram(kQATrackCuts,cutIndex);
     return kFALSE;
   }
   if(fEtaCutMin>-0.1){
     if( (posTrack->Eta() < (fEtaCutMin) && posTrack->Eta() > (-fEtaCutMin)) ||
       (negTrack->Eta() < (fEtaCutMin) && negTrack->Eta() > (-fEtaCutMin)) ){
-      if(fHistoTrackCuts)fHistoTrackCuts->Fill(cutIndex);
+      if(fHistoTrackCuts)FillQAHistogram(kQATrackCuts,cutIndex);
       return kFALSE;
     }
   }
@@ -1222,12 +1404,12 @@ Bool_t AliConversionPhotonCuts::TracksAreSelected(AliVTrack * negTrack, AliVTrac
   // Single Pt Cut
   if(fDoAsymPtCut){
     if((posTrack->Pt()<fSinglePtCut || negTrack->Pt()<fSinglePtCut2) && (posTrack->Pt()<fSinglePtCut2 || negTrack->Pt()<fSinglePtCut) ){
-      if(fHistoTrackCuts)fHistoTrackCuts->Fill(cutIndex);
+      if(fHistoTrackCuts)FillQAHistogram(kQATrackCuts,cutIndex);
       return kFALSE;
     }
   } else {
     if(posTrack->Pt()<fSinglePtCut || negTrack->Pt()<fSinglePtCut){
-      if(fHistoTrackCuts)fHistoTrackCuts->Fill(cutIndex);
+      if(fHistoTrackCuts)FillQAHistogram(kQATrackCuts,cutIndex);
       return kFALSE;
     }
   }
@@ -1243,12 +1425,12 @@ Bool_t AliConversionPhotonCuts::TracksAreSelected(AliVTrack * negTrack, AliVTrac
   }
 
   if(!passCuts){
-    if(fHistoTrackCuts)fHistoTrackCuts->Fill(cutIndex);
+    if(fHistoTrackCuts)FillQAHistogram(kQATrackCuts,cutIndex);
     return kFALSE;
   }
   cutIndex++;
 
-  if(fHistoTrackCuts)fHistoTrackCuts->Fill(cutIndex);
+  if(fHistoTrackCuts)FillQAHistogram(kQATrackCuts,cutIndex);
 
   return kTRUE;
 
@@ -1277,16 +1459,16 @@ Bool_t AliConversionPhotonCuts::dEdxCuts(AliVTrack *fCurrentTrack){
   if(!fPIDResponse){AliError("No PID Response"); return kTRUE;}// if still missing fatal error
 
   Int_t cutIndex=0;
-  if(fHistodEdxCuts)fHistodEdxCuts->Fill(cutIndex,fCurrentTrack->Pt());
-  if(fHistoTPCdEdxSigbefore)fHistoTPCdEdxSigbefore->Fill(fCurrentTrack->P(),fPIDResponse->NumberOfSigmasTPC(fCurrentTrack, AliPID::kElectron));
-  if(fHistoTPCdEdxbefore)fHistoTPCdEdxbefore->Fill(fCurrentTrack->P(),fCurrentTrack->GetTPCsignal());
+  if(fHistodEdxCuts)FillQAHistogram(kQAdEdxCuts,cutIndex,fCurrentTrack->Pt());
+  if(fHistoTPCdEdxSigbefore)FillQAHistogram(kQATPCdEdxSigbefore,fCurrentTrack->P(),fPIDResponse->NumberOfSigmasTPC(fCurrentTrack, AliPID::kElectron));
+  if(fHistoTPCdEdxbefore)FillQAHistogram(kQATPCdEdxbefore,fCurrentTrack->P(),fCurrentTrack->GetTPCsignal());
   cutIndex++;
   if(fDodEdxSigmaCut == kTRUE && !fSwitchToKappa){
     // TPC Electron Line
     if( fPIDResponse->NumberOfSigmasTPC(fCurrentTrack,AliPID::kElectron)<fPIDnSigmaBelowElectronLine ||
       fPIDResponse->NumberOfSigmasTPC(fCurrentTrack,AliPID::kElectron)>fPIDnSigmaAboveElectronLine){
 
-      if(fHistodEdxCuts)fHistodEdxCuts->Fill(cutIndex,fCurrentTrack->Pt());
+      if(fHistodEdxCuts)FillQAHistogram(kQAdEdxCuts,cutIndex,fCurrentTrack->Pt());
       return kFALSE;
     }
     cutIndex++;
@@ -1297,7 +1479,7 @@ Bool_t AliConversionPhotonCuts::dEdxCuts(AliVTrack *fCurrentTrack){
         fPIDResponse->NumberOfSigmasTPC(fCurrentTrack,AliPID::kElectron)<fPIDnSigmaAboveElectronLine&&
         fPIDResponse->NumberOfSigmasTPC(fCurrentTrack,AliPID::kPion)<fPIDnSigmaAbovePionLine){
 
-        if(fHistodEdxCuts)fHistodEdxCuts->Fill(cutIndex,fCurrentTrack->Pt());
+        if(fHistodEdxCuts)FillQAHistogram(kQAdEdxCuts,cutIndex,fCurrentTrack->Pt());
         return kFALSE;
       }
     }
@@ -1309,7 +1491,7 @@ Bool_t AliConversionPhotonCuts::dEdxCuts(AliVTrack *fCurrentTrack){
         fPIDResponse->NumberOfSigmasTPC(fCurrentTrack,AliPID::kElectron)<fPIDnSigmaAboveElectronLine &&
         fPIDResponse->NumberOfSigmasTPC(fCurrentTrack,AliPID::kPion)<fPIDnSigmaAbovePionLineHighPt){
 
-        if(fHistodEdxCuts)fHistodEdxCuts->Fill(cutIndex,fCurrentTrack->Pt());
+        if(fHistodEdxCuts)FillQAHistogram(kQAdEdxCuts,cutIndex,fCurrentTrack->Pt());
         return kFALSE;
       }
     }
@@ -1321,7 +1503,7 @@ Bool_t AliConversionPhotonCuts::dEdxCuts(AliVTrack *fCurrentTrack){
     if(fCurrentTrack->P()<fPIDMinPKaonRejectionLowP ){
       if( TMath::Abs(fPIDResponse->NumberOfSigmasTPC(fCurrentTrack,AliPID::kKaon))<fPIDnSigmaAtLowPAroundKaonLine){
 
-        if(fHistodEdxCuts)fHistodEdxCuts->Fill(cutIndex,fCurrentTrack->Pt());
+        if(fHistodEdxCuts)FillQAHistogram(kQAdEdxCuts,cutIndex,fCurrentTrack->Pt());
         return kFALSE;
       }
     }
@@ -1331,7 +1513,7 @@ Bool_t AliConversionPhotonCuts::dEdxCuts(AliVTrack *fCurrentTrack){
     if( fCurrentTrack->P()<fPIDMinPProtonRejectionLowP ){
       if( TMath::Abs(fPIDResponse->NumberOfSigmasTPC(fCurrentTrack,AliPID::kProton))<fPIDnSigmaAtLowPAroundProtonLine){
 
-        if(fHistodEdxCuts)fHistodEdxCuts->Fill(cutIndex,fCurrentTrack->Pt());
+        if(fHistodEdxCuts)FillQAHistogram(kQAdEdxCuts,cutIndex,fCurrentTrack->Pt());
         return kFALSE;
       }
     }
@@ -1342,7 +1524,7 @@ Bool_t AliConversionPhotonCuts::dEdxCuts(AliVTrack *fCurrentTrack){
     if( fCurrentTrack->P()<fPIDMinPPionRejectionLowP ){
       if( TMath::Abs(fPIDResponse->NumberOfSigmasTPC(fCurrentTrack,AliPID::kPion))<fPIDnSigmaAtLowPAroundPionLine){
 
-        if(fHistodEdxCuts)fHistodEdxCuts->Fill(cutIndex,fCurrentTrack->Pt());
+        if(fHistodEdxCuts)FillQAHistogram(kQAdEdxCuts,cutIndex,fCurrentTrack->Pt());
         return kFALSE;
       }
     }
@@ -1370,31 +1552,31 @@ Bool_t AliConversionPhotonCuts::dEdxCuts(AliVTrack *fCurrentTrack){
       fCurrentTrack->GetIntegratedTimes(times,AliPID::kSPECIESC);
       Double_t TOFsignal = fCurrentTrack->GetTOFsignal();
       Double_t dT = TOFsignal - t0 - times[0];
-      fHistoTOFbefore->Fill(fCurrentTrack->P(),dT);
+      FillQAHistogram(kQATOFbefore,fCurrentTrack->P(),dT);
     }
-    if(fHistoTOFSigbefore) fHistoTOFSigbefore->Fill(fCurrentTrack->P(),fPIDResponse->NumberOfSigmasTOF(fCurrentTrack, AliPID::kElectron));
+    if(fHistoTOFSigbefore) FillQAHistogram(kQATOFSigbefore,fCurrentTrack->P(),fPIDResponse->NumberOfSigmasTOF(fCurrentTrack, AliPID::kElectron));
     if(fUseTOFpid){
       if(fPIDResponse->NumberOfSigmasTOF(fCurrentTrack, AliPID::kElectron)>fTofPIDnSigmaAboveElectronLine ||
         fPIDResponse->NumberOfSigmasTOF(fCurrentTrack, AliPID::kElectron)<fTofPIDnSigmaBelowElectronLine ){
-        if(fHistodEdxCuts)fHistodEdxCuts->Fill(cutIndex,fCurrentTrack->Pt());
+        if(fHistodEdxCuts)FillQAHistogram(kQAdEdxCuts,cutIndex,fCurrentTrack->Pt());
         return kFALSE;
       }
     }
-    if(fHistoTOFSigafter)fHistoTOFSigafter->Fill(fCurrentTrack->P(),fPIDResponse->NumberOfSigmasTOF(fCurrentTrack, AliPID::kElectron));
+    if(fHistoTOFSigafter)FillQAHistogram(kQATOFSigafter,fCurrentTrack->P(),fPIDResponse->NumberOfSigmasTOF(fCurrentTrack, AliPID::kElectron));
   }
   cutIndex++;
   
   if((fCurrentTrack->GetStatus() & AliESDtrack::kITSpid)){
-    if(fHistoITSSigbefore) fHistoITSSigbefore->Fill(fCurrentTrack->P(),fPIDResponse->NumberOfSigmasITS(fCurrentTrack, AliPID::kElectron));
+    if(fHistoITSSigbefore) FillQAHistogram(kQAITSSigbefore,fCurrentTrack->P(),fPIDResponse->NumberOfSigmasITS(fCurrentTrack, AliPID::kElectron));
     if(fUseITSpid){
       if(fCurrentTrack->Pt()<=fMaxPtPIDITS){
         if(fPIDResponse->NumberOfSigmasITS(fCurrentTrack, AliPID::kElectron)>fITSPIDnSigmaAboveElectronLine || fPIDResponse->NumberOfSigmasITS(fCurrentTrack, AliPID::kElectron)<fITSPIDnSigmaBelowElectronLine ){
-          if(fHistodEdxCuts)fHistodEdxCuts->Fill(cutIndex,fCurrentTrack->Pt());
+          if(fHistodEdxCuts)FillQAHistogram(kQAdEdxCuts,cutIndex,fCurrentTrack->Pt());
           return kFALSE;
         }
       }
     }
-    if(fHistoITSSigafter)fHistoITSSigafter->Fill(fCurrentTrack->P(),fPIDResponse->NumberOfSigmasITS(fCurrentTrack, AliPID::kElectron));
+    if(fHistoITSSigafter)FillQAHistogram(kQAITSSigafter,fCurrentTrack->P(),fPIDResponse->NumberOfSigmasITS(fCurrentTrack, AliPID::kElectron));
   }
   
   cutIndex++;
@@ -1402,15 +1584,15 @@ Bool_t AliConversionPhotonCuts::dEdxCuts(AliVTrack *fCurrentTrack){
   // Apply TRD PID
   if(fDoTRDPID){
     if(!fPIDResponse->IdentifiedAsElectronTRD(fCurrentTrack,fPIDTRDEfficiency)){
-      if(fHistodEdxCuts)fHistodEdxCuts->Fill(cutIndex,fCurrentTrack->Pt());
+      if(fHistodEdxCuts)FillQAHistogram(kQAdEdxCuts,cutIndex,fCurrentTrack->Pt());
       return kFALSE;
     }
   }
   cutIndex++;
 
-  if(fHistodEdxCuts)fHistodEdxCuts->Fill(cutIndex,fCurrentTrack->Pt());
-  if(fHistoTPCdEdxSigafter)fHistoTPCdEdxSigafter->Fill(fCurrentTrack->P(),fPIDResponse->NumberOfSigmasTPC(fCurrentTrack, AliPID::kElectron));
-  if(fHistoTPCdEdxafter)fHistoTPCdEdxafter->Fill(fCurrentTrack->P(),fCurrentTrack->GetTPCsignal());
+  if(fHistodEdxCuts)FillQAHistogram(kQAdEdxCuts,cutIndex,fCurrentTrack->Pt());
+  if(fHistoTPCdEdxSigafter)FillQAHistogram(kQATPCdEdxSigafter,fCurrentTrack->P(),fPIDResponse->NumberOfSigmasTPC(fCurrentTrack, AliPID::kElectron));
+  if(fHistoTPCdEdxafter)FillQAHistogram(kQATPCdEdxafter,fCurrentTrack->P(),fCurrentTrack->GetTPCsignal());
   
   return kTRUE;
 }
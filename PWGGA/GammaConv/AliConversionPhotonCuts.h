@@ -15,6 +15,7 @@
 #include "TProfile.h"
 #include "AliAnalysisUtils.h"
 #include "AliAnalysisManager.h"
+#include <vector>
 
 
 class AliESDEvent;
@@ -119,6 +120,42 @@ class AliConversionPhotonCuts : public AliAnalysisCuts {
         kPhotonOut
     };
 
+    enum photonSelectionStages {
+        kStageV0Finder=0,
+        kStageTracks,
+        kStageV0InAOD,
+        kStageTrackCuts,
+        kStagedEdxCuts,
+        kStagePhotonCuts,
+        kNSelectionStages
+    };
+
+    enum photonQAHistograms {
+        kQAEtaDistV0s=0,
+        kQAEtaDistV0sAfterdEdxCuts,
+        kQATrackCuts,
+        kQAdEdxCuts,
+        kQATPCdEdxbefore,
+        kQATPCdEdxafter,
+        kQATPCdEdxSigbefore,
+        kQATPCdEdxSigafter,
+        kQATOFbefore,
+        kQATOFSigbefore,
+        kQATOFSigafter,
+        kQAITSSigbefore,
+        kQAITSSigafter,
+        kQAPhotonCuts,
+        kQAInvMassbefore,
+        kQAInvMassafter,
+        kQAArmenterosbefore,
+        kQAArmenterosafter,
+        kQAPsiPairDeltaPhiafter,
+        kQAKappaafter,
+        kQAAsymmetryafter,
+        kQAAcceptanceCuts,
+        kNQAHistograms
+    };
+
 
     Bool_t SetCutIds(TString cutString);
     Int_t fCuts[kNCuts];
@@ -126,6 +163,7 @@ class AliConversionPhotonCuts : public AliAnalysisCuts {
     Bool_t UpdateCutString();
 
     static const char * fgkCutNames[kNCuts];
+    static const Int_t fgkStageCutIndex[kNSelectionStages];
 
     Double_t GetCosineOfPointingAngle(const AliConversionPhotonBase * photon, AliVEvent * event) const; 
     Bool_t InitializeCutsFromCutString(const TString analysisCutSelection);
@@ -155,6 +193,8 @@ class AliConversionPhotonCuts : public AliAnalysisCuts {
     
     // Cut Selection
     Bool_t PhotonIsSelected(AliConversionPhotonBase * photon, AliVEvent  * event);
+    Bool_t PhotonPassesStage(Int_t stage, AliConversionPhotonBase * photon, AliVEvent * event, AliVTrack *&negTrack, AliVTrack *&posTrack);
+    TString GetStageKey(Int_t stage) const;
     Bool_t PhotonIsSelectedMC(TParticle *particle,AliMCEvent *mcEvent,Bool_t checkForConvertedGamma=kTRUE);
     Bool_t PhotonIsSelectedAODMC(AliAODMCParticle *particle,TClonesArray *aodmcArray,Bool_t checkForConvertedGamma=kTRUE);
     //Bool_t ElectronIsSelectedMC(TParticle *particle,AliMCEvent *mcEvent);
@@ -172,6 +212,12 @@ class AliConversionPhotonCuts : public AliAnalysisCuts {
     void FillPhotonCutIndex(Int_t photoncut){if(fHistoCutIndex)fHistoCutIndex->Fill(photoncut);}    
     void FillV0EtaBeforedEdxCuts(Float_t v0Eta){if(fHistoEtaDistV0s)fHistoEtaDistV0s->Fill(v0Eta);}
     void FillV0EtaAfterdEdxCuts(Float_t v0Eta){if(fHistoEtaDistV0sAfterdEdxCuts)fHistoEtaDistV0sAfterdEdxCuts->Fill(v0Eta);}
+    TH1* GetQAHistogram(Int_t slot) const;
+    UInt_t GetQAHistogramMask() const;
+    void FillQAHistogram(Int_t slot, Double_t x, Double_t y=1.);
+    void SetQAFillRecord(std::vector<Double_t> *record){fQAFillRecord = record;}
+    void ReplayQAFills(const std::vector<Double_t> &record);
+    Bool_t PhotonPassesSelection(AliConversionPhotonBase *photon, AliVEvent *event);
 
     void SetV0ReaderName(TString name){fV0ReaderName = name; return;}
     void SetProcessAODCheck(Bool_t flag){fProcessAODCheck = flag; return;}
@@ -382,10 +428,12 @@ class AliConversionPhotonCuts : public AliAnalysisCuts {
     Bool_t            fPreSelCut;                           ///< Flag for preselection cut used in V0Reader
     Bool_t            fProcessAODCheck;                     ///< Flag for processing check for AOD to be contained in AliAODs.root and AliAODGammaConversion.root
     TProfile*         fProfileContainingMaterialBudgetWeights;      
+    std::vector<Double_t>* fQAFillRecord;                   //!<! record of the QA histogram fills (slot, x, y), not owned
+    Bool_t            fQAFillsDisabled;                     //!<! no QA histogram fills, set during PhotonPassesSelection
 
   private:
     /// \cond CLASSIMP
-    ClassDef(AliConversionPhotonCuts,15)
+    ClassDef(AliConversionPhotonCuts,17)
     /// \endcond
 };
 
@@ -45,7 +45,10 @@ AliGammaConversionAODBGHandler::AliGammaConversionAODBGHandler() :
 	fBinLimitsArrayMultiplicity(NULL),
 	fBGEvents(),
 	fBGEventsENeg(),
-	fBGEventsMeson()
+	fBGEventsMeson(),
+	fBGEventsPool(),
+	fBGEventsENegPool(),
+	fBGEventsMesonPool()
 {
 	// constructor
 }
@@ -66,7 +69,10 @@ AliGammaConversionAODBGHandler::AliGammaConversionAODBGHandler(Int_t binsZ,Int_t
 	fBinLimitsArrayMultiplicity(NULL),
 	fBGEvents(binsZ,AliGammaConversionMultipicityVector(binsMultiplicity,AliGammaConversionBGEventVector(nEvents))),
 	fBGEventsENeg(binsZ,AliGammaConversionMultipicityVector(binsMultiplicity,AliGammaConversionBGEventVector(nEvents))),
-	fBGEventsMeson(binsZ,AliGammaConversionMotherMultipicityVector(binsMultiplicity,AliGammaConversionMotherBGEventVector(nEvents)))
+	fBGEventsMeson(binsZ,AliGammaConversionMotherMultipicityVector(binsMultiplicity,AliGammaConversionMotherBGEventVector(nEvents))),
+	fBGEventsPool(),
+	fBGEventsENegPool(),
+	fBGEventsMesonPool()
 {
 	// constructor
 }
@@ -89,7 +95,10 @@ AliGammaConversionAODBGHandler::AliGammaConversionAODBGHandler(Int_t collisionSy
 	fBinLimitsArrayMultiplicity(NULL),
 	fBGEvents(binsZ,AliGammaConversionMultipicityVector(binsMultiplicity,AliGammaConversionBGEventVector(nEvents))),
 	fBGEventsENeg(binsZ,AliGammaConversionMultipicityVector(binsMultiplicity,AliGammaConversionBGEventVector(nEvents))),
-	fBGEventsMeson(binsZ,AliGammaConversionMotherMultipicityVector(binsMultiplicity,AliGammaConversionMotherBGEventVector(nEvents)))
+	fBGEventsMeson(binsZ,AliGammaConversionMotherMultipicityVector(binsMultiplicity,AliGammaConversionMotherBGEventVector(nEvents))),
+	fBGEventsPool(),
+	fBGEventsENegPool(),
+	fBGEventsMesonPool()
 {
 	// constructor
     if(fNBinsZ>8) fNBinsZ = 8;
@@ -361,9 +370,12 @@ AliGammaConversionAODBGHandler::AliGammaConversionAODBGHandler(const AliGammaCon
 	fBinLimitsArrayMultiplicity(original.fBinLimitsArrayMultiplicity),
 	fBGEvents(original.fBGEvents),
 	fBGEventsENeg(original.fBGEventsENeg),
-	fBGEventsMeson(original.fBGEventsMeson)
+	fBGEventsMeson(original.fBGEventsMeson),
+	fBGEventsPool(),
+	fBGEventsENegPool(),
+	fBGEventsMesonPool()
 {
-	//copy constructor	
+	//copy constructor, the buffered events stay owned by the original
 }
 
 //_____________________________________________________________________________________________________________________________
@@ -425,6 +437,32 @@ AliGammaConversionAODBGHandler::~AliGammaConversionAODBGHandler(){
 	if(fBinLimitsArrayMultiplicity){
 		delete[] fBinLimitsArrayMultiplicity;
 	}
+
+	DeleteBufferPools(fBGEventsPool);
+	DeleteBufferPools(fBGEventsENegPool);
+	DeleteBufferPools(fBGEventsMesonPool);
+}
+
+//_____________________________________________________________________________________________________________________________
+TClonesArray* AliGammaConversionAODBGHandler::GetBufferPool(std::vector<TClonesArray*> &pools, const char *className, Int_t z, Int_t m, Int_t event){
+	// Storage of the objects of one buffered event. When the event is overwritten the objects are
+	// destructed and the new ones are constructed in place, so that filling the buffer does not
+	// allocate once the ring buffer of each bin has been filled.
+	if(pools.empty()) pools.assign(fNBinsZ*fNBinsMultiplicity*fNEvents, NULL);
+	TClonesArray *&pool = pools[(z*fNBinsMultiplicity+m)*fNEvents+event];
+	if(!pool) pool = new TClonesArray(className);
+	return pool;
+}
+
+//_____________________________________________________________________________________________________________________________
+void AliGammaConversionAODBGHandler::DeleteBufferPools(std::vector<TClonesArray*> &pools){
+	for(UInt_t i=0;i<pools.size();i++){
+		if(pools[i]){
+			pools[i]->Delete();
+			delete pools[i];
+		}
+	}
+	pools.clear();
 }
 
 //_____________________________________________________________________________________________________________________________
@@ -593,15 +631,14 @@ void AliGammaConversionAODBGHandler::AddEvent(TList* const eventGammas,Double_t
 	//  cout<<"Checking the entries: Z="<<z<<", M="<<m<<", eventCounter="<<eventCounter<<endl;
 
 	//  cout<<"The size of this vector is: "<<fBGEvents[z][m][eventCounter].size()<<endl;
-    for(Int_t d=0;d<fBGEvents[z][m][eventCounter].size();d++){
-		delete (AliAODConversionPhoton*)(fBGEvents[z][m][eventCounter][d]);
-	}
+	TClonesArray *pool = GetBufferPool(fBGEventsPool,"AliAODConversionPhoton",z,m,eventCounter);
+	pool->Delete();
 	fBGEvents[z][m][eventCounter].clear();
 	
 	// add the gammas to the vector
 	for(Int_t i=0; i< eventGammas->GetEntries();i++){
 		//    AliKFParticle *t = new AliKFParticle(*(AliKFParticle*)(eventGammas->At(i)));
-		fBGEvents[z][m][eventCounter].push_back(new AliAODConversionPhoton(*(AliAODConversionPhoton*)(eventGammas->At(i))));
+		fBGEvents[z][m][eventCounter].push_back(new((*pool)[i]) AliAODConversionPhoton(*(AliAODConversionPhoton*)(eventGammas->At(i))));
 	}
 	fBGEventCounter[z][m]++;
 }
@@ -628,14 +665,13 @@ void AliGammaConversionAODBGHandler::AddMesonEvent(TList* const eventMothers, Do
 	fBGEventVertex[z][m][eventCounter].fEP = epvalue;
 
 	//first clear the vector
-  for(Int_t d=0;d<fBGEventsMeson[z][m][eventCounter].size();d++){
-		delete (AliAODConversionMother*)(fBGEventsMeson[z][m][eventCounter][d]);
-	}
+	TClonesArray *pool = GetBufferPool(fBGEventsMesonPool,"AliAODConversionMother",z,m,eventCounter);
+	pool->Delete();
 	fBGEventsMeson[z][m][eventCounter].clear();
 	
 	// add the gammas to the vector
 	for(Int_t i=0; i< eventMothers->GetEntries();i++){
-		fBGEventsMeson[z][m][eventCounter].push_back(new AliAODConversionMother(*(AliAODConversionMother*)(eventMothers->At(i))));
+		fBGEventsMeson[z][m][eventCounter].push_back(new((*pool)[i]) AliAODConversionMother(*(AliAODConversionMother*)(eventMothers->At(i))));
 	}
 	fBGEventMesonCounter[z][m]++;
 }
@@ -658,14 +694,14 @@ void AliGammaConversionAODBGHandler::AddMesonEvent(const std::vector<AliAODConve
   fBGEventVertex[z][m][eventCounter].fEP = epvalue;
 
   //first clear the vector
-  for(Int_t d=0;d<fBGEvents[z][m][eventCounter].size();d++){
-    delete (AliAODConversionMother*)(fBGEventsMeson[z][m][eventCounter][d]);
-  }
+  TClonesArray *pool = GetBufferPool(fBGEventsMesonPool,"AliAODConversionMother",z,m,eventCounter);
+  pool->Delete();
   fBGEventsMeson[z][m][eventCounter].clear();
 
   // add the gammas to the vector
+  Int_t i = 0;
   for(const auto &mother : eventMother){
-    fBGEventsMeson[z][m][eventCounter].push_back(new AliAODConversionMother(mother));
+    fBGEventsMeson[z][m][eventCounter].push_back(new((*pool)[i++]) AliAODConversionMother(mother));
   }
   fBGEventMesonCounter[z][m]++;
 }
@@ -686,16 +722,14 @@ void AliGammaConversionAODBGHandler::AddElectronEvent(TClonesArray* const eventE
 	//  cout<<"Checking the entries: Z="<<z<<", M="<<m<<", eventCounter="<<eventCounter<<endl;
 
 	//  cout<<"The size of this vector is: "<<fBGEvents[z][m][eventCounter].size()<<endl;
-    for(Int_t d=0;d<fBGEventsENeg[z][m][eventENegCounter].size();d++){
-		delete (AliAODConversionPhoton*)(fBGEventsENeg[z][m][eventENegCounter][d]);
-	}
-
+	TClonesArray *pool = GetBufferPool(fBGEventsENegPool,"AliAODConversionPhoton",z,m,eventENegCounter);
+	pool->Delete();
 	fBGEventsENeg[z][m][eventENegCounter].clear();
 
 	// add the electron to the vector
 	for(Int_t i=0; i< eventENeg->GetEntriesFast();i++){
 		//    AliKFParticle *t = new AliKFParticle(*(AliKFParticle*)(eventGammas->At(i)));
-		fBGEventsENeg[z][m][eventENegCounter].push_back(new AliAODConversionPhoton(*(AliAODConversionPhoton*)(eventENeg->At(i))));
+		fBGEventsENeg[z][m][eventENegCounter].push_back(new((*pool)[i]) AliAODConversionPhoton(*(AliAODConversionPhoton*)(eventENeg->At(i))));
 	}
 	fBGEventENegCounter[z][m]++;
 }
@@ -84,6 +84,9 @@ class AliGammaConversionAODBGHandler : public TObject {
 
 	private:
 
+		TClonesArray* GetBufferPool(std::vector<TClonesArray*> &pools, const char *className, Int_t z, Int_t m, Int_t event);
+		void DeleteBufferPools(std::vector<TClonesArray*> &pools);
+
 		Int_t 								fNEvents; 						// number of events
 		Int_t ** 							fBGEventCounter;				//! bg counter
 		Int_t ** 							fBGEventENegCounter;			//! bg electron counter
@@ -98,6 +101,9 @@ class AliGammaConversionAODBGHandler : public TObject {
 		AliGammaConversionBGVector 			fBGEvents; 						// photon background events
 		AliGammaConversionBGVector 			fBGEventsENeg; 					// electron background electron events
 		AliGammaConversionMotherBGVector 	fBGEventsMeson; 				// neutral meson background events
+		std::vector<TClonesArray*>			fBGEventsPool;					//! storage of the photon background events, reused when an event is overwritten
+		std::vector<TClonesArray*>			fBGEventsENegPool;				//! storage of the electron background events
+		std::vector<TClonesArray*>			fBGEventsMesonPool;				//! storage of the neutral meson background events
 		
 	ClassDef(AliGammaConversionAODBGHandler,6)
 };
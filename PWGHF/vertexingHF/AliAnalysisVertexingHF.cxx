@@ -70,6 +70,27 @@
 #include "AliCodeTimer.h"
 #include "AliMultSelection.h"
 #include <cstring>
+#include <vector>
+#include <RVersion.h>
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,6,0)
+#include <mutex>
+#include <thread>
+#include <TROOT.h>
+#endif
+
+namespace {
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,6,0)
+  /// Serializes the calls of the parallel candidate loops which reach objects
+  /// shared by all the threads: the candidate selection of the cuts objects
+  /// (their AliAODPidHF points to the PID response of the input handler, and
+  /// they read the event) and the TRefs to the AOD tracks of the event
+  std::mutex gSharedObjectsMutex;
+  typedef std::lock_guard<std::mutex> SharedObjectsLock;
+#else
+  const Int_t gSharedObjectsMutex = 0;
+  struct SharedObjectsLock { SharedObjectsLock(Int_t) {} };
+#endif
+}
 
 /// \cond CLASSIMP
 ClassImp(AliAnalysisVertexingHF);
@@ -157,10 +178,18 @@ fMassDplus(0.),
 fMassDs(0.),
 fMassLambdaC(0.),
 fMassDstar(0.),
-fMassJpsi(0.)
+fMassJpsi(0.),
+fNThreads(1),
+fWorkers(0),
+fUsePairPreselection(kFALSE),
+fTrkPreselSize(0),
+fTrkPreselNTrks(0),
+fTrkPresel(0)
 {
   /// Default constructor
 
+  for(Int_t i=0; i<kNCombStages; i++) fnCombinations[i]=0;
+
   Double_t d02[2]={0.,0.};
   Double_t d03[3]={0.,0.,0.};
   Double_t d04[4]={0.,0.,0.,0.};
@@ -252,11 +281,18 @@ fMassDplus(source.fMassDplus),
 fMassDs(source.fMassDs),
 fMassLambdaC(source.fMassLambdaC),
 fMassDstar(source.fMassDstar),
-fMassJpsi(source.fMassJpsi)
+fMassJpsi(source.fMassJpsi),
+fNThreads(source.fNThreads),
+fWorkers(0),
+fUsePairPreselection(source.fUsePairPreselection),
+fTrkPreselSize(0),
+fTrkPreselNTrks(0),
+fTrkPresel(0)
 {
   ///
   /// Copy constructor
   ///
+  for(Int_t i=0; i<kNCombStages; i++) fnCombinations[i]=0;
 }
 //--------------------------------------------------------------------------
 AliAnalysisVertexingHF &AliAnalysisVertexingHF::operator=(const AliAnalysisVertexingHF &source)
@@ -344,6 +380,8 @@ AliAnalysisVertexingHF &AliAnalysisVertexingHF::operator=(const AliAnalysisVerte
   fMassLambdaC = source.fMassLambdaC;
   fMassDstar = source.fMassDstar;
   fMassJpsi = source.fMassJpsi;
+  fNThreads = source.fNThreads;
+  fUsePairPreselection = source.fUsePairPreselection;
 
   return *this;
 }
@@ -371,6 +409,8 @@ AliAnalysisVertexingHF::~AliAnalysisVertexingHF() {
   if(fMassCalc2) { delete fMassCalc2; fMassCalc2=0; }
   if(fMassCalc3) { delete fMassCalc3; fMassCalc3=0; }
   if(fMassCalc4) { delete fMassCalc4; fMassCalc4=0; }
+  if(fWorkers) { delete fWorkers; fWorkers=0; }
+  if(fTrkPresel) { delete [] fTrkPresel; fTrkPresel=0; }
 }
 //----------------------------------------------------------------------------
 TList *AliAnalysisVertexingHF::FillListOfCuts() {
@@ -548,17 +588,14 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
   AliAODRecoDecayHF4Prong *io4Prong  = 0;
   AliAODRecoCascadeHF     *ioCascade = 0;
 
-  Int_t    iTrkP1,iTrkP2,iTrkN1,iTrkN2,iTrkSoftPi,trkEntries,iv0,nv0;
-  Double_t xdummy,ydummy,dcap1n1,dcap1n2,dcap2n1,dcap1p2,dcan1n2,dcap2n2,dcaV0,dcaCasc;
-  Bool_t   okD0=kFALSE,okJPSI=kFALSE,ok3Prong=kFALSE,ok4Prong=kFALSE;
+  Int_t    iTrkP1,iTrkN1,iTrkSoftPi,trkEntries,iv0,nv0;
+  Double_t xdummy,ydummy,dcaV0,dcaCasc;
+  Bool_t   okD0=kFALSE,okJPSI=kFALSE;
   Bool_t   okDstar=kFALSE,okD0fromDstar=kFALSE;
   Bool_t   okCascades=kFALSE;
   AliESDtrack *postrack1 = 0;
-  AliESDtrack *postrack2 = 0;
   AliESDtrack *negtrack1 = 0;
-  AliESDtrack *negtrack2 = 0;
   AliESDtrack *trackPi   = 0;
-  Double_t mompos1[3],mompos2[3],momneg1[3],momneg2[3];
   //   AliESDtrack *posV0track = 0;
   //   AliESDtrack *negV0track = 0;
   Float_t dcaMax = fCutsD0toKpi->GetDCACut();
@@ -594,16 +631,7 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
   }
 
   // event selection + PID configuration
-  if(!fCutsD0toKpi->IsEventSelected(event)) return;
-  if(fCutsJpsitoee) fCutsJpsitoee->SetupPID(event);
-  if(fCutsDplustoK0spi) fCutsDplustoK0spi->SetupPID(event);
-  if(fCutsDplustoKpipi) fCutsDplustoKpipi->SetupPID(event);
-  if(fCutsDstoK0sK) fCutsDstoK0sK->SetupPID(event);
-  if(fCutsDstoKKpi) fCutsDstoKKpi->SetupPID(event);
-  if(fCutsLctopKpi) fCutsLctopKpi->SetupPID(event);
-  if(fCutsLctoV0) fCutsLctoV0->SetupPID(event);
-  if(fCutsD0toKpipipi) fCutsD0toKpipipi->SetupPID(event);
-  if(fCutsDStartoKpipi) fCutsDStartoKpipi->SetupPID(event);
+  if(!SetupCutsForEvent(event)) return;
 
   // call function that applies sigle-track selection,
   // for displaced tracks and soft pions (both charges) for D*,
@@ -618,33 +646,43 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
   AliDebug(1,Form(" Selected tracks: %d",nSeleTrks));
   fnSeleTrksTotal += nSeleTrks;
 
+  // cheap pre-selection of pairs and triplets, before any DCA or vertex fit
+  fTrkPreselNTrks=0;
+  Double_t minPtPair=0.,minPt3Prong=0.;
+  if(fUsePairPreselection && nSeleTrks>1) {
+    FillPreselectionInfo(&tracksAtVertex,nSeleTrks);
+    GetPreselectionMinPt(minPtPair,minPt3Prong);
+  }
+
+
+  // 2-, 3- and 4-prong candidates of all the positive tracks, found in
+  // parallel if enabled; they are stored per positive track in the loop below
+  std::vector< std::vector<CandidateRecord> > candsPerTrk;
+  Bool_t parallelLoops = FindCandidatesParallel(event,seleTrksArray,tracksAtVertex,nSeleTrks,seleFlags,evtNumber,
+						 dcaMax,minPtPair,minPt3Prong,candsPerTrk);
+  std::vector<CandidateRecord> serialCands;
 
-  TObjArray *twoTrackArray1    = new TObjArray(2);
-  TObjArray *twoTrackArray2    = new TObjArray(2);
   TObjArray *twoTrackArrayV0   = new TObjArray(2);
   TObjArray *twoTrackArrayCasc = new TObjArray(2);
-  TObjArray *threeTrackArray   = new TObjArray(3);
-  TObjArray *fourTrackArray    = new TObjArray(4);
+  TObjArray *candTrackArray    = new TObjArray(4);
 
   Double_t dispersion;
-  Bool_t isLikeSign2Prong=kFALSE,isLikeSign3Prong=kFALSE;
+  Bool_t isLikeSign2Prong=kFALSE;
 
   AliAODRecoDecayHF   *rd = 0;
   AliAODRecoCascadeHF *rc = 0;
   AliAODv0            *v0 = 0;
   AliESDv0         *esdV0 = 0;
 
-  Bool_t massCutOK=kTRUE;
-
   // LOOP ON  POSITIVE  TRACKS
   for(iTrkP1=0; iTrkP1<nSeleTrks; iTrkP1++) {
 
     //if(iTrkP1%1==0) AliDebug(1,Form("  1st loop on pos: track number %d of %d",iTrkP1,nSeleTrks));
     //if(iTrkP1%1==0) printf("  1st loop on pos: track number %d of %d\n",iTrkP1,nSeleTrks);
 
-    // get track from tracks array
+    // get track from tracks array, at the primary vertex
     postrack1 = (AliESDtrack*)seleTrksArray.UncheckedAt(iTrkP1);
-    postrack1->GetPxPyPz(mompos1);
+    SetParametersAtVertex(postrack1,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkP1));
 
     // Make cascades with V0+track
     //
@@ -827,62 +865,27 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
     if(!TESTBIT(seleFlags[iTrkP1],kBitDispl)) continue;
     if(postrack1->Charge()<0 && !fLikeSign) continue;
 
-    // LOOP ON  NEGATIVE  TRACKS
-    for(iTrkN1=0; iTrkN1<nSeleTrks; iTrkN1++) {
-
-      //if(iTrkN1%1==0) AliDebug(1,Form("    1st loop on neg: track number %d of %d",iTrkN1,nSeleTrks));
-      //if(iTrkN1%1==0) printf("    1st loop on neg: track number %d of %d\n",iTrkN1,nSeleTrks);
-
-      if(iTrkN1==iTrkP1) continue;
-
-      // get track from tracks array
-      negtrack1 = (AliESDtrack*)seleTrksArray.UncheckedAt(iTrkN1);
-
-      if(negtrack1->Charge()>0 && !fLikeSign) continue;
-
-      if(!TESTBIT(seleFlags[iTrkN1],kBitDispl)) continue;
-
-      if(fMixEvent) {
-	if(evtNumber[iTrkP1]==evtNumber[iTrkN1]) continue;
-      }
-
-      if(postrack1->Charge()==negtrack1->Charge()) { // like-sign
-	isLikeSign2Prong=kTRUE;
-	if(!fLikeSign)    continue;
-	if(iTrkN1<iTrkP1) continue; // this is needed to avoid double-counting of like-sign
-      } else { // unlike-sign
-	isLikeSign2Prong=kFALSE;
-	if(postrack1->Charge()<0 || negtrack1->Charge()>0) continue;  // this is needed to avoid double-counting of unlike-sign
-	if(fMixEvent) {
-	  if(evtNumber[iTrkP1]==evtNumber[iTrkN1]) continue;
-	}
-
-      }
-
-      // back to primary vertex
-      //      postrack1->PropagateToDCA(fV1,fBzkG,kVeryBig);
-      //      negtrack1->PropagateToDCA(fV1,fBzkG,kVeryBig);
-      SetParametersAtVertex(postrack1,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkP1));
-      SetParametersAtVertex(negtrack1,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkN1));
-      negtrack1->GetPxPyPz(momneg1);
-
-      // DCA between the two tracks
-      dcap1n1 = postrack1->GetDCA(negtrack1,fBzkG,xdummy,ydummy);
-      if(dcap1n1>dcaMax) { negtrack1=0; continue; }
+    // 2-, 3- and 4-prong candidates with this track as first prong
+    std::vector<CandidateRecord> &cands = (parallelLoops ? candsPerTrk[iTrkP1] : serialCands);
+    if(!parallelLoops) {
+      serialCands.clear();
+      FindCandidatesForTrack(iTrkP1,event,seleTrksArray,tracksAtVertex,nSeleTrks,seleFlags,evtNumber,
+			     dcaMax,minPtPair,minPt3Prong,serialCands);
+    }
 
-      // Vertexing
-      twoTrackArray1->AddAt(postrack1,0);
-      twoTrackArray1->AddAt(negtrack1,1);
-      AliAODVertex *vertexp1n1 = ReconstructSecondaryVertex(twoTrackArray1,dispersion);
-      if(!vertexp1n1) {
-	twoTrackArray1->Clear();
-	negtrack1=0;
-	continue;
-      }
-      // 2 prong candidate
-      if(fD0toKpi || fJPSItoEle || fDstar || fLikeSign) {
+    // add them to the AOD
+    for(UInt_t iCand=0; iCand<cands.size(); iCand++) {
+      CandidateRecord &cand = cands[iCand];
+      candTrackArray->Clear();
+      for(Int_t ip=0; ip<cand.fNProngs; ip++) candTrackArray->AddAt(seleTrksArray.UncheckedAt(cand.fTrk[ip]),ip);
 
-	io2Prong = Make2Prong(twoTrackArray1,event,vertexp1n1,dcap1n1,okD0,okJPSI,okD0fromDstar);
+      if(cand.fNProngs==2) {
+	io2Prong = (AliAODRecoDecayHF2Prong*)cand.fRecoDecay;
+	AliAODVertex *vertexp1n1 = cand.fVertex;
+	iTrkN1 = cand.fTrk[1];
+	negtrack1 = (AliESDtrack*)seleTrksArray.UncheckedAt(iTrkN1);
+	isLikeSign2Prong = cand.fLikeSign;
+	okD0 = cand.fOKD0; okJPSI = cand.fOKJPSI; okD0fromDstar = cand.fOKD0fromDstar;
 
 	if((fD0toKpi && okD0) || (fJPSItoEle && okJPSI) || (isLikeSign2Prong && (okD0 || okJPSI))) {
 	  // add the vertex and the decay to the AOD
@@ -896,10 +899,11 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
               if(fMakeReducedRHF){
 		rd->DeleteRecoD();
 		rd->SetPrimaryVtxRef((AliAODVertex*)event->GetPrimaryVertex());
+		rd->SetSecondaryVtx(0x0); // temporary vertex, not stored
               }else{
 		rd->SetSecondaryVtx(v2Prong);
 		v2Prong->SetParent(rd);
-		AddRefs(v2Prong,rd,event,twoTrackArray1);
+		AddRefs(v2Prong,rd,event,candTrackArray);
               }
 	    }
 	    if(okJPSI) {
@@ -907,9 +911,11 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	      if(fMakeReducedRHF){
 		rd->DeleteRecoD();
 		rd->SetPrimaryVtxRef((AliAODVertex*)event->GetPrimaryVertex());
+		rd->SetSecondaryVtx(0x0);
 	      }else{
+		rd->SetSecondaryVtx(v2Prong);
 		if(!okD0) v2Prong->SetParent(rd); // it cannot have two mothers ...
-		AddRefs(v2Prong,rd,event,twoTrackArray1);
+		AddRefs(v2Prong,rd,event,candTrackArray);
               }
 	    }
 	  } else { // isLikeSign2Prong
@@ -919,10 +925,11 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	    if(fMakeReducedRHF){
 	      rd->DeleteRecoD();
 	      rd->SetPrimaryVtxRef((AliAODVertex*)event->GetPrimaryVertex());
+	      rd->SetSecondaryVtx(0x0);
 	    }else{
 	      rd->SetSecondaryVtx(v2Prong);
 	      v2Prong->SetParent(rd);
-	      AddRefs(v2Prong,rd,event,twoTrackArray1);
+	      AddRefs(v2Prong,rd,event,candTrackArray);
 	    }
 	  }
 	}
@@ -930,13 +937,12 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	if(fDstar && okD0fromDstar && !isLikeSign2Prong) {
 	  // write references in io2Prong
 	  if(fInputAOD) {
-	    AddDaughterRefs(vertexp1n1,event,twoTrackArray1);
+	    AddDaughterRefs(vertexp1n1,event,candTrackArray);
 	  } else {
 	    vertexp1n1->AddDaughter(postrack1);
 	    vertexp1n1->AddDaughter(negtrack1);
 	  }
 	  io2Prong->SetSecondaryVtx(vertexp1n1);
-          //printf("--->  %d %d %d %d %d\n",vertexp1n1->GetNDaughters(),iTrkP1,iTrkN1,postrack1->Charge(),negtrack1->Charge());
 	  // create a track from the D0
 	  AliNeutralTrackParam *trackD0 = new AliNeutralTrackParam(io2Prong);
 
@@ -1000,11 +1006,12 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
                  if(fMakeReducedRHF){
 		   rd->DeleteRecoD();
 		   rd->SetPrimaryVtxRef((AliAODVertex*)event->GetPrimaryVertex());
+		   rd->SetSecondaryVtx(0x0);
 	         }else{
 		   AliAODVertex *v2Prong = new (verticesHFRef[iVerticesHF++])AliAODVertex(*vertexp1n1);
 		   rd->SetSecondaryVtx(v2Prong);
 		   v2Prong->SetParent(rd);
-		   AddRefs(v2Prong,rd,event,twoTrackArray1);
+		   AddRefs(v2Prong,rd,event,candTrackArray);
                  }
         	okD0=kTRUE; // this is done to add it only once
 	      }
@@ -1012,7 +1019,6 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	      rc = new(aodDstarRef[iDstar++])AliAODRecoCascadeHF(*ioCascade);
 	      // Set selection bit for PID
 	      SetSelectionBitForPID(fCutsDStartoKpipi,rc,AliRDHFCuts::kDstarPID);
-	      AliAODVertex *vCasc = 0x0;
                if(fMakeReducedRHF){
 		 //assign a ID to the D0 candidate, daughter of the Cascade. ID = position in the D0toKpi array
 		 UShort_t idCasc[2]={(UShort_t)trackPi->GetID(),(UShort_t)(iD0toKpi-1)};
@@ -1037,524 +1043,645 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	  if(trackD0) {delete trackD0; trackD0=NULL;}
 
 	}
-	if(io2Prong) {delete io2Prong; io2Prong=NULL;}
+	negtrack1 = 0;
+
+      } else if(cand.fNProngs==3) {
+	io3Prong = (AliAODRecoDecayHF3Prong*)cand.fRecoDecay;
+	AliAODVertex *v3Prong=0x0;
+	if(!fMakeReducedRHF) v3Prong = new(verticesHFRef[iVerticesHF++])AliAODVertex(*cand.fVertex);
+	if(!cand.fLikeSign) {
+	  rd = new(aodCharm3ProngRef[i3Prong++])AliAODRecoDecayHF3Prong(*io3Prong);
+	} else { // like-sign triplet
+	  rd = new(aodLikeSign3ProngRef[iLikeSign3Prong++])AliAODRecoDecayHF3Prong(*io3Prong);
+	}
+	// Set selection bit for PID
+	SetSelectionBitForPID(fCutsDplustoKpipi,rd,AliRDHFCuts::kDplusPID);
+	SetSelectionBitForPID(fCutsDstoKKpi,rd,AliRDHFCuts::kDsPID);
+	SetSelectionBitForPID(fCutsLctopKpi,rd,AliRDHFCuts::kLcPID);
+	if(fMakeReducedRHF){
+	  rd->SetPrimaryVtxRef((AliAODVertex*)event->GetPrimaryVertex());
+	  ((AliAODRecoDecayHF3Prong*)rd)->DeleteRecoD();
+	  rd->SetSecondaryVtx(0x0);
+	}else{
+	  rd->SetSecondaryVtx(v3Prong);
+	  v3Prong->SetParent(rd);
+	  AddRefs(v3Prong,rd,event,candTrackArray);
+	}
+
+      } else { // 4 prongs
+	io4Prong = (AliAODRecoDecayHF4Prong*)cand.fRecoDecay;
+	rd = new(aodCharm4ProngRef[i4Prong++])AliAODRecoDecayHF4Prong(*io4Prong);
+	if(fMakeReducedRHF){
+	  rd->DeleteRecoD();
+	  rd->SetPrimaryVtxRef((AliAODVertex*)event->GetPrimaryVertex());
+	  rd->SetSecondaryVtx(0x0);
+	}else{
+	  AliAODVertex *v4Prong = new(verticesHFRef[iVerticesHF++])AliAODVertex(*cand.fVertex);
+	  rd->SetSecondaryVtx(v4Prong);
+	  v4Prong->SetParent(rd);
+	  AddRefs(v4Prong,rd,event,candTrackArray);
+	}
       }
 
+      delete cand.fRecoDecay; cand.fRecoDecay=NULL;
+      delete cand.fVertex; cand.fVertex=NULL;
+      io2Prong=NULL; io3Prong=NULL; io4Prong=NULL;
+    } // end loop on the candidates of this track
+    candTrackArray->Clear();
+    cands.clear();
+
+    postrack1 = 0;
+ }  // end 1st loop on positive tracks
+
+
+  //  AliDebug(1,Form(" Total HF vertices in event = %d;",
+  //		  (Int_t)aodVerticesHFTClArr->GetEntriesFast()));
+  if(fD0toKpi) {
+    AliDebug(1,Form(" D0->Kpi in event = %d;",
+		    (Int_t)aodD0toKpiTClArr->GetEntriesFast()));
+  }
+  if(fJPSItoEle) {
+    AliDebug(1,Form(" JPSI->ee in event = %d;",
+		    (Int_t)aodJPSItoEleTClArr->GetEntriesFast()));
+  }
+  if(f3Prong) {
+    AliDebug(1,Form(" Charm->3Prong in event = %d;",
+		    (Int_t)aodCharm3ProngTClArr->GetEntriesFast()));
+  }
+  if(f4Prong) {
+    AliDebug(1,Form(" Charm->4Prong in event = %d;\n",
+		    (Int_t)aodCharm4ProngTClArr->GetEntriesFast()));
+  }
+  if(fDstar) {
+    AliDebug(1,Form(" D*->D0pi in event = %d;\n",
+		    (Int_t)aodDstarTClArr->GetEntriesFast()));
+  }
+  if(fCascades){
+    AliDebug(1,Form(" cascades -> v0 + track in event = %d;\n",
+		    (Int_t)aodCascadesTClArr->GetEntriesFast()));
+  }
+  if(fLikeSign) {
+    AliDebug(1,Form(" Like-sign 2Prong in event = %d;\n",
+		    (Int_t)aodLikeSign2ProngTClArr->GetEntriesFast()));
+  }
+  if(fLikeSign3prong && f3Prong) {
+    AliDebug(1,Form(" Like-sign 3Prong in event = %d;\n",
+		    (Int_t)aodLikeSign3ProngTClArr->GetEntriesFast()));
+  }
+
+
+  twoTrackArrayCasc->Delete();  delete twoTrackArrayCasc;
+  twoTrackArrayV0->Delete();  delete twoTrackArrayV0;
+  candTrackArray->Clear();  delete candTrackArray;
+  delete [] seleFlags; seleFlags=NULL;
+  if(evtNumber) {delete [] evtNumber; evtNumber=NULL;}
+  tracksAtVertex.Delete();
+  fTrkPreselNTrks=0;
+
+  if(fInputAOD) {
+    seleTrksArray.Delete();
+    if(fAODMap) { delete [] fAODMap; fAODMap=NULL; }
+  }
+
+
+  //printf("Trks: total %d  sele %d\n",fnTrksTotal,fnSeleTrksTotal);
+
+  return;
+}
+//----------------------------------------------------------------------------
+void AliAnalysisVertexingHF::FindCandidatesForTrack(Int_t iTrkP1,AliVEvent *event,
+						    const TObjArray &seleTrksArray,
+						    const TObjArray &tracksAtVertex,
+						    Int_t nSeleTrks,const UChar_t *seleFlags,
+						    const Int_t *evtNumber,Float_t dcaMax,
+						    Double_t minPtPair,Double_t minPt3Prong,
+						    std::vector<CandidateRecord> &cands)
+{
+  /// 2-, 3- and 4-prong candidates with the track iTrkP1 as first prong.
+  /// They are appended to cands in the order in which FindCandidates stores
+  /// them; the pairs needed for the D* loop are kept as well.
+  /// The tracks of seleTrksArray are used as scratch (they are set back
+  /// to the primary vertex before each use).
+  //AliCodeTimerAuto("",0);
+
+  AliAODRecoDecayHF2Prong *io2Prong  = 0;
+  AliAODRecoDecayHF3Prong *io3Prong  = 0;
+  AliAODRecoDecayHF4Prong *io4Prong  = 0;
+
+  Int_t    iTrkP2,iTrkN1,iTrkN2;
+  Double_t xdummy,ydummy,dcap1n1,dcap1n2,dcap2n1,dcap1p2,dcan1n2,dcap2n2;
+  Bool_t   okD0=kFALSE,okJPSI=kFALSE,ok3Prong=kFALSE,ok4Prong=kFALSE;
+  Bool_t   okD0fromDstar=kFALSE;
+  AliESDtrack *postrack1 = 0;
+  AliESDtrack *postrack2 = 0;
+  AliESDtrack *negtrack1 = 0;
+  AliESDtrack *negtrack2 = 0;
+  Double_t mompos1[3],mompos2[3],momneg1[3],momneg2[3];
+
+  TObjArray *twoTrackArray1    = new TObjArray(2);
+  TObjArray *twoTrackArray2    = new TObjArray(2);
+  TObjArray *threeTrackArray   = new TObjArray(3);
+  TObjArray *fourTrackArray    = new TObjArray(4);
+
+  Double_t dispersion;
+  Bool_t isLikeSign2Prong=kFALSE,isLikeSign3Prong=kFALSE;
+  Bool_t massCutOK=kTRUE;
+  CandidateRecord cand;
+
+  // get track from tracks array, momentum at the primary vertex
+  postrack1 = (AliESDtrack*)seleTrksArray.UncheckedAt(iTrkP1);
+  ((AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkP1))->GetPxPyPz(mompos1);
+
+  // LOOP ON  NEGATIVE  TRACKS
+  for(iTrkN1=0; iTrkN1<nSeleTrks; iTrkN1++) {
+
+    if(iTrkN1==iTrkP1) continue;
+
+    // get track from tracks array
+    negtrack1 = (AliESDtrack*)seleTrksArray.UncheckedAt(iTrkN1);
+
+    if(negtrack1->Charge()>0 && !fLikeSign) continue;
+
+    if(!TESTBIT(seleFlags[iTrkN1],kBitDispl)) continue;
+
+    if(fMixEvent) {
+      if(evtNumber[iTrkP1]==evtNumber[iTrkN1]) continue;
+    }
+
+    if(postrack1->Charge()==negtrack1->Charge()) { // like-sign
+      isLikeSign2Prong=kTRUE;
+      if(!fLikeSign)    continue;
+      if(iTrkN1<iTrkP1) continue; // this is needed to avoid double-counting of like-sign
+    } else { // unlike-sign
+      isLikeSign2Prong=kFALSE;
+      if(postrack1->Charge()<0 || negtrack1->Charge()>0) continue;  // this is needed to avoid double-counting of unlike-sign
+      if(fMixEvent) {
+	if(evtNumber[iTrkP1]==evtNumber[iTrkN1]) continue;
+      }
+
+    }
+
+    // pre-selection with the transverse circles of the tracks
+    fnCombinations[kPairTried]++;
+    if(IsPairRejected(iTrkP1,iTrkN1,dcaMax) || IsBelowMinPt(minPtPair,iTrkP1,iTrkN1)) {
+      fnCombinations[kPairPreselRej]++;
+      negtrack1=0;
+      continue;
+    }
+
+    // back to primary vertex
+    SetParametersAtVertex(postrack1,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkP1));
+    SetParametersAtVertex(negtrack1,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkN1));
+    negtrack1->GetPxPyPz(momneg1);
+
+    // DCA between the two tracks
+    dcap1n1 = postrack1->GetDCA(negtrack1,fBzkG,xdummy,ydummy);
+    if(dcap1n1>dcaMax) { fnCombinations[kPairDCARej]++; negtrack1=0; continue; }
+
+    // Vertexing
+    twoTrackArray1->AddAt(postrack1,0);
+    twoTrackArray1->AddAt(negtrack1,1);
+    AliAODVertex *vertexp1n1 = ReconstructSecondaryVertex(twoTrackArray1,dispersion);
+    if(!vertexp1n1) {
+      fnCombinations[kPairVtxRej]++;
       twoTrackArray1->Clear();
-      if( (!f3Prong && !f4Prong) ||
-	  (isLikeSign2Prong && !f3Prong) ) {
-	negtrack1=0;
-	delete vertexp1n1;
-	continue;
+      negtrack1=0;
+      continue;
+    }
+    // 2 prong candidate
+    if(fD0toKpi || fJPSItoEle || fDstar || fLikeSign) {
+
+      io2Prong = Make2Prong(twoTrackArray1,event,vertexp1n1,dcap1n1,okD0,okJPSI,okD0fromDstar);
+      if(okD0 || okJPSI) fnCombinations[kPairCand]++;
+
+      // keep it if it goes to the AOD or seeds the D* loop
+      if((fD0toKpi && okD0) || (fJPSItoEle && okJPSI) || (isLikeSign2Prong && (okD0 || okJPSI)) ||
+	 (fDstar && okD0fromDstar && !isLikeSign2Prong)) {
+	cand.fNProngs = 2;
+	cand.fTrk[0] = iTrkP1; cand.fTrk[1] = iTrkN1; cand.fTrk[2] = cand.fTrk[3] = -1;
+	cand.fLikeSign = isLikeSign2Prong;
+	cand.fOKD0 = okD0; cand.fOKJPSI = okJPSI; cand.fOKD0fromDstar = okD0fromDstar;
+	cand.fRecoDecay = io2Prong;
+	cand.fVertex = new AliAODVertex(*vertexp1n1);
+	cands.push_back(cand);
+	io2Prong=NULL;
       }
+      if(io2Prong) {delete io2Prong; io2Prong=NULL;}
+    }
+
+    twoTrackArray1->Clear();
+    if( (!f3Prong && !f4Prong) ||
+	(isLikeSign2Prong && !f3Prong) ) {
+      negtrack1=0;
+      delete vertexp1n1;
+      continue;
+    }
 
 
-      // 2nd LOOP  ON  POSITIVE  TRACKS
-      for(iTrkP2=iTrkP1+1; iTrkP2<nSeleTrks; iTrkP2++) {
+    // 2nd LOOP  ON  POSITIVE  TRACKS
+    for(iTrkP2=iTrkP1+1; iTrkP2<nSeleTrks; iTrkP2++) {
 
-	if(iTrkP2==iTrkP1 || iTrkP2==iTrkN1) continue;
+      if(iTrkP2==iTrkP1 || iTrkP2==iTrkN1) continue;
 
-	//if(iTrkP2%1==0) AliDebug(1,Form("    2nd loop on pos: track number %d of %d",iTrkP2,nSeleTrks));
+      // get track from tracks array
+      postrack2 = (AliESDtrack*)seleTrksArray.UncheckedAt(iTrkP2);
 
-	// get track from tracks array
-	postrack2 = (AliESDtrack*)seleTrksArray.UncheckedAt(iTrkP2);
+      if(postrack2->Charge()<0) continue;
 
-	if(postrack2->Charge()<0) continue;
+      if(!TESTBIT(seleFlags[iTrkP2],kBitDispl)) continue;
 
-	if(!TESTBIT(seleFlags[iTrkP2],kBitDispl)) continue;
+      // Check single tracks cuts specific for 3 prongs
+      if(!TESTBIT(seleFlags[iTrkP2],kBit3Prong)) continue;
+      if(!TESTBIT(seleFlags[iTrkP1],kBit3Prong)) continue;
+      if(!TESTBIT(seleFlags[iTrkN1],kBit3Prong)) continue;
 
-	// Check single tracks cuts specific for 3 prongs
-	if(!TESTBIT(seleFlags[iTrkP2],kBit3Prong)) continue;
-	if(!TESTBIT(seleFlags[iTrkP1],kBit3Prong)) continue;
-	if(!TESTBIT(seleFlags[iTrkN1],kBit3Prong)) continue;
+      if(fMixEvent) {
+	if(evtNumber[iTrkP1]==evtNumber[iTrkP2] ||
+	   evtNumber[iTrkN1]==evtNumber[iTrkP2] ||
+	   evtNumber[iTrkP1]==evtNumber[iTrkN1]) continue;
+      }
 
+      if(isLikeSign2Prong) { // like-sign pair -> have to build only like-sign triplet
+	if(!fLikeSign3prong) continue;
+	if(postrack1->Charge()>0) { // ok: like-sign triplet (+++)
+	  isLikeSign3Prong=kTRUE;
+	} else { // not ok
+	  continue;
+	}
+      } else { // normal triplet (+-+)
+	isLikeSign3Prong=kFALSE;
 	if(fMixEvent) {
 	  if(evtNumber[iTrkP1]==evtNumber[iTrkP2] ||
 	     evtNumber[iTrkN1]==evtNumber[iTrkP2] ||
 	     evtNumber[iTrkP1]==evtNumber[iTrkN1]) continue;
 	}
+      }
 
-	if(isLikeSign2Prong) { // like-sign pair -> have to build only like-sign triplet
-	  if(!fLikeSign3prong) continue;
-	  if(postrack1->Charge()>0) { // ok: like-sign triplet (+++)
-	    isLikeSign3Prong=kTRUE;
-	  } else { // not ok
-	    continue;
+      if(fUseKaonPIDfor3Prong){
+	if(!TESTBIT(seleFlags[iTrkN1],kBitKaonCompat)) continue;
+      }
+      Bool_t okForLcTopKpi=kTRUE;
+      Int_t pidLcStatus=3; // 3= OK as pKpi and Kpipi
+      if(fUsePIDforLc>0){
+	if(!TESTBIT(seleFlags[iTrkP1],kBitProtonCompat) &&
+	   !TESTBIT(seleFlags[iTrkP2],kBitProtonCompat) ){
+	  okForLcTopKpi=kFALSE;
+	  pidLcStatus=0;
+	}
+	if(okForLcTopKpi && fUsePIDforLc>1){
+	  okForLcTopKpi=kFALSE;
+	  pidLcStatus=0;
+	  if(TESTBIT(seleFlags[iTrkP1],kBitProtonCompat) &&
+	     TESTBIT(seleFlags[iTrkP2],kBitPionCompat) ){
+	    okForLcTopKpi=kTRUE;
+	    pidLcStatus+=1; // 1= OK as pKpi
 	  }
-	} else { // normal triplet (+-+)
-	  isLikeSign3Prong=kFALSE;
-	  if(fMixEvent) {
-	    if(evtNumber[iTrkP1]==evtNumber[iTrkP2] ||
-	       evtNumber[iTrkN1]==evtNumber[iTrkP2] ||
-	       evtNumber[iTrkP1]==evtNumber[iTrkN1]) continue;
+	  if(TESTBIT(seleFlags[iTrkP2],kBitProtonCompat) &&
+	     TESTBIT(seleFlags[iTrkP1],kBitPionCompat) ){
+	    okForLcTopKpi=kTRUE;
+	    pidLcStatus+=2; // 2= OK as piKp
 	  }
 	}
+      }
+      Bool_t okForDsToKKpi=kTRUE;
+      if(fUseKaonPIDforDs){
+	if(!TESTBIT(seleFlags[iTrkP1],kBitKaonCompat) &&
+	   !TESTBIT(seleFlags[iTrkP2],kBitKaonCompat) ) okForDsToKKpi=kFALSE;
+      }
+      // pre-selection with the transverse circles of the tracks
+      // (the pt limit only if the triplet is not needed for the 4 prongs)
+      fnCombinations[kTripletTried]++;
+      if(IsPairRejected(iTrkP2,iTrkN1,dcaMax) || IsPairRejected(iTrkP2,iTrkP1,dcaMax) ||
+	 (!f4Prong && IsBelowMinPt(minPt3Prong,iTrkP1,iTrkN1,iTrkP2))) {
+	fnCombinations[kTripletPreselRej]++;
+	postrack2=0;
+	continue;
+      }
 
-	if(fUseKaonPIDfor3Prong){
-	  if(!TESTBIT(seleFlags[iTrkN1],kBitKaonCompat)) continue;
+      // back to primary vertex
+      SetParametersAtVertex(postrack1,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkP1));
+      SetParametersAtVertex(negtrack1,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkN1));
+      SetParametersAtVertex(postrack2,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkP2));
+
+      dcap2n1 = postrack2->GetDCA(negtrack1,fBzkG,xdummy,ydummy);
+      if(dcap2n1>dcaMax) { fnCombinations[kTripletDCARej]++; postrack2=0; continue; }
+      dcap1p2 = postrack2->GetDCA(postrack1,fBzkG,xdummy,ydummy);
+      if(dcap1p2>dcaMax) { fnCombinations[kTripletDCARej]++; postrack2=0; continue; }
+
+      // check invariant mass cuts for D+,Ds,Lc
+      massCutOK=kTRUE;
+      if(f3Prong) {
+	if(postrack2->Charge()>0) {
+	  threeTrackArray->AddAt(postrack1,0);
+	  threeTrackArray->AddAt(negtrack1,1);
+	  threeTrackArray->AddAt(postrack2,2);
+	} else {
+	  threeTrackArray->AddAt(negtrack1,0);
+	  threeTrackArray->AddAt(postrack1,1);
+	  threeTrackArray->AddAt(postrack2,2);
 	}
-	Bool_t okForLcTopKpi=kTRUE;
-	Int_t pidLcStatus=3; // 3= OK as pKpi and Kpipi
-	if(fUsePIDforLc>0){
-	  if(!TESTBIT(seleFlags[iTrkP1],kBitProtonCompat) &&
-	     !TESTBIT(seleFlags[iTrkP2],kBitProtonCompat) ){
-	    okForLcTopKpi=kFALSE;
-	    pidLcStatus=0;
-	  }
-	  if(okForLcTopKpi && fUsePIDforLc>1){
-	    okForLcTopKpi=kFALSE;
-	    pidLcStatus=0;
-	    if(TESTBIT(seleFlags[iTrkP1],kBitProtonCompat) &&
-	       TESTBIT(seleFlags[iTrkP2],kBitPionCompat) ){
-	      okForLcTopKpi=kTRUE;
-	      pidLcStatus+=1; // 1= OK as pKpi
-	    }
-	    if(TESTBIT(seleFlags[iTrkP2],kBitProtonCompat) &&
-	       TESTBIT(seleFlags[iTrkP1],kBitPionCompat) ){
-	      okForLcTopKpi=kTRUE;
-	      pidLcStatus+=2; // 2= OK as piKp
-	    }
-	  }
+	if(fMassCutBeforeVertexing){
+	  postrack2->GetPxPyPz(mompos2);
+	  Double_t pxDau[3]={mompos1[0],momneg1[0],mompos2[0]};
+	  Double_t pyDau[3]={mompos1[1],momneg1[1],mompos2[1]};
+	  Double_t pzDau[3]={mompos1[2],momneg1[2],mompos2[2]};
+	  //	    massCutOK = SelectInvMassAndPt3prong(threeTrackArray);
+	  massCutOK = SelectInvMassAndPt3prong(pxDau,pyDau,pzDau,pidLcStatus);
 	}
-	Bool_t okForDsToKKpi=kTRUE;
-	if(fUseKaonPIDforDs){
-	  if(!TESTBIT(seleFlags[iTrkP1],kBitKaonCompat) &&
-	     !TESTBIT(seleFlags[iTrkP2],kBitKaonCompat) ) okForDsToKKpi=kFALSE;
+      }
+
+      if(f3Prong && !massCutOK) {
+	fnCombinations[kTripletMassRej]++;
+	threeTrackArray->Clear();
+	if(!f4Prong) {
+	  postrack2=0;
+	  continue;
 	}
+      }
+
+      // Vertexing
+      twoTrackArray2->AddAt(postrack2,0);
+      twoTrackArray2->AddAt(negtrack1,1);
+      AliAODVertex *vertexp2n1 = ReconstructSecondaryVertex(twoTrackArray2,dispersion);
+      if(!vertexp2n1) {
+	if(f3Prong && massCutOK) fnCombinations[kTripletVtxRej]++;
+	twoTrackArray2->Clear();
+	postrack2=0;
+	continue;
+      }
+
+      // 3 prong candidates
+      if(f3Prong && massCutOK) {
+
+	AliAODVertex* secVert3PrAOD = ReconstructSecondaryVertex(threeTrackArray,dispersion);
+	io3Prong = Make3Prong(threeTrackArray,event,secVert3PrAOD,dispersion,vertexp1n1,vertexp2n1,dcap1n1,dcap2n1,dcap1p2,okForLcTopKpi,okForDsToKKpi,ok3Prong);
+	if(ok3Prong) {
+	  fnCombinations[kTripletCand]++;
+	  cand.fNProngs = 3;
+	  cand.fTrk[0] = iTrkP1; cand.fTrk[1] = iTrkN1; cand.fTrk[2] = iTrkP2; cand.fTrk[3] = -1;
+	  cand.fLikeSign = isLikeSign3Prong;
+	  cand.fOKD0 = cand.fOKJPSI = cand.fOKD0fromDstar = kFALSE;
+	  cand.fRecoDecay = io3Prong; io3Prong=NULL;
+	  cand.fVertex = secVert3PrAOD; secVert3PrAOD=NULL;
+	  cands.push_back(cand);
+	}
+	if(io3Prong) {delete io3Prong; io3Prong=NULL;}
+	if(secVert3PrAOD) {delete secVert3PrAOD; secVert3PrAOD=NULL;}
+      }
+
+      // 4 prong candidates
+      if(f4Prong
+	 // don't make 4 prong with like-sign pairs and triplets
+	 && !isLikeSign2Prong && !isLikeSign3Prong
+	 // track-to-track dca cuts already now
+	 && dcap1n1 < fCutsD0toKpipipi->GetDCACut()
+	 && dcap2n1 < fCutsD0toKpipipi->GetDCACut()) {
 	// back to primary vertex
-	//	postrack1->PropagateToDCA(fV1,fBzkG,kVeryBig);
-	//	postrack2->PropagateToDCA(fV1,fBzkG,kVeryBig);
-	//	negtrack1->PropagateToDCA(fV1,fBzkG,kVeryBig);
 	SetParametersAtVertex(postrack1,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkP1));
 	SetParametersAtVertex(negtrack1,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkN1));
 	SetParametersAtVertex(postrack2,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkP2));
 
-	//printf("********** %d %d %d\n",postrack1->GetID(),postrack2->GetID(),negtrack1->GetID());
-
-	dcap2n1 = postrack2->GetDCA(negtrack1,fBzkG,xdummy,ydummy);
-	if(dcap2n1>dcaMax) { postrack2=0; continue; }
-	dcap1p2 = postrack2->GetDCA(postrack1,fBzkG,xdummy,ydummy);
-	if(dcap1p2>dcaMax) { postrack2=0; continue; }
-
-	// check invariant mass cuts for D+,Ds,Lc
-        massCutOK=kTRUE;
-	if(f3Prong) {
-	  if(postrack2->Charge()>0) {
-	    threeTrackArray->AddAt(postrack1,0);
-	    threeTrackArray->AddAt(negtrack1,1);
-	    threeTrackArray->AddAt(postrack2,2);
-	  } else {
-	    threeTrackArray->AddAt(negtrack1,0);
-	    threeTrackArray->AddAt(postrack1,1);
-	    threeTrackArray->AddAt(postrack2,2);
-	  }
-	  if(fMassCutBeforeVertexing){
-	    postrack2->GetPxPyPz(mompos2);
-	    Double_t pxDau[3]={mompos1[0],momneg1[0],mompos2[0]};
-	    Double_t pyDau[3]={mompos1[1],momneg1[1],mompos2[1]};
-	    Double_t pzDau[3]={mompos1[2],momneg1[2],mompos2[2]};
-	    //	    massCutOK = SelectInvMassAndPt3prong(threeTrackArray);
-	    massCutOK = SelectInvMassAndPt3prong(pxDau,pyDau,pzDau,pidLcStatus);
-	  }
-	}
+	// Vertexing for these 3 (can be taken from above?)
+	threeTrackArray->AddAt(postrack1,0);
+	threeTrackArray->AddAt(negtrack1,1);
+	threeTrackArray->AddAt(postrack2,2);
+	AliAODVertex* vertexp1n1p2 = ReconstructSecondaryVertex(threeTrackArray,dispersion);
 
-	if(f3Prong && !massCutOK) {
-	  threeTrackArray->Clear();
-	  if(!f4Prong) {
-	    postrack2=0;
-	    continue;
-	  }
-	}
+	// 3rd LOOP  ON  NEGATIVE  TRACKS (for 4 prong)
+	for(iTrkN2=iTrkN1+1; iTrkN2<nSeleTrks; iTrkN2++) {
 
-	// Vertexing
-	twoTrackArray2->AddAt(postrack2,0);
-	twoTrackArray2->AddAt(negtrack1,1);
-	AliAODVertex *vertexp2n1 = ReconstructSecondaryVertex(twoTrackArray2,dispersion);
-	if(!vertexp2n1) {
-	  twoTrackArray2->Clear();
-	  postrack2=0;
-	  continue;
-	}
+	  if(iTrkN2==iTrkP1 || iTrkN2==iTrkP2 || iTrkN2==iTrkN1) continue;
 
-	// 3 prong candidates
-	if(f3Prong && massCutOK) {
+	  // get track from tracks array
+	  negtrack2 = (AliESDtrack*)seleTrksArray.UncheckedAt(iTrkN2);
 
-	  AliAODVertex* secVert3PrAOD = ReconstructSecondaryVertex(threeTrackArray,dispersion);
-	  io3Prong = Make3Prong(threeTrackArray,event,secVert3PrAOD,dispersion,vertexp1n1,vertexp2n1,dcap1n1,dcap2n1,dcap1p2,okForLcTopKpi,okForDsToKKpi,ok3Prong);
-	  if(ok3Prong) {
-            AliAODVertex *v3Prong=0x0;
-	    if(!fMakeReducedRHF)v3Prong = new (verticesHFRef[iVerticesHF++])AliAODVertex(*secVert3PrAOD);
-	    if(!isLikeSign3Prong) {
-	      rd = new(aodCharm3ProngRef[i3Prong++])AliAODRecoDecayHF3Prong(*io3Prong);
-	      // Set selection bit for PID
-	      SetSelectionBitForPID(fCutsDplustoKpipi,rd,AliRDHFCuts::kDplusPID);
-	      SetSelectionBitForPID(fCutsDstoKKpi,rd,AliRDHFCuts::kDsPID);
-	      SetSelectionBitForPID(fCutsLctopKpi,rd,AliRDHFCuts::kLcPID);
-	      if(fMakeReducedRHF){
-		rd->SetPrimaryVtxRef((AliAODVertex*)event->GetPrimaryVertex());
-                ((AliAODRecoDecayHF3Prong*)rd)->DeleteRecoD();
-	      }else{
-                v3Prong = new (verticesHFRef[iVerticesHF++])AliAODVertex(*secVert3PrAOD);
-		rd->SetSecondaryVtx(v3Prong);
-		v3Prong->SetParent(rd);
-		AddRefs(v3Prong,rd,event,threeTrackArray);
-	      }
-	    } else { // isLikeSign3Prong
-	      if(fLikeSign3prong){
-		rd = new(aodLikeSign3ProngRef[iLikeSign3Prong++])AliAODRecoDecayHF3Prong(*io3Prong);
-	        // Set selection bit for PID
-	        SetSelectionBitForPID(fCutsDplustoKpipi,rd,AliRDHFCuts::kDplusPID);
-	        SetSelectionBitForPID(fCutsDstoKKpi,rd,AliRDHFCuts::kDsPID);
-	        SetSelectionBitForPID(fCutsLctopKpi,rd,AliRDHFCuts::kLcPID);
-                if(fMakeReducedRHF){
-		  rd->SetPrimaryVtxRef((AliAODVertex*)event->GetPrimaryVertex());
-                  ((AliAODRecoDecayHF3Prong*)rd)->DeleteRecoD();
-		}else{
-		  rd->SetSecondaryVtx(v3Prong);
-		  v3Prong->SetParent(rd);
-		  AddRefs(v3Prong,rd,event,threeTrackArray);
-                }
-	      }
-	    }
+	  if(negtrack2->Charge()>0) continue;
 
+	  if(!TESTBIT(seleFlags[iTrkN2],kBitDispl)) continue;
+	  if(fMixEvent){
+	    if(evtNumber[iTrkP1]==evtNumber[iTrkN2] ||
+	       evtNumber[iTrkN1]==evtNumber[iTrkN2] ||
+	       evtNumber[iTrkP2]==evtNumber[iTrkN2] ||
+	       evtNumber[iTrkP1]==evtNumber[iTrkN1] ||
+	       evtNumber[iTrkP1]==evtNumber[iTrkP2] ||
+	       evtNumber[iTrkN1]==evtNumber[iTrkP2]) continue;
 	  }
-	  if(io3Prong) {delete io3Prong; io3Prong=NULL;}
-	  if(secVert3PrAOD) {delete secVert3PrAOD; secVert3PrAOD=NULL;}
-	}
 
-	// 4 prong candidates
-	if(f4Prong
-	   // don't make 4 prong with like-sign pairs and triplets
-	   && !isLikeSign2Prong && !isLikeSign3Prong
-	   // track-to-track dca cuts already now
-	   && dcap1n1 < fCutsD0toKpipipi->GetDCACut()
-	   && dcap2n1 < fCutsD0toKpipipi->GetDCACut()) {
+	  // pre-selection with the transverse circles of the tracks
+	  if(IsPairRejected(iTrkP1,iTrkN2,fCutsD0toKpipipi->GetDCACut()) ||
+	     IsPairRejected(iTrkP2,iTrkN2,fCutsD0toKpipipi->GetDCACut())) { negtrack2=0; continue; }
+
 	  // back to primary vertex
-	  //	  postrack1->PropagateToDCA(fV1,fBzkG,kVeryBig);
-	  //	  postrack2->PropagateToDCA(fV1,fBzkG,kVeryBig);
-	  //	  negtrack1->PropagateToDCA(fV1,fBzkG,kVeryBig);
 	  SetParametersAtVertex(postrack1,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkP1));
 	  SetParametersAtVertex(negtrack1,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkN1));
 	  SetParametersAtVertex(postrack2,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkP2));
+	  SetParametersAtVertex(negtrack2,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkN2));
 
-	  // Vertexing for these 3 (can be taken from above?)
-          threeTrackArray->AddAt(postrack1,0);
-          threeTrackArray->AddAt(negtrack1,1);
-	  threeTrackArray->AddAt(postrack2,2);
-          AliAODVertex* vertexp1n1p2 = ReconstructSecondaryVertex(threeTrackArray,dispersion);
-
-	  // 3rd LOOP  ON  NEGATIVE  TRACKS (for 4 prong)
-	  for(iTrkN2=iTrkN1+1; iTrkN2<nSeleTrks; iTrkN2++) {
+	  dcap1n2 = postrack1->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
+	  if(dcap1n2 > fCutsD0toKpipipi->GetDCACut()) { negtrack2=0; continue; }
+	  dcap2n2 = postrack2->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
+	  if(dcap2n2 > fCutsD0toKpipipi->GetDCACut()) { negtrack2=0; continue; }
 
-	    if(iTrkN2==iTrkP1 || iTrkN2==iTrkP2 || iTrkN2==iTrkN1) continue;
 
-	    //if(iTrkN2%1==0) AliDebug(1,Form("    3rd loop on neg: track number %d of %d",iTrkN2,nSeleTrks));
+	  fourTrackArray->AddAt(postrack1,0);
+	  fourTrackArray->AddAt(negtrack1,1);
+	  fourTrackArray->AddAt(postrack2,2);
+	  fourTrackArray->AddAt(negtrack2,3);
 
-	    // get track from tracks array
-	    negtrack2 = (AliESDtrack*)seleTrksArray.UncheckedAt(iTrkN2);
-
-	    if(negtrack2->Charge()>0) continue;
-
-	    if(!TESTBIT(seleFlags[iTrkN2],kBitDispl)) continue;
-	    if(fMixEvent){
-	      if(evtNumber[iTrkP1]==evtNumber[iTrkN2] ||
-		 evtNumber[iTrkN1]==evtNumber[iTrkN2] ||
-		 evtNumber[iTrkP2]==evtNumber[iTrkN2] ||
-		 evtNumber[iTrkP1]==evtNumber[iTrkN1] ||
-		 evtNumber[iTrkP1]==evtNumber[iTrkP2] ||
-		 evtNumber[iTrkN1]==evtNumber[iTrkP2]) continue;
-	    }
-
-	    // back to primary vertex
-	    // postrack1->PropagateToDCA(fV1,fBzkG,kVeryBig);
-	    // postrack2->PropagateToDCA(fV1,fBzkG,kVeryBig);
-	    // negtrack1->PropagateToDCA(fV1,fBzkG,kVeryBig);
-	    // negtrack2->PropagateToDCA(fV1,fBzkG,kVeryBig);
-	    SetParametersAtVertex(postrack1,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkP1));
-	    SetParametersAtVertex(negtrack1,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkN1));
-	    SetParametersAtVertex(postrack2,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkP2));
-	    SetParametersAtVertex(negtrack2,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkN2));
-
-	    dcap1n2 = postrack1->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
-	    if(dcap1n2 > fCutsD0toKpipipi->GetDCACut()) { negtrack2=0; continue; }
-            dcap2n2 = postrack2->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
-            if(dcap2n2 > fCutsD0toKpipipi->GetDCACut()) { negtrack2=0; continue; }
-
-
-	    fourTrackArray->AddAt(postrack1,0);
-	    fourTrackArray->AddAt(negtrack1,1);
-	    fourTrackArray->AddAt(postrack2,2);
-	    fourTrackArray->AddAt(negtrack2,3);
-
-	    // check invariant mass cuts for D0
-	    massCutOK=kTRUE;
-	    if(fMassCutBeforeVertexing)
-	      massCutOK = SelectInvMassAndPt4prong(fourTrackArray);
-
-	    if(!massCutOK) {
-	      fourTrackArray->Clear();
-	      negtrack2=0;
-	      continue;
-	    }
-
-	    // Vertexing
-	    AliAODVertex* secVert4PrAOD = ReconstructSecondaryVertex(fourTrackArray,dispersion);
-	    io4Prong = Make4Prong(fourTrackArray,event,secVert4PrAOD,vertexp1n1,vertexp1n1p2,dcap1n1,dcap1n2,dcap2n1,dcap2n2,ok4Prong);
-	    if(ok4Prong) {
-	      rd = new(aodCharm4ProngRef[i4Prong++])AliAODRecoDecayHF4Prong(*io4Prong);
-	      if(fMakeReducedRHF){
-		rd->DeleteRecoD();
-		rd->SetPrimaryVtxRef((AliAODVertex*)event->GetPrimaryVertex());
-	      }else{
-                AliAODVertex *v4Prong = new(verticesHFRef[iVerticesHF++])AliAODVertex(*secVert4PrAOD);
-		rd->SetSecondaryVtx(v4Prong);
-		v4Prong->SetParent(rd);
-		AddRefs(v4Prong,rd,event,fourTrackArray);
-	      }
-            }
+	  // check invariant mass cuts for D0
+	  massCutOK=kTRUE;
+	  if(fMassCutBeforeVertexing)
+	    massCutOK = SelectInvMassAndPt4prong(fourTrackArray);
 
-	    if(io4Prong) {delete io4Prong; io4Prong=NULL;}
-	    if(secVert4PrAOD) {delete secVert4PrAOD; secVert4PrAOD=NULL;}
+	  if(!massCutOK) {
 	    fourTrackArray->Clear();
-	    negtrack2 = 0;
+	    negtrack2=0;
+	    continue;
+	  }
 
-	  } // end loop on negative tracks
+	  // Vertexing
+	  AliAODVertex* secVert4PrAOD = ReconstructSecondaryVertex(fourTrackArray,dispersion);
+	  io4Prong = Make4Prong(fourTrackArray,event,secVert4PrAOD,vertexp1n1,vertexp1n1p2,dcap1n1,dcap1n2,dcap2n1,dcap2n2,ok4Prong);
+	  if(ok4Prong) {
+	    cand.fNProngs = 4;
+	    cand.fTrk[0] = iTrkP1; cand.fTrk[1] = iTrkN1; cand.fTrk[2] = iTrkP2; cand.fTrk[3] = iTrkN2;
+	    cand.fLikeSign = kFALSE;
+	    cand.fOKD0 = cand.fOKJPSI = cand.fOKD0fromDstar = kFALSE;
+	    cand.fRecoDecay = io4Prong; io4Prong=NULL;
+	    cand.fVertex = secVert4PrAOD; secVert4PrAOD=NULL;
+	    cands.push_back(cand);
+	  }
 
-          threeTrackArray->Clear();
-	  delete vertexp1n1p2;
+	  if(io4Prong) {delete io4Prong; io4Prong=NULL;}
+	  if(secVert4PrAOD) {delete secVert4PrAOD; secVert4PrAOD=NULL;}
+	  fourTrackArray->Clear();
+	  negtrack2 = 0;
 
-	}
+	} // end loop on negative tracks
 
-	postrack2 = 0;
-	delete vertexp2n1;
+	threeTrackArray->Clear();
+	delete vertexp1n1p2;
 
-      } // end 2nd loop on positive tracks
+      }
 
-      twoTrackArray2->Clear();
+      postrack2 = 0;
+      delete vertexp2n1;
 
-      // 2nd LOOP  ON  NEGATIVE  TRACKS (for 3 prong -+-)
-      for(iTrkN2=iTrkN1+1; iTrkN2<nSeleTrks; iTrkN2++) {
+    } // end 2nd loop on positive tracks
 
-	if(iTrkN2==iTrkP1 || iTrkN2==iTrkP2 || iTrkN2==iTrkN1) continue;
+    twoTrackArray2->Clear();
 
-	//if(iTrkN2%1==0) AliDebug(1,Form("    2nd loop on neg: track number %d of %d",iTrkN2,nSeleTrks));
+    // 2nd LOOP  ON  NEGATIVE  TRACKS (for 3 prong -+-)
+    for(iTrkN2=iTrkN1+1; iTrkN2<nSeleTrks; iTrkN2++) {
 
-	// get track from tracks array
-	negtrack2 = (AliESDtrack*)seleTrksArray.UncheckedAt(iTrkN2);
+      if(iTrkN2==iTrkP1 || iTrkN2==iTrkP2 || iTrkN2==iTrkN1) continue;
 
-	if(negtrack2->Charge()>0) continue;
+      // get track from tracks array
+      negtrack2 = (AliESDtrack*)seleTrksArray.UncheckedAt(iTrkN2);
 
-	if(!TESTBIT(seleFlags[iTrkN2],kBitDispl)) continue;
+      if(negtrack2->Charge()>0) continue;
 
-	// Check single tracks cuts specific for 3 prongs
-	if(!TESTBIT(seleFlags[iTrkN2],kBit3Prong)) continue;
-	if(!TESTBIT(seleFlags[iTrkP1],kBit3Prong)) continue;
-	if(!TESTBIT(seleFlags[iTrkN1],kBit3Prong)) continue;
+      if(!TESTBIT(seleFlags[iTrkN2],kBitDispl)) continue;
 
-	if(fMixEvent) {
-	  if(evtNumber[iTrkP1]==evtNumber[iTrkN2] ||
-	     evtNumber[iTrkN1]==evtNumber[iTrkN2] ||
-	     evtNumber[iTrkP1]==evtNumber[iTrkN1]) continue;
-	}
+      // Check single tracks cuts specific for 3 prongs
+      if(!TESTBIT(seleFlags[iTrkN2],kBit3Prong)) continue;
+      if(!TESTBIT(seleFlags[iTrkP1],kBit3Prong)) continue;
+      if(!TESTBIT(seleFlags[iTrkN1],kBit3Prong)) continue;
 
-	if(isLikeSign2Prong) { // like-sign pair -> have to build only like-sign triplet
-	  if(!fLikeSign3prong) continue;
-	  if(postrack1->Charge()<0) { // ok: like-sign triplet (---)
-	    isLikeSign3Prong=kTRUE;
-	  } else { // not ok
-	    continue;
-	  }
-	} else { // normal triplet (-+-)
-	  isLikeSign3Prong=kFALSE;
+      if(fMixEvent) {
+	if(evtNumber[iTrkP1]==evtNumber[iTrkN2] ||
+	   evtNumber[iTrkN1]==evtNumber[iTrkN2] ||
+	   evtNumber[iTrkP1]==evtNumber[iTrkN1]) continue;
+      }
+
+      if(isLikeSign2Prong) { // like-sign pair -> have to build only like-sign triplet
+	if(!fLikeSign3prong) continue;
+	if(postrack1->Charge()<0) { // ok: like-sign triplet (---)
+	  isLikeSign3Prong=kTRUE;
+	} else { // not ok
+	  continue;
 	}
+      } else { // normal triplet (-+-)
+	isLikeSign3Prong=kFALSE;
+      }
 
-	if(fUseKaonPIDfor3Prong){
-	  if(!TESTBIT(seleFlags[iTrkP1],kBitKaonCompat)) continue;
+      if(fUseKaonPIDfor3Prong){
+	if(!TESTBIT(seleFlags[iTrkP1],kBitKaonCompat)) continue;
+      }
+      Bool_t okForLcTopKpi=kTRUE;
+      Int_t pidLcStatus=3; // 3= OK as pKpi and Kpipi
+      if(fUsePIDforLc>0){
+	if(!TESTBIT(seleFlags[iTrkN1],kBitProtonCompat) &&
+	   !TESTBIT(seleFlags[iTrkN2],kBitProtonCompat) ){
+	  okForLcTopKpi=kFALSE;
+	  pidLcStatus=0;
 	}
-	Bool_t okForLcTopKpi=kTRUE;
-	Int_t pidLcStatus=3; // 3= OK as pKpi and Kpipi
-	if(fUsePIDforLc>0){
-	  if(!TESTBIT(seleFlags[iTrkN1],kBitProtonCompat) &&
-	     !TESTBIT(seleFlags[iTrkN2],kBitProtonCompat) ){
-	    okForLcTopKpi=kFALSE;
-	    pidLcStatus=0;
+	if(okForLcTopKpi && fUsePIDforLc>1){
+	  okForLcTopKpi=kFALSE;
+	  pidLcStatus=0;
+	  if(TESTBIT(seleFlags[iTrkN1],kBitProtonCompat) &&
+	     TESTBIT(seleFlags[iTrkN2],kBitPionCompat) ){
+	    okForLcTopKpi=kTRUE;
+	    pidLcStatus+=1; // 1= OK as pKpi
 	  }
-	  if(okForLcTopKpi && fUsePIDforLc>1){
-	    okForLcTopKpi=kFALSE;
-	    pidLcStatus=0;
-	    if(TESTBIT(seleFlags[iTrkN1],kBitProtonCompat) &&
-	       TESTBIT(seleFlags[iTrkN2],kBitPionCompat) ){
-	      okForLcTopKpi=kTRUE;
-	      pidLcStatus+=1; // 1= OK as pKpi
-	    }
-	    if(TESTBIT(seleFlags[iTrkN2],kBitProtonCompat) &&
-	       TESTBIT(seleFlags[iTrkN1],kBitPionCompat) ){
-	      okForLcTopKpi=kTRUE;
-	      pidLcStatus+=2; // 2= OK as piKp
-	    }
+	  if(TESTBIT(seleFlags[iTrkN2],kBitProtonCompat) &&
+	     TESTBIT(seleFlags[iTrkN1],kBitPionCompat) ){
+	    okForLcTopKpi=kTRUE;
+	    pidLcStatus+=2; // 2= OK as piKp
 	  }
 	}
-	Bool_t okForDsToKKpi=kTRUE;
-	if(fUseKaonPIDforDs){
-	  if(!TESTBIT(seleFlags[iTrkN1],kBitKaonCompat) &&
-	     !TESTBIT(seleFlags[iTrkN2],kBitKaonCompat) ) okForDsToKKpi=kFALSE;
-	}
-
-	// back to primary vertex
-	// postrack1->PropagateToDCA(fV1,fBzkG,kVeryBig);
-	// negtrack1->PropagateToDCA(fV1,fBzkG,kVeryBig);
-	// negtrack2->PropagateToDCA(fV1,fBzkG,kVeryBig);
-	SetParametersAtVertex(postrack1,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkP1));
-	SetParametersAtVertex(negtrack1,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkN1));
-	SetParametersAtVertex(negtrack2,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkN2));
-	//printf("********** %d %d %d\n",postrack1->GetID(),negtrack1->GetID(),negtrack2->GetID());
-
-	dcap1n2 = postrack1->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
-	if(dcap1n2>dcaMax) { negtrack2=0; continue; }
-	dcan1n2 = negtrack1->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
-	if(dcan1n2>dcaMax) { negtrack2=0; continue; }
-
-	threeTrackArray->AddAt(negtrack1,0);
-	threeTrackArray->AddAt(postrack1,1);
-	threeTrackArray->AddAt(negtrack2,2);
-
-	// check invariant mass cuts for D+,Ds,Lc
-        massCutOK=kTRUE;
-	if(fMassCutBeforeVertexing && f3Prong){
-	  negtrack2->GetPxPyPz(momneg2);
-	  Double_t pxDau[3]={momneg1[0],mompos1[0],momneg2[0]};
-	  Double_t pyDau[3]={momneg1[1],mompos1[1],momneg2[1]};
-	  Double_t pzDau[3]={momneg1[2],mompos1[2],momneg2[2]};
-	  //	  massCutOK = SelectInvMassAndPt3prong(threeTrackArray);
-	  massCutOK = SelectInvMassAndPt3prong(pxDau,pyDau,pzDau,pidLcStatus);
-	}
-	if(!massCutOK) {
-	  threeTrackArray->Clear();
-	  negtrack2=0;
-	  continue;
-	}
-
-	// Vertexing
-	twoTrackArray2->AddAt(postrack1,0);
-	twoTrackArray2->AddAt(negtrack2,1);
-
-	AliAODVertex *vertexp1n2 = ReconstructSecondaryVertex(twoTrackArray2,dispersion);
-	if(!vertexp1n2) {
-	  twoTrackArray2->Clear();
-	  negtrack2=0;
-	  continue;
-	}
+      }
+      Bool_t okForDsToKKpi=kTRUE;
+      if(fUseKaonPIDforDs){
+	if(!TESTBIT(seleFlags[iTrkN1],kBitKaonCompat) &&
+	   !TESTBIT(seleFlags[iTrkN2],kBitKaonCompat) ) okForDsToKKpi=kFALSE;
+      }
 
-	if(f3Prong) {
-	  AliAODVertex* secVert3PrAOD = ReconstructSecondaryVertex(threeTrackArray,dispersion);
-	  io3Prong = Make3Prong(threeTrackArray,event,secVert3PrAOD,dispersion,vertexp1n1,vertexp1n2,dcap1n1,dcap1n2,dcan1n2,okForLcTopKpi,okForDsToKKpi,ok3Prong);
-	  if(ok3Prong) {
-	    AliAODVertex *v3Prong = 0x0;
-            if(!fMakeReducedRHF) v3Prong = new(verticesHFRef[iVerticesHF++])AliAODVertex(*secVert3PrAOD);
-	    if(!isLikeSign3Prong) {
-	      rd = new(aodCharm3ProngRef[i3Prong++])AliAODRecoDecayHF3Prong(*io3Prong);
-	      SetSelectionBitForPID(fCutsDplustoKpipi,rd,AliRDHFCuts::kDplusPID);
-	      SetSelectionBitForPID(fCutsDstoKKpi,rd,AliRDHFCuts::kDsPID);
-	      SetSelectionBitForPID(fCutsLctopKpi,rd,AliRDHFCuts::kLcPID);
-	      if(fMakeReducedRHF){
-		rd->SetPrimaryVtxRef((AliAODVertex*)event->GetPrimaryVertex());
-                ((AliAODRecoDecayHF3Prong*)rd)->DeleteRecoD();
-	      }else{
-		rd->SetSecondaryVtx(v3Prong);
-		v3Prong->SetParent(rd);
-		AddRefs(v3Prong,rd,event,threeTrackArray);
-              }
-	    } else { // isLikeSign3Prong
-	      if(fLikeSign3prong){
-		rd = new(aodLikeSign3ProngRef[iLikeSign3Prong++])AliAODRecoDecayHF3Prong(*io3Prong);
-	        SetSelectionBitForPID(fCutsDplustoKpipi,rd,AliRDHFCuts::kDplusPID);
-	        SetSelectionBitForPID(fCutsDstoKKpi,rd,AliRDHFCuts::kDsPID);
-	        SetSelectionBitForPID(fCutsLctopKpi,rd,AliRDHFCuts::kLcPID);
-	        if(fMakeReducedRHF){
-		  rd->SetPrimaryVtxRef((AliAODVertex*)event->GetPrimaryVertex());
-                  ((AliAODRecoDecayHF3Prong*)rd)->DeleteRecoD();
-	        }else{
-                  rd->SetSecondaryVtx(v3Prong);
-                  v3Prong->SetParent(rd);
-                  AddRefs(v3Prong,rd,event,threeTrackArray);
-		}
-	      }
+      // pre-selection with the transverse circles of the tracks
+      fnCombinations[kTripletTried]++;
+      if(IsPairRejected(iTrkP1,iTrkN2,dcaMax) || IsPairRejected(iTrkN1,iTrkN2,dcaMax) ||
+	 IsBelowMinPt(minPt3Prong,iTrkP1,iTrkN1,iTrkN2)) {
+	fnCombinations[kTripletPreselRej]++;
+	negtrack2=0;
+	continue;
+      }
 
-	    }
-	  }
-	  if(io3Prong) {delete io3Prong; io3Prong=NULL;}
-	  if(secVert3PrAOD) {delete secVert3PrAOD; secVert3PrAOD=NULL;}
-	}
+      // back to primary vertex
+      SetParametersAtVertex(postrack1,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkP1));
+      SetParametersAtVertex(negtrack1,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkN1));
+      SetParametersAtVertex(negtrack2,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkN2));
+
+      dcap1n2 = postrack1->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
+      if(dcap1n2>dcaMax) { fnCombinations[kTripletDCARej]++; negtrack2=0; continue; }
+      dcan1n2 = negtrack1->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
+      if(dcan1n2>dcaMax) { fnCombinations[kTripletDCARej]++; negtrack2=0; continue; }
+
+      threeTrackArray->AddAt(negtrack1,0);
+      threeTrackArray->AddAt(postrack1,1);
+      threeTrackArray->AddAt(negtrack2,2);
+
+      // check invariant mass cuts for D+,Ds,Lc
+      massCutOK=kTRUE;
+      if(fMassCutBeforeVertexing && f3Prong){
+	negtrack2->GetPxPyPz(momneg2);
+	Double_t pxDau[3]={momneg1[0],mompos1[0],momneg2[0]};
+	Double_t pyDau[3]={momneg1[1],mompos1[1],momneg2[1]};
+	Double_t pzDau[3]={momneg1[2],mompos1[2],momneg2[2]};
+	//	  massCutOK = SelectInvMassAndPt3prong(threeTrackArray);
+	massCutOK = SelectInvMassAndPt3prong(pxDau,pyDau,pzDau,pidLcStatus);
+      }
+      if(!massCutOK) {
+	fnCombinations[kTripletMassRej]++;
 	threeTrackArray->Clear();
-	negtrack2 = 0;
-	delete vertexp1n2;
+	negtrack2=0;
+	continue;
+      }
 
-      } // end 2nd loop on negative tracks
+      // Vertexing
+      twoTrackArray2->AddAt(postrack1,0);
+      twoTrackArray2->AddAt(negtrack2,1);
+
+      AliAODVertex *vertexp1n2 = ReconstructSecondaryVertex(twoTrackArray2,dispersion);
+      if(!vertexp1n2) {
+	fnCombinations[kTripletVtxRej]++;
+	twoTrackArray2->Clear();
+	negtrack2=0;
+	continue;
+      }
 
-      twoTrackArray2->Clear();
+      if(f3Prong) {
+	AliAODVertex* secVert3PrAOD = ReconstructSecondaryVertex(threeTrackArray,dispersion);
+	io3Prong = Make3Prong(threeTrackArray,event,secVert3PrAOD,dispersion,vertexp1n1,vertexp1n2,dcap1n1,dcap1n2,dcan1n2,okForLcTopKpi,okForDsToKKpi,ok3Prong);
+	if(ok3Prong) {
+	  fnCombinations[kTripletCand]++;
+	  cand.fNProngs = 3;
+	  cand.fTrk[0] = iTrkN1; cand.fTrk[1] = iTrkP1; cand.fTrk[2] = iTrkN2; cand.fTrk[3] = -1;
+	  cand.fLikeSign = isLikeSign3Prong;
+	  cand.fOKD0 = cand.fOKJPSI = cand.fOKD0fromDstar = kFALSE;
+	  cand.fRecoDecay = io3Prong; io3Prong=NULL;
+	  cand.fVertex = secVert3PrAOD; secVert3PrAOD=NULL;
+	  cands.push_back(cand);
+	}
+	if(io3Prong) {delete io3Prong; io3Prong=NULL;}
+	if(secVert3PrAOD) {delete secVert3PrAOD; secVert3PrAOD=NULL;}
+      }
+      threeTrackArray->Clear();
+      negtrack2 = 0;
+      delete vertexp1n2;
 
-      negtrack1 = 0;
-      delete vertexp1n1;
-    } // end 1st loop on negative tracks
+    } // end 2nd loop on negative tracks
 
-    postrack1 = 0;
- }  // end 1st loop on positive tracks
+    twoTrackArray2->Clear();
 
+    negtrack1 = 0;
+    delete vertexp1n1;
+  } // end 1st loop on negative tracks
 
-  //  AliDebug(1,Form(" Total HF vertices in event = %d;",
-  //		  (Int_t)aodVerticesHFTClArr->GetEntriesFast()));
-  if(fD0toKpi) {
-    AliDebug(1,Form(" D0->Kpi in event = %d;",
-		    (Int_t)aodD0toKpiTClArr->GetEntriesFast()));
-  }
-  if(fJPSItoEle) {
-    AliDebug(1,Form(" JPSI->ee in event = %d;",
-		    (Int_t)aodJPSItoEleTClArr->GetEntriesFast()));
-  }
-  if(f3Prong) {
-    AliDebug(1,Form(" Charm->3Prong in event = %d;",
-		    (Int_t)aodCharm3ProngTClArr->GetEntriesFast()));
-  }
-  if(f4Prong) {
-    AliDebug(1,Form(" Charm->4Prong in event = %d;\n",
-		    (Int_t)aodCharm4ProngTClArr->GetEntriesFast()));
-  }
-  if(fDstar) {
-    AliDebug(1,Form(" D*->D0pi in event = %d;\n",
-		    (Int_t)aodDstarTClArr->GetEntriesFast()));
-  }
-  if(fCascades){
-    AliDebug(1,Form(" cascades -> v0 + track in event = %d;\n",
-		    (Int_t)aodCascadesTClArr->GetEntriesFast()));
-  }
-  if(fLikeSign) {
-    AliDebug(1,Form(" Like-sign 2Prong in event = %d;\n",
-		    (Int_t)aodLikeSign2ProngTClArr->GetEntriesFast()));
-  }
-  if(fLikeSign3prong && f3Prong) {
-    AliDebug(1,Form(" Like-sign 3Prong in event = %d;\n",
-		    (Int_t)aodLikeSign3ProngTClArr->GetEntriesFast()));
-  }
-
-
-  twoTrackArray1->Delete();  delete twoTrackArray1;
-  twoTrackArray2->Delete();  delete twoTrackArray2;
-  twoTrackArrayCasc->Delete();  delete twoTrackArrayCasc;
-  twoTrackArrayV0->Delete();  delete twoTrackArrayV0;
+  delete twoTrackArray1;
+  delete twoTrackArray2;
   threeTrackArray->Clear();
-  threeTrackArray->Delete(); delete threeTrackArray;
-  fourTrackArray->Delete();  delete fourTrackArray;
-  delete [] seleFlags; seleFlags=NULL;
-  if(evtNumber) {delete [] evtNumber; evtNumber=NULL;}
-  tracksAtVertex.Delete();
-
-  if(fInputAOD) {
-    seleTrksArray.Delete();
-    if(fAODMap) { delete [] fAODMap; fAODMap=NULL; }
-  }
-
-
-  //printf("Trks: total %d  sele %d\n",fnTrksTotal,fnSeleTrksTotal);
+  delete threeTrackArray;
+  delete fourTrackArray;
 
   return;
 }
@@ -1588,9 +1715,12 @@ void AliAnalysisVertexingHF::AddDaughterRefs(AliAODVertex *v,
                                              const AliVEvent *event,
                                              const TObjArray *trkArray) const
 {
-  /// Add the AOD tracks as daughters of the vertex (TRef)
+  /// Add the AOD tracks as daughters of the vertex (TRef).
+  /// Locked against the threads of the candidate loops, which share the AOD tracks
   //AliCodeTimerAuto("",0);
 
+  SharedObjectsLock lock(gSharedObjectsMutex);
+
   Int_t nDg = v->GetNDaughters();
   TObject *dg = 0;
   if(nDg) dg = v->GetDaughter(0);
@@ -2347,6 +2477,9 @@ AliAODRecoDecayHF2Prong *AliAnalysisVertexingHF::Make2Prong(
     // Add daughter references already here
     if(fInputAOD) AddDaughterRefs(secVert,(AliAODEvent*)event,twoTrackArray);
 
+    // candidate selection, locked against the other threads of the candidate loops
+    SharedObjectsLock lock(gSharedObjectsMutex);
+
     // select D0->Kpi
     if(fD0toKpi)   {
       okD0 = (Bool_t)fCutsD0toKpi->IsSelected(the2Prong,AliRDHFCuts::kCandidate,(AliAODEvent*)event);
@@ -2489,6 +2622,8 @@ AliAODRecoDecayHF3Prong* AliAnalysisVertexingHF::Make3Prong(
   // select D+->Kpipi, Ds->KKpi, Lc->pKpi
   if(f3Prong) {
     ok3Prong = kFALSE;
+    // locked against the other threads of the candidate loops
+    SharedObjectsLock lock(gSharedObjectsMutex);
 
     if(fOKInvMassDplus && fCutsDplustoKpipi->IsSelected(the3Prong,AliRDHFCuts::kCandidate,(AliAODEvent*)event)) {
       ok3Prong = kTRUE;
@@ -2718,7 +2853,11 @@ AliAODRecoDecayHF4Prong* AliAnalysisVertexingHF::Make4Prong(
 
   delete primVertexAOD; primVertexAOD=NULL;
 
-  ok4Prong=(Bool_t)fCutsD0toKpipipi->IsSelected(the4Prong,AliRDHFCuts::kCandidate);
+  {
+    // locked against the other threads of the candidate loops
+    SharedObjectsLock lock(gSharedObjectsMutex);
+    ok4Prong=(Bool_t)fCutsD0toKpipipi->IsSelected(the4Prong,AliRDHFCuts::kCandidate);
+  }
 
 
   if(!fRecoPrimVtxSkippingTrks && !fRmTrksFromPrimVtx && !fMixEvent) {
@@ -2937,6 +3076,17 @@ void AliAnalysisVertexingHF::PrintStatus() const {
     printf("  Ds -> K0s K cuts:\n");
     if(fCutsDstoK0sK) fCutsDstoK0sK->PrintAll();
   }
+  if(fNThreads>1) printf("2-, 3- and 4-prong loops run with %d threads\n",fNThreads);
+  if(fUsePairPreselection) printf("Pre-selection of pairs and triplets with the transverse circles of the tracks\n");
+  if(fnCombinations[kPairTried]>0) {
+    printf("Combinations after %d tracks (%d selected):\n",fnTrksTotal,fnSeleTrksTotal);
+    printf("  pairs:    tried %lld, rejected by pre-selection %lld, by DCA %lld, by vertexing %lld; 2-prong candidates %lld\n",
+	   fnCombinations[kPairTried],fnCombinations[kPairPreselRej],fnCombinations[kPairDCARej],
+	   fnCombinations[kPairVtxRej],fnCombinations[kPairCand]);
+    printf("  triplets: tried %lld, rejected by pre-selection %lld, by DCA %lld, by mass %lld, by vertexing %lld; 3-prong candidates %lld\n",
+	   fnCombinations[kTripletTried],fnCombinations[kTripletPreselRej],fnCombinations[kTripletDCARej],
+	   fnCombinations[kTripletMassRej],fnCombinations[kTripletVtxRej],fnCombinations[kTripletCand]);
+  }
 
   return;
 }
@@ -3697,6 +3847,298 @@ void AliAnalysisVertexingHF::SetParametersAtVertex(AliESDtrack* esdt, const AliE
   return;
 }
 //-----------------------------------------------------------------------------
+Bool_t AliAnalysisVertexingHF::SetupCutsForEvent(AliVEvent *event){
+  /// Event selection and PID configuration of the cuts objects
+
+  if(!fCutsD0toKpi->IsEventSelected(event)) return kFALSE;
+  if(fCutsJpsitoee) fCutsJpsitoee->SetupPID(event);
+  if(fCutsDplustoK0spi) fCutsDplustoK0spi->SetupPID(event);
+  if(fCutsDplustoKpipi) fCutsDplustoKpipi->SetupPID(event);
+  if(fCutsDstoK0sK) fCutsDstoK0sK->SetupPID(event);
+  if(fCutsDstoKKpi) fCutsDstoKKpi->SetupPID(event);
+  if(fCutsLctopKpi) fCutsLctopKpi->SetupPID(event);
+  if(fCutsLctoV0) fCutsLctoV0->SetupPID(event);
+  if(fCutsD0toKpipipi) fCutsD0toKpipipi->SetupPID(event);
+  if(fCutsDStartoKpipi) fCutsDStartoKpipi->SetupPID(event);
+  return kTRUE;
+}
+//-----------------------------------------------------------------------------
+AliAnalysisVertexingHF* AliAnalysisVertexingHF::CreateWorker() const {
+  /// Copy of this object for one thread of the candidate loops: it has its
+  /// own vertexer, cuts and mass calculators, the track filters and the
+  /// list of cuts are not needed. The primary vertex, the AOD map and the
+  /// pre-selection table are shared with the master for each event.
+
+  AliAnalysisVertexingHF *worker = new AliAnalysisVertexingHF(*this);
+  worker->fNThreads = 1;
+  worker->fVertexerTracks = new AliVertexerTracks(fBzkG);
+  worker->fV1 = 0;
+  worker->fAODMapSize = 0;
+  worker->fAODMap = 0;
+  worker->fTrackFilter = 0;
+  worker->fTrackFilter2prongCentral = 0;
+  worker->fTrackFilter3prongCentral = 0;
+  worker->fTrackFilterSoftPi = 0;
+  worker->fTrackFilterBachelor = 0;
+  worker->fListOfCuts = 0;
+  worker->fCutsD0toKpi = fCutsD0toKpi ? (AliRDHFCutsD0toKpi*)fCutsD0toKpi->Clone() : 0;
+  worker->fCutsJpsitoee = fCutsJpsitoee ? (AliRDHFCutsJpsitoee*)fCutsJpsitoee->Clone() : 0;
+  worker->fCutsDplustoK0spi = fCutsDplustoK0spi ? (AliRDHFCutsDplustoK0spi*)fCutsDplustoK0spi->Clone() : 0;
+  worker->fCutsDplustoKpipi = fCutsDplustoKpipi ? (AliRDHFCutsDplustoKpipi*)fCutsDplustoKpipi->Clone() : 0;
+  worker->fCutsDstoK0sK = fCutsDstoK0sK ? (AliRDHFCutsDstoK0sK*)fCutsDstoK0sK->Clone() : 0;
+  worker->fCutsDstoKKpi = fCutsDstoKKpi ? (AliRDHFCutsDstoKKpi*)fCutsDstoKKpi->Clone() : 0;
+  worker->fCutsLctopKpi = fCutsLctopKpi ? (AliRDHFCutsLctopKpi*)fCutsLctopKpi->Clone() : 0;
+  worker->fCutsLctoV0 = fCutsLctoV0 ? (AliRDHFCutsLctoV0*)fCutsLctoV0->Clone() : 0;
+  worker->fCutsD0toKpipipi = fCutsD0toKpipipi ? (AliRDHFCutsD0toKpipipi*)fCutsD0toKpipipi->Clone() : 0;
+  worker->fCutsDStartoKpipi = fCutsDStartoKpipi ? (AliRDHFCutsDStartoKpipi*)fCutsDStartoKpipi->Clone() : 0;
+  Double_t d02[2]={0.,0.};
+  Double_t d03[3]={0.,0.,0.};
+  Double_t d04[4]={0.,0.,0.,0.};
+  worker->fMassCalc2 = new AliAODRecoDecay(0x0,2,0,d02);
+  worker->fMassCalc3 = new AliAODRecoDecay(0x0,3,1,d03);
+  worker->fMassCalc4 = new AliAODRecoDecay(0x0,4,0,d04);
+  worker->fTrkPreselSize = 0;
+  worker->fTrkPreselNTrks = 0;
+  worker->fTrkPresel = 0;
+  return worker;
+}
+//-----------------------------------------------------------------------------
+Bool_t AliAnalysisVertexingHF::FindCandidatesParallel(AliVEvent *event,
+						      const TObjArray &seleTrksArray,
+						      const TObjArray &tracksAtVertex,
+						      Int_t nSeleTrks,const UChar_t *seleFlags,
+						      const Int_t *evtNumber,Float_t dcaMax,
+						      Double_t minPtPair,Double_t minPt3Prong,
+						      std::vector< std::vector<CandidateRecord> > &candsPerTrk){
+  /// Run the 2-, 3- and 4-prong loops of all the positive tracks with
+  /// fNThreads copies of this object (see CreateWorker). The positive tracks
+  /// are interleaved among the threads and the candidates are returned per
+  /// positive track, so that FindCandidates stores them in the same order
+  /// whatever the scheduling. Returns kFALSE (serial loops) if the
+  /// configuration needs state that cannot be duplicated per thread.
+  /// Inside the threads, the track propagation, the vertexing and the mass
+  /// cuts only use the worker's own objects and read the shared primary
+  /// vertex, AOD map and pre-selection table. The candidate selection of
+  /// the cuts objects (shared PID response, event) and the TRefs to the AOD
+  /// tracks (AddDaughterRefs) are serialized with gSharedObjectsMutex; the
+  /// TRefs created with the candidates rely on the locking of TProcessID
+  /// enabled by ROOT::EnableThreadSafety.
+
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,6,0)
+  if(fNThreads<2 || nSeleTrks<2) return kFALSE;
+  // AliKFParticle keeps the field in a static member, and the primary
+  // vertex refits on the fly are done on the shared primary vertex
+  if(fSecVtxWithKF || fRecoPrimVtxSkippingTrks || fRmTrksFromPrimVtx) return kFALSE;
+
+  if(fWorkers && fWorkers->GetEntriesFast()!=fNThreads) { delete fWorkers; fWorkers=0; }
+  if(!fWorkers) {
+    ROOT::EnableThreadSafety();
+    fWorkers = new TObjArray(fNThreads);
+    fWorkers->SetOwner();
+    for(Int_t ith=0; ith<fNThreads; ith++) fWorkers->AddAt(CreateWorker(),ith);
+  }
+
+  for(Int_t ith=0; ith<fNThreads; ith++) {
+    AliAnalysisVertexingHF *worker = (AliAnalysisVertexingHF*)fWorkers->UncheckedAt(ith);
+    worker->fInputAOD = fInputAOD;
+    worker->fMixEvent = fMixEvent;
+    worker->fBzkG = fBzkG;
+    if(worker->fVertexerTracks->GetFieldkG()!=fBzkG) worker->fVertexerTracks->SetFieldkG(fBzkG);
+    worker->fV1 = fV1;
+    worker->fAODMapSize = fAODMapSize;
+    worker->fAODMap = fAODMap;
+    worker->fTrkPreselSize = fTrkPreselSize;
+    worker->fTrkPreselNTrks = fTrkPreselNTrks;
+    worker->fTrkPresel = fTrkPresel;
+    worker->SetupCutsForEvent(event);
+  }
+
+  // the candidates of the threads refer to the AOD tracks: give them their
+  // unique ID here, in track order, so that the output does not depend on
+  // which thread references them first
+  if(fInputAOD) {
+    for(Int_t i=0; i<nSeleTrks; i++) {
+      if(!TESTBIT(seleFlags[i],kBitDispl)) continue;
+      Int_t id = (Int_t)((AliESDtrack*)seleTrksArray.UncheckedAt(i))->GetID();
+      if(id<0) continue;
+      TObject *aodTrack = event->GetTrack(fAODMap[id]);
+      if(aodTrack) TProcessID::AssignID(aodTrack);
+    }
+  }
+
+  candsPerTrk.assign(nSeleTrks,std::vector<CandidateRecord>());
+  std::vector<std::thread> threads;
+  for(Int_t ith=0; ith<fNThreads; ith++) {
+    threads.push_back(std::thread(&AliAnalysisVertexingHF::FindCandidatesInThread,
+				  (AliAnalysisVertexingHF*)fWorkers->UncheckedAt(ith),
+				  ith,fNThreads,event,&seleTrksArray,&tracksAtVertex,nSeleTrks,
+				  seleFlags,evtNumber,dcaMax,minPtPair,minPt3Prong,&candsPerTrk));
+  }
+  for(UInt_t ith=0; ith<threads.size(); ith++) threads[ith].join();
+
+  for(Int_t ith=0; ith<fNThreads; ith++) {
+    AliAnalysisVertexingHF *worker = (AliAnalysisVertexingHF*)fWorkers->UncheckedAt(ith);
+    for(Int_t i=0; i<kNCombStages; i++) {
+      fnCombinations[i] += worker->fnCombinations[i];
+      worker->fnCombinations[i] = 0;
+    }
+    // owned by the master
+    worker->fV1 = 0;
+    worker->fAODMapSize = 0;
+    worker->fAODMap = 0;
+    worker->fTrkPreselSize = 0;
+    worker->fTrkPreselNTrks = 0;
+    worker->fTrkPresel = 0;
+  }
+  return kTRUE;
+#else
+  return kFALSE;
+#endif
+}
+//-----------------------------------------------------------------------------
+void AliAnalysisVertexingHF::FindCandidatesInThread(Int_t firstTrk,Int_t trkStep,
+						    AliVEvent *event,
+						    const TObjArray *seleTrksArray,
+						    const TObjArray *tracksAtVertex,
+						    Int_t nSeleTrks,const UChar_t *seleFlags,
+						    const Int_t *evtNumber,Float_t dcaMax,
+						    Double_t minPtPair,Double_t minPt3Prong,
+						    std::vector< std::vector<CandidateRecord> > *candsPerTrk){
+  /// Candidate loops of the positive tracks firstTrk, firstTrk+trkStep, ...
+  /// on private copies of the selected tracks (they are moved to the
+  /// secondary vertices during the loops)
+
+  TObjArray trks(nSeleTrks);
+  for(Int_t i=0; i<nSeleTrks; i++) trks.AddAt(new AliESDtrack(*(AliESDtrack*)seleTrksArray->UncheckedAt(i)),i);
+
+  for(Int_t iTrkP1=firstTrk; iTrkP1<nSeleTrks; iTrkP1+=trkStep) {
+    if(!TESTBIT(seleFlags[iTrkP1],kBitDispl)) continue;
+    if(((AliESDtrack*)trks.UncheckedAt(iTrkP1))->Charge()<0 && !fLikeSign) continue;
+    FindCandidatesForTrack(iTrkP1,event,trks,*tracksAtVertex,nSeleTrks,seleFlags,evtNumber,
+			   dcaMax,minPtPair,minPt3Prong,(*candsPerTrk)[iTrkP1]);
+  }
+
+  trks.Delete();
+  return;
+}
+//-----------------------------------------------------------------------------
+void AliAnalysisVertexingHF::FillPreselectionInfo(const TObjArray *tracksAtVertex,
+						  Int_t nSeleTrks){
+  /// Store, for each selected track, what the pair pre-selection needs:
+  /// centre and radius of the track circle in the transverse plane (radius 0
+  /// for straight tracks), position errors at the primary vertex and pt
+
+  Int_t size=nSeleTrks*kNPreselPars;
+  if(size>fTrkPreselSize) {
+    delete [] fTrkPresel;
+    fTrkPresel = new Double_t[size];
+    fTrkPreselSize = size;
+  }
+
+  Double_t xyz[3],pxpypz[3];
+  for(Int_t i=0; i<nSeleTrks; i++) {
+    const AliExternalTrackParam *par=(const AliExternalTrackParam*)tracksAtVertex->UncheckedAt(i);
+    Double_t *trk=&fTrkPresel[i*kNPreselPars];
+    par->GetXYZ(xyz);
+    par->GetPxPyPz(pxpypz);
+    Double_t ptDir=TMath::Sqrt(pxpypz[0]*pxpypz[0]+pxpypz[1]*pxpypz[1]);
+    // signed curvature: the direction turns counter-clockwise for crv>0,
+    // the centre is on the left of the direction of flight
+    Double_t crv=par->GetC(fBzkG);
+    if(ptDir<=0. || TMath::Abs(crv)<1.e-9) {
+      trk[kPreselXc]=trk[kPreselYc]=trk[kPreselR]=0.;
+    } else {
+      trk[kPreselXc]=xyz[0]-pxpypz[1]/ptDir/crv;
+      trk[kPreselYc]=xyz[1]+pxpypz[0]/ptDir/crv;
+      trk[kPreselR]=1./TMath::Abs(crv);
+    }
+    trk[kPreselSigmaY2]=par->GetSigmaY2();
+    trk[kPreselSigmaZ2]=par->GetSigmaZ2();
+    trk[kPreselPt]=par->Pt();
+  }
+  fTrkPreselNTrks=nSeleTrks;
+  return;
+}
+//-----------------------------------------------------------------------------
+void AliAnalysisVertexingHF::GetPreselectionMinPt(Double_t &minPtPair,
+						  Double_t &minPt3Prong) const {
+  /// Lowest candidate pt that a pair (triplet) can lead to, from the pt cuts
+  /// of SelectInvMassAndPt*: 0 if there is no such cut. The pairs also feed
+  /// the 3 and 4 prong loops, so minPtPair is set only when those are off.
+
+  minPtPair=0.;
+  minPt3Prong=0.;
+  if(f3Prong) {
+    Double_t minPt=TMath::Min(fCutsDplustoKpipi->GetMinPtCandidate(),fCutsDstoKKpi->GetMinPtCandidate());
+    minPt=TMath::Min(minPt,fCutsLctopKpi->GetMinPtCandidate());
+    if(minPt>0.1) minPt3Prong=minPt;
+  }
+  if(!f3Prong && !f4Prong) {
+    // Make2Prong keeps the pair if any of these mass/pt selections is passed
+    const Int_t kNChannels=4;
+    Bool_t isOn[kNChannels]={fD0toKpi,fJPSItoEle,fDstar,fCascades};
+    AliRDHFCuts *cuts[kNChannels]={fCutsD0toKpi,fCutsJpsitoee,fCutsDStartoKpipi,fCutsLctoV0};
+    Bool_t first=kTRUE;
+    for(Int_t ich=0; ich<kNChannels; ich++) {
+      if(!isOn[ich]) continue;
+      Double_t minPt=0.;
+      if(cuts[ich] && cuts[ich]->GetMinPtCandidate()>0.1) minPt=cuts[ich]->GetMinPtCandidate();
+      minPtPair = first ? minPt : TMath::Min(minPtPair,minPt);
+      first=kFALSE;
+    }
+  }
+  return;
+}
+//-----------------------------------------------------------------------------
+Bool_t AliAnalysisVertexingHF::IsPairRejected(Int_t iTrk1,Int_t iTrk2,Double_t dcaCut) const {
+  /// Pre-selection of a pair of selected tracks, before their DCA is computed:
+  /// kTRUE only if the DCA returned by AliExternalTrackParam::GetDCA is
+  /// above dcaCut for sure.
+  /// GetDCA returns the distance of two points of the helices, with the
+  /// transverse distance weighted by (sigmaZ2/sigmaY2)^(1/4) and the
+  /// longitudinal one by the inverse; its minimisation can end anywhere on
+  /// the helices. A lower limit is thus the weighted distance of the
+  /// transverse circles of the tracks, which does not depend on where the
+  /// minimisation ends. The longitudinal distance is not used: over the
+  /// full helices z takes any value.
+  /// For the same reason the tracks are not binned in phi, eta or sign of
+  /// the impact parameter: no cut on these is safe for all pairs of points.
+
+  if(fTrkPreselNTrks<=0) return kFALSE;
+  const Double_t *trk1=&fTrkPresel[iTrk1*kNPreselPars];
+  const Double_t *trk2=&fTrkPresel[iTrk2*kNPreselPars];
+  Double_t r1=trk1[kPreselR];
+  Double_t r2=trk2[kPreselR];
+  if(r1<=0. || r2<=0.) return kFALSE; // straight tracks: the lines cross
+
+  Double_t sigmaY2=trk1[kPreselSigmaY2]+trk2[kPreselSigmaY2];
+  Double_t sigmaZ2=trk1[kPreselSigmaZ2]+trk2[kPreselSigmaZ2];
+  if(sigmaY2<=0. || sigmaZ2<=0.) return kFALSE;
+  Double_t wXY=TMath::Sqrt(TMath::Sqrt(sigmaZ2/sigmaY2));
+
+  // smallest distance of two points of the circles
+  Double_t dx=trk1[kPreselXc]-trk2[kPreselXc];
+  Double_t dy=trk1[kPreselYc]-trk2[kPreselYc];
+  Double_t dCentres=TMath::Sqrt(dx*dx+dy*dy);
+  Double_t distXY=0.;
+  if(dCentres>r1+r2) distXY=dCentres-r1-r2;                              // separate circles
+  else if(dCentres<TMath::Abs(r1-r2)) distXY=TMath::Abs(r1-r2)-dCentres; // one inside the other
+  if(distXY<=0.) return kFALSE;
+
+  // margin for the rounding of the centres and radii
+  return (wXY*(distXY-1.e-9*(r1+r2))>dcaCut*(1.+1.e-6));
+}
+//-----------------------------------------------------------------------------
+Bool_t AliAnalysisVertexingHF::IsBelowMinPt(Double_t minPt,Int_t iTrk1,Int_t iTrk2,Int_t iTrk3) const {
+  /// kTRUE if the sum of the track pt, an upper limit of the candidate pt
+  /// (the propagation does not change the pt of the tracks), is below minPt
+
+  if(minPt<=0. || fTrkPreselNTrks<=0) return kFALSE;
+  Double_t ptSum=fTrkPresel[iTrk1*kNPreselPars+kPreselPt]+fTrkPresel[iTrk2*kNPreselPars+kPreselPt];
+  if(iTrk3>=0) ptSum+=fTrkPresel[iTrk3*kNPreselPars+kPreselPt];
+  return (ptSum<minPt*(1.-1.e-6));
+}
+//-----------------------------------------------------------------------------
 void AliAnalysisVertexingHF::SetMasses(){
   /// Set the hadron mass values from TDatabasePDG
 
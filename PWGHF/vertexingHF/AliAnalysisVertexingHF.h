@@ -15,6 +15,7 @@
 
 #include <TNamed.h>
 #include <TList.h>
+#include <vector>
 
 #include "AliAnalysisFilter.h"
 #include "AliESDtrackCuts.h"
@@ -94,6 +95,8 @@ class AliAnalysisVertexingHF : public TNamed {
   void SetMixEventOff() { fMixEvent=kFALSE; }
   void SetInputAOD() { fInputAOD=kTRUE; }
   void SetMakeReducedRHF(Bool_t makeredAOD=kFALSE) { fMakeReducedRHF=makeredAOD; }
+  void SetNThreads(Int_t nth=1) { fNThreads=nth; }
+  void SetUsePairPreselection(Bool_t opt=kTRUE) { fUsePairPreselection=opt; }
   Bool_t GetD0toKpi() const { return fD0toKpi; }
   Bool_t GetJPSItoEle() const { return fJPSItoEle; }
   Bool_t Get3Prong() const { return f3Prong; }
@@ -240,13 +243,23 @@ class AliAnalysisVertexingHF : public TNamed {
   Int_t GetUseProtonPIDforLambdaC() const {return fUsePIDforLc;}
   Bool_t GetUseKaonPIDforDs() const {return fUseKaonPIDforDs;}
   Bool_t GetUseProtonPIDforLambdaC2V0() const {return fUsePIDforLc2V0;}
+  Int_t GetNThreads() const {return fNThreads;}
+  Bool_t GetUsePairPreselection() const {return fUsePairPreselection;}
+  Long64_t GetNCombinations(Int_t stage) const {return (stage>=0 && stage<kNCombStages) ? fnCombinations[stage] : 0;}
 
   void SetPidResponse(AliPIDResponse* p){fPidResponse=p;}
 
+  /// stages of the 2- and 3-prong combinatorics, for the rejection counters
+  enum ECombStage { kPairTried, kPairPreselRej, kPairDCARej, kPairVtxRej, kPairCand,
+		    kTripletTried, kTripletPreselRej, kTripletDCARej, kTripletMassRej, kTripletVtxRej, kTripletCand,
+		    kNCombStages };
+
   //
  private:
   //
   enum { kBitDispl = 0, kBitSoftPi = 1, kBit3Prong = 2, kBitPionCompat = 3, kBitKaonCompat = 4, kBitProtonCompat = 5, kBitBachelor = 6};
+  /// per-track parameters of the pair pre-selection (see FillPreselectionInfo)
+  enum { kPreselXc, kPreselYc, kPreselR, kPreselSigmaY2, kPreselSigmaZ2, kPreselPt, kNPreselPars };
 
   Bool_t fInputAOD; /// input from AOD (kTRUE) or ESD (kFALSE)
   Int_t fAODMapSize; /// size of fAODMap
@@ -348,6 +361,26 @@ class AliAnalysisVertexingHF : public TNamed {
   Double_t fMassDstar;
   Double_t fMassJpsi;
 
+  Int_t fNThreads; /// number of threads for the 2-, 3- and 4-prong loops
+  TObjArray *fWorkers; //! copies of this object used by the threads of the candidate loops
+  Bool_t fUsePairPreselection; /// cheap pre-selection of pairs and triplets before the DCA and vertexing
+  Long64_t fnCombinations[kNCombStages]; //! combinations per stage of the candidate loops
+  Int_t fTrkPreselSize; //! size of fTrkPresel
+  Int_t fTrkPreselNTrks; //! number of selected tracks in fTrkPresel (0 = no pre-selection)
+  Double_t *fTrkPresel; //![fTrkPreselSize] pre-selection parameters of the selected tracks
+
+
+  /// candidate of the 2-, 3- and 4-prong loops, kept until it is stored in the output arrays
+  struct CandidateRecord {
+    Int_t fNProngs;               /// 2, 3 or 4
+    Int_t fTrk[4];                /// indices of the prongs in the selected tracks, in the order of the candidate
+    Bool_t fLikeSign;             /// like-sign pair or triplet
+    Bool_t fOKD0;                 /// 2 prong: D0->Kpi cuts passed
+    Bool_t fOKJPSI;               /// 2 prong: J/psi->ee cuts passed
+    Bool_t fOKD0fromDstar;        /// 2 prong: D0 from D* cuts passed
+    AliAODRecoDecayHF *fRecoDecay; /// the candidate (owned)
+    AliAODVertex *fVertex;        /// its secondary vertex (owned)
+  };
 
   //
   void AddRefs(AliAODVertex *v,AliAODRecoDecayHF *rd,const AliVEvent *event,
@@ -411,6 +444,27 @@ class AliAnalysisVertexingHF : public TNamed {
 				   Int_t &nSeleTrks,
 				   UChar_t *seleFlags,Int_t *evtNumber);
   void SetParametersAtVertex(AliESDtrack* esdt, const AliExternalTrackParam* extpar) const;
+  Bool_t SetupCutsForEvent(AliVEvent *event);
+  void FindCandidatesForTrack(Int_t iTrkP1,AliVEvent *event,
+			      const TObjArray &seleTrksArray,const TObjArray &tracksAtVertex,
+			      Int_t nSeleTrks,const UChar_t *seleFlags,const Int_t *evtNumber,
+			      Float_t dcaMax,Double_t minPtPair,Double_t minPt3Prong,
+			      std::vector<CandidateRecord> &cands);
+  Bool_t FindCandidatesParallel(AliVEvent *event,
+				const TObjArray &seleTrksArray,const TObjArray &tracksAtVertex,
+				Int_t nSeleTrks,const UChar_t *seleFlags,const Int_t *evtNumber,
+				Float_t dcaMax,Double_t minPtPair,Double_t minPt3Prong,
+				std::vector< std::vector<CandidateRecord> > &candsPerTrk);
+  void FindCandidatesInThread(Int_t firstTrk,Int_t trkStep,AliVEvent *event,
+			      const TObjArray *seleTrksArray,const TObjArray *tracksAtVertex,
+			      Int_t nSeleTrks,const UChar_t *seleFlags,const Int_t *evtNumber,
+			      Float_t dcaMax,Double_t minPtPair,Double_t minPt3Prong,
+			      std::vector< std::vector<CandidateRecord> > *candsPerTrk);
+  AliAnalysisVertexingHF* CreateWorker() const;
+  void FillPreselectionInfo(const TObjArray *tracksAtVertex,Int_t nSeleTrks);
+  void GetPreselectionMinPt(Double_t &minPtPair,Double_t &minPt3Prong) const;
+  Bool_t IsPairRejected(Int_t iTrk1,Int_t iTrk2,Double_t dcaCut) const;
+  Bool_t IsBelowMinPt(Double_t minPt,Int_t iTrk1,Int_t iTrk2,Int_t iTrk3=-1) const;
 
   Bool_t SingleTrkCuts(AliESDtrack *trk,Float_t centralityperc, Bool_t &okDisplaced,Bool_t &okSoftPi, Bool_t &ok3prong, Bool_t &okBachelor) const;
 
@@ -420,7 +474,7 @@ class AliAnalysisVertexingHF : public TNamed {
 				  TObjArray *twoTrackArrayV0);
 
   /// \cond CLASSIMP
-  ClassDef(AliAnalysisVertexingHF,27);  // Reconstruction of HF decay candidates
+  ClassDef(AliAnalysisVertexingHF,29);  // Reconstruction of HF decay candidates
   /// \endcond
 };
 
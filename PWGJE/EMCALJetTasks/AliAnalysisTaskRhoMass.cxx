@@ -15,6 +15,7 @@
 #include "AliEmcalJet.h"
 #include "AliLog.h"
 #include "AliRhoParameter.h"
+#include "AliJetRhoService.h"
 
 ClassImp(AliAnalysisTaskRhoMass)
 
@@ -69,80 +70,46 @@ Bool_t AliAnalysisTaskRhoMass::Run()
   if (!fJets)
     return kFALSE;
 
-  const Int_t Njets   = fJets->GetEntries();
-
-  Int_t maxJetIds[]   = {-1, -1};
-  Float_t maxJetPts[] = { 0,  0};
-
-  if (fNExclLeadJets > 0) {
-    for (Int_t ij = 0; ij < Njets; ++ij) {
-      AliEmcalJet *jet = static_cast<AliEmcalJet*>(fJets->At(ij));
-      if (!jet) {
-	AliError(Form("%s: Could not receive jet %d", GetName(), ij));
-	continue;
-      } 
-
-      if (!AcceptJet(jet))
-        continue;
-
-      if (jet->Pt() > maxJetPts[0]) {
-	maxJetPts[1] = maxJetPts[0];
-	maxJetIds[1] = maxJetIds[0];
-	maxJetPts[0] = jet->Pt();
-	maxJetIds[0] = ij;
-      } else if (jet->Pt() > maxJetPts[1]) {
-	maxJetPts[1] = jet->Pt();
-	maxJetIds[1] = ij;
-      }
-    }
-    if (fNExclLeadJets < 2) {
-      maxJetIds[1] = -1;
-      maxJetPts[1] = 0;
-    }
-  }
-
-  static Double_t rhomvec[999];
-  static Double_t Evec[999];
-  static Double_t Mvec[999];
-  Int_t NjetAcc = 0;
+  // jet selection and per-jet m_delta, shared with the other rho mass tasks computing it the same way on the same jets
+  AliJetRhoService *rhoService = AliJetRhoService::GetService(fJets);
+  Int_t mdId = rhoService->GetJetQuantityId(Form("Md_%d_%d_%p_%p", fJetRhoMassType, fPionMassClusters, (void*)fTracks, (void*)fCaloClusters));
 
-  // push all jets within selected acceptance into stack
-  for (Int_t iJets = 0; iJets < Njets; ++iJets) {
+  // all jets within selected acceptance, excluding lead jets
+  static std::vector<Int_t> selectedJets;
+  rhoService->SelectJets(GetJetContainer(0), fNExclLeadJets, selectedJets);
 
-    // exlcuding lead jets
-    if (iJets == maxJetIds[0] || iJets == maxJetIds[1])
-      continue;
+  static std::vector<Double_t> rhomvec;
+  static std::vector<Double_t> Evec;
+  static std::vector<Double_t> Mvec;
+  rhomvec.clear();
+  Evec.clear();
+  Mvec.clear();
 
+  for (auto iJets : selectedJets) {
     AliEmcalJet *jet = static_cast<AliEmcalJet*>(fJets->At(iJets));
-    if (!jet) {
-      AliError(Form("%s: Could not receive jet %d", GetName(), iJets));
-      continue;
-    } 
-
-    if (!AcceptJet(jet))
-      continue;
 
     // Double_t sumM = GetSumMConstituents(jet);
     // Double_t sumPt = GetSumPtConstituents(jet);
     if(jet->Area()>0.) {// && (jet->M()*jet->M() + jet->Pt()*jet->Pt())>0.) {
       //rhomvec[NjetAcc] = (TMath::Sqrt(sumM*sumM + sumPt*sumPt) - sumPt ) / jet->Area();
       // rhomvec[NjetAcc] = (TMath::Sqrt(jet->M()*jet->M() + jet->Pt()*jet->Pt()) - jet->Pt() ) / jet->Area();
-      rhomvec[NjetAcc] = GetMd(jet) / jet->Area();
-      fHistMdAreavsCent->Fill(fCent,rhomvec[NjetAcc]);
-      Evec[NjetAcc] = jet->E();
-      Mvec[NjetAcc] = jet->M();
-      ++NjetAcc;
+      if (!rhoService->HasJetQuantity(mdId, iJets))
+        rhoService->SetJetQuantity(mdId, iJets, GetMd(jet));
+      rhomvec.push_back(rhoService->GetJetQuantity(mdId, iJets) / jet->Area());
+      fHistMdAreavsCent->Fill(fCent,rhomvec.back());
+      Evec.push_back(jet->E());
+      Mvec.push_back(jet->M());
     }
   }
 
-  if (NjetAcc > 0) {
+  if (!rhomvec.empty()) {
     //find median value
-    Double_t rhom = TMath::Median(NjetAcc, rhomvec);
+    Double_t rhom = AliJetRhoService::Median(rhomvec);
     fOutRhoMass->SetVal(rhom);
 
     Int_t Ntracks = fTracks->GetEntries();
-    Double_t meanM = TMath::Mean(NjetAcc, Mvec);
-    Double_t meanE = TMath::Mean(NjetAcc, Evec);
+    Double_t meanM = TMath::Mean(Mvec.begin(), Mvec.end());
+    Double_t meanE = TMath::Mean(Evec.begin(), Evec.end());
     Double_t gamma = 0.;
     if(meanM>0.) gamma = meanE/meanM;
     fHistGammaVsNtrack->Fill(Ntracks,gamma);
@@ -16,6 +16,7 @@
 #include "AliLog.h"
 #include "AliRhoParameter.h"
 #include "AliJetContainer.h"
+#include "AliJetRhoService.h"
 
 ClassImp(AliAnalysisTaskRhoMassSparse)
 
@@ -101,50 +102,37 @@ Bool_t AliAnalysisTaskRhoMassSparse::Run()
     return kFALSE;
 
   const Int_t Njets   = fJets->GetEntries();
+
+  // jet selection and per-jet m_delta, shared with the other rho mass tasks computing it the same way on the same jets
+  AliJetRhoService *rhoService = AliJetRhoService::GetService(fJets);
+  Int_t mdId = rhoService->GetJetQuantityId(Form("Md_%d_%d_%p_%p", fJetRhoMassType, fPionMassClusters, (void*)fTracks, (void*)fCaloClusters));
   
   AliJetContainer *sigjets = static_cast<AliJetContainer*>(fJetCollArray.At(1));
   
   Int_t NjetsSig = 0;
   if (sigjets) NjetsSig = sigjets->GetNJets();
 
-  Int_t maxJetIds[]   = {-1, -1};
-  Float_t maxJetPts[] = { 0,  0};
-
-  if (fNExclLeadJets > 0) {
-    for (Int_t ij = 0; ij < Njets; ++ij) {
-      AliEmcalJet *jet = static_cast<AliEmcalJet*>(fJets->At(ij));
-      if (!jet) {
-	AliError(Form("%s: Could not receive jet %d", GetName(), ij));
-	continue;
-      } 
-
-      if (!AcceptJet(jet))
-        continue;
-
-      if (jet->Pt() > maxJetPts[0]) {
-	maxJetPts[1] = maxJetPts[0];
-	maxJetIds[1] = maxJetIds[0];
-	maxJetPts[0] = jet->Pt();
-	maxJetIds[0] = ij;
-      } else if (jet->Pt() > maxJetPts[1]) {
-	maxJetPts[1] = jet->Pt();
-	maxJetIds[1] = ij;
-      }
-    }
-    if (fNExclLeadJets < 2) {
-      maxJetIds[1] = -1;
-      maxJetPts[1] = 0;
-    }
+  // tracks of the accepted signal jets, looked up for the overlap check with the background jets
+  static std::vector<Int_t> sigTrackIds;
+  sigTrackIds.clear();
+  for (Int_t j = 0; j < NjetsSig; j++) {
+    AliEmcalJet* signalJet = sigjets->GetAcceptJet(j);
+    if (!signalJet)
+      continue;
+    if (!IsJetSignal(signalJet))
+      continue;
+    for (Int_t i = 0; i < signalJet->GetNumberOfTracks(); i++) sigTrackIds.push_back(signalJet->TrackAt(i));
   }
+  AliJetRhoService::SortTrackIDs(sigTrackIds);
+
+  // all jets within selected acceptance, excluding lead jets
+  static std::vector<Int_t> selectedJets;
+  Int_t maxJetIds[] = {-1, -1};
+  rhoService->SelectJets(GetJetContainer(0), fNExclLeadJets, selectedJets, maxJetIds);
 
-  static Double_t rhomvec[999];
-  static Double_t Evec[999];
-  static Double_t Mvec[999];
-  Int_t NjetAcc = 0;
+  // area of all the jets but the lead jets, for the occupancy correction
   Double_t TotaljetArea=0;
   Double_t TotaljetAreaPhys=0;
-
-  // push all jets within selected acceptance into stack
   for (Int_t iJets = 0; iJets < Njets; ++iJets) {
 
     // exlcuding lead jets
@@ -152,38 +140,28 @@ Bool_t AliAnalysisTaskRhoMassSparse::Run()
       continue;
 
     AliEmcalJet *jet = static_cast<AliEmcalJet*>(fJets->At(iJets));
-    if (!jet) {
-      AliError(Form("%s: Could not receive jet %d", GetName(), iJets));
+    if (!jet)
       continue;
-    } 
 
     TotaljetArea+=jet->Area();
 
     if(jet->Pt()>0.1){
       TotaljetAreaPhys+=jet->Area();
     }
+  }
 
-    if (!AcceptJet(jet))
-      continue;
+  static std::vector<Double_t> rhomvec;
+  static std::vector<Double_t> Evec;
+  static std::vector<Double_t> Mvec;
+  rhomvec.clear();
+  Evec.clear();
+  Mvec.clear();
 
-      // Search for overlap with signal jets
-    Bool_t isOverlapping = kFALSE;
-    if (sigjets) {
-      for(Int_t j=0;j<NjetsSig;j++)
-	{
-	  AliEmcalJet* signalJet = sigjets->GetAcceptJet(j);
-	  if(!signalJet)
-	    continue;
-	  if(!IsJetSignal(signalJet))     
-	    continue;
-	  
-	  if(IsJetOverlapping(signalJet, jet))
-	    {
-	      isOverlapping = kTRUE;
-	      break;
-	    }
-	}
-    }
+  for (auto iJets : selectedJets) {
+    AliEmcalJet *jet = static_cast<AliEmcalJet*>(fJets->At(iJets));
+
+    // Search for overlap with signal jets
+    Bool_t isOverlapping = AliJetRhoService::SharesTrack(jet, sigTrackIds);
 
     if(isOverlapping) 
       continue;
@@ -194,11 +172,12 @@ Bool_t AliAnalysisTaskRhoMassSparse::Run()
     if(jet->Area()>0.) {// && (jet->M()*jet->M() + jet->Pt()*jet->Pt())>0.) {
        //rhomvec[NjetAcc] = (TMath::Sqrt(sumM*sumM + sumPt*sumPt) - sumPt ) / jet->Area();
       // rhomvec[NjetAcc] = (TMath::Sqrt(jet->M()*jet->M() + jet->Pt()*jet->Pt()) - jet->Pt() ) / jet->Area();
-      rhomvec[NjetAcc] = GetMd(jet) / jet->Area();
-      fHistMdAreavsCent->Fill(fCent,rhomvec[NjetAcc]);
-      Evec[NjetAcc] = jet->E();
-      Mvec[NjetAcc] = jet->M();
-      ++NjetAcc;
+      if (!rhoService->HasJetQuantity(mdId, iJets))
+        rhoService->SetJetQuantity(mdId, iJets, GetMd(jet));
+      rhomvec.push_back(rhoService->GetJetQuantity(mdId, iJets) / jet->Area());
+      fHistMdAreavsCent->Fill(fCent,rhomvec.back());
+      Evec.push_back(jet->E());
+      Mvec.push_back(jet->M());
     }
   }
 
@@ -209,9 +188,9 @@ Bool_t AliAnalysisTaskRhoMassSparse::Run()
     fHistOccCorrvsCent->Fill(fCent, OccCorr);
 
 
-  if (NjetAcc > 0) {
+  if (!rhomvec.empty()) {
     //find median value
-    Double_t rhom = TMath::Median(NjetAcc, rhomvec);
+    Double_t rhom = AliJetRhoService::Median(rhomvec);
     if(fRhoCMS){
       rhom = rhom * OccCorr;
     }
@@ -219,8 +198,8 @@ Bool_t AliAnalysisTaskRhoMassSparse::Run()
     fOutRhoMass->SetVal(rhom);
 
     Int_t Ntracks = fTracks->GetEntries();
-    Double_t meanM = TMath::Mean(NjetAcc, Mvec);
-    Double_t meanE = TMath::Mean(NjetAcc, Evec);
+    Double_t meanM = TMath::Mean(Mvec.begin(), Mvec.end());
+    Double_t meanE = TMath::Mean(Evec.begin(), Evec.end());
     Double_t gamma = 0.;
     if(meanM>0.) gamma = meanE/meanM;
     fHistGammaVsNtrack->Fill(Ntracks,gamma);
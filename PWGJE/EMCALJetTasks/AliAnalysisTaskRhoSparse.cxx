@@ -16,6 +16,7 @@
 #include "AliLog.h"
 #include "AliRhoParameter.h"
 #include "AliJetContainer.h"
+#include "AliJetRhoService.h"
 
 ClassImp(AliAnalysisTaskRhoSparse)
 
@@ -91,47 +92,35 @@ Bool_t AliAnalysisTaskRhoSparse::Run()
 
   const Int_t Njets = fJets->GetEntries();
 
+  // jet selection and per-jet pt/area, shared with the other rho tasks running on the same jets
+  AliJetRhoService *rhoService = AliJetRhoService::GetService(fJets);
+
   AliJetContainer *sigjets = static_cast<AliJetContainer*>(fJetCollArray.At(1));
 
   Int_t NjetsSig = 0;
   if (sigjets) NjetsSig = sigjets->GetNJets();
 
-  Int_t maxJetIds[]   = {-1, -1};
-  Float_t maxJetPts[] = { 0,  0};
-
-  if (fNExclLeadJets > 0) {
-    for (Int_t ij = 0; ij < Njets; ++ij) {
-      AliEmcalJet *jet = static_cast<AliEmcalJet*>(fJets->At(ij));
-      if (!jet) {
-	AliError(Form("%s: Could not receive jet %d", GetName(), ij));
-	continue;
-      } 
-
-      if (!AcceptJet(jet))
-        continue;
-
-      if (jet->Pt() > maxJetPts[0]) {
-	maxJetPts[1] = maxJetPts[0];
-	maxJetIds[1] = maxJetIds[0];
-	maxJetPts[0] = jet->Pt();
-	maxJetIds[0] = ij;
-      } else if (jet->Pt() > maxJetPts[1]) {
-	maxJetPts[1] = jet->Pt();
-	maxJetIds[1] = ij;
-      }
-    }
-    if (fNExclLeadJets < 2) {
-      maxJetIds[1] = -1;
-      maxJetPts[1] = 0;
-    }
+  // tracks of the accepted signal jets, looked up for the overlap check with the background jets
+  static std::vector<Int_t> sigTrackIds;
+  sigTrackIds.clear();
+  for (Int_t j = 0; j < NjetsSig; j++) {
+    AliEmcalJet* signalJet = sigjets->GetAcceptJet(j);
+    if (!signalJet)
+      continue;
+    if (!IsJetSignal(signalJet))
+      continue;
+    for (Int_t i = 0; i < signalJet->GetNumberOfTracks(); i++) sigTrackIds.push_back(signalJet->TrackAt(i));
   }
+  AliJetRhoService::SortTrackIDs(sigTrackIds);
+
+  // all jets within selected acceptance, excluding lead jets
+  static std::vector<Int_t> selectedJets;
+  Int_t maxJetIds[] = {-1, -1};
+  rhoService->SelectJets(GetJetContainer(0), fNExclLeadJets, selectedJets, maxJetIds);
 
-  static Double_t rhovec[999];
-  Int_t NjetAcc = 0;
+  // area of all the jets but the lead jets, for the occupancy correction
   Double_t TotaljetArea=0;
   Double_t TotaljetAreaPhys=0;
-
-  // push all jets within selected acceptance into stack
   for (Int_t iJets = 0; iJets < Njets; ++iJets) {
 
     // exlcuding lead jets
@@ -139,45 +128,29 @@ Bool_t AliAnalysisTaskRhoSparse::Run()
       continue;
 
     AliEmcalJet *jet = static_cast<AliEmcalJet*>(fJets->At(iJets));
-    if (!jet) {
-      AliError(Form("%s: Could not receive jet %d", GetName(), iJets));
+    if (!jet)
       continue;
-    } 
 
     TotaljetArea+=jet->Area();
     
     if(jet->Pt()>0.1){
       TotaljetAreaPhys+=jet->Area();
     }
+  }
 
-    if (!AcceptJet(jet))
-      continue;
+  static std::vector<Int_t> rhoJets;
+  rhoJets.clear();
+  for (auto iJets : selectedJets) {
+    AliEmcalJet *jet = static_cast<AliEmcalJet*>(fJets->At(iJets));
 
-   // Search for overlap with signal jets
-    Bool_t isOverlapping = kFALSE;
-    if (sigjets) {
-      for(Int_t j=0;j<NjetsSig;j++)
-	{
-	  AliEmcalJet* signalJet = sigjets->GetAcceptJet(j);
-	  if(!signalJet)
-	    continue;
-	  if(!IsJetSignal(signalJet))     
-	    continue;
-	  
-	  if(IsJetOverlapping(signalJet, jet))
-	    {
-	      isOverlapping = kTRUE;
-	      break;
-	    }
-	}
-    }
+    // Search for overlap with signal jets
+    Bool_t isOverlapping = AliJetRhoService::SharesTrack(jet, sigTrackIds);
 
     if(isOverlapping) 
       continue;
 
     if(jet->Pt()>0.1){
-      rhovec[NjetAcc] = jet->Pt() / jet->Area();
-      ++NjetAcc;
+      rhoJets.push_back(iJets);
     }
   }
 
@@ -187,9 +160,9 @@ Bool_t AliAnalysisTaskRhoSparse::Run()
   if (fCreateHisto)
     fHistOccCorrvsCent->Fill(fCent, OccCorr);
 
-  if (NjetAcc > 0) {
+  if (!rhoJets.empty()) {
     //find median value
-    Double_t rho = TMath::Median(NjetAcc, rhovec);
+    Double_t rho = rhoService->MedianPtOverArea(rhoJets);
 
     if(fRhoCMS){
       rho = rho * OccCorr;
@@ -14,6 +14,7 @@
  **************************************************************************/
 
 #include <vector>
+#include <algorithm>
 
 #include <TClonesArray.h>
 #include <TMath.h>
@@ -47,6 +48,7 @@ ClassImp(AliEmcalJetTask);
 /// \endcond
 
 const Int_t AliEmcalJetTask::fgkConstIndexShift = 100000;
+std::vector<const AliFJWrapper*> AliEmcalJetTask::fgSharedClusterings;
 
 /**
  * Default constructor. This constructor is only for ROOT I/O and
@@ -70,6 +72,7 @@ AliEmcalJetTask::AliEmcalJetTask() :
   fTrackEfficiencyOnlyForEmbedding(kFALSE),
   fUtilities(0),
   fLocked(0),
+  fShareClustering(kFALSE),
   fJetsName(),
   fIsInit(0),
   fIsPSelSet(0),
@@ -105,6 +108,7 @@ AliEmcalJetTask::AliEmcalJetTask(const char *name) :
   fTrackEfficiencyOnlyForEmbedding(kFALSE),
   fUtilities(0),
   fLocked(0),
+  fShareClustering(kFALSE),
   fJetsName(),
   fIsInit(0),
   fIsPSelSet(0),
@@ -123,6 +127,7 @@ AliEmcalJetTask::AliEmcalJetTask(const char *name) :
  */
 AliEmcalJetTask::~AliEmcalJetTask()
 {
+  fgSharedClusterings.erase(std::remove(fgSharedClusterings.begin(), fgSharedClusterings.end(), &fFastJetWrapper), fgSharedClusterings.end());
 }
 
 /**
@@ -275,11 +280,36 @@ Int_t AliEmcalJetTask::FindJets()
   if (fFastJetWrapper.GetInputVectors().size() == 0) return 0;
 
   // run jet finder
-  fFastJetWrapper.Run();
+  RunJetFinder();
 
   return fFastJetWrapper.GetInclusiveJets().size();
 }
 
+/**
+ * Runs the jet finder on the input vectors of the FastJet wrapper. Trains often contain
+ * several jet finders with identical inputs and jet definitions (e.g. differing only
+ * in the jet cuts applied when filling the output). If sharing is enabled (opt-in), the
+ * clustering of another jet finder which also enabled sharing is reused when its jet
+ * definition (including the radius), area definition and input vectors (four-momenta
+ * and indices) are identical to the ones of this task. Jet finders with different radii
+ * always run their own clustering. Since the inputs are compared exactly, the reused
+ * clustering is the one this task would have obtained itself, except for the random
+ * placement of the ghosts (see the class documentation).
+ * @return Return value of the FastJet wrapper (0 if successful)
+ */
+Int_t AliEmcalJetTask::RunJetFinder()
+{
+  if (fShareClustering) {
+    for (auto wrapper : fgSharedClusterings) {
+      if (!fFastJetWrapper.CanShareClusteringWith(*wrapper)) continue;
+      AliDebug(2, Form("Reusing clustering of jet finder %s", wrapper->GetName()));
+      return fFastJetWrapper.RunShared(*wrapper);
+    }
+  }
+
+  return fFastJetWrapper.Run();
+}
+
 /**
  * This method fills the jet output branch (TClonesArray) with the jet found by the FastJet
  * wrapper. Before filling the jet branch, the utilities are prepared. Then the utilities are
@@ -403,6 +433,11 @@ void AliEmcalJetTask::ExecOnce()
 
   InitUtilities();
 
+  // offer the clustering of this task for reuse by other jet finders
+  if (fShareClustering && std::find(fgSharedClusterings.begin(), fgSharedClusterings.end(), &fFastJetWrapper) == fgSharedClusterings.end()) {
+    fgSharedClusterings.push_back(&fFastJetWrapper);
+  }
+
   AliAnalysisTaskEmcal::ExecOnce();
 
   // Setup container utils. Must be called after AliAnalysisTaskEmcal::ExecOnce() so that the
@@ -439,6 +474,10 @@ void AliEmcalJetTask::FillJetConstituents(AliEmcalJet *jet, std::vector<fastjet:
 
   Int_t uid   = -1;
 
+  // pT and global index of the track constituents, used to store the pT order in the jet
+  std::vector<std::pair<Double_t, Int_t> > trackPtIds;
+  trackPtIds.reserve(constituents.size());
+
   jet->SetNumberOfTracks(constituents.size());
   jet->SetNumberOfClusters(constituents.size());
 
@@ -522,6 +561,7 @@ void AliEmcalJetTask::FillJetConstituents(AliEmcalJet *jet, std::vector<fastjet:
 
       if (flag == 0 || particlesSubName == "") {
         jet->AddTrackAt(fParticleContainerIndexMap.GlobalIndexFromLocalIndex(partCont, tid), nt);
+        trackPtIds.push_back(std::make_pair(cPt, jet->TrackAt(nt)));
       }
       else {
         // Get the particle container and array corresponding to the subtracted particles
@@ -532,6 +572,7 @@ void AliEmcalJetTask::FillJetConstituents(AliEmcalJet *jet, std::vector<fastjet:
         AliEmcalParticle* part_sub = new ((*particles_sub)[part_sub_id]) AliEmcalParticle(dynamic_cast<AliVTrack*>(t));   // SA: probably need to be fixed!!
         part_sub->SetPtEtaPhiM(constituents[ic].perp(),constituents[ic].eta(),constituents[ic].phi(),constituents[ic].m());
         jet->AddTrackAt(fParticleContainerIndexMap.GlobalIndexFromLocalIndex(partCont, part_sub_id), nt);
+        trackPtIds.push_back(std::make_pair(part_sub->Pt(), jet->TrackAt(nt)));
       }
 
       ++nt;
@@ -606,6 +647,8 @@ void AliEmcalJetTask::FillJetConstituents(AliEmcalJet *jet, std::vector<fastjet:
   jet->SetMCPt(mcpt);
   jet->SetPtEmc(emcpt);
   jet->SortConstituents();
+  // Store the pT order once, such that analysis tasks do not need to sort the constituents again
+  jet->SetTrackConstituentPt(trackPtIds);
 }
 
 /**
@@ -44,6 +44,19 @@ namespace fastjet {
  * and its derived classes. Utilities can be added via the AddUtility(AliEmcalJetUtility*) method.
  * All the utilities added in the list will be executed. Users can implement new utilities
  * deriving a new class from AliEmcalJetUtility to interface functionalities of the FastJet contribs.
+ *
+ * Jet finders in the same train which end up with identical FastJet input and identical
+ * jet and area definitions, including the radius (e.g. tasks differing only in the output
+ * jet cuts), can share a single clustering sequence per event. Sharing is opt-in and is
+ * enabled per task via SetShareClustering(); only tasks which enabled it are reused or
+ * reuse others. Jet finders with different radii are always clustered separately.
+ * Enabling sharing changes the ghosts used for the jet areas: a task reusing a sequence
+ * gets the jet areas computed with the ghosts of the task it reuses, instead of an
+ * independent ghost configuration, and it does not draw ghosts from the FastJet random
+ * generator, so all jet finders running later in the event see a different ghost
+ * placement than without sharing. Jets and constituents are not affected; jet areas
+ * and area-based quantities (e.g. rho*A subtraction) change within their ghost
+ * fluctuations only.
  */
 class AliEmcalJetTask : public AliAnalysisTaskEmcal {
  public:
@@ -79,6 +92,7 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   void                   SetLegacyMode(Bool_t mode)                 { if (IsLocked()) return; fLegacyMode       = mode  ; }
   void                   SetFillGhost(Bool_t b=kTRUE)               { if (IsLocked()) return; fFillGhost        = b     ; }
   void                   SetRadius(Double_t r)                      { if (IsLocked()) return; fRadius           = r     ; }
+  void                   SetShareClustering(Bool_t b=kTRUE)         { if (IsLocked()) return; fShareClustering  = b     ; }
 
   void                   SetEtaRange(Double_t emi, Double_t ema);
   void                   SetMinJetClusPt(Double_t min);
@@ -105,6 +119,7 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   Int_t                  GetRecombScheme()                { return fRecombScheme      ; }
   Double_t               GetTrackEfficiency()             { return fTrackEfficiency   ; }
   Bool_t                 GetTrackEfficiencyOnlyForEmbedding() { return fTrackEfficiencyOnlyForEmbedding; }
+  Bool_t                 GetShareClustering()             { return fShareClustering   ; }
 
   TClonesArray*          GetJets()                        { return fJets              ; }
   TObjArray*             GetUtilities()                   { return fUtilities         ; }
@@ -143,6 +158,7 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
  protected:
 
   Int_t                  FindJets();
+  Int_t                  RunJetFinder();
   void                   FillJetBranch();
   void                   ExecOnce();
   void                   InitEvent();
@@ -173,6 +189,7 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   TObjArray             *fUtilities;              // jet utilities (gen subtractor, constituent subtractor etc.)
   Bool_t                 fTrackEfficiencyOnlyForEmbedding; // Apply aritificial tracking inefficiency only for embedded tracks
   Bool_t                 fLocked;                 // true if lock is set
+  Bool_t                 fShareClustering;        // share the clustering with other jet finders with identical jet definition and input in the same event (opt-in)
 
   TString                fJetsName;               //!name of jet collection
   Bool_t                 fIsInit;                 //!=true if already initialized
@@ -190,6 +207,8 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   // Handle mapping between index and containers
   AliEmcalContainerIndexMap <AliClusterContainer, AliVCluster> fClusterContainerIndexMap;    //!<! Mapping between index and cluster containers
   AliEmcalContainerIndexMap <AliParticleContainer, AliVParticle> fParticleContainerIndexMap; //!<! Mapping between index and particle containers
+
+  static std::vector<const AliFJWrapper*> fgSharedClusterings; //!<! FastJet wrappers of all jet finders offering their clustering for reuse
 #endif
 
  private:
@@ -197,7 +216,7 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   AliEmcalJetTask &operator=(const AliEmcalJetTask&); // not implemented
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalJetTask, 24);
+  ClassDef(AliEmcalJetTask, 25);
   /// \endcond
 };
 #endif
@@ -4,6 +4,7 @@
 #if !defined(__CINT__)
 
 #include <vector>
+#include <memory>
 #include <TString.h>
 #include "AliLog.h"
 #include "FJ_includes.h"
@@ -88,6 +89,8 @@ class AliFJWrapper
   virtual void RemoveLastInputVector();
 
   virtual Int_t Run();
+  virtual Int_t RunShared(const AliFJWrapper& source);
+  virtual Bool_t CanShareClusteringWith(const AliFJWrapper& other) const;
   virtual Int_t Filter();
   virtual void  DoGenericSubtraction(const fastjet::FunctionOfPseudoJet<Double32_t>& jetshape, std::vector<fastjet::contrib::GenericSubtractorInfo>& output);
   virtual Int_t DoGenericSubtractionJetMass();
@@ -168,6 +171,7 @@ class AliFJWrapper
   fastjet::Selector                     *fRange;              //!
 #endif
   fastjet::ClusterSequenceArea          *fClustSeq;           //!
+  std::shared_ptr<fastjet::ClusterSequenceArea> fClustSeqShared; //! owner of fClustSeq, possibly shared with other wrappers
   fastjet::ClusterSequenceArea          *fClustSeqES;           //!
   fastjet::ClusterSequence              *fClustSeqSA;                //!
   fastjet::ClusterSequenceActiveAreaExplicitGhosts *fClustSeqActGhosts; //!
@@ -237,6 +241,7 @@ class AliFJWrapper
   std::vector<double>                      fGRDenominatorSub; //!
 
   virtual void   SubtractBackground(const Double_t median_pt = -1);
+  virtual void   SetupDefinitions();
 
  private:
   AliFJWrapper();
@@ -277,6 +282,7 @@ AliFJWrapper::AliFJWrapper(const char *name, const char *title)
   , fPlugin            (0)
   , fRange             (0)
   , fClustSeq          (0)
+  , fClustSeqShared    ( )
   , fClustSeqES        (0)
   , fClustSeqSA        (0)
   , fClustSeqActGhosts (0)
@@ -360,7 +366,7 @@ void AliFJWrapper::ClearMemory()
   if (fJetDef)            { delete fJetDef;            fJetDef          = NULL; }
   if (fPlugin)            { delete fPlugin;            fPlugin          = NULL; }
   if (fRange)             { delete fRange;             fRange           = NULL; }
-  if (fClustSeq)          { delete fClustSeq;          fClustSeq        = NULL; }
+  if (fClustSeq)          { fClustSeqShared.reset();   fClustSeq        = NULL; }
   if (fClustSeqES)          { delete fClustSeqES;        fClustSeqES        = NULL; }
   if (fClustSeqSA)        { delete fClustSeqSA;        fClustSeqSA        = NULL; }
   if (fClustSeqActGhosts) { delete fClustSeqActGhosts; fClustSeqActGhosts = NULL; }
@@ -692,9 +698,9 @@ void AliFJWrapper::GetMedianAndSigma(Double_t &median, Double_t &sigma, Int_t re
 }
 
 //_________________________________________________________________________________________________
-Int_t AliFJWrapper::Run()
+void AliFJWrapper::SetupDefinitions()
 {
-  // Run the actual jet finder.
+  // Create the area, range and jet definitions from the settings.
 
   if (fAreaType == fj::voronoi_area) {
     // Rfact - check dependence - default is 1.
@@ -744,9 +750,18 @@ Int_t AliFJWrapper::Run()
   } else {
     fJetDef = new fj::JetDefinition(fAlgor, fR, fScheme, fStrategy);
   }
+}
+
+//_________________________________________________________________________________________________
+Int_t AliFJWrapper::Run()
+{
+  // Run the actual jet finder.
+
+  SetupDefinitions();
 
   try {
-    fClustSeq = new fj::ClusterSequenceArea(fInputVectors, *fJetDef, *fAreaDef);
+    fClustSeqShared.reset(new fj::ClusterSequenceArea(fInputVectors, *fJetDef, *fAreaDef));
+    fClustSeq = fClustSeqShared.get();
     if(fEventSub){
       DoEventConstituentSubtraction();
       fClustSeqES = new fj::ClusterSequenceArea(fEventSubCorrectedVectors, *fJetDef, *fAreaDef);
@@ -772,6 +787,56 @@ Int_t AliFJWrapper::Run()
   return 0;
 }
 
+//_________________________________________________________________________________________________
+Bool_t AliFJWrapper::CanShareClusteringWith(const AliFJWrapper& other) const
+{
+  // Check whether the clustering of the other wrapper is identical to the one
+  // this wrapper would obtain: same jet and area definition and the very same
+  // input vectors (momenta and user indices). The other wrapper must have been run.
+
+  if (&other == this || !other.fClustSeq) return kFALSE;
+  if (fAlgor == fj::plugin_algorithm || other.fAlgor == fj::plugin_algorithm) return kFALSE;
+  if (fEventSub || other.fEventSub) return kFALSE;
+  if (fAlgor != other.fAlgor || fScheme != other.fScheme || fStrategy != other.fStrategy || fR != other.fR) return kFALSE;
+  if (fAreaType != other.fAreaType || fNGhostRepeats != other.fNGhostRepeats || fGhostArea != other.fGhostArea ||
+      fMaxRap != other.fMaxRap || fGridScatter != other.fGridScatter || fKtScatter != other.fKtScatter ||
+      fMeanGhostKt != other.fMeanGhostKt || fLegacyMode != other.fLegacyMode) return kFALSE;
+
+  if (fInputVectors.size() != other.fInputVectors.size()) return kFALSE;
+  for (UInt_t i = 0; i < fInputVectors.size(); ++i) {
+    const fj::PseudoJet &mine = fInputVectors[i], &theirs = other.fInputVectors[i];
+    if (mine.user_index() != theirs.user_index() || mine.px() != theirs.px() || mine.py() != theirs.py() ||
+        mine.pz() != theirs.pz() || mine.E() != theirs.E()) return kFALSE;
+  }
+  return kTRUE;
+}
+
+//_________________________________________________________________________________________________
+Int_t AliFJWrapper::RunShared(const AliFJWrapper& source)
+{
+  // Take over the clustering of another wrapper instead of running the jet finder.
+  // The caller needs to check compatibility with CanShareClusteringWith() first.
+  // The cluster sequence is shared (reference counted), all other definitions
+  // are created by this wrapper, so that it can be used as after Run().
+
+  SetupDefinitions();
+
+  fClustSeqShared = source.fClustSeqShared;
+  fClustSeq = fClustSeqShared.get();
+
+#ifdef FASTJET_VERSION
+  fBkrdEstimator     = new fj::JetMedianBackgroundEstimator(fj::SelectorAbsRapMax(fMaxRap));
+#endif
+
+  if (fLegacyMode) { SetLegacyFJ(); }
+
+  fInclusiveJets.clear();
+  fEventSubJets.clear();
+  fInclusiveJets = source.fInclusiveJets;
+
+  return 0;
+}
+
 //_________________________________________________________________________________________________
 Int_t AliFJWrapper::Filter()
 {
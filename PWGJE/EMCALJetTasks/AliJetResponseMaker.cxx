@@ -22,6 +22,10 @@
 #include <TClonesArray.h>
 #include <TH2F.h>
 #include <THnSparse.h>
+#include <TVector2.h>
+
+#include <algorithm>
+#include <unordered_map>
 
 #include "AliTLorentzVector.h"
 #include "AliAnalysisManager.h"
@@ -59,6 +63,7 @@ AliJetResponseMaker::AliJetResponseMaker() :
   fFlavourZAxis(0),
   fFlavourPtAxis(0),
   fJetRelativeEPAngle(0),
+  fFastMatching(kTRUE),
   fIsJet1Rho(kFALSE),
   fIsJet2Rho(kFALSE),
   fHistRejectionReason1(0),
@@ -148,6 +153,7 @@ AliJetResponseMaker::AliJetResponseMaker(const char *name) :
   fFlavourZAxis(0),
   fFlavourPtAxis(0),
   fJetRelativeEPAngle(0),
+  fFastMatching(kTRUE),
   fIsJet1Rho(kFALSE),
   fIsJet2Rho(kFALSE),
   fHistRejectionReason1(0),
@@ -1417,6 +1423,16 @@ Bool_t AliJetResponseMaker::DoJetMatching()
 void AliJetResponseMaker::DoJetLoop()
 {
   // Do the jet loop.
+  //
+  // With fFastMatching only the pairs that can end up as matched closest jets are tested:
+  // - geometrical matching: the second collection is binned in eta-phi with a cell size
+  //   equal to the matching distance, and only the neighbouring cells are searched;
+  // - MC label / same collections matching: jets sharing at least one constituent are looked up
+  //   in a hash map (constituent key -> jet) built once per event. Pairs without common constituents
+  //   always have matching level 1 (or -1); they are only evaluated for the first jet of each collection,
+  //   which is the jet the full double loop would pick as closest in that case.
+  // The candidates are visited in the same order as in the full double loop, hence the matched pairs
+  // (including tie-breaking) are identical to the ones obtained testing all pairs.
 
   AliJetContainer *jets1 = static_cast<AliJetContainer*>(fJetCollArray.At(0));
   AliJetContainer *jets2 = static_cast<AliJetContainer*>(fJetCollArray.At(1));
@@ -1426,8 +1442,73 @@ void AliJetResponseMaker::DoJetLoop()
   AliEmcalJet* jet1 = 0;
   AliEmcalJet* jet2 = 0;
 
+  std::vector<AliEmcalJet*> jets2List;
   jets2->ResetCurrentID();
-  while ((jet2 = jets2->GetNextJet())) jet2->ResetMatching();
+  while ((jet2 = jets2->GetNextJet())) {
+    jet2->ResetMatching();
+    jets2List.push_back(jet2);
+  }
+  const Int_t nJets2 = jets2List.size();
+
+  // Eta-phi grid of the second collection (geometrical matching)
+  Bool_t useGrid = kFALSE;
+  Double_t gridEtaMin = 0, gridCellEta = 0, gridCellPhi = 0;
+  Int_t gridNEta = 0, gridNPhi = 0;
+  std::vector<Int_t> gridCellStart, gridCellJets;
+
+  // Constituent key -> jet2 position (MC label / same collections matching)
+  Bool_t useKeyMap = kFALSE;
+  std::unordered_multimap<Int_t, Int_t> partKeyMap, caloKeyMap;
+  std::vector<Int_t> partKeys, caloKeys;
+
+  if (fFastMatching && nJets2 > 0) {
+    if (fMatching == kGeometrical) {
+      // A pair can only be matched if its distance is below both matching parameters;
+      // the cell size gets a small safety margin against rounding at the cell edges
+      Double_t maxDist = TMath::Min(fMatchingPar1, fMatchingPar2);
+      if (maxDist > 0) {
+        gridCellEta = maxDist * 1.0001;
+        gridNPhi = TMath::Max(1, TMath::FloorNint(TMath::TwoPi() / gridCellEta));
+        gridCellPhi = TMath::TwoPi() / gridNPhi;
+
+        gridEtaMin = jets2List[0]->Eta();
+        Double_t gridEtaMax = gridEtaMin;
+        for (Int_t i = 1; i < nJets2; i++) {
+          gridEtaMin = TMath::Min(gridEtaMin, jets2List[i]->Eta());
+          gridEtaMax = TMath::Max(gridEtaMax, jets2List[i]->Eta());
+        }
+        gridNEta = TMath::FloorNint((gridEtaMax - gridEtaMin) / gridCellEta) + 1;
+
+        // Counting sort of the jets into the cells; within a cell the jets keep the container order
+        std::vector<Int_t> jetCell(nJets2);
+        gridCellStart.assign(gridNEta * gridNPhi + 1, 0);
+        for (Int_t i = 0; i < nJets2; i++) {
+          Int_t ieta = TMath::Min(gridNEta - 1, Int_t((jets2List[i]->Eta() - gridEtaMin) / gridCellEta));
+          Int_t iphi = TMath::Min(gridNPhi - 1, Int_t(TVector2::Phi_0_2pi(jets2List[i]->Phi()) / gridCellPhi));
+          jetCell[i] = ieta * gridNPhi + iphi;
+          gridCellStart[jetCell[i] + 1]++;
+        }
+        for (UInt_t icell = 1; icell < gridCellStart.size(); icell++) gridCellStart[icell] += gridCellStart[icell - 1];
+        gridCellJets.resize(nJets2);
+        std::vector<Int_t> fill(gridCellStart.begin(), gridCellStart.end() - 1);
+        for (Int_t i = 0; i < nJets2; i++) gridCellJets[fill[jetCell[i]]++] = i;
+
+        useGrid = kTRUE;
+      }
+    }
+    else if (fMatching == kMCLabel || fMatching == kSameCollections) {
+      useKeyMap = kTRUE;
+      for (Int_t i = 0; i < nJets2 && useKeyMap; i++) {
+        useKeyMap = GetConstituentMatchingKeys(jets2List[i], 1, partKeys, caloKeys);
+        for (UInt_t ikey = 0; ikey < partKeys.size(); ikey++) partKeyMap.insert(std::make_pair(partKeys[ikey], i));
+        for (UInt_t ikey = 0; ikey < caloKeys.size(); ikey++) caloKeyMap.insert(std::make_pair(caloKeys[ikey], i));
+      }
+    }
+  }
+
+  std::vector<Int_t> candidates;
+  std::vector<Int_t> candidateStamp(nJets2, -1);
+  Int_t ijet1 = 0;
 
   jets1->ResetCurrentID();
   while ((jet1 = jets1->GetNextJet())) {
@@ -1435,13 +1516,138 @@ void AliJetResponseMaker::DoJetLoop()
 
     if (jet1->MCPt() < fMinJetMCPt) continue;
 
-    jets2->ResetCurrentID();
-    while ((jet2 = jets2->GetNextJet())) {
-      SetMatchingLevel(jet1, jet2, fMatching);
-    } // jet2 loop
+    if (useGrid) {
+      candidates.clear();
+      Int_t ieta1 = TMath::FloorNint((jet1->Eta() - gridEtaMin) / gridCellEta);
+      Int_t iphi1 = TMath::Min(gridNPhi - 1, Int_t(TVector2::Phi_0_2pi(jet1->Phi()) / gridCellPhi));
+      for (Int_t ieta = TMath::Max(0, ieta1 - 1); ieta <= TMath::Min(gridNEta - 1, ieta1 + 1); ieta++) {
+        for (Int_t dphi = -1; dphi <= 1; dphi++) {
+          Int_t iphi = (iphi1 + dphi + gridNPhi) % gridNPhi;
+          Int_t icell = ieta * gridNPhi + iphi;
+          for (Int_t k = gridCellStart[icell]; k < gridCellStart[icell + 1]; k++) {
+            Int_t i = gridCellJets[k];
+            if (candidateStamp[i] == ijet1) continue; // phi cells wrap around onto each other for coarse grids
+            candidateStamp[i] = ijet1;
+            candidates.push_back(i);
+          }
+        }
+      }
+      std::sort(candidates.begin(), candidates.end());
+      for (UInt_t k = 0; k < candidates.size(); k++) SetMatchingLevel(jet1, jets2List[candidates[k]], fMatching);
+    }
+    else if (useKeyMap && ijet1 > 0) {
+      candidates.clear();
+      candidateStamp[0] = ijet1;
+      candidates.push_back(0);
+      GetConstituentMatchingKeys(jet1, 0, partKeys, caloKeys);
+      for (Int_t imap = 0; imap < 2; imap++) {
+        const std::vector<Int_t> &keys = imap == 0 ? partKeys : caloKeys;
+        const std::unordered_multimap<Int_t, Int_t> &keyMap = imap == 0 ? partKeyMap : caloKeyMap;
+        for (UInt_t ikey = 0; ikey < keys.size(); ikey++) {
+          auto range = keyMap.equal_range(keys[ikey]);
+          for (auto it = range.first; it != range.second; ++it) {
+            if (candidateStamp[it->second] == ijet1) continue;
+            candidateStamp[it->second] = ijet1;
+            candidates.push_back(it->second);
+          }
+        }
+      }
+      std::sort(candidates.begin(), candidates.end());
+      for (UInt_t k = 0; k < candidates.size(); k++) SetMatchingLevel(jet1, jets2List[candidates[k]], fMatching);
+    }
+    else {
+      for (Int_t i = 0; i < nJets2; i++) SetMatchingLevel(jet1, jets2List[i], fMatching);
+    }
+
+    ijet1++;
   } // jet1 loop
 }
 
+/**
+ * Collect the constituent keys used to find candidate pairs for the MC label
+ * and same collections matching. Two jets get a matching level below 1 only if they
+ * share at least one key, following exactly the comparisons done in
+ * GetMCLabelMatchingLevel() and GetSameCollectionsMatchingLevel().
+ * @param[in] jet Jet
+ * @param[in] icoll Jet collection (0 or 1)
+ * @param[out] partKeys Particle keys (track indexes, or for jet 1 in MC label matching the index of the associated MC particle)
+ * @param[out] caloKeys Calorimeter keys (cluster indexes or cell ids, same collections matching only)
+ * @return kFALSE if the keys cannot be determined (the caller should then test all pairs)
+ */
+Bool_t AliJetResponseMaker::GetConstituentMatchingKeys(AliEmcalJet *jet, Int_t icoll, std::vector<Int_t> &partKeys, std::vector<Int_t> &caloKeys) const
+{
+  partKeys.clear();
+  caloKeys.clear();
+
+  AliJetContainer *jets1 = static_cast<AliJetContainer*>(fJetCollArray.At(0));
+  AliJetContainer *jets2 = static_cast<AliJetContainer*>(fJetCollArray.At(1));
+
+  if (!jets1 || !jets2) return kFALSE;
+
+  if (fMatching == kMCLabel) {
+    AliParticleContainer *tracks2 = jets2->GetParticleContainer();
+    if (!tracks2) return kFALSE;
+
+    if (icoll == 1) {
+      for (Int_t iTrack = 0; iTrack < jet->GetNumberOfTracks(); iTrack++) partKeys.push_back(jet->TrackAt(iTrack));
+      return kTRUE;
+    }
+
+    for (Int_t iTrack = 0; iTrack < jet->GetNumberOfTracks(); iTrack++) {
+      AliVParticle *track = jet->Track(iTrack);
+      if (!track) continue;
+      Int_t MClabel = TMath::Abs(track->GetLabel()) - fMCLabelShift;
+      if (MClabel <= 0) continue;
+      Int_t index = tracks2->GetIndexFromLabel(MClabel);
+      if (index >= 0) partKeys.push_back(index);
+    }
+
+    for (Int_t iClus = 0; iClus < jet->GetNumberOfClusters(); iClus++) {
+      AliVCluster *clus = jet->Cluster(iClus);
+      if (!clus) continue;
+      if (fUseCellsToMatch && fCaloCells) {
+        for (Int_t iCell = 0; iCell < clus->GetNCells(); iCell++) {
+          Int_t MClabel = TMath::Abs(fCaloCells->GetCellMCLabel(clus->GetCellAbsId(iCell))) - fMCLabelShift;
+          if (MClabel <= 0) continue;
+          Int_t index = tracks2->GetIndexFromLabel(MClabel);
+          if (index >= 0) partKeys.push_back(index);
+        }
+      }
+      else {
+        Int_t MClabel = TMath::Abs(clus->GetLabel()) - fMCLabelShift;
+        if (MClabel <= 0) continue;
+        Int_t index = tracks2->GetIndexFromLabel(MClabel);
+        if (index >= 0) partKeys.push_back(index);
+      }
+    }
+    return kTRUE;
+  }
+
+  if (fMatching != kSameCollections) return kFALSE;
+
+  AliJetContainer *jets = icoll == 0 ? jets1 : jets2;
+
+  if (jets1->GetParticleContainer() && jets2->GetParticleContainer()) {
+    for (Int_t iTrack = 0; iTrack < jet->GetNumberOfTracks(); iTrack++) partKeys.push_back(jet->TrackAt(iTrack));
+  }
+
+  if (jets1->GetClusterContainer() && jets2->GetClusterContainer()) {
+    if (fUseCellsToMatch && fCaloCells) {
+      AliClusterContainer *clusters = jets->GetClusterContainer();
+      for (Int_t iClus = 0; iClus < jet->GetNumberOfClusters(); iClus++) {
+        AliVCluster *clus = clusters->GetCluster(jet->ClusterAt(iClus));
+        if (!clus) continue;
+        for (Int_t iCell = 0; iCell < clus->GetNCells(); iCell++) caloKeys.push_back(clus->GetCellAbsId(iCell));
+      }
+    }
+    else {
+      for (Int_t iClus = 0; iClus < jet->GetNumberOfClusters(); iClus++) caloKeys.push_back(jet->ClusterAt(iClus));
+    }
+  }
+
+  return kTRUE;
+}
+
 //________________________________________________________________________
 void AliJetResponseMaker::GetGeometricalMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2, Double_t &d) const
 {
@@ -24,6 +24,8 @@ class TH2;
 class THnSparse;
 class AliNamedArrayI;
 
+#include <vector>
+
 #include "AliEmcalJet.h"
 #include "AliAnalysisTaskEmcalJet.h"
 #include "AliEmcalEmbeddingQA.h"
@@ -59,6 +61,7 @@ class AliJetResponseMaker : public AliAnalysisTaskEmcalJet {
   void                        SetPtgAxis(Int_t b)                                             { fPtgAxis           = b         ; }
   void                        SetDBCAxis(Int_t b)                                             { fDBCAxis           = b         ; }
   void                        SetJetRelativeEPAngleAxis(Int_t b)                              { fJetRelativeEPAngle = b        ; }
+  void                        SetFastMatching(Bool_t b)                                       { fFastMatching      = b         ; }
 
  protected:
   void                        ExecOnce();
@@ -70,6 +73,7 @@ class AliJetResponseMaker : public AliAnalysisTaskEmcalJet {
   void                        GetGeometricalMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2, Double_t &d) const;
   void                        GetMCLabelMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2, Double_t &d1, Double_t &d2) const;
   void                        GetSameCollectionsMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2, Double_t &d1, Double_t &d2) const;
+  Bool_t                      GetConstituentMatchingKeys(AliEmcalJet *jet, Int_t icoll, std::vector<Int_t> &partKeys, std::vector<Int_t> &caloKeys) const;
   void                        FillMatchingHistos(AliEmcalJet* jet1, AliEmcalJet* jet2, Double_t d, Double_t CE1, Double_t CE2);
   void                        FillJetHisto(AliEmcalJet* jet, Int_t Set);
   void                        AllocateTH2();
@@ -94,6 +98,7 @@ class AliJetResponseMaker : public AliAnalysisTaskEmcalJet {
   Int_t                       fPtgAxis;                                // add Ptg axis in matching THnSparse (default=0)
   Int_t                       fDBCAxis;                                // add DBC (number of soft dropped branches) axis in matching THnSparse (default=0)
   Int_t                       fJetRelativeEPAngle;                     ///< add jet angle relative to the EP in matching THnSparse (default=0)
+  Bool_t                      fFastMatching;                           ///< only test candidate pairs (eta-phi grid / shared constituents) instead of all jet pairs
 
   Bool_t                      fIsJet1Rho;                              //!whether the jet1 collection has to be average subtracted
   Bool_t                      fIsJet2Rho;                              //!whether the jet2 collection has to be average subtracted
@@ -174,6 +179,6 @@ class AliJetResponseMaker : public AliAnalysisTaskEmcalJet {
   AliJetResponseMaker(const AliJetResponseMaker&);            // not implemented
   AliJetResponseMaker &operator=(const AliJetResponseMaker&); // not implemented
 
-  ClassDef(AliJetResponseMaker, 29) // Jet response matrix producing task
+  ClassDef(AliJetResponseMaker, 30) // Jet response matrix producing task
 };
 #endif
@@ -0,0 +1,227 @@
+/**************************************************************************
+* Copyright(c) 1998-2017, ALICE Experiment at CERN, All rights reserved. *
+*                                                                        *
+* Author: The ALICE Off-line Project.                                    *
+* Contributors are mentioned in the code where appropriate.              *
+*                                                                        *
+* Permission to use, copy, modify and distribute this software and its   *
+* documentation strictly for non-commercial purposes is hereby granted   *
+* without fee, provided that the above copyright notice appears in all   *
+* copies and that both the copyright notice and this permission notice   *
+* appear in the supporting documentation. The authors make no claims     *
+* about the suitability of this software for any purpose. It is          *
+* provided "as is" without express or implied warranty.                  *
+**************************************************************************/
+#include "AliJetRhoService.h"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+
+#include <TClonesArray.h>
+#include <TMath.h>
+
+#include "AliAnalysisManager.h"
+#include "AliEmcalJet.h"
+#include "AliJetContainer.h"
+#include "AliLog.h"
+
+/**
+ * Get the service attached to a jet array, updated for the current event.
+ * The services live for the whole job, one per jet array.
+ * @param[in] jets Jet array
+ * @return Service for the jet array (null if no array is given)
+ */
+AliJetRhoService *AliJetRhoService::GetService(TClonesArray *jets)
+{
+  static std::map<TClonesArray*, std::unique_ptr<AliJetRhoService> > services;
+
+  if (!jets) return 0;
+
+  std::unique_ptr<AliJetRhoService> &service = services[jets];
+  if (!service) service.reset(new AliJetRhoService(jets));
+  service->Update();
+  return service.get();
+}
+
+/**
+ * Median of a set of values, identical to TMath::Median (for an even number
+ * of values the mean of the two central ones is returned). The values are
+ * partially reordered.
+ * @param[in,out] values Values
+ * @return Median (0 if no values are given)
+ */
+Double_t AliJetRhoService::Median(std::vector<Double_t> &values)
+{
+  const Int_t n = values.size();
+  if (n <= 0) return 0;
+
+  std::vector<Double_t>::iterator mid = values.begin() + n / 2;
+  std::nth_element(values.begin(), mid, values.end());
+  if (n % 2 == 1) return *mid;
+
+  // All the values below mid are not larger than mid: the lower central value is their maximum
+  Double_t lower = *std::max_element(values.begin(), mid);
+  return 0.5 * (lower + *mid);
+}
+
+/**
+ * Prepare a list of track IDs for SharesTrack (sort and remove duplicates).
+ * @param[in,out] ids Track IDs
+ */
+void AliJetRhoService::SortTrackIDs(std::vector<Int_t> &ids)
+{
+  std::sort(ids.begin(), ids.end());
+  ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+}
+
+/**
+ * Check whether a jet has at least one track in common with a list of tracks.
+ * @param[in] jet Jet
+ * @param[in] sortedIds Track IDs, sorted with SortTrackIDs
+ * @return kTRUE if one of the jet tracks is in the list
+ */
+Bool_t AliJetRhoService::SharesTrack(const AliEmcalJet *jet, const std::vector<Int_t> &sortedIds)
+{
+  if (sortedIds.empty()) return kFALSE;
+
+  for (Int_t i = 0; i < jet->GetNumberOfTracks(); i++) {
+    if (std::binary_search(sortedIds.begin(), sortedIds.end(), jet->TrackAt(i))) return kTRUE;
+  }
+  return kFALSE;
+}
+
+/**
+ * Select the jets of the array accepted by a jet container, excluding the
+ * nExclLeadJets (at most two) accepted jets with the highest pT.
+ * @param[in] cont Jet container of the jet array, providing the jet cuts
+ * @param[in] nExclLeadJets Number of leading jets to exclude
+ * @param[out] selected Indexes of the selected jets in the jet array (increasing)
+ * @param[out] excluded If given, filled with the indexes of the two excluded leading jets (-1 if not excluded)
+ */
+void AliJetRhoService::SelectJets(const AliJetContainer *cont, Int_t nExclLeadJets, std::vector<Int_t> &selected, Int_t *excluded) const
+{
+  selected.clear();
+
+  Int_t maxJetIds[]   = {-1, -1};
+  Float_t maxJetPts[] = { 0,  0};
+
+  const Int_t njets = fJets->GetEntries();
+  for (Int_t ij = 0; ij < njets; ++ij) {
+    AliEmcalJet *jet = static_cast<AliEmcalJet*>(fJets->At(ij));
+    if (!jet) {
+      AliErrorGeneral("AliJetRhoService", Form("%s: Could not receive jet %d", cont->GetName(), ij));
+      continue;
+    }
+
+    UInt_t rejectionReason = 0;
+    if (!cont->AcceptJet(jet, rejectionReason))
+      continue;
+
+    selected.push_back(ij);
+
+    if (nExclLeadJets <= 0)
+      continue;
+
+    if (jet->Pt() > maxJetPts[0]) {
+      maxJetPts[1] = maxJetPts[0];
+      maxJetIds[1] = maxJetIds[0];
+      maxJetPts[0] = jet->Pt();
+      maxJetIds[0] = ij;
+    } else if (jet->Pt() > maxJetPts[1]) {
+      maxJetPts[1] = jet->Pt();
+      maxJetIds[1] = ij;
+    }
+  }
+  if (nExclLeadJets < 2) maxJetIds[1] = -1;
+
+  // exclude the leading jets
+  if (maxJetIds[0] >= 0 || maxJetIds[1] >= 0) {
+    selected.erase(std::remove_if(selected.begin(), selected.end(),
+                                  [&maxJetIds](Int_t ij) { return ij == maxJetIds[0] || ij == maxJetIds[1]; }),
+                   selected.end());
+  }
+
+  if (excluded) {
+    excluded[0] = maxJetIds[0];
+    excluded[1] = maxJetIds[1];
+  }
+}
+
+/**
+ * Median of pT/area of a set of jets of the array.
+ * @param[in] jetIds Indexes of the jets in the jet array (e.g. from SelectJets)
+ * @return Median (0 if no jets are given)
+ */
+Double_t AliJetRhoService::MedianPtOverArea(const std::vector<Int_t> &jetIds)
+{
+  fMedianWork.clear();
+  for (auto ij : jetIds) fMedianWork.push_back(fPtOverArea[ij]);
+  return Median(fMedianWork);
+}
+
+/**
+ * Constructor.
+ * @param[in] jets Jet array
+ */
+AliJetRhoService::AliJetRhoService(TClonesArray *jets) :
+  fJets(jets),
+  fEventEntry(-1),
+  fEventNJets(-1),
+  fPtOverArea(),
+  fJetQuantityKeys(),
+  fJetQuantities(),
+  fMedianWork()
+{
+}
+
+/**
+ * Refill the per-jet values if the jet array belongs to a new event.
+ * Without an analysis manager the event cannot be identified and the values are always refilled.
+ */
+void AliJetRhoService::Update()
+{
+  AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+  Long64_t entry = mgr ? mgr->GetCurrentEntry() : -1;
+  const Int_t njets = fJets->GetEntriesFast();
+
+  if (entry >= 0 && entry == fEventEntry && njets == fEventNJets) return;
+
+  fEventEntry = entry;
+  fEventNJets = njets;
+
+  fPtOverArea.resize(njets);
+  for (Int_t ijet = 0; ijet < njets; ijet++) {
+    AliEmcalJet *jet = static_cast<AliEmcalJet*>(fJets->At(ijet));
+    fPtOverArea[ijet] = jet ? jet->Pt() / jet->Area() : TMath::QuietNaN();
+  }
+
+  for (UInt_t id = 0; id < fJetQuantities.size(); id++) fJetQuantities[id].assign(njets, TMath::QuietNaN());
+}
+
+/**
+ * Get the id of a lazily filled per-jet quantity. Tasks computing the same quantity
+ * the same way must use the same key, which should encode everything the quantity depends on.
+ * @param[in] key Quantity key
+ * @return Id of the quantity, to be used with HasJetQuantity/GetJetQuantity/SetJetQuantity
+ */
+Int_t AliJetRhoService::GetJetQuantityId(const char *key)
+{
+  for (UInt_t id = 0; id < fJetQuantityKeys.size(); id++) {
+    if (fJetQuantityKeys[id] == key) return id;
+  }
+  fJetQuantityKeys.push_back(key);
+  fJetQuantities.push_back(std::vector<Double_t>(fPtOverArea.size(), TMath::QuietNaN()));
+  return fJetQuantities.size() - 1;
+}
+
+/**
+ * Check whether a per-jet quantity was already computed in this event.
+ * @param[in] id Quantity id
+ * @param[in] ijet Jet index
+ * @return kTRUE if the value is available
+ */
+Bool_t AliJetRhoService::HasJetQuantity(Int_t id, Int_t ijet) const
+{
+  return !TMath::IsNaN(fJetQuantities[id][ijet]);
+}
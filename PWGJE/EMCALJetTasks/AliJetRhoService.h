@@ -0,0 +1,83 @@
+#ifndef ALIJETRHOSERVICE_H
+#define ALIJETRHOSERVICE_H
+/**************************************************************************
+* Copyright(c) 1998-2017, ALICE Experiment at CERN, All rights reserved. *
+*                                                                        *
+* Author: The ALICE Off-line Project.                                    *
+* Contributors are mentioned in the code where appropriate.              *
+*                                                                        *
+* Permission to use, copy, modify and distribute this software and its   *
+* documentation strictly for non-commercial purposes is hereby granted   *
+* without fee, provided that the above copyright notice appears in all   *
+* copies and that both the copyright notice and this permission notice   *
+* appear in the supporting documentation. The authors make no claims     *
+* about the suitability of this software for any purpose. It is          *
+* provided "as is" without express or implied warranty.                  *
+**************************************************************************/
+
+#include <vector>
+
+#include <TString.h>
+
+class TClonesArray;
+class AliEmcalJet;
+class AliJetContainer;
+
+/**
+ * @class AliJetRhoService
+ * @brief Per-event store of the jet inputs shared by the rho estimation tasks
+ * @ingroup EMCALJETFW
+ *
+ * Several rho tasks (AliAnalysisTaskRho, AliAnalysisTaskRhoSparse,
+ * AliAnalysisTaskRhoMass, AliAnalysisTaskRhoMassSparse and AliAnalysisTaskRhoFlow)
+ * usually run on the same k_T jet collection. The service holds, for each jet array,
+ * the per-jet pT/area computed once per event, and lazily filled per-jet quantities
+ * (e.g. m_delta) that the first task needing them computes and the other tasks reuse.
+ *
+ * The common part of the rho estimation is done by the service: the selection of the
+ * jets accepted by the jet container of a task, excluding the leading jets (SelectJets),
+ * and the median of pT/area of the selected jets (MedianPtOverArea). The selection is
+ * redone at each call, since it depends on the cuts of the calling task, which can
+ * change between calls (e.g. the phi windows of AliAnalysisTaskRhoFlow); it checks the
+ * acceptance of each jet once. Selections specific to a task (overlap with signal jets,
+ * pT threshold of the sparse tasks) and the mass estimates stay in the tasks.
+ *
+ * The median is obtained with a selection algorithm on the values of the
+ * selected jets and is identical to TMath::Median.
+ */
+class AliJetRhoService {
+ public:
+  static AliJetRhoService *GetService(TClonesArray *jets);
+  static Double_t          Median(std::vector<Double_t> &values);
+  static void              SortTrackIDs(std::vector<Int_t> &ids);
+  static Bool_t            SharesTrack(const AliEmcalJet *jet, const std::vector<Int_t> &sortedIds);
+
+  Int_t                    GetNJets() const                                    { return fPtOverArea.size()          ; }
+  Double_t                 GetPtOverArea(Int_t ijet) const                     { return fPtOverArea[ijet]           ; }
+
+  void                     SelectJets(const AliJetContainer *cont, Int_t nExclLeadJets, std::vector<Int_t> &selected, Int_t *excluded = 0) const;
+  Double_t                 MedianPtOverArea(const std::vector<Int_t> &jetIds);
+
+  Int_t                    GetJetQuantityId(const char *key);
+  Bool_t                   HasJetQuantity(Int_t id, Int_t ijet) const;
+  Double_t                 GetJetQuantity(Int_t id, Int_t ijet) const          { return fJetQuantities[id][ijet]    ; }
+  void                     SetJetQuantity(Int_t id, Int_t ijet, Double_t v)    { fJetQuantities[id][ijet] = v       ; }
+
+ protected:
+  AliJetRhoService(TClonesArray *jets);
+
+  void                     Update();
+
+  TClonesArray            *fJets;                         ///< jet array
+  Long64_t                 fEventEntry;                   ///< entry of the event the values belong to
+  Int_t                    fEventNJets;                   ///< number of jets in the event the values belong to
+  std::vector<Double_t>    fPtOverArea;                   ///< pT/area of each jet in the array
+  std::vector<TString>     fJetQuantityKeys;              ///< keys of the lazily filled per-jet quantities
+  std::vector<std::vector<Double_t> > fJetQuantities;     ///< lazily filled per-jet quantities (NaN = not yet computed)
+  std::vector<Double_t>    fMedianWork;                   ///< work array of the median calculation
+
+ private:
+  AliJetRhoService(const AliJetRhoService&);            // not implemented
+  AliJetRhoService &operator=(const AliJetRhoService&); // not implemented
+};
+#endif